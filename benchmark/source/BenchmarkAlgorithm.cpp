@@ -16,6 +16,7 @@
 #include <EASTL/list.h>
 #include <EASTL/string.h>
 #include <EASTL/random.h>
+#include <EASTL/searcher.h>
 
 EA_DISABLE_ALL_VC_WARNINGS()
 #include <stdio.h>
@@ -1206,6 +1207,217 @@ void BenchmarkAlgorithm8(EASTLTest_Rand& rng, EA::StdC::Stopwatch& stopwatch1, E
 
 
 
+// The algorithms for ranges of arithmetic types, which use the SIMD kernels. The first
+// column is the scalar code of the algorithm, which the SIMD version is compared with.
+void BenchmarkAlgorithm9(EASTLTest_Rand& rng, EA::StdC::Stopwatch& stopwatch1, EA::StdC::Stopwatch& stopwatch2)
+{
+	const uint32_t ElementCount = 100000;
+
+	std::vector<int32_t> vectorInt32(ElementCount);
+	std::vector<float>   vectorFloat(ElementCount);
+	std::vector<double>  vectorDouble(ElementCount);
+
+	for(uint32_t i = 0; i < ElementCount; i++)
+	{
+		vectorInt32[i]  = (int32_t)(rng() % 1000000);
+		vectorFloat[i]  = (float)vectorInt32[i] * 0.5f;
+		vectorDouble[i] = (double)vectorInt32[i] * 0.25;
+	}
+
+	std::vector<int32_t> vectorInt32Copy(vectorInt32);
+
+	int32_t* const pInt32Begin  = vectorInt32.data();
+	int32_t* const pInt32End    = vectorInt32.data() + ElementCount;
+	const float*   pFloatBegin  = vectorFloat.data();
+	const float*   pFloatEnd    = vectorFloat.data() + ElementCount;
+	const double*  pDoubleBegin = vectorDouble.data();
+	const double*  pDoubleEnd   = vectorDouble.data() + ElementCount;
+
+	for(int i = 0; i < 2; i++)
+	{
+		///////////////////////////////
+		// Test find
+		///////////////////////////////
+
+		stopwatch1.Restart();
+		Benchmark::DoNothing(std::Internal::find_impl(pInt32Begin, pInt32End, (int32_t)-1, std::false_type()));
+		stopwatch1.Stop();
+
+		stopwatch2.Restart();
+		Benchmark::DoNothing(std::find(pInt32Begin, pInt32End, (int32_t)-1));
+		stopwatch2.Stop();
+
+		if(i == 1)
+			Benchmark::AddResult("algorithm/find/vector<int32_t>", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+		stopwatch1.Restart();
+		Benchmark::DoNothing(std::Internal::find_impl(pDoubleBegin, pDoubleEnd, -1.0, std::false_type()));
+		stopwatch1.Stop();
+
+		stopwatch2.Restart();
+		Benchmark::DoNothing(std::find(pDoubleBegin, pDoubleEnd, -1.0));
+		stopwatch2.Stop();
+
+		if(i == 1)
+			Benchmark::AddResult("algorithm/find/vector<double>", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+		///////////////////////////////
+		// Test count
+		///////////////////////////////
+
+		stopwatch1.Restart();
+		Benchmark::DoNothing(std::Internal::count_impl(pInt32Begin, pInt32End, vectorInt32[0], std::false_type()));
+		stopwatch1.Stop();
+
+		stopwatch2.Restart();
+		Benchmark::DoNothing(std::count(pInt32Begin, pInt32End, vectorInt32[0]));
+		stopwatch2.Stop();
+
+		if(i == 1)
+			Benchmark::AddResult("algorithm/count/vector<int32_t>", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+		///////////////////////////////
+		// Test min_element / max_element / minmax_element
+		///////////////////////////////
+
+		stopwatch1.Restart();
+		Benchmark::DoNothing(std::Internal::min_element_impl(pInt32Begin, pInt32End, std::false_type()));
+		stopwatch1.Stop();
+
+		stopwatch2.Restart();
+		Benchmark::DoNothing(std::min_element(pInt32Begin, pInt32End));
+		stopwatch2.Stop();
+
+		if(i == 1)
+			Benchmark::AddResult("algorithm/min_element/vector<int32_t>", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+		stopwatch1.Restart();
+		Benchmark::DoNothing(std::Internal::max_element_impl(pFloatBegin, pFloatEnd, std::false_type()));
+		stopwatch1.Stop();
+
+		stopwatch2.Restart();
+		Benchmark::DoNothing(std::max_element(pFloatBegin, pFloatEnd));
+		stopwatch2.Stop();
+
+		if(i == 1)
+			Benchmark::AddResult("algorithm/max_element/vector<float>", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+		stopwatch1.Restart();
+		Benchmark::DoNothing(std::Internal::minmax_element_impl(pDoubleBegin, pDoubleEnd, std::false_type()).first);
+		stopwatch1.Stop();
+
+		stopwatch2.Restart();
+		Benchmark::DoNothing(std::minmax_element(pDoubleBegin, pDoubleEnd).first);
+		stopwatch2.Stop();
+
+		if(i == 1)
+			Benchmark::AddResult("algorithm/minmax_element/vector<double>", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+		///////////////////////////////
+		// Test equal
+		///////////////////////////////
+
+		stopwatch1.Restart();
+		Benchmark::DoNothing(std::Internal::equal_impl(pInt32Begin, pInt32End, vectorInt32Copy.data(), std::false_type()));
+		stopwatch1.Stop();
+
+		stopwatch2.Restart();
+		Benchmark::DoNothing(std::equal(pInt32Begin, pInt32End, vectorInt32Copy.data()));
+		stopwatch2.Stop();
+
+		if(i == 1)
+			Benchmark::AddResult("algorithm/equal/vector<int32_t>", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+		///////////////////////////////
+		// Test replace
+		///////////////////////////////
+
+		stopwatch1.Restart();
+		std::Internal::replace_impl(pInt32Begin, pInt32End, vectorInt32[0], vectorInt32[0], std::false_type());
+		stopwatch1.Stop();
+
+		stopwatch2.Restart();
+		std::replace(pInt32Begin, pInt32End, vectorInt32[0], vectorInt32[0]);
+		stopwatch2.Stop();
+
+		if(i == 1)
+			Benchmark::AddResult("algorithm/replace/vector<int32_t>", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+	}
+}
+
+
+
+// search with each searcher, compared with the search of the pattern itself, for patterns
+// of several lengths which don't occur in the text. The text is of 16 letters, so that the
+// first elements of the pattern match often.
+template <typename Searcher>
+static void BenchmarkSearcher(const char* pName, const std::string& sText, const char* pPatternBegin, const char* pPatternEnd,
+							  EA::StdC::Stopwatch& stopwatch1, EA::StdC::Stopwatch& stopwatch2, bool bAddResult)
+{
+	stopwatch1.Restart();
+	Benchmark::DoNothing(std::search(sText.begin(), sText.end(), pPatternBegin, pPatternEnd));
+	stopwatch1.Stop();
+
+	stopwatch2.Restart();
+	const Searcher searcher(pPatternBegin, pPatternEnd);
+	Benchmark::DoNothing(std::search(sText.begin(), sText.end(), searcher));
+	stopwatch2.Stop();
+
+	if(bAddResult)
+		Benchmark::AddResult(pName, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+}
+
+
+void BenchmarkAlgorithm10(EASTLTest_Rand& rng, EA::StdC::Stopwatch& stopwatch1, EA::StdC::Stopwatch& stopwatch2)
+{
+	const eastl_size_t TextLength = 1000000;
+
+	std::string sText(TextLength, 'a');
+	for(eastl_size_t i = 0; i < TextLength; i++)
+		sText[i] = (char)('a' + (rng() % 16));
+
+	std::string sPattern(64, 'a');
+	for(eastl_size_t i = 0; i < 64; i++)
+		sPattern[i] = (char)('a' + (rng() % 16));
+	sPattern[0]  = 'z'; // Neither pattern is in the text.
+	sPattern[56] = 'z';
+
+	const char* const pPatternEnd = sPattern.data() + sPattern.size();
+
+	// The worst case of search, which matches all but the last element of the pattern at
+	// every position.
+	const std::string sPeriodicText(TextLength / 16, 'a');
+	std::string       sPeriodicPattern(64, 'a');
+	sPeriodicPattern[63] = 'b';
+
+	const char* const pPeriodicPatternEnd = sPeriodicPattern.data() + sPeriodicPattern.size();
+
+	for(int i = 0; i < 2; i++)
+	{
+		typedef std::default_searcher<const char*>              default_searcher_type;
+		typedef std::boyer_moore_searcher<const char*>          boyer_moore_searcher_type;
+		typedef std::boyer_moore_horspool_searcher<const char*> boyer_moore_horspool_searcher_type;
+		typedef std::two_way_searcher<const char*>              two_way_searcher_type;
+
+		BenchmarkSearcher<default_searcher_type>             ("algorithm/search/default_searcher/8",                sText, pPatternEnd -  8, pPatternEnd, stopwatch1, stopwatch2, i == 1);
+		BenchmarkSearcher<boyer_moore_searcher_type>         ("algorithm/search/boyer_moore_searcher/8",            sText, pPatternEnd -  8, pPatternEnd, stopwatch1, stopwatch2, i == 1);
+		BenchmarkSearcher<boyer_moore_searcher_type>         ("algorithm/search/boyer_moore_searcher/64",           sText, pPatternEnd - 64, pPatternEnd, stopwatch1, stopwatch2, i == 1);
+		BenchmarkSearcher<boyer_moore_horspool_searcher_type>("algorithm/search/boyer_moore_horspool_searcher/8",   sText, pPatternEnd -  8, pPatternEnd, stopwatch1, stopwatch2, i == 1);
+		BenchmarkSearcher<boyer_moore_horspool_searcher_type>("algorithm/search/boyer_moore_horspool_searcher/64",  sText, pPatternEnd - 64, pPatternEnd, stopwatch1, stopwatch2, i == 1);
+		BenchmarkSearcher<two_way_searcher_type>             ("algorithm/search/two_way_searcher/8",                sText, pPatternEnd -  8, pPatternEnd, stopwatch1, stopwatch2, i == 1);
+		BenchmarkSearcher<two_way_searcher_type>             ("algorithm/search/two_way_searcher/64",               sText, pPatternEnd - 64, pPatternEnd, stopwatch1, stopwatch2, i == 1);
+
+		BenchmarkSearcher<boyer_moore_searcher_type>         ("algorithm/search/boyer_moore_searcher/64 periodic",  sPeriodicText, pPeriodicPatternEnd - 64, pPeriodicPatternEnd, stopwatch1, stopwatch2, i == 1);
+		BenchmarkSearcher<two_way_searcher_type>             ("algorithm/search/two_way_searcher/64 periodic",      sPeriodicText, pPeriodicPatternEnd - 64, pPeriodicPatternEnd, stopwatch1, stopwatch2, i == 1);
+	}
+}
+
+
+
 void BenchmarkAlgorithm()
 {
 	EASTLTest_Printf("Algorithm\n");
@@ -1222,6 +1434,8 @@ void BenchmarkAlgorithm()
 	BenchmarkAlgorithm6(rng, stopwatch1, stopwatch2);
 	BenchmarkAlgorithm7(rng, stopwatch1, stopwatch2);
 	BenchmarkAlgorithm8(rng, stopwatch1, stopwatch2);
+	BenchmarkAlgorithm9(rng, stopwatch1, stopwatch2);
+	BenchmarkAlgorithm10(rng, stopwatch1, stopwatch2);
 }
 
 
@@ -0,0 +1,127 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#include "EASTLBenchmark.h"
+#include "EASTLTest.h"
+#include <EAStdC/EAStopwatch.h>
+#include <EASTL/algorithm.h>
+#include <EASTL/bonus/lru_cache.h>
+#include <EASTL/vector.h>
+#include <math.h>
+#include <stdio.h>
+
+
+using namespace EA;
+
+
+namespace
+{
+	// Returns a trace of nLength requests for keys of a Zipf distribution of nKeyCount keys with
+	// exponent s. If nScanInterval is nonzero, a scan of nScanLength keys which aren't otherwise
+	// requested is inserted after each nScanInterval requests.
+	std::vector<uint32_t> MakeZipfTrace(EASTLTest_Rand& rng, uint32_t nKeyCount, double s, uint32_t nLength,
+	                                    uint32_t nScanInterval = 0, uint32_t nScanLength = 0)
+	{
+		std::vector<double> cdf(nKeyCount);
+		double fSum = 0;
+
+		for(uint32_t i = 0; i < nKeyCount; i++)
+			cdf[i] = (fSum += 1.0 / pow((double)(i + 1), s));
+
+		std::vector<uint32_t> trace;
+		trace.reserve(nLength + (nScanInterval ? (nLength / nScanInterval) * nScanLength : 0));
+
+		uint32_t nScanKey = nKeyCount;
+
+		for(uint32_t i = 0; i < nLength; i++)
+		{
+			const double fValue = fSum * ((double)rng.RandLimit(0x40000000) + 0.5) / (double)0x40000000;
+			const uint32_t nRank = (uint32_t)(std::lower_bound(cdf.begin(), cdf.end(), fValue) - cdf.begin());
+
+			trace.push_back((nRank < nKeyCount ? nRank : nKeyCount - 1) * 2654435761u); // Spread the ranks over the keys.
+
+			if(nScanInterval && ((i + 1) % nScanInterval == 0))
+			{
+				for(uint32_t j = 0; j < nScanLength; j++)
+					trace.push_back(nScanKey++ * 2654435761u);
+			}
+		}
+
+		return trace;
+	}
+
+
+	// Replays the trace, adding each key which isn't in the cache, and returns the number of hits.
+	template <typename Cache>
+	uint32_t TestReplay(EA::StdC::Stopwatch& stopwatch, Cache& cache, const std::vector<uint32_t>& trace)
+	{
+		uint32_t nHitCount = 0;
+
+		stopwatch.Restart();
+		for(eastl_size_t i = 0, iEnd = trace.size(); i < iEnd; i++)
+		{
+			if(cache.touch(trace[i]))
+				nHitCount++;
+			else
+				cache.insert(trace[i], trace[i]);
+		}
+		stopwatch.Stop();
+
+		Benchmark::DoNothing(&cache);
+		return nHitCount;
+	}
+
+
+	template <typename Policy>
+	void BenchmarkPolicy(const char* pPolicyName, const char* pTraceName, const std::vector<uint32_t>& trace, uint32_t nCapacity)
+	{
+		EA::StdC::Stopwatch stopwatch1(EA::StdC::Stopwatch::kUnitsNanoseconds);
+		EA::StdC::Stopwatch stopwatch2(EA::StdC::Stopwatch::kUnitsNanoseconds);
+
+		std::lru_cache<uint32_t, uint32_t> lruCache(nCapacity);
+		std::lru_cache<uint32_t, uint32_t, EASTLAllocatorType, std::hash<uint32_t>, std::equal_to<uint32_t>, Policy> policyCache(nCapacity);
+
+		const uint32_t nLruHitCount    = TestReplay(stopwatch1, lruCache, trace);
+		const uint32_t nPolicyHitCount = TestReplay(stopwatch2, policyCache, trace);
+
+		char name[64];
+		char notes[128];
+		sprintf(name, "lru_cache<%s>/%s", pPolicyName, pTraceName);
+		sprintf(notes, "hit ratio %.3f (lru %.3f), %.1f Mops/s",
+		        (double)nPolicyHitCount / trace.size(), (double)nLruHitCount / trace.size(),
+		        (double)trace.size() * 1000.0 / (double)(stopwatch2.GetElapsedTime() ? stopwatch2.GetElapsedTime() : 1));
+
+		Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime(), notes);
+	}
+
+
+	void BenchmarkTrace(const char* pTraceName, const std::vector<uint32_t>& trace, uint32_t nCapacity)
+	{
+		BenchmarkPolicy<std::cache_clock_policy>   ("clock",    pTraceName, trace, nCapacity);
+		BenchmarkPolicy<std::cache_s3fifo_policy>  ("s3fifo",   pTraceName, trace, nCapacity);
+		BenchmarkPolicy<std::cache_wtinylfu_policy>("wtinylfu", pTraceName, trace, nCapacity);
+	}
+
+} // namespace
+
+
+
+void BenchmarkLruCache()
+{
+	EASTLTest_Printf("LRU Cache\n");
+
+	EASTLTest_Rand rng(EA::UnitTest::GetRandSeed());
+
+	{
+		const uint32_t kKeyCount = 100000;
+		const uint32_t kCapacity = 2000;
+		const uint32_t kLength   = 1000000;
+
+		// Each result compares the time of a policy with that of LRU, and notes their hit ratios.
+		BenchmarkTrace("zipf 0.99",       MakeZipfTrace(rng, kKeyCount, 0.99, kLength), kCapacity);
+		BenchmarkTrace("zipf 0.8",        MakeZipfTrace(rng, kKeyCount, 0.8,  kLength), kCapacity);
+		BenchmarkTrace("zipf 0.99 scans", MakeZipfTrace(rng, kKeyCount, 0.99, kLength, 20000, 5000), kCapacity);
+	}
+}
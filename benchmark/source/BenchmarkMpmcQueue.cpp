@@ -0,0 +1,136 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#include "EASTLBenchmark.h"
+#include "EASTLTest.h"
+#include <EAStdC/EAStopwatch.h>
+#include <EASTL/mpmc_queue.h>
+#include <EASTL/thread_pool.h>
+#include <EASTL/deque.h>
+#include <EASTL/internal/thread_support.h>
+#include <stdio.h>
+
+
+using namespace EA;
+
+
+namespace
+{
+	// The alternative to mpmc_queue: a deque guarded by a mutex.
+	class LockedDeque
+	{
+	public:
+		eastl_size_t push_n(std::span<const uint32_t> values)
+		{
+			std::Internal::auto_mutex lock(mMutex);
+			mDeque.insert(mDeque.end(), values.begin(), values.end());
+			return values.size();
+		}
+
+		eastl_size_t pop_n(std::span<uint32_t> values)
+		{
+			std::Internal::auto_mutex lock(mMutex);
+			eastl_size_t i = 0;
+			for(; (i < values.size()) && !mDeque.empty(); i++)
+			{
+				values[i] = mDeque.front();
+				mDeque.pop_front();
+			}
+			return i;
+		}
+
+	protected:
+		std::Internal::mutex   mMutex;
+		std::deque<uint32_t>   mDeque;
+	};
+
+
+	// Runs nThreadCount threads which each push and then pop nBatchSize values at a time,
+	// for nCount values in all. Each thread pops only as many values as it pushed, so the
+	// queue never holds more than nThreadCount * nBatchSize values.
+	template <typename Queue>
+	uint32_t TestPushPop(EA::StdC::Stopwatch& stopwatch, std::thread_pool& pool, Queue& queue, uint32_t nThreadCount, uint32_t nCount, uint32_t nBatchSize)
+	{
+		std::atomic<uint32_t> nSum(0);
+
+		stopwatch.Restart();
+		pool.parallel_for(nThreadCount, 1, [&](size_t nBegin, size_t nEnd)
+		{
+			uint32_t values[16];
+			uint32_t nSum1 = 0;
+
+			for(size_t t = nBegin; t < nEnd; t++)
+			{
+				for(uint32_t i = 0; i < nCount / nThreadCount; i += nBatchSize)
+				{
+					for(uint32_t j = 0; j < nBatchSize; j++)
+						values[j] = i + j;
+
+					for(uint32_t j = 0; j < nBatchSize; )
+					{
+						const uint32_t n = (uint32_t)queue.push_n(std::span<const uint32_t>(values + j, nBatchSize - j));
+						if(!n)
+							std::Internal::thread_yield();
+						j += n;
+					}
+
+					for(uint32_t j = 0; j < nBatchSize; )
+					{
+						const uint32_t n = (uint32_t)queue.pop_n(std::span<uint32_t>(values, nBatchSize - j));
+						if(!n)
+							std::Internal::thread_yield();
+						for(uint32_t k = 0; k < n; k++)
+							nSum1 += values[k];
+						j += n;
+					}
+				}
+			}
+
+			nSum.fetch_add(nSum1, std::memory_order_relaxed);
+		});
+		stopwatch.Stop();
+
+		return nSum.load();
+	}
+
+} // namespace
+
+
+
+void BenchmarkMpmcQueue()
+{
+	EASTLTest_Printf("MPMC Queue\n");
+
+	EA::StdC::Stopwatch stopwatch1(EA::StdC::Stopwatch::kUnitsNanoseconds);
+	EA::StdC::Stopwatch stopwatch2(EA::StdC::Stopwatch::kUnitsNanoseconds);
+
+	const uint32_t kCount = 1 << 20;
+	const uint32_t threadCounts[] = { 1, 2, 4, 8, 16, 32, 64 };
+	const uint32_t batchSizes[]   = { 1, 16 };
+
+	for(uint32_t nThreadCount : threadCounts)
+	{
+		// The threads may outnumber the hardware threads, in which case the results show
+		// how the queues behave when threads are suspended while they use them.
+		std::thread_pool pool((int)nThreadCount - 1);
+
+		for(uint32_t nBatchSize : batchSizes)
+		{
+			LockedDeque                           lockedDeque;
+			std::fixed_mpmc_queue<uint32_t, 1024> mpmcQueue;
+
+			const uint32_t nSum1 = TestPushPop(stopwatch1, pool, lockedDeque, nThreadCount, kCount, nBatchSize);
+			const uint32_t nSum2 = TestPushPop(stopwatch2, pool, mpmcQueue, nThreadCount, kCount, nBatchSize);
+
+			char name[64];
+			char notes[64];
+			sprintf(name, "mpmc_queue<uint32_t>/%u threads, batch %u", (unsigned)nThreadCount, (unsigned)nBatchSize);
+			sprintf(notes, "%.1f Mvalues/s%s", (double)kCount * 1000.0 / (double)(stopwatch2.GetElapsedTime() ? stopwatch2.GetElapsedTime() : 1),
+			        (nSum1 != nSum2) ? ", values lost" : "");
+
+			Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime(), notes);
+		}
+	}
+}
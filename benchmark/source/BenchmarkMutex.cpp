@@ -0,0 +1,126 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#include "EASTLBenchmark.h"
+#include "EASTLTest.h"
+#include <EAStdC/EAStopwatch.h>
+#include <EASTL/mutex.h>
+#include <EASTL/shared_mutex.h>
+#include <EASTL/thread_pool.h>
+#include <EASTL/internal/thread_support.h>
+#include <stdio.h>
+
+
+using namespace EA;
+
+
+namespace
+{
+	// Gives Internal::mutex, the recursive pthread mutex (or CRITICAL_SECTION) which the
+	// library used before, the shared_mutex interface, so that it's the baseline for both.
+	class InternalMutex
+	{
+	public:
+		void lock()          { mMutex.lock(); }
+		void unlock()        { mMutex.unlock(); }
+		void lock_shared()   { mMutex.lock(); }
+		void unlock_shared() { mMutex.unlock(); }
+
+	protected:
+		std::Internal::mutex mMutex;
+	};
+
+
+	template <typename Mutex>
+	class ExclusiveOnly : public Mutex // Makes lock_shared exclusive, for the mutexes without shared locking.
+	{
+	public:
+		void lock_shared()   { Mutex::lock(); }
+		void unlock_shared() { Mutex::unlock(); }
+	};
+
+
+	// Runs nThreadCount threads which each lock the mutex nCount / nThreadCount times, and
+	// do a little work both inside and outside of it. Every nWriteInterval-th lock is
+	// exclusive and the others are shared, which for mutexes without shared locking
+	// means they're all exclusive.
+	template <typename Mutex>
+	uint64_t TestLock(EA::StdC::Stopwatch& stopwatch, std::thread_pool& pool, Mutex& m, uint32_t nThreadCount, uint32_t nCount, uint32_t nWriteInterval)
+	{
+		uint64_t data[8] = {};
+
+		stopwatch.Restart();
+		pool.parallel_for(nThreadCount, 1, [&](size_t nBegin, size_t nEnd)
+		{
+			uint64_t nLocal = nBegin;
+
+			for(size_t t = nBegin; t < nEnd; t++)
+			{
+				for(uint32_t i = 0; i < nCount / nThreadCount; i++)
+				{
+					if((i % nWriteInterval) == 0)
+					{
+						std::lock_guard<Mutex> lock(m);
+						data[i % 8] += nLocal;
+					}
+					else
+					{
+						m.lock_shared();
+						nLocal += data[i % 8];
+						m.unlock_shared();
+					}
+
+					nLocal = (nLocal * 2862933555777941757ULL) + 3037000493ULL; // Work outside the lock.
+				}
+			}
+		});
+		stopwatch.Stop();
+
+		return data[0];
+	}
+
+} // namespace
+
+
+
+void BenchmarkMutex()
+{
+	EASTLTest_Printf("Mutex\n");
+
+	EA::StdC::Stopwatch stopwatch1(EA::StdC::Stopwatch::kUnitsNanoseconds);
+	EA::StdC::Stopwatch stopwatch2(EA::StdC::Stopwatch::kUnitsNanoseconds);
+
+	const uint32_t kCount = 1 << 20;
+	const uint32_t threadCounts[] = { 1, 2, 4, 8, 16 };
+
+	for(uint32_t nThreadCount : threadCounts)
+	{
+		// The threads may outnumber the hardware threads, in which case the results show
+		// how the locks behave when threads are suspended while they hold them.
+		std::thread_pool pool((int)nThreadCount - 1);
+
+		InternalMutex                         internalMutex;
+		ExclusiveOnly<std::mutex>             mutex;
+		ExclusiveOnly<std::spinlock>          spinlock;
+		std::shared_mutex                     sharedMutex;
+		char                                  name[64];
+
+		// Exclusive locking.
+		TestLock(stopwatch1, pool, internalMutex, nThreadCount, kCount, 1);
+		TestLock(stopwatch2, pool, mutex, nThreadCount, kCount, 1);
+		sprintf(name, "mutex/%u threads", (unsigned)nThreadCount);
+		Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+		TestLock(stopwatch2, pool, spinlock, nThreadCount, kCount, 1);
+		sprintf(name, "spinlock/%u threads", (unsigned)nThreadCount);
+		Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+		// Read-mostly locking, with one write per 16 locks.
+		TestLock(stopwatch1, pool, internalMutex, nThreadCount, kCount, 16);
+		TestLock(stopwatch2, pool, sharedMutex, nThreadCount, kCount, 16);
+		sprintf(name, "shared_mutex/%u threads, 1/16 writes", (unsigned)nThreadCount);
+		Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+	}
+}
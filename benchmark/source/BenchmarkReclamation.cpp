@@ -0,0 +1,247 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#include "EASTLBenchmark.h"
+#include "EASTLTest.h"
+#include <EAStdC/EAStopwatch.h>
+#include <EASTL/hazard_pointer.h>
+#include <EASTL/rcu.h>
+#include <EASTL/mutex.h>
+#include <EASTL/thread_pool.h>
+#include <EASTL/internal/thread_support.h>
+#include <stdio.h>
+
+
+using namespace EA;
+
+
+namespace
+{
+	// Each scheme publishes a node which readers read a value from, and which writers
+	// replace, deleting the old node once no reader can be using it. The baseline is
+	// what code without safe reclamation writes: the pointer is guarded by a mutex,
+	// which readers hold while they use the node.
+
+	class MutexScheme
+	{
+	public:
+		struct Node
+		{
+			explicit Node(uint64_t nValue) : mnValue(nValue) {}
+			uint64_t mnValue;
+		};
+
+		MutexScheme() : mpNode(new Node(0)) {}
+		~MutexScheme() { delete mpNode; }
+
+		uint64_t Read()
+		{
+			std::Internal::auto_mutex lock(mMutex);
+			return mpNode->mnValue;
+		}
+
+		void Replace(uint64_t nValue)
+		{
+			Node* const pNode = new Node(nValue);
+			Node* pOld;
+			{
+				std::Internal::auto_mutex lock(mMutex);
+				pOld   = mpNode;
+				mpNode = pNode;
+			}
+			delete pOld;
+		}
+
+	protected:
+		std::Internal::mutex mMutex;
+		Node*                mpNode;
+	};
+
+
+	class HazardPointerScheme
+	{
+	public:
+		struct Node : public std::hazard_pointer_obj_base<Node>
+		{
+			explicit Node(uint64_t nValue) : mnValue(nValue) {}
+			uint64_t mnValue;
+		};
+
+		HazardPointerScheme() : mpNode(new Node(0)) {}
+		~HazardPointerScheme() { mpNode.load()->retire(); std::hazard_pointer_reclaim(); }
+
+		uint64_t Read()
+		{
+			std::hazard_pointer hp = std::make_hazard_pointer();
+			return hp.protect(mpNode)->mnValue;
+		}
+
+		void Replace(uint64_t nValue)
+		{
+			mpNode.exchange(new Node(nValue), std::memory_order_acq_rel)->retire();
+		}
+
+	protected:
+		std::atomic<Node*> mpNode;
+	};
+
+
+	class RcuScheme
+	{
+	public:
+		struct Node : public std::rcu_obj_base<Node>
+		{
+			explicit Node(uint64_t nValue) : mnValue(nValue) {}
+			uint64_t mnValue;
+		};
+
+		RcuScheme() : mpNode(new Node(0)) {}
+		~RcuScheme() { mpNode.load()->retire(); std::rcu_barrier(); }
+
+		uint64_t Read()
+		{
+			std::lock_guard<std::rcu_domain> lock(std::rcu_default_domain());
+			return mpNode.load(std::memory_order_acquire)->mnValue;
+		}
+
+		void Replace(uint64_t nValue)
+		{
+			mpNode.exchange(new Node(nValue), std::memory_order_acq_rel)->retire();
+		}
+
+	protected:
+		std::atomic<Node*> mpNode;
+	};
+
+
+	template <typename Scheme>
+	void TestRead(EA::StdC::Stopwatch& stopwatch, Scheme& scheme, uint32_t nCount)
+	{
+		uint64_t nSum = 0;
+
+		stopwatch.Restart();
+		for(uint32_t i = 0; i < nCount; i++)
+			nSum += scheme.Read();
+		stopwatch.Stop();
+
+		Benchmark::DoNothing(&nSum);
+	}
+
+
+	template <typename Scheme>
+	void TestReplace(EA::StdC::Stopwatch& stopwatch, Scheme& scheme, uint32_t nCount)
+	{
+		stopwatch.Restart();
+		for(uint32_t i = 0; i < nCount; i++)
+			scheme.Replace(i);
+		stopwatch.Stop();
+	}
+
+
+	// Runs nReaderCount threads which each read nCount / nReaderCount times, and one
+	// thread which replaces the node once for every nWriteInterval reads of a reader.
+	template <typename Scheme>
+	void TestReadWrite(EA::StdC::Stopwatch& stopwatch, std::thread_pool& pool, Scheme& scheme, uint32_t nReaderCount, uint32_t nCount, uint32_t nWriteInterval)
+	{
+		std::atomic<uint64_t> nSum(0);
+
+		stopwatch.Restart();
+		pool.parallel_for(nReaderCount + 1, 1, [&](size_t nBegin, size_t nEnd)
+		{
+			for(size_t t = nBegin; t < nEnd; t++)
+			{
+				if(t == 0)
+				{
+					for(uint32_t i = 0; i < nCount / nReaderCount / nWriteInterval; i++)
+						scheme.Replace(i);
+				}
+				else
+				{
+					uint64_t nLocal = 0;
+
+					for(uint32_t i = 0; i < nCount / nReaderCount; i++)
+						nLocal += scheme.Read();
+
+					nSum.fetch_add(nLocal, std::memory_order_relaxed);
+				}
+			}
+		});
+		stopwatch.Stop();
+
+		Benchmark::DoNothing(&nSum);
+	}
+
+
+	void AddReadResult(const char* pName, EA::StdC::Stopwatch& stopwatch1, EA::StdC::Stopwatch& stopwatch2, uint32_t nCount, const char* pUnit)
+	{
+		char notes[64];
+		sprintf(notes, "%.1f ns per %s", (double)stopwatch2.GetElapsedTime() / nCount, pUnit);
+		Benchmark::AddResult(pName, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime(), notes);
+	}
+
+} // namespace
+
+
+
+void BenchmarkReclamation()
+{
+	EASTLTest_Printf("Reclamation\n");
+
+	EA::StdC::Stopwatch stopwatch1(EA::StdC::Stopwatch::kUnitsNanoseconds);
+	EA::StdC::Stopwatch stopwatch2(EA::StdC::Stopwatch::kUnitsNanoseconds);
+
+	const uint32_t kCount = 1000000;
+
+	// The pool is created first so that uncontended mutexes don't take the fast path
+	// which glibc uses while a process has only one thread.
+	std::thread_pool pool(3);
+
+	{
+		MutexScheme         mutexScheme;
+		HazardPointerScheme hazardPointerScheme;
+		RcuScheme           rcuScheme;
+
+		TestRead(stopwatch1, mutexScheme, kCount);
+		TestRead(stopwatch2, hazardPointerScheme, kCount);
+		AddReadResult("hazard_pointer/read", stopwatch1, stopwatch2, kCount, "read");
+
+		TestRead(stopwatch1, mutexScheme, kCount);
+		TestRead(stopwatch2, rcuScheme, kCount);
+		AddReadResult("rcu/read", stopwatch1, stopwatch2, kCount, "read");
+
+		TestReplace(stopwatch1, mutexScheme, kCount / 10);
+		TestReplace(stopwatch2, hazardPointerScheme, kCount / 10);
+		AddReadResult("hazard_pointer/replace and retire", stopwatch1, stopwatch2, kCount / 10, "retire");
+
+		TestReplace(stopwatch1, mutexScheme, kCount / 10);
+		TestReplace(stopwatch2, rcuScheme, kCount / 10);
+		AddReadResult("rcu/replace and retire", stopwatch1, stopwatch2, kCount / 10, "retire");
+	}
+
+	for(uint32_t nReaderCount = 1; nReaderCount <= 3; nReaderCount += 2)
+	{
+		char name[64];
+
+		{
+			MutexScheme         mutexScheme;
+			HazardPointerScheme hazardPointerScheme;
+
+			TestReadWrite(stopwatch1, pool, mutexScheme, nReaderCount, kCount, 16);
+			TestReadWrite(stopwatch2, pool, hazardPointerScheme, nReaderCount, kCount, 16);
+			sprintf(name, "hazard_pointer/%u readers, 1 writer", (unsigned)nReaderCount);
+			AddReadResult(name, stopwatch1, stopwatch2, kCount, "read");
+		}
+
+		{
+			MutexScheme mutexScheme;
+			RcuScheme   rcuScheme;
+
+			TestReadWrite(stopwatch1, pool, mutexScheme, nReaderCount, kCount, 16);
+			TestReadWrite(stopwatch2, pool, rcuScheme, nReaderCount, kCount, 16);
+			sprintf(name, "rcu/%u readers, 1 writer", (unsigned)nReaderCount);
+			AddReadResult(name, stopwatch1, stopwatch2, kCount, "read");
+		}
+	}
+}
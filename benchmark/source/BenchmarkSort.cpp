@@ -5,7 +5,9 @@
 
 #include <EASTL/bonus/sort_extra.h>
 #include <EASTL/sort>
+#include <EASTL/parallel_sort.h>
 #include <EASTL/vector>
+#include <EASTL/string.h>
 #include <EAStdC/EAStopwatch.h>
 #include "EASTLBenchmark.h"
 #include "EASTLTest.h"
@@ -38,6 +40,14 @@ namespace
 		}
 	};
 
+	struct VPKeyCompare
+	{
+		bool operator()(const ValuePair& vp1, const ValuePair& vp2) const
+		{
+			return (vp1.key < vp2.key);
+		}
+	};
+
 	bool operator<(const ValuePair& vp1, const ValuePair& vp2)
 	{
 		// return *(const uint64_t*)&vp1 < *(const uint64_t*)&vp2;
@@ -68,6 +78,8 @@ typedef std::vector<uint32_t>   EaVectorInt;
 typedef std::vector<TestObject>   StdVectorTO;
 typedef std::vector<TestObject> EaVectorTO;
 
+typedef std::vector<std::string> EaVectorString;
+
 
 namespace
 {
@@ -87,6 +99,14 @@ namespace
 	EA_PREFIX_NO_INLINE void TestQuickSortEaInt (EA::StdC::Stopwatch& stopwatch, EaVectorInt&  eaVectorInt)  EA_POSTFIX_NO_INLINE;
 	EA_PREFIX_NO_INLINE void TestQuickSortStdTO (EA::StdC::Stopwatch& stopwatch, StdVectorTO&  stdVectorTO)  EA_POSTFIX_NO_INLINE;
 	EA_PREFIX_NO_INLINE void TestQuickSortEaTO  (EA::StdC::Stopwatch& stopwatch, EaVectorTO&   eaVectorTO)   EA_POSTFIX_NO_INLINE;
+	EA_PREFIX_NO_INLINE void TestParallelSortVP      (EA::StdC::Stopwatch& stopwatch, EaVectorVP& eaVectorVP) EA_POSTFIX_NO_INLINE;
+	EA_PREFIX_NO_INLINE void TestParallelStableSortVP(EA::StdC::Stopwatch& stopwatch, EaVectorVP& eaVectorVP) EA_POSTFIX_NO_INLINE;
+	EA_PREFIX_NO_INLINE void TestStableSortVP        (EA::StdC::Stopwatch& stopwatch, EaVectorVP& eaVectorVP) EA_POSTFIX_NO_INLINE;
+	EA_PREFIX_NO_INLINE void TestSortString          (EA::StdC::Stopwatch& stopwatch, EaVectorString& eaVectorString) EA_POSTFIX_NO_INLINE;
+	EA_PREFIX_NO_INLINE void TestStableSortString    (EA::StdC::Stopwatch& stopwatch, EaVectorString& eaVectorString) EA_POSTFIX_NO_INLINE;
+	EA_PREFIX_NO_INLINE void TestStringSortString    (EA::StdC::Stopwatch& stopwatch, EaVectorString& eaVectorString) EA_POSTFIX_NO_INLINE;
+	EA_PREFIX_NO_INLINE void TestInsertionSortTiny   (EA::StdC::Stopwatch& stopwatch, EaVectorInt& eaVectorInt) EA_POSTFIX_NO_INLINE;
+	EA_PREFIX_NO_INLINE void TestStaticSortTiny      (EA::StdC::Stopwatch& stopwatch, EaVectorInt& eaVectorInt) EA_POSTFIX_NO_INLINE;
 
 
 
@@ -143,6 +163,82 @@ namespace
 		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)eaVectorTO[0].mX);
 	}
 
+
+	void TestParallelSortVP(EA::StdC::Stopwatch& stopwatch, EaVectorVP& eaVectorVP)
+	{
+		stopwatch.Restart();
+		std::parallel_sort(eaVectorVP.begin(), eaVectorVP.end());
+		stopwatch.Stop();
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)eaVectorVP[0].key);
+	}
+
+
+	void TestStableSortVP(EA::StdC::Stopwatch& stopwatch, EaVectorVP& eaVectorVP)
+	{
+		stopwatch.Restart();
+		std::stable_sort(eaVectorVP.begin(), eaVectorVP.end(), VPKeyCompare());
+		stopwatch.Stop();
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)eaVectorVP[0].key);
+	}
+
+
+	void TestParallelStableSortVP(EA::StdC::Stopwatch& stopwatch, EaVectorVP& eaVectorVP)
+	{
+		stopwatch.Restart();
+		std::parallel_stable_sort(eaVectorVP.begin(), eaVectorVP.end(), VPKeyCompare());
+		stopwatch.Stop();
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)eaVectorVP[0].key);
+	}
+
+
+	void TestSortString(EA::StdC::Stopwatch& stopwatch, EaVectorString& eaVectorString)
+	{
+		stopwatch.Restart();
+		std::sort(eaVectorString.begin(), eaVectorString.end());
+		stopwatch.Stop();
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)eaVectorString[0].size());
+	}
+
+
+	void TestStableSortString(EA::StdC::Stopwatch& stopwatch, EaVectorString& eaVectorString)
+	{
+		stopwatch.Restart();
+		std::stable_sort(eaVectorString.begin(), eaVectorString.end());
+		stopwatch.Stop();
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)eaVectorString[0].size());
+	}
+
+
+	void TestStringSortString(EA::StdC::Stopwatch& stopwatch, EaVectorString& eaVectorString)
+	{
+		stopwatch.Restart();
+		std::string_sort(eaVectorString.begin(), eaVectorString.end());
+		stopwatch.Stop();
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)eaVectorString[0].size());
+	}
+
+
+	const eastl_size_t kTinySortSize = 16;
+
+	void TestInsertionSortTiny(EA::StdC::Stopwatch& stopwatch, EaVectorInt& eaVectorInt)
+	{
+		stopwatch.Restart();
+		for (eastl_size_t i = 0, iEnd = eaVectorInt.size(); i < iEnd; i += kTinySortSize)
+			std::insertion_sort(eaVectorInt.begin() + i, eaVectorInt.begin() + i + kTinySortSize);
+		stopwatch.Stop();
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)eaVectorInt[0]);
+	}
+
+
+	void TestStaticSortTiny(EA::StdC::Stopwatch& stopwatch, EaVectorInt& eaVectorInt)
+	{
+		stopwatch.Restart();
+		for (eastl_size_t i = 0, iEnd = eaVectorInt.size(); i < iEnd; i += kTinySortSize)
+			std::static_sort<kTinySortSize>(eaVectorInt.begin() + i);
+		stopwatch.Stop();
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)eaVectorInt[0]);
+	}
+
 } // namespace
 
 
@@ -160,6 +256,7 @@ namespace
 		sf_selection_sort,    // std::selection_sort
 		sf_shaker_sort,       // std::shaker_sort
 		sf_quick_sort,        // std::quick_sort
+		sf_pdq_sort,          // std::pdq_sort
 		sf_tim_sort,          // std::tim_sort
 		sf_insertion_sort,    // std::insertion_sort
 		sf_std_sort,          // std::sort
@@ -173,7 +270,10 @@ namespace
 		switch (sortFunctionType)
 		{
 			case sf_quick_sort:
-				return "std::sort";
+				return "std::quick_sort";
+
+			case sf_pdq_sort:
+				return "std::pdq_sort";
 
 			case sf_tim_sort:
 				return "std::tim_sort";
@@ -229,6 +329,8 @@ namespace
 		kRandomSorted,  // Random values already sorted.
 		kOrdered,                   // Already sorted.
 		kMostlyOrdered,             // Partly sorted already.
+		kReverseOrdered,            // Sorted in reverse.
+		kFewUnique,                 // Random values from a small set, thus with many duplicates.
 		kRandomizationTypeCount
 	};
 
@@ -248,6 +350,12 @@ namespace
 			case kMostlyOrdered:
 				return "mostly ordered";
 
+			case kReverseOrdered:
+				return "reverse ordered";
+
+			case kFewUnique:
+				return "few unique";
+
 			default:
 				return "unknown";
 		}
@@ -304,6 +412,22 @@ namespace
 
 				break;
 			}
+
+			case kReverseOrdered:
+			{
+				for(eastl_size_t i = 0, s = v.size(); i < s; ++i)
+					v[i] = value_type((value_type)(s - i));
+
+				break;
+			}
+
+			case kFewUnique:
+			{
+				for(eastl_size_t i = 0; i < v.size(); ++i)
+					v[i] = value_type((value_type)rng.mRand.RandLimit(16));
+
+				break;
+			}
 		}
 	}
 
@@ -514,6 +638,12 @@ int CompareSortPerformance()
 								stopwatch.Stop();
 								break;
 
+							case sf_pdq_sort:
+								stopwatch.Restart();
+								std::pdq_sort(v.begin(), v.end(), CompareFunction());
+								stopwatch.Stop();
+								break;
+
 							case sf_tim_sort:
 								stopwatch.Restart();
 								std::tim_sort_buffer(v.begin(), v.end(), pBuffer, CompareFunction());
@@ -692,6 +822,12 @@ int CompareSortPerformance()
 								stopwatch.Stop();
 								break;
 
+							case sf_pdq_sort:
+								stopwatch.Restart();
+								std::pdq_sort(v.begin(), v.end(), CompareFunction());
+								stopwatch.Stop();
+								break;
+
 							case sf_tim_sort:
 								stopwatch.Restart();
 								std::tim_sort_buffer(v.begin(), v.end(), pBuffer, CompareFunction());
@@ -869,6 +1005,12 @@ int CompareSortPerformance()
 								stopwatch.Stop();
 								break;
 
+							case sf_pdq_sort:
+								stopwatch.Restart();
+								std::pdq_sort(v.begin(), v.end(), CompareFunction());
+								stopwatch.Stop();
+								break;
+
 							case sf_tim_sort:
 								stopwatch.Restart();
 								std::tim_sort_buffer(v.begin(), v.end(), pBuffer, CompareFunction());
@@ -1055,6 +1197,15 @@ static int CompareSmallInputSortPerformanceHelper(std::vector<eastl_size_t> &arr
 							stopwatch.Stop();
 							break;
 
+						case sf_pdq_sort:
+							stopwatch.Restart();
+							for (auto begin = v.begin(); begin != v.end(); begin += size)
+							{
+								std::pdq_sort(begin, begin + size, CompareFunction());
+							}
+							stopwatch.Stop();
+							break;
+
 						case sf_tim_sort:
 							stopwatch.Restart();
 							for (auto begin = v.begin(); begin != v.end(); begin += size)
@@ -1391,6 +1542,118 @@ void BenchmarkSort()
 				Benchmark::AddResult("sort/q_sort/TestObject[]/sorted", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
 		}
 	}
+
+	{
+		// parallel_sort and parallel_stable_sort versus their serial counterparts on
+		// thread_pool::get_default(). The first column is the serial time.
+		std::vector<uint32_t> intVector(1000000);
+		std::generate(intVector.begin(), intVector.end(), rng);
+
+		for (int i = 0; i < 2; i++)
+		{
+			///////////////////////////////
+			// Test parallel_sort/vector/ValuePair
+			///////////////////////////////
+
+			EaVectorVP serialVP(intVector.size());
+			EaVectorVP parallelVP(intVector.size());
+
+			for (eastl_size_t j = 0, jEnd = intVector.size(); j < jEnd; j++)
+			{
+				const ValuePair vp = {intVector[j], (uint32_t)j};
+				serialVP[j] = vp;
+				parallelVP[j] = vp;
+			}
+
+			TestQuickSortEaVP (stopwatch1, serialVP);
+			TestParallelSortVP(stopwatch2, parallelVP);
+
+			if(i == 1)
+				Benchmark::AddResult("sort/parallel_sort/vector<ValuePair>", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+
+			///////////////////////////////
+			// Test parallel_stable_sort/vector/ValuePair
+			///////////////////////////////
+
+			for (eastl_size_t j = 0, jEnd = intVector.size(); j < jEnd; j++)
+			{
+				const ValuePair vp = {intVector[j] % 1000, (uint32_t)j}; // Many equal keys.
+				serialVP[j] = vp;
+				parallelVP[j] = vp;
+			}
+
+			TestStableSortVP        (stopwatch1, serialVP);
+			TestParallelStableSortVP(stopwatch2, parallelVP);
+
+			if(i == 1)
+				Benchmark::AddResult("sort/parallel_stable_sort/vector<ValuePair>", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+		}
+	}
+
+	{
+		// string_sort versus sort and stable_sort, which are the first column, on words which 
+		// share prefixes of various lengths, like those of a dictionary.
+		const char* const kPrefixes[] = { "", "co", "com", "comp", "compute", "computer", "inter", "international", "pre", "un", "under" };
+
+		EaVectorString words(1000000);
+		for (eastl_size_t j = 0, jEnd = words.size(); j < jEnd; j++)
+		{
+			words[j] = kPrefixes[rng.mRand.RandLimit((uint32_t)EAArrayCount(kPrefixes))];
+			for (uint32_t k = 0, kEnd = 2 + rng.mRand.RandLimit(10); k < kEnd; k++)
+				words[j].push_back((char)('a' + rng.mRand.RandLimit(26)));
+		}
+
+		for (int i = 0; i < 2; i++)
+		{
+			///////////////////////////////
+			// Test string_sort/vector/string
+			///////////////////////////////
+
+			EaVectorString sortWords(words);
+			EaVectorString stringSortWords(words);
+
+			TestSortString      (stopwatch1, sortWords);
+			TestStringSortString(stopwatch2, stringSortWords);
+
+			if(i == 1)
+				Benchmark::AddResult("sort/string_sort/vector<string>", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+			sortWords       = words;
+			stringSortWords = words;
+
+			TestStableSortString(stopwatch1, sortWords);
+			TestStringSortString(stopwatch2, stringSortWords);
+
+			if(i == 1)
+				Benchmark::AddResult("sort/string_sort/vector<string>/vs stable_sort", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+		}
+	}
+
+	{
+		// static_sort versus insertion_sort, which is the first column, on many arrays of 16 
+		// elements, as sorted by median filters and top-k selection.
+		EaVectorInt ints(kTinySortSize * 65536);
+		for (eastl_size_t j = 0, jEnd = ints.size(); j < jEnd; j++)
+			ints[j] = rng.mRand.Rand();
+
+		for (int i = 0; i < 2; i++)
+		{
+			///////////////////////////////
+			// Test static_sort/uint32[16]
+			///////////////////////////////
+
+			EaVectorInt insertionSortInts(ints);
+			EaVectorInt staticSortInts(ints);
+
+			TestInsertionSortTiny(stopwatch1, insertionSortInts);
+			TestStaticSortTiny   (stopwatch2, staticSortInts);
+
+			if(i == 1)
+				Benchmark::AddResult("sort/static_sort/uint32[16]", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+		}
+	}
 }
 
 
@@ -0,0 +1,256 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#include "EASTLBenchmark.h"
+#include "EASTLTest.h"
+#include <EAStdC/EAStopwatch.h>
+#include <EASTL/spsc_queue.h>
+#include <EASTL/thread_pool.h>
+#include <EASTL/bonus/ring_buffer.h>
+#include <EASTL/internal/thread_support.h>
+#include <stdio.h>
+
+#if defined(EA_PLATFORM_LINUX)
+	#include <pthread.h>
+	#include <sched.h>
+#endif
+
+
+using namespace EA;
+
+
+namespace
+{
+	const uint32_t kCapacity = 1024;
+
+
+	// The alternative to spsc_queue: a ring_buffer guarded by a mutex.
+	class LockedRingBuffer
+	{
+	public:
+		LockedRingBuffer() : mBuffer(kCapacity) {}
+
+		bool try_push(uint32_t value)
+		{
+			std::Internal::auto_mutex lock(mMutex);
+			if(mBuffer.size() == kCapacity)
+				return false;
+			mBuffer.push_back(value);
+			return true;
+		}
+
+		bool try_pop(uint32_t& value)
+		{
+			std::Internal::auto_mutex lock(mMutex);
+			if(mBuffer.empty())
+				return false;
+			value = mBuffer.front();
+			mBuffer.pop_front();
+			return true;
+		}
+
+		eastl_size_t push_n(std::span<const uint32_t> values)
+		{
+			std::Internal::auto_mutex lock(mMutex);
+			eastl_size_t i = 0;
+			for(; (i < values.size()) && (mBuffer.size() < kCapacity); i++)
+				mBuffer.push_back(values[i]);
+			return i;
+		}
+
+		eastl_size_t pop_n(std::span<uint32_t> values)
+		{
+			std::Internal::auto_mutex lock(mMutex);
+			eastl_size_t i = 0;
+			for(; (i < values.size()) && !mBuffer.empty(); i++)
+			{
+				values[i] = mBuffer.front();
+				mBuffer.pop_front();
+			}
+			return i;
+		}
+
+	protected:
+		std::Internal::mutex         mMutex;
+		std::ring_buffer<uint32_t>   mBuffer;
+	};
+
+
+	// Restricts the calling thread to the given hardware thread, where supported, so that
+	// the producer and consumer stay on different cores for the whole measurement.
+	void PinThread(int nCpu)
+	{
+		#if defined(EA_PLATFORM_LINUX)
+			cpu_set_t cpuSet;
+			CPU_ZERO(&cpuSet);
+			CPU_SET(nCpu, &cpuSet);
+			pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+		#else
+			EA_UNUSED(nCpu);
+		#endif
+	}
+
+
+	// Passes nCount values from the calling thread to a pool thread, in batches of
+	// nBatchSize values (or singly if nBatchSize is 1), and returns the number of
+	// values which arrived out of order.
+	template <typename Queue>
+	uint32_t TestThroughput(EA::StdC::Stopwatch& stopwatch, std::thread_pool& pool, Queue& queue, uint32_t nCount, uint32_t nBatchSize)
+	{
+		uint32_t nWrongCount = 0;
+
+		stopwatch.Restart();
+		pool.parallel_invoke([&]
+		{
+			uint32_t values[64];
+
+			for(uint32_t i = 0; i < nCount; )
+			{
+				if(nBatchSize == 1)
+				{
+					if(queue.try_push(i))
+						i++;
+				}
+				else
+				{
+					for(uint32_t j = 0; j < nBatchSize; j++)
+						values[j] = i + j;
+					i += (uint32_t)queue.push_n(std::span<const uint32_t>(values, nBatchSize));
+				}
+			}
+		},
+		[&]
+		{
+			PinThread(1);
+
+			uint32_t values[64];
+			uint32_t nExpected = 0;
+
+			while(nExpected < nCount)
+			{
+				if(nBatchSize == 1)
+				{
+					uint32_t n;
+					if(queue.try_pop(n) && (n != nExpected++))
+						nWrongCount++;
+				}
+				else
+				{
+					for(eastl_size_t j = 0, jEnd = queue.pop_n(std::span<uint32_t>(values, nBatchSize)); j < jEnd; j++)
+					{
+						if(values[j] != nExpected++)
+							nWrongCount++;
+					}
+				}
+			}
+		});
+		stopwatch.Stop();
+
+		return nWrongCount;
+	}
+
+
+	// Sends a value from the calling thread to a pool thread through queue1 and back
+	// through queue2, nCount times, so that each send waits for the last to return.
+	template <typename Queue>
+	void TestRoundTrip(EA::StdC::Stopwatch& stopwatch, std::thread_pool& pool, Queue& queue1, Queue& queue2, uint32_t nCount)
+	{
+		stopwatch.Restart();
+		pool.parallel_invoke([&]
+		{
+			for(uint32_t i = 0; i < nCount; i++)
+			{
+				uint32_t n;
+				queue1.try_push(i);
+				while(!queue2.try_pop(n))
+					std::cpu_pause();
+			}
+		},
+		[&]
+		{
+			PinThread(1);
+
+			for(uint32_t i = 0; i < nCount; i++)
+			{
+				uint32_t n;
+				while(!queue1.try_pop(n))
+					std::cpu_pause();
+				queue2.try_push(n);
+			}
+		});
+		stopwatch.Stop();
+	}
+
+} // namespace
+
+
+
+void BenchmarkSpscQueue()
+{
+	EASTLTest_Printf("SPSC Queue\n");
+
+	// The two threads spin on each other, so without two hardware threads to run
+	// them at once a measurement would mostly time the scheduler's time slices.
+	if(std::thread_pool::hardware_concurrency() < 2)
+	{
+		EASTLTest_Printf("   Skipped: fewer than two hardware threads.\n");
+		return;
+	}
+
+	#if defined(EA_PLATFORM_LINUX)
+		cpu_set_t savedCpuSet;
+		pthread_getaffinity_np(pthread_self(), sizeof(savedCpuSet), &savedCpuSet);
+	#endif
+
+	std::thread_pool pool(1);
+	PinThread(0);
+
+	{
+		EA::StdC::Stopwatch stopwatch1(EA::StdC::Stopwatch::kUnitsNanoseconds);
+		EA::StdC::Stopwatch stopwatch2(EA::StdC::Stopwatch::kUnitsNanoseconds);
+
+		const uint32_t kCount = 4000000;
+		const uint32_t batchSizes[] = { 1, 16, 64 };
+
+		for(uint32_t nBatchSize : batchSizes)
+		{
+			LockedRingBuffer                           lockedRingBuffer;
+			std::fixed_spsc_queue<uint32_t, kCapacity> spscQueue;
+
+			uint32_t nWrongCount = TestThroughput(stopwatch1, pool, lockedRingBuffer, kCount, nBatchSize);
+			nWrongCount         += TestThroughput(stopwatch2, pool, spscQueue, kCount, nBatchSize);
+
+			char name[64];
+			char notes[64];
+			sprintf(name, "spsc_queue<uint32_t>/throughput, batch %u", (unsigned)nBatchSize);
+			sprintf(notes, "%.1f Mvalues/s%s", (double)kCount * 1000.0 / (double)(stopwatch2.GetElapsedTime() ? stopwatch2.GetElapsedTime() : 1),
+			        nWrongCount ? ", out of order" : "");
+
+			Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime(), notes);
+		}
+	}
+
+	{
+		EA::StdC::Stopwatch stopwatch1(EA::StdC::Stopwatch::kUnitsNanoseconds);
+		EA::StdC::Stopwatch stopwatch2(EA::StdC::Stopwatch::kUnitsNanoseconds);
+
+		const uint32_t kCount = 200000;
+
+		LockedRingBuffer                           lockedRingBuffer1, lockedRingBuffer2;
+		std::fixed_spsc_queue<uint32_t, kCapacity> spscQueue1, spscQueue2;
+
+		TestRoundTrip(stopwatch1, pool, lockedRingBuffer1, lockedRingBuffer2, kCount);
+		TestRoundTrip(stopwatch2, pool, spscQueue1, spscQueue2, kCount);
+
+		char notes[64];
+		sprintf(notes, "%.0f ns per round trip", (double)stopwatch2.GetElapsedTime() / kCount);
+
+		Benchmark::AddResult("spsc_queue<uint32_t>/latency", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime(), notes);
+	}
+
+	#if defined(EA_PLATFORM_LINUX)
+		pthread_setaffinity_np(pthread_self(), sizeof(savedCpuSet), &savedCpuSet);
+	#endif
+}
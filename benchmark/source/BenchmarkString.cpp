@@ -187,6 +187,89 @@ namespace
 		stopwatch.Stop();
 	}
 
+
+	template <typename Container, typename T> 
+	void TestSearchGeneric(EA::StdC::Stopwatch& stopwatch, Container& c, T* p, int n)
+	{
+		stopwatch.Restart();
+		for(int i = 0; i < 100; i++)
+			Benchmark::DoNothing(&c, std::search(c.begin(), c.end(), p, p + n));
+		stopwatch.Stop();
+	}
+
+
+	template <typename Container, typename T> 
+	void TestSearch(EA::StdC::Stopwatch& stopwatch, Container& c, T* p, int n)
+	{
+		stopwatch.Restart();
+		for(int i = 0; i < 100; i++)
+			Benchmark::DoNothing(&c, c.find(p, 0, (typename Container::size_type)n));
+		stopwatch.Stop();
+	}
+
+
+	template <typename Container, typename T> 
+	void TestFindFirstOfGeneric(EA::StdC::Stopwatch& stopwatch, Container& c, T* p, int n)
+	{
+		stopwatch.Restart();
+		for(int i = 0; i < 100; i++)
+			Benchmark::DoNothing(&c, std::find_first_of(c.begin(), c.end(), p, p + n));
+		stopwatch.Stop();
+	}
+
+
+	template <typename Container, typename T> 
+	void TestFindFirstOf(EA::StdC::Stopwatch& stopwatch, Container& c, T* p, int n)
+	{
+		stopwatch.Restart();
+		for(int i = 0; i < 100; i++)
+			Benchmark::DoNothing(&c, c.find_first_of(p, 0, (typename Container::size_type)n));
+		stopwatch.Stop();
+	}
+
+
+	// Converts UTF-8 to UTF-16 a code point at a time, without validating it, as a baseline for append_convert.
+	void TestConvertScalar(EA::StdC::Stopwatch& stopwatch, const std::string& s, std::u16string& result)
+	{
+		stopwatch.Restart();
+		for(int i = 0; i < 10; i++)
+		{
+			result.clear();
+			for(const uint8_t* p = (const uint8_t*)s.data(), *pEnd = p + s.size(); p != pEnd; )
+			{
+				uint32_t c = *p++;
+				if(c >= 0xf0)
+					{ c = ((c & 0x07) << 18) | ((p[0] & 0x3fu) << 12) | ((p[1] & 0x3fu) << 6) | (p[2] & 0x3fu); p += 3; }
+				else if(c >= 0xe0)
+					{ c = ((c & 0x0f) << 12) | ((p[0] & 0x3fu) << 6) | (p[1] & 0x3fu); p += 2; }
+				else if(c >= 0xc0)
+					{ c = ((c & 0x1f) << 6) | (p[0] & 0x3fu); p += 1; }
+
+				if(c >= 0x10000)
+				{
+					result.push_back((char16_t)(0xd800 + ((c - 0x10000) >> 10)));
+					c = 0xdc00 + (c & 0x3ff);
+				}
+				result.push_back((char16_t)c);
+			}
+			Benchmark::DoNothing(&result);
+		}
+		stopwatch.Stop();
+	}
+
+
+	void TestConvert(EA::StdC::Stopwatch& stopwatch, const std::string& s, std::u16string& result)
+	{
+		stopwatch.Restart();
+		for(int i = 0; i < 10; i++)
+		{
+			result.clear();
+			result.append_convert(s);
+			Benchmark::DoNothing(&result);
+		}
+		stopwatch.Stop();
+	}
+
 } // namespace
 
 
@@ -519,6 +602,78 @@ void BenchmarkString()
 		}
 	}
 
+	{
+		// Searches of a long string of char, such as a log or a payload, which string does with SIMD.
+		// The first column is the generic algorithm the member function specializes.
+		const char* const kWords[] = { "GET ", "/index.html ", "HTTP/1.1 ", "200 ", "user-agent: ", "mozilla ", "timestamp=", "1234567 " };
+
+		std::string text;
+		for(uint32_t j = 0; text.size() < 1000000; j = (j * 1103515245 + 12345))
+			text += kWords[(j >> 16) % EAArrayCount(kWords)];
+
+		const char pPattern[]  = "error: disk full";
+		const char pSpecials[] = "!#$%&*;<>?@~";
+
+		for(int i = 0; i < 2; i++)
+		{
+			///////////////////////////////
+			// Test find(const value_type* p, size_type position, size_type n)
+			///////////////////////////////
+
+			TestSearchGeneric(stopwatch1, text, pPattern, (int)strlen(pPattern));
+			TestSearch       (stopwatch2, text, pPattern, (int)strlen(pPattern));
+
+			if(i == 1)
+				Benchmark::AddResult("string<char>/find/p,pos,n/long", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+			///////////////////////////////
+			// Test find_first_of(const value_type* p, size_type position, size_type n)
+			///////////////////////////////
+
+			TestFindFirstOfGeneric(stopwatch1, text, pSpecials, (int)strlen(pSpecials));
+			TestFindFirstOf       (stopwatch2, text, pSpecials, (int)strlen(pSpecials));
+
+			if(i == 1)
+				Benchmark::AddResult("string<char>/find_first_of/p,pos,n/long", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+		}
+	}
+
+	{
+		// Conversion of a long UTF-8 string to UTF-16, of mostly ASCII (such as markup) and of mostly
+		// other text, which append_convert validates and converts in vectors where it can.
+		const char* const kWords[] = { "<p class=\"x\">", "text ", "caf\xc3\xa9 ", "</p>\n", "\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e", "\xf0\x9f\x98\x80", "\xd0\xbc\xd0\xb8\xd1\x80 " };
+
+		std::string ascii, mixed;
+		for(uint32_t j = 0; mixed.size() < 1000000; j = (j * 1103515245 + 12345))
+		{
+			const uint32_t nWord = (j >> 16) % EAArrayCount(kWords);
+			ascii += kWords[(nWord == 4) ? 1 : (nWord % 4)];
+			mixed += kWords[nWord];
+		}
+
+		std::u16string result1, result2;
+
+		for(int i = 0; i < 2; i++)
+		{
+			///////////////////////////////
+			// Test append_convert(const OtherStringType& x)
+			///////////////////////////////
+
+			TestConvertScalar(stopwatch1, ascii, result1);
+			TestConvert      (stopwatch2, ascii, result2);
+
+			if(i == 1)
+				Benchmark::AddResult("string<char16_t>/append_convert/utf8/ascii", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+			TestConvertScalar(stopwatch1, mixed, result1);
+			TestConvert      (stopwatch2, mixed, result2);
+
+			if(i == 1)
+				Benchmark::AddResult("string<char16_t>/append_convert/utf8/mixed", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+		}
+	}
+
 }
 
 
@@ -0,0 +1,313 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#include "EASTLBenchmark.h"
+#include "EASTLTest.h"
+#include <EAStdC/EAStopwatch.h>
+#include <EASTL/semaphore.h>
+#include <EASTL/latch.h>
+#include <EASTL/barrier.h>
+#include <EASTL/seqlock.h>
+#include <EASTL/thread_pool.h>
+#include <EASTL/internal/thread_support.h>
+#include <new>
+#include <stdio.h>
+
+
+using namespace EA;
+
+
+namespace
+{
+	// The alternatives measured against are what code without these primitives
+	// writes: state guarded by Internal::mutex, which waiting threads poll, yielding
+	// in between.
+
+	class PolledSemaphore
+	{
+	public:
+		explicit PolledSemaphore(int nCount) : mnCount(nCount) {}
+
+		void release()
+		{
+			std::Internal::auto_mutex lock(mMutex);
+			mnCount++;
+		}
+
+		void acquire()
+		{
+			for(;;)
+			{
+				{
+					std::Internal::auto_mutex lock(mMutex);
+					if(mnCount > 0)
+					{
+						mnCount--;
+						return;
+					}
+				}
+				std::Internal::thread_yield();
+			}
+		}
+
+	protected:
+		std::Internal::mutex mMutex;
+		int                  mnCount;
+	};
+
+
+	class PolledLatch
+	{
+	public:
+		explicit PolledLatch(int nCount) : mnCount(nCount) {}
+
+		void count_down()
+		{
+			std::Internal::auto_mutex lock(mMutex);
+			mnCount--;
+		}
+
+		void wait()
+		{
+			for(;;)
+			{
+				{
+					std::Internal::auto_mutex lock(mMutex);
+					if(mnCount == 0)
+						return;
+				}
+				std::Internal::thread_yield();
+			}
+		}
+
+	protected:
+		std::Internal::mutex mMutex;
+		int                  mnCount;
+	};
+
+
+	class PolledBarrier
+	{
+	public:
+		explicit PolledBarrier(int nCount) : mnExpected(nCount), mnRemaining(nCount), mnPhase(0) {}
+
+		void arrive_and_wait()
+		{
+			int nPhase;
+			{
+				std::Internal::auto_mutex lock(mMutex);
+				nPhase = mnPhase;
+				if(--mnRemaining == 0)
+				{
+					mnRemaining = mnExpected;
+					mnPhase++;
+					return;
+				}
+			}
+
+			for(;;)
+			{
+				std::Internal::thread_yield();
+				std::Internal::auto_mutex lock(mMutex);
+				if(mnPhase != nPhase)
+					return;
+			}
+		}
+
+	protected:
+		std::Internal::mutex mMutex;
+		int                  mnExpected;
+		int                  mnRemaining;
+		int                  mnPhase;
+	};
+
+
+	struct Sample
+	{
+		uint64_t mnValue;
+		uint64_t mnTime;
+		uint64_t mnFlags;
+	};
+
+
+	class LockedSample
+	{
+	public:
+		LockedSample() { mSample.mnValue = mSample.mnTime = mSample.mnFlags = 0; }
+
+		void store(const Sample& sample)
+		{
+			std::Internal::auto_mutex lock(mMutex);
+			mSample = sample;
+		}
+
+		Sample load()
+		{
+			std::Internal::auto_mutex lock(mMutex);
+			return mSample;
+		}
+
+	protected:
+		std::Internal::mutex mMutex;
+		Sample               mSample;
+	};
+
+
+	// Passes a turn back and forth between the caller and a worker nCount times, with a
+	// semaphore for each direction.
+	template <typename Semaphore>
+	void TestSemaphorePingPong(EA::StdC::Stopwatch& stopwatch, std::thread_pool& pool, uint32_t nCount)
+	{
+		Semaphore ping(0), pong(0);
+
+		stopwatch.Restart();
+		pool.parallel_invoke([&]
+		{
+			for(uint32_t i = 0; i < nCount; i++)
+			{
+				ping.release();
+				pong.acquire();
+			}
+		},
+		[&]
+		{
+			for(uint32_t i = 0; i < nCount; i++)
+			{
+				ping.acquire();
+				pong.release();
+			}
+		});
+		stopwatch.Stop();
+	}
+
+
+	// Passes a turn back and forth as above, with a new latch for each handoff.
+	template <typename Latch>
+	void TestLatchPingPong(EA::StdC::Stopwatch& stopwatch, std::thread_pool& pool, uint32_t nCount)
+	{
+		void* const pMemory = ::operator new(sizeof(Latch) * nCount * 2);
+		Latch* const pLatches = static_cast<Latch*>(pMemory);
+
+		for(uint32_t i = 0; i < nCount * 2; i++)
+			::new(&pLatches[i]) Latch(1);
+
+		stopwatch.Restart();
+		pool.parallel_invoke([&]
+		{
+			for(uint32_t i = 0; i < nCount; i++)
+			{
+				pLatches[i * 2].count_down();
+				pLatches[i * 2 + 1].wait();
+			}
+		},
+		[&]
+		{
+			for(uint32_t i = 0; i < nCount; i++)
+			{
+				pLatches[i * 2].wait();
+				pLatches[i * 2 + 1].count_down();
+			}
+		});
+		stopwatch.Stop();
+
+		for(uint32_t i = 0; i < nCount * 2; i++)
+			pLatches[i].~Latch();
+		::operator delete(pMemory);
+	}
+
+
+	// Has the caller and a worker meet at a barrier nCount times.
+	template <typename Barrier>
+	void TestBarrier(EA::StdC::Stopwatch& stopwatch, std::thread_pool& pool, uint32_t nCount)
+	{
+		Barrier sync(2);
+
+		stopwatch.Restart();
+		pool.parallel_invoke([&]
+		{
+			for(uint32_t i = 0; i < nCount; i++)
+				sync.arrive_and_wait();
+		},
+		[&]
+		{
+			for(uint32_t i = 0; i < nCount; i++)
+				sync.arrive_and_wait();
+		});
+		stopwatch.Stop();
+	}
+
+
+	// Has the caller publish a sample, which a worker polls for and answers by publishing
+	// a sample of its own, nCount times.
+	template <typename SampleLock>
+	void TestSamplePingPong(EA::StdC::Stopwatch& stopwatch, std::thread_pool& pool, uint32_t nCount)
+	{
+		SampleLock request, response;
+
+		stopwatch.Restart();
+		pool.parallel_invoke([&]
+		{
+			for(uint64_t i = 1; i <= nCount; i++)
+			{
+				const Sample sample = { i, i * 1000, 0 };
+				request.store(sample);
+				while(response.load().mnValue != i)
+					std::Internal::thread_yield();
+			}
+		},
+		[&]
+		{
+			for(uint64_t i = 1; i <= nCount; i++)
+			{
+				while(request.load().mnValue != i)
+					std::Internal::thread_yield();
+				const Sample sample = { i, i * 1000, 1 };
+				response.store(sample);
+			}
+		});
+		stopwatch.Stop();
+	}
+
+
+	void AddLatencyResult(const char* pName, EA::StdC::Stopwatch& stopwatch1, EA::StdC::Stopwatch& stopwatch2, uint32_t nHandoffCount)
+	{
+		char notes[64];
+		sprintf(notes, "%.0f ns per handoff", (double)stopwatch2.GetElapsedTime() / nHandoffCount);
+		Benchmark::AddResult(pName, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime(), notes);
+	}
+
+} // namespace
+
+
+
+void BenchmarkSynchronization()
+{
+	EASTLTest_Printf("Synchronization\n");
+
+	EA::StdC::Stopwatch stopwatch1(EA::StdC::Stopwatch::kUnitsNanoseconds);
+	EA::StdC::Stopwatch stopwatch2(EA::StdC::Stopwatch::kUnitsNanoseconds);
+
+	const uint32_t kCount = 20000;
+
+	// With fewer than two hardware threads, the handoffs measure how fast the OS switches
+	// from one thread to the other, rather than how fast the other notices.
+	std::thread_pool pool(1);
+
+	TestSemaphorePingPong<PolledSemaphore>(stopwatch1, pool, kCount);
+	TestSemaphorePingPong<std::binary_semaphore>(stopwatch2, pool, kCount);
+	AddLatencyResult("binary_semaphore/ping-pong", stopwatch1, stopwatch2, kCount * 2);
+
+	TestLatchPingPong<PolledLatch>(stopwatch1, pool, kCount);
+	TestLatchPingPong<std::latch>(stopwatch2, pool, kCount);
+	AddLatencyResult("latch/ping-pong", stopwatch1, stopwatch2, kCount * 2);
+
+	TestBarrier<PolledBarrier>(stopwatch1, pool, kCount);
+	TestBarrier<std::barrier<>>(stopwatch2, pool, kCount);
+	AddLatencyResult("barrier/2 threads", stopwatch1, stopwatch2, kCount);
+
+	TestSamplePingPong<LockedSample>(stopwatch1, pool, kCount);
+	TestSamplePingPong<std::seqlock<Sample>>(stopwatch2, pool, kCount);
+	AddLatencyResult("seqlock<24 bytes>/ping-pong", stopwatch1, stopwatch2, kCount * 2);
+}
@@ -44,6 +44,12 @@ void BenchmarkAlgorithm();
 void BenchmarkHeap();
 void BenchmarkBitset();
 void BenchmarkTupleVector();
+void BenchmarkLruCache();
+void BenchmarkSpscQueue();
+void BenchmarkMpmcQueue();
+void BenchmarkMutex();
+void BenchmarkSynchronization();
+void BenchmarkReclamation();
 
 
 namespace Benchmark
@@ -157,6 +157,12 @@ int EAMain(int argc, char* argv[])
 	BenchmarkBitset();
 	BenchmarkSort();
 	BenchmarkTupleVector();
+	BenchmarkLruCache();
+	BenchmarkSpscQueue();
+	BenchmarkMpmcQueue();
+	BenchmarkMutex();
+	BenchmarkSynchronization();
+	BenchmarkReclamation();
 
 	stopwatch.Stop();
 
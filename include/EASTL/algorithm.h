@@ -246,6 +246,7 @@
 #include <EASTL/functional.h>
 #include <EASTL/utility.h>
 #include <EASTL/internal/generic_iterator.h>
+#include <EASTL/internal/simd.h>
 #include <EASTL/random.h>
 
 EA_DISABLE_ALL_VC_WARNINGS();
@@ -287,6 +288,148 @@ EA_RESTORE_ALL_VC_WARNINGS();
 
 namespace std
 {
+	namespace Internal
+	{
+		/// simd_element
+		///
+		/// simd_element<Iterator>::value is true if the SIMD kernels of the algorithms
+		/// (see internal/simd.h) process the elements of Iterator, and type is the type
+		/// they process them as. They process the elements of pointers to float, double
+		/// and the integer types, the latter as the fixed size integer type of their size
+		/// and signedness, as the algorithms for other iterators can't tell if their
+		/// elements are contiguous.
+		///
+		template <size_t nSize, bool bSigned> struct simd_integer_type           { typedef void     type; };
+		template <>                           struct simd_integer_type<1, true>  { typedef int8_t   type; };
+		template <>                           struct simd_integer_type<1, false> { typedef uint8_t  type; };
+		template <>                           struct simd_integer_type<2, true>  { typedef int16_t  type; };
+		template <>                           struct simd_integer_type<2, false> { typedef uint16_t type; };
+		template <>                           struct simd_integer_type<4, true>  { typedef int32_t  type; };
+		template <>                           struct simd_integer_type<4, false> { typedef uint32_t type; };
+		template <>                           struct simd_integer_type<8, true>  { typedef int64_t  type; };
+		template <>                           struct simd_integer_type<8, false> { typedef uint64_t type; };
+
+		template <typename T, bool bIntegral = std::is_integral<T>::value>
+		struct simd_arithmetic_type { typedef void type; };
+
+		template <typename T>
+		struct simd_arithmetic_type<T, true> : public simd_integer_type<sizeof(T), std::is_signed<T>::value> { };
+
+		template <> struct simd_arithmetic_type<float,  false> { typedef float  type; };
+		template <> struct simd_arithmetic_type<double, false> { typedef double type; };
+
+		template <typename Iterator>
+		struct simd_element
+		{
+			typedef void type;
+			static const bool value = false;
+		};
+
+		#if EASTL_SIMD_ENABLED
+			template <typename T>
+			struct simd_element<T*>
+			{
+				typedef typename simd_arithmetic_type<typename std::conditional<std::is_volatile<T>::value, void, typename std::remove_const<T>::type>::type>::type type;
+				static const bool value = !std::is_void<type>::value;
+			};
+		#endif
+
+
+		/// simd_value
+		///
+		/// True if the algorithms which compare the elements of Iterator with a value of
+		/// type T (find, count and replace) use the SIMD kernels. T must be the type of the
+		/// elements, as comparing them with another type may convert the elements instead.
+		///
+		template <typename Iterator, typename T>
+		struct simd_value : public std::false_type { };
+
+		template <typename T, typename U>
+		struct simd_value<T*, U>
+			: public std::integral_constant<bool, simd_element<T*>::value && std::is_same<typename std::remove_const<T>::type, U>::value> { };
+
+
+		/// simd_elements
+		///
+		/// True if the algorithms which compare the elements of Iterator1 with those of
+		/// Iterator2 (mismatch and equal) use the SIMD kernels.
+		///
+		template <typename Iterator1, typename Iterator2>
+		struct simd_elements : public std::false_type { };
+
+		template <typename T, typename U>
+		struct simd_elements<T*, U*>
+			: public std::integral_constant<bool, simd_element<T*>::value && std::is_same<typename std::remove_const<T>::type, typename std::remove_const<U>::type>::value> { };
+
+
+		template <typename ForwardIterator>
+		ForwardIterator min_element_impl(ForwardIterator first, ForwardIterator last, std::false_type)
+		{
+			if(first != last)
+			{
+				ForwardIterator currentMin = first;
+
+				while(++first != last)
+				{
+					if(*first < *currentMin)
+						currentMin = first;
+				}
+				return currentMin;
+			}
+			return first;
+		}
+
+		template <typename ForwardIterator>
+		ForwardIterator max_element_impl(ForwardIterator first, ForwardIterator last, std::false_type)
+		{
+			if(first != last)
+			{
+				ForwardIterator currentMax = first;
+
+				while(++first != last)
+				{
+					if(*currentMax < *first)
+						currentMax = first;
+				}
+				return currentMax;
+			}
+			return first;
+		}
+
+		#if EASTL_SIMD_ENABLED
+			template <typename T>
+			T* min_element_impl(T* first, T* last, std::true_type)
+			{
+				typedef typename simd_element<T*>::type simd_type;
+
+				if((last - first) >= EASTL_SIMD_MIN_RANGE_SIZE)
+				{
+					const simd_type* const pMin = Internal::simd_min_element((const simd_type*)first, (const simd_type*)last);
+
+					if(pMin) // NULL if the range has a NaN.
+						return first + (pMin - (const simd_type*)first);
+				}
+				return Internal::min_element_impl(first, last, std::false_type());
+			}
+
+			template <typename T>
+			T* max_element_impl(T* first, T* last, std::true_type)
+			{
+				typedef typename simd_element<T*>::type simd_type;
+
+				if((last - first) >= EASTL_SIMD_MIN_RANGE_SIZE)
+				{
+					const simd_type* const pMax = Internal::simd_max_element((const simd_type*)first, (const simd_type*)last);
+
+					if(pMax)
+						return first + (pMax - (const simd_type*)first);
+				}
+				return Internal::max_element_impl(first, last, std::false_type());
+			}
+		#endif
+	}
+
+
 	/// min_element
 	///
 	/// min_element finds the smallest element in the range [first, last).
@@ -301,21 +444,13 @@ namespace std
 	/// Complexity: Exactly 'max((last - first) - 1, 0)' applications of the
 	/// corresponding comparisons.
 	///
+	/// Ranges of arithmetic types given by pointers are searched with SIMD
+	/// instructions, if enabled (see EASTL_SIMD_ENABLED).
+	///
 	template <typename ForwardIterator>
 	ForwardIterator min_element(ForwardIterator first, ForwardIterator last)
 	{
-		if(first != last)
-		{
-			ForwardIterator currentMin = first;
-
-			while(++first != last)
-			{
-				if(*first < *currentMin)
-					currentMin = first;
-			}
-			return currentMin;
-		}
-		return first;
+		return Internal::min_element_impl(first, last, std::integral_constant<bool, Internal::simd_element<ForwardIterator>::value>());
 	}
 
 
@@ -365,21 +500,13 @@ namespace std
 	/// Complexity: Exactly 'max((last - first) - 1, 0)' applications of the
 	/// corresponding comparisons.
 	///
+	/// Ranges of arithmetic types given by pointers are searched with SIMD
+	/// instructions, if enabled (see EASTL_SIMD_ENABLED).
+	///
 	template <typename ForwardIterator>
 	ForwardIterator max_element(ForwardIterator first, ForwardIterator last)
 	{
-		if(first != last)
-		{
-			ForwardIterator currentMax = first;
-
-			while(++first != last)
-			{
-				if(*currentMax < *first)
-					currentMax = first;
-			}
-			return currentMax;
-		}
-		return first;
+		return Internal::max_element_impl(first, last, std::integral_constant<bool, Internal::simd_element<ForwardIterator>::value>());
 	}
 
 
@@ -728,13 +855,42 @@ namespace std
 	}
 
 
+	namespace Internal
+	{
+		template <typename ForwardIterator>
+		std::pair<ForwardIterator, ForwardIterator>
+		minmax_element_impl(ForwardIterator first, ForwardIterator last, std::false_type)
+		{
+			typedef typename std::iterator_traits<ForwardIterator>::value_type value_type;
+
+			return std::minmax_element(first, last, std::less<value_type>());
+		}
+
+		#if EASTL_SIMD_ENABLED
+			template <typename T>
+			std::pair<T*, T*> minmax_element_impl(T* first, T* last, std::true_type)
+			{
+				typedef typename simd_element<T*>::type simd_type;
+
+				const simd_type* pMin;
+				const simd_type* pMax;
+
+				if(((last - first) >= EASTL_SIMD_MIN_RANGE_SIZE) && // The kernel fails if the range has a NaN.
+				   Internal::simd_minmax_element((const simd_type*)first, (const simd_type*)last, pMin, pMax))
+				{
+					return std::pair<T*, T*>(first + (pMin - (const simd_type*)first), first + (pMax - (const simd_type*)first));
+				}
+				return Internal::minmax_element_impl(first, last, std::false_type());
+			}
+		#endif
+	}
+
+
 	template <typename ForwardIterator>
 	std::pair<ForwardIterator, ForwardIterator>
 	minmax_element(ForwardIterator first, ForwardIterator last)
 	{
-		typedef typename std::iterator_traits<ForwardIterator>::value_type value_type;
-
-		return std::minmax_element(first, last, std::less<value_type>());
+		return Internal::minmax_element_impl(first, last, std::integral_constant<bool, Internal::simd_element<ForwardIterator>::value>());
 	}
 
 
@@ -1331,6 +1487,36 @@ namespace std
 	}
 
 
+	namespace Internal
+	{
+		template <typename InputIterator, typename T>
+		inline typename std::iterator_traits<InputIterator>::difference_type
+		count_impl(InputIterator first, InputIterator last, const T& value, std::false_type)
+		{
+			typename std::iterator_traits<InputIterator>::difference_type result = 0;
+
+			for(; first != last; ++first)
+			{
+				if(*first == value)
+					++result;
+			}
+			return result;
+		}
+
+		#if EASTL_SIMD_ENABLED
+			template <typename T, typename U>
+			inline ptrdiff_t count_impl(T* first, T* last, const U& value, std::true_type)
+			{
+				typedef typename simd_element<T*>::type simd_type;
+
+				if((last - first) >= EASTL_SIMD_MIN_RANGE_SIZE)
+					return (ptrdiff_t)Internal::simd_count((const simd_type*)first, (const simd_type*)last, (simd_type)value);
+				return Internal::count_impl(first, last, value, std::false_type());
+			}
+		#endif
+	}
+
+
 	/// count
 	///
 	/// Counts the number of items in the range of [first, last) which equal the input value.
@@ -1343,18 +1529,15 @@ namespace std
 	/// Note: The predicate version of count is count_if and not another variation of count.
 	/// This is because both versions would have three parameters and there could be ambiguity.
 	///
+	/// Ranges of arithmetic types given by pointers are counted with SIMD
+	/// instructions, if enabled (see EASTL_SIMD_ENABLED) and value is of
+	/// the type of their elements.
+	///
 	template <typename InputIterator, typename T>
 	inline typename std::iterator_traits<InputIterator>::difference_type
 	count(InputIterator first, InputIterator last, const T& value)
 	{
-		typename std::iterator_traits<InputIterator>::difference_type result = 0;
-
-		for(; first != last; ++first)
-		{
-			if(*first == value)
-				++result;
-		}
-		return result;
+		return Internal::count_impl(first, last, value, Internal::simd_value<InputIterator, T>());
 	}
 
 
@@ -1403,6 +1586,31 @@ namespace std
 	}
 
 
+	namespace Internal
+	{
+		template <typename InputIterator, typename T>
+		inline InputIterator
+		find_impl(InputIterator first, InputIterator last, const T& value, std::false_type)
+		{
+			while((first != last) && !(*first == value)) // Note that we always express value comparisons in terms of < or ==.
+				++first;
+			return first;
+		}
+
+		#if EASTL_SIMD_ENABLED
+			template <typename T, typename U>
+			inline T* find_impl(T* first, T* last, const U& value, std::true_type)
+			{
+				typedef typename simd_element<T*>::type simd_type;
+
+				if((last - first) >= EASTL_SIMD_MIN_RANGE_SIZE)
+					return first + (Internal::simd_find((const simd_type*)first, (const simd_type*)last, (simd_type)value) - (const simd_type*)first);
+				return Internal::find_impl(first, last, value, std::false_type());
+			}
+		#endif
+	}
+
+
 	/// find
 	///
 	/// finds the value within the unsorted range of [first, last).
@@ -1417,13 +1625,15 @@ namespace std
 	/// Note: The predicate version of find is find_if and not another variation of find.
 	/// This is because both versions would have three parameters and there could be ambiguity.
 	///
+	/// Ranges of arithmetic types given by pointers are searched with SIMD
+	/// instructions, if enabled (see EASTL_SIMD_ENABLED) and value is of
+	/// the type of their elements.
+	///
 	template <typename InputIterator, typename T>
 	inline InputIterator
 	find(InputIterator first, InputIterator last, const T& value)
 	{
-		while((first != last) && !(*first == value)) // Note that we always express value comparisons in terms of < or ==.
-			++first;
-		return first;
+		return Internal::find_impl(first, last, value, Internal::simd_value<InputIterator, T>());
 	}
 
 
@@ -1841,6 +2051,33 @@ namespace std
 	}
 
 
+	namespace Internal
+	{
+		template <typename InputIterator1, typename InputIterator2>
+		EA_CPP14_CONSTEXPR inline bool equal_impl(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, std::false_type)
+		{
+			for(; first1 != last1; ++first1, ++first2)
+			{
+				if(!(*first1 == *first2)) // Note that we always express value comparisons in terms of < or ==.
+					return false;
+			}
+			return true;
+		}
+
+		#if EASTL_SIMD_ENABLED
+			template <typename T, typename U>
+			EA_CPP14_CONSTEXPR inline bool equal_impl(T* first1, T* last1, U* first2, std::true_type)
+			{
+				typedef typename simd_element<T*>::type simd_type;
+
+				if((last1 - first1) >= EASTL_SIMD_MIN_RANGE_SIZE)
+					return Internal::simd_mismatch_elements((const simd_type*)first1, (const simd_type*)first2, (size_t)(last1 - first1)) == (size_t)(last1 - first1);
+				return Internal::equal_impl(first1, last1, first2, std::false_type());
+			}
+		#endif
+	}
+
+
 	/// equal
 	///
 	/// Returns: true if for every iterator i in the range [first1, last1) the
@@ -1849,60 +2086,17 @@ namespace std
 	///
 	/// Complexity: At most last1 first1 applications of the corresponding predicate.
 	///
-	/// To consider: Make specializations of this for scalar types and random access
-	/// iterators that uses memcmp or some trick memory comparison function.
-	/// We should verify that such a thing results in an improvement.
+	/// Ranges of arithmetic types given by pointers are compared with SIMD
+	/// instructions, if enabled (see EASTL_SIMD_ENABLED). Short ranges are
+	/// compared with scalar code, so that equal can be evaluated at compile
+	/// time for them.
 	///
 	template <typename InputIterator1, typename InputIterator2>
 	EA_CPP14_CONSTEXPR inline bool equal(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2)
 	{
-		for(; first1 != last1; ++first1, ++first2)
-		{
-			if(!(*first1 == *first2)) // Note that we always express value comparisons in terms of < or ==.
-				return false;
-		}
-		return true;
+		return Internal::equal_impl(first1, last1, first2, Internal::simd_elements<InputIterator1, InputIterator2>());
 	}
 
-	/* Enable the following if there was shown to be some benefit. A glance and Microsoft VC++ memcmp
-		shows that it is not optimized in any way, much less one that would benefit us here.
-
-	inline bool equal(const bool* first1, const bool* last1, const bool* first2)
-		{ return (memcmp(first1, first2, (size_t)((uintptr_t)last1 - (uintptr_t)first1)) == 0); }
-
-	inline bool equal(const char* first1, const char* last1, const char* first2)
-		{ return (memcmp(first1, first2, (size_t)((uintptr_t)last1 - (uintptr_t)first1)) == 0); }
-
-	inline bool equal(const unsigned char* first1, const unsigned char* last1, const unsigned char* first2)
-		{ return (memcmp(first1, first2, (size_t)((uintptr_t)last1 - (uintptr_t)first1)) == 0); }
-
-	inline bool equal(const signed char* first1, const signed char* last1, const signed char* first2)
-		{ return (memcmp(first1, first2, (size_t)((uintptr_t)last1 - (uintptr_t)first1)) == 0); }
-
-	#ifndef EA_WCHAR_T_NON_NATIVE
-		inline bool equal(const wchar_t* first1, const wchar_t* last1, const wchar_t* first2)
-			{ return (memcmp(first1, first2, (size_t)((uintptr_t)last1 - (uintptr_t)first1)) == 0); }
-	#endif
-
-	inline bool equal(const int16_t* first1, const int16_t* last1, const int16_t* first2)
-		{ return (memcmp(first1, first2, (size_t)((uintptr_t)last1 - (uintptr_t)first1)) == 0); }
-
-	inline bool equal(const uint16_t* first1, const uint16_t* last1, const uint16_t* first2)
-		{ return (memcmp(first1, first2, (size_t)((uintptr_t)last1 - (uintptr_t)first1)) == 0); }
-
-	inline bool equal(const int32_t* first1, const int32_t* last1, const int32_t* first2)
-		{ return (memcmp(first1, first2, (size_t)((uintptr_t)last1 - (uintptr_t)first1)) == 0); }
-
-	inline bool equal(const uint32_t* first1, const uint32_t* last1, const uint32_t* first2)
-		{ return (memcmp(first1, first2, (size_t)((uintptr_t)last1 - (uintptr_t)first1)) == 0); }
-
-	inline bool equal(const int64_t* first1, const int64_t* last1, const int64_t* first2)
-		{ return (memcmp(first1, first2, (size_t)((uintptr_t)last1 - (uintptr_t)first1)) == 0); }
-
-	inline bool equal(const uint64_t* first1, const uint64_t* last1, const uint64_t* first2)
-		{ return (memcmp(first1, first2, (size_t)((uintptr_t)last1 - (uintptr_t)first1)) == 0); }
-	*/
-
 
 
 	/// equal
@@ -2114,6 +2308,38 @@ namespace std
 	}
 
 
+	namespace Internal
+	{
+		template <class InputIterator1, class InputIterator2>
+		inline std::pair<InputIterator1, InputIterator2>
+		mismatch_impl(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, std::false_type)
+		{
+			while((first1 != last1) && (*first1 == *first2)) // && (first2 != last2) <- C++ standard mismatch function doesn't check first2/last2.
+			{
+				++first1;
+				++first2;
+			}
+
+			return std::pair<InputIterator1, InputIterator2>(first1, first2);
+		}
+
+		#if EASTL_SIMD_ENABLED
+			template <typename T, typename U>
+			inline std::pair<T*, U*> mismatch_impl(T* first1, T* last1, U* first2, std::true_type)
+			{
+				typedef typename simd_element<T*>::type simd_type;
+
+				if((last1 - first1) >= EASTL_SIMD_MIN_RANGE_SIZE)
+				{
+					const size_t i = Internal::simd_mismatch_elements((const simd_type*)first1, (const simd_type*)first2, (size_t)(last1 - first1));
+					return std::pair<T*, U*>(first1 + i, first2 + i);
+				}
+				return Internal::mismatch_impl(first1, last1, first2, std::false_type());
+			}
+		#endif
+	}
+
+
 	/// mismatch
 	///
 	/// Finds the first position where the two ranges [first1, last1) and
@@ -2128,18 +2354,15 @@ namespace std
 	///
 	/// Complexity: At most last1 first1 applications of the corresponding predicate.
 	///
+	/// Ranges of arithmetic types given by pointers are compared with SIMD
+	/// instructions, if enabled (see EASTL_SIMD_ENABLED).
+	///
 	template <class InputIterator1, class InputIterator2>
 	inline std::pair<InputIterator1, InputIterator2>
 	mismatch(InputIterator1 first1, InputIterator1 last1,
 			 InputIterator2 first2) // , InputIterator2 last2)
 	{
-		while((first1 != last1) && (*first1 == *first2)) // && (first2 != last2) <- C++ standard mismatch function doesn't check first2/last2.
-		{
-			++first1;
-			++first2;
-		}
-
-		return std::pair<InputIterator1, InputIterator2>(first1, first2);
+		return Internal::mismatch_impl(first1, last1, first2, Internal::simd_elements<InputIterator1, InputIterator2>());
 	}
 
 
@@ -2454,6 +2677,34 @@ namespace std
 	}
 
 
+	namespace Internal
+	{
+		template <typename ForwardIterator, typename T>
+		inline void
+		replace_impl(ForwardIterator first, ForwardIterator last, const T& old_value, const T& new_value, std::false_type)
+		{
+			for(; first != last; ++first)
+			{
+				if(*first == old_value)
+					*first = new_value;
+			}
+		}
+
+		#if EASTL_SIMD_ENABLED
+			template <typename T>
+			inline void replace_impl(T* first, T* last, const T& old_value, const T& new_value, std::true_type)
+			{
+				typedef typename simd_element<T*>::type simd_type;
+
+				if((last - first) >= EASTL_SIMD_MIN_RANGE_SIZE)
+					Internal::simd_replace((simd_type*)first, (simd_type*)last, (simd_type)old_value, (simd_type)new_value);
+				else
+					Internal::replace_impl(first, last, old_value, new_value, std::false_type());
+			}
+		#endif
+	}
+
+
 	/// replace
 	///
 	/// Effects: Substitutes elements referred by the iterator i in the range [first, last)
@@ -2464,15 +2715,15 @@ namespace std
 	/// Note: The predicate version of replace is replace_if and not another variation of replace.
 	/// This is because both versions would have the same parameter count and there could be ambiguity.
 	///
+	/// Ranges of arithmetic types given by pointers are processed with SIMD
+	/// instructions, if enabled (see EASTL_SIMD_ENABLED) and the values are
+	/// of the type of their elements.
+	///
 	template <typename ForwardIterator, typename T>
 	inline void
 	replace(ForwardIterator first, ForwardIterator last, const T& old_value, const T& new_value)
 	{
-		for(; first != last; ++first)
-		{
-			if(*first == old_value)
-				*first = new_value;
-		}
+		Internal::replace_impl(first, last, old_value, new_value, Internal::simd_value<ForwardIterator, T>());
 	}
 
 
@@ -2888,6 +3139,26 @@ namespace std
 	}
 
 
+	/// search
+	///
+	/// Searches [first, last) with a searcher, which is an object constructed from the
+	/// subsequence to find (see searcher.h), and returns an iterator pointing to the beginning
+	/// of the first occurrence, or else last if none exists. Searchers such as
+	/// boyer_moore_searcher precompute tables from the subsequence, so that they examine far
+	/// fewer elements than the above versions of search.
+	///
+	/// Example usage:
+	///    boyer_moore_searcher<const char*> searcher(pPattern, pPattern + nPatternLength);
+	///    string::iterator it = search(s.begin(), s.end(), searcher);
+	///
+	template <typename ForwardIterator, typename Searcher>
+	inline ForwardIterator
+	search(ForwardIterator first, ForwardIterator last, const Searcher& searcher)
+	{
+		return searcher(first, last).first;
+	}
+
+
 
 	// search_n helper functions
 	//
@@ -4163,7 +4434,6 @@ namespace std
 	}
 
 
-
 	/// rotate_copy
 	///
 	/// Similar to rotate except writes the output to the OutputIterator and
@@ -8,6 +8,7 @@
 
 
 #include <EASTL/internal/config.h>
+#include <EASTL/type_traits.h>
 #include <EABase/nullptr.h>
 #include <stddef.h>
 
@@ -153,6 +154,37 @@ namespace std
 	void* allocate_memory(Allocator& a, size_t n, size_t alignment, size_t alignmentOffset);
 
 
+	/// allocator_has_reallocate
+	///
+	/// Identifies if an allocator implements the optional reallocate function:
+	///     void* reallocate(void* p, size_t oldSize, size_t newSize, int flags = 0);
+	///
+	/// reallocate resizes a block previously returned by allocate, preserving its
+	/// contents bitwise up to the lesser of the two sizes. The resulting block may
+	/// be at a different address and need only have EASTL_SYSTEM_ALLOCATOR_MIN_ALIGNMENT,
+	/// even if the original block was allocated with a greater alignment.
+	/// Upon failure it returns NULL and leaves the original block intact.
+	/// Containers such as vector use this to grow storage of trivially relocatable
+	/// elements without an allocate-copy-free cycle. See mmap_allocator.
+	///
+	template <typename Allocator, typename = void>
+	struct allocator_has_reallocate : public false_type {};
+
+	template <typename Allocator>
+	struct allocator_has_reallocate<Allocator, void_t<decltype(declval<Allocator&>().reallocate((void*)NULL, size_t(0), size_t(0)))>>
+		: public true_type {};
+
+
+	/// reallocate_memory
+	///
+	/// This is a memory reallocation dispatching function. It calls the allocator's 
+	/// reallocate function if it has one (see allocator_has_reallocate) and otherwise
+	/// returns NULL, which tells the caller to fall back to allocate, copy and free.
+	///
+	template <typename Allocator>
+	void* reallocate_memory(Allocator& a, void* p, size_t oldSize, size_t newSize);
+
+
 } // namespace std
 
 
@@ -373,6 +405,31 @@ namespace std
 		return result;
 	}
 
+
+	namespace Internal
+	{
+		template <typename Allocator>
+		inline void* reallocate_memory_impl(Allocator& a, void* p, size_t oldSize, size_t newSize, true_type)
+		{
+			return a.reallocate(p, oldSize, newSize);
+		}
+
+		template <typename Allocator>
+		inline void* reallocate_memory_impl(Allocator&, void*, size_t, size_t, false_type)
+		{
+			return NULL;
+		}
+	}
+
+
+	/// reallocate_memory
+	///
+	template <typename Allocator>
+	inline void* reallocate_memory(Allocator& a, void* p, size_t oldSize, size_t newSize)
+	{
+		return Internal::reallocate_memory_impl(a, p, oldSize, newSize, typename allocator_has_reallocate<Allocator>::type());
+	}
+
 }
 
 
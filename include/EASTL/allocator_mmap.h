@@ -0,0 +1,140 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_ALLOCATOR_MMAP_H
+#define EASTL_ALLOCATOR_MMAP_H
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/allocator.h>
+#include <stddef.h>
+
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// EASTL_MMAP_ALLOCATOR_AVAILABLE
+//
+// Defined as 0 or 1. Identifies if the platform supports anonymous mappings
+// which can be grown in place via mremap. If not, mmap_allocator falls back
+// to malloc/realloc, which is still a valid reallocate implementation.
+//
+#ifndef EASTL_MMAP_ALLOCATOR_AVAILABLE
+	#if defined(EA_PLATFORM_LINUX) && !defined(EA_PLATFORM_ANDROID)
+		#define EASTL_MMAP_ALLOCATOR_AVAILABLE 1
+	#else
+		#define EASTL_MMAP_ALLOCATOR_AVAILABLE 0
+	#endif
+#endif
+
+
+///////////////////////////////////////////////////////////////////////////////
+// EASTL_MMAP_ALLOCATOR_THRESHOLD
+//
+// Allocations smaller than this many bytes are served by malloc, as mapping
+// whole pages for small blocks wastes memory and costs a system call each.
+// Blocks which cross the threshold in reallocate are migrated between the two.
+//
+#ifndef EASTL_MMAP_ALLOCATOR_THRESHOLD
+	#define EASTL_MMAP_ALLOCATOR_THRESHOLD (256 * 1024)
+#endif
+
+
+///////////////////////////////////////////////////////////////////////////////
+// EASTL_MMAP_ALLOCATOR_HUGE_PAGE_SIZE
+//
+// The transparent huge page size. When huge pages are requested, mappings of
+// at least this size are advised with MADV_HUGEPAGE. Mappings are always
+// rounded to the regular page size only, so that any mmap_allocator instance
+// can free or resize a block regardless of its huge page setting.
+//
+#ifndef EASTL_MMAP_ALLOCATOR_HUGE_PAGE_SIZE
+	#define EASTL_MMAP_ALLOCATOR_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+#endif
+
+
+
+namespace std
+{
+
+	///////////////////////////////////////////////////////////////////////////////
+	// mmap_allocator
+	//
+	// Implements an EASTL allocator intended for very large containers. Blocks
+	// at or above EASTL_MMAP_ALLOCATOR_THRESHOLD are backed by anonymous private
+	// mappings, optionally advised to use transparent huge pages.
+	//
+	// The allocator implements the optional reallocate function (see
+	// allocator_has_reallocate in allocator.h), which grows a mapping with
+	// mremap. The kernel either extends the mapping in place or moves its page
+	// table entries, so no element data is copied. vector uses this for element
+	// types with has_trivial_relocate, which turns growth of a multi-gigabyte
+	// buffer into page table work instead of an allocate-copy-free cycle that
+	// briefly needs twice the memory.
+	//
+	// Example usage:
+	//      vector<int64_t, mmap_allocator> columnBuffer;
+	//      vector<int64_t, mmap_allocator> hugeBuffer(mmap_allocator("column", true));
+	//
+	class EASTL_API mmap_allocator
+	{
+	public:
+		EASTL_ALLOCATOR_EXPLICIT mmap_allocator(const char* pName = EASTL_NAME_VAL("mmap_allocator"), bool bUseHugePages = false);
+		mmap_allocator(const mmap_allocator& x);
+		mmap_allocator(const mmap_allocator& x, const char* pName);
+
+		mmap_allocator& operator=(const mmap_allocator& x);
+
+		void* allocate(size_t n, int flags = 0);
+		void* allocate(size_t n, size_t alignment, size_t alignmentOffset, int flags = 0);
+		void  deallocate(void* p, size_t n);
+
+		// Resizes the block p, which was allocated with oldSize bytes, to newSize bytes.
+		// The contents up to the lesser of the two sizes are preserved bitwise, and the
+		// returned block may be at a different address, and is only guaranteed to have
+		// EASTL_SYSTEM_ALLOCATOR_MIN_ALIGNMENT, as blocks below the threshold come from
+		// malloc. Returns NULL upon failure, in which case p is left untouched and still
+		// owned by the caller.
+		void* reallocate(void* p, size_t oldSize, size_t newSize, int flags = 0);
+
+		bool  get_huge_pages() const { return mbUseHugePages; }
+		void  set_huge_pages(bool bUseHugePages) { mbUseHugePages = bUseHugePages; }
+
+		const char* get_name() const;
+		void        set_name(const char* pName);
+
+		static size_t get_page_size();
+
+	protected:
+		void* DoMap(size_t n);
+		void  DoUnmap(void* p, size_t n);
+
+	protected:
+		#if EASTL_NAME_ENABLED
+			const char* mpName; // Debug name, used to track memory.
+		#endif
+		bool mbUseHugePages;
+	};
+
+
+	inline bool operator==(const mmap_allocator&, const mmap_allocator&)
+	{
+		return true; // Any instance can free memory allocated by any other, as the mode is recoverable from the block size.
+	}
+
+	inline bool operator!=(const mmap_allocator&, const mmap_allocator&)
+	{
+		return false;
+	}
+
+
+} // namespace std
+
+
+
+#endif // Header include guard
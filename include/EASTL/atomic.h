@@ -90,6 +90,15 @@
 //        : This operation is the same as the above weak variants
 //        : expect that it will not fail spuriously if the value stored equals T&.
 //
+//   - void wait(T old, order)
+//        : Blocks the calling thread until a load with the given order returns a value other than old.
+//        : Spins for EASTL_ATOMIC_WAIT_SPIN_COUNT loads before it asks the OS to suspend the thread.
+//        : Valid orders are relaxed, acquire, and seq_cst.
+//   - void notify_one()
+//   - void notify_all()
+//        : Wakes one or all threads blocked in wait on this object.
+//        : Doesn't make a system call unless a thread may be blocked.
+//
 //   The below operations are only valid for Integral types.
 //
 //   - T fetch_add(T, order)
@@ -199,6 +208,11 @@
 //       : Atomically loads the flag value.
 //       : Valid orders are relaxed, acquire, and seq_cst.
 //
+//   - void wait(bool old, order)
+//   - void notify_one()
+//   - void notify_all()
+//       : Same as std::atomic<T>::wait, notify_one and notify_all.
+//
 
 
 /////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,178 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements the following
+//     barrier
+//
+// This follows the C++ standard library's <barrier>.
+//
+// http://en.cppreference.com/w/cpp/header/barrier
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_BARRIER_H
+#define EASTL_BARRIER_H
+
+
+#include <EABase/eabase.h>
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once
+#endif
+
+#include <EASTL/internal/config.h>
+#include <EASTL/atomic.h>
+#include <EASTL/utility.h>
+#include <stddef.h>
+
+
+
+namespace std
+{
+
+	namespace Internal
+	{
+		/// barrier_empty_completion
+		/// The default completion function of barrier, which does nothing.
+		struct barrier_empty_completion
+		{
+			void operator()() EA_NOEXCEPT { }
+		};
+	}
+
+
+	/// barrier
+	///
+	/// Implements a reusable barrier for a set of threads which work in phases:
+	/// each phase completes once the expected number of threads have arrived,
+	/// at which point the last of them calls the completion function, and then
+	/// the threads waiting for the phase are released and the next one starts.
+	/// A thread can leave the set for later phases with arrive_and_drop.
+	///
+	/// The phase number and the number of threads yet to arrive share a 64-bit
+	/// atomic, so that an arrival learns which phase it arrived in with the same
+	/// operation that counts it. Waiting threads sleep on a separate 32-bit
+	/// phase counter through atomic<uint32_t>::wait, which is a futex on Linux,
+	/// and only the completing thread notifies.
+	///
+	/// CompletionFunction must be callable as f() and must not throw. It runs
+	/// before any thread waiting for the phase returns, and its effects are
+	/// visible to them.
+	///
+	/// Example usage:
+	///    barrier<> sync(kThreadCount);
+	///
+	///    for(int step = 0; step < kStepCount; step++) // On each thread.
+	///    {
+	///        Simulate(step);
+	///        sync.arrive_and_wait();
+	///    }
+	///
+	template <typename CompletionFunction = Internal::barrier_empty_completion>
+	class barrier
+	{
+	public:
+		/// arrival_token
+		/// Returned by arrive, and passed to wait to wait for the phase it arrived in.
+		class arrival_token
+		{
+		public:
+			arrival_token(arrival_token&& x) EA_NOEXCEPT
+				: mnPhase(x.mnPhase) { }
+
+			arrival_token& operator=(arrival_token&& x) EA_NOEXCEPT
+				{ mnPhase = x.mnPhase; return *this; }
+
+		protected:
+			friend class barrier;
+
+			explicit arrival_token(uint32_t nPhase)
+				: mnPhase(nPhase) { }
+
+			uint32_t mnPhase;
+		};
+
+	public:
+		static EA_CONSTEXPR ptrdiff_t max() EA_NOEXCEPT
+			{ return INT32_MAX; }
+
+		explicit barrier(ptrdiff_t nExpected, CompletionFunction completion = CompletionFunction())
+			: mnState((uint64_t)nExpected)
+			, mnPhase(0)
+			, mnExpected((int32_t)nExpected)
+			, mCompletion(std::move(completion))
+		{
+			EASTL_ASSERT((nExpected >= 0) && (nExpected <= max()));
+		}
+
+		barrier(const barrier&) = delete;
+		barrier& operator=(const barrier&) = delete;
+
+		/// Counts n arrivals in the current phase, completing it if they're the last.
+		/// The returned token can be passed to wait.
+		arrival_token arrive(ptrdiff_t n = 1)
+		{
+			const uint64_t nPrevious = mnState.fetch_sub((uint64_t)n, memory_order_acq_rel);
+			const uint32_t nPhase    = (uint32_t)(nPrevious >> 32);
+
+			EASTL_ASSERT((n > 0) && ((uint64_t)n <= (nPrevious & 0xffffffff)));
+
+			if((uint32_t)nPrevious == (uint32_t)n)
+				CompletePhase(nPhase);
+
+			return arrival_token(nPhase);
+		}
+
+		/// Waits until the phase that the token was returned for completes.
+		void wait(arrival_token&& token) const
+		{
+			for(;;)
+			{
+				const uint32_t nPhase = mnPhase.load(memory_order_acquire);
+
+				if((int32_t)(nPhase - token.mnPhase) > 0)
+					return;
+
+				mnPhase.wait(nPhase, memory_order_acquire);
+			}
+		}
+
+		void arrive_and_wait()
+		{
+			wait(arrive());
+		}
+
+		/// Arrives in the current phase, and reduces the number of threads expected
+		/// in later phases by one.
+		void arrive_and_drop()
+		{
+			mnExpected.fetch_sub(1, memory_order_relaxed); // Ordered before the completion's load by arrive.
+			arrive(1);
+		}
+
+	protected:
+		void CompletePhase(uint32_t nPhase)
+		{
+			mCompletion();
+
+			// Threads may arrive for the next phase as soon as we reset the state. Should the
+			// next phase complete before we increment mnPhase, its increment releases the
+			// waiters of this phase and ours those of the next, so we add rather than store.
+			const uint32_t nExpected = (uint32_t)mnExpected.load(memory_order_relaxed);
+
+			mnState.store(((uint64_t)(nPhase + 1) << 32) | nExpected, memory_order_release);
+			mnPhase.fetch_add(1, memory_order_release);
+			mnPhase.notify_all();
+		}
+
+		atomic<uint64_t>   mnState;     // The phase number in the upper 32 bits, and the number of arrivals to come in the lower.
+		atomic<uint32_t>   mnPhase;     // The number of phases completed, which waiters wait on.
+		atomic<int32_t>    mnExpected;  // The number of arrivals each phase expects.
+		CompletionFunction mCompletion;
+	};
+
+} // namespace std
+
+
+#endif // Header include guard
@@ -0,0 +1,597 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file defines the policies by which an lru_cache (see lru_cache.h)
+// chooses which entry to evict when it's full, given as its Policy template
+// parameter:
+//
+//    cache_lru_policy      Evicts the least recently used entry. This is the
+//                          default.
+//    cache_clock_policy    CLOCK: an access only marks its entry as referenced,
+//                          and eviction passes over the entries in the order
+//                          they were added, evicting the first one which isn't
+//                          referenced, and unmarking (and requeuing) the ones
+//                          which are. So an access doesn't relink the entry.
+//    cache_s3fifo_policy   S3-FIFO: new entries go to a small queue, of a tenth
+//                          of the capacity, and only those accessed while in it
+//                          move on to the main queue, which is a CLOCK with a
+//                          count of up to 3 accesses per entry. The keys evicted
+//                          from the small queue are remembered (by a fingerprint
+//                          of their hash, in a "ghost" table of a slot per
+//                          entry), and go to the main queue when they're added
+//                          again.
+//    cache_wtinylfu_policy W-TinyLFU: new entries go to an LRU window of a
+//                          hundredth of the capacity. The entry leaving the
+//                          window is admitted to the main part of the cache,
+//                          a segmented LRU, only if its key has been used more
+//                          often than that of the entry which it would evict,
+//                          as estimated by a count-min sketch (see
+//                          cache_frequency_sketch) of 4-bit counters.
+//
+// LRU is flushed by a scan of keys which are used once, such as a batch job
+// reading through a table. S3-FIFO and W-TinyLFU are scan resistant: they
+// keep such keys from displacing the frequently used ones. CLOCK evicts much
+// as LRU does, but an access only writes a flag. On Zipf distributed keys,
+// S3-FIFO and W-TinyLFU also hit more often than LRU (see BenchmarkLruCache);
+// S3-FIFO is about as fast as LRU, and W-TinyLFU slower, as each access counts
+// in the sketch.
+//
+// A policy keeps its queues as consecutive parts of one list of the entries,
+// which is the order the cache iterates them in, from the first to be evicted.
+// It's given the entries of the cache through a view (Entries), which has:
+//     lru_cache_link& link(uint32_t i)      The links of entry i in the list.
+//     entry_type&     state(uint32_t i)     The policy's data for entry i.
+//     size_t          hash(uint32_t i)      The hash of the key of entry i.
+//
+// A policy has:
+//     entry_type                                   Its data for each entry, which must be trivial (and which is
+//                                                  a base of the entry, so it may be empty).
+//     static size_t storage_size(size_t n)         The size of the memory, a multiple of 8 bytes, which it needs
+//                                                  for a capacity of n, which is allocated with the entries.
+//     void reset(void* p, size_t n)                Forgets all entries, and takes the memory p for a capacity of n.
+//     const lru_cache_link& list() const           The list of the entries (mNewer is the first, mOlder the last).
+//     void insert(const Entries&, uint32_t i)      Adds the new entry i.
+//     void access(const Entries&, uint32_t i)      Records an access of entry i.
+//     void erase(const Entries&, uint32_t i)       Removes entry i.
+//     uint32_t victim(const Entries&)              Chooses the entry to evict for a new one, when the cache is full.
+//     void relink(const Entries&, uint32_t i)      Adds entry i with its existing data, which keeps its place if the
+//                                                  entries are relinked in the order of the list (as by resize()).
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef EASTL_CACHE_POLICY_H
+#define EASTL_CACHE_POLICY_H
+
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+#pragma once
+#endif
+
+#include <EASTL/internal/config.h>
+#include <stddef.h>
+#include <string.h>
+
+namespace std
+{
+	/// lru_cache_link
+	///
+	/// The links of an lru_cache entry to the entries before and after it in the cache's list,
+	/// as the indexes of those entries, or kNone at either end of the list.
+	///
+	struct lru_cache_link
+	{
+		static const uint32_t kNone = 0xffffffff;
+
+		uint32_t mOlder;
+		uint32_t mNewer;
+	};
+
+
+	namespace Internal
+	{
+		/// cache_queues
+		///
+		/// N queues of cache entries, kept one after another in one list, each from its oldest
+		/// to its newest entry.
+		///
+		template <int N>
+		struct cache_queues
+		{
+			static const uint32_t kNone = lru_cache_link::kNone;
+
+			lru_cache_link mList;      // mNewer is the first entry, and mOlder the last.
+			uint32_t       mFirst[N];  // The oldest entry of each queue.
+			uint32_t       mCount[N];
+
+			void reset()
+			{
+				mList.mOlder = mList.mNewer = kNone;
+				for (int q = 0; q < N; q++)
+				{
+					mFirst[q] = kNone;
+					mCount[q] = 0;
+				}
+			}
+
+			// Links entry i as the newest of queue q, which is before the oldest of the following queues.
+			template <typename Entries>
+			void push(const Entries& entries, uint32_t i, int q)
+			{
+				uint32_t iNext = kNone;
+				for (int r = q + 1; (r < N) && (iNext == kNone); r++)
+					iNext = mFirst[r];
+
+				lru_cache_link& link = entries.link(i);
+				link.mNewer = iNext;
+				if (iNext != kNone)
+				{
+					link.mOlder = entries.link(iNext).mOlder;
+					entries.link(iNext).mOlder = i;
+				}
+				else
+				{
+					link.mOlder = mList.mOlder;
+					mList.mOlder = i;
+				}
+
+				if (link.mOlder != kNone)
+					entries.link(link.mOlder).mNewer = i;
+				else
+					mList.mNewer = i;
+
+				if (mFirst[q] == kNone)
+					mFirst[q] = i;
+				mCount[q]++;
+			}
+
+			template <typename Entries>
+			void remove(const Entries& entries, uint32_t i, int q)
+			{
+				const lru_cache_link& link = entries.link(i);
+
+				if (mFirst[q] == i)
+					mFirst[q] = (mCount[q] > 1) ? link.mNewer : kNone;
+
+				if (link.mOlder != kNone)
+					entries.link(link.mOlder).mNewer = link.mNewer;
+				else
+					mList.mNewer = link.mNewer;
+
+				if (link.mNewer != kNone)
+					entries.link(link.mNewer).mOlder = link.mOlder;
+				else
+					mList.mOlder = link.mOlder;
+
+				mCount[q]--;
+			}
+
+			// Moves entry i from queue q to the newest end of queue r.
+			template <typename Entries>
+			void move(const Entries& entries, uint32_t i, int q, int r)
+			{
+				remove(entries, i, q);
+				push(entries, i, r);
+			}
+		};
+
+		// Mixes a hash, so that each of its bits depends on all of those of the hash.
+		inline uint64_t cache_mix_hash(size_t h)
+		{
+			uint64_t x = (uint64_t)h * UINT64_C(0xc4ceb9fe1a85ec53);
+			return x ^ (x >> 29);
+		}
+
+		inline uint32_t cache_log2_ceil(size_t n)
+		{
+			uint32_t nLog2 = 0;
+			while (((size_t)1 << nLog2) < n)
+				nLog2++;
+			return nLog2;
+		}
+	}
+
+
+	/// cache_frequency_sketch
+	///
+	/// Estimates how often each hash has been added to it, with a count-min sketch: each hash
+	/// counts in 4 of the table's 4-bit counters, and its estimate is the least of those. Once the
+	/// additions reach ten per entry of the cache, all the counters are halved, so the estimates
+	/// favor recent use. The table has 4 counters per entry, in 64-bit words of 16 counters, and
+	/// the 4 counters of a hash are in one 64-byte block of 8 words, one in each pair of words,
+	/// so that an addition touches one cache line.
+	///
+	class cache_frequency_sketch
+	{
+	public:
+		cache_frequency_sketch()
+			: mpTable(NULL), mnMask(0), mnAdditions(0), mnSampleSize(0) { }
+
+		static size_t storage_size(size_t nCapacity)
+		{
+			return nCapacity ? (sizeof(uint64_t) << word_count_log2(nCapacity)) : 0;
+		}
+
+		void reset(void* pStorage, size_t nCapacity)
+		{
+			mpTable      = (uint64_t*)pStorage;
+			mnMask       = pStorage ? (((size_t)1 << word_count_log2(nCapacity)) - 1) : 0;
+			mnAdditions  = 0;
+			mnSampleSize = 10 * nCapacity;
+
+			if (mpTable)
+				memset(mpTable, 0, (mnMask + 1) * sizeof(uint64_t));
+		}
+
+		void increment(size_t h)
+		{
+			if (!mpTable)
+				return;
+
+			const uint64_t x      = Internal::cache_mix_hash(h);
+			uint64_t*      pBlock = block(x);
+
+			// Without a branch for each counter, as whether it's full is unpredictable.
+			const uint64_t nAdded = add(pBlock, x, 0) | add(pBlock, x, 1) | add(pBlock, x, 2) | add(pBlock, x, 3);
+
+			if ((mnAdditions += (size_t)nAdded) >= mnSampleSize)
+			{
+				for (size_t i = 0; i <= mnMask; i++)
+					mpTable[i] = (mpTable[i] >> 1) & UINT64_C(0x7777777777777777);
+				mnAdditions /= 2;
+			}
+		}
+
+		uint32_t frequency(size_t h) const
+		{
+			if (!mpTable)
+				return 0;
+
+			const uint64_t x      = Internal::cache_mix_hash(h);
+			const uint64_t* pBlock = block(x);
+			const uint32_t nCount0 = count(pBlock, x, 0), nCount1 = count(pBlock, x, 1);
+			const uint32_t nCount2 = count(pBlock, x, 2), nCount3 = count(pBlock, x, 3);
+			const uint32_t nMin01  = (nCount0 < nCount1) ? nCount0 : nCount1;
+			const uint32_t nMin23  = (nCount2 < nCount3) ? nCount2 : nCount3;
+
+			return (nMin01 < nMin23) ? nMin01 : nMin23;
+		}
+
+	protected:
+		static uint32_t word_count_log2(size_t nCapacity)
+		{
+			const uint32_t nLog2 = Internal::cache_log2_ceil((nCapacity + 3) / 4);
+			return (nLog2 > 3) ? nLog2 : 3;
+		}
+
+		// The low half of x selects the block, and the high half the counter in each pair of its words.
+		uint64_t* block(uint64_t x) const { return mpTable + (((size_t)(uint32_t)x << 3) & mnMask); }
+
+		static uint64_t& word(uint64_t* pBlock, uint64_t x, int i)             { return pBlock[(i * 2) + (int)((x >> (32 + i)) & 1)]; }
+		static uint64_t  word(const uint64_t* pBlock, uint64_t x, int i)       { return pBlock[(i * 2) + (int)((x >> (32 + i)) & 1)]; }
+		static uint32_t  counter_shift(uint64_t x, int i)                      { return (uint32_t)((x >> (40 + 4 * i)) & 15) * 4; }
+		static uint32_t  count(const uint64_t* pBlock, uint64_t x, int i)      { return (uint32_t)(word(pBlock, x, i) >> counter_shift(x, i)) & 0xf; }
+
+		// Adds 1 to counter i of x, unless it's full, and returns 1 if it did.
+		static uint64_t add(uint64_t* pBlock, uint64_t x, int i)
+		{
+			const uint32_t nShift = counter_shift(x, i);
+			uint64_t&      w      = word(pBlock, x, i);
+			const uint64_t nAdd   = (((w >> nShift) & 0xf) != 0xf);
+
+			w += nAdd << nShift;
+			return nAdd;
+		}
+
+		uint64_t* mpTable;
+		size_t    mnMask;
+		size_t    mnAdditions;
+		size_t    mnSampleSize;
+	};
+
+
+	/// cache_lru_policy
+	///
+	/// Evicts the least recently used entry. The list is from the least to the most recently used.
+	///
+	class cache_lru_policy
+	{
+	public:
+		struct entry_type { };
+
+		static size_t storage_size(size_t) { return 0; }
+
+		void reset(void*, size_t) { mQueue.reset(); }
+
+		const lru_cache_link& list() const { return mQueue.mList; }
+
+		template <typename Entries> void insert(const Entries& entries, uint32_t i) { mQueue.push(entries, i, 0); }
+		template <typename Entries> void erase(const Entries& entries, uint32_t i)  { mQueue.remove(entries, i, 0); }
+		template <typename Entries> void relink(const Entries& entries, uint32_t i) { mQueue.push(entries, i, 0); }
+
+		template <typename Entries>
+		void access(const Entries& entries, uint32_t i)
+		{
+			if (i != mQueue.mList.mOlder)
+				mQueue.move(entries, i, 0, 0);
+		}
+
+		template <typename Entries>
+		uint32_t victim(const Entries&) const { return mQueue.mList.mNewer; }
+
+	protected:
+		Internal::cache_queues<1> mQueue;
+	};
+
+
+	/// cache_clock_policy
+	///
+	/// Evicts the first entry, in the order they were added, which hasn't been accessed since it
+	/// was added or last passed over. The list is in that order: the hand of the clock is its first
+	/// entry, and the entries passed over move to its end.
+	///
+	class cache_clock_policy
+	{
+	public:
+		struct entry_type { uint8_t mbReferenced; };
+
+		static size_t storage_size(size_t) { return 0; }
+
+		void reset(void*, size_t) { mQueue.reset(); }
+
+		const lru_cache_link& list() const { return mQueue.mList; }
+
+		template <typename Entries>
+		void insert(const Entries& entries, uint32_t i)
+		{
+			entries.state(i).mbReferenced = 0;
+			mQueue.push(entries, i, 0);
+		}
+
+		template <typename Entries> void access(const Entries& entries, uint32_t i) { entries.state(i).mbReferenced = 1; }
+		template <typename Entries> void erase(const Entries& entries, uint32_t i)  { mQueue.remove(entries, i, 0); }
+		template <typename Entries> void relink(const Entries& entries, uint32_t i) { mQueue.push(entries, i, 0); }
+
+		template <typename Entries>
+		uint32_t victim(const Entries& entries)
+		{
+			uint32_t i;
+
+			while (entries.state(i = mQueue.mList.mNewer).mbReferenced)
+			{
+				entries.state(i).mbReferenced = 0;
+				mQueue.move(entries, i, 0, 0);
+			}
+
+			return i;
+		}
+
+	protected:
+		Internal::cache_queues<1> mQueue;
+	};
+
+
+	/// cache_s3fifo_policy
+	///
+	/// Keeps a small FIFO queue of new entries, and a main queue of the entries accessed while in the
+	/// small queue, or which were recently evicted from it. The list is the small queue followed
+	/// by the main queue, each from its oldest entry.
+	///
+	class cache_s3fifo_policy
+	{
+	public:
+		struct entry_type
+		{
+			uint8_t mnQueue;
+			uint8_t mnFrequency; // The number of accesses, up to 3, since the entry was added or moved.
+		};
+
+		static size_t storage_size(size_t nCapacity)
+		{
+			return nCapacity ? ((sizeof(uint32_t) << ghost_count_log2(nCapacity)) + 7) & ~(size_t)7 : 0;
+		}
+
+		void reset(void* pStorage, size_t nCapacity)
+		{
+			mQueues.reset();
+			mnSmallCapacity = (uint32_t)((nCapacity + 9) / 10);
+			mpGhost         = (uint32_t*)pStorage;
+			mnGhostShift    = 64 - (pStorage ? ghost_count_log2(nCapacity) : 0);
+
+			if (mpGhost)
+				memset(mpGhost, 0, sizeof(uint32_t) << (64 - mnGhostShift));
+		}
+
+		const lru_cache_link& list() const { return mQueues.mList; }
+
+		template <typename Entries>
+		void insert(const Entries& entries, uint32_t i)
+		{
+			entry_type& state = entries.state(i);
+			uint32_t*   pSlot = ghost_slot(entries.hash(i));
+
+			state.mnFrequency = 0;
+			state.mnQueue     = (pSlot && (*pSlot == ghost_fingerprint(entries.hash(i)))) ? kMain : kSmall;
+
+			if (state.mnQueue == kMain)
+				*pSlot = 0;
+
+			mQueues.push(entries, i, state.mnQueue);
+		}
+
+		template <typename Entries>
+		void access(const Entries& entries, uint32_t i)
+		{
+			entry_type& state = entries.state(i);
+
+			if (state.mnFrequency < 3)
+				state.mnFrequency++;
+		}
+
+		template <typename Entries> void erase(const Entries& entries, uint32_t i)  { mQueues.remove(entries, i, entries.state(i).mnQueue); }
+		template <typename Entries> void relink(const Entries& entries, uint32_t i) { mQueues.push(entries, i, entries.state(i).mnQueue); }
+
+		template <typename Entries>
+		uint32_t victim(const Entries& entries)
+		{
+			for (;;)
+			{
+				if (mQueues.mCount[kSmall] && ((mQueues.mCount[kSmall] >= mnSmallCapacity) || !mQueues.mCount[kMain]))
+				{
+					const uint32_t i     = mQueues.mFirst[kSmall];
+					entry_type&    state = entries.state(i);
+
+					if (state.mnFrequency == 0)
+					{
+						if (uint32_t* pSlot = ghost_slot(entries.hash(i)))
+							*pSlot = ghost_fingerprint(entries.hash(i));
+						return i;
+					}
+
+					state.mnFrequency = 0;
+					state.mnQueue     = kMain;
+					mQueues.move(entries, i, kSmall, kMain);
+				}
+				else
+				{
+					const uint32_t i     = mQueues.mFirst[kMain];
+					entry_type&    state = entries.state(i);
+
+					if (state.mnFrequency == 0)
+						return i;
+
+					state.mnFrequency--;
+					mQueues.move(entries, i, kMain, kMain);
+				}
+			}
+		}
+
+	protected:
+		enum { kSmall, kMain };
+
+		static uint32_t ghost_count_log2(size_t nCapacity) { return Internal::cache_log2_ceil(nCapacity); }
+
+		// The ghost table has a slot per entry of the cache, which holds the fingerprint of the last key
+		// evicted from the small queue which maps to it, or 0.
+		uint32_t* ghost_slot(size_t h) const
+		{
+			return mpGhost ? &mpGhost[(mnGhostShift < 64) ? (Internal::cache_mix_hash(h) >> mnGhostShift) : 0] : NULL;
+		}
+
+		static uint32_t ghost_fingerprint(size_t h) { return (uint32_t)Internal::cache_mix_hash(h) | 1; }
+
+		Internal::cache_queues<2> mQueues;
+		uint32_t                  mnSmallCapacity;
+		uint32_t*                 mpGhost;
+		uint32_t                  mnGhostShift; // 64 - log2 of the number of slots of the ghost table.
+	};
+
+
+	/// cache_wtinylfu_policy
+	///
+	/// Keeps an LRU window of new entries, and a main segmented LRU of the entries admitted from it,
+	/// of which four fifths are the entries accessed while in the main part (protected), and the rest
+	/// those which haven't been (probation). The list is the window, then probation, then protected,
+	/// each from its least recently used entry.
+	///
+	class cache_wtinylfu_policy
+	{
+	public:
+		struct entry_type { uint8_t mnQueue; };
+
+		static size_t storage_size(size_t nCapacity) { return cache_frequency_sketch::storage_size(nCapacity); }
+
+		void reset(void* pStorage, size_t nCapacity)
+		{
+			const size_t nMain = nCapacity - ((nCapacity + 99) / 100);
+
+			mQueues.reset();
+			mSketch.reset(pStorage, nCapacity);
+			mnWindowCapacity    = (uint32_t)(nCapacity - nMain);
+			mnProtectedCapacity = (uint32_t)(nMain - (nMain / 5));
+		}
+
+		const lru_cache_link& list() const { return mQueues.mList; }
+
+		// The entries which the window has too many of, as while the cache fills, move to probation.
+		template <typename Entries>
+		void insert(const Entries& entries, uint32_t i)
+		{
+			mSketch.increment(entries.hash(i));
+			entries.state(i).mnQueue = kWindow;
+			mQueues.push(entries, i, kWindow);
+
+			while (mQueues.mCount[kWindow] > mnWindowCapacity)
+			{
+				const uint32_t iOldest = mQueues.mFirst[kWindow];
+				entries.state(iOldest).mnQueue = kProbation;
+				mQueues.move(entries, iOldest, kWindow, kProbation);
+			}
+		}
+
+		template <typename Entries>
+		void access(const Entries& entries, uint32_t i)
+		{
+			entry_type& state = entries.state(i);
+
+			mSketch.increment(entries.hash(i));
+
+			if (state.mnQueue == kProbation) // Promote it, and demote the least recently used protected entry if there are too many.
+			{
+				state.mnQueue = kProtected;
+				mQueues.move(entries, i, kProbation, kProtected);
+
+				if (mQueues.mCount[kProtected] > mnProtectedCapacity)
+				{
+					const uint32_t iDemoted = mQueues.mFirst[kProtected];
+					entries.state(iDemoted).mnQueue = kProbation;
+					mQueues.move(entries, iDemoted, kProtected, kProbation);
+				}
+			}
+			else if (i != mQueues.mList.mOlder)
+				mQueues.move(entries, i, state.mnQueue, state.mnQueue);
+		}
+
+		template <typename Entries> void erase(const Entries& entries, uint32_t i)  { mQueues.remove(entries, i, entries.state(i).mnQueue); }
+		template <typename Entries> void relink(const Entries& entries, uint32_t i) { mQueues.push(entries, i, entries.state(i).mnQueue); }
+
+		// If the window is full, its least recently used entry (the candidate) leaves it, and either it or
+		// the entry which probation would evict, whichever key is used less often, is evicted.
+		template <typename Entries>
+		uint32_t victim(const Entries& entries)
+		{
+			uint32_t iVictim = mQueues.mFirst[kProbation];
+
+			if (iVictim == kNone)
+				iVictim = mQueues.mFirst[kProtected];
+
+			if ((mQueues.mCount[kWindow] >= mnWindowCapacity) || (iVictim == kNone))
+			{
+				const uint32_t iCandidate = mQueues.mFirst[kWindow];
+
+				if ((iVictim == kNone) || (mSketch.frequency(entries.hash(iCandidate)) <= mSketch.frequency(entries.hash(iVictim))))
+					return iCandidate;
+
+				entries.state(iCandidate).mnQueue = kProbation;
+				mQueues.move(entries, iCandidate, kWindow, kProbation);
+			}
+
+			return iVictim;
+		}
+
+		const cache_frequency_sketch& sketch() const { return mSketch; }
+
+	protected:
+		enum { kWindow, kProbation, kProtected };
+
+		static const uint32_t kNone = lru_cache_link::kNone;
+
+		Internal::cache_queues<3> mQueues;
+		cache_frequency_sketch    mSketch;
+		uint32_t                  mnWindowCapacity;
+		uint32_t                  mnProtectedCapacity;
+	};
+}
+
+
+
+#endif
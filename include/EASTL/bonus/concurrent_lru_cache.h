@@ -0,0 +1,434 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// concurrent_lru_cache is an lru_cache (see lru_cache.h) which many threads
+// can use at once. Keys are partitioned by their hash across a number of
+// shards, each of which is an lru_cache of its part of the capacity, with
+// its own lock, so that threads using different shards don't contend.
+//
+// Reads which find their key (get, touch) hold their shard's lock shared,
+// so any number of them run at once. Rather than move the entry to the most
+// recently used end of the shard's list, which would need the lock held
+// exclusively, they record the entry in the shard's access buffer, which is
+// applied to the list in a batch by the read which fills it, and before any
+// change to the shard. If reads fill the buffer faster than it's applied,
+// further reads aren't recorded. So the order of eviction approximates that
+// of lru_cache, and is per shard rather than over the whole cache.
+//
+// Data is created and returned by value, as other threads can replace or
+// evict an entry at any time. The creator is called without holding any
+// lock; if two threads create data for the same key at once, the data of
+// the thread which adds it second is deleted (by the deletor), and the
+// data of the first is returned to both. Every datum which the creator
+// creates or which is added is eventually passed to the deletor once.
+//
+// The lock of a shard is a mutex which writers hold, together with an atomic
+// count of readers. Writers wait for the readers of the shard to finish by
+// spinning, which is brief, as a read doesn't call any callback.
+//
+// Example usage:
+//     concurrent_lru_cache<string, Texture*> cache(1024, 16, allocator, loadTexture, freeTexture);
+//
+//     // On any thread:
+//     Texture* pTexture = cache.get("ui/button.png");
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef EASTL_CONCURRENT_LRUCACHE_H
+#define EASTL_CONCURRENT_LRUCACHE_H
+
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+#pragma once
+#endif
+
+#include <EASTL/internal/config.h>
+#include <EASTL/mutex.h>
+#include <EASTL/bonus/lru_cache.h>
+#include <EASTL/atomic.h>
+#include <EASTL/optional.h>
+#include <new>
+#include <stddef.h>
+
+// 4324 - structure was padded due to alignment specifier
+EA_DISABLE_VC_WARNING(4324);
+
+namespace std
+{
+	/// EASTL_CONCURRENT_LRUCACHE_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_CONCURRENT_LRUCACHE_DEFAULT_NAME
+	#define EASTL_CONCURRENT_LRUCACHE_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " concurrent_lru_cache" // Unless the user overrides something, this is "EASTL concurrent_lru_cache".
+	#endif
+
+
+	/// EASTL_CONCURRENT_LRUCACHE_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_CONCURRENT_LRUCACHE_DEFAULT_ALLOCATOR
+	#define EASTL_CONCURRENT_LRUCACHE_DEFAULT_ALLOCATOR allocator_type(EASTL_CONCURRENT_LRUCACHE_DEFAULT_NAME)
+	#endif
+
+
+	/// EASTL_CONCURRENT_LRUCACHE_SHARD_COUNT
+	///
+	/// The default number of shards of a concurrent_lru_cache. More shards than threads make it
+	/// unlikely that threads contend for a shard.
+	///
+	#ifndef EASTL_CONCURRENT_LRUCACHE_SHARD_COUNT
+	#define EASTL_CONCURRENT_LRUCACHE_SHARD_COUNT 16
+	#endif
+
+
+	/// EASTL_CONCURRENT_LRUCACHE_BUFFER_SIZE
+	///
+	/// The number of reads each shard records before they're applied to its list.
+	///
+	#ifndef EASTL_CONCURRENT_LRUCACHE_BUFFER_SIZE
+	#define EASTL_CONCURRENT_LRUCACHE_BUFFER_SIZE 32
+	#endif
+
+
+	/// concurrent_lru_cache
+	///
+	/// Implements a caching map based off of a key and data, which can be used by many threads at once.
+	/// See lru_cache for the meaning of the functions, which differ in that data is returned by value.
+	///
+	/// The capacity is divided evenly among the shards, rounded up, and each shard evicts its oldest
+	/// entry (or the one its Policy chooses) when it's full. The shard count is rounded up to a power
+	/// of two.
+	///
+	template <typename Key,
+	          typename Value,
+	          typename Allocator = EASTLAllocatorType,
+	          typename Hash = std::hash<Key>,
+	          typename Predicate = std::equal_to<Key>,
+	          typename Policy = cache_lru_policy>
+	class concurrent_lru_cache
+	{
+	public:
+		using key_type = Key;
+		using value_type = Value;
+		using allocator_type = Allocator;
+		using hasher = Hash;
+		using key_equal = Predicate;
+		using size_type = eastl_size_t;
+		using policy_type = Policy;
+		using shard_type = lru_cache<Key, Value, Allocator, Hash, Predicate, Policy>;
+		using this_type = concurrent_lru_cache<Key, Value, Allocator, Hash, Predicate, Policy>;
+		using create_callback_type = typename shard_type::create_callback_type;
+		using delete_callback_type = typename shard_type::delete_callback_type;
+
+		/// concurrent_lru_cache constructor
+		///
+		/// Creates a cache of at least size entries, in shardCount shards.
+		explicit concurrent_lru_cache(size_type size,
+		                              size_type shardCount = EASTL_CONCURRENT_LRUCACHE_SHARD_COUNT,
+		                              const allocator_type& allocator = EASTL_CONCURRENT_LRUCACHE_DEFAULT_ALLOCATOR,
+		                              create_callback_type creator = nullptr,
+		                              delete_callback_type deletor = nullptr)
+		    : m_shards(NULL)
+		    , m_shard_count(1)
+		    , m_allocator(allocator)
+		    , m_create_callback(creator)
+		    , m_delete_callback(deletor)
+		{
+			while (m_shard_count < shardCount)
+				m_shard_count *= 2;
+
+			const size_type nShardCapacity = (size + m_shard_count - 1) / m_shard_count;
+
+			m_shards = (shard*)EASTLAllocAligned(m_allocator, m_shard_count * sizeof(shard), EA_CACHE_LINE_SIZE, 0);
+			for (size_type i = 0; i < m_shard_count; i++)
+				::new((void*)&m_shards[i]) shard(nShardCapacity, m_allocator, deletor);
+		}
+
+		/// concurrent_lru_cache destructor
+		///
+		/// Calls the deletor for every entry. No other thread may be using the cache.
+		~concurrent_lru_cache()
+		{
+			for (size_type i = 0; i < m_shard_count; i++)
+				m_shards[i].~shard();
+			EASTLFree(m_allocator, m_shards, m_shard_count * sizeof(shard));
+		}
+
+		concurrent_lru_cache(const this_type&) = delete;
+		this_type &operator=(const this_type&) = delete;
+
+		/// insert
+		///
+		/// Adds key k with data v, and returns true, if k doesn't exist.
+		bool insert(const key_type& k, const value_type& v)
+		{
+			shard& s = shard_for(k);
+			exclusive_lock lock(s);
+			return s.mCache.insert(k, v);
+		}
+
+		/// insert_or_assign
+		///
+		/// Adds key k with data v, or replaces the data of k, calling the deletor for the old data.
+		void insert_or_assign(const key_type& k, const value_type& v)
+		{
+			shard& s = shard_for(k);
+			exclusive_lock lock(s);
+			s.mCache.insert_or_assign(k, v);
+		}
+
+		/// assign
+		///
+		/// Replaces the data of key k, calling the deletor for the old data, and returns true, if k exists.
+		bool assign(const key_type& k, const value_type& v)
+		{
+			shard& s = shard_for(k);
+			exclusive_lock lock(s);
+			return s.mCache.assign(k, v);
+		}
+
+		/// contains
+		///
+		/// Returns true if key k exists in the cache
+		bool contains(const key_type& k) const
+		{
+			shard& s = shard_for(k);
+			shared_lock lock(s);
+			return s.mCache.contains(k);
+		}
+
+		/// at
+		///
+		/// Returns the data for key k, if it exists, without changing which entries are most
+		/// recently used.
+		std::optional<value_type> at(const key_type& k) const
+		{
+			shard& s = shard_for(k);
+			shared_lock lock(s);
+
+			auto iter = s.mCache.find(k);
+			if (iter != s.mCache.end())
+				return iter->second.first;
+			return std::nullopt;
+		}
+
+		/// get
+		///
+		/// Returns the data for key k. If no data exists, it's created by calling the creator, and added.
+		value_type get(const key_type& k)
+		{
+			shard& s = shard_for(k);
+
+			{
+				shared_lock lock(s);
+
+				auto iter = s.mCache.find(k);
+				if (iter != s.mCache.end())
+				{
+					value_type v(iter->second.first);
+					lock.record(iter);
+					return v;
+				}
+			}
+
+			value_type v(m_create_callback ? m_create_callback(k) : value_type());
+
+			exclusive_lock lock(s);
+
+			auto iter = s.mCache.find(k);
+			if (iter == s.mCache.end())
+				s.mCache.insert(k, v);
+			else // Another thread added k while we created its data.
+			{
+				if (m_delete_callback)
+					m_delete_callback(v);
+				v = iter->second.first;
+				s.mCache.touch(iter);
+			}
+
+			return v;
+		}
+
+		/// erase
+		///
+		/// Erases key k, calling the deletor for its data, and returns true, if k exists.
+		bool erase(const key_type& k)
+		{
+			shard& s = shard_for(k);
+			exclusive_lock lock(s);
+			return s.mCache.erase(k);
+		}
+
+		/// touch
+		///
+		/// Marks key k as most recently used, and returns true, if k exists.
+		bool touch(const key_type& k)
+		{
+			shard& s = shard_for(k);
+			shared_lock lock(s);
+
+			auto iter = s.mCache.find(k);
+			if (iter != s.mCache.end())
+			{
+				lock.record(iter);
+				return true;
+			}
+
+			return false;
+		}
+
+		/// clear
+		///
+		/// Erases every entry, calling the deletor for its data.
+		void clear()
+		{
+			for (size_type i = 0; i < m_shard_count; i++)
+			{
+				exclusive_lock lock(m_shards[i]);
+				m_shards[i].mCache.clear();
+			}
+		}
+
+		/// size
+		///
+		/// Returns the number of entries, which other threads may be changing.
+		size_type size() const
+		{
+			size_type n = 0;
+
+			for (size_type i = 0; i < m_shard_count; i++)
+			{
+				shared_lock lock(m_shards[i]);
+				n += m_shards[i].mCache.size();
+			}
+
+			return n;
+		}
+
+		bool empty() const { return size() == 0; }
+
+		size_type capacity() const    EA_NOEXCEPT { return m_shard_count * m_shards[0].mCache.capacity(); }
+		size_type shard_count() const EA_NOEXCEPT { return m_shard_count; }
+
+		/// These must not be called while other threads use the cache.
+		void setCreateCallback(create_callback_type callback) { m_create_callback = callback; }
+		void setDeleteCallback(delete_callback_type callback)
+		{
+			m_delete_callback = callback;
+			for (size_type i = 0; i < m_shard_count; i++)
+				m_shards[i].mCache.setDeleteCallback(callback);
+		}
+
+		const allocator_type& get_allocator() const EA_NOEXCEPT { return m_allocator; }
+
+	private:
+		enum : int32_t { kWriter = INT32_MIN }; // Set in mnLockState while a writer holds the lock; the rest is the reader count.
+
+		static const uint32_t kBufferSize = EASTL_CONCURRENT_LRUCACHE_BUFFER_SIZE;
+
+		struct shard
+		{
+			shard(size_type nCapacity, const allocator_type& allocator, delete_callback_type deletor)
+				: mnLockState(0), mnAccessCount(0), mCache(nCapacity, allocator, nullptr, deletor) { }
+
+			mutex                              mMutex;        // Held by writers, and waited for by readers while a writer holds it.
+			atomic<int32_t>                    mnLockState;
+			atomic<uint32_t>                   mnAccessCount; // The number of reads recorded, which may exceed kBufferSize.
+			shard_type                         mCache;
+			typename shard_type::iterator      mAccesses[kBufferSize];
+			char                               mPadding[EA_CACHE_LINE_SIZE]; // Keeps the next shard's lock off this shard's cache lines.
+		};
+
+		// Holds a shard's lock shared, and records reads of its entries.
+		class shared_lock
+		{
+		public:
+			explicit shared_lock(shard& s) : mShard(s), mbApply(false)
+			{
+				while (mShard.mnLockState.fetch_add(1, memory_order_acquire) & kWriter)
+				{
+					mShard.mnLockState.fetch_sub(1, memory_order_relaxed);
+					lock_guard<mutex> wait(mShard.mMutex); // Waits until the writer is done.
+				}
+			}
+
+			~shared_lock()
+			{
+				mShard.mnLockState.fetch_sub(1, memory_order_release);
+
+				if (mbApply) // This read filled the buffer.
+					exclusive_lock lock(mShard);
+			}
+
+			void record(typename shard_type::iterator iter)
+			{
+				const uint32_t n = mShard.mnAccessCount.fetch_add(1, memory_order_relaxed);
+
+				if (n < kBufferSize)
+				{
+					mShard.mAccesses[n] = iter;
+					mbApply = (n == (kBufferSize - 1));
+				}
+			}
+
+		private:
+			shard& mShard;
+			bool   mbApply;
+
+			shared_lock(const shared_lock&) = delete;
+			void operator=(const shared_lock&) = delete;
+		};
+
+		// Holds a shard's lock exclusively. It applies the recorded reads once it's acquired, so
+		// that they refer to entries which exist.
+		class exclusive_lock
+		{
+		public:
+			explicit exclusive_lock(shard& s) : mShard(s)
+			{
+				mShard.mMutex.lock();
+				mShard.mnLockState.fetch_or(kWriter, memory_order_relaxed);
+				while (mShard.mnLockState.load(memory_order_acquire) != kWriter)
+					cpu_pause();
+
+				const uint32_t nCount = mShard.mnAccessCount.load(memory_order_relaxed);
+				for (uint32_t i = 0, iEnd = (nCount < kBufferSize) ? nCount : kBufferSize; i < iEnd; i++)
+					mShard.mCache.touch(mShard.mAccesses[i]);
+				mShard.mnAccessCount.store(0, memory_order_relaxed);
+			}
+
+			~exclusive_lock()
+			{
+				mShard.mnLockState.fetch_and(~kWriter, memory_order_release);
+				mShard.mMutex.unlock();
+			}
+
+		private:
+			shard& mShard;
+
+			exclusive_lock(const exclusive_lock&) = delete;
+			void operator=(const exclusive_lock&) = delete;
+		};
+
+		// The shard is chosen by the top bits of the hash times a different constant than the one which
+		// lru_cache chooses buckets with, so that the keys of a shard are spread over its buckets.
+		shard& shard_for(const key_type& k) const
+		{
+			const uint64_t h = (uint64_t)m_hash(k) * UINT64_C(0xff51afd7ed558ccd);
+			return m_shards[(size_type)(h >> 40) & (m_shard_count - 1)];
+		}
+
+	private:
+		shard*					m_shards;
+		size_type				m_shard_count;
+		hasher					m_hash;
+		allocator_type			m_allocator;
+		create_callback_type	m_create_callback;
+		delete_callback_type	m_delete_callback;
+	};
+}
+
+EA_RESTORE_VC_WARNING();
+
+
+#endif
@@ -7,18 +7,26 @@
 // Basically, you give the container a key, like a string, and the data you want.
 // The container provides callback mechanisms to generate data if it's missing
 // as well as delete data when it's purged from the cache.  This container
-// uses a least recently used method: whatever the oldest item is will be 
+// uses a least recently used method: whatever the oldest item is will be
 // replaced with a new entry.
 //
-// Algorithmically, the container is a combination of a map and a list.
-// The list stores the age of the entries by moving the entry to the head
-// of the list on each access, either by a call to get() or to touch().
-// The map is just the map as one would expect.
+// Algorithmically, the container is a hash table whose entries are linked
+// in a list by age. Each access, by get() or touch(), moves the entry to the
+// newest end of the list, and the entry at the oldest end is the one replaced.
+// Each key has a single entry, which holds the key, the data and the links of
+// the list, and the entries for the whole capacity are allocated in a single
+// block of memory, together with the hash buckets, when the cache is created.
+// So an access is a hash lookup and a few link updates, and an insertion
+// or an eviction doesn't allocate or free memory.
 //
-// This is useful for caching off data that is expensive to generate, 
+// This is useful for caching off data that is expensive to generate,
 // for example text to speech wave files that are dynamically generated,
 // but that will need to be reused, as is the case in narration of menu
 // entries as a user scrolls through the entries.
+//
+// The Policy template parameter can replace LRU with a scan resistant policy,
+// such as CLOCK, S3-FIFO or W-TinyLFU; see cache_policy.h. The entries are then
+// linked in the queues of the policy, rather than by age.
 ///////////////////////////////////////////////////////////////////////////////
 
 #ifndef EASTL_LRUCACHE_H
@@ -28,9 +36,16 @@
 #pragma once
 #endif
 
-#include <EASTL/list.h>
-#include <EASTL/unordered_map>
+#include <EASTL/internal/config.h>
+#include <EASTL/bonus/cache_policy.h>
+#include <EASTL/allocator.h>
+#include <EASTL/functional.h>
+#include <EASTL/initializer_list.h>
+#include <EASTL/iterator.h>
 #include <EASTL/optional.h>
+#include <EASTL/utility.h>
+#include <new>
+#include <stddef.h>
 
 namespace std
 {
@@ -49,48 +64,117 @@ namespace std
 	#define EASTL_LRUCACHE_DEFAULT_ALLOCATOR allocator_type(EASTL_LRUCACHE_DEFAULT_NAME)
 	#endif
 
+
+	/// lru_cache_node
+	///
+	/// An entry of an lru_cache. mnNext links the entries of a hash bucket, or the free entries.
+	/// State is the data which the cache's policy keeps for the entry.
+	///
+	template <typename Value, typename State = cache_lru_policy::entry_type>
+	struct lru_cache_node : public State
+	{
+		Value    mValue;
+		uint32_t mnNext;
+	};
+
+
+	/// lru_cache_iterator
+	///
+	/// Iterates the entries of an lru_cache from the least to the most recently used, or
+	/// in the order of its policy's list. mpList is the list of the cache, whose mNewer
+	/// is its first entry and whose mOlder is its last entry.
+	///
+	template <typename Node, typename Pointer, typename Reference>
+	struct lru_cache_iterator
+	{
+		typedef lru_cache_iterator<Node, Pointer, Reference>                               this_type;
+		typedef lru_cache_iterator<Node, typename remove_const<typename remove_pointer<Pointer>::type>::type*,
+		                           typename remove_const<typename remove_reference<Reference>::type>::type&> iterator;
+		typedef typename remove_const<typename remove_pointer<Pointer>::type>::type          value_type;
+		typedef ptrdiff_t                                                                   difference_type;
+		typedef Pointer                                                                     pointer;
+		typedef Reference                                                                   reference;
+		typedef EASTL_ITC_NS::bidirectional_iterator_tag                                    iterator_category;
+
+		Node*                 mpNodes;
+		const lru_cache_link* mpList;
+		uint32_t              mnIndex;
+
+		lru_cache_iterator()
+			: mpNodes(NULL), mpList(NULL), mnIndex(lru_cache_link::kNone) { }
+
+		lru_cache_iterator(Node* pNodes, const lru_cache_link* pList, uint32_t nIndex)
+			: mpNodes(pNodes), mpList(pList), mnIndex(nIndex) { }
+
+		lru_cache_iterator(const iterator& x)
+			: mpNodes(x.mpNodes), mpList(x.mpList), mnIndex(x.mnIndex) { }
+
+		reference operator*() const  { return mpNodes[mnIndex].mValue; }
+		pointer   operator->() const { return &mpNodes[mnIndex].mValue; }
+
+		this_type& operator++()   { mnIndex = mpNodes[mnIndex].mValue.second.second.mNewer; return *this; }
+		this_type  operator++(int) { this_type temp(*this); ++*this; return temp; }
+
+		this_type& operator--()   { mnIndex = (mnIndex == lru_cache_link::kNone) ? mpList->mOlder : mpNodes[mnIndex].mValue.second.second.mOlder; return *this; }
+		this_type  operator--(int) { this_type temp(*this); --*this; return temp; }
+	};
+
+	template <typename Node, typename PointerA, typename ReferenceA, typename PointerB, typename ReferenceB>
+	inline bool operator==(const lru_cache_iterator<Node, PointerA, ReferenceA>& a, const lru_cache_iterator<Node, PointerB, ReferenceB>& b)
+		{ return a.mnIndex == b.mnIndex; }
+
+	template <typename Node, typename PointerA, typename ReferenceA, typename PointerB, typename ReferenceB>
+	inline bool operator!=(const lru_cache_iterator<Node, PointerA, ReferenceA>& a, const lru_cache_iterator<Node, PointerB, ReferenceB>& b)
+		{ return a.mnIndex != b.mnIndex; }
+
+
 	/// lru_cache
 	///
 	/// Implements a caching map based off of a key and data.
-	/// LRUList parameter is any container that guarantees the validity of its iterator even after a modification (e.g. list)
-	/// LRUMap is any mapping container that can map a key to some data.  By default, we use unordered_set, but it might be better
-	/// to use hash_map or some other structure depending on your key/data combination.  For example, you may want to swap the 
-	/// map backing if using strings as keys or if the data objects are small.  In any case, unordered_set is a good default and should
-	/// work well enough since the purpose of this class is to cache results of expensive, order of milliseconds, operations
+	/// Hash and Predicate hash and compare keys, as with unordered_map. Policy chooses the
+	/// entry to evict (see cache_policy.h). The capacity must be less than 0xffffffff entries.
 	///
-	/// Algorithmic Performance (default data structures):
+	/// Algorithmic Performance:
 	///		touch() -> O(1)
-	///		insert() / update(), get() / operator[] -> equivalent to unordered_set (O(1) on average, O(n) worst)
+	///		insert() / update(), get() / operator[] -> equivalent to unordered_map (O(1) on average, O(n) worst)
 	///		size() -> O(1)
+	///		resize() -> O(n), as the entries are moved to storage of the new capacity
 	///
 	/// All accesses to a given key (insert, update, get) will push that key to most recently used.
+	/// Iteration is from the least to the most recently used entry (with another policy, in the
+	/// order of its list, starting with the entries it would evict first), and each entry is a
+	/// pair of the key and a pair of the data and the links of the entry (data_container_type).
+	/// Insertions and erasures don't invalidate iterators to other entries, but resize() does.
 	/// If the data objects are shared between threads, it would be best to use a smartptr to manage the lifetime of the data.
 	/// as it could be removed from the cache while in use by another thread.
 	template <typename Key,
 	          typename Value,
 	          typename Allocator = EASTLAllocatorType,
-	          typename list_type = std::list<Key, Allocator>,
-	          typename map_type = std::unordered_map<Key,
-	                                                   std::pair<Value, typename list_type::iterator>,
-	                                                   std::hash<Key>,
-	                                                   std::equal_to<Key>,
-	                                                   Allocator>>
+	          typename Hash = std::hash<Key>,
+	          typename Predicate = std::equal_to<Key>,
+	          typename Policy = cache_lru_policy>
 	class lru_cache
 	{
 	public:
 		using key_type = Key;
 		using value_type = Value;
 		using allocator_type = Allocator;
+		using hasher = Hash;
+		using key_equal = Predicate;
+		using policy_type = Policy;
 		using size_type = eastl_size_t;
-		using list_iterator = typename list_type::iterator;
-		using map_iterator = typename map_type::iterator;
-		using data_container_type = std::pair<value_type, list_iterator>;
-		using iterator = typename map_type::iterator;
-		using const_iterator = typename map_type::const_iterator;
-		using this_type = lru_cache<key_type, value_type, Allocator, list_type, map_type>;
+		using data_container_type = std::pair<value_type, lru_cache_link>;
+		using node_type = lru_cache_node<std::pair<const key_type, data_container_type>, typename Policy::entry_type>;
+		using iterator = lru_cache_iterator<node_type, std::pair<const key_type, data_container_type>*, std::pair<const key_type, data_container_type>&>;
+		using const_iterator = lru_cache_iterator<node_type, const std::pair<const key_type, data_container_type>*, const std::pair<const key_type, data_container_type>&>;
+		using reverse_iterator = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+		using this_type = lru_cache<key_type, value_type, Allocator, Hash, Predicate, Policy>;
 		using create_callback_type = std::function<value_type(key_type)>;
 		using delete_callback_type = std::function<void(const value_type &)>;
 
+		static const uint32_t kNone = lru_cache_link::kNone;
+
 		/// lru_cache constructor
 		///
 		/// Creates a Key / Value map that only stores size Value objects until it deletes them.
@@ -100,25 +184,25 @@ namespace std
 		                   const allocator_type& allocator = EASTL_LRUCACHE_DEFAULT_ALLOCATOR,
 		                   create_callback_type creator = nullptr,
 		                   delete_callback_type deletor = nullptr)
-		    : m_list(allocator)
-		    , m_map(allocator)
+		    : m_nodes(NULL)
+		    , m_buckets(NULL)
+		    , m_bucket_count(0)
+		    , m_size(0)
 		    , m_capacity(size)
+		    , m_allocator(allocator)
 		    , m_create_callback(creator)
 		    , m_delete_callback(deletor)
 		{
+			allocate_storage();
 		}
 
 		/// lru_cache destructor
 		///
-		/// Iterates across every entry in the map and calls the deletor before calling the standard destructors
+		/// Calls the deletor for every entry before calling the standard destructors
 		~lru_cache()
 		{
-			// Destruct everything we have cached
-			for (auto& iter : m_map)
-			{
-				if (m_delete_callback)
-					m_delete_callback(iter.second.first);
-			}
+			clear();
+			free_storage();
 		}
 
 		lru_cache(std::initializer_list<std::pair<Key, Value>> il)
@@ -133,19 +217,17 @@ namespace std
 		this_type &operator=(const this_type&) = delete;
 
 		/// insert
-		/// 
+		///
 		/// insert key k with value v.
 		/// If key already exists, no change is made and the return value is false.
 		/// If the key doesn't exist, the data is added to the map and the return value is true.
 		bool insert(const key_type& k, const value_type& v)
 		{
-			if (m_map.find(k) == m_map.end())
-			{
-				make_space();
-
-				m_list.push_front(k);
-				m_map[k] = data_container_type(v, m_list.begin());
+			const size_t h = m_hash(k);
 
+			if (find_index(k, h) == kNone)
+			{
+				create_entry(k, h, v);
 				return true;
 			}
 			else
@@ -155,16 +237,19 @@ namespace std
 		}
 
 		/// emplace
-		/// 
+		///
 		/// Places a new object in place k created with args
 		/// If the key already exists, it is replaced.
 		template <typename... Args>
 		void emplace(const key_type& k, Args&&... args)
 		{
-			make_space();
+			const size_t   h = m_hash(k);
+			const uint32_t i = find_index(k, h);
 
-			m_list.push_front(k);
-			m_map.emplace(k, data_container_type(std::forward<Args>(args)..., m_list.begin()));
+			if (i != kNone)
+				assign_entry(i, h, value_type(std::forward<Args>(args)...));
+			else
+				create_entry(k, h, std::forward<Args>(args)...);
 		}
 
 		/// insert_or_assign
@@ -173,24 +258,35 @@ namespace std
 		/// Note that the deletor for the old v will be called before it's replaced with the new value of v
 		void insert_or_assign(const key_type& k, const value_type& v)
 		{
-			auto iter = m_map.find(k);
+			const size_t   h = m_hash(k);
+			const uint32_t i = find_index(k, h);
 
-			if (m_map.find(k) != m_map.end())
-			{
-				assign(iter, v);
-			}
+			if (i != kNone)
+				assign_entry(i, h, v);
 			else
-			{
-				insert(k, v);
-			}
+				create_entry(k, h, v);
 		}
 
 		/// contains
-		/// 
+		///
 		/// Returns true if key k exists in the cache
 		bool contains(const key_type& k) const
 		{
-			return m_map.find(k) != m_map.end();
+			return find_index(k) != kNone;
+		}
+
+		/// find
+		///
+		/// Returns the entry for key k, or end() if k does not exist. Doesn't change which entries
+		/// are most recently used; see touch(iterator&).
+		iterator find(const key_type& k)
+		{
+			return iterator(m_nodes, &m_policy.list(), find_index(k));
+		}
+
+		const_iterator find(const key_type& k) const
+		{
+			return const_iterator(m_nodes, &m_policy.list(), find_index(k));
 		}
 
 		/// at
@@ -198,11 +294,11 @@ namespace std
 		/// Retrives the data for key k, not valid if k does not exist
 		std::optional<value_type> at(const key_type& k)
 		{
-			auto iter = m_map.find(k);
+			const uint32_t i = find_index(k);
 
-			if (iter != m_map.end())
+			if (i != kNone)
 			{
-				return iter->second.first;
+				return entry_value(i);
 			}
 			else
 			{
@@ -216,22 +312,16 @@ namespace std
 		/// creator.
 		value_type& get(const key_type& k)
 		{
-			auto iter = m_map.find(k);
+			const size_t h = m_hash(k);
+			uint32_t     i = find_index(k, h);
 
 			// The entry exists in the cache
-			if (iter != m_map.end())
-			{
-				touch(k);
-				return iter->second.first;
-			}
+			if (i != kNone)
+				touch_entry(i, h);
 			else // The entry doesn't exist in the cache, so create one
-			{
-				// Add the entry to the map
-				insert(k, m_create_callback ? m_create_callback(k) : value_type());
+				i = create_entry(k, h, m_create_callback ? m_create_callback(k) : value_type());
 
-				// return the new data
-				return m_map[k].first;
-			}
+			return entry_value(i);
 		}
 
 		/// Equivalent to get(k)
@@ -243,15 +333,11 @@ namespace std
 		/// If k does not exist, returns false.  If k exists, returns true.
 		bool erase(const key_type& k)
 		{
-			auto iter = m_map.find(k);
+			const uint32_t i = find_index(k);
 
-			if (iter != m_map.end())
+			if (i != kNone)
 			{
-				m_list.erase(iter->second.second);
-
-				// Delete the actual entry
-				map_erase(iter);
-
+				erase_entry(i);
 				return true;
 			}
 
@@ -260,15 +346,11 @@ namespace std
 
 		/// erase_oldest
 		///
-		/// Removes the oldest entry from the cache.
+		/// Removes the oldest entry (the first entry, with another policy) from the cache.
 		void erase_oldest()
 		{
-			auto key = m_list.back();
-			m_list.pop_back();
-
-			// Delete the actual entry
-			auto iter = m_map.find(key);
-			map_erase(iter);
+			EASTL_ASSERT(!empty());
+			erase_entry(m_policy.list().mNewer);
 		}
 
 		/// touch
@@ -277,11 +359,12 @@ namespace std
 		/// If k does not exist, returns false.  If the touch was successful, returns true.
 		bool touch(const key_type& k)
 		{
-			auto iter = m_map.find(k);
+			const size_t   h = m_hash(k);
+			const uint32_t i = find_index(k, h);
 
-			if (iter != m_map.end())
+			if (i != kNone)
 			{
-				touch(iter);
+				touch_entry(i, h);
 				return true;
 			}
 
@@ -293,11 +376,7 @@ namespace std
 		/// Touches key at iterator iter, moving it to most recently used position
 		void touch(iterator& iter)
 		{
-			auto listRef = iter->second.second;
-
-			m_list.erase(listRef);
-			m_list.push_front(iter->first);
-			iter->second.second = m_list.begin();
+			m_policy.access(policy_entries(*this), iter.mnIndex);
 		}
 
 		/// assign
@@ -307,11 +386,12 @@ namespace std
 		/// If key k exists, existing data has its deletor called and key k's data is replaced with new v data
 		bool assign(const key_type& k, const value_type& v)
 		{
-			auto iter = m_map.find(k);
+			const size_t   h = m_hash(k);
+			const uint32_t i = find_index(k, h);
 
-			if (iter != m_map.end())
+			if (i != kNone)
 			{
-				assign(iter, v);
+				assign_entry(i, h, v);
 				return true;
 			}
 
@@ -323,97 +403,294 @@ namespace std
 		/// Updates data at spot iter with data v.
 		void assign(iterator& iter, const value_type& v)
 		{
-			if (m_delete_callback)
-				m_delete_callback(iter->second.first);
-			touch(iter);
-			iter->second.first = v;
+			assign_entry(iter.mnIndex, m_hash(iter->first), v);
 		}
 
 		// standard container functions
-		iterator begin()               EA_NOEXCEPT { return m_map.begin(); }
-		iterator end()                 EA_NOEXCEPT { return m_map.end(); }
-		iterator rbegin()              EA_NOEXCEPT { return m_map.rbegin(); }
-		iterator rend()                EA_NOEXCEPT { return m_map.rend(); }
-		const_iterator begin() const   EA_NOEXCEPT { return m_map.begin(); }
-		const_iterator cbegin() const  EA_NOEXCEPT { return m_map.cbegin(); }
-		const_iterator crbegin() const EA_NOEXCEPT { return m_map.crbegin(); }
-		const_iterator end() const     EA_NOEXCEPT { return m_map.end(); }
-		const_iterator cend() const    EA_NOEXCEPT { return m_map.cend(); }
-		const_iterator crend() const   EA_NOEXCEPT { return m_map.crend(); }
-
-		bool empty() const             EA_NOEXCEPT { return m_map.empty(); }
-		size_type size() const         EA_NOEXCEPT { return m_map.size(); }
+		iterator begin()                        EA_NOEXCEPT { return iterator(m_nodes, &m_policy.list(), m_policy.list().mNewer); }
+		iterator end()                          EA_NOEXCEPT { return iterator(m_nodes, &m_policy.list(), kNone); }
+		reverse_iterator rbegin()               EA_NOEXCEPT { return reverse_iterator(end()); }
+		reverse_iterator rend()                 EA_NOEXCEPT { return reverse_iterator(begin()); }
+		const_iterator begin() const            EA_NOEXCEPT { return const_iterator(m_nodes, &m_policy.list(), m_policy.list().mNewer); }
+		const_iterator cbegin() const           EA_NOEXCEPT { return begin(); }
+		const_reverse_iterator rbegin() const   EA_NOEXCEPT { return const_reverse_iterator(end()); }
+		const_reverse_iterator crbegin() const  EA_NOEXCEPT { return rbegin(); }
+		const_iterator end() const              EA_NOEXCEPT { return const_iterator(m_nodes, &m_policy.list(), kNone); }
+		const_iterator cend() const             EA_NOEXCEPT { return end(); }
+		const_reverse_iterator rend() const     EA_NOEXCEPT { return const_reverse_iterator(begin()); }
+		const_reverse_iterator crend() const    EA_NOEXCEPT { return rend(); }
+
+		bool empty() const             EA_NOEXCEPT { return m_size == 0; }
+		size_type size() const         EA_NOEXCEPT { return m_size; }
 		size_type capacity() const     EA_NOEXCEPT { return m_capacity; }
 
 		void clear() EA_NOEXCEPT
 		{
-			// Since we have a delete callback, we want to reuse the trim function by cheating the max
-			// size to clear all the entries to avoid duplicating code.
-			auto old_max = m_capacity;
+			for (uint32_t i = m_policy.list().mNewer; i != kNone; i = m_nodes[i].mValue.second.second.mNewer)
+			{
+				if (m_delete_callback)
+					m_delete_callback(entry_value(i));
+				m_nodes[i].mValue.~node_value_type();
+			}
 
-			m_capacity = 0;
-			trim();
-			m_capacity = old_max;
+			reset_entries();
 		}
 
 		/// resize
 		///
 		/// Resizes the cache.  Can be used to either expand or contract the cache.
-		/// In the case of a contraction, the oldest entries will be evicted with their respective
-		/// deletors called before completing.
-		void resize(size_type newSize)	
+		/// In the case of a contraction, the oldest entries (those chosen by the policy) will be
+		/// evicted with their respective deletors called before completing. The entries are then
+		/// moved to storage for the new capacity, in the order of the list. A policy's other data,
+		/// such as the frequencies of W-TinyLFU, is reset.
+		void resize(size_type newSize)
 		{
+			while (m_size > newSize)
+				erase_entry(m_policy.victim(policy_entries(*this)));
+
+			if (newSize == m_capacity)
+				return;
+
+			node_type* const  pOldNodes    = m_nodes;
+			const size_type   nOldCapacity = m_capacity;
+			const size_type   nOldBuckets  = m_bucket_count;
+			const uint32_t    nFirst       = m_policy.list().mNewer;
+
 			m_capacity = newSize;
-			trim();
+			allocate_storage();
+
+			for (uint32_t i = nFirst; i != kNone; )
+			{
+				node_value_type& value = pOldNodes[i].mValue;
+				const uint32_t   iNext = value.second.second.mNewer;
+				const uint32_t   j     = allocate_entry(m_hash(value.first));
+
+				static_cast<typename Policy::entry_type&>(m_nodes[j]) = static_cast<typename Policy::entry_type&>(pOldNodes[i]);
+				::new((void*)&m_nodes[j].mValue) node_value_type(std::move(value));
+				m_policy.relink(policy_entries(*this), j);
+				++m_size;
+
+				value.~node_value_type();
+				i = iNext;
+			}
+
+			if (pOldNodes)
+				EASTLFree(m_allocator, pOldNodes, storage_size(nOldCapacity, nOldBuckets));
 		}
-		
+
 		void setCreateCallback(create_callback_type callback) { m_create_callback = callback; }
 		void setDeleteCallback(delete_callback_type callback) { m_delete_callback = callback; }
 
 		// EASTL extensions
-		const allocator_type& get_allocator() const EA_NOEXCEPT					{ return m_map.get_allocator(); }
-		allocator_type&       get_allocator() EA_NOEXCEPT						{ return m_map.get_allocator(); }
-		void                  set_allocator(const allocator_type& allocator)	{ m_map.set_allocator(allocator); m_list.set_allocator(allocator); }
+		const allocator_type& get_allocator() const EA_NOEXCEPT					{ return m_allocator; }
+		allocator_type&       get_allocator() EA_NOEXCEPT						{ return m_allocator; }
+		void                  set_allocator(const allocator_type& allocator)	{ m_allocator = allocator; }
 
-		/// Does not reset the callbacks
-		void reset_lose_memory() EA_NOEXCEPT									{ m_map.reset_lose_memory(); m_list.reset_lose_memory(); }
+		/// Does not reset the callbacks. The storage is allocated again when it's next needed.
+		void reset_lose_memory() EA_NOEXCEPT
+		{
+			m_nodes        = NULL;
+			m_buckets      = NULL;
+			m_bucket_count = 0;
+			reset_entries();
+		}
 
 	private:
-		inline void map_erase(map_iterator pos)
+		using node_value_type = std::pair<const key_type, data_container_type>;
+
+		// The view of the entries which the policy is given. The hash of the key of entry mnIndex is known
+		// to be mnHash, if it's not kNone.
+		struct policy_entries
 		{
-			if (m_delete_callback)
-				m_delete_callback(pos->second.first);
-			m_map.erase(pos);
+			this_type& mCache;
+			uint32_t   mnIndex;
+			size_t     mnHash;
+
+			explicit policy_entries(this_type& cache, uint32_t nIndex = kNone, size_t nHash = 0)
+				: mCache(cache), mnIndex(nIndex), mnHash(nHash) { }
+
+			lru_cache_link&              link(uint32_t i) const  { return mCache.entry_link(i); }
+			typename Policy::entry_type& state(uint32_t i) const { return mCache.m_nodes[i]; }
+			size_t                       hash(uint32_t i) const  { return (i == mnIndex) ? mnHash : (size_t)mCache.m_hash(mCache.m_nodes[i].mValue.first); }
+		};
+
+		// The policy's memory follows the entries, and the buckets follow it.
+		static size_t policy_offset(size_type nCapacity)
+		{
+			return (size_t)(nCapacity * sizeof(node_type) + 7) & ~(size_t)7;
+		}
+
+		static size_t storage_size(size_type nCapacity, size_type nBucketCount)
+		{
+			return policy_offset(nCapacity) + Policy::storage_size(nCapacity) + (size_t)(nBucketCount * sizeof(uint32_t));
 		}
-		
-		bool trim()
+
+		void* policy_storage() const
+		{
+			return (m_nodes && Policy::storage_size(m_capacity)) ? (char*)m_nodes + policy_offset(m_capacity) : NULL;
+		}
+
+		// Allocates the entries for the capacity, and the policy's memory, followed by a power of two buckets,
+		// at least twice as many as the entries, which keeps the chains short enough that a lookup rarely
+		// follows one.
+		void allocate_storage()
 		{
-			if (size() <= m_capacity)
+			EASTL_ASSERT(m_capacity < kNone);
+
+			m_nodes        = NULL;
+			m_buckets      = NULL;
+			m_bucket_count = 0;
+			m_bucket_shift = 63;
+
+			if (m_capacity)
 			{
-				return false; // No trim necessary
+				const size_t nAlignment = (EASTL_ALIGN_OF(node_type) > 8) ? EASTL_ALIGN_OF(node_type) : 8;
+
+				m_bucket_count = 2;
+
+				while (m_bucket_count < 2 * m_capacity)
+				{
+					m_bucket_count *= 2;
+					m_bucket_shift--;
+				}
+
+				m_nodes   = (node_type*)allocate_memory(m_allocator, storage_size(m_capacity, m_bucket_count), nAlignment, 0);
+				m_buckets = (uint32_t*)((char*)m_nodes + policy_offset(m_capacity) + Policy::storage_size(m_capacity));
 			}
 
-			// We need to trim
-			do
+			reset_entries();
+		}
+
+		void free_storage()
+		{
+			if (m_nodes)
+				EASTLFree(m_allocator, m_nodes, storage_size(m_capacity, m_bucket_count));
+		}
+
+		void reset_entries()
+		{
+			for (size_type i = 0; i < m_bucket_count; i++)
+				m_buckets[i] = kNone;
+
+			m_policy.reset(policy_storage(), m_capacity);
+			m_free = kNone;
+			m_used = 0;
+			m_size = 0;
+		}
+
+		// The hash is multiplied by 2^64 / phi, and the top bits of the product select the bucket,
+		// so that keys which differ only in the high bits of their hash (as with integers hashed
+		// to themselves) don't share buckets.
+		uint32_t bucket_index(size_t h) const
+		{
+			return (uint32_t)(((uint64_t)h * UINT64_C(0x9E3779B97F4A7C15)) >> m_bucket_shift);
+		}
+
+		uint32_t find_index(const key_type& k, size_t h) const
+		{
+			if (m_size)
 			{
-				erase_oldest();
-			} while (m_list.size() > m_capacity);
+				for (uint32_t i = m_buckets[bucket_index(h)]; i != kNone; i = m_nodes[i].mnNext)
+				{
+					if (m_equal(m_nodes[i].mValue.first, k))
+						return i;
+				}
+			}
+
+			return kNone;
+		}
+
+		uint32_t find_index(const key_type& k) const
+		{
+			return m_size ? find_index(k, m_hash(k)) : kNone;
+		}
 
-			return true;
+		value_type&     entry_value(uint32_t i) { return m_nodes[i].mValue.second.first; }
+		lru_cache_link& entry_link(uint32_t i)  { return m_nodes[i].mValue.second.second; }
+
+		void touch_entry(uint32_t i, size_t h)
+		{
+			m_policy.access(policy_entries(*this, i, h), i);
 		}
 
-		void make_space()
+		// Returns a free entry, and links it in the bucket of hash h.
+		uint32_t allocate_entry(size_t h)
 		{
-			if (size() == m_capacity)
+			uint32_t i;
+
+			if (m_free != kNone)
 			{
-				erase_oldest();
+				i      = m_free;
+				m_free = m_nodes[i].mnNext;
 			}
+			else
+				i = m_used++;
+
+			uint32_t& bucket = m_buckets[bucket_index(h)];
+			m_nodes[i].mnNext = bucket;
+			bucket = i;
+
+			return i;
+		}
+
+		template <typename... Args>
+		uint32_t create_entry(const key_type& k, size_t h, Args&&... args)
+		{
+			if (!m_nodes) // If reset_lose_memory was called.
+				allocate_storage();
+
+			EASTL_ASSERT(m_capacity != 0);
+			if (m_size == m_capacity)
+				erase_entry(m_policy.victim(policy_entries(*this)));
+
+			const uint32_t i = allocate_entry(h);
+
+			::new((void*)&m_nodes[i].mValue) node_value_type(k, data_container_type(value_type(std::forward<Args>(args)...), lru_cache_link()));
+			m_policy.insert(policy_entries(*this, i, h), i);
+			++m_size;
+
+			return i;
+		}
+
+		template <typename V>
+		void assign_entry(uint32_t i, size_t h, V&& v)
+		{
+			if (m_delete_callback)
+				m_delete_callback(entry_value(i));
+			touch_entry(i, h);
+			entry_value(i) = std::forward<V>(v);
+		}
+
+		void erase_entry(uint32_t i)
+		{
+			uint32_t* pIndex = &m_buckets[bucket_index(m_hash(m_nodes[i].mValue.first))];
+			while (*pIndex != i)
+				pIndex = &m_nodes[*pIndex].mnNext;
+			*pIndex = m_nodes[i].mnNext;
+
+			m_policy.erase(policy_entries(*this), i);
+			if (m_delete_callback)
+				m_delete_callback(entry_value(i));
+			m_nodes[i].mValue.~node_value_type();
+
+			m_nodes[i].mnNext = m_free;
+			m_free = i;
+			--m_size;
 		}
 
 	private:
-		list_type				m_list;
-		map_type				m_map;
+		node_type*				m_nodes;		// The entries, followed by the policy's memory and the buckets, in one block of memory.
+		uint32_t*				m_buckets;		// The first entry of each bucket.
+		size_type				m_bucket_count;
+		int						m_bucket_shift;	// 64 - log2(m_bucket_count)
+		Policy					m_policy;		// Links the entries in its list.
+		uint32_t				m_free;			// The entries which have been erased, linked by mnNext.
+		uint32_t				m_used;			// The entries from here on have never been used.
+		size_type				m_size;
 		size_type				m_capacity;
+		hasher					m_hash;
+		key_equal				m_equal;
+		allocator_type			m_allocator;
 		create_callback_type	m_create_callback;
 		delete_callback_type	m_delete_callback;
 	};
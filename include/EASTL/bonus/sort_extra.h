@@ -8,6 +8,7 @@
 //    selection_sort        -- Unstable.
 //    shaker_sort           -- Stable.
 //    bucket_sort           -- Stable. 
+//    string_sort           -- Unstable.    Multikey quicksort for ranges of strings.
 //
 //////////////////////////////////////////////////////////////////////////////
 
@@ -23,6 +24,7 @@
 #include <EASTL/heap.h>
 #include <EASTL/sort>             // For backwards compatibility due to sorts moved from here to sort.
 #include <EASTL/allocator.h>
+#include <EASTL/internal/char_traits.h>
 
 #if defined(EA_PRAGMA_ONCE_SUPPORTED)
 	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
@@ -178,6 +180,308 @@ namespace std
 
 
 
+	/// string_sort
+	///
+	/// Sorts a range of strings into lexicographical order. The strings may be basic_string,
+	/// fixed_string or basic_string_view objects, or pointers to null-terminated strings,
+	/// of any character type. Characters compare as unsigned values, as in basic_string::compare.
+	/// The sort is not stable, which only matters for distinct objects holding equal strings.
+	///
+	/// This is a multikey quicksort (Bentley and Sedgewick): the strings are partitioned into
+	/// those less than, equal to and greater than the pivot in the characters at the current
+	/// depth, and only the equal ones are compared at greater depths. Thus no string prefix is 
+	/// compared more than once, unlike comparison sorts which compare each pair of strings from
+	/// their first character. The next 8 bytes of characters of each string are cached as an
+	/// integer, so that partitioning neither follows string pointers nor compares one character
+	/// at a time. Large ranges are radix sorted by that integer instead of partitioned by it.
+	///
+	/// The sort works on arrays of 48 bytes per string, after which the strings are moved to
+	/// their places through a buffer of (last - first) strings. Both are allocated with the
+	/// default allocator. The string type must be move constructible and move assignable.
+	///
+	/// Example usage:
+	///     vector<string> words;
+	///     string_sort(words.begin(), words.end());
+	///
+	namespace Internal
+	{
+		/// string_sort_traits
+		///
+		/// Gives string_sort the characters of a string.
+		///
+		template <typename String>
+		struct string_sort_traits
+		{
+			typedef typename String::value_type char_type;
+
+			static const char_type* chars(const String& s, size_t& nLength)
+				{ nLength = (size_t)s.size(); return s.data(); }
+		};
+
+		template <typename CharT>
+		struct string_sort_traits<CharT*>
+		{
+			typedef typename remove_const<CharT>::type char_type;
+
+			static const char_type* chars(const char_type* p, size_t& nLength)
+				{ nLength = CharStrlen(p); return p; }
+		};
+
+
+		// The entries sorted are kept small by leaving the string pointers in a separate array.
+		struct string_sort_entry
+		{
+			uint64_t mKey;    // The characters at the current depth, packed in comparison order and padded with zeros.
+			size_t   mIndex;  // The position of the string in the range.
+		};
+
+		template <typename CharT>
+		struct string_sort_string
+		{
+			const CharT* mpChars;
+			size_t       mLength;
+		};
+
+		// Ranges of up to this many strings are insertion sorted.
+		const size_t kStringSortInsertionSortLimit = 16;
+
+		// Ranges larger than this choose the pivot as the median of three medians of three.
+		const size_t kStringSortNintherLimit = 128;
+
+		// Ranges of at least this many strings are radix sorted by their keys rather than partitioned.
+		const size_t kStringSortRadixSortMinCount = 1024;
+
+
+		template <typename CharT>
+		inline uint64_t string_sort_key(const CharT* pChars, size_t nLength, size_t nDepth)
+		{
+			typedef typename make_unsigned<CharT>::type uchar_type;
+
+			const size_t kCharsPerKey = sizeof(uint64_t) / sizeof(CharT);
+			const int    kCharBits    = (int)(sizeof(CharT) * 8);
+
+			uint64_t key = 0;
+
+			if((nDepth + kCharsPerKey) <= nLength)
+			{
+				for(size_t i = 0; i < kCharsPerKey; i++)
+					key = (key << kCharBits) | (uint64_t)(uchar_type)pChars[nDepth + i];
+			}
+			else
+			{
+				for(size_t i = 0; i < kCharsPerKey; i++)
+					key = (key << kCharBits) | (((nDepth + i) < nLength) ? (uint64_t)(uchar_type)pChars[nDepth + i] : 0);
+			}
+
+			return key;
+		}
+
+
+		// Returns true if a orders before b, given that they are equal before nDepth.
+		template <typename CharT>
+		inline bool string_sort_less(const string_sort_entry& a, const string_sort_entry& b, const string_sort_string<CharT>* pStrings, size_t nDepth)
+		{
+			if(a.mKey != b.mKey)
+				return (a.mKey < b.mKey);
+
+			// A string which ends within the key is a prefix of any other string with the same key.
+			const string_sort_string<CharT>& sa = pStrings[a.mIndex];
+			const string_sort_string<CharT>& sb = pStrings[b.mIndex];
+			const size_t nNextDepth = nDepth + (sizeof(uint64_t) / sizeof(CharT));
+
+			if((sa.mLength <= nNextDepth) || (sb.mLength <= nNextDepth))
+				return (sa.mLength < sb.mLength);
+
+			const size_t nCount  = ((sa.mLength < sb.mLength) ? sa.mLength : sb.mLength) - nNextDepth;
+			const int    nResult = Compare(sa.mpChars + nNextDepth, sb.mpChars + nNextDepth, nCount);
+
+			return (nResult != 0) ? (nResult < 0) : (sa.mLength < sb.mLength);
+		}
+
+
+		template <typename CharT>
+		void string_sort_insertion_sort(string_sort_entry* pFirst, size_t n, const string_sort_string<CharT>* pStrings, size_t nDepth)
+		{
+			for(size_t i = 1; i < n; i++)
+			{
+				const string_sort_entry entry = pFirst[i];
+				size_t j = i;
+
+				for(; (j > 0) && string_sort_less(entry, pFirst[j - 1], pStrings, nDepth); j--)
+					pFirst[j] = pFirst[j - 1];
+
+				pFirst[j] = entry;
+			}
+		}
+
+
+		inline uint64_t string_sort_median(uint64_t a, uint64_t b, uint64_t c)
+		{
+			if(a < b)
+				return (b < c) ? b : ((a < c) ? c : a);
+			else
+				return (a < c) ? a : ((b < c) ? c : b);
+		}
+
+
+		// Strings which end within the key of [pEqual, pEqualEnd) are equal but for their lengths, and
+		// precede the others. Sorts them by length, and loads the next key of the others, which remain
+		// to be sorted at the next depth. Returns the first of the others.
+		template <typename CharT>
+		string_sort_entry* string_sort_next_depth(string_sort_entry* pEqual, string_sort_entry* pEqualEnd, const string_sort_string<CharT>* pStrings, size_t nNextDepth)
+		{
+			string_sort_entry* const pLonger = std::partition(pEqual, pEqualEnd, [=](const string_sort_entry& e) { return pStrings[e.mIndex].mLength <= nNextDepth; });
+
+			if((pLonger - pEqual) > 1)
+				std::sort(pEqual, pLonger, [=](const string_sort_entry& a, const string_sort_entry& b) { return pStrings[a.mIndex].mLength < pStrings[b.mIndex].mLength; });
+
+			for(string_sort_entry* p = pLonger; p != pEqualEnd; ++p)
+				p->mKey = string_sort_key(pStrings[p->mIndex].mpChars, pStrings[p->mIndex].mLength, nNextDepth);
+
+			return pLonger;
+		}
+
+
+		// Sorts the n entries at pFirst, which are equal in their first nDepth characters. 
+		// pBuffer is scratch space for n entries.
+		template <typename CharT>
+		void string_sort_impl(string_sort_entry* pFirst, string_sort_entry* pBuffer, size_t n, const string_sort_string<CharT>* pStrings, size_t nDepth)
+		{
+			const size_t kCharsPerKey = sizeof(uint64_t) / sizeof(CharT);
+
+			if(n >= kStringSortRadixSortMinCount)
+			{
+				// Radix sort by the key, then sort each run of equal keys at the next depth.
+				std::radix_sort(pFirst, pFirst + n, pBuffer, [](const string_sort_entry& e) { return e.mKey; });
+
+				for(size_t i = 0; i < n; )
+				{
+					size_t iEnd = i + 1;
+					while((iEnd < n) && (pFirst[iEnd].mKey == pFirst[i].mKey))
+						iEnd++;
+
+					if((iEnd - i) > 1)
+					{
+						string_sort_entry* const pLonger = string_sort_next_depth(pFirst + i, pFirst + iEnd, pStrings, nDepth + kCharsPerKey);
+						const size_t             nLonger = (size_t)((pFirst + iEnd) - pLonger);
+
+						if(nLonger > 1)
+							string_sort_impl(pLonger, pBuffer + (pLonger - pFirst), nLonger, pStrings, nDepth + kCharsPerKey);
+					}
+
+					i = iEnd;
+				}
+
+				return;
+			}
+
+			while(n > kStringSortInsertionSortLimit)
+			{
+				uint64_t pivot;
+
+				if(n > kStringSortNintherLimit)
+				{
+					const size_t s = n / 8;
+					pivot = string_sort_median(string_sort_median(pFirst[0].mKey,         pFirst[s].mKey,         pFirst[2 * s].mKey),
+					                           string_sort_median(pFirst[n / 2 - s].mKey, pFirst[n / 2].mKey,     pFirst[n / 2 + s].mKey),
+					                           string_sort_median(pFirst[n - 1 - 2 * s].mKey, pFirst[n - 1 - s].mKey, pFirst[n - 1].mKey));
+				}
+				else
+					pivot = string_sort_median(pFirst[0].mKey, pFirst[n / 2].mKey, pFirst[n - 1].mKey);
+
+				// Partition into [0, nLess) < pivot, [nLess, nGreater) == pivot and [nGreater, n) > pivot.
+				size_t nLess = 0, i = 0, nGreater = n;
+
+				while(i < nGreater)
+				{
+					const uint64_t key = pFirst[i].mKey;
+
+					if(key < pivot)
+						std::swap(pFirst[nLess++], pFirst[i++]);
+					else if(pivot < key)
+						std::swap(pFirst[i], pFirst[--nGreater]);
+					else
+						i++;
+				}
+
+				string_sort_entry* const pEqualEnd = pFirst + nGreater;
+				string_sort_entry* const pLonger   = string_sort_next_depth(pFirst + nLess, pEqualEnd, pStrings, nDepth + kCharsPerKey);
+
+				// Recurse into the two smaller parts and continue with the largest, 
+				// which limits the recursion depth to log2(n).
+				struct Part { string_sort_entry* mpFirst; size_t mCount; size_t mDepth; };
+
+				Part parts[3] = { { pFirst,    nLess,                         nDepth                },
+				                  { pLonger,   (size_t)(pEqualEnd - pLonger), nDepth + kCharsPerKey },
+				                  { pEqualEnd, n - nGreater,                  nDepth                } };
+
+				size_t nLargest = (parts[1].mCount > parts[0].mCount) ? 1 : 0;
+				if(parts[2].mCount > parts[nLargest].mCount)
+					nLargest = 2;
+
+				for(size_t p = 0; p < 3; p++)
+				{
+					if((p != nLargest) && (parts[p].mCount > 1))
+						string_sort_impl(parts[p].mpFirst, pBuffer + (parts[p].mpFirst - pFirst), parts[p].mCount, pStrings, parts[p].mDepth);
+				}
+
+				pBuffer += (parts[nLargest].mpFirst - pFirst);
+				pFirst   = parts[nLargest].mpFirst;
+				n        = parts[nLargest].mCount;
+				nDepth   = parts[nLargest].mDepth;
+			}
+
+			string_sort_insertion_sort(pFirst, n, pStrings, nDepth);
+		}
+
+	} // namespace Internal
+
+	template <typename RandomAccessIterator>
+	void string_sort(RandomAccessIterator first, RandomAccessIterator last)
+	{
+		typedef typename std::iterator_traits<RandomAccessIterator>::value_type  value_type;
+		typedef Internal::string_sort_traits<value_type>                         traits_type;
+		typedef typename traits_type::char_type                                  char_type;
+		typedef Internal::string_sort_string<char_type>                          string_type;
+
+		const size_t n = (size_t)(last - first);
+
+		if(n > 1)
+		{
+			EASTLAllocatorType& allocator = *get_default_allocator(0);
+			Internal::string_sort_entry* const pEntries = (Internal::string_sort_entry*)allocate_memory(allocator, 2 * n * sizeof(Internal::string_sort_entry), EASTL_ALIGN_OF(Internal::string_sort_entry), 0);
+			string_type* const pStrings = (string_type*)allocate_memory(allocator, n * sizeof(string_type), EASTL_ALIGN_OF(string_type), 0);
+
+			for(size_t i = 0; i < n; i++)
+			{
+				pStrings[i].mpChars = traits_type::chars(first[i], pStrings[i].mLength);
+				pEntries[i].mKey    = Internal::string_sort_key(pStrings[i].mpChars, pStrings[i].mLength, 0);
+				pEntries[i].mIndex  = i;
+			}
+
+			Internal::string_sort_impl(pEntries, pEntries + n, n, pStrings, 0);
+			EASTLFree(allocator, pStrings, n * sizeof(string_type));
+
+			// Move the strings out in sorted order and then back. This accesses the range in
+			// random order once, where following the cycles of the permutation would do so twice.
+			value_type* const pValues = (value_type*)allocate_memory(allocator, n * sizeof(value_type), EASTL_ALIGN_OF(value_type), 0);
+
+			for(size_t i = 0; i < n; i++)
+				::new((void*)(pValues + i)) value_type(std::move(first[pEntries[i].mIndex]));
+
+			for(size_t i = 0; i < n; i++)
+			{
+				first[i] = std::move(pValues[i]);
+				pValues[i].~value_type();
+			}
+
+			EASTLFree(allocator, pValues, n * sizeof(value_type));
+			EASTLFree(allocator, pEntries, 2 * n * sizeof(Internal::string_sort_entry));
+		}
+	}
+
+
+
 } // namespace std
 
 
@@ -0,0 +1,348 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements the following
+//     concurrent_fixed_pool
+//
+// concurrent_fixed_pool is a thread-safe version of fixed_pool. It can be
+// shared between threads (e.g. a producer thread which allocates nodes and
+// a consumer thread which frees them) without an external mutex, and can be
+// used as the pool of fixed_node_allocator via its PoolType parameter.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_CONCURRENT_FIXED_POOL_H
+#define EASTL_CONCURRENT_FIXED_POOL_H
+
+
+#include <EABase/eabase.h>
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once
+#endif
+
+#include <EASTL/internal/config.h>
+#include <EASTL/internal/fixed_pool.h>
+#include <EASTL/atomic.h>
+
+
+// 4275 - non dll-interface class used as base for DLL-interface classkey 'identifier'
+EA_DISABLE_VC_WARNING(4275);
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// EASTL_CONCURRENT_FIXED_POOL_CACHE_COUNT
+//
+// The number of free list caches in each concurrent_fixed_pool. Threads are
+// assigned to caches round-robin, so with at least as many caches as threads
+// using the pool, each thread gets a cache to itself.
+//
+#ifndef EASTL_CONCURRENT_FIXED_POOL_CACHE_COUNT
+	#define EASTL_CONCURRENT_FIXED_POOL_CACHE_COUNT 8
+#endif
+
+
+///////////////////////////////////////////////////////////////////////////////
+// EASTL_CONCURRENT_FIXED_POOL_BATCH_SIZE
+//
+// The number of nodes moved between a cache and the shared free list at
+// a time. A cache refills with this many nodes when empty and drains this
+// many back when it holds twice as many.
+//
+#ifndef EASTL_CONCURRENT_FIXED_POOL_BATCH_SIZE
+	#define EASTL_CONCURRENT_FIXED_POOL_BATCH_SIZE 16
+#endif
+
+
+
+namespace std
+{
+
+	/// EASTL_CONCURRENT_FIXED_POOL_DEFAULT_NAME
+	///
+	/// Defines a default allocator name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_CONCURRENT_FIXED_POOL_DEFAULT_NAME
+		#define EASTL_CONCURRENT_FIXED_POOL_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " concurrent_fixed_pool" // Unless the user overrides something, this is "EASTL concurrent_fixed_pool".
+	#endif
+
+
+
+	///////////////////////////////////////////////////////////////////////////
+	// concurrent_fixed_pool
+	///////////////////////////////////////////////////////////////////////////
+
+	/// concurrent_fixed_pool
+	///
+	/// Implements a fixed pool allocator which may be used from multiple threads
+	/// at once. It has the same interface as fixed_pool, except that init and
+	/// operator= must not be called while other threads use the pool.
+	///
+	/// Free nodes are held in two levels:
+	///   - A shared free list, which is a lock-free stack. Its head is a pointer
+	///     paired with a tag which is incremented upon every change and which is
+	///     swapped with a double-width compare-and-swap (cmpxchg16b on x64), so
+	///     that a node which is popped and pushed back in between another thread's
+	///     read and swap of the head (the ABA problem) is detected.
+	///   - A small array of caches, each of which is a plain singly-linked list
+	///     guarded by a flag. Each thread is assigned a cache, so the flag is
+	///     uncontended in the common case and allocate/deallocate cost one atomic
+	///     exchange and one store. A cache refills from the shared list in batches
+	///     of EASTL_CONCURRENT_FIXED_POOL_BATCH_SIZE nodes and drains back to it in
+	///     batches, so the shared list is only touched once per batch.
+	///
+	/// Nodes which have never been allocated are carved from the memory block in
+	/// batches as well, so that init doesn't need to thread the block into a list.
+	/// allocate returns NULL only after the shared list, the unused part of the
+	/// block and every cache were found to be empty.
+	///
+	/// Example usage:
+	///    typedef fixed_node_allocator<sizeof(list<Widget>::node_type), 1024, EASTL_ALIGN_OF(list<Widget>::node_type), 0, false,
+	///                                 EASTLAllocatorType, concurrent_fixed_pool> WidgetAllocator;
+	///
+	///    concurrent_fixed_pool messagePool(buffer, sizeof(buffer), sizeof(Message), EASTL_ALIGN_OF(Message));
+	///    Message* pMessage = new(messagePool.allocate()) Message; // On the producer thread.
+	///    pMessage->~Message(); messagePool.deallocate(pMessage);   // On the consumer thread.
+	///
+	class EASTL_API concurrent_fixed_pool
+	{
+	public:
+		typedef fixed_pool_base::Link Link;
+
+		enum
+		{
+			kCacheCount = EASTL_CONCURRENT_FIXED_POOL_CACHE_COUNT,
+			kBatchSize  = EASTL_CONCURRENT_FIXED_POOL_BATCH_SIZE
+		};
+
+	public:
+		/// concurrent_fixed_pool
+		///
+		/// Default constructor. As with fixed_pool, the pMemory argument is only
+		/// stored for the purposes of copy construction and init must be called.
+		///
+		concurrent_fixed_pool(void* pMemory = NULL);
+
+
+		/// concurrent_fixed_pool
+		///
+		/// Constructs a concurrent_fixed_pool with a given set of parameters.
+		///
+		concurrent_fixed_pool(void* pMemory, size_t memorySize, size_t nodeSize,
+							  size_t alignment, size_t alignmentOffset = 0);
+
+
+		/// operator=
+		///
+		concurrent_fixed_pool& operator=(const concurrent_fixed_pool&)
+		{
+			// By design we do nothing. We don't attempt to deep-copy member data.
+			return *this;
+		}
+
+
+		/// init
+		///
+		/// Initializes the pool with a given set of parameters, discarding any
+		/// outstanding allocations. This is not thread-safe with respect to
+		/// other uses of the pool.
+		///
+		void init(void* pMemory, size_t memorySize, size_t nodeSize,
+				  size_t alignment, size_t alignmentOffset = 0);
+
+
+		/// allocate
+		///
+		/// Allocates a new object of the size specified upon class initialization.
+		/// Returns NULL if there is no more memory.
+		///
+		void* allocate()
+		{
+			Link* pLink = NULL;
+			Cache& cache = mCache[GetThreadCacheIndex() % kCacheCount];
+
+			if(cache.mnLocked.exchange(1, memory_order_acquire) == 0)
+			{
+				pLink = cache.mpHead;
+
+				if(pLink)
+				{
+					cache.mpHead = pLink->mpNext;
+					cache.mnCount.store(cache.mnCount.load(memory_order_relaxed) - 1, memory_order_relaxed);
+				}
+				else
+					pLink = Refill(cache);
+
+				cache.mnLocked.store(0, memory_order_release);
+			}
+			else
+				pLink = PopShared(1).mpHead; // Another thread shares our cache and is using it. We don't wait for it.
+
+			if(!pLink)
+				pLink = AllocateSlow();
+
+			#if EASTL_FIXED_SIZE_TRACKING_ENABLED
+				if(pLink)
+					TrackAllocate();
+			#endif
+
+			return pLink;
+		}
+
+		void* allocate(size_t /*alignment*/, size_t /*offset*/)
+		{
+			return allocate();
+		}
+
+
+		/// deallocate
+		///
+		/// Frees the given object which was allocated by allocate(), possibly by
+		/// another thread. If the given node was not allocated by allocate() then
+		/// the behaviour is undefined.
+		///
+		void deallocate(void* p)
+		{
+			#if EASTL_FIXED_SIZE_TRACKING_ENABLED
+				mnCurrentSize.fetch_sub(1, memory_order_relaxed);
+			#endif
+
+			Link* const pLink = (Link*)p;
+			Cache& cache = mCache[GetThreadCacheIndex() % kCacheCount];
+
+			if(cache.mnLocked.exchange(1, memory_order_acquire) == 0)
+			{
+				pLink->mpNext = cache.mpHead;
+				cache.mpHead  = pLink;
+
+				const uint32_t nCount = cache.mnCount.load(memory_order_relaxed) + 1;
+				cache.mnCount.store(nCount, memory_order_relaxed);
+
+				if(nCount >= (2 * kBatchSize))
+					Drain(cache);
+
+				cache.mnLocked.store(0, memory_order_release);
+			}
+			else
+				PushShared(pLink, pLink);
+		}
+
+
+		/// can_allocate
+		///
+		/// Returns true if there are any free links. As other threads may be
+		/// allocating at the same time, the result is only a snapshot.
+		///
+		bool can_allocate() const;
+
+
+		/// peak_size
+		///
+		/// Returns the maximum number of outstanding allocations there have been
+		/// at any one time. This represents a high water mark for the allocation count.
+		///
+		size_t peak_size() const
+		{
+			#if EASTL_FIXED_SIZE_TRACKING_ENABLED
+				return mnPeakSize.load(memory_order_relaxed);
+			#else
+				return 0;
+			#endif
+		}
+
+
+		/// current_size
+		///
+		/// Returns the number of outstanding allocations.
+		///
+		size_t current_size() const
+		{
+			#if EASTL_FIXED_SIZE_TRACKING_ENABLED
+				return mnCurrentSize.load(memory_order_relaxed);
+			#else
+				return 0;
+			#endif
+		}
+
+
+		const char* get_name() const
+		{
+			return EASTL_CONCURRENT_FIXED_POOL_DEFAULT_NAME;
+		}
+
+
+		void set_name(const char*)
+		{
+			// Nothing to do. We don't allocate memory.
+		}
+
+	protected:
+		/// TaggedLink
+		/// The head of the shared free list. mnTag changes upon every successful swap.
+		struct TaggedLink
+		{
+			Link*     mpHead;
+			uintptr_t mnTag;
+		};
+
+		/// Cache
+		/// A free list owned by whichever thread holds mnLocked. Padded to a cache line
+		/// so that threads using neighboring caches don't contend for the same line.
+		struct Cache
+		{
+			atomic<uint32_t> mnLocked;
+			atomic<uint32_t> mnCount;  // Written only with mnLocked held, but read by can_allocate.
+			Link*            mpHead;
+			char             mPadding[(EA_CACHE_LINE_SIZE > (sizeof(uint32_t) * 2 + sizeof(Link*))) ? (EA_CACHE_LINE_SIZE - (sizeof(uint32_t) * 2 + sizeof(Link*))) : 1];
+		};
+
+		static size_t GetThreadCacheIndex();
+
+		Link*      Refill(Cache& cache);
+		void       Drain(Cache& cache);
+		Link*      AllocateSlow();
+		Link*      Carve(size_t nMaxCount, size_t& nCount);
+		TaggedLink PopShared(size_t nMaxCount);          // Returns the popped chain's first node and its node count in mnTag.
+		void       PushShared(Link* pFirst, Link* pLast);
+
+		bool IsNode(const Link* pLink) const
+		{
+			return ((const char*)pLink >= (const char*)mpBegin) && (((const char*)pLink + sizeof(Link)) <= (const char*)mpCapacity);
+		}
+
+		#if EASTL_FIXED_SIZE_TRACKING_ENABLED
+			void TrackAllocate()
+			{
+				const uint32_t nSize = mnCurrentSize.fetch_add(1, memory_order_relaxed) + 1;
+				uint32_t nPeak = mnPeakSize.load(memory_order_relaxed);
+
+				while((nSize > nPeak) && !mnPeakSize.compare_exchange_weak(nPeak, nSize, memory_order_relaxed))
+					{ } // compare_exchange_weak reloads nPeak upon failure.
+			}
+		#endif
+
+	public:
+		atomic<TaggedLink> mShared;                 // The shared free list.
+		atomic<Link*>      mpNext;                  // The start of the never-allocated part of the memory block.
+		Link*              mpBegin;
+		Link*              mpCapacity;
+		size_t             mnNodeSize;
+		Cache              mCache[kCacheCount];
+
+		#if EASTL_FIXED_SIZE_TRACKING_ENABLED
+			atomic<uint32_t> mnCurrentSize; /// Current number of allocated nodes.
+			atomic<uint32_t> mnPeakSize;    /// Max number of allocated nodes at any one time.
+		#endif
+
+	}; // concurrent_fixed_pool
+
+
+} // namespace std
+
+
+EA_RESTORE_VC_WARNING();
+
+
+#endif // Header include guard
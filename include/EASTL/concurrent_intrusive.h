@@ -0,0 +1,335 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements the following
+//     intrusive_mpsc_queue
+//     intrusive_treiber_stack
+//
+// These link objects which derive from intrusive_slist_node, as intrusive_slist
+// does, but can be used by several threads at once without a mutex. Neither
+// allocates memory: pushing an object links it through its own node.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_CONCURRENT_INTRUSIVE_H
+#define EASTL_CONCURRENT_INTRUSIVE_H
+
+
+#include <EABase/eabase.h>
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once
+#endif
+
+#include <EASTL/internal/config.h>
+#include <EASTL/bonus/intrusive_slist.h>
+#include <EASTL/atomic.h>
+
+
+
+namespace std
+{
+
+	namespace Internal
+	{
+		/// intrusive_slist_atomic_link
+		///
+		/// Returns the link of an intrusive_slist_node as an atomic. The node's
+		/// link is a plain pointer, so that the same node type serves intrusive_slist,
+		/// and atomic<intrusive_slist_node*> has the same size and representation.
+		/// Threads which may access a node at once must all do so through this.
+		///
+		inline atomic<intrusive_slist_node*>& intrusive_slist_atomic_link(intrusive_slist_node* pNode)
+		{
+			static_assert(sizeof(atomic<intrusive_slist_node*>) == sizeof(intrusive_slist_node*), "atomic pointers must have the size of plain pointers.");
+			static_assert(EASTL_ALIGN_OF(atomic<intrusive_slist_node*>) == EASTL_ALIGN_OF(intrusive_slist_node*), "atomic pointers must have the alignment of plain pointers.");
+
+			return *reinterpret_cast<atomic<intrusive_slist_node*>*>(&pNode->mpNext);
+		}
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////////
+	// intrusive_mpsc_queue
+	///////////////////////////////////////////////////////////////////////////
+
+	/// intrusive_mpsc_queue
+	///
+	/// Implements an unbounded FIFO queue of nodes which any number of threads
+	/// may push to, and one thread at a time may pop from. It follows Dmitry
+	/// Vyukov's intrusive MPSC queue: push swaps the node in as the back of the
+	/// queue and then links the previous back to it, so it is wait-free and
+	/// costs one atomic exchange regardless of contention. The consumer follows
+	/// the links from the front without any atomic read-modify-write.
+	///
+	/// A producer which is suspended between its exchange and its link hides
+	/// the nodes pushed after it from the consumer until it resumes, during
+	/// which try_pop returns NULL although the queue isn't empty. Nodes pushed
+	/// by any one thread are popped in the order that thread pushed them.
+	///
+	/// T must derive from intrusive_slist_node, and a node must not be in more
+	/// than one container at a time. The queue doesn't own its nodes; they must
+	/// outlive their time in the queue.
+	///
+	/// Example usage:
+	///    struct Message : public intrusive_slist_node { ... };
+	///    intrusive_mpsc_queue<Message> mailbox;
+	///
+	///    mailbox.push(pMessage);                   // Any thread.
+	///
+	///    while(Message* pMessage = mailbox.try_pop()) // The actor's thread.
+	///        Handle(pMessage);
+	///
+	template <typename T = intrusive_slist_node>
+	class intrusive_mpsc_queue
+	{
+	public:
+		typedef intrusive_mpsc_queue<T>   this_type;
+		typedef T                         node_type;
+		typedef T                         value_type;
+		typedef T*                        pointer;
+
+	public:
+		intrusive_mpsc_queue()
+			: mpBack(&mStub), mpFront(&mStub)
+		{
+			mStub.mpNext = NULL;
+		}
+
+		/// push
+		///
+		/// Adds the node to the back of the queue. Any thread may call this.
+		///
+		void push(value_type& value)
+		{
+			intrusive_slist_node* const pNode = &value;
+
+			Internal::intrusive_slist_atomic_link(pNode).store(NULL, memory_order_relaxed);
+			PushNode(pNode);
+		}
+
+		void push(value_type* pValue)
+			{ push(*pValue); }
+
+
+		/// try_pop
+		///
+		/// Removes the front node and returns it, or returns NULL if no node is
+		/// available. Only one thread at a time may call this.
+		///
+		value_type* try_pop()
+		{
+			intrusive_slist_node* pFront = mpFront;
+			intrusive_slist_node* pNext  = Internal::intrusive_slist_atomic_link(pFront).load(memory_order_acquire);
+
+			if(pFront == &mStub) // The stub is at the front whenever the queue was emptied; skip it.
+			{
+				if(!pNext)
+					return NULL;
+
+				mpFront = pFront = pNext;
+				pNext   = Internal::intrusive_slist_atomic_link(pFront).load(memory_order_acquire);
+			}
+
+			if(pNext)
+			{
+				mpFront = pNext;
+				return static_cast<value_type*>(pFront);
+			}
+
+			// pFront is the last linked node. Unless it's also the back, a producer is
+			// between its exchange and its link, and the nodes after pFront aren't
+			// reachable yet.
+			if(pFront != mpBack.load(memory_order_acquire))
+				return NULL;
+
+			// pFront can only be popped if another node follows it, so that mpFront has
+			// somewhere to go. We push the stub behind it for that purpose.
+			Internal::intrusive_slist_atomic_link(&mStub).store(NULL, memory_order_relaxed);
+			PushNode(&mStub);
+
+			pNext = Internal::intrusive_slist_atomic_link(pFront).load(memory_order_acquire);
+
+			if(pNext)
+			{
+				mpFront = pNext;
+				return static_cast<value_type*>(pFront);
+			}
+
+			return NULL; // A producer pushed after pFront in the meantime and hasn't linked yet.
+		}
+
+
+		/// empty
+		///
+		/// Returns true if the queue holds no nodes. Only the consumer may call this,
+		/// and producers may push nodes at any time after it returns.
+		///
+		bool empty() const
+		{
+			return (mpFront == mpBack.load(memory_order_acquire)) && (mpFront == &mStub);
+		}
+
+	protected:
+		void PushNode(intrusive_slist_node* pNode)
+		{
+			intrusive_slist_node* const pPrevious = mpBack.exchange(pNode, memory_order_acq_rel);
+			Internal::intrusive_slist_atomic_link(pPrevious).store(pNode, memory_order_release);
+		}
+
+		intrusive_mpsc_queue(const this_type&);       // Not implemented.
+		this_type& operator=(const this_type&);       // Not implemented.
+
+	protected:
+		atomic<intrusive_slist_node*> mpBack;         // Swapped by producers.
+		char                          mPadding[EA_CACHE_LINE_SIZE]; // Keeps the consumer's fields off the producers' line.
+		intrusive_slist_node*         mpFront;        // The consumer's position. Only the consumer uses this.
+		intrusive_slist_node          mStub;          // Keeps the queue from ever being without a node.
+	};
+
+
+
+	///////////////////////////////////////////////////////////////////////////
+	// intrusive_treiber_stack
+	///////////////////////////////////////////////////////////////////////////
+
+	/// intrusive_treiber_stack
+	///
+	/// Implements a LIFO stack of nodes which any number of threads may push to
+	/// and pop from at once without locking (R. K. Treiber's stack). The top is
+	/// a node pointer paired with a tag which is incremented upon every change,
+	/// swapped with a double-width compare-and-swap (cmpxchg16b on x64), so that
+	/// a pop which read the top and its next node, and was then overtaken by other
+	/// threads popping that node and pushing it back (the ABA problem), fails and
+	/// retries rather than installing a stale next node.
+	///
+	/// A thread popping reads the link of the top node, which may have been popped
+	/// by another thread in the meantime. Nodes must therefore stay readable while
+	/// any thread may be popping, e.g. by being carved from memory which lives as
+	/// long as the stack, as with the free lists of a pool.
+	///
+	/// T must derive from intrusive_slist_node, and a node must not be in more
+	/// than one container at a time.
+	///
+	/// Example usage:
+	///    intrusive_treiber_stack<Block> freeBlocks;
+	///
+	///    freeBlocks.push(pBlock);
+	///    Block* pBlock = freeBlocks.try_pop();
+	///
+	template <typename T = intrusive_slist_node>
+	class intrusive_treiber_stack
+	{
+	public:
+		typedef intrusive_treiber_stack<T>   this_type;
+		typedef T                            node_type;
+		typedef T                            value_type;
+		typedef T*                           pointer;
+
+	public:
+		intrusive_treiber_stack()
+		{
+			const TaggedTop emptyTop = { NULL, 0 };
+			mTop.store(emptyTop, memory_order_relaxed);
+		}
+
+		/// push
+		/// Adds the node to the top of the stack.
+		void push(value_type& value)
+			{ PushChain(&value, &value); }
+
+		void push(value_type* pValue)
+			{ PushChain(pValue, pValue); }
+
+
+		/// try_pop
+		/// Removes the top node and returns it, or returns NULL if the stack is empty.
+		value_type* try_pop()
+		{
+			TaggedTop top = mTop.load(memory_order_acquire);
+			TaggedTop newTop;
+
+			do {
+				if(!top.mpNode)
+					return NULL;
+
+				newTop.mpNode = Internal::intrusive_slist_atomic_link(top.mpNode).load(memory_order_relaxed); // May be stale, in which case the tag has changed.
+				newTop.mnTag  = top.mnTag + 1;
+			} while(!mTop.compare_exchange_weak(top, newTop, memory_order_acquire, memory_order_acquire));
+
+			return static_cast<value_type*>(top.mpNode);
+		}
+
+
+		/// pop_all
+		///
+		/// Removes all nodes and returns the top one, from which the others follow
+		/// through their mpNext links in the order they would have been popped.
+		///
+		value_type* pop_all()
+		{
+			TaggedTop top = mTop.load(memory_order_relaxed);
+			TaggedTop newTop;
+
+			do {
+				if(!top.mpNode)
+					return NULL;
+
+				newTop.mpNode = NULL;
+				newTop.mnTag  = top.mnTag + 1;
+			} while(!mTop.compare_exchange_weak(top, newTop, memory_order_acquire, memory_order_relaxed));
+
+			return static_cast<value_type*>(top.mpNode);
+		}
+
+
+		/// push_chain
+		///
+		/// Adds the nodes from pFirst through pLast, which are linked through their
+		/// mpNext pointers, to the top of the stack with a single swap. pFirst
+		/// becomes the top.
+		///
+		void push_chain(value_type* pFirst, value_type* pLast)
+			{ PushChain(pFirst, pLast); }
+
+
+		/// empty
+		/// Returns true if the stack is empty. The result may be out of date on return.
+		bool empty() const
+			{ return mTop.load(memory_order_acquire).mpNode == NULL; }
+
+	protected:
+		/// TaggedTop
+		/// The top of the stack. mnTag changes upon every successful swap.
+		struct TaggedTop
+		{
+			intrusive_slist_node* mpNode;
+			uintptr_t             mnTag;
+		};
+
+		void PushChain(intrusive_slist_node* pFirst, intrusive_slist_node* pLast)
+		{
+			TaggedTop top = mTop.load(memory_order_relaxed);
+			TaggedTop newTop;
+
+			do {
+				Internal::intrusive_slist_atomic_link(pLast).store(top.mpNode, memory_order_relaxed);
+				newTop.mpNode = pFirst;
+				newTop.mnTag  = top.mnTag + 1;
+			} while(!mTop.compare_exchange_weak(top, newTop, memory_order_release, memory_order_relaxed));
+		}
+
+		intrusive_treiber_stack(const this_type&);    // Not implemented.
+		this_type& operator=(const this_type&);       // Not implemented.
+
+	protected:
+		atomic<TaggedTop> mTop;
+	};
+
+
+} // namespace std
+
+
+#endif // Header include guard
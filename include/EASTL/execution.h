@@ -0,0 +1,750 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements the C++17 execution policies (execution::seq and
+// execution::par) along with the execution policy overloads of the following
+// algorithms from algorithm.h and numeric.h:
+//     for_each, transform, copy, fill, count_if, find_if,
+//     reduce, transform_reduce, accumulate, sort, stable_sort
+//
+// With execution::par, the range is divided into chunks which are run on a
+// thread_pool (see thread_pool.h), by default thread_pool::get_default().
+// A different pool and chunk size can be selected per call:
+//     std::for_each(std::execution::par.on(myPool).with_grain_size(65536), v.begin(), v.end(), Score);
+//
+// The parallel versions require random access iterators; with other iterators,
+// as with execution::seq, they call the serial algorithm. Ranges smaller than
+// EASTL_PARALLEL_MIN_GRAIN_SIZE elements are also processed serially.
+//
+// As with the C++ Standard Library, reduce and transform_reduce (and here also
+// accumulate) may apply their binary operation in any order and grouping when
+// run in parallel, so it must be associative and commutative. Functions passed
+// to the parallel versions must not throw exceptions.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_EXECUTION_H
+#define EASTL_EXECUTION_H
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/thread_pool.h>
+#include <EASTL/parallel_sort.h>
+#include <EASTL/algorithm.h>
+#include <EASTL/numeric.h>
+#include <EASTL/functional.h>
+#include <EASTL/iterator.h>
+#include <EASTL/type_traits.h>
+#include <EASTL/allocator.h>
+
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// EASTL_PARALLEL_MIN_GRAIN_SIZE
+//
+// The smallest number of elements the parallel algorithms hand to a thread
+// at a time, unless a grain size is given with parallel_policy::with_grain_size.
+// Below this size the cost of waking threads exceeds the work being split.
+//
+#ifndef EASTL_PARALLEL_MIN_GRAIN_SIZE
+	#define EASTL_PARALLEL_MIN_GRAIN_SIZE 4096
+#endif
+
+
+///////////////////////////////////////////////////////////////////////////////
+// EASTL_PARALLEL_CHUNKS_PER_THREAD
+//
+// The number of chunks per thread the parallel algorithms divide a range
+// into. More than one chunk per thread lets threads which finish early steal
+// work from threads which are slowed down (e.g. by preemption).
+//
+#ifndef EASTL_PARALLEL_CHUNKS_PER_THREAD
+	#define EASTL_PARALLEL_CHUNKS_PER_THREAD 4
+#endif
+
+
+
+namespace std
+{
+	namespace execution
+	{
+		/// sequenced_policy
+		///
+		/// The policy type of execution::seq, which runs algorithms serially on the calling thread.
+		///
+		class sequenced_policy
+		{
+		};
+
+
+		/// parallel_policy
+		///
+		/// The policy type of execution::par, which runs algorithms on a thread_pool.
+		///
+		class parallel_policy
+		{
+		public:
+			EA_CONSTEXPR parallel_policy()
+				: mpPool(NULL), mnGrainSize(0) {}
+
+			EA_CONSTEXPR parallel_policy(thread_pool* pPool, size_t nGrainSize)
+				: mpPool(pPool), mnGrainSize(nGrainSize) {}
+
+			/// on
+			/// Returns a copy of this policy which runs algorithms on the given pool.
+			parallel_policy on(thread_pool& pool) const
+				{ return parallel_policy(&pool, mnGrainSize); }
+
+			/// with_grain_size
+			/// Returns a copy of this policy which divides ranges into chunks of nGrainSize elements.
+			/// A value of 0 selects a chunk size based on the range size and the pool's concurrency.
+			parallel_policy with_grain_size(size_t nGrainSize) const
+				{ return parallel_policy(mpPool, nGrainSize); }
+
+			thread_pool& get_pool() const
+				{ return mpPool ? *mpPool : thread_pool::get_default(); }
+
+			size_t get_grain_size() const
+				{ return mnGrainSize; }
+
+		protected:
+			thread_pool* mpPool;
+			size_t       mnGrainSize;
+		};
+
+
+		EASTL_CPP17_INLINE_VARIABLE EA_CONSTEXPR sequenced_policy seq = sequenced_policy();
+		EASTL_CPP17_INLINE_VARIABLE EA_CONSTEXPR parallel_policy  par = parallel_policy();
+
+	} // namespace execution
+
+
+	/// is_execution_policy
+	///
+	/// Identifies the execution policy types, which select the overloads in this file.
+	///
+	template <typename T> struct is_execution_policy                                : public false_type {};
+	template <>           struct is_execution_policy<execution::sequenced_policy> : public true_type {};
+	template <>           struct is_execution_policy<execution::parallel_policy>  : public true_type {};
+
+	#if EASTL_VARIABLE_TEMPLATES_ENABLED
+		template <typename T>
+		EA_CONSTEXPR bool is_execution_policy_v = is_execution_policy<T>::value;
+	#endif
+
+
+
+	namespace Internal
+	{
+		/// enable_if_execution_policy
+		///
+		/// Evaluates to Result if ExecutionPolicy (which may be a reference) is an execution policy.
+		///
+		template <typename ExecutionPolicy, typename Result = void>
+		struct enable_if_execution_policy
+			: public enable_if<is_execution_policy<typename decay<ExecutionPolicy>::type>::value, Result> {};
+
+
+		/// use_parallel
+		///
+		/// true_type if the given policy is parallel_policy and the given iterators are random access,
+		/// which are the conditions under which we can divide a range into chunks. Else false_type.
+		///
+		template <typename ExecutionPolicy, typename Iterator1, typename Iterator2 = Iterator1, typename Iterator3 = Iterator1>
+		struct use_parallel
+			: public integral_constant<bool, is_same<typename decay<ExecutionPolicy>::type, execution::parallel_policy>::value &&
+			                                 is_base_of<random_access_iterator_tag, typename iterator_traits<Iterator1>::iterator_category>::value &&
+			                                 is_base_of<random_access_iterator_tag, typename iterator_traits<Iterator2>::iterator_category>::value &&
+			                                 is_base_of<random_access_iterator_tag, typename iterator_traits<Iterator3>::iterator_category>::value> {};
+
+
+		/// parallel_partition
+		///
+		/// Divides a range of n elements into chunks for a parallel_policy, and runs a
+		/// function for each chunk. The function is called as function(nChunk, nBegin, nEnd).
+		///
+		struct parallel_partition
+		{
+			size_t mnCount;
+			size_t mnGrainSize;
+			size_t mnChunkCount;
+
+			parallel_partition(const execution::parallel_policy& policy, size_t nCount)
+				: mnCount(nCount), mnGrainSize(policy.get_grain_size()), mnChunkCount(0)
+			{
+				const thread_pool& pool = policy.get_pool();
+
+				if(mnGrainSize == 0)
+				{
+					mnGrainSize = nCount / (pool.concurrency() * EASTL_PARALLEL_CHUNKS_PER_THREAD);
+
+					if(mnGrainSize < EASTL_PARALLEL_MIN_GRAIN_SIZE)
+						mnGrainSize = EASTL_PARALLEL_MIN_GRAIN_SIZE;
+				}
+
+				if(pool.worker_count() == 0)
+					mnGrainSize = nCount; // There's no one to share the work with.
+
+				if(nCount)
+					mnChunkCount = (mnGrainSize < nCount) ? ((nCount + mnGrainSize - 1) / mnGrainSize) : 1;
+			}
+
+			size_t chunk_begin(size_t nChunk) const
+				{ return nChunk * mnGrainSize; }
+
+			size_t chunk_end(size_t nChunk) const
+				{ return ((mnCount - chunk_begin(nChunk)) > mnGrainSize) ? (chunk_begin(nChunk) + mnGrainSize) : mnCount; }
+
+			template <typename Function>
+			void run(const execution::parallel_policy& policy, Function& function) const
+			{
+				if(mnChunkCount == 1)
+					function((size_t)0, (size_t)0, mnCount);
+				else if(mnChunkCount > 1)
+				{
+					const parallel_partition& partition = *this;
+
+					policy.get_pool().parallel_for(mnChunkCount, 1, [&partition, &function](size_t nBegin, size_t nEnd)
+					{
+						for(; nBegin != nEnd; ++nBegin)
+							function(nBegin, partition.chunk_begin(nBegin), partition.chunk_end(nBegin));
+					});
+				}
+			}
+		};
+
+
+		/// parallel_partials
+		///
+		/// Holds one uninitialized T per chunk, which the chunks construct in parallel.
+		/// All of them must have been constructed by the time this object is destroyed.
+		///
+		template <typename T>
+		class parallel_partials
+		{
+		public:
+			parallel_partials(size_t nCount)
+				: mAllocator(EASTL_DEFAULT_NAME_PREFIX " parallel_partials"), mnCount(nCount)
+			{
+				void* const pMemory = EASTLAllocAligned(mAllocator, nCount * sizeof(T), EASTL_ALIGN_OF(T), 0);
+				mpBegin = static_cast<T*>(pMemory);
+			}
+
+		   ~parallel_partials()
+			{
+				for(size_t i = 0; i < mnCount; i++)
+					mpBegin[i].~T();
+				EASTLFree(mAllocator, mpBegin, mnCount * sizeof(T));
+			}
+
+			void construct(size_t i, T&& value)
+				{ ::new(static_cast<void*>(mpBegin + i)) T(std::move(value)); }
+
+			T& operator[](size_t i)
+				{ return mpBegin[i]; }
+
+		protected:
+			parallel_partials(const parallel_partials&);
+			parallel_partials& operator=(const parallel_partials&);
+
+			EASTLAllocatorType mAllocator;
+			T*                 mpBegin;
+			size_t             mnCount;
+		};
+
+
+		/// parallel_map_reduce
+		///
+		/// Returns binary_op(...binary_op(init, map(0))..., map(n - 1)), evaluated in chunks. Each
+		/// chunk reduces its own elements, and the chunk results are then reduced in order.
+		///
+		template <typename T, typename BinaryOperation, typename Map>
+		T parallel_map_reduce(const execution::parallel_policy& policy, size_t n, T init, BinaryOperation& binary_op, Map& map)
+		{
+			const parallel_partition partition(policy, n);
+
+			if(partition.mnChunkCount <= 1)
+			{
+				for(size_t i = 0; i < n; i++)
+					init = binary_op(init, map(i));
+				return init;
+			}
+
+			parallel_partials<T> partials(partition.mnChunkCount);
+
+			auto reduceChunk = [&partials, &binary_op, &map](size_t nChunk, size_t nBegin, size_t nEnd)
+			{
+				T partial(map(nBegin));
+
+				while(++nBegin != nEnd)
+					partial = binary_op(partial, map(nBegin));
+
+				partials.construct(nChunk, std::move(partial));
+			};
+
+			partition.run(policy, reduceChunk);
+
+			for(size_t i = 0; i < partition.mnChunkCount; i++)
+				init = binary_op(init, partials[i]);
+
+			return init;
+		}
+
+
+		///////////////////////////////////////////////////////////////////////
+		// Algorithm implementations. The false_type versions are the serial
+		// fallbacks and the true_type versions the parallel ones.
+		///////////////////////////////////////////////////////////////////////
+
+		template <typename ExecutionPolicy, typename InputIterator, typename Function>
+		void for_each_policy(const ExecutionPolicy&, InputIterator first, InputIterator last, Function& function, false_type)
+		{
+			std::for_each(first, last, function);
+		}
+
+		template <typename RandomAccessIterator, typename Function>
+		void for_each_policy(const execution::parallel_policy& policy, RandomAccessIterator first, RandomAccessIterator last, Function& function, true_type)
+		{
+			auto chunkFunction = [first, &function](size_t, size_t nBegin, size_t nEnd)
+			{
+				std::for_each(first + nBegin, first + nEnd, function); // for_each takes a copy of function for each chunk.
+			};
+
+			parallel_partition(policy, (size_t)(last - first)).run(policy, chunkFunction);
+		}
+
+
+		template <typename ExecutionPolicy, typename InputIterator, typename OutputIterator, typename UnaryOperation>
+		OutputIterator transform_policy(const ExecutionPolicy&, InputIterator first, InputIterator last, OutputIterator result, UnaryOperation& unary_op, false_type)
+		{
+			return std::transform(first, last, result, unary_op);
+		}
+
+		template <typename RandomAccessIterator, typename RandomAccessOutputIterator, typename UnaryOperation>
+		RandomAccessOutputIterator transform_policy(const execution::parallel_policy& policy, RandomAccessIterator first, RandomAccessIterator last,
+		                                            RandomAccessOutputIterator result, UnaryOperation& unary_op, true_type)
+		{
+			auto chunkFunction = [first, result, &unary_op](size_t, size_t nBegin, size_t nEnd)
+			{
+				std::transform(first + nBegin, first + nEnd, result + nBegin, unary_op);
+			};
+
+			const size_t n = (size_t)(last - first);
+			parallel_partition(policy, n).run(policy, chunkFunction);
+			return result + n;
+		}
+
+
+		template <typename ExecutionPolicy, typename InputIterator1, typename InputIterator2, typename OutputIterator, typename BinaryOperation>
+		OutputIterator transform_policy(const ExecutionPolicy&, InputIterator1 first1, InputIterator1 last1, InputIterator2 first2,
+		                                OutputIterator result, BinaryOperation& binary_op, false_type)
+		{
+			return std::transform(first1, last1, first2, result, binary_op);
+		}
+
+		template <typename RandomAccessIterator1, typename RandomAccessIterator2, typename RandomAccessOutputIterator, typename BinaryOperation>
+		RandomAccessOutputIterator transform_policy(const execution::parallel_policy& policy, RandomAccessIterator1 first1, RandomAccessIterator1 last1,
+		                                            RandomAccessIterator2 first2, RandomAccessOutputIterator result, BinaryOperation& binary_op, true_type)
+		{
+			auto chunkFunction = [first1, first2, result, &binary_op](size_t, size_t nBegin, size_t nEnd)
+			{
+				std::transform(first1 + nBegin, first1 + nEnd, first2 + nBegin, result + nBegin, binary_op);
+			};
+
+			const size_t n = (size_t)(last1 - first1);
+			parallel_partition(policy, n).run(policy, chunkFunction);
+			return result + n;
+		}
+
+
+		template <typename ExecutionPolicy, typename InputIterator, typename OutputIterator>
+		OutputIterator copy_policy(const ExecutionPolicy&, InputIterator first, InputIterator last, OutputIterator result, false_type)
+		{
+			return std::copy(first, last, result);
+		}
+
+		template <typename RandomAccessIterator, typename RandomAccessOutputIterator>
+		RandomAccessOutputIterator copy_policy(const execution::parallel_policy& policy, RandomAccessIterator first, RandomAccessIterator last,
+		                                       RandomAccessOutputIterator result, true_type)
+		{
+			auto chunkFunction = [first, result](size_t, size_t nBegin, size_t nEnd)
+			{
+				std::copy(first + nBegin, first + nEnd, result + nBegin);
+			};
+
+			const size_t n = (size_t)(last - first);
+			parallel_partition(policy, n).run(policy, chunkFunction);
+			return result + n;
+		}
+
+
+		template <typename ExecutionPolicy, typename ForwardIterator, typename T>
+		void fill_policy(const ExecutionPolicy&, ForwardIterator first, ForwardIterator last, const T& value, false_type)
+		{
+			std::fill(first, last, value);
+		}
+
+		template <typename RandomAccessIterator, typename T>
+		void fill_policy(const execution::parallel_policy& policy, RandomAccessIterator first, RandomAccessIterator last, const T& value, true_type)
+		{
+			auto chunkFunction = [first, &value](size_t, size_t nBegin, size_t nEnd)
+			{
+				std::fill(first + nBegin, first + nEnd, value);
+			};
+
+			parallel_partition(policy, (size_t)(last - first)).run(policy, chunkFunction);
+		}
+
+
+		template <typename ExecutionPolicy, typename InputIterator, typename Predicate>
+		typename iterator_traits<InputIterator>::difference_type
+		count_if_policy(const ExecutionPolicy&, InputIterator first, InputIterator last, Predicate& predicate, false_type)
+		{
+			return std::count_if(first, last, predicate);
+		}
+
+		template <typename RandomAccessIterator, typename Predicate>
+		typename iterator_traits<RandomAccessIterator>::difference_type
+		count_if_policy(const execution::parallel_policy& policy, RandomAccessIterator first, RandomAccessIterator last, Predicate& predicate, true_type)
+		{
+			typedef typename iterator_traits<RandomAccessIterator>::difference_type difference_type;
+
+			std::plus<difference_type> binary_op;
+			auto map = [first, &predicate](size_t i) -> difference_type { return predicate(first[i]) ? 1 : 0; };
+
+			return parallel_map_reduce(policy, (size_t)(last - first), difference_type(0), binary_op, map);
+		}
+
+
+		template <typename ExecutionPolicy, typename InputIterator, typename Predicate>
+		InputIterator find_if_policy(const ExecutionPolicy&, InputIterator first, InputIterator last, Predicate& predicate, false_type)
+		{
+			return std::find_if(first, last, predicate);
+		}
+
+		template <typename RandomAccessIterator, typename Predicate>
+		RandomAccessIterator find_if_policy(const execution::parallel_policy& policy, RandomAccessIterator first, RandomAccessIterator last, Predicate& predicate, true_type)
+		{
+			// nFound holds the lowest index at which a match has been found so far. Chunks which start
+			// beyond it are skipped, and running chunks give up once a match precedes their position.
+			const size_t   n = (size_t)(last - first);
+			atomic<size_t> nFound(n);
+
+			auto chunkFunction = [first, &predicate, &nFound](size_t, size_t nBegin, size_t nEnd)
+			{
+				for(size_t i = nBegin; i != nEnd; ++i)
+				{
+					if((((i - nBegin) % 1024) == 0) && (nFound.load(memory_order_relaxed) < i))
+						return;
+
+					if(predicate(first[i]))
+					{
+						size_t nCurrent = nFound.load(memory_order_relaxed);
+						while((i < nCurrent) && !nFound.compare_exchange_weak(nCurrent, i, memory_order_relaxed))
+							{ } // compare_exchange_weak reloads nCurrent upon failure.
+						return;
+					}
+				}
+			};
+
+			parallel_partition(policy, n).run(policy, chunkFunction);
+			return first + nFound.load(memory_order_relaxed);
+		}
+
+
+		template <typename ExecutionPolicy, typename InputIterator, typename T, typename BinaryOperation>
+		T reduce_policy(const ExecutionPolicy&, InputIterator first, InputIterator last, T init, BinaryOperation& binary_op, false_type)
+		{
+			return std::reduce(first, last, init, binary_op);
+		}
+
+		template <typename RandomAccessIterator, typename T, typename BinaryOperation>
+		T reduce_policy(const execution::parallel_policy& policy, RandomAccessIterator first, RandomAccessIterator last, T init, BinaryOperation& binary_op, true_type)
+		{
+			auto map = [first](size_t i) -> decltype(first[i]) { return first[i]; };
+			return parallel_map_reduce(policy, (size_t)(last - first), init, binary_op, map);
+		}
+
+
+		template <typename ExecutionPolicy, typename InputIterator, typename T, typename BinaryOperation, typename UnaryOperation>
+		T transform_reduce_policy(const ExecutionPolicy&, InputIterator first, InputIterator last, T init,
+		                          BinaryOperation& binary_op, UnaryOperation& unary_op, false_type)
+		{
+			return std::transform_reduce(first, last, init, binary_op, unary_op);
+		}
+
+		template <typename RandomAccessIterator, typename T, typename BinaryOperation, typename UnaryOperation>
+		T transform_reduce_policy(const execution::parallel_policy& policy, RandomAccessIterator first, RandomAccessIterator last, T init,
+		                          BinaryOperation& binary_op, UnaryOperation& unary_op, true_type)
+		{
+			auto map = [first, &unary_op](size_t i) { return unary_op(first[i]); };
+			return parallel_map_reduce(policy, (size_t)(last - first), init, binary_op, map);
+		}
+
+
+		template <typename ExecutionPolicy, typename InputIterator1, typename InputIterator2, typename T, typename BinaryOperation, typename BinaryTransformOperation>
+		T transform_reduce_policy(const ExecutionPolicy&, InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, T init,
+		                          BinaryOperation& binary_op, BinaryTransformOperation& binary_transform_op, false_type)
+		{
+			return std::transform_reduce(first1, last1, first2, init, binary_op, binary_transform_op);
+		}
+
+		template <typename RandomAccessIterator1, typename RandomAccessIterator2, typename T, typename BinaryOperation, typename BinaryTransformOperation>
+		T transform_reduce_policy(const execution::parallel_policy& policy, RandomAccessIterator1 first1, RandomAccessIterator1 last1, RandomAccessIterator2 first2, T init,
+		                          BinaryOperation& binary_op, BinaryTransformOperation& binary_transform_op, true_type)
+		{
+			auto map = [first1, first2, &binary_transform_op](size_t i) { return binary_transform_op(first1[i], first2[i]); };
+			return parallel_map_reduce(policy, (size_t)(last1 - first1), init, binary_op, map);
+		}
+
+		template <typename ExecutionPolicy, typename RandomAccessIterator, typename Compare>
+		void sort_policy(const ExecutionPolicy&, RandomAccessIterator first, RandomAccessIterator last, Compare& compare, false_type)
+		{
+			std::sort<RandomAccessIterator, Compare>(first, last, compare);
+		}
+
+		template <typename RandomAccessIterator, typename Compare>
+		void sort_policy(const execution::parallel_policy& policy, RandomAccessIterator first, RandomAccessIterator last, Compare& compare, true_type)
+		{
+			const size_t nGrainSize = policy.get_grain_size();
+			parallel_sort_impl<RandomAccessIterator, Compare>(policy.get_pool(), first, last, compare, nGrainSize ? nGrainSize : EASTL_PARALLEL_SORT_THRESHOLD);
+		}
+
+		template <typename ExecutionPolicy, typename RandomAccessIterator, typename Compare>
+		void stable_sort_policy(const ExecutionPolicy&, RandomAccessIterator first, RandomAccessIterator last, Compare& compare, false_type)
+		{
+			std::stable_sort<RandomAccessIterator, Compare>(first, last, compare);
+		}
+
+		template <typename RandomAccessIterator, typename Compare>
+		void stable_sort_policy(const execution::parallel_policy& policy, RandomAccessIterator first, RandomAccessIterator last, Compare& compare, true_type)
+		{
+			const size_t nGrainSize = policy.get_grain_size();
+			parallel_stable_sort_impl<RandomAccessIterator, Compare>(policy.get_pool(), first, last, compare, nGrainSize ? nGrainSize : EASTL_PARALLEL_SORT_THRESHOLD);
+		}
+
+	} // namespace Internal
+
+
+
+	/// for_each
+	///
+	/// Calls function for each element of [first, last). With execution::par, the
+	/// calls are made from several threads and in no particular order.
+	///
+	/// Example usage:
+	///    std::for_each(std::execution::par, scores.begin(), scores.end(), [](Score& s) { s.Update(); });
+	///
+	template <typename ExecutionPolicy, typename ForwardIterator, typename Function>
+	typename Internal::enable_if_execution_policy<ExecutionPolicy>::type
+	for_each(ExecutionPolicy&& policy, ForwardIterator first, ForwardIterator last, Function function)
+	{
+		Internal::for_each_policy(policy, first, last, function, typename Internal::use_parallel<ExecutionPolicy, ForwardIterator>::type());
+	}
+
+
+	/// transform
+	///
+	/// Writes unary_op(*i) for each element i of [first, last) to the range beginning
+	/// at result. Returns the end of the output range.
+	///
+	template <typename ExecutionPolicy, typename ForwardIterator, typename ForwardOutputIterator, typename UnaryOperation>
+	typename Internal::enable_if_execution_policy<ExecutionPolicy, ForwardOutputIterator>::type
+	transform(ExecutionPolicy&& policy, ForwardIterator first, ForwardIterator last, ForwardOutputIterator result, UnaryOperation unary_op)
+	{
+		return Internal::transform_policy(policy, first, last, result, unary_op,
+		                                  typename Internal::use_parallel<ExecutionPolicy, ForwardIterator, ForwardOutputIterator>::type());
+	}
+
+
+	/// transform
+	///
+	/// Writes binary_op(*i, *j) for corresponding elements i and j of [first1, last1)
+	/// and the range beginning at first2 to the range beginning at result. Returns
+	/// the end of the output range.
+	///
+	template <typename ExecutionPolicy, typename ForwardIterator1, typename ForwardIterator2, typename ForwardOutputIterator, typename BinaryOperation>
+	typename Internal::enable_if_execution_policy<ExecutionPolicy, ForwardOutputIterator>::type
+	transform(ExecutionPolicy&& policy, ForwardIterator1 first1, ForwardIterator1 last1, ForwardIterator2 first2, ForwardOutputIterator result, BinaryOperation binary_op)
+	{
+		return Internal::transform_policy(policy, first1, last1, first2, result, binary_op,
+		                                  typename Internal::use_parallel<ExecutionPolicy, ForwardIterator1, ForwardIterator2, ForwardOutputIterator>::type());
+	}
+
+
+	/// copy
+	///
+	/// Copies [first, last) to the range beginning at result. Returns the end of the output range.
+	///
+	template <typename ExecutionPolicy, typename ForwardIterator, typename ForwardOutputIterator>
+	typename Internal::enable_if_execution_policy<ExecutionPolicy, ForwardOutputIterator>::type
+	copy(ExecutionPolicy&& policy, ForwardIterator first, ForwardIterator last, ForwardOutputIterator result)
+	{
+		return Internal::copy_policy(policy, first, last, result, typename Internal::use_parallel<ExecutionPolicy, ForwardIterator, ForwardOutputIterator>::type());
+	}
+
+
+	/// fill
+	///
+	/// Assigns value to each element of [first, last).
+	///
+	template <typename ExecutionPolicy, typename ForwardIterator, typename T>
+	typename Internal::enable_if_execution_policy<ExecutionPolicy>::type
+	fill(ExecutionPolicy&& policy, ForwardIterator first, ForwardIterator last, const T& value)
+	{
+		Internal::fill_policy(policy, first, last, value, typename Internal::use_parallel<ExecutionPolicy, ForwardIterator>::type());
+	}
+
+
+	/// count_if
+	///
+	/// Returns the number of elements of [first, last) for which predicate returns true.
+	///
+	template <typename ExecutionPolicy, typename ForwardIterator, typename Predicate>
+	typename Internal::enable_if_execution_policy<ExecutionPolicy, typename iterator_traits<ForwardIterator>::difference_type>::type
+	count_if(ExecutionPolicy&& policy, ForwardIterator first, ForwardIterator last, Predicate predicate)
+	{
+		return Internal::count_if_policy(policy, first, last, predicate, typename Internal::use_parallel<ExecutionPolicy, ForwardIterator>::type());
+	}
+
+
+	/// find_if
+	///
+	/// Returns the first element of [first, last) for which predicate returns true, or
+	/// last if there is none. The parallel version may call predicate for elements
+	/// beyond the one it returns.
+	///
+	template <typename ExecutionPolicy, typename ForwardIterator, typename Predicate>
+	typename Internal::enable_if_execution_policy<ExecutionPolicy, ForwardIterator>::type
+	find_if(ExecutionPolicy&& policy, ForwardIterator first, ForwardIterator last, Predicate predicate)
+	{
+		return Internal::find_if_policy(policy, first, last, predicate, typename Internal::use_parallel<ExecutionPolicy, ForwardIterator>::type());
+	}
+
+
+	/// reduce
+	///
+	/// See reduce in numeric.h.
+	///
+	template <typename ExecutionPolicy, typename ForwardIterator, typename T, typename BinaryOperation>
+	typename Internal::enable_if_execution_policy<ExecutionPolicy, T>::type
+	reduce(ExecutionPolicy&& policy, ForwardIterator first, ForwardIterator last, T init, BinaryOperation binary_op)
+	{
+		return Internal::reduce_policy(policy, first, last, init, binary_op, typename Internal::use_parallel<ExecutionPolicy, ForwardIterator>::type());
+	}
+
+	template <typename ExecutionPolicy, typename ForwardIterator, typename T>
+	typename Internal::enable_if_execution_policy<ExecutionPolicy, T>::type
+	reduce(ExecutionPolicy&& policy, ForwardIterator first, ForwardIterator last, T init)
+	{
+		return std::reduce(std::forward<ExecutionPolicy>(policy), first, last, init, std::plus<T>());
+	}
+
+	template <typename ExecutionPolicy, typename ForwardIterator>
+	typename Internal::enable_if_execution_policy<ExecutionPolicy, typename iterator_traits<ForwardIterator>::value_type>::type
+	reduce(ExecutionPolicy&& policy, ForwardIterator first, ForwardIterator last)
+	{
+		typedef typename iterator_traits<ForwardIterator>::value_type value_type;
+		return std::reduce(std::forward<ExecutionPolicy>(policy), first, last, value_type(), std::plus<value_type>());
+	}
+
+
+	/// accumulate
+	///
+	/// The execution policy versions of accumulate are equivalent to reduce, and
+	/// thus require an associative and commutative binary_op.
+	///
+	template <typename ExecutionPolicy, typename ForwardIterator, typename T, typename BinaryOperation>
+	typename Internal::enable_if_execution_policy<ExecutionPolicy, T>::type
+	accumulate(ExecutionPolicy&& policy, ForwardIterator first, ForwardIterator last, T init, BinaryOperation binary_op)
+	{
+		return std::reduce(std::forward<ExecutionPolicy>(policy), first, last, init, binary_op);
+	}
+
+	template <typename ExecutionPolicy, typename ForwardIterator, typename T>
+	typename Internal::enable_if_execution_policy<ExecutionPolicy, T>::type
+	accumulate(ExecutionPolicy&& policy, ForwardIterator first, ForwardIterator last, T init)
+	{
+		return std::reduce(std::forward<ExecutionPolicy>(policy), first, last, init, std::plus<T>());
+	}
+
+
+	/// transform_reduce
+	///
+	/// See transform_reduce in numeric.h.
+	///
+	template <typename ExecutionPolicy, typename ForwardIterator, typename T, typename BinaryOperation, typename UnaryOperation>
+	typename Internal::enable_if_execution_policy<ExecutionPolicy, T>::type
+	transform_reduce(ExecutionPolicy&& policy, ForwardIterator first, ForwardIterator last, T init, BinaryOperation binary_op, UnaryOperation unary_op)
+	{
+		return Internal::transform_reduce_policy(policy, first, last, init, binary_op, unary_op,
+		                                         typename Internal::use_parallel<ExecutionPolicy, ForwardIterator>::type());
+	}
+
+	template <typename ExecutionPolicy, typename ForwardIterator1, typename ForwardIterator2, typename T, typename BinaryOperation, typename BinaryTransformOperation>
+	typename Internal::enable_if_execution_policy<ExecutionPolicy, T>::type
+	transform_reduce(ExecutionPolicy&& policy, ForwardIterator1 first1, ForwardIterator1 last1, ForwardIterator2 first2, T init,
+	                 BinaryOperation binary_op, BinaryTransformOperation binary_transform_op)
+	{
+		return Internal::transform_reduce_policy(policy, first1, last1, first2, init, binary_op, binary_transform_op,
+		                                         typename Internal::use_parallel<ExecutionPolicy, ForwardIterator1, ForwardIterator2>::type());
+	}
+
+	template <typename ExecutionPolicy, typename ForwardIterator1, typename ForwardIterator2, typename T>
+	typename Internal::enable_if_execution_policy<ExecutionPolicy, T>::type
+	transform_reduce(ExecutionPolicy&& policy, ForwardIterator1 first1, ForwardIterator1 last1, ForwardIterator2 first2, T init)
+	{
+		return std::transform_reduce(std::forward<ExecutionPolicy>(policy), first1, last1, first2, init, std::plus<T>(), std::multiplies<T>());
+	}
+
+
+
+	/// sort
+	///
+	/// With execution::par, maps to parallel_sort (see parallel_sort.h). A grain size
+	/// set with with_grain_size replaces EASTL_PARALLEL_SORT_THRESHOLD.
+	///
+	template <typename ExecutionPolicy, typename RandomAccessIterator, typename Compare>
+	typename Internal::enable_if_execution_policy<ExecutionPolicy>::type
+	sort(ExecutionPolicy&& policy, RandomAccessIterator first, RandomAccessIterator last, Compare compare)
+	{
+		Internal::sort_policy(policy, first, last, compare, typename Internal::use_parallel<ExecutionPolicy, RandomAccessIterator>::type());
+	}
+
+	template <typename ExecutionPolicy, typename RandomAccessIterator>
+	typename Internal::enable_if_execution_policy<ExecutionPolicy>::type
+	sort(ExecutionPolicy&& policy, RandomAccessIterator first, RandomAccessIterator last)
+	{
+		std::sort(std::forward<ExecutionPolicy>(policy), first, last, std::less<typename iterator_traits<RandomAccessIterator>::value_type>());
+	}
+
+
+	/// stable_sort
+	///
+	/// With execution::par, maps to parallel_stable_sort (see parallel_sort.h).
+	///
+	template <typename ExecutionPolicy, typename RandomAccessIterator, typename Compare>
+	typename Internal::enable_if_execution_policy<ExecutionPolicy>::type
+	stable_sort(ExecutionPolicy&& policy, RandomAccessIterator first, RandomAccessIterator last, Compare compare)
+	{
+		Internal::stable_sort_policy(policy, first, last, compare, typename Internal::use_parallel<ExecutionPolicy, RandomAccessIterator>::type());
+	}
+
+	template <typename ExecutionPolicy, typename RandomAccessIterator>
+	typename Internal::enable_if_execution_policy<ExecutionPolicy>::type
+	stable_sort(ExecutionPolicy&& policy, RandomAccessIterator first, RandomAccessIterator last)
+	{
+		std::stable_sort(std::forward<ExecutionPolicy>(policy), first, last, std::less<typename iterator_traits<RandomAccessIterator>::value_type>());
+	}
+
+
+} // namespace std
+
+
+#endif // Header include guard
@@ -0,0 +1,313 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements the following
+//     hazard_pointer_obj_base
+//     hazard_pointer
+//     make_hazard_pointer
+//     hazard_pointer_reclaim (extension)
+//
+// This follows the C++26 standard library's <hazard_pointer>.
+//
+// http://en.cppreference.com/w/cpp/header/hazard_pointer
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_HAZARD_POINTER_H
+#define EASTL_HAZARD_POINTER_H
+
+
+#include <EABase/eabase.h>
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once
+#endif
+
+#include <EASTL/internal/config.h>
+#include <EASTL/internal/retired_node.h>
+#include <EASTL/internal/smart_ptr.h>
+#include <EASTL/atomic.h>
+#include <EASTL/utility.h>
+
+
+///////////////////////////////////////////////////////////////////////////////
+// EASTL_HAZARD_POINTER_RETIRE_THRESHOLD
+//
+// The least number of objects which a thread accumulates in its retire list
+// before scanning the hazard pointers and reclaiming the unprotected ones.
+// A thread scans once it has retired twice as many objects as there are hazard
+// pointers, or this many if more, so that each scan reclaims at least half of
+// its list and the objects awaiting reclamation are bounded.
+//
+#ifndef EASTL_HAZARD_POINTER_RETIRE_THRESHOLD
+	#define EASTL_HAZARD_POINTER_RETIRE_THRESHOLD 64
+#endif
+
+
+///////////////////////////////////////////////////////////////////////////////
+// EASTL_HAZARD_POINTER_CACHE_SIZE
+//
+// The number of hazard pointer records each thread keeps for reuse after its
+// hazard_pointers are destroyed, so that make_hazard_pointer in a loop doesn't
+// search the shared list of records.
+//
+#ifndef EASTL_HAZARD_POINTER_CACHE_SIZE
+	#define EASTL_HAZARD_POINTER_CACHE_SIZE 4
+#endif
+
+
+
+namespace std
+{
+
+	namespace Internal
+	{
+		/// hazard_pointer_record
+		///
+		/// Holds the pointer which one hazard_pointer protects. Records are linked
+		/// into a list which only grows, and are reused once released, so that a
+		/// thread scanning them never reads freed memory.
+		///
+		struct hazard_pointer_record
+		{
+			atomic<const void*>    mpProtected;
+			atomic<uint32_t>       mnInUse;
+			hazard_pointer_record* mpNext;
+		};
+
+		EASTL_API hazard_pointer_record* hazard_pointer_acquire_record();
+		EASTL_API void hazard_pointer_release_record(hazard_pointer_record* pRecord) EA_NOEXCEPT;
+		EASTL_API void hazard_pointer_retire(retired_node* pNode) EA_NOEXCEPT;
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////////
+	// hazard_pointer_obj_base
+	///////////////////////////////////////////////////////////////////////////
+
+	/// hazard_pointer_obj_base
+	///
+	/// The base of objects which can be protected by hazard pointers. T must
+	/// derive from hazard_pointer_obj_base<T, D> publicly. Once an object has
+	/// been unlinked from the structure which readers find it through, calling
+	/// retire hands it over to be deleted with D once no hazard pointer which
+	/// was protecting it before then still protects it.
+	///
+	/// The object holds the record which is needed until then, so retiring it
+	/// doesn't allocate memory. With D = allocator_delete<T, Allocator> the object
+	/// is returned to its allocator, e.g. the node pool of a container.
+	///
+	template <typename T, typename D = default_delete<T> >
+	class hazard_pointer_obj_base : public Internal::retired_object_base<T, D>
+	{
+	public:
+		/// retire
+		///
+		/// Retires the object, which must not be retired more than once. It may be
+		/// deleted by this or any later call to retire or hazard_pointer_reclaim,
+		/// on this or another thread.
+		///
+		void retire(D d = D()) EA_NOEXCEPT
+		{
+			Internal::hazard_pointer_retire(this->PrepareRetire(std::move(d)));
+		}
+
+	protected:
+		hazard_pointer_obj_base() = default;
+		hazard_pointer_obj_base(const hazard_pointer_obj_base&) = default;
+		hazard_pointer_obj_base(hazard_pointer_obj_base&&) = default;
+		hazard_pointer_obj_base& operator=(const hazard_pointer_obj_base&) = default;
+		hazard_pointer_obj_base& operator=(hazard_pointer_obj_base&&) = default;
+		~hazard_pointer_obj_base() = default;
+	};
+
+
+
+	///////////////////////////////////////////////////////////////////////////
+	// hazard_pointer
+	///////////////////////////////////////////////////////////////////////////
+
+	/// hazard_pointer
+	///
+	/// Protects one object at a time from being deleted after it has been
+	/// retired, so that a thread which read a pointer from a shared atomic can
+	/// safely access the object while another thread unlinks and retires it
+	/// (M. M. Michael, "Hazard Pointers: Safe Memory Reclamation for Lock-Free
+	/// Objects"). This makes lock-free structures whose nodes are freed, such as
+	/// queues and maps, possible without a mutex or a garbage collector.
+	///
+	/// A hazard_pointer owns a record in a shared list. protect publishes the
+	/// pointer in the record and then checks that the atomic still holds it,
+	/// so that a retiring thread which scans the records afterwards is bound to
+	/// see it. Protecting costs a store and a load, each sequentially consistent,
+	/// and nothing is written to memory shared with other readers.
+	///
+	/// Retired objects go to a list of the retiring thread, which is scanned for
+	/// reclamation in batches (see EASTL_HAZARD_POINTER_RETIRE_THRESHOLD). The
+	/// objects awaiting reclamation are therefore bounded by the number of
+	/// threads and hazard pointers, however long any reader takes. A thread's
+	/// remaining objects are handed over to other threads when it exits.
+	///
+	/// Example usage:
+	///    struct Config : public hazard_pointer_obj_base<Config> { ... };
+	///    atomic<Config*> gpConfig;
+	///
+	///    hazard_pointer hp = make_hazard_pointer();   // A reader.
+	///    Config* pConfig = hp.protect(gpConfig);
+	///    Use(*pConfig);
+	///
+	///    gpConfig.exchange(pNewConfig)->retire();     // A writer.
+	///
+	class hazard_pointer
+	{
+	public:
+		/// Constructs an empty hazard_pointer, which can't protect anything.
+		/// Use make_hazard_pointer to create one which can.
+		hazard_pointer() EA_NOEXCEPT
+			: mpRecord(NULL) { }
+
+		hazard_pointer(hazard_pointer&& x) EA_NOEXCEPT
+			: mpRecord(x.mpRecord)
+		{
+			x.mpRecord = NULL;
+		}
+
+		hazard_pointer& operator=(hazard_pointer&& x) EA_NOEXCEPT
+		{
+			if(this != &x)
+			{
+				if(mpRecord)
+					Internal::hazard_pointer_release_record(mpRecord);
+
+				mpRecord   = x.mpRecord;
+				x.mpRecord = NULL;
+			}
+			return *this;
+		}
+
+		~hazard_pointer()
+		{
+			if(mpRecord)
+				Internal::hazard_pointer_release_record(mpRecord);
+		}
+
+		hazard_pointer(const hazard_pointer&) = delete;
+		hazard_pointer& operator=(const hazard_pointer&) = delete;
+
+		bool empty() const EA_NOEXCEPT
+			{ return mpRecord == NULL; }
+
+		/// protect
+		///
+		/// Loads the pointer in src and protects the object it points to until
+		/// the protection is reset or moved to another object. The returned
+		/// pointer may be NULL.
+		///
+		template <typename T>
+		T* protect(const atomic<T*>& src) EA_NOEXCEPT
+		{
+			T* p = src.load(memory_order_relaxed);
+
+			while(!try_protect(p, src))
+				{ }
+
+			return p;
+		}
+
+		/// try_protect
+		///
+		/// Protects ptr, a value previously loaded from src, and returns true if src
+		/// still holds it. Otherwise resets the protection, sets ptr to the value in
+		/// src and returns false.
+		///
+		template <typename T>
+		bool try_protect(T*& ptr, const atomic<T*>& src) EA_NOEXCEPT
+		{
+			EASTL_ASSERT(mpRecord);
+
+			T* const pOld = ptr;
+
+			// The store must precede the load in the single total order of
+			// sequentially consistent operations; the retiring thread's scan follows
+			// its unlink with a sequentially consistent fence, so either we load the
+			// new value or it sees our pointer.
+			mpRecord->mpProtected.store(static_cast<const void*>(pOld), memory_order_seq_cst);
+			ptr = src.load(memory_order_seq_cst);
+
+			if(ptr != pOld)
+			{
+				mpRecord->mpProtected.store(NULL, memory_order_release);
+				return false;
+			}
+
+			return true;
+		}
+
+		/// reset_protection
+		///
+		/// Protects p, which the caller must know to not have been retired, or
+		/// stops protecting anything if p is NULL.
+		///
+		template <typename T>
+		void reset_protection(const T* p) EA_NOEXCEPT
+		{
+			EASTL_ASSERT(mpRecord);
+			mpRecord->mpProtected.store(static_cast<const void*>(p), memory_order_seq_cst);
+		}
+
+		void reset_protection(std::nullptr_t = nullptr) EA_NOEXCEPT
+		{
+			EASTL_ASSERT(mpRecord);
+			mpRecord->mpProtected.store(NULL, memory_order_release);
+		}
+
+		void swap(hazard_pointer& x) EA_NOEXCEPT
+		{
+			Internal::hazard_pointer_record* const pRecord = mpRecord;
+			mpRecord   = x.mpRecord;
+			x.mpRecord = pRecord;
+		}
+
+	protected:
+		friend hazard_pointer make_hazard_pointer();
+
+		explicit hazard_pointer(Internal::hazard_pointer_record* pRecord) EA_NOEXCEPT
+			: mpRecord(pRecord) { }
+
+		Internal::hazard_pointer_record* mpRecord;
+	};
+
+
+	/// make_hazard_pointer
+	///
+	/// Returns a hazard_pointer which isn't empty and protects nothing. Reuses a
+	/// record of a destroyed hazard_pointer where possible, which the calling
+	/// thread keeps a few of; allocates a new one otherwise.
+	///
+	inline hazard_pointer make_hazard_pointer()
+	{
+		return hazard_pointer(Internal::hazard_pointer_acquire_record());
+	}
+
+
+	inline void swap(hazard_pointer& a, hazard_pointer& b) EA_NOEXCEPT
+	{
+		a.swap(b);
+	}
+
+
+	/// hazard_pointer_reclaim
+	///
+	/// Scans the hazard pointers now rather than waiting for the retire list to
+	/// fill, and reclaims the objects retired by this thread, or by threads which
+	/// have exited, which no hazard pointer protects. Useful before tearing down
+	/// an allocator which retired objects are to be returned to.
+	///
+	EASTL_API void hazard_pointer_reclaim() EA_NOEXCEPT;
+
+} // namespace std
+
+
+#endif // Header include guard
@@ -29,6 +29,8 @@
 
 #include "atomic_pointer.h"
 
+#include "atomic_wait.h"
+
 
 /////////////////////////////////////////////////////////////////////////////////
 
@@ -168,6 +170,29 @@ namespace internal
 		operator type() const EA_NOEXCEPT			\
 		{											\
 			return load(std::memory_order_seq_cst); \
+		}											\
+													\
+	public: /* wait / notify */						\
+													\
+		template <typename Order>					\
+		void wait(type old, Order order) const EA_NOEXCEPT \
+		{											\
+			std::internal::atomic_wait(*this, this->GetAtomicAddress(), old, order); \
+		}											\
+													\
+		void wait(type old) const EA_NOEXCEPT		\
+		{											\
+			std::internal::atomic_wait(*this, this->GetAtomicAddress(), old, std::memory_order_seq_cst); \
+		}											\
+													\
+		void notify_one() EA_NOEXCEPT				\
+		{											\
+			std::internal::atomic_notify_slow(this->GetAtomicAddress(), sizeof(type), false); \
+		}											\
+													\
+		void notify_all() EA_NOEXCEPT				\
+		{											\
+			std::internal::atomic_notify_slow(this->GetAtomicAddress(), sizeof(type), true); \
 		}
 
 
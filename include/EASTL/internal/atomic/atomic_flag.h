@@ -155,6 +155,31 @@ public: /* test */
 		return mFlag.load(std::memory_order_seq_cst);
 	}
 
+public: /* wait */
+
+	template <typename Order>
+	void wait(bool old, Order order) const EA_NOEXCEPT
+	{
+		mFlag.wait(old, order);
+	}
+
+	void wait(bool old) const EA_NOEXCEPT
+	{
+		mFlag.wait(old, std::memory_order_seq_cst);
+	}
+
+public: /* notify */
+
+	void notify_one() EA_NOEXCEPT
+	{
+		mFlag.notify_one();
+	}
+
+	void notify_all() EA_NOEXCEPT
+	{
+		mFlag.notify_all();
+	}
+
 private:
 
 	std::atomic<bool> mFlag;
@@ -63,6 +63,42 @@ EASTL_FORCE_INLINE bool atomic_flag_test_explicit(std::atomic_flag* atomicObj, O
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+//
+// void atomic_flag_wait(const std::atomic_flag*, bool)
+//
+EASTL_FORCE_INLINE void atomic_flag_wait(const std::atomic_flag* atomicObj, bool old)
+{
+	atomicObj->wait(old);
+}
+
+template <typename Order>
+EASTL_FORCE_INLINE void atomic_flag_wait_explicit(const std::atomic_flag* atomicObj, bool old, Order order)
+{
+	atomicObj->wait(old, order);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// void atomic_flag_notify_one(std::atomic_flag*)
+//
+EASTL_FORCE_INLINE void atomic_flag_notify_one(std::atomic_flag* atomicObj)
+{
+	atomicObj->notify_one();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// void atomic_flag_notify_all(std::atomic_flag*)
+//
+EASTL_FORCE_INLINE void atomic_flag_notify_all(std::atomic_flag* atomicObj)
+{
+	atomicObj->notify_all();
+}
+
+
 } // namespace std
 
 
@@ -302,6 +302,45 @@ EASTL_FORCE_INLINE typename std::atomic<T>::value_type atomic_load_explicit(cons
 }
 
 
+/////////////////////////////////////////////////////////////////////////////////
+//
+// void atomic_wait(const std::atomic<T>*, T)
+//
+template <typename T>
+EASTL_FORCE_INLINE void atomic_wait(const std::atomic<T>* atomicObj, typename std::atomic<T>::value_type old) EA_NOEXCEPT
+{
+	atomicObj->wait(old);
+}
+
+template <typename T, typename Order>
+EASTL_FORCE_INLINE void atomic_wait_explicit(const std::atomic<T>* atomicObj, typename std::atomic<T>::value_type old, Order order) EA_NOEXCEPT
+{
+	atomicObj->wait(old, order);
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////
+//
+// void atomic_notify_one(std::atomic<T>*)
+//
+template <typename T>
+EASTL_FORCE_INLINE void atomic_notify_one(std::atomic<T>* atomicObj) EA_NOEXCEPT
+{
+	atomicObj->notify_one();
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////
+//
+// void atomic_notify_all(std::atomic<T>*)
+//
+template <typename T>
+EASTL_FORCE_INLINE void atomic_notify_all(std::atomic<T>* atomicObj) EA_NOEXCEPT
+{
+	atomicObj->notify_all();
+}
+
+
 /////////////////////////////////////////////////////////////////////////////////
 //
 // T atomic_load_cond(const std::atomic<T>*)
@@ -0,0 +1,125 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_ATOMIC_INTERNAL_WAIT_H
+#define EASTL_ATOMIC_INTERNAL_WAIT_H
+
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once
+#endif
+
+
+#include "atomic_push_compiler_options.h"
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// EASTL_ATOMIC_WAIT_SPIN_COUNT
+//
+// The number of times atomic<T>::wait and atomic_flag::wait reload the value,
+// with a cpu_pause in between, before they ask the OS to suspend the thread.
+// Most waits in practice are short, and a spin which sees the change avoids
+// the cost of a system call on both the waiting and the notifying side.
+//
+#ifndef EASTL_ATOMIC_WAIT_SPIN_COUNT
+	#define EASTL_ATOMIC_WAIT_SPIN_COUNT 128
+#endif
+
+
+namespace std
+{
+
+
+namespace internal
+{
+
+
+	/**
+	 * Returns true if the value representations of the two objects differ, which
+	 * is the comparison that the C++20 wait functions make.
+	 */
+	template <typename T>
+	EASTL_FORCE_INLINE bool atomic_wait_value_changed(const T& value, const T& old) EA_NOEXCEPT
+	{
+		const unsigned char* const pValue = reinterpret_cast<const unsigned char*>(std::addressof(value));
+		const unsigned char* const pOld   = reinterpret_cast<const unsigned char*>(std::addressof(old));
+
+		for (size_t i = 0; i < sizeof(T); ++i)
+		{
+			if (pValue[i] != pOld[i])
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+
+	/**
+	 * Called by atomic_wait_slow, with the atomic object and the old value given to it,
+	 * to reload the value and check whether it changed.
+	 */
+	typedef bool (*AtomicWaitChangedFunc)(const void* pAtomicObj, const void* pOld);
+
+
+	/**
+	 * Suspends the calling thread until pfnChanged returns true, rechecking it upon being
+	 * woken by atomic_notify_slow for pAddress. Implemented in source/atomic.cpp with a
+	 * futex on Linux, WaitOnAddress on Windows, and by yielding the thread elsewhere.
+	 */
+	EASTL_API void atomic_wait_slow(const void* pAddress, size_t size, AtomicWaitChangedFunc pfnChanged,
+									const void* pAtomicObj, const void* pOld) EA_NOEXCEPT;
+
+
+	/**
+	 * Wakes one or all threads in atomic_wait_slow for pAddress. Doesn't make a system
+	 * call unless a thread may be waiting on an address which hashes like pAddress.
+	 */
+	EASTL_API void atomic_notify_slow(const void* pAddress, size_t size, bool bAll) EA_NOEXCEPT;
+
+
+	template <typename AtomicType, typename T, typename Order>
+	struct atomic_wait_changed
+	{
+		static bool Changed(const void* pAtomicObj, const void* pOld)
+		{
+			return atomic_wait_value_changed(static_cast<const AtomicType*>(pAtomicObj)->load(Order()), *static_cast<const T*>(pOld));
+		}
+	};
+
+
+	/**
+	 * Implements atomic<T>::wait. Returns once the value loaded from atomicObj with the
+	 * given order differs from old, which may be later than the change if the value
+	 * was changed back in between (the ABA problem), as the standard allows.
+	 */
+	template <typename AtomicType, typename T, typename Order>
+	void atomic_wait(const AtomicType& atomicObj, const void* pAddress, T old, Order order) EA_NOEXCEPT
+	{
+		for (int i = 0; i < EASTL_ATOMIC_WAIT_SPIN_COUNT; ++i)
+		{
+			if (atomic_wait_value_changed(atomicObj.load(order), old))
+			{
+				return;
+			}
+
+			EASTL_ATOMIC_CPU_PAUSE();
+		}
+
+		atomic_wait_slow(pAddress, sizeof(T), &atomic_wait_changed<AtomicType, T, Order>::Changed,
+						 std::addressof(atomicObj), std::addressof(old));
+	}
+
+
+} // namespace internal
+
+
+} // namespace std
+
+
+#include "atomic_pop_compiler_options.h"
+
+
+#endif /* EASTL_ATOMIC_INTERNAL_WAIT_H */
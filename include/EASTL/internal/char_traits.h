@@ -19,6 +19,7 @@
 #endif
 
 #include <EASTL/internal/config.h>
+#include <EASTL/internal/simd.h>
 #include <EASTL/type_traits.h>
 
 EA_DISABLE_ALL_VC_WARNINGS()
@@ -219,6 +220,16 @@ namespace std
 	template <typename T>
 	int Compare(const T* p1, const T* p2, size_t n)
 	{
+		#if EASTL_SIMD_ENABLED
+			if(is_integral<T>::value && (n >= EASTL_SIMD_MIN_STRING_LENGTH)) // Skip the common prefix of long wide strings a vector at a time.
+			{
+				const size_t i = Internal::simd_mismatch(p1, p2, n * sizeof(T)) / sizeof(T);
+				p1 += i;
+				p2 += i;
+				n  -= i;
+			}
+		#endif
+
 		for(; n > 0; ++p1, ++p2, --n)
 		{
 			if(*p1 != *p2)
@@ -286,6 +297,58 @@ namespace std
 	}
 
 
+	template <typename T>
+	const T* CharTypeStringSearch(const T* p1Begin, const T* p1End, 
+								  const T* p2Begin, const T* p2End)
+	{
+		// Test for zero length strings, in which case we have a match or a failure, 
+		// but the return value is the same either way.
+		if((p1Begin == p1End) || (p2Begin == p2End))
+			return p1Begin;
+
+		// Test for a pattern of length 1.
+		if((p2Begin + 1) == p2End)
+		{
+			for(; p1Begin != p1End; ++p1Begin)
+			{
+				if(*p1Begin == *p2Begin)
+					return p1Begin;
+			}
+			return p1End;
+		}
+
+		// General case.
+		const T* pTemp;
+		const T* pTemp1 = (p2Begin + 1);
+		const T* pCurrent = p1Begin;
+
+		while(p1Begin != p1End)
+		{
+			while((p1Begin != p1End) && !(*p1Begin == *p2Begin))
+				++p1Begin;
+			if(p1Begin == p1End)
+				return p1End;
+
+			pTemp = pTemp1;
+			pCurrent = p1Begin;
+			if(++pCurrent == p1End)
+				return p1End;
+
+			while(*pCurrent == *pTemp)
+			{
+				if(++pTemp == p2End)
+					return p1Begin;
+				if(++pCurrent == p1End)
+					return p1End;
+			}
+
+			++p1Begin;
+		}
+
+		return p1Begin;
+	}
+
+
 	template <typename T>
 	const T* CharTypeStringFindEnd(const T* pBegin, const T* pEnd, T c)
 	{
@@ -425,6 +488,98 @@ namespace std
 	}
 
 
+	// char versions of the string search functions above, which hand long strings to
+	// the SIMD kernels (see internal/simd.h). They are found by overload resolution
+	// when the functions above are called with char arguments.
+	#if EASTL_SIMD_ENABLED
+		inline const char* CharTypeStringSearch(const char* p1Begin, const char* p1End, const char* p2Begin, const char* p2End)
+		{
+			if(((p1End - p1Begin) >= EASTL_SIMD_MIN_STRING_LENGTH) && ((p2End - p2Begin) >= 2))
+			{
+				const char* const pResult = Internal::simd_string_search(p1Begin, p1End, p2Begin, p2End);
+				return pResult ? pResult : p1End;
+			}
+			if((p2End - p2Begin) == 1)
+			{
+				const char* const pResult = Find(p1Begin, *p2Begin, (size_t)(p1End - p1Begin));
+				return pResult ? pResult : p1End;
+			}
+			return CharTypeStringSearch<char>(p1Begin, p1End, p2Begin, p2End);
+		}
+
+		inline const char* CharTypeStringFindEnd(const char* pBegin, const char* pEnd, char c)
+		{
+			if((pEnd - pBegin) >= EASTL_SIMD_MIN_STRING_LENGTH)
+			{
+				const char* const pResult = Internal::simd_string_find_last(pBegin, pEnd, c);
+				return pResult ? pResult : pEnd;
+			}
+			return CharTypeStringFindEnd<char>(pBegin, pEnd, c);
+		}
+
+		inline const char* CharTypeStringRSearch(const char* p1Begin, const char* p1End, const char* p2Begin, const char* p2End)
+		{
+			if(((p1End - p1Begin) >= EASTL_SIMD_MIN_STRING_LENGTH) && ((p2End - p2Begin) >= 2))
+			{
+				const char* const pResult = Internal::simd_string_rsearch(p1Begin, p1End, p2Begin, p2End);
+				return pResult ? pResult : p1End;
+			}
+			return CharTypeStringRSearch<char>(p1Begin, p1End, p2Begin, p2End);
+		}
+
+		inline const char* CharTypeStringFindFirstOf(const char* p1Begin, const char* p1End, const char* p2Begin, const char* p2End)
+		{
+			if((p1End - p1Begin) >= EASTL_SIMD_MIN_STRING_LENGTH)
+			{
+				const char* const pResult = Internal::simd_string_find_first_of(p1Begin, p1End, p2Begin, p2End, true);
+				return pResult ? pResult : p1End;
+			}
+			return CharTypeStringFindFirstOf<char>(p1Begin, p1End, p2Begin, p2End);
+		}
+
+		inline const char* CharTypeStringFindFirstNotOf(const char* p1Begin, const char* p1End, const char* p2Begin, const char* p2End)
+		{
+			if((p1End - p1Begin) >= EASTL_SIMD_MIN_STRING_LENGTH)
+			{
+				const char* const pResult = Internal::simd_string_find_first_of(p1Begin, p1End, p2Begin, p2End, false);
+				return pResult ? pResult : p1End;
+			}
+			return CharTypeStringFindFirstNotOf<char>(p1Begin, p1End, p2Begin, p2End);
+		}
+
+		// The reverse functions take and return the end of the range and of what was found.
+		inline const char* CharTypeStringRFind(const char* pRBegin, const char* pREnd, const char c)
+		{
+			if((pRBegin - pREnd) >= EASTL_SIMD_MIN_STRING_LENGTH)
+			{
+				const char* const pResult = Internal::simd_string_find_last(pREnd, pRBegin, c);
+				return pResult ? (pResult + 1) : pREnd;
+			}
+			return CharTypeStringRFind<char>(pRBegin, pREnd, c);
+		}
+
+		inline const char* CharTypeStringRFindFirstOf(const char* p1RBegin, const char* p1REnd, const char* p2Begin, const char* p2End)
+		{
+			if((p1RBegin - p1REnd) >= EASTL_SIMD_MIN_STRING_LENGTH)
+			{
+				const char* const pResult = Internal::simd_string_find_last_of(p1REnd, p1RBegin, p2Begin, p2End, true);
+				return pResult ? (pResult + 1) : p1REnd;
+			}
+			return CharTypeStringRFindFirstOf<char>(p1RBegin, p1REnd, p2Begin, p2End);
+		}
+
+		inline const char* CharTypeStringRFindFirstNotOf(const char* p1RBegin, const char* p1REnd, const char* p2Begin, const char* p2End)
+		{
+			if((p1RBegin - p1REnd) >= EASTL_SIMD_MIN_STRING_LENGTH)
+			{
+				const char* const pResult = Internal::simd_string_find_last_of(p1REnd, p1RBegin, p2Begin, p2End, false);
+				return pResult ? (pResult + 1) : p1REnd;
+			}
+			return CharTypeStringRFindFirstNotOf<char>(p1RBegin, p1REnd, p2Begin, p2End);
+		}
+	#endif
+
+
 	inline char* CharStringUninitializedFillN(char* pDestination, size_t n, const char c)
 	{
 		if(n) // Some compilers (e.g. GCC 4.3+) generate a warning (which can't be disabled) if you call memset with a size of 0.
@@ -601,13 +601,16 @@ namespace std
 	///     nodeAlignmentOffset    The alignment offset of the objects to allocate.
 	///     bEnableOverflow        Whether or not we should use the overflow heap if our object pool is exhausted.
 	///     OverflowAllocator      Overflow allocator, which is only used if bEnableOverflow == true. Defaults to the global heap.
+	///     PoolType               The pool implementation. Defaults to fixed_pool_with_overflow or fixed_pool, depending on bEnableOverflow.
+	///                            concurrent_fixed_pool (EASTL/concurrent_fixed_pool.h) may be used when bEnableOverflow == false.
 	///
-	template <size_t nodeSize, size_t nodeCount, size_t nodeAlignment, size_t nodeAlignmentOffset, bool bEnableOverflow, typename OverflowAllocator = EASTLAllocatorType>
+	template <size_t nodeSize, size_t nodeCount, size_t nodeAlignment, size_t nodeAlignmentOffset, bool bEnableOverflow, typename OverflowAllocator = EASTLAllocatorType,
+			  typename PoolType = typename type_select<bEnableOverflow, fixed_pool_with_overflow<OverflowAllocator>, fixed_pool>::type>
 	class fixed_node_allocator
 	{
 	public:
-		typedef typename type_select<bEnableOverflow, fixed_pool_with_overflow<OverflowAllocator>, fixed_pool>::type  pool_type;
-		typedef fixed_node_allocator<nodeSize, nodeCount, nodeAlignment, nodeAlignmentOffset, bEnableOverflow, OverflowAllocator>   this_type;
+		typedef PoolType pool_type;
+		typedef fixed_node_allocator<nodeSize, nodeCount, nodeAlignment, nodeAlignmentOffset, bEnableOverflow, OverflowAllocator, PoolType>   this_type;
 		typedef OverflowAllocator overflow_allocator_type;
 
 		enum
@@ -751,14 +754,14 @@ namespace std
 
 
 	// This is a near copy of the code above, with the only difference being 
-	// the 'false' bEnableOverflow template parameter, the pool_type and this_type typedefs, 
+	// the 'false' bEnableOverflow template parameter, the this_type typedef, 
 	// and the get_overflow_allocator / set_overflow_allocator functions.
-	template <size_t nodeSize, size_t nodeCount, size_t nodeAlignment, size_t nodeAlignmentOffset, typename OverflowAllocator>
-	class fixed_node_allocator<nodeSize, nodeCount, nodeAlignment, nodeAlignmentOffset, false, OverflowAllocator>
+	template <size_t nodeSize, size_t nodeCount, size_t nodeAlignment, size_t nodeAlignmentOffset, typename OverflowAllocator, typename PoolType>
+	class fixed_node_allocator<nodeSize, nodeCount, nodeAlignment, nodeAlignmentOffset, false, OverflowAllocator, PoolType>
 	{
 	public:
-		typedef fixed_pool pool_type;
-		typedef fixed_node_allocator<nodeSize, nodeCount, nodeAlignment, nodeAlignmentOffset, false, OverflowAllocator>   this_type;
+		typedef PoolType pool_type;
+		typedef fixed_node_allocator<nodeSize, nodeCount, nodeAlignment, nodeAlignmentOffset, false, OverflowAllocator, PoolType>   this_type;
 		typedef OverflowAllocator overflow_allocator_type;
 
 		enum
@@ -897,17 +900,17 @@ namespace std
 	// global operators
 	///////////////////////////////////////////////////////////////////////
 
-	template <size_t nodeSize, size_t nodeCount, size_t nodeAlignment, size_t nodeAlignmentOffset, bool bEnableOverflow, typename OverflowAllocator>
-	inline bool operator==(const fixed_node_allocator<nodeSize, nodeCount, nodeAlignment, nodeAlignmentOffset, bEnableOverflow, OverflowAllocator>& a, 
-						   const fixed_node_allocator<nodeSize, nodeCount, nodeAlignment, nodeAlignmentOffset, bEnableOverflow, OverflowAllocator>& b)
+	template <size_t nodeSize, size_t nodeCount, size_t nodeAlignment, size_t nodeAlignmentOffset, bool bEnableOverflow, typename OverflowAllocator, typename PoolType>
+	inline bool operator==(const fixed_node_allocator<nodeSize, nodeCount, nodeAlignment, nodeAlignmentOffset, bEnableOverflow, OverflowAllocator, PoolType>& a, 
+						   const fixed_node_allocator<nodeSize, nodeCount, nodeAlignment, nodeAlignmentOffset, bEnableOverflow, OverflowAllocator, PoolType>& b)
 	{
 		return (&a == &b); // They are only equal if they are the same object.
 	}
 
 
-	template <size_t nodeSize, size_t nodeCount, size_t nodeAlignment, size_t nodeAlignmentOffset, bool bEnableOverflow, typename OverflowAllocator>
-	inline bool operator!=(const fixed_node_allocator<nodeSize, nodeCount, nodeAlignment, nodeAlignmentOffset, bEnableOverflow, OverflowAllocator>& a, 
-						   const fixed_node_allocator<nodeSize, nodeCount, nodeAlignment, nodeAlignmentOffset, bEnableOverflow, OverflowAllocator>& b)
+	template <size_t nodeSize, size_t nodeCount, size_t nodeAlignment, size_t nodeAlignmentOffset, bool bEnableOverflow, typename OverflowAllocator, typename PoolType>
+	inline bool operator!=(const fixed_node_allocator<nodeSize, nodeCount, nodeAlignment, nodeAlignmentOffset, bEnableOverflow, OverflowAllocator, PoolType>& a, 
+						   const fixed_node_allocator<nodeSize, nodeCount, nodeAlignment, nodeAlignmentOffset, bEnableOverflow, OverflowAllocator, PoolType>& b)
 	{
 		return (&a != &b); // They are only equal if they are the same object.
 	}
@@ -0,0 +1,97 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements the record which hazard pointers and rcu keep for each
+// retired object until it is safe to reclaim, and the base class through
+// which objects carry that record themselves.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_INTERNAL_RETIRED_NODE_H
+#define EASTL_INTERNAL_RETIRED_NODE_H
+
+
+#include <EABase/eabase.h>
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once
+#endif
+
+#include <EASTL/internal/config.h>
+#include <EASTL/type_traits.h>
+#include <EASTL/utility.h>
+#include <new>
+#include <stddef.h>
+
+
+
+namespace std
+{
+	namespace Internal
+	{
+		/// retired_node
+		///
+		/// Links a retired object into the list of objects awaiting reclamation.
+		/// mpReclaim destroys the object and frees its memory, including the memory
+		/// of the node if it isn't part of the object.
+		///
+		struct retired_node
+		{
+			retired_node* mpNext;
+			void (*mpReclaim)(retired_node* pNode);
+			const void*   mpObject;  // The address of the retired object, which readers protect.
+		};
+
+
+		/// retired_object_base
+		///
+		/// The base of hazard_pointer_obj_base and rcu_obj_base, through which an
+		/// object of type T, which derives from it, holds its own retired_node and
+		/// the deleter which it is retired with. Retiring the object thus requires
+		/// no memory allocation.
+		///
+		template <typename T, typename D>
+		class retired_object_base
+		{
+		protected:
+			retired_object_base() EA_NOEXCEPT { }
+			retired_object_base(const retired_object_base&) EA_NOEXCEPT { }     // The node belongs to this object rather than its value,
+			retired_object_base(retired_object_base&&) EA_NOEXCEPT { }          // so neither copies nor moves.
+			retired_object_base& operator=(const retired_object_base&) EA_NOEXCEPT { return *this; }
+			retired_object_base& operator=(retired_object_base&&) EA_NOEXCEPT { return *this; }
+			~retired_object_base() = default;
+
+			/// Stores the deleter and returns the node to hand over for reclamation.
+			retired_node* PrepareRetire(D&& deleter)
+			{
+				::new(&mRetiredDeleter) D(std::move(deleter));
+
+				mRetiredNode.mpNext    = NULL;
+				mRetiredNode.mpReclaim = &Reclaim;
+				mRetiredNode.mpObject  = static_cast<const T*>(this);
+
+				return &mRetiredNode;
+			}
+
+			static void Reclaim(retired_node* pNode)
+			{
+				retired_object_base* const pThis = reinterpret_cast<retired_object_base*>(reinterpret_cast<char*>(pNode) - offsetof(retired_object_base, mRetiredNode));
+				D* const pDeleter = reinterpret_cast<D*>(&pThis->mRetiredDeleter);
+				D deleter(std::move(*pDeleter));
+
+				pDeleter->~D();
+				deleter(static_cast<T*>(pThis));
+			}
+
+		protected:
+			retired_node mRetiredNode;
+			typename aligned_storage<sizeof(D), EASTL_ALIGN_OF(D)>::type mRetiredDeleter; // Constructed by PrepareRetire, so D needn't be default-constructible.
+		};
+
+	} // namespace Internal
+
+} // namespace std
+
+
+#endif // Header include guard
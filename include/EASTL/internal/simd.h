@@ -0,0 +1,170 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file declares the SIMD kernels which EASTL compiles into its library
+// (see source/simd.cpp), and which the headers call for long enough ranges.
+// Each kernel is compiled for SSE2, which every x64 CPU has, and for AVX2,
+// and the version to run is picked when it is called, from the features of
+// the CPU it runs on. No compiler options are needed to build them.
+//
+// The kernels are only declared if EASTL_SIMD_ENABLED is 1; otherwise
+// the headers use their scalar code.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_INTERNAL_SIMD_H
+#define EASTL_INTERNAL_SIMD_H
+
+
+#include <EABase/eabase.h>
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once
+#endif
+
+#include <EASTL/internal/config.h>
+#include <stddef.h>
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// EASTL_SIMD_ENABLED
+//
+// Defined as 0 or 1. Identifies if the SIMD kernels are compiled into the
+// library and used by the headers. The default is 1 for x86 and x64 targets
+// with SSE2, and can be set to 0 to build EASTL with scalar code only.
+//
+#ifndef EASTL_SIMD_ENABLED
+	#if (defined(EA_PROCESSOR_X86) || defined(EA_PROCESSOR_X86_64)) && EA_SSE2 && (defined(EA_COMPILER_MSVC) || defined(EA_COMPILER_GNUC) || defined(EA_COMPILER_CLANG))
+		#define EASTL_SIMD_ENABLED 1
+	#else
+		#define EASTL_SIMD_ENABLED 0
+	#endif
+#endif
+
+
+///////////////////////////////////////////////////////////////////////////////
+// EASTL_SIMD_MIN_STRING_LENGTH
+//
+// The length below which the char string search functions (see char_traits.h)
+// don't call the SIMD kernels, as a call isn't worth it for short strings.
+//
+#ifndef EASTL_SIMD_MIN_STRING_LENGTH
+	#define EASTL_SIMD_MIN_STRING_LENGTH 32
+#endif
+
+
+///////////////////////////////////////////////////////////////////////////////
+// EASTL_SIMD_MIN_RANGE_SIZE
+//
+// The number of elements below which the algorithms (see algorithm.h) don't
+// call the SIMD kernels for ranges of arithmetic types.
+//
+#ifndef EASTL_SIMD_MIN_RANGE_SIZE
+	#define EASTL_SIMD_MIN_RANGE_SIZE 32
+#endif
+
+
+
+#if EASTL_SIMD_ENABLED
+
+namespace std
+{
+	namespace Internal
+	{
+		enum simd_feature
+		{
+			kSimdFeatureSSE2 = 0x01,
+			kSimdFeatureAVX2 = 0x02  // Also requires the OS to save the AVX registers.
+		};
+
+		/// simd_features
+		///
+		/// Returns the simd_feature flags of the CPU, which determine the kernels run.
+		///
+		EASTL_API int simd_features();
+
+		/// simd_set_features
+		///
+		/// Limits the kernels run to those which use the given features (and which the CPU
+		/// supports), and returns the previous features. This is for testing and benchmarking
+		/// the kernels for each instruction set; it must not be called while others run.
+		///
+		EASTL_API int simd_set_features(int nFeatures);
+
+
+		// char string kernels, used by the char versions of the string search functions
+		// in char_traits.h. The find kernels return NULL if nothing was found.
+
+		// The first and the last occurrence of [pPatternBegin, pPatternEnd), of at least 2 chars.
+		EASTL_API const char* simd_string_search (const char* pBegin, const char* pEnd, const char* pPatternBegin, const char* pPatternEnd);
+		EASTL_API const char* simd_string_rsearch(const char* pBegin, const char* pEnd, const char* pPatternBegin, const char* pPatternEnd);
+
+		// The last occurrence of c.
+		EASTL_API const char* simd_string_find_last(const char* pBegin, const char* pEnd, char c);
+
+		// The first and the last char which is (bInSet) or isn't (!bInSet) in [pSetBegin, pSetEnd).
+		EASTL_API const char* simd_string_find_first_of(const char* pBegin, const char* pEnd, const char* pSetBegin, const char* pSetEnd, bool bInSet);
+		EASTL_API const char* simd_string_find_last_of (const char* pBegin, const char* pEnd, const char* pSetBegin, const char* pSetEnd, bool bInSet);
+
+		// The index of the first byte which differs between p1 and p2, or nSize if none does.
+		EASTL_API size_t simd_mismatch(const void* p1, const void* p2, size_t nSize);
+
+
+		// Kernels of the algorithms for ranges of arithmetic types, used by the pointer versions
+		// of find, count, replace, mismatch, equal, min_element, max_element and minmax_element
+		// (see algorithm.h). They compare elements with the == and < of T.
+		//
+		// simd_find returns pEnd if value isn't found, and simd_mismatch_elements the number of
+		// elements before the first which differs between p1 and p2. The min/max kernels require
+		// a non-empty range, and fail (returning NULL or false) if it has a NaN, for which the
+		// callers use their scalar code.
+		#define EASTL_SIMD_DECLARE_ALGORITHMS(T)                                                                 \
+			EASTL_API const T* simd_find(const T* pBegin, const T* pEnd, T value);                               \
+			EASTL_API size_t   simd_count(const T* pBegin, const T* pEnd, T value);                              \
+			EASTL_API void     simd_replace(T* pBegin, T* pEnd, T oldValue, T newValue);                         \
+			EASTL_API size_t   simd_mismatch_elements(const T* p1, const T* p2, size_t n);                       \
+			EASTL_API const T* simd_min_element(const T* pBegin, const T* pEnd);                                 \
+			EASTL_API const T* simd_max_element(const T* pBegin, const T* pEnd);                                 \
+			EASTL_API bool     simd_minmax_element(const T* pBegin, const T* pEnd, const T*& pMin, const T*& pMax);
+
+		EASTL_SIMD_DECLARE_ALGORITHMS(int8_t)
+		EASTL_SIMD_DECLARE_ALGORITHMS(uint8_t)
+		EASTL_SIMD_DECLARE_ALGORITHMS(int16_t)
+		EASTL_SIMD_DECLARE_ALGORITHMS(uint16_t)
+		EASTL_SIMD_DECLARE_ALGORITHMS(int32_t)
+		EASTL_SIMD_DECLARE_ALGORITHMS(uint32_t)
+		EASTL_SIMD_DECLARE_ALGORITHMS(int64_t)
+		EASTL_SIMD_DECLARE_ALGORITHMS(uint64_t)
+		EASTL_SIMD_DECLARE_ALGORITHMS(float)
+		EASTL_SIMD_DECLARE_ALGORITHMS(double)
+
+		#undef EASTL_SIMD_DECLARE_ALGORITHMS
+
+
+		// UTF kernels, used by the transcoders of utf.h (see source/string.cpp).
+
+		// The length of a prefix of [p, p + n) which is valid UTF-8 and ends at the end of a
+		// character: n if it's all valid. AVX2 validates 32 bytes per step; SSE2 only skips
+		// ASCII, and leaves the rest to be validated by the caller.
+		EASTL_API size_t simd_utf8_valid_length(const char* p, size_t n);
+
+		// Convert the leading elements of the source which each convert to one element of the
+		// same value (ASCII, or for UTF-16 to UTF-32 and back, code points below 0x10000 which
+		// aren't surrogates), in whole vectors, and return their number.
+		EASTL_API size_t simd_utf_transcode_direct(const char*     pSrc, size_t n, char16_t* pDest);
+		EASTL_API size_t simd_utf_transcode_direct(const char*     pSrc, size_t n, char32_t* pDest);
+		EASTL_API size_t simd_utf_transcode_direct(const char16_t* pSrc, size_t n, char*     pDest);
+		EASTL_API size_t simd_utf_transcode_direct(const char16_t* pSrc, size_t n, char32_t* pDest);
+		EASTL_API size_t simd_utf_transcode_direct(const char32_t* pSrc, size_t n, char*     pDest);
+		EASTL_API size_t simd_utf_transcode_direct(const char32_t* pSrc, size_t n, char16_t* pDest);
+
+	} // namespace Internal
+
+} // namespace std
+
+#endif // EASTL_SIMD_ENABLED
+
+
+#endif // Header include guard
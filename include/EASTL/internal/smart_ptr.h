@@ -183,6 +183,39 @@ namespace std
 	};
 
 
+	/// allocator_delete
+	///
+	/// Provides a way to delete an object which was constructed in memory from
+	/// an allocator, e.g. a node of a fixed_node_allocator or of a pool, by calling
+	/// its destructor and returning sizeof(T) bytes to the allocator. The allocator
+	/// must outlive the deleter's use.
+	///
+	/// Example usage:
+	///     typedef allocator_delete<Node, NodeAllocator> NodeDelete;
+	///     unique_ptr<Node, NodeDelete> pNode(::new(nodeAllocator.allocate(sizeof(Node))) Node, NodeDelete(&nodeAllocator));
+	///
+	template <typename T, typename Allocator>
+	struct allocator_delete
+	{
+		EA_CONSTEXPR allocator_delete() EA_NOEXCEPT
+			: mpAllocator(NULL) {}
+
+		explicit allocator_delete(Allocator* pAllocator) EA_NOEXCEPT
+			: mpAllocator(pAllocator) {}
+
+		void operator()(T* p) const EA_NOEXCEPT
+		{
+			if(p)
+			{
+				p->~T();
+				EASTLFree(*mpAllocator, p, sizeof(T));
+			}
+		}
+
+		Allocator* mpAllocator;
+	};
+
+
 
 
 	/// smart_ptr_deleter
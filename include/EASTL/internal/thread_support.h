@@ -92,6 +92,8 @@ EA_DISABLE_VC_WARNING(4625 4626 4275);
 
 namespace std
 {
+	class mutex; // See <EASTL/mutex.h>.
+
 	namespace Internal
 	{
 		/// atomic_increment
@@ -225,14 +227,24 @@ namespace std
 		};
 
 
+		// thread_yield
+		// Gives the rest of the calling thread's time slice to another thread which is ready to run, if any.
+		EASTL_API void thread_yield();
+
+
 		// shared_ptr_auto_mutex
-		class EASTL_API shared_ptr_auto_mutex : public auto_mutex
+		// Locks the std::mutex which guards the shared_ptr at the given address for the atomic_* shared_ptr functions.
+		class EASTL_API shared_ptr_auto_mutex
 		{
 		public:
 			shared_ptr_auto_mutex(const void* pSharedPtr);
+		   ~shared_ptr_auto_mutex();
 
 			shared_ptr_auto_mutex(const shared_ptr_auto_mutex&) = delete;
 			void operator=(shared_ptr_auto_mutex&&) = delete;
+
+		protected:
+			std::mutex* mpMutex;
 		};
 
 
@@ -8,6 +8,7 @@
 
 
 #include <EASTL/internal/config.h>
+#include <EASTL/internal/thread_support.h>
 #include <stddef.h>
 
 #if defined(EA_PRAGMA_ONCE_SUPPORTED)
@@ -35,6 +36,126 @@ namespace std
 		p->Release();
 	}
 
+	// Likewise, these are the functions used by intrusive_ptr_local_policy, and can be
+	// overridden in the same way. The defaults call the non-atomic functions of
+	// intrusive_ref_counter.
+	template <typename T>
+	void intrusive_ptr_add_ref_local(T* p)
+	{
+		p->AddRefLocal();
+	}
+
+	template <typename T>
+	void intrusive_ptr_release_local(T* p)
+	{
+		p->ReleaseLocal();
+	}
+
+
+	/// intrusive_ptr_default_policy
+	///
+	/// The default RefCountPolicy of intrusive_ptr. It calls intrusive_ptr_add_ref and
+	/// intrusive_ptr_release, which is what intrusive_ptr has always done.
+	///
+	struct intrusive_ptr_default_policy
+	{
+		template <typename T>
+		static void add_ref(T* p)
+			{ intrusive_ptr_add_ref(p); }  // Intentionally do not prefix the call with std:: but instead allow namespace lookup to resolve the namespace.
+
+		template <typename T>
+		static void release(T* p)
+			{ intrusive_ptr_release(p); }
+	};
+
+
+	/// intrusive_ptr_local_policy
+	///
+	/// A RefCountPolicy for objects which are confined to a single thread. It calls
+	/// intrusive_ptr_add_ref_local and intrusive_ptr_release_local, which for types
+	/// derived from intrusive_ref_counter update the count with plain arithmetic
+	/// instead of atomic read-modify-write instructions.
+	///
+	/// All intrusive_ptrs which refer to a given object must use the same policy
+	/// while they do so, as atomic and non-atomic updates of the same count don't mix.
+	///
+	struct intrusive_ptr_local_policy
+	{
+		template <typename T>
+		static void add_ref(T* p)
+			{ intrusive_ptr_add_ref_local(p); }
+
+		template <typename T>
+		static void release(T* p)
+			{ intrusive_ptr_release_local(p); }
+	};
+
+
+	/// intrusive_ref_counter
+	///
+	/// A base class which provides the reference count for use with intrusive_ptr.
+	/// AddRef and Release update the count atomically, for use with the default
+	/// policy. AddRefLocal and ReleaseLocal do the same non-atomically, for use with
+	/// intrusive_ptr_local_policy. The object is deleted as a Derived when its count
+	/// drops to zero. Copying an object doesn't copy its count.
+	///
+	/// Example usage:
+	///    struct Node : public intrusive_ref_counter<Node> { local_intrusive_ptr<Node> mpNext; };
+	///
+	///    local_intrusive_ptr<Node> pHead(new Node);
+	///    pHead->mpNext = new Node;
+	///
+	template <typename Derived>
+	class intrusive_ref_counter
+	{
+	public:
+		int32_t AddRef() const EA_NOEXCEPT
+		{
+			return Internal::atomic_increment(&mnRefCount);
+		}
+
+		int32_t Release() const
+		{
+			const int32_t nRefCount = Internal::atomic_decrement(&mnRefCount);
+			if(nRefCount == 0)
+				delete static_cast<const Derived*>(this);
+			return nRefCount;
+		}
+
+		int32_t AddRefLocal() const EA_NOEXCEPT
+		{
+			return ++mnRefCount;
+		}
+
+		int32_t ReleaseLocal() const
+		{
+			const int32_t nRefCount = --mnRefCount;
+			if(nRefCount == 0)
+				delete static_cast<const Derived*>(this);
+			return nRefCount;
+		}
+
+		int32_t use_count() const EA_NOEXCEPT
+		{
+			return mnRefCount;
+		}
+
+	protected:
+		intrusive_ref_counter() EA_NOEXCEPT
+			: mnRefCount(0) { }
+
+		intrusive_ref_counter(const intrusive_ref_counter&) EA_NOEXCEPT
+			: mnRefCount(0) { }
+
+		intrusive_ref_counter& operator=(const intrusive_ref_counter&) EA_NOEXCEPT
+			{ return *this; }
+
+		~intrusive_ref_counter() { }
+
+	protected:
+		mutable int32_t mnRefCount;
+	};
+
 
 	//////////////////////////////////////////////////////////////////////////////
 	/// intrusive_ptr
@@ -58,18 +179,21 @@ namespace std
 	///    2) Clear out your intrusive_ptr members in your shutdown function.
 	///    3) Simply don't use intrusive_ptr objects as class members.
 	///
+	/// The RefCountPolicy parameter selects how references are added and released.
+	/// See intrusive_ptr_default_policy and intrusive_ptr_local_policy.
+	///
 	/// Example usage:
 	///    intrusive_ptr<IWidget> pWidget = new Widget;
 	///    pWidget = new Widget;
 	///    pWidget->Reset();
 	///
-	template <typename T>
+	template <typename T, typename RefCountPolicy = intrusive_ptr_default_policy>
 	class intrusive_ptr
 	{
 	protected:
 		// Friend declarations.
-		template <typename U> friend class intrusive_ptr;
-		typedef intrusive_ptr<T> this_type;
+		template <typename U, typename P> friend class intrusive_ptr;
+		typedef intrusive_ptr<T, RefCountPolicy> this_type;
 
 		T* mpObject;
 
@@ -85,6 +209,10 @@ namespace std
 		///
 		typedef T element_type;
 
+		/// policy_type
+		/// The RefCountPolicy this intrusive_ptr was instantiated with.
+		typedef RefCountPolicy policy_type;
+
 		/// intrusive_ptr
 		/// Default constructor. The member object is set to NULL.
 		intrusive_ptr()
@@ -103,7 +231,7 @@ namespace std
 			: mpObject(p) 
 		{
 			if(mpObject && bAddRef)
-				intrusive_ptr_add_ref(mpObject);  // Intentionally do not prefix the call with std:: but instead allow namespace lookup to resolve the namespace.
+				RefCountPolicy::add_ref(mpObject);
 		} 
 
 		/// intrusive_ptr
@@ -112,7 +240,7 @@ namespace std
 			: mpObject(ip.mpObject) 
 		{
 			if(mpObject)
-				intrusive_ptr_add_ref(mpObject);
+				RefCountPolicy::add_ref(mpObject);
 		}
 
 
@@ -133,11 +261,11 @@ namespace std
 		///    intrusive_ptr<Widget> pWidget1;
 		///    intrusive_ptr<Widget> pWidget2(pWidget1);
 		template <typename U>
-		intrusive_ptr(const intrusive_ptr<U>& ip) 
+		intrusive_ptr(const intrusive_ptr<U, RefCountPolicy>& ip) 
 			: mpObject(ip.mpObject) 
 		{
 			if(mpObject)
-				intrusive_ptr_add_ref(mpObject);
+				RefCountPolicy::add_ref(mpObject);
 		}
 
 		/// intrusive_ptr
@@ -145,7 +273,7 @@ namespace std
 		~intrusive_ptr() 
 		{
 			if(mpObject)
-				intrusive_ptr_release(mpObject);
+				RefCountPolicy::release(mpObject);
 		}
 
 
@@ -175,7 +303,7 @@ namespace std
 		/// action is taken. The incoming pointer is AddRefd before any 
 		/// member pointer is Released.
 		template <typename U>
-		intrusive_ptr& operator=(const intrusive_ptr<U>& ip)       
+		intrusive_ptr& operator=(const intrusive_ptr<U, RefCountPolicy>& ip)       
 		{
 			return operator=(ip.mpObject);
 		}
@@ -193,10 +321,10 @@ namespace std
 			{
 				T* const pTemp = mpObject; // Create temporary to prevent possible problems with re-entrancy.
 				if(pObject)
-					intrusive_ptr_add_ref(pObject);
+					RefCountPolicy::add_ref(pObject);
 				mpObject = pObject;
 				if(pTemp)
-					intrusive_ptr_release(pTemp);
+					RefCountPolicy::release(pTemp);
 			}
 			return *this;
 		}
@@ -230,7 +358,7 @@ namespace std
 			T* const pTemp = mpObject;
 			mpObject = NULL;
 			if(pTemp)
-				intrusive_ptr_release(pTemp);
+				RefCountPolicy::release(pTemp);
 		}
 
 		/// swap
@@ -255,7 +383,7 @@ namespace std
 			T* const pTemp = mpObject;
 			mpObject = pObject;
 			if(pTemp)
-				intrusive_ptr_release(pTemp);
+				RefCountPolicy::release(pTemp);
 		}
 
 		/// detach
@@ -313,8 +441,8 @@ namespace std
 
 	/// get_pointer
 	/// returns intrusive_ptr::get() via the input intrusive_ptr. 
-	template <typename T>
-	inline T* get_pointer(const intrusive_ptr<T>& intrusivePtr)
+	template <typename T, typename P>
+	inline T* get_pointer(const intrusive_ptr<T, P>& intrusivePtr)
 	{
 		return intrusivePtr.get();
 	}
@@ -323,60 +451,60 @@ namespace std
 	/// Exchanges the owned pointer beween two intrusive_ptr objects.
 	/// This non-member version is useful for compatibility of intrusive_ptr
 	/// objects with the C++ Standard Library and other libraries.
-	template <typename T>
-	inline void swap(intrusive_ptr<T>& intrusivePtr1, intrusive_ptr<T>& intrusivePtr2)
+	template <typename T, typename P>
+	inline void swap(intrusive_ptr<T, P>& intrusivePtr1, intrusive_ptr<T, P>& intrusivePtr2)
 	{
 		intrusivePtr1.swap(intrusivePtr2);
 	}
 
 
-	template <typename T, typename U>
-	bool operator==(intrusive_ptr<T> const& iPtr1, intrusive_ptr<U> const& iPtr2)
+	template <typename T, typename U, typename P>
+	bool operator==(intrusive_ptr<T, P> const& iPtr1, intrusive_ptr<U, P> const& iPtr2)
 	{
 		return (iPtr1.get() == iPtr2.get());
 	}
 
-	template <typename T, typename U>
-	bool operator!=(intrusive_ptr<T> const& iPtr1, intrusive_ptr<U> const& iPtr2)
+	template <typename T, typename U, typename P>
+	bool operator!=(intrusive_ptr<T, P> const& iPtr1, intrusive_ptr<U, P> const& iPtr2)
 	{
 		return (iPtr1.get() != iPtr2.get());
 	}
 
-	template <typename T>
-	bool operator==(intrusive_ptr<T> const& iPtr1, T* p)
+	template <typename T, typename P>
+	bool operator==(intrusive_ptr<T, P> const& iPtr1, T* p)
 	{
 		return (iPtr1.get() == p);
 	}
 
-	template <typename T>
-	bool operator!=(intrusive_ptr<T> const& iPtr1, T* p)
+	template <typename T, typename P>
+	bool operator!=(intrusive_ptr<T, P> const& iPtr1, T* p)
 	{
 		return (iPtr1.get() != p);
 	}
 
-	template <typename T>
-	bool operator==(T* p, intrusive_ptr<T> const& iPtr2)
+	template <typename T, typename P>
+	bool operator==(T* p, intrusive_ptr<T, P> const& iPtr2)
 	{
 		return (p == iPtr2.get());
 	}
 
-	template <typename T>
-	bool operator!=(T* p, intrusive_ptr<T> const& iPtr2)
+	template <typename T, typename P>
+	bool operator!=(T* p, intrusive_ptr<T, P> const& iPtr2)
 	{
 		return (p != iPtr2.get());
 	}
 
-	template <typename T, typename U>
-	bool operator<(intrusive_ptr<T> const& iPtr1, intrusive_ptr<U> const& iPtr2)
+	template <typename T, typename U, typename P>
+	bool operator<(intrusive_ptr<T, P> const& iPtr1, intrusive_ptr<U, P> const& iPtr2)
 	{
 		return ((uintptr_t)iPtr1.get() < (uintptr_t)iPtr2.get());
 	}
 
 
 	/// static_pointer_cast
-	/// Returns an intrusive_ptr<T> static-casted from a intrusive_ptr<U>.
-	template <class T, class U>
-	intrusive_ptr<T> static_pointer_cast(const intrusive_ptr<U>& intrusivePtr)
+	/// Returns an intrusive_ptr<T, P> static-casted from a intrusive_ptr<U, P>.
+	template <class T, class U, class P>
+	intrusive_ptr<T, P> static_pointer_cast(const intrusive_ptr<U, P>& intrusivePtr)
 	{
 		return static_cast<T*>(intrusivePtr.get());
 	}
@@ -385,9 +513,9 @@ namespace std
 	#if EASTL_RTTI_ENABLED
 
 	/// dynamic_pointer_cast
-	/// Returns an intrusive_ptr<T> dynamic-casted from a intrusive_ptr<U>.
-	template <class T, class U>
-	intrusive_ptr<T> dynamic_pointer_cast(const intrusive_ptr<U>& intrusivePtr)
+	/// Returns an intrusive_ptr<T, P> dynamic-casted from a intrusive_ptr<U, P>.
+	template <class T, class U, class P>
+	intrusive_ptr<T, P> dynamic_pointer_cast(const intrusive_ptr<U, P>& intrusivePtr)
 	{
 		return dynamic_cast<T*>(intrusivePtr.get());
 	}
@@ -395,6 +523,16 @@ namespace std
 	#endif
 
 
+	/// local_intrusive_ptr
+	///
+	/// An intrusive_ptr which uses intrusive_ptr_local_policy.
+	///
+	#if !defined(EA_COMPILER_NO_TEMPLATE_ALIASES)
+		template <typename T>
+		using local_intrusive_ptr = intrusive_ptr<T, intrusive_ptr_local_policy>;
+	#endif
+
+
 } // namespace std
 
 
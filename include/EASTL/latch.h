@@ -0,0 +1,100 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements the following
+//     latch
+//
+// This follows the C++ standard library's <latch>.
+//
+// http://en.cppreference.com/w/cpp/header/latch
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_LATCH_H
+#define EASTL_LATCH_H
+
+
+#include <EABase/eabase.h>
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once
+#endif
+
+#include <EASTL/internal/config.h>
+#include <EASTL/atomic.h>
+#include <stddef.h>
+
+
+
+namespace std
+{
+
+	/// latch
+	///
+	/// Implements a single-use countdown which threads can wait to reach zero,
+	/// e.g. for a thread to wait for a set of jobs to finish, or for a set of
+	/// threads to start at the same time. Unlike barrier, it can't be reused.
+	///
+	/// The count is a 32-bit atomic which waiting threads sleep on through
+	/// atomic<int32_t>::wait, which is a futex on Linux. Only the count_down
+	/// which reaches zero notifies.
+	///
+	/// Example usage:
+	///    latch done(kJobCount);
+	///
+	///    for(int i = 0; i < kJobCount; i++)
+	///        Submit([&]{ DoJob(); done.count_down(); });
+	///
+	///    done.wait();
+	///
+	class latch
+	{
+	public:
+		static EA_CONSTEXPR ptrdiff_t max() EA_NOEXCEPT
+			{ return INT32_MAX; }
+
+		EA_CONSTEXPR explicit latch(ptrdiff_t nExpected)
+			: mnCount((int32_t)nExpected) { }
+
+		latch(const latch&) = delete;
+		latch& operator=(const latch&) = delete;
+
+		/// Subtracts n from the count, and wakes the waiting threads if it reaches zero.
+		void count_down(ptrdiff_t n = 1)
+		{
+			const int32_t nPrevious = mnCount.fetch_sub((int32_t)n, memory_order_release);
+			EASTL_ASSERT((n >= 0) && (n <= nPrevious));
+
+			if(nPrevious == n)
+				mnCount.notify_all();
+		}
+
+		/// Returns true if the count has reached zero.
+		bool try_wait() const EA_NOEXCEPT
+		{
+			return mnCount.load(memory_order_acquire) == 0;
+		}
+
+		/// Waits until the count reaches zero.
+		void wait() const
+		{
+			for(int32_t nCount = mnCount.load(memory_order_acquire); nCount != 0; nCount = mnCount.load(memory_order_acquire))
+				mnCount.wait(nCount, memory_order_acquire);
+		}
+
+		/// Subtracts n from the count and waits until it reaches zero.
+		void arrive_and_wait(ptrdiff_t n = 1)
+		{
+			count_down(n);
+			wait();
+		}
+
+	protected:
+		atomic<int32_t> mnCount;
+	};
+
+} // namespace std
+
+
+#endif // Header include guard
@@ -0,0 +1,834 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements local_shared_ptr and local_weak_ptr, which are versions
+// of shared_ptr and weak_ptr whose reference counts are updated with plain
+// integer arithmetic instead of atomic read-modify-write instructions.
+//
+// shared_ptr must update its counts atomically, as any copy of it may be
+// released by any thread. That costs a locked instruction per copy and per
+// destruction, even for object graphs which never leave the thread that
+// created them. local_shared_ptr is for such thread-confined graphs (e.g.
+// the objects of a single-threaded event loop or a scene graph which is
+// walked by one thread); copying and destroying it is as cheap as ++ and --.
+//
+// Notes regarding safe usage of local_shared_ptr:
+//     - All local_shared_ptr and local_weak_ptr instances which share ownership
+//       of an object must be used by only one thread at a time. Handing the
+//       whole ownership group to another thread (e.g. moving the last
+//       local_shared_ptr across a queue) is fine; using two of them from two
+//       threads at once is not.
+//     - local_shared_ptr and shared_ptr are not interconvertible, as that
+//       would mix atomic and non-atomic updates of the same counts.
+//     - local_shared_ptr doesn't set up enable_shared_from_this.
+//
+// The control blocks are the same ref_count_sp types used by shared_ptr, so
+// custom deleters and allocators, allocate_local_shared and make_local_shared
+// behave the same as their shared_ptr counterparts.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_LOCAL_SHARED_PTR_H
+#define EASTL_LOCAL_SHARED_PTR_H
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/shared_ptr.h>
+
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace std
+{
+	// Forward declarations
+	template <typename T> class local_shared_ptr;
+	template <typename T> class local_weak_ptr;
+
+
+
+	/// local_shared_ptr
+	///
+	/// A shared_ptr whose reference count is not thread-safe. See the top of this
+	/// file for when it can be used. The interface is that of shared_ptr minus the
+	/// atomic functions and enable_shared_from_this support.
+	///
+	/// Example usage:
+	///    struct Node { vector<local_shared_ptr<Node> > mChildren; local_weak_ptr<Node> mParent; };
+	///
+	///    local_shared_ptr<Node> pRoot = make_local_shared<Node>();
+	///    local_shared_ptr<Node> pChild(new Node);
+	///    pChild->mParent = pRoot;
+	///    pRoot->mChildren.push_back(pChild);
+	///
+	template <typename T>
+	class local_shared_ptr
+	{
+	public:
+		typedef local_shared_ptr<T>                              this_type;
+		typedef T                                                element_type;
+		typedef typename shared_ptr_traits<T>::reference_type    reference_type;
+		typedef EASTLAllocatorType                               default_allocator_type;
+		typedef default_delete<T>                                default_deleter_type;
+		typedef local_weak_ptr<T>                                weak_type;
+
+	protected:
+		element_type*  mpValue;
+		ref_count_sp*  mpRefCount;           /// Base pointer to Reference count for owned pointer and the owned pointer.
+
+	public:
+		/// Initializes and "empty" local_shared_ptr.
+		/// Postcondition: use_count() == zero and get() == 0
+		local_shared_ptr() EA_NOEXCEPT
+			: mpValue(nullptr),
+			  mpRefCount(nullptr)
+		{
+		}
+
+
+		local_shared_ptr(std::nullptr_t) EA_NOEXCEPT
+			: mpValue(nullptr),
+			  mpRefCount(nullptr)
+		{
+		}
+
+
+		/// Takes ownership of the pointer and sets the reference count
+		/// to the pointer to 1. It is OK if the input pointer is null.
+		/// The shared reference count is allocated on the heap using the
+		/// default eastl allocator.
+		/// Exception safety: If an exception is thrown, delete p is called.
+		/// Postcondition in the event of no exception: use_count() == 1 && get() == p
+		template <typename U>
+		explicit local_shared_ptr(U* pValue,
+		                          typename std::enable_if<std::is_convertible<U*, element_type*>::value>::type* = 0)
+		    : mpValue(nullptr), mpRefCount(nullptr)
+		{
+			alloc_internal(pValue, default_allocator_type(), default_delete<U>());
+		}
+
+
+		/// Takes ownership of the pointer, which will be disposed of
+		/// using the provided deleter.
+		template <typename U, typename Deleter>
+		local_shared_ptr(U* pValue,
+		                 Deleter deleter,
+		                 typename std::enable_if<std::is_convertible<U*, element_type*>::value>::type* = 0)
+		    : mpValue(nullptr), mpRefCount(nullptr)
+		{
+			alloc_internal(pValue, default_allocator_type(), std::move(deleter));
+		}
+
+
+		/// Takes ownership of the pointer, which will be disposed of using the
+		/// provided deleter. The shared reference count is allocated with the
+		/// supplied allocator.
+		template <typename U, typename Deleter, typename Allocator>
+		explicit local_shared_ptr(U* pValue,
+		                          Deleter deleter,
+		                          const Allocator& allocator,
+		                          typename std::enable_if<std::is_convertible<U*, element_type*>::value>::type* = 0)
+		    : mpValue(nullptr), mpRefCount(nullptr)
+		{
+			alloc_internal(pValue, allocator, std::move(deleter));
+		}
+
+
+		local_shared_ptr(const local_shared_ptr& sharedPtr) EA_NOEXCEPT
+			: mpValue(sharedPtr.mpValue),
+			  mpRefCount(sharedPtr.mpRefCount)
+		{
+			if(mpRefCount)
+				mpRefCount->local_addref();
+		}
+
+
+		template <typename U>
+		local_shared_ptr(const local_shared_ptr<U>& sharedPtr,
+		                 typename std::enable_if<std::is_convertible<U*, element_type*>::value>::type* = 0) EA_NOEXCEPT
+		    : mpValue(sharedPtr.mpValue),
+		      mpRefCount(sharedPtr.mpRefCount)
+		{
+			if(mpRefCount)
+				mpRefCount->local_addref();
+		}
+
+
+		/// local_shared_ptr
+		/// Aliasing constructor. Shares ownership with sharedPtr while storing pValue.
+		/// See the equivalent shared_ptr constructor.
+		template <typename U>
+		local_shared_ptr(const local_shared_ptr<U>& sharedPtr, element_type* pValue) EA_NOEXCEPT
+			: mpValue(pValue),
+			  mpRefCount(sharedPtr.mpRefCount)
+		{
+			if(mpRefCount)
+				mpRefCount->local_addref();
+		}
+
+
+		local_shared_ptr(local_shared_ptr&& sharedPtr) EA_NOEXCEPT
+			: mpValue(sharedPtr.mpValue),
+			  mpRefCount(sharedPtr.mpRefCount)
+		{
+			sharedPtr.mpValue = nullptr;
+			sharedPtr.mpRefCount = nullptr;
+		}
+
+
+		template <typename U>
+		local_shared_ptr(local_shared_ptr<U>&& sharedPtr,
+		                 typename std::enable_if<std::is_convertible<U*, element_type*>::value>::type* = 0) EA_NOEXCEPT
+		    : mpValue(sharedPtr.mpValue),
+		      mpRefCount(sharedPtr.mpRefCount)
+		{
+			sharedPtr.mpValue = nullptr;
+			sharedPtr.mpRefCount = nullptr;
+		}
+
+
+		// unique_ptr constructor
+		template <typename U, typename Deleter>
+		local_shared_ptr(unique_ptr<U, Deleter>&& uniquePtr,
+		                 typename std::enable_if<!std::is_array<U>::value && !is_lvalue_reference<Deleter>::value &&
+		                                           std::is_convertible<U*, element_type*>::value>::type* = 0)
+		    : mpValue(nullptr), mpRefCount(nullptr)
+		{
+			alloc_internal(uniquePtr.release(), default_allocator_type(), uniquePtr.get_deleter());
+		}
+
+
+		/// local_shared_ptr(local_weak_ptr)
+		/// Shares ownership of a pointer with an instance of local_weak_ptr.
+		/// Throws bad_weak_ptr if the local_weak_ptr has expired.
+		template <typename U>
+		explicit local_shared_ptr(const local_weak_ptr<U>& weakPtr,
+		                          typename std::enable_if<std::is_convertible<U*, element_type*>::value>::type* = 0)
+		    : mpValue(weakPtr.mpValue)
+		    , mpRefCount(weakPtr.mpRefCount ? weakPtr.mpRefCount->local_lock() : weakPtr.mpRefCount) // local_lock() addref's the return value for us.
+		{
+			if(!mpRefCount)
+			{
+				mpValue = nullptr;
+
+			#if EASTL_EXCEPTIONS_ENABLED
+				throw std::bad_weak_ptr();
+			#else
+				EASTL_FAIL_MSG("std::local_shared_ptr -- bad_weak_ptr");
+			#endif
+			}
+		}
+
+
+		/// ~local_shared_ptr
+		/// Decrements the reference count for the owned pointer. If the
+		/// reference count goes to zero, the owned pointer is deleted and
+		/// the shared reference count is deleted.
+		~local_shared_ptr()
+		{
+			if(mpRefCount)
+				mpRefCount->local_release();
+
+			#if EASTL_DEBUG
+				mpValue = nullptr;
+				mpRefCount = nullptr;
+			#endif
+		}
+
+
+		local_shared_ptr& operator=(const local_shared_ptr& sharedPtr) EA_NOEXCEPT
+		{
+			if(&sharedPtr != this)
+				this_type(sharedPtr).swap(*this);
+
+			return *this;
+		}
+
+
+		template <typename U>
+		typename std::enable_if<std::is_convertible<U*, element_type*>::value, this_type&>::type
+		operator=(const local_shared_ptr<U>& sharedPtr) EA_NOEXCEPT
+		{
+			if(!equivalent_ownership(sharedPtr))
+				this_type(sharedPtr).swap(*this);
+			return *this;
+		}
+
+
+		this_type& operator=(local_shared_ptr&& sharedPtr) EA_NOEXCEPT
+		{
+			if(&sharedPtr != this)
+				this_type(std::move(sharedPtr)).swap(*this);
+
+			return *this;
+		}
+
+
+		template <typename U>
+		typename std::enable_if<std::is_convertible<U*, element_type*>::value, this_type&>::type
+		operator=(local_shared_ptr<U>&& sharedPtr) EA_NOEXCEPT
+		{
+			if(!equivalent_ownership(sharedPtr))
+				this_type(std::move(sharedPtr)).swap(*this);
+			return *this;
+		}
+
+
+		template <typename U, typename Deleter>
+		typename std::enable_if<!std::is_array<U>::value && std::is_convertible<U*, element_type*>::value, this_type&>::type
+		operator=(unique_ptr<U, Deleter>&& uniquePtr)
+		{
+			this_type(std::move(uniquePtr)).swap(*this);
+			return *this;
+		}
+
+
+		/// reset
+		/// Releases the owned pointer.
+		void reset() EA_NOEXCEPT
+		{
+			this_type().swap(*this);
+		}
+
+
+		/// reset
+		/// Releases the owned pointer and takes ownership of the
+		/// passed in pointer.
+		template <typename U>
+		typename std::enable_if<std::is_convertible<U*, element_type*>::value, void>::type
+		reset(U* pValue)
+		{
+			this_type(pValue).swap(*this);
+		}
+
+
+		template <typename U, typename Deleter>
+		typename std::enable_if<std::is_convertible<U*, element_type*>::value, void>::type
+		reset(U* pValue, Deleter deleter)
+		{
+			this_type(pValue, deleter).swap(*this);
+		}
+
+
+		template <typename U, typename Deleter, typename Allocator>
+		typename std::enable_if<std::is_convertible<U*, element_type*>::value, void>::type
+		reset(U* pValue, Deleter deleter, const Allocator& allocator)
+		{
+			this_type(pValue, deleter, allocator).swap(*this);
+		}
+
+
+		/// swap
+		/// Exchanges the owned pointer between two local_shared_ptr objects.
+		void swap(this_type& sharedPtr) EA_NOEXCEPT
+		{
+			element_type* const pValue = sharedPtr.mpValue;
+			sharedPtr.mpValue = mpValue;
+			mpValue           = pValue;
+
+			ref_count_sp* const pRefCount = sharedPtr.mpRefCount;
+			sharedPtr.mpRefCount = mpRefCount;
+			mpRefCount           = pRefCount;
+		}
+
+
+		reference_type operator*() const EA_NOEXCEPT
+		{
+			return *mpValue;
+		}
+
+		element_type* operator->() const EA_NOEXCEPT
+		{
+			return mpValue;
+		}
+
+		element_type* get() const EA_NOEXCEPT
+		{
+			return mpValue;
+		}
+
+		/// use_count
+		/// Returns: the number of local_shared_ptr objects, *this included, that share ownership with *this, or 0 when *this is empty.
+		int use_count() const EA_NOEXCEPT
+		{
+			return mpRefCount ? mpRefCount->mRefCount : 0;
+		}
+
+		/// unique
+		/// Returns: use_count() == 1.
+		bool unique() const EA_NOEXCEPT
+		{
+			return (mpRefCount && (mpRefCount->mRefCount == 1));
+		}
+
+
+		/// owner_before
+		/// C++11 function for ordering.
+		template <typename U>
+		bool owner_before(const local_shared_ptr<U>& sharedPtr) const EA_NOEXCEPT
+		{
+			return (mpRefCount < sharedPtr.mpRefCount);
+		}
+
+		template <typename U>
+		bool owner_before(const local_weak_ptr<U>& weakPtr) const EA_NOEXCEPT
+		{
+			return (mpRefCount < weakPtr.mpRefCount);
+		}
+
+
+		template <typename Deleter>
+		Deleter* get_deleter() const EA_NOEXCEPT
+		{
+			#if EASTL_RTTI_ENABLED
+				return mpRefCount ? static_cast<Deleter*>(mpRefCount->get_deleter(typeid(typename remove_cv<Deleter>::type))) : nullptr;
+			#else
+				return nullptr;
+			#endif
+		}
+
+		#ifdef EA_COMPILER_NO_EXPLICIT_CONVERSION_OPERATORS
+			typedef T* (this_type::*bool_)() const;
+			operator bool_() const EA_NOEXCEPT
+			{
+				if(mpValue)
+					return &this_type::get;
+				return nullptr;
+			}
+
+			bool operator!() const EA_NOEXCEPT
+			{
+				return (mpValue == nullptr);
+			}
+		#else
+			/// Explicit operator bool
+			/// Allows for using a local_shared_ptr as a boolean.
+			explicit operator bool() const EA_NOEXCEPT
+			{
+				return (mpValue != nullptr);
+			}
+		#endif
+
+		/// Returns true if the given local_shared_ptr ows the same T pointer that we do.
+		template <typename U>
+		bool equivalent_ownership(const local_shared_ptr<U>& sharedPtr) const
+		{
+			return (mpRefCount == sharedPtr.mpRefCount);
+		}
+
+	protected:
+		// Friend declarations.
+		template <typename U> friend class local_shared_ptr;
+		template <typename U> friend class local_weak_ptr;
+		template <typename U> friend void allocate_local_shared_helper(local_shared_ptr<U>&, ref_count_sp*, U*);
+
+		// Handles the allocating of mpRefCount, while assigning mpValue.
+		// The provided pValue may be NULL, as with constructing with a deleter and allocator but NULL pointer.
+		template <typename U, typename Allocator, typename Deleter>
+		void alloc_internal(U pValue, Allocator allocator, Deleter deleter)
+		{
+			typedef ref_count_sp_t<U, Allocator, Deleter> ref_count_type;
+
+			#if EASTL_EXCEPTIONS_ENABLED
+				try
+				{
+					void* const pMemory = EASTLAlloc(allocator, sizeof(ref_count_type));
+					if(!pMemory)
+						throw std::bad_alloc();
+					mpRefCount = ::new(pMemory) ref_count_type(pValue, std::move(deleter), std::move(allocator));
+					mpValue = pValue;
+				}
+				catch(...)
+				{
+					deleter(pValue);
+					throw;
+				}
+			#else
+				void* const pMemory = EASTLAlloc(allocator, sizeof(ref_count_type));
+				if(pMemory)
+				{
+					mpRefCount = ::new(pMemory) ref_count_type(pValue, std::move(deleter), std::move(allocator));
+					mpValue = pValue;
+				}
+				else
+				{
+					deleter(pValue);
+				}
+			#endif
+		}
+
+	}; // class local_shared_ptr
+
+
+	template <typename T>
+	inline typename local_shared_ptr<T>::element_type* get_pointer(const local_shared_ptr<T>& sharedPtr) EA_NOEXCEPT
+	{
+		return sharedPtr.get();
+	}
+
+	template <typename Deleter, typename T>
+	Deleter* get_deleter(const local_shared_ptr<T>& sharedPtr) EA_NOEXCEPT
+	{
+		return sharedPtr.template get_deleter<Deleter>();
+	}
+
+	template <typename T>
+	inline void swap(local_shared_ptr<T>& a, local_shared_ptr<T>& b) EA_NOEXCEPT
+	{
+		a.swap(b);
+	}
+
+
+	/// local_shared_ptr comparison operators
+	template <typename T, typename U>
+	inline bool operator==(const local_shared_ptr<T>& a, const local_shared_ptr<U>& b) EA_NOEXCEPT
+	{
+		return (a.get() == b.get());
+	}
+
+	template <typename T, typename U>
+	inline bool operator!=(const local_shared_ptr<T>& a, const local_shared_ptr<U>& b) EA_NOEXCEPT
+	{
+		return (a.get() != b.get());
+	}
+
+	template <typename T, typename U>
+	inline bool operator<(const local_shared_ptr<T>& a, const local_shared_ptr<U>& b) EA_NOEXCEPT
+	{
+		typedef typename std::common_type<T*, U*>::type CPointer; // See the shared_ptr version of this for why these temporaries exist.
+		CPointer pT = a.get();
+		CPointer pU = b.get();
+		return less<CPointer>()(pT, pU);
+	}
+
+	template <typename T, typename U>
+	inline bool operator>(const local_shared_ptr<T>& a, const local_shared_ptr<U>& b) EA_NOEXCEPT
+	{
+		return (b < a);
+	}
+
+	template <typename T, typename U>
+	inline bool operator<=(const local_shared_ptr<T>& a, const local_shared_ptr<U>& b) EA_NOEXCEPT
+	{
+		return !(b < a);
+	}
+
+	template <typename T, typename U>
+	inline bool operator>=(const local_shared_ptr<T>& a, const local_shared_ptr<U>& b) EA_NOEXCEPT
+	{
+		return !(a < b);
+	}
+
+	template <typename T>
+	inline bool operator==(const local_shared_ptr<T>& a, std::nullptr_t) EA_NOEXCEPT
+	{
+		return !a;
+	}
+
+	template <typename T>
+	inline bool operator==(std::nullptr_t, const local_shared_ptr<T>& b) EA_NOEXCEPT
+	{
+		return !b;
+	}
+
+	template <typename T>
+	inline bool operator!=(const local_shared_ptr<T>& a, std::nullptr_t) EA_NOEXCEPT
+	{
+		return static_cast<bool>(a);
+	}
+
+	template <typename T>
+	inline bool operator!=(std::nullptr_t, const local_shared_ptr<T>& b) EA_NOEXCEPT
+	{
+		return static_cast<bool>(b);
+	}
+
+
+	/// static_pointer_cast / const_pointer_cast / reinterpret_pointer_cast / dynamic_pointer_cast
+	///
+	/// These are the local_shared_ptr equivalents of the shared_ptr casts.
+	///
+	template <typename T, typename U>
+	inline local_shared_ptr<T> static_pointer_cast(const local_shared_ptr<U>& sharedPtr) EA_NOEXCEPT
+	{
+		return local_shared_ptr<T>(sharedPtr, static_cast<T*>(sharedPtr.get()));
+	}
+
+	template <typename T, typename U>
+	inline local_shared_ptr<T> const_pointer_cast(const local_shared_ptr<U>& sharedPtr) EA_NOEXCEPT
+	{
+		return local_shared_ptr<T>(sharedPtr, const_cast<T*>(sharedPtr.get()));
+	}
+
+	template <typename T, typename U>
+	inline local_shared_ptr<T> reinterpret_pointer_cast(const local_shared_ptr<U>& sharedPtr) EA_NOEXCEPT
+	{
+		return local_shared_ptr<T>(sharedPtr, reinterpret_cast<T*>(sharedPtr.get()));
+	}
+
+	#if EASTL_RTTI_ENABLED
+		template <typename T, typename U>
+		inline local_shared_ptr<T> dynamic_pointer_cast(const local_shared_ptr<U>& sharedPtr) EA_NOEXCEPT
+		{
+			if(T* p = dynamic_cast<T*>(sharedPtr.get()))
+				return local_shared_ptr<T>(sharedPtr, p);
+			return local_shared_ptr<T>();
+		}
+	#endif
+
+
+	/// hash specialization for local_shared_ptr.
+	template <typename T>
+	struct hash< local_shared_ptr<T> >
+	{
+		size_t operator()(const local_shared_ptr<T>& x) const EA_NOEXCEPT
+			{ return std::hash<T*>()(x.get()); }
+	};
+
+
+	template <typename T>
+	void allocate_local_shared_helper(local_shared_ptr<T>& sharedPtr, ref_count_sp* pRefCount, T* pValue)
+	{
+		sharedPtr.mpRefCount = pRefCount;
+		sharedPtr.mpValue = pValue;
+	}
+
+
+	/// allocate_local_shared
+	///
+	/// Like allocate_shared, this allocates the object and its reference counts
+	/// with a single allocation.
+	///
+	template <typename T, typename Allocator, typename... Args>
+	local_shared_ptr<T> allocate_local_shared(const Allocator& allocator, Args&&... args)
+	{
+		typedef ref_count_sp_t_inst<T, Allocator> ref_count_type;
+		local_shared_ptr<T> ret;
+		void* const pMemory = EASTLAlloc(const_cast<Allocator&>(allocator), sizeof(ref_count_type));
+		if(pMemory)
+		{
+			ref_count_type* pRefCount = ::new(pMemory) ref_count_type(allocator, std::forward<Args>(args)...);
+			allocate_local_shared_helper(ret, pRefCount, pRefCount->GetValue());
+		}
+		return ret;
+	}
+
+
+	/// make_local_shared
+	///
+	/// The local_shared_ptr equivalent of make_shared.
+	///
+	template <typename T, typename... Args>
+	local_shared_ptr<T> make_local_shared(Args&&... args)
+	{
+		return std::allocate_local_shared<T>(EASTL_SHARED_PTR_DEFAULT_ALLOCATOR, std::forward<Args>(args)...);
+	}
+
+
+
+	/// local_weak_ptr
+	///
+	/// The weak_ptr counterpart of local_shared_ptr. The same single-thread
+	/// confinement applies to it.
+	///
+	template <typename T>
+	class local_weak_ptr
+	{
+	public:
+		typedef local_weak_ptr<T> this_type;
+		typedef T                 element_type;
+
+	public:
+		local_weak_ptr() EA_NOEXCEPT
+			: mpValue(nullptr),
+			  mpRefCount(nullptr)
+		{
+		}
+
+
+		local_weak_ptr(const this_type& weakPtr) EA_NOEXCEPT
+			: mpValue(weakPtr.mpValue),
+			  mpRefCount(weakPtr.mpRefCount)
+		{
+			if(mpRefCount)
+				mpRefCount->local_weak_addref();
+		}
+
+
+		local_weak_ptr(this_type&& weakPtr) EA_NOEXCEPT
+			: mpValue(weakPtr.mpValue),
+			  mpRefCount(weakPtr.mpRefCount)
+		{
+			weakPtr.mpValue = nullptr;
+			weakPtr.mpRefCount = nullptr;
+		}
+
+
+		template <typename U>
+		local_weak_ptr(const local_weak_ptr<U>& weakPtr,
+		               typename std::enable_if<std::is_convertible<U*, element_type*>::value>::type* = 0) EA_NOEXCEPT
+			: mpValue(weakPtr.mpValue),
+			  mpRefCount(weakPtr.mpRefCount)
+		{
+			if(mpRefCount)
+				mpRefCount->local_weak_addref();
+		}
+
+
+		template <typename U>
+		local_weak_ptr(const local_shared_ptr<U>& sharedPtr,
+		               typename std::enable_if<std::is_convertible<U*, element_type*>::value>::type* = 0) EA_NOEXCEPT
+			: mpValue(sharedPtr.mpValue),
+			  mpRefCount(sharedPtr.mpRefCount)
+		{
+			if(mpRefCount)
+				mpRefCount->local_weak_addref();
+		}
+
+
+		~local_weak_ptr()
+		{
+			if(mpRefCount)
+				mpRefCount->local_weak_release();
+		}
+
+
+		this_type& operator=(const this_type& weakPtr) EA_NOEXCEPT
+		{
+			assign(weakPtr);
+			return *this;
+		}
+
+
+		this_type& operator=(this_type&& weakPtr) EA_NOEXCEPT
+		{
+			this_type(std::move(weakPtr)).swap(*this);
+			return *this;
+		}
+
+
+		template <typename U>
+		typename std::enable_if<std::is_convertible<U*, element_type*>::value, this_type&>::type
+		operator=(const local_weak_ptr<U>& weakPtr) EA_NOEXCEPT
+		{
+			assign(weakPtr);
+			return *this;
+		}
+
+
+		template <typename U>
+		typename std::enable_if<std::is_convertible<U*, element_type*>::value, this_type&>::type
+		operator=(const local_shared_ptr<U>& sharedPtr) EA_NOEXCEPT
+		{
+			assign(sharedPtr.mpValue, sharedPtr.mpRefCount);
+			return *this;
+		}
+
+
+		/// lock
+		/// Returns a local_shared_ptr to the object, or an empty local_shared_ptr if it has expired.
+		local_shared_ptr<T> lock() const EA_NOEXCEPT
+		{
+			local_shared_ptr<T> temp;
+			temp.mpRefCount = mpRefCount ? mpRefCount->local_lock() : mpRefCount; // local_lock() addref's the return value for us.
+			if(temp.mpRefCount)
+				temp.mpValue = mpValue;
+			return temp;
+		}
+
+		// Returns: 0 if *this is empty ; otherwise, the number of local_shared_ptr instances that share ownership with *this.
+		int use_count() const EA_NOEXCEPT
+		{
+			return mpRefCount ? mpRefCount->mRefCount : 0;
+		}
+
+		// Returns: use_count() == 0
+		bool expired() const EA_NOEXCEPT
+		{
+			return (!mpRefCount || (mpRefCount->mRefCount == 0));
+		}
+
+		void reset()
+		{
+			if(mpRefCount)
+				mpRefCount->local_weak_release();
+
+			mpValue    = nullptr;
+			mpRefCount = nullptr;
+		}
+
+		void swap(this_type& weakPtr)
+		{
+			T* const pValue = weakPtr.mpValue;
+			weakPtr.mpValue = mpValue;
+			mpValue         = pValue;
+
+			ref_count_sp* const pRefCount = weakPtr.mpRefCount;
+			weakPtr.mpRefCount = mpRefCount;
+			mpRefCount         = pRefCount;
+		}
+
+
+		template <typename U>
+		void assign(const local_weak_ptr<U>& weakPtr,
+		            typename std::enable_if<std::is_convertible<U*, element_type*>::value>::type* = 0) EA_NOEXCEPT
+		{
+			assign(weakPtr.mpValue, weakPtr.mpRefCount);
+		}
+
+
+		template <typename U>
+		bool owner_before(const local_weak_ptr<U>& weakPtr) const EA_NOEXCEPT
+		{
+			return (mpRefCount < weakPtr.mpRefCount);
+		}
+
+		template <typename U>
+		bool owner_before(const local_shared_ptr<U>& sharedPtr) const EA_NOEXCEPT
+		{
+			return (mpRefCount < sharedPtr.mpRefCount);
+		}
+
+	protected:
+		void assign(element_type* pValue, ref_count_sp* pRefCount) EA_NOEXCEPT
+		{
+			mpValue = pValue;
+
+			if(pRefCount != mpRefCount) // This check encompasses assignment to self.
+			{
+				if(mpRefCount)
+					mpRefCount->local_weak_release();
+
+				mpRefCount = pRefCount;
+
+				if(mpRefCount)
+					mpRefCount->local_weak_addref();
+			}
+		}
+
+	protected:
+		element_type*  mpValue;       /// The (weakly) owned pointer.
+		ref_count_sp*  mpRefCount;    /// Reference count for owned pointer.
+
+		// Friend declarations
+		template <typename U> friend class local_shared_ptr;
+		template <typename U> friend class local_weak_ptr;
+
+	}; // class local_weak_ptr
+
+
+	template <typename T>
+	inline void swap(local_weak_ptr<T>& a, local_weak_ptr<T>& b)
+	{
+		a.swap(b);
+	}
+
+
+} // namespace std
+
+
+#endif // Header include guard
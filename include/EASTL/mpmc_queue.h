@@ -0,0 +1,530 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements the following
+//     mpmc_queue
+//     fixed_mpmc_queue
+//
+// mpmc_queue is a bounded queue which any number of producer and consumer
+// threads can use at once without a mutex. It follows Dmitry Vyukov's design,
+// in which each slot of the ring carries a sequence number that tells which
+// lap of the ring it was last written or read in, so that claiming a slot
+// takes a single compare-and-swap of the shared push or pop index.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_MPMC_QUEUE_H
+#define EASTL_MPMC_QUEUE_H
+
+
+#include <EABase/eabase.h>
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once
+#endif
+
+#include <EASTL/internal/config.h>
+#include <EASTL/internal/thread_support.h>
+#include <EASTL/allocator.h>
+#include <EASTL/atomic.h>
+#include <EASTL/span.h>
+#include <EASTL/type_traits.h>
+#include <EASTL/utility.h>
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// EASTL_MPMC_QUEUE_SPIN_COUNT
+//
+// The number of times the blocking functions of mpmc_queue retry with a
+// pause in between before they start to yield the thread's time slice
+// between retries.
+//
+#ifndef EASTL_MPMC_QUEUE_SPIN_COUNT
+	#define EASTL_MPMC_QUEUE_SPIN_COUNT 64
+#endif
+
+
+
+namespace std
+{
+
+	/// EASTL_MPMC_QUEUE_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_MPMC_QUEUE_DEFAULT_NAME
+		#define EASTL_MPMC_QUEUE_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " mpmc_queue" // Unless the user overrides something, this is "EASTL mpmc_queue".
+	#endif
+
+
+	/// EASTL_MPMC_QUEUE_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_MPMC_QUEUE_DEFAULT_ALLOCATOR
+		#define EASTL_MPMC_QUEUE_DEFAULT_ALLOCATOR allocator_type(EASTL_MPMC_QUEUE_DEFAULT_NAME)
+	#endif
+
+
+
+	namespace Internal
+	{
+		/// mpmc_queue_cell
+		///
+		/// A slot of the ring. For the slot at index i of a ring of n slots, in
+		/// lap k (which covers the push and pop indices k*n+i), mnSequence is
+		/// k*n+i while the slot is free for the push of index k*n+i, k*n+i+1 once
+		/// that push has constructed its element, and (k+1)*n+i once the pop of
+		/// index k*n+i has destroyed it again.
+		///
+		template <typename T>
+		struct mpmc_queue_cell
+		{
+			atomic<eastl_size_t>                                      mnSequence;
+			typename aligned_storage<sizeof(T), EASTL_ALIGN_OF(T)>::type mValue;
+
+			T* value() { return reinterpret_cast<T*>(&mValue); }
+		};
+
+
+		/// mpmc_queue_sequence_diff
+		///
+		/// Returns how far a cell's sequence number is ahead of (if positive) or
+		/// behind (if negative) the index expected of it, which is correct across
+		/// wraparound of the indices. The difference must be taken in the signed
+		/// type of the same width as eastl_size_t, which is narrower than intptr_t
+		/// when EASTL_SIZE_T_32BIT is set on a 64 bit platform.
+		///
+		inline eastl_ssize_t mpmc_queue_sequence_diff(eastl_size_t nSequence, eastl_size_t nExpected)
+		{
+			static_assert(sizeof(eastl_ssize_t) == sizeof(eastl_size_t), "eastl_ssize_t must be the signed counterpart of eastl_size_t.");
+			return (eastl_ssize_t)(nSequence - nExpected);
+		}
+
+
+		///////////////////////////////////////////////////////////////////////
+		// mpmc_queue_base
+		///////////////////////////////////////////////////////////////////////
+
+		/// mpmc_queue_base
+		///
+		/// Implements the queue over a ring of cells provided by the subclass. The
+		/// push and pop indices increase without wrapping to the ring's size, which
+		/// is a power of two of at least 2. A thread claims the cell at the push
+		/// index by checking its sequence number and then swapping the index with
+		/// the next, and makes the cell's element visible by storing its new
+		/// sequence number; popping is the mirror image. A thread which is
+		/// suspended between the two steps holds up consumers of its cell only.
+		///
+		/// Each index is on its own cache line, so that producers and consumers
+		/// only contend with their own kind on them.
+		///
+		template <typename T>
+		class mpmc_queue_base
+		{
+		public:
+			typedef mpmc_queue_base<T>      this_type;
+			typedef T                       value_type;
+			typedef T&                      reference;
+			typedef const T&                const_reference;
+			typedef T*                      pointer;
+			typedef eastl_size_t            size_type;
+			typedef mpmc_queue_cell<T>      cell_type;
+
+		public:
+			/// try_push
+			///
+			/// Adds a copy of value to the back of the queue. Returns false without
+			/// doing anything if the queue is full.
+			///
+			bool try_push(const value_type& value)
+				{ return try_emplace(value); }
+
+			bool try_push(value_type&& value)
+				{ return try_emplace(std::move(value)); }
+
+
+			/// try_emplace
+			///
+			/// Constructs an element from args at the back of the queue. Returns
+			/// false without doing anything if the queue is full. args are only
+			/// used if the element is constructed.
+			///
+			template <typename... Args>
+			bool try_emplace(Args&&... args)
+			{
+				size_type nPos = mnPushIndex.load(memory_order_relaxed);
+				cell_type* pCell;
+
+				for(;;)
+				{
+					pCell = &mpCells[nPos & (mnCapacity - 1)];
+					const eastl_ssize_t nDiff = mpmc_queue_sequence_diff(pCell->mnSequence.load(memory_order_acquire), nPos);
+
+					if(nDiff == 0)
+					{
+						if(mnPushIndex.compare_exchange_weak(nPos, nPos + 1, memory_order_relaxed))
+							break;
+					}
+					else if(nDiff < 0)
+						return false; // The cell still holds the element pushed a lap ago.
+					else
+						nPos = mnPushIndex.load(memory_order_relaxed); // Another producer claimed the cell.
+				}
+
+				::new(static_cast<void*>(pCell->value())) value_type(std::forward<Args>(args)...);
+				pCell->mnSequence.store(nPos + 1, memory_order_release);
+				return true;
+			}
+
+
+			/// try_pop
+			///
+			/// Moves the front element into value and removes it. Returns false
+			/// without doing anything if the queue is empty.
+			///
+			bool try_pop(value_type& value)
+			{
+				size_type nPos = mnPopIndex.load(memory_order_relaxed);
+				cell_type* pCell;
+
+				for(;;)
+				{
+					pCell = &mpCells[nPos & (mnCapacity - 1)];
+					const eastl_ssize_t nDiff = mpmc_queue_sequence_diff(pCell->mnSequence.load(memory_order_acquire), nPos + 1);
+
+					if(nDiff == 0)
+					{
+						if(mnPopIndex.compare_exchange_weak(nPos, nPos + 1, memory_order_relaxed))
+							break;
+					}
+					else if(nDiff < 0)
+						return false; // The cell's element hasn't been pushed yet.
+					else
+						nPos = mnPopIndex.load(memory_order_relaxed); // Another consumer claimed the cell.
+				}
+
+				value = std::move(*pCell->value());
+				pCell->value()->~value_type();
+				pCell->mnSequence.store(nPos + mnCapacity, memory_order_release);
+				return true;
+			}
+
+
+			/// push / emplace / pop
+			///
+			/// Like try_push, try_emplace and try_pop, but wait until there is room
+			/// or an element instead of failing. They spin for a while and then
+			/// yield between retries.
+			///
+			void push(const value_type& value)
+				{ emplace(value); }
+
+			void push(value_type&& value)
+				{ emplace(std::move(value)); }
+
+			template <typename... Args>
+			void emplace(Args&&... args)
+			{
+				for(int i = 0; !try_emplace(std::forward<Args>(args)...); i++) // args aren't used up by a failed try.
+					Backoff(i);
+			}
+
+			void pop(value_type& value)
+			{
+				for(int i = 0; !try_pop(value); i++)
+					Backoff(i);
+			}
+
+
+			/// push_n
+			///
+			/// Adds copies of as many of the given values as fit to the back of the
+			/// queue, in order, and returns how many were added. The values are
+			/// given consecutive places in the queue with a single swap of the push
+			/// index, and other producers' elements don't come between them.
+			///
+			size_type push_n(span<const value_type> values)
+			{
+				const size_type nMaxCount = (size_type)values.size();
+				size_type       nPos      = mnPushIndex.load(memory_order_relaxed);
+				size_type       nCount;
+
+				for(;;)
+				{
+					// Counts the free cells from nPos on. The swap below fails if any of
+					// them was claimed by another producer in the meantime.
+					eastl_ssize_t nDiff = 0;
+
+					for(nCount = 0; nCount < nMaxCount; nCount++)
+					{
+						nDiff = mpmc_queue_sequence_diff(mpCells[(nPos + nCount) & (mnCapacity - 1)].mnSequence.load(memory_order_acquire), nPos + nCount);
+						if(nDiff != 0)
+							break;
+					}
+
+					if(nCount)
+					{
+						if(mnPushIndex.compare_exchange_weak(nPos, nPos + nCount, memory_order_relaxed))
+							break;
+					}
+					else if(nDiff < 0 || !nMaxCount)
+						return 0;
+					else
+						nPos = mnPushIndex.load(memory_order_relaxed);
+				}
+
+				for(size_type i = 0; i < nCount; i++)
+				{
+					cell_type& cell = mpCells[(nPos + i) & (mnCapacity - 1)];
+					::new(static_cast<void*>(cell.value())) value_type(values[i]);
+					cell.mnSequence.store(nPos + i + 1, memory_order_release);
+				}
+
+				return nCount;
+			}
+
+
+			/// pop_n
+			///
+			/// Moves up to values.size() elements from the front of the queue into
+			/// values, in order, removes them and returns how many there were. The
+			/// elements are taken with a single swap of the pop index.
+			///
+			size_type pop_n(span<value_type> values)
+			{
+				const size_type nMaxCount = (size_type)values.size();
+				size_type       nPos      = mnPopIndex.load(memory_order_relaxed);
+				size_type       nCount;
+
+				for(;;)
+				{
+					eastl_ssize_t nDiff = 0;
+
+					for(nCount = 0; nCount < nMaxCount; nCount++)
+					{
+						nDiff = mpmc_queue_sequence_diff(mpCells[(nPos + nCount) & (mnCapacity - 1)].mnSequence.load(memory_order_acquire), nPos + nCount + 1);
+						if(nDiff != 0)
+							break;
+					}
+
+					if(nCount)
+					{
+						if(mnPopIndex.compare_exchange_weak(nPos, nPos + nCount, memory_order_relaxed))
+							break;
+					}
+					else if(nDiff < 0 || !nMaxCount)
+						return 0;
+					else
+						nPos = mnPopIndex.load(memory_order_relaxed);
+				}
+
+				for(size_type i = 0; i < nCount; i++)
+				{
+					cell_type& cell = mpCells[(nPos + i) & (mnCapacity - 1)];
+					values[i] = std::move(*cell.value());
+					cell.value()->~value_type();
+					cell.mnSequence.store(nPos + i + mnCapacity, memory_order_release);
+				}
+
+				return nCount;
+			}
+
+
+			/// size
+			///
+			/// Returns the number of elements which are in the queue or being pushed.
+			/// The result may be out of date on return if other threads use the queue.
+			///
+			size_type size() const
+			{
+				const size_type nPopIndex = mnPopIndex.load(memory_order_acquire); // Read before mnPushIndex so that the difference can't be negative.
+				const size_type nSize     = mnPushIndex.load(memory_order_acquire) - nPopIndex;
+
+				return (nSize < mnCapacity) ? nSize : mnCapacity;
+			}
+
+			bool empty() const
+				{ return size() == 0; }
+
+			/// capacity
+			/// Returns the maximum number of elements, which is a power of two.
+			size_type capacity() const
+				{ return mnCapacity; }
+
+		protected:
+			mpmc_queue_base(cell_type* pCells, size_type nCapacity)
+				: mpCells(pCells), mnCapacity(nCapacity), mnPushIndex(0), mnPopIndex(0)
+			{
+				EASTL_ASSERT((nCapacity >= 2) && ((nCapacity & (nCapacity - 1)) == 0));
+			}
+
+			// Sets the cells' sequence numbers for the first lap. Subclasses call this once the cells exist.
+			void InitCells()
+			{
+				for(size_type i = 0; i < mnCapacity; i++)
+					mpCells[i].mnSequence.store(i, memory_order_relaxed);
+			}
+
+			// Destroys the elements which are still in the queue. Subclasses call this before freeing the cells.
+			void DestroyElements()
+			{
+				for(size_type i = mnPopIndex.load(memory_order_relaxed), iEnd = mnPushIndex.load(memory_order_relaxed); i != iEnd; i++)
+					mpCells[i & (mnCapacity - 1)].value()->~value_type();
+			}
+
+			static void Backoff(int nAttempt)
+			{
+				if(nAttempt < EASTL_MPMC_QUEUE_SPIN_COUNT)
+					cpu_pause();
+				else
+					Internal::thread_yield();
+			}
+
+			mpmc_queue_base(const this_type&);            // Not implemented.
+			this_type& operator=(const this_type&);       // Not implemented.
+
+		protected:
+			cell_type*        mpCells;      // Neither is written after construction, so all threads can share this cache line.
+			size_type         mnCapacity;
+			char              mPadding0[EA_CACHE_LINE_SIZE]; // Keeps the producers' line off the above.
+
+			atomic<size_type> mnPushIndex;  // Swapped by producers.
+			char              mPadding1[EA_CACHE_LINE_SIZE]; // Keeps the consumers' line off the producers'.
+
+			atomic<size_type> mnPopIndex;   // Swapped by consumers.
+			char              mPadding2[EA_CACHE_LINE_SIZE]; // Keeps whatever follows the queue off the consumers' line.
+		};
+
+	} // namespace Internal
+
+
+
+	///////////////////////////////////////////////////////////////////////////
+	// mpmc_queue
+	///////////////////////////////////////////////////////////////////////////
+
+	/// mpmc_queue
+	///
+	/// Implements a bounded FIFO queue which any number of threads may push to
+	/// and pop from at once without locking. try_push, try_emplace and try_pop
+	/// fail rather than wait when the queue is full or empty; push, emplace and
+	/// pop wait. push_n and pop_n move batches of elements at the cost of one
+	/// swap of the shared index per batch rather than per element.
+	///
+	/// The queue is lock-free in the sense that threads never hold a lock, but
+	/// a producer which is suspended after claiming a cell keeps consumers from
+	/// getting past that cell until it resumes; the cell appears empty to them
+	/// in the meantime. Constructing an element must not throw, because the
+	/// claimed cell can't be given back.
+	///
+	/// The ring is allocated by the constructor and its size is nCapacity rounded
+	/// up to a power of two of at least 2. See fixed_mpmc_queue for a version
+	/// which holds its ring inline.
+	///
+	/// Example usage:
+	///    mpmc_queue<Task*> queue(4096);
+	///
+	///    // Any stage thread:
+	///    queue.push(pTask);
+	///
+	///    // Any worker thread:
+	///    Task* tasks[16];
+	///    while(size_t n = queue.pop_n(tasks))
+	///        RunTasks(tasks, n);
+	///
+	template <typename T, typename Allocator = EASTLAllocatorType>
+	class mpmc_queue : public Internal::mpmc_queue_base<T>
+	{
+	public:
+		typedef Internal::mpmc_queue_base<T>   base_type;
+		typedef mpmc_queue<T, Allocator>       this_type;
+		typedef typename base_type::size_type  size_type;
+		typedef typename base_type::cell_type  cell_type;
+		typedef Allocator                      allocator_type;
+
+	public:
+		explicit mpmc_queue(size_type nCapacity, const allocator_type& allocator = EASTL_MPMC_QUEUE_DEFAULT_ALLOCATOR)
+			: base_type(NULL, RoundUpCapacity(nCapacity)), mAllocator(allocator)
+		{
+			this->mpCells = (cell_type*)EASTLAllocAligned(mAllocator, this->mnCapacity * sizeof(cell_type),
+			                                              (EASTL_ALIGN_OF(cell_type) > EA_CACHE_LINE_SIZE) ? EASTL_ALIGN_OF(cell_type) : EA_CACHE_LINE_SIZE, 0);
+			for(size_type i = 0; i < this->mnCapacity; i++)
+				::new(static_cast<void*>(this->mpCells + i)) cell_type;
+			this->InitCells();
+		}
+
+	   ~mpmc_queue()
+		{
+			this->DestroyElements();
+			EASTLFree(mAllocator, this->mpCells, this->mnCapacity * sizeof(cell_type));
+		}
+
+		const allocator_type& get_allocator() const EA_NOEXCEPT
+			{ return mAllocator; }
+
+	protected:
+		static size_type RoundUpCapacity(size_type n)
+		{
+			size_type nCapacity = 2;
+			while(nCapacity < n)
+				nCapacity *= 2;
+			return nCapacity;
+		}
+
+		mpmc_queue(const this_type&);            // Not implemented.
+		this_type& operator=(const this_type&);  // Not implemented.
+
+	protected:
+		allocator_type mAllocator;
+	};
+
+
+
+	///////////////////////////////////////////////////////////////////////////
+	// fixed_mpmc_queue
+	///////////////////////////////////////////////////////////////////////////
+
+	/// fixed_mpmc_queue
+	///
+	/// Implements an mpmc_queue whose ring of nCapacity cells is a member, so
+	/// that it does no allocation. nCapacity must be a power of two of at least 2.
+	///
+	/// Example usage:
+	///    fixed_mpmc_queue<Job, 1024> queue;
+	///
+	template <typename T, size_t nCapacity>
+	class fixed_mpmc_queue : public Internal::mpmc_queue_base<T>
+	{
+		static_assert((nCapacity >= 2) && ((nCapacity & (nCapacity - 1)) == 0), "fixed_mpmc_queue capacity must be a power of two of at least 2.");
+
+	public:
+		typedef Internal::mpmc_queue_base<T>   base_type;
+		typedef fixed_mpmc_queue<T, nCapacity> this_type;
+		typedef typename base_type::cell_type  cell_type;
+
+	public:
+		fixed_mpmc_queue()
+			: base_type(mCells, nCapacity)
+		{
+			this->InitCells();
+		}
+
+	   ~fixed_mpmc_queue()
+		{
+			this->DestroyElements();
+		}
+
+	protected:
+		fixed_mpmc_queue(const this_type&);            // Not implemented.
+		this_type& operator=(const this_type&);        // Not implemented.
+
+	protected:
+		cell_type mCells[nCapacity];
+	};
+
+
+} // namespace std
+
+
+#endif // Header include guard
@@ -0,0 +1,373 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements the following
+//     mutex
+//     spinlock
+//     lock_guard
+//     unique_lock
+//     defer_lock / try_to_lock / adopt_lock
+//
+// mutex and lock_guard/unique_lock follow the C++ standard library's <mutex>.
+// spinlock is an extension for critical sections so short that suspending
+// the thread costs more than waiting for them.
+//
+// Neither mutex nor spinlock is recursive: a thread which locks one it already
+// holds deadlocks. Both are a single 32-bit word which can be zero-initialized
+// statically, and neither makes a system call when it isn't contended.
+//
+// http://en.cppreference.com/w/cpp/header/mutex
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_MUTEX_H
+#define EASTL_MUTEX_H
+
+
+#include <EABase/eabase.h>
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once
+#endif
+
+#include <EASTL/internal/config.h>
+#include <EASTL/internal/thread_support.h>
+#include <EASTL/atomic.h>
+#include <EASTL/utility.h>
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// EASTL_MUTEX_SPIN_COUNT
+//
+// The number of times mutex::lock checks a locked mutex, with a cpu_pause in
+// between, before it asks the OS to suspend the thread. Mutexes are mostly
+// held for short times, so a thread which spins briefly usually gets the
+// mutex without the system calls of sleeping and being woken.
+//
+#ifndef EASTL_MUTEX_SPIN_COUNT
+	#define EASTL_MUTEX_SPIN_COUNT 100
+#endif
+
+
+///////////////////////////////////////////////////////////////////////////////
+// EASTL_SPINLOCK_MAX_BACKOFF
+//
+// The largest number of cpu_pause calls spinlock::lock makes between checks
+// of a locked spinlock. The count doubles upon each check, up to this, so that
+// threads waiting for the same spinlock don't all check it at once. Beyond it
+// the waiting thread yields to other threads.
+//
+#ifndef EASTL_SPINLOCK_MAX_BACKOFF
+	#define EASTL_SPINLOCK_MAX_BACKOFF 64
+#endif
+
+
+
+namespace std
+{
+
+	///////////////////////////////////////////////////////////////////////////
+	// mutex
+	///////////////////////////////////////////////////////////////////////////
+
+	/// mutex
+	///
+	/// Implements a non-recursive mutex which spins briefly when it finds the
+	/// mutex locked and then sleeps until it's unlocked (U. Drepper, "Futexes
+	/// Are Tricky"). Its state is 0 when unlocked, 1 when locked, and 2 when
+	/// locked and a thread may be asleep waiting for it. Sleeping threads wait
+	/// through atomic<uint32_t>::wait, which is a futex on Linux and
+	/// WaitOnAddress on Windows, and unlock only notifies when the state was 2.
+	///
+	/// Unlike Internal::mutex, which is recursive and wraps a pthread mutex or a
+	/// CRITICAL_SECTION, this needs no constructor or destructor calls, so it
+	/// can be a global which is used during static initialization.
+	///
+	/// Example usage:
+	///    mutex gMutex;
+	///
+	///    lock_guard<mutex> lock(gMutex);
+	///
+	class mutex
+	{
+	public:
+		EA_CONSTEXPR mutex() EA_NOEXCEPT
+			: mnState(0) { }
+
+		mutex(const mutex&) = delete;
+		mutex& operator=(const mutex&) = delete;
+
+		void lock()
+		{
+			uint32_t nExpected = 0;
+
+			if(!mnState.compare_exchange_strong(nExpected, 1, memory_order_acquire, memory_order_relaxed))
+				LockContended();
+		}
+
+		bool try_lock()
+		{
+			uint32_t nExpected = 0;
+			return mnState.compare_exchange_strong(nExpected, 1, memory_order_acquire, memory_order_relaxed);
+		}
+
+		void unlock()
+		{
+			if(mnState.exchange(0, memory_order_release) == 2)
+				mnState.notify_one();
+		}
+
+	protected:
+		void LockContended()
+		{
+			for(int i = 0; i < EASTL_MUTEX_SPIN_COUNT; i++)
+			{
+				uint32_t nState = mnState.load(memory_order_relaxed);
+
+				if(nState == 2) // Other threads are already asleep; there's no point in spinning with them.
+					break;
+
+				if((nState == 0) && mnState.compare_exchange_weak(nState, 1, memory_order_acquire, memory_order_relaxed))
+					return;
+
+				cpu_pause();
+			}
+
+			// We set the state to 2 whenever we may sleep, and keep it at 2 when we get the
+			// mutex, as we can't tell whether other threads are asleep.
+			while(mnState.exchange(2, memory_order_acquire) != 0)
+				mnState.wait(2, memory_order_relaxed);
+		}
+
+	protected:
+		atomic<uint32_t> mnState;
+	};
+
+
+
+	///////////////////////////////////////////////////////////////////////////
+	// spinlock
+	///////////////////////////////////////////////////////////////////////////
+
+	/// spinlock
+	///
+	/// Implements a non-recursive lock which threads wait for by spinning rather
+	/// than sleeping. lock tests the lock with a plain load before it tries to
+	/// set it (test-and-test-and-set), so that waiting threads read a shared
+	/// cache line rather than fight over it, and pauses for exponentially longer
+	/// between tests. It has the interface of mutex, and so works with lock_guard
+	/// and unique_lock.
+	///
+	/// A thread which is suspended while it holds a spinlock keeps the others
+	/// spinning until it resumes, so this is only better than mutex for critical
+	/// sections of a few dozen instructions, with fewer threads than cores.
+	///
+	class spinlock
+	{
+	public:
+		EA_CONSTEXPR spinlock() EA_NOEXCEPT
+			: mbLocked(false) { }
+
+		spinlock(const spinlock&) = delete;
+		spinlock& operator=(const spinlock&) = delete;
+
+		void lock()
+		{
+			while(mbLocked.exchange(true, memory_order_acquire))
+			{
+				int nBackoff = 1;
+
+				while(mbLocked.load(memory_order_relaxed))
+				{
+					if(nBackoff <= EASTL_SPINLOCK_MAX_BACKOFF)
+					{
+						for(int i = 0; i < nBackoff; i++)
+							cpu_pause();
+						nBackoff *= 2;
+					}
+					else
+						Internal::thread_yield(); // The holder may be waiting for our core.
+				}
+			}
+		}
+
+		bool try_lock()
+		{
+			return !mbLocked.load(memory_order_relaxed) && !mbLocked.exchange(true, memory_order_acquire);
+		}
+
+		void unlock()
+		{
+			mbLocked.store(false, memory_order_release);
+		}
+
+	protected:
+		atomic<bool> mbLocked;
+	};
+
+
+
+	///////////////////////////////////////////////////////////////////////////
+	// defer_lock / try_to_lock / adopt_lock
+	///////////////////////////////////////////////////////////////////////////
+
+	/// Tags which tell unique_lock (and lock_guard, for adopt_lock) how to treat
+	/// the mutex it's given: not to lock it, to try to lock it, or that the
+	/// caller has already locked it.
+	struct defer_lock_t  { explicit defer_lock_t()  = default; };
+	struct try_to_lock_t { explicit try_to_lock_t() = default; };
+	struct adopt_lock_t  { explicit adopt_lock_t()  = default; };
+
+	EASTL_CPP17_INLINE_VARIABLE EA_CONSTEXPR defer_lock_t  defer_lock{};
+	EASTL_CPP17_INLINE_VARIABLE EA_CONSTEXPR try_to_lock_t try_to_lock{};
+	EASTL_CPP17_INLINE_VARIABLE EA_CONSTEXPR adopt_lock_t  adopt_lock{};
+
+
+
+	///////////////////////////////////////////////////////////////////////////
+	// lock_guard
+	///////////////////////////////////////////////////////////////////////////
+
+	/// lock_guard
+	///
+	/// Locks a mutex for the lifetime of the lock_guard.
+	///
+	template <typename Mutex>
+	class lock_guard
+	{
+	public:
+		typedef Mutex mutex_type;
+
+		explicit lock_guard(mutex_type& m)
+			: mMutex(m) { mMutex.lock(); }
+
+		lock_guard(mutex_type& m, adopt_lock_t)
+			: mMutex(m) { }
+
+	   ~lock_guard()
+			{ mMutex.unlock(); }
+
+		lock_guard(const lock_guard&) = delete;
+		lock_guard& operator=(const lock_guard&) = delete;
+
+	protected:
+		mutex_type& mMutex;
+	};
+
+
+
+	///////////////////////////////////////////////////////////////////////////
+	// unique_lock
+	///////////////////////////////////////////////////////////////////////////
+
+	/// unique_lock
+	///
+	/// Holds a mutex exclusively, and unlocks it upon destruction if it still
+	/// holds it. Unlike lock_guard, it can be unlocked and relocked, start out
+	/// without the lock, and be moved to another owner.
+	///
+	/// Example usage:
+	///    unique_lock<mutex> lock(gMutex, try_to_lock);
+	///
+	///    if(lock)
+	///        ...
+	///
+	template <typename Mutex>
+	class unique_lock
+	{
+	public:
+		typedef Mutex mutex_type;
+
+		unique_lock() EA_NOEXCEPT
+			: mpMutex(NULL), mbOwns(false) { }
+
+		explicit unique_lock(mutex_type& m)
+			: mpMutex(&m), mbOwns(false) { lock(); }
+
+		unique_lock(mutex_type& m, defer_lock_t) EA_NOEXCEPT
+			: mpMutex(&m), mbOwns(false) { }
+
+		unique_lock(mutex_type& m, try_to_lock_t)
+			: mpMutex(&m), mbOwns(m.try_lock()) { }
+
+		unique_lock(mutex_type& m, adopt_lock_t)
+			: mpMutex(&m), mbOwns(true) { }
+
+		unique_lock(unique_lock&& x) EA_NOEXCEPT
+			: mpMutex(x.mpMutex), mbOwns(x.mbOwns)
+		{
+			x.mpMutex = NULL;
+			x.mbOwns  = false;
+		}
+
+	   ~unique_lock()
+		{
+			if(mbOwns)
+				mpMutex->unlock();
+		}
+
+		unique_lock& operator=(unique_lock&& x) EA_NOEXCEPT
+		{
+			unique_lock(std::move(x)).swap(*this);
+			return *this;
+		}
+
+		unique_lock(const unique_lock&) = delete;
+		unique_lock& operator=(const unique_lock&) = delete;
+
+		void lock()
+		{
+			EASTL_ASSERT(mpMutex && !mbOwns);
+			mpMutex->lock();
+			mbOwns = true;
+		}
+
+		bool try_lock()
+		{
+			EASTL_ASSERT(mpMutex && !mbOwns);
+			return (mbOwns = mpMutex->try_lock());
+		}
+
+		void unlock()
+		{
+			EASTL_ASSERT(mbOwns);
+			mpMutex->unlock();
+			mbOwns = false;
+		}
+
+		void swap(unique_lock& x) EA_NOEXCEPT
+		{
+			std::swap(mpMutex, x.mpMutex);
+			std::swap(mbOwns, x.mbOwns);
+		}
+
+		/// Disassociates the lock from its mutex without unlocking it, and returns the mutex.
+		mutex_type* release() EA_NOEXCEPT
+		{
+			mutex_type* const pMutex = mpMutex;
+			mpMutex = NULL;
+			mbOwns  = false;
+			return pMutex;
+		}
+
+		bool        owns_lock() const EA_NOEXCEPT         { return mbOwns; }
+		explicit    operator bool() const EA_NOEXCEPT     { return mbOwns; }
+		mutex_type* mutex() const EA_NOEXCEPT             { return mpMutex; }
+
+	protected:
+		mutex_type* mpMutex;
+		bool        mbOwns;
+	};
+
+	template <typename Mutex>
+	inline void swap(unique_lock<Mutex>& a, unique_lock<Mutex>& b) EA_NOEXCEPT
+	{
+		a.swap(b);
+	}
+
+} // namespace std
+
+
+#endif // Header include guard
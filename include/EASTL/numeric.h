@@ -57,6 +57,68 @@ namespace std
 	}
 
 
+	/// reduce
+	///
+	/// Like accumulate, except that the elements may be combined in any order and
+	/// grouping, which is what allows the parallel versions of reduce (see execution.h)
+	/// to split the range. binary_op must thus be associative and commutative for
+	/// the result to be deterministic. The serial versions process the values in order.
+	///
+	template <typename InputIterator, typename T, typename BinaryOperation>
+	T reduce(InputIterator first, InputIterator last, T init, BinaryOperation binary_op)
+	{
+		for(; first != last; ++first)
+			init = binary_op(init, *first);
+		return init;
+	}
+
+	template <typename InputIterator, typename T>
+	T reduce(InputIterator first, InputIterator last, T init)
+	{
+		return std::accumulate(first, last, init);
+	}
+
+	template <typename InputIterator>
+	typename iterator_traits<InputIterator>::value_type
+	reduce(InputIterator first, InputIterator last)
+	{
+		return std::accumulate(first, last, typename iterator_traits<InputIterator>::value_type());
+	}
+
+
+	/// transform_reduce
+	///
+	/// Applies unary_op to each element of [first, last), or binary_transform_op to
+	/// the elements of two ranges pairwise, and reduces the results together with
+	/// init using binary_op. As with reduce, the parallel versions may apply binary_op
+	/// in any order and grouping. The version without operations computes an inner product.
+	///
+	template <typename InputIterator, typename T, typename BinaryOperation, typename UnaryOperation>
+	T transform_reduce(InputIterator first, InputIterator last, T init, BinaryOperation binary_op, UnaryOperation unary_op)
+	{
+		for(; first != last; ++first)
+			init = binary_op(init, unary_op(*first));
+		return init;
+	}
+
+	template <typename InputIterator1, typename InputIterator2, typename T, typename BinaryOperation, typename BinaryTransformOperation>
+	T transform_reduce(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, T init, 
+	                   BinaryOperation binary_op, BinaryTransformOperation binary_transform_op)
+	{
+		for(; first1 != last1; ++first1, ++first2)
+			init = binary_op(init, binary_transform_op(*first1, *first2));
+		return init;
+	}
+
+	template <typename InputIterator1, typename InputIterator2, typename T>
+	T transform_reduce(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, T init)
+	{
+		for(; first1 != last1; ++first1, ++first2)
+			init += (*first1 * *first2); // See inner_product for why we use += instead of +.
+		return init;
+	}
+
+
 
 	/// iota
 	///
@@ -0,0 +1,611 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements sorting algorithms which run on a thread_pool:
+//    parallel_sort         -- Unstable.    A sample sort.
+//    parallel_stable_sort  -- Stable.      A merge sort with a buffer and parallel merges.
+//    parallel_radix_sort   -- Stable.      A radix sort which distributes by the most significant digit first.
+//
+// The first two call the serial sort (or stable_sort) for ranges of up to
+// EASTL_PARALLEL_SORT_THRESHOLD elements and on pools without workers, and
+// parallel_radix_sort calls radix_sort for ranges of up to
+// EASTL_PARALLEL_RADIX_SORT_THRESHOLD elements.
+// The execution::par overloads of sort and stable_sort in execution.h map
+// to these functions.
+//
+// Like merge_sort, both allocate a buffer of (last - first) default
+// constructed elements, and thus require the value type to be default
+// constructible and move assignable. The comparison must not throw exceptions.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_PARALLEL_SORT_H
+#define EASTL_PARALLEL_SORT_H
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/thread_pool.h>
+#include <EASTL/sort.h>
+#include <EASTL/vector.h>
+#include <EASTL/iterator.h>
+
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// EASTL_PARALLEL_SORT_THRESHOLD
+//
+// The size below which parallel_sort and parallel_stable_sort call the
+// serial sort. Also the smallest size of the pieces the range is split into.
+//
+#ifndef EASTL_PARALLEL_SORT_THRESHOLD
+	#define EASTL_PARALLEL_SORT_THRESHOLD 16384
+#endif
+
+
+///////////////////////////////////////////////////////////////////////////////
+// EASTL_PARALLEL_SORT_BUCKETS_PER_THREAD
+//
+// The number of buckets per thread parallel_sort distributes elements into,
+// and the number of runs per thread parallel_stable_sort starts merging from.
+// More than one per thread evens out the load when buckets differ in size.
+//
+#ifndef EASTL_PARALLEL_SORT_BUCKETS_PER_THREAD
+	#define EASTL_PARALLEL_SORT_BUCKETS_PER_THREAD 4
+#endif
+
+
+///////////////////////////////////////////////////////////////////////////////
+// EASTL_PARALLEL_RADIX_SORT_THRESHOLD
+//
+// The size below which parallel_radix_sort calls the serial radix_sort.
+// It is larger than EASTL_PARALLEL_SORT_THRESHOLD because radix_sort is
+// fast enough that smaller ranges don't repay the extra distribution pass.
+//
+#ifndef EASTL_PARALLEL_RADIX_SORT_THRESHOLD
+	#define EASTL_PARALLEL_RADIX_SORT_THRESHOLD 262144
+#endif
+
+
+
+namespace std
+{
+	namespace Internal
+	{
+		// The number of sample elements taken per bucket to choose splitters.
+		const size_t kParallelSortOversampling = 16;
+
+		// The bucket index of each element is stored in a uint16_t.
+		const size_t kParallelSortMaxBucketCount = 4096;
+
+		// The smallest threshold honored, which guarantees the sample is smaller than the range.
+		const size_t kParallelSortMinThreshold = 64;
+
+
+		// parallel_sort_bucket_count
+		//
+		// Returns the number of pieces (buckets or runs) to split n elements into.
+		//
+		inline size_t parallel_sort_bucket_count(const thread_pool& pool, size_t n, size_t nThreshold)
+		{
+			size_t nCount = pool.concurrency() * EASTL_PARALLEL_SORT_BUCKETS_PER_THREAD;
+
+			if(nCount > (n / (nThreshold / 4 + 1)))
+				nCount = (n / (nThreshold / 4 + 1));
+			if(nCount > kParallelSortMaxBucketCount)
+				nCount = kParallelSortMaxBucketCount;
+
+			return (nCount < 2) ? 2 : nCount;
+		}
+
+
+		// parallel_sort_classify
+		//
+		// Returns the bucket of value given the sorted splitters. Bucket 2i holds
+		// the elements between splitter i-1 and splitter i, and bucket 2i+1 holds
+		// the elements equal to splitter i. The latter need no sorting, which
+		// keeps inputs with many duplicates from collapsing into one large bucket.
+		//
+		template <typename T, typename Compare>
+		inline size_t parallel_sort_classify(const T* pSplitters, size_t nSplitterCount, const T& value, Compare& compare)
+		{
+			const size_t i = (size_t)(std::lower_bound(pSplitters, pSplitters + nSplitterCount, value, compare) - pSplitters);
+
+			return ((i < nSplitterCount) && !compare(value, pSplitters[i])) ? (2 * i + 1) : (2 * i);
+		}
+
+
+		template <typename RandomAccessIterator, typename Compare>
+		void parallel_sort_impl(thread_pool& pool, RandomAccessIterator first, RandomAccessIterator last, Compare compare, size_t nThreshold)
+		{
+			typedef typename std::iterator_traits<RandomAccessIterator>::value_type value_type;
+
+			const size_t n = (size_t)(last - first);
+
+			if(nThreshold < kParallelSortMinThreshold)
+				nThreshold = kParallelSortMinThreshold;
+
+			if((n <= nThreshold) || (pool.worker_count() == 0))
+			{
+				std::sort<RandomAccessIterator, Compare>(first, last, compare);
+				return;
+			}
+
+			// Choose splitters from a sorted sample. The sample positions are spread
+			// evenly over the range with some jitter, so that periodic inputs don't
+			// produce a skewed sample.
+			const size_t nBucketCount  = parallel_sort_bucket_count(pool, n, nThreshold);
+			const size_t nSampleCount  = nBucketCount * kParallelSortOversampling;
+			const size_t nSplitterCount = nBucketCount - 1;
+			const size_t nSlotCount     = 2 * nSplitterCount + 1;
+
+			std::vector<value_type> splitters;
+			{
+				std::vector<value_type> sample;
+				sample.reserve(nSampleCount);
+
+				uint32_t nRandom = 0x9e3779b9;
+				for(size_t i = 0; i < nSampleCount; i++)
+				{
+					nRandom = (nRandom * 1664525) + 1013904223;
+					const size_t nStride = n / nSampleCount;
+					sample.push_back(first[(i * nStride) + ((nRandom >> 8) % nStride)]);
+				}
+
+				std::sort(sample.begin(), sample.end(), compare);
+
+				splitters.reserve(nSplitterCount);
+				for(size_t i = 1; i < nBucketCount; i++)
+					splitters.push_back(sample[i * kParallelSortOversampling]);
+			}
+
+			// Classify each block of elements, recording the bucket of each element and
+			// the size of each bucket within each block.
+			const size_t      nBlockCount = nBucketCount;
+			const value_type* pSplitters  = splitters.data();
+			std::vector<uint16_t> bucketIndexes(n);
+			std::vector<size_t>   blockCounts(nBlockCount * nSlotCount, 0);
+
+			pool.parallel_for(nBlockCount, 1, [&](size_t nBlockBegin, size_t nBlockEnd)
+			{
+				for(size_t b = nBlockBegin; b < nBlockEnd; b++)
+				{
+					size_t* const pCounts = &blockCounts[b * nSlotCount];
+					Compare       blockCompare(compare);
+
+					for(size_t i = (b * n) / nBlockCount, iEnd = ((b + 1) * n) / nBlockCount; i < iEnd; i++)
+					{
+						const size_t nSlot = parallel_sort_classify(pSplitters, nSplitterCount, first[i], blockCompare);
+						bucketIndexes[i] = (uint16_t)nSlot;
+						pCounts[nSlot]++;
+					}
+				}
+			});
+
+			// Turn the counts into the position each block writes each bucket's elements to.
+			std::vector<size_t> bucketBegin(nSlotCount + 1);
+
+			for(size_t s = 0, nPosition = 0; s < nSlotCount; s++)
+			{
+				bucketBegin[s] = nPosition;
+
+				for(size_t b = 0; b < nBlockCount; b++)
+				{
+					const size_t nCount = blockCounts[(b * nSlotCount) + s];
+					blockCounts[(b * nSlotCount) + s] = nPosition;
+					nPosition += nCount;
+				}
+			}
+			bucketBegin[nSlotCount] = n;
+
+			// Distribute the elements into the buffer, then sort each bucket and move it back.
+			std::vector<value_type> buffer(n);
+			value_type* const pBuffer = buffer.data();
+
+			pool.parallel_for(nBlockCount, 1, [&](size_t nBlockBegin, size_t nBlockEnd)
+			{
+				for(size_t b = nBlockBegin; b < nBlockEnd; b++)
+				{
+					size_t* const pPositions = &blockCounts[b * nSlotCount];
+
+					for(size_t i = (b * n) / nBlockCount, iEnd = ((b + 1) * n) / nBlockCount; i < iEnd; i++)
+						pBuffer[pPositions[bucketIndexes[i]]++] = std::move(first[i]);
+				}
+			});
+
+			pool.parallel_for(nSlotCount, 1, [&](size_t nSlotBegin, size_t nSlotEnd)
+			{
+				for(size_t s = nSlotBegin; s < nSlotEnd; s++)
+				{
+					value_type* const pBegin = pBuffer + bucketBegin[s];
+					value_type* const pEnd   = pBuffer + bucketBegin[s + 1];
+
+					if((s & 1) == 0) // Odd buckets hold elements equal to a splitter.
+						std::sort<value_type*, Compare>(pBegin, pEnd, compare);
+
+					std::move(pBegin, pEnd, first + bucketBegin[s]);
+				}
+			});
+		}
+
+
+		// parallel_merge_split
+		//
+		// Returns the number of elements of [pFirst1, pFirst1 + n1) among the first
+		// k elements of the stable merge of it with [pFirst2, pFirst2 + n2).
+		//
+		template <typename RandomAccessIterator, typename Compare>
+		size_t parallel_merge_split(RandomAccessIterator first1, size_t n1, RandomAccessIterator first2, size_t n2, size_t k, Compare& compare)
+		{
+			size_t nLow  = (k > n2) ? (k - n2) : 0;
+			size_t nHigh = (k < n1) ? k : n1;
+
+			while(nLow < nHigh)
+			{
+				const size_t nMid = nLow + ((nHigh - nLow) / 2);
+
+				if(compare(first2[k - nMid - 1], first1[nMid]))
+					nHigh = nMid;
+				else
+					nLow = nMid + 1;
+			}
+
+			return nLow;
+		}
+
+
+		// parallel_merge_split_at
+		//
+		// Returns parallel_merge_split for output position nPosition of a merge pass
+		// which merges pairs of adjacent sorted runs of nWidth elements.
+		//
+		template <typename RandomAccessIterator, typename Compare>
+		size_t parallel_merge_split_at(RandomAccessIterator source, size_t n, size_t nWidth, size_t nPosition, Compare& compare)
+		{
+			const size_t nPair    = nPosition - (nPosition % (2 * nWidth));
+			const size_t nMid     = ((n - nPair) > nWidth)       ? (nPair + nWidth)       : n;
+			const size_t nPairEnd = ((n - nPair) > (2 * nWidth)) ? (nPair + (2 * nWidth)) : n;
+
+			return parallel_merge_split(source + nPair, nMid - nPair, source + nMid, nPairEnd - nMid, nPosition - nPair, compare);
+		}
+
+
+		// parallel_merge_pass
+		//
+		// Merges the pairs of adjacent sorted runs of nWidth elements in [source, source + n)
+		// into dest. The output is divided into pieces of nPieceSize elements regardless of
+		// the run width, so that even the final merge of two runs uses every thread. pSplits
+		// must have room for one more than the number of pieces.
+		//
+		template <typename InputIterator, typename OutputIterator, typename Compare>
+		void parallel_merge_pass(thread_pool& pool, InputIterator source, OutputIterator dest, size_t n, size_t nWidth,
+		                         size_t nPieceSize, size_t* pSplits, Compare& compare)
+		{
+			const size_t nPieceCount = (n + nPieceSize - 1) / nPieceSize;
+
+			// Find where every piece begins before moving any elements, as moving
+			// an element may change the value left behind in the source.
+			pool.parallel_for(nPieceCount + 1, 1, [&](size_t nPieceBegin, size_t nPieceEnd)
+			{
+				Compare pieceCompare(compare);
+
+				for(size_t p = nPieceBegin; p < nPieceEnd; p++)
+				{
+					const size_t nPosition = p * nPieceSize;
+					pSplits[p] = parallel_merge_split_at(source, n, nWidth, (nPosition < n) ? nPosition : n, pieceCompare);
+				}
+			});
+
+			pool.parallel_for(nPieceCount, 1, [&](size_t nPieceBegin, size_t nPieceEnd)
+			{
+				for(size_t p = nPieceBegin; p < nPieceEnd; p++)
+				{
+					const size_t nBegin = p * nPieceSize;
+					const size_t nEnd   = ((n - nBegin) > nPieceSize) ? (nBegin + nPieceSize) : n;
+
+					for(size_t nPair = nBegin - (nBegin % (2 * nWidth)); nPair < nEnd; nPair += (2 * nWidth))
+					{
+						const size_t nMid     = ((n - nPair) > nWidth)       ? (nPair + nWidth)       : n;
+						const size_t nPairEnd = ((n - nPair) > (2 * nWidth)) ? (nPair + (2 * nWidth)) : n;
+						const size_t k0       = (nBegin > nPair)  ? (nBegin - nPair)  : 0;
+						const size_t i0       = (nBegin > nPair)  ? pSplits[p]        : 0;
+						const size_t k1       = (nEnd < nPairEnd) ? (nEnd - nPair)    : (nPairEnd - nPair);
+						const size_t i1       = (nEnd < nPairEnd) ? pSplits[p + 1]    : (nMid - nPair);
+
+						const InputIterator first1 = source + nPair;
+						const InputIterator first2 = source + nMid;
+
+						std::merge(std::make_move_iterator(first1 + i0),        std::make_move_iterator(first1 + i1),
+						           std::make_move_iterator(first2 + (k0 - i0)), std::make_move_iterator(first2 + (k1 - i1)),
+						           dest + (nPair + k0), compare);
+					}
+				}
+			});
+		}
+
+
+		template <typename RandomAccessIterator, typename Compare>
+		void parallel_stable_sort_impl(thread_pool& pool, RandomAccessIterator first, RandomAccessIterator last, Compare compare, size_t nThreshold)
+		{
+			typedef typename std::iterator_traits<RandomAccessIterator>::value_type value_type;
+
+			const size_t n = (size_t)(last - first);
+
+			if(nThreshold < kParallelSortMinThreshold)
+				nThreshold = kParallelSortMinThreshold;
+
+			if((n <= nThreshold) || (pool.worker_count() == 0))
+			{
+				std::stable_sort<RandomAccessIterator, Compare>(first, last, compare);
+				return;
+			}
+
+			// Sort runs of nWidth elements in parallel, using the buffer as scratch space.
+			size_t nRunCount = 1;
+			while(nRunCount < parallel_sort_bucket_count(pool, n, nThreshold))
+				nRunCount *= 2;
+
+			const size_t nWidth = (n + nRunCount - 1) / nRunCount;
+			const size_t nGrainSize = (n / (pool.concurrency() * EASTL_PARALLEL_SORT_BUCKETS_PER_THREAD)) + 1;
+
+			std::vector<value_type> buffer(n);
+			value_type* const pBuffer = buffer.data();
+
+			pool.parallel_for(nRunCount, 1, [&](size_t nRunBegin, size_t nRunEnd)
+			{
+				for(size_t r = nRunBegin; r < nRunEnd; r++)
+				{
+					const size_t nBegin = r * nWidth;
+					const size_t nEnd   = ((n - nBegin) > nWidth) ? (nBegin + nWidth) : n;
+
+					if(nBegin < nEnd)
+						std::merge_sort_buffer<RandomAccessIterator, value_type, Compare>(first + nBegin, first + nEnd, pBuffer + nBegin, compare);
+				}
+			});
+
+			// Merge pairs of runs, alternating between the range and the buffer.
+			std::vector<size_t> splits(((n + nGrainSize - 1) / nGrainSize) + 1);
+			bool bInBuffer = false;
+
+			for(size_t w = nWidth; w < n; w *= 2, bInBuffer = !bInBuffer)
+			{
+				if(bInBuffer)
+					parallel_merge_pass(pool, pBuffer, first, n, w, nGrainSize, splits.data(), compare);
+				else
+					parallel_merge_pass(pool, first, pBuffer, n, w, nGrainSize, splits.data(), compare);
+			}
+
+			if(bInBuffer)
+			{
+				pool.parallel_for(n, nGrainSize, [&](size_t nBegin, size_t nEnd)
+					{ std::move(pBuffer + nBegin, pBuffer + nEnd, first + nBegin); });
+			}
+		}
+
+
+		template <typename RandomAccessIterator, typename ExtractKey>
+		void parallel_radix_sort_impl(thread_pool& pool, RandomAccessIterator first, RandomAccessIterator last, RandomAccessIterator buffer, ExtractKey extractKey)
+		{
+			typedef radix_sort_elements<RandomAccessIterator, ExtractKey> storage_type;
+			typedef typename storage_type::traits_type                    traits_type;
+			typedef typename storage_type::unsigned_type                  unsigned_type;
+
+			const int    kKeyBits     = (int)(sizeof(unsigned_type) * 8);
+			const int    kDigitBits   = (sizeof(unsigned_type) >= 4) ? 11 : 8;
+			const size_t kBucketCount = (size_t)1 << kDigitBits;
+			const size_t n            = (size_t)(last - first);
+
+			if((n <= EASTL_PARALLEL_RADIX_SORT_THRESHOLD) || (pool.worker_count() == 0))
+			{
+				std::radix_sort<RandomAccessIterator, ExtractKey>(first, last, buffer, extractKey);
+				return;
+			}
+
+			const size_t nBlockCount = pool.concurrency() * EASTL_PARALLEL_SORT_BUCKETS_PER_THREAD;
+
+			// Find the highest bit in which keys differ. The digit distributed by is the one
+			// ending at that bit rather than the top digit of the key, so that keys which share
+			// their high bits, like timestamps from a short period, still spread over the buckets.
+			std::vector<unsigned_type> blockDifferences(nBlockCount);
+			const unsigned_type firstKey = traits_type::encode(extractKey(*first));
+
+			pool.parallel_for(nBlockCount, 1, [&](size_t nBlockBegin, size_t nBlockEnd)
+			{
+				for(size_t b = nBlockBegin; b < nBlockEnd; b++)
+				{
+					ExtractKey    blockExtractKey(extractKey);
+					unsigned_type nDifference = 0;
+
+					for(size_t i = (b * n) / nBlockCount, iEnd = ((b + 1) * n) / nBlockCount; i < iEnd; i++)
+						nDifference |= (unsigned_type)(traits_type::encode(blockExtractKey(first[i])) ^ firstKey);
+
+					blockDifferences[b] = nDifference;
+				}
+			});
+
+			unsigned_type nDifference = 0;
+			for(size_t b = 0; b < nBlockCount; b++)
+				nDifference |= blockDifferences[b];
+
+			int nKeyBits = 0;
+			while((nKeyBits < kKeyBits) && ((nDifference >> nKeyBits) != 0))
+				nKeyBits++;
+
+			if(nKeyBits == 0)
+				return; // All keys are equal.
+
+			const int nShift = (nKeyBits > kDigitBits) ? (nKeyBits - kDigitBits) : 0;
+
+			// Count the elements of each block per bucket, then turn the counts into
+			// the position each block writes each bucket's elements to.
+			std::vector<size_t> blockPositions(nBlockCount * kBucketCount, 0);
+
+			pool.parallel_for(nBlockCount, 1, [&](size_t nBlockBegin, size_t nBlockEnd)
+			{
+				for(size_t b = nBlockBegin; b < nBlockEnd; b++)
+				{
+					ExtractKey    blockExtractKey(extractKey);
+					size_t* const pCounts = &blockPositions[b * kBucketCount];
+
+					for(size_t i = (b * n) / nBlockCount, iEnd = ((b + 1) * n) / nBlockCount; i < iEnd; i++)
+						pCounts[(size_t)(traits_type::encode(blockExtractKey(first[i])) >> nShift) & (kBucketCount - 1)]++;
+				}
+			});
+
+			std::vector<size_t> bucketBegin(kBucketCount + 1);
+
+			for(size_t s = 0, nPosition = 0; s < kBucketCount; s++)
+			{
+				bucketBegin[s] = nPosition;
+
+				for(size_t b = 0; b < nBlockCount; b++)
+				{
+					const size_t nCount = blockPositions[(b * kBucketCount) + s];
+					blockPositions[(b * kBucketCount) + s] = nPosition;
+					nPosition += nCount;
+				}
+			}
+			bucketBegin[kBucketCount] = n;
+
+			// Distribute the elements into the buffer. Each block's elements stay in order within each bucket.
+			pool.parallel_for(nBlockCount, 1, [&](size_t nBlockBegin, size_t nBlockEnd)
+			{
+				for(size_t b = nBlockBegin; b < nBlockEnd; b++)
+				{
+					ExtractKey    blockExtractKey(extractKey);
+					size_t* const pPositions = &blockPositions[b * kBucketCount];
+
+					for(size_t i = (b * n) / nBlockCount, iEnd = ((b + 1) * n) / nBlockCount; i < iEnd; i++)
+					{
+						const size_t nBucket = (size_t)(traits_type::encode(blockExtractKey(first[i])) >> nShift) & (kBucketCount - 1);
+						buffer[pPositions[nBucket]++] = std::move(first[i]);
+					}
+				}
+			});
+
+			// Sort each bucket by the bits below the distributed digit, if any, with the range
+			// as its buffer, and move it back unless the sort left it there.
+			pool.parallel_for(kBucketCount, 1, [&](size_t nBucketBegin, size_t nBucketEnd)
+			{
+				for(size_t s = nBucketBegin; s < nBucketEnd; s++)
+				{
+					const size_t nBegin = bucketBegin[s];
+					const size_t nEnd   = bucketBegin[s + 1];
+					storage_type storage(buffer + nBegin, first + nBegin, extractKey);
+
+					if((nShift == 0) || !radix_sort_adaptive(storage, nEnd - nBegin, nShift))
+						std::move(buffer + nBegin, buffer + nEnd, first + nBegin);
+				}
+			});
+		}
+
+	} // namespace Internal
+
+
+
+	/// parallel_sort
+	///
+	/// Sorts [first, last) on the given thread_pool, or on thread_pool::get_default().
+	/// This is a sample sort: a sorted sample of the range selects splitters, every
+	/// element is moved into the bucket between its two splitters, and then the
+	/// buckets are sorted in parallel. The sort is not stable.
+	///
+	/// Example usage:
+	///    vector<Record> records;
+	///    parallel_sort(records.begin(), records.end(), RecordLess());
+	///
+	template <typename RandomAccessIterator, typename Compare>
+	inline void parallel_sort(thread_pool& pool, RandomAccessIterator first, RandomAccessIterator last, Compare compare)
+	{
+		Internal::parallel_sort_impl<RandomAccessIterator, Compare>(pool, first, last, compare, EASTL_PARALLEL_SORT_THRESHOLD);
+	}
+
+	template <typename RandomAccessIterator, typename Compare>
+	inline void parallel_sort(RandomAccessIterator first, RandomAccessIterator last, Compare compare)
+	{
+		Internal::parallel_sort_impl<RandomAccessIterator, Compare>(thread_pool::get_default(), first, last, compare, EASTL_PARALLEL_SORT_THRESHOLD);
+	}
+
+	template <typename RandomAccessIterator>
+	inline void parallel_sort(RandomAccessIterator first, RandomAccessIterator last)
+	{
+		typedef std::less<typename std::iterator_traits<RandomAccessIterator>::value_type> Less;
+
+		Internal::parallel_sort_impl<RandomAccessIterator, Less>(thread_pool::get_default(), first, last, Less(), EASTL_PARALLEL_SORT_THRESHOLD);
+	}
+
+
+
+	/// parallel_stable_sort
+	///
+	/// Stably sorts [first, last) on the given thread_pool, or on thread_pool::get_default().
+	/// The range is divided into runs which are merge sorted in parallel, after which
+	/// pairs of runs are merged. Each merge is divided between threads by binary
+	/// searching for the split points of equal-sized pieces of its output.
+	///
+	template <typename RandomAccessIterator, typename Compare>
+	inline void parallel_stable_sort(thread_pool& pool, RandomAccessIterator first, RandomAccessIterator last, Compare compare)
+	{
+		Internal::parallel_stable_sort_impl<RandomAccessIterator, Compare>(pool, first, last, compare, EASTL_PARALLEL_SORT_THRESHOLD);
+	}
+
+	template <typename RandomAccessIterator, typename Compare>
+	inline void parallel_stable_sort(RandomAccessIterator first, RandomAccessIterator last, Compare compare)
+	{
+		Internal::parallel_stable_sort_impl<RandomAccessIterator, Compare>(thread_pool::get_default(), first, last, compare, EASTL_PARALLEL_SORT_THRESHOLD);
+	}
+
+	template <typename RandomAccessIterator>
+	inline void parallel_stable_sort(RandomAccessIterator first, RandomAccessIterator last)
+	{
+		typedef std::less<typename std::iterator_traits<RandomAccessIterator>::value_type> Less;
+
+		Internal::parallel_stable_sort_impl<RandomAccessIterator, Less>(thread_pool::get_default(), first, last, Less(), EASTL_PARALLEL_SORT_THRESHOLD);
+	}
+
+
+	/// parallel_radix_sort
+	///
+	/// Stably sorts [first, last) by the keys extractKey returns, like radix_sort, on the
+	/// given thread_pool or on thread_pool::get_default(). buffer is scratch space of
+	/// (last - first) elements. The elements are first distributed by their most significant
+	/// digit, counting and moving the elements of each block of the range in parallel,
+	/// after which each bucket is radix sorted from the least significant digit on its own.
+	///
+	/// The digit distributed by ends at the highest bit in which any two keys differ,
+	/// so keys which share their high bits still spread over all buckets. Ranges with
+	/// few distinct values in that digit sort mostly serially.
+	///
+	/// Example usage:
+	///    vector<Sample> samples, buffer(samples.size());
+	///    parallel_radix_sort(samples.begin(), samples.end(), buffer.begin(), [](const Sample& s) { return s.mTimestamp; });
+	///
+	template <typename RandomAccessIterator, typename ExtractKey>
+	inline void parallel_radix_sort(thread_pool& pool, RandomAccessIterator first, RandomAccessIterator last, RandomAccessIterator buffer, ExtractKey extractKey)
+	{
+		Internal::parallel_radix_sort_impl<RandomAccessIterator, ExtractKey>(pool, first, last, buffer, extractKey);
+	}
+
+	template <typename RandomAccessIterator, typename ExtractKey>
+	inline void parallel_radix_sort(RandomAccessIterator first, RandomAccessIterator last, RandomAccessIterator buffer, ExtractKey extractKey)
+	{
+		Internal::parallel_radix_sort_impl<RandomAccessIterator, ExtractKey>(thread_pool::get_default(), first, last, buffer, extractKey);
+	}
+
+	template <typename RandomAccessIterator>
+	inline void parallel_radix_sort(RandomAccessIterator first, RandomAccessIterator last, RandomAccessIterator buffer)
+	{
+		typedef Internal::radix_identity_key<typename std::iterator_traits<RandomAccessIterator>::value_type> ExtractKey;
+
+		Internal::parallel_radix_sort_impl<RandomAccessIterator, ExtractKey>(thread_pool::get_default(), first, last, buffer, ExtractKey());
+	}
+
+} // namespace std
+
+
+#endif // Header include guard
@@ -0,0 +1,252 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements the following
+//     rcu_domain
+//     rcu_default_domain
+//     rcu_obj_base
+//     rcu_retire
+//     rcu_synchronize
+//     rcu_barrier
+//
+// This follows the C++26 standard library's <rcu>, which it implements with
+// epoch-based reclamation.
+//
+// http://en.cppreference.com/w/cpp/header/rcu
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_RCU_H
+#define EASTL_RCU_H
+
+
+#include <EABase/eabase.h>
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once
+#endif
+
+#include <EASTL/internal/config.h>
+#include <EASTL/internal/retired_node.h>
+#include <EASTL/internal/smart_ptr.h>
+#include <EASTL/allocator.h>
+#include <EASTL/utility.h>
+#include <new>
+
+
+///////////////////////////////////////////////////////////////////////////////
+// EASTL_RCU_RETIRE_BATCH_SIZE
+//
+// The number of objects a thread retires between attempts to advance the
+// epoch. Each attempt reads every thread's state, so larger batches make
+// retiring cheaper, at the cost of more objects awaiting reclamation.
+//
+#ifndef EASTL_RCU_RETIRE_BATCH_SIZE
+	#define EASTL_RCU_RETIRE_BATCH_SIZE 64
+#endif
+
+
+
+namespace std
+{
+
+	/// EASTL_RCU_DEFAULT_NAME
+	///
+	/// Defines a default allocator name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_RCU_DEFAULT_NAME
+		#define EASTL_RCU_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " rcu" // Unless the user overrides something, this is "EASTL rcu".
+	#endif
+
+
+	namespace Internal
+	{
+		EASTL_API void rcu_retire(retired_node* pNode) EA_NOEXCEPT;
+
+
+		/// rcu_retired_pointer
+		///
+		/// The record which rcu_retire allocates for an object which doesn't derive
+		/// from rcu_obj_base, and frees again when it reclaims the object.
+		///
+		template <typename T, typename D>
+		struct rcu_retired_pointer
+		{
+			retired_node mNode; // Must be first, so that Reclaim can find the record.
+			D            mDeleter;
+
+			rcu_retired_pointer(T* p, D&& deleter)
+				: mDeleter(std::move(deleter))
+			{
+				mNode.mpNext    = NULL;
+				mNode.mpReclaim = &Reclaim;
+				mNode.mpObject  = p;
+			}
+
+			static void Reclaim(retired_node* pNode)
+			{
+				rcu_retired_pointer* const pRecord = reinterpret_cast<rcu_retired_pointer*>(pNode);
+				T* const p = static_cast<T*>(const_cast<void*>(pNode->mpObject));
+				D deleter(std::move(pRecord->mDeleter));
+
+				pRecord->~rcu_retired_pointer();
+
+				EASTLAllocatorType allocator(EASTL_RCU_DEFAULT_NAME);
+				EASTLFree(allocator, pRecord, sizeof(rcu_retired_pointer));
+
+				deleter(p);
+			}
+		};
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////////
+	// rcu_domain
+	///////////////////////////////////////////////////////////////////////////
+
+	class rcu_domain;
+
+	EASTL_API rcu_domain& rcu_default_domain() EA_NOEXCEPT;
+
+
+	/// rcu_domain
+	///
+	/// Lets threads read shared structures with no locking beyond marking their
+	/// critical sections with lock and unlock (e.g. through lock_guard), while
+	/// other threads unlink objects from the structures and retire them. A retired
+	/// object is deleted once every critical section which might have found it
+	/// has ended. Like hazard pointers, this allows lock-free structures which
+	/// free their nodes; unlike them, readers protect any number of objects at
+	/// once, so it suits structures which readers traverse, such as maps.
+	///
+	/// The domain keeps a global epoch and each thread a record of the epoch it
+	/// entered its critical section in, if any (K. Fraser, "Practical Lock-Freedom").
+	/// lock stores the global epoch to the thread's record, and unlock clears it,
+	/// so neither writes to memory shared with other readers. A thread can advance
+	/// the epoch once every thread in a critical section entered it in the current
+	/// epoch, after which no critical section from before the previous advance
+	/// remains, and objects retired before then can be deleted.
+	///
+	/// Each thread keeps the objects it retires in lists by epoch, and every
+	/// EASTL_RCU_RETIRE_BATCH_SIZE objects tries to advance the epoch and frees
+	/// the lists which have become safe in one batch. Retiring therefore touches
+	/// no shared memory most of the time. A thread's remaining objects are handed
+	/// over to other threads when it exits. A critical section which doesn't end
+	/// holds back the reclamation of every thread's retired objects, so critical
+	/// sections should be short and should not block.
+	///
+	/// Only the default domain exists; rcu_default_domain returns it.
+	///
+	/// Example usage:
+	///    struct Config : public rcu_obj_base<Config> { ... };
+	///    atomic<Config*> gpConfig;
+	///
+	///    {                                                       // A reader.
+	///        lock_guard<rcu_domain> lock(rcu_default_domain());
+	///        Use(*gpConfig.load(memory_order_acquire));
+	///    }
+	///
+	///    gpConfig.exchange(pNewConfig)->retire();                // A writer.
+	///
+	class rcu_domain
+	{
+	public:
+		rcu_domain(const rcu_domain&) = delete;
+		rcu_domain& operator=(const rcu_domain&) = delete;
+
+		/// Enters a critical section. Critical sections may nest.
+		EASTL_API void lock() EA_NOEXCEPT;
+
+		bool try_lock() EA_NOEXCEPT
+			{ lock(); return true; }
+
+		/// Leaves a critical section entered by lock on the same thread.
+		EASTL_API void unlock() EA_NOEXCEPT;
+
+	protected:
+		friend EASTL_API rcu_domain& rcu_default_domain() EA_NOEXCEPT;
+
+		EA_CONSTEXPR rcu_domain() EA_NOEXCEPT { }
+	};
+
+
+
+	///////////////////////////////////////////////////////////////////////////
+	// rcu_obj_base
+	///////////////////////////////////////////////////////////////////////////
+
+	/// rcu_obj_base
+	///
+	/// The base of objects which can be retired without rcu_retire allocating a
+	/// record for them. T must derive from rcu_obj_base<T, D> publicly. With
+	/// D = allocator_delete<T, Allocator> the object is returned to its allocator,
+	/// e.g. the node pool of a container.
+	///
+	template <typename T, typename D = default_delete<T> >
+	class rcu_obj_base : public Internal::retired_object_base<T, D>
+	{
+	public:
+		/// retire
+		///
+		/// Retires the object, which must have been unlinked from everything that
+		/// critical sections find objects through, and must not be retired more
+		/// than once. It is deleted with d by a later call to retire, rcu_retire or
+		/// rcu_barrier, on this or another thread.
+		///
+		void retire(D d = D(), rcu_domain& = rcu_default_domain()) EA_NOEXCEPT
+		{
+			Internal::rcu_retire(this->PrepareRetire(std::move(d)));
+		}
+
+	protected:
+		rcu_obj_base() = default;
+		rcu_obj_base(const rcu_obj_base&) = default;
+		rcu_obj_base(rcu_obj_base&&) = default;
+		rcu_obj_base& operator=(const rcu_obj_base&) = default;
+		rcu_obj_base& operator=(rcu_obj_base&&) = default;
+		~rcu_obj_base() = default;
+	};
+
+
+
+	/// rcu_retire
+	///
+	/// Retires p, to be deleted with d as rcu_obj_base::retire does. As p doesn't
+	/// hold its own record, one is allocated with the default allocator.
+	///
+	template <typename T, typename D = default_delete<T> >
+	void rcu_retire(T* p, D d = D(), rcu_domain& = rcu_default_domain())
+	{
+		typedef Internal::rcu_retired_pointer<T, D> record_type;
+
+		EASTLAllocatorType allocator(EASTL_RCU_DEFAULT_NAME);
+		void* const pMemory = EASTLAllocAligned(allocator, sizeof(record_type), EASTL_ALIGN_OF(record_type), 0);
+		record_type* const pRecord = ::new(pMemory) record_type(p, std::move(d));
+
+		Internal::rcu_retire(&pRecord->mNode);
+	}
+
+
+	/// rcu_synchronize
+	///
+	/// Waits until every critical section which was entered before the call has
+	/// ended. Must not be called from within a critical section.
+	///
+	EASTL_API void rcu_synchronize(rcu_domain& = rcu_default_domain()) EA_NOEXCEPT;
+
+
+	/// rcu_barrier
+	///
+	/// Waits as rcu_synchronize does and then deletes the objects retired by
+	/// this thread, or by threads which have exited, before the call. Useful
+	/// before tearing down an allocator which retired objects are to be returned
+	/// to. Must not be called from within a critical section.
+	///
+	EASTL_API void rcu_barrier(rcu_domain& = rcu_default_domain()) EA_NOEXCEPT;
+
+} // namespace std
+
+
+#endif // Header include guard
@@ -0,0 +1,495 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements searchers, which find the first occurrence in a range
+// of the pattern they were constructed with. A searcher precomputes what it
+// needs from the pattern once, so searching many ranges for the same pattern
+// is cheaper than calling search for each:
+//    default_searcher               -- Forward iterators. Calls search, and precomputes nothing.
+//    boyer_moore_searcher           -- Random access. Skips by the bad element and the good suffix rules.
+//    boyer_moore_horspool_searcher  -- Random access. Skips by the bad element rule only.
+//    two_way_searcher               -- Random access. Crochemore-Perrin; linear in the worst case.
+//
+// The Boyer-Moore searchers compare the pattern from its end and skip ahead
+// by up to its length, and so examine a fraction of the elements of most
+// ranges. Their bad element table is an array for elements of one byte, and
+// a hash_map of the elements of the pattern otherwise. They are O(n * m) in
+// the worst case, for periodic patterns in periodic ranges.
+//
+// two_way_searcher takes O(n + m) comparisons and constant memory whatever
+// the range, but requires an ordering of the elements.
+//
+// Searchers are used with search(first, last, searcher), or called directly,
+// which returns the matching subrange [i, i + m), or (last, last) if there is
+// none. An empty pattern matches at first. Like the C++17 searchers, these hold
+// the pattern's iterators, which must remain valid while they are used.
+//
+// Example usage:
+//     const char pattern[] = "needle";
+//     boyer_moore_searcher<const char*> searcher(pattern, pattern + 6);
+//
+//     for(eastl_size_t i = 0; i < buffers.size(); i++)
+//     {
+//         string::iterator it = search(buffers[i].begin(), buffers[i].end(), searcher);
+//         ...
+//     }
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_SEARCHER_H
+#define EASTL_SEARCHER_H
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/algorithm.h>
+#include <EASTL/functional.h>
+#include <EASTL/hash_map.h>
+#include <EASTL/iterator.h>
+#include <EASTL/utility.h>
+#include <EASTL/vector.h>
+
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace std
+{
+	namespace Internal
+	{
+		/// searcher_skip_table
+		///
+		/// The bad element table of the Boyer-Moore searchers: maps the elements of the
+		/// pattern to their skips, and any other element to the default skip. Elements of
+		/// one byte, with the default hash and predicate, index an array of 256 skips.
+		///
+		template <typename Key, typename Value, typename Hash, typename BinaryPredicate,
+				  bool bArray = std::is_integral<Key>::value && (sizeof(Key) == 1) &&
+								std::is_same<Hash, std::hash<Key> >::value && std::is_same<BinaryPredicate, std::equal_to<Key> >::value>
+		class searcher_skip_table
+		{
+		public:
+			searcher_skip_table(Value nDefault, const Hash& hash, const BinaryPredicate& predicate)
+				: mMap(0, hash, predicate), mnDefault(nDefault) { }
+
+			void set(const Key& key, Value value)
+				{ mMap[key] = value; }
+
+			Value operator[](const Key& key) const
+			{
+				const typename map_type::const_iterator it = mMap.find(key);
+				return (it != mMap.end()) ? it->second : mnDefault;
+			}
+
+		protected:
+			typedef std::hash_map<Key, Value, Hash, BinaryPredicate> map_type;
+
+			map_type mMap;
+			Value    mnDefault;
+		};
+
+		template <typename Key, typename Value, typename Hash, typename BinaryPredicate>
+		class searcher_skip_table<Key, Value, Hash, BinaryPredicate, true>
+		{
+		public:
+			searcher_skip_table(Value nDefault, const Hash&, const BinaryPredicate&)
+				{ std::fill(mTable, mTable + 256, nDefault); }
+
+			void set(const Key& key, Value value)
+				{ mTable[(uint8_t)key] = value; }
+
+			Value operator[](const Key& key) const
+				{ return mTable[(uint8_t)key]; }
+
+		protected:
+			Value mTable[256];
+		};
+
+	} // namespace Internal
+
+
+
+	/// default_searcher
+	///
+	/// Searches with search(first, last, patternFirst, patternLast, predicate), which
+	/// compares the pattern at each position in turn. Needs only forward iterators.
+	///
+	template <typename ForwardIterator1, typename BinaryPredicate = std::equal_to<typename std::iterator_traits<ForwardIterator1>::value_type> >
+	class default_searcher
+	{
+	public:
+		default_searcher(ForwardIterator1 patternFirst, ForwardIterator1 patternLast, BinaryPredicate predicate = BinaryPredicate())
+			: mPatternFirst(patternFirst), mPatternLast(patternLast), mPredicate(predicate) { }
+
+		template <typename ForwardIterator2>
+		std::pair<ForwardIterator2, ForwardIterator2> operator()(ForwardIterator2 first, ForwardIterator2 last) const
+		{
+			first = std::search(first, last, mPatternFirst, mPatternLast, mPredicate);
+
+			if(first == last)
+				return std::pair<ForwardIterator2, ForwardIterator2>(last, last);
+
+			ForwardIterator2 matchLast(first);
+			std::advance(matchLast, std::distance(mPatternFirst, mPatternLast));
+			return std::pair<ForwardIterator2, ForwardIterator2>(first, matchLast);
+		}
+
+	protected:
+		ForwardIterator1 mPatternFirst;
+		ForwardIterator1 mPatternLast;
+		BinaryPredicate  mPredicate;
+	};
+
+
+
+	/// boyer_moore_horspool_searcher
+	///
+	/// Compares the pattern from its end at each position, then skips ahead by the
+	/// distance from the last occurrence in the pattern (excluding its last element)
+	/// of the element under the pattern's last element to the pattern's end.
+	///
+	/// The pattern's elements must be hashable with Hash, and Hash must be consistent
+	/// with BinaryPredicate. Precomputation is O(m), in time and memory.
+	///
+	template <typename RandomAccessIterator1,
+			  typename Hash            = std::hash<typename std::iterator_traits<RandomAccessIterator1>::value_type>,
+			  typename BinaryPredicate = std::equal_to<typename std::iterator_traits<RandomAccessIterator1>::value_type> >
+	class boyer_moore_horspool_searcher
+	{
+	public:
+		typedef typename std::iterator_traits<RandomAccessIterator1>::value_type      value_type;
+		typedef typename std::iterator_traits<RandomAccessIterator1>::difference_type difference_type;
+
+		boyer_moore_horspool_searcher(RandomAccessIterator1 patternFirst, RandomAccessIterator1 patternLast,
+									  Hash hash = Hash(), BinaryPredicate predicate = BinaryPredicate())
+			: mPatternFirst(patternFirst)
+			, mnPatternLength(patternLast - patternFirst)
+			, mSkipTable(mnPatternLength, hash, predicate)
+			, mPredicate(predicate)
+		{
+			for(difference_type i = 0; i < (mnPatternLength - 1); i++)
+				mSkipTable.set(*(patternFirst + i), mnPatternLength - 1 - i);
+		}
+
+		template <typename RandomAccessIterator2>
+		std::pair<RandomAccessIterator2, RandomAccessIterator2> operator()(RandomAccessIterator2 first, RandomAccessIterator2 last) const
+		{
+			typedef typename std::iterator_traits<RandomAccessIterator2>::difference_type difference_type_2;
+
+			const difference_type_2 m = (difference_type_2)mnPatternLength;
+
+			if(m == 0)
+				return std::pair<RandomAccessIterator2, RandomAccessIterator2>(first, first);
+
+			for(difference_type_2 nRemaining = last - first; nRemaining >= m; )
+			{
+				difference_type_2 i = m - 1;
+
+				while(mPredicate(*(first + i), *(mPatternFirst + i)))
+				{
+					if(i == 0)
+						return std::pair<RandomAccessIterator2, RandomAccessIterator2>(first, first + m);
+					--i;
+				}
+
+				const difference_type_2 nSkip = (difference_type_2)mSkipTable[*(first + (m - 1))];
+				first      += nSkip;
+				nRemaining -= nSkip;
+			}
+
+			return std::pair<RandomAccessIterator2, RandomAccessIterator2>(last, last);
+		}
+
+	protected:
+		typedef Internal::searcher_skip_table<value_type, difference_type, Hash, BinaryPredicate> skip_table_type;
+
+		RandomAccessIterator1 mPatternFirst;
+		difference_type       mnPatternLength;
+		skip_table_type       mSkipTable;
+		BinaryPredicate       mPredicate;
+	};
+
+
+
+	/// boyer_moore_searcher
+	///
+	/// Compares the pattern from its end at each position, then skips ahead by the
+	/// larger of the bad element rule (aligning the mismatched element with its last
+	/// occurrence in the pattern) and the good suffix rule (aligning the matched suffix
+	/// with its previous occurrence in the pattern). The latter makes it faster than
+	/// boyer_moore_horspool_searcher for long patterns with repeated parts, at the cost
+	/// of a table of m skips.
+	///
+	/// The pattern's elements must be hashable with Hash, and Hash must be consistent
+	/// with BinaryPredicate. Precomputation is O(m), in time and memory.
+	///
+	template <typename RandomAccessIterator1,
+			  typename Hash            = std::hash<typename std::iterator_traits<RandomAccessIterator1>::value_type>,
+			  typename BinaryPredicate = std::equal_to<typename std::iterator_traits<RandomAccessIterator1>::value_type> >
+	class boyer_moore_searcher
+	{
+	public:
+		typedef typename std::iterator_traits<RandomAccessIterator1>::value_type      value_type;
+		typedef typename std::iterator_traits<RandomAccessIterator1>::difference_type difference_type;
+
+		boyer_moore_searcher(RandomAccessIterator1 patternFirst, RandomAccessIterator1 patternLast,
+							 Hash hash = Hash(), BinaryPredicate predicate = BinaryPredicate())
+			: mPatternFirst(patternFirst)
+			, mnPatternLength(patternLast - patternFirst)
+			, mSkipTable(mnPatternLength, hash, predicate)
+			, mGoodSuffix((eastl_size_t)mnPatternLength)
+			, mPredicate(predicate)
+		{
+			const difference_type m = mnPatternLength;
+
+			for(difference_type i = 0; i < (m - 1); i++)
+				mSkipTable.set(*(patternFirst + i), m - 1 - i);
+
+			if(m == 0)
+				return;
+
+			// suffix[i] is the length of the longest suffix of the pattern which ends at i.
+			std::vector<difference_type> suffix((eastl_size_t)m);
+			difference_type f = 0, g = m - 1;
+
+			suffix[(eastl_size_t)(m - 1)] = m;
+
+			for(difference_type i = m - 2; i >= 0; i--)
+			{
+				if((i > g) && (suffix[(eastl_size_t)(i + m - 1 - f)] < (i - g)))
+					suffix[(eastl_size_t)i] = suffix[(eastl_size_t)(i + m - 1 - f)];
+				else
+				{
+					if(i < g)
+						g = i;
+					f = i;
+					while((g >= 0) && mPredicate(*(patternFirst + g), *(patternFirst + (g + m - 1 - f))))
+						--g;
+					suffix[(eastl_size_t)i] = f - g;
+				}
+			}
+
+			// mGoodSuffix[i] is the skip after a mismatch at i, which aligns the matched
+			// suffix (i, m) with its rightmost other occurrence in the pattern, or failing
+			// that, the longest prefix of the pattern which is a suffix of it.
+			std::fill(mGoodSuffix.begin(), mGoodSuffix.end(), m);
+
+			for(difference_type i = m - 1, j = 0; i >= 0; i--)
+			{
+				if(suffix[(eastl_size_t)i] == (i + 1))
+				{
+					for(; j < (m - 1 - i); j++)
+					{
+						if(mGoodSuffix[(eastl_size_t)j] == m)
+							mGoodSuffix[(eastl_size_t)j] = m - 1 - i;
+					}
+				}
+			}
+
+			for(difference_type i = 0; i <= (m - 2); i++)
+				mGoodSuffix[(eastl_size_t)(m - 1 - suffix[(eastl_size_t)i])] = m - 1 - i;
+		}
+
+		template <typename RandomAccessIterator2>
+		std::pair<RandomAccessIterator2, RandomAccessIterator2> operator()(RandomAccessIterator2 first, RandomAccessIterator2 last) const
+		{
+			typedef typename std::iterator_traits<RandomAccessIterator2>::difference_type difference_type_2;
+
+			const difference_type_2 m = (difference_type_2)mnPatternLength;
+
+			if(m == 0)
+				return std::pair<RandomAccessIterator2, RandomAccessIterator2>(first, first);
+
+			for(difference_type_2 nRemaining = last - first; nRemaining >= m; )
+			{
+				difference_type_2 i = m - 1;
+
+				while(mPredicate(*(first + i), *(mPatternFirst + i)))
+				{
+					if(i == 0)
+						return std::pair<RandomAccessIterator2, RandomAccessIterator2>(first, first + m);
+					--i;
+				}
+
+				const difference_type_2 nBadElementSkip  = (difference_type_2)mSkipTable[*(first + i)] - (m - 1 - i); // May be negative.
+				const difference_type_2 nGoodSuffixSkip  = (difference_type_2)mGoodSuffix[(eastl_size_t)i];
+				const difference_type_2 nSkip            = (nBadElementSkip > nGoodSuffixSkip) ? nBadElementSkip : nGoodSuffixSkip;
+
+				first      += nSkip;
+				nRemaining -= nSkip;
+			}
+
+			return std::pair<RandomAccessIterator2, RandomAccessIterator2>(last, last);
+		}
+
+	protected:
+		typedef Internal::searcher_skip_table<value_type, difference_type, Hash, BinaryPredicate> skip_table_type;
+
+		RandomAccessIterator1        mPatternFirst;
+		difference_type              mnPatternLength;
+		skip_table_type              mSkipTable;
+		std::vector<difference_type> mGoodSuffix;
+		BinaryPredicate              mPredicate;
+	};
+
+
+
+	/// two_way_searcher
+	///
+	/// The two-way algorithm of Crochemore and Perrin. The pattern is split at a
+	/// critical factorization, found from its maximal suffixes for the ordering
+	/// given by Compare and for the reverse ordering. At each position the right
+	/// part is compared first, and a mismatch there skips past the elements which
+	/// matched; after a match of the right part the left part is compared, and a
+	/// mismatch skips by the period of the pattern. For periodic patterns it also
+	/// remembers how much of the pattern the last skip left matched.
+	///
+	/// It makes at most 2n - m comparisons of the range, whatever the pattern, and
+	/// precomputes three integers in O(m). Elements are equal if neither is ordered
+	/// before the other by Compare.
+	///
+	template <typename RandomAccessIterator1, typename Compare = std::less<typename std::iterator_traits<RandomAccessIterator1>::value_type> >
+	class two_way_searcher
+	{
+	public:
+		typedef typename std::iterator_traits<RandomAccessIterator1>::value_type      value_type;
+		typedef typename std::iterator_traits<RandomAccessIterator1>::difference_type difference_type;
+
+		two_way_searcher(RandomAccessIterator1 patternFirst, RandomAccessIterator1 patternLast, Compare compare = Compare())
+			: mPatternFirst(patternFirst)
+			, mnPatternLength(patternLast - patternFirst)
+			, mnCritical(-1)
+			, mnPeriod(1)
+			, mbPeriodic(true)
+			, mCompare(compare)
+		{
+			difference_type nPeriod, nReversePeriod;
+
+			const difference_type nSuffix        = MaximalSuffix(false, nPeriod);
+			const difference_type nReverseSuffix = MaximalSuffix(true,  nReversePeriod);
+
+			if(nSuffix > nReverseSuffix)
+			{
+				mnCritical = nSuffix;
+				mnPeriod   = nPeriod;
+			}
+			else
+			{
+				mnCritical = nReverseSuffix;
+				mnPeriod   = nReversePeriod;
+			}
+
+			// The period of the right part is that of the pattern if the left part occurs mnPeriod
+			// elements later. Otherwise any shift of at most the length of the larger part misses.
+			for(difference_type i = 0; i <= mnCritical; i++)
+			{
+				if(!Equal(*(patternFirst + i), *(patternFirst + (i + mnPeriod))))
+				{
+					mbPeriodic = false;
+					mnPeriod   = ((mnCritical + 1) > (mnPatternLength - mnCritical - 1) ? (mnCritical + 1) : (mnPatternLength - mnCritical - 1)) + 1;
+					break;
+				}
+			}
+		}
+
+		template <typename RandomAccessIterator2>
+		std::pair<RandomAccessIterator2, RandomAccessIterator2> operator()(RandomAccessIterator2 first, RandomAccessIterator2 last) const
+		{
+			typedef typename std::iterator_traits<RandomAccessIterator2>::difference_type difference_type_2;
+
+			const difference_type_2 m        = (difference_type_2)mnPatternLength;
+			const difference_type_2 nLeft    = (difference_type_2)mnCritical; // The last index of the left part, or -1 if it's empty.
+			const difference_type_2 nPeriod  = (difference_type_2)mnPeriod;
+			difference_type_2       nMemory  = -1; // The pattern is known to match up to and including this index.
+
+			if(m == 0)
+				return std::pair<RandomAccessIterator2, RandomAccessIterator2>(first, first);
+
+			for(difference_type_2 nRemaining = last - first; nRemaining >= m; )
+			{
+				difference_type_2 i = ((nLeft > nMemory) ? nLeft : nMemory) + 1;
+
+				while((i < m) && Equal(*(first + i), *(mPatternFirst + i)))
+					++i;
+
+				if(i < m)
+				{
+					first      += (i - nLeft);
+					nRemaining -= (i - nLeft);
+					nMemory     = -1;
+				}
+				else
+				{
+					for(i = nLeft; (i > nMemory) && Equal(*(first + i), *(mPatternFirst + i)); --i)
+						{ }
+
+					if(i <= nMemory)
+						return std::pair<RandomAccessIterator2, RandomAccessIterator2>(first, first + m);
+
+					first      += nPeriod;
+					nRemaining -= nPeriod;
+
+					if(mbPeriodic)
+						nMemory = m - nPeriod - 1;
+				}
+			}
+
+			return std::pair<RandomAccessIterator2, RandomAccessIterator2>(last, last);
+		}
+
+	protected:
+		template <typename T, typename U>
+		bool Equal(const T& a, const U& b) const
+			{ return !mCompare(a, b) && !mCompare(b, a); }
+
+		// Returns the index before the maximal suffix of the pattern for the ordering (or
+		// its reverse), which may be -1, and sets nPeriod to the period of that suffix.
+		difference_type MaximalSuffix(bool bReverse, difference_type& nPeriod) const
+		{
+			difference_type nSuffix = -1, j = 0, k = 1, p = 1;
+
+			while((j + k) < mnPatternLength)
+			{
+				const value_type& a = *(mPatternFirst + (j + k));
+				const value_type& b = *(mPatternFirst + (nSuffix + k));
+
+				if(bReverse ? mCompare(b, a) : mCompare(a, b)) // The suffix at j is smaller; advance past it.
+				{
+					j += k;
+					k  = 1;
+					p  = j - nSuffix;
+				}
+				else if(bReverse ? mCompare(a, b) : mCompare(b, a)) // The suffix at j is larger; it's the new maximum.
+				{
+					nSuffix = j;
+					j       = nSuffix + 1;
+					k = p   = 1;
+				}
+				else if(k != p)
+					++k;
+				else
+				{
+					j += p;
+					k  = 1;
+				}
+			}
+
+			nPeriod = p;
+			return nSuffix;
+		}
+
+		RandomAccessIterator1 mPatternFirst;
+		difference_type       mnPatternLength;
+		difference_type       mnCritical;   // The last index of the left part of the critical factorization, or -1.
+		difference_type       mnPeriod;     // The skip after a match of the right part and a mismatch of the left.
+		bool                  mbPeriodic;   // True if mnPeriod is the period of the pattern.
+		Compare               mCompare;
+	};
+
+} // namespace std
+
+
+#endif // Header include guard
@@ -0,0 +1,149 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements the following
+//     counting_semaphore
+//     binary_semaphore
+//
+// These follow the C++ standard library's <semaphore>, without the timed
+// try_acquire_for and try_acquire_until, as atomic<T>::wait, which threads
+// sleep in, has no timeout.
+//
+// http://en.cppreference.com/w/cpp/header/semaphore
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_SEMAPHORE_H
+#define EASTL_SEMAPHORE_H
+
+
+#include <EABase/eabase.h>
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once
+#endif
+
+#include <EASTL/internal/config.h>
+#include <EASTL/atomic.h>
+#include <stddef.h>
+
+
+
+namespace std
+{
+
+	/// counting_semaphore
+	///
+	/// Implements a semaphore: a count of available resources which acquire
+	/// takes one of, waiting until one is available, and release returns.
+	/// Unlike a mutex, any thread may release, so that semaphores also serve
+	/// to signal from one thread to another.
+	///
+	/// The count is a 32-bit atomic which waiting threads sleep on through
+	/// atomic<int32_t>::wait, which is a futex on Linux. Waiters register in
+	/// a second counter before they sleep, so that release makes no system
+	/// call unless a thread may be asleep.
+	///
+	/// LeastMaxValue is the largest count the semaphore must hold. It can't
+	/// exceed INT32_MAX, which is also the default.
+	///
+	/// Example usage:
+	///    counting_semaphore<> slots(4);
+	///
+	///    slots.acquire();
+	///    UseSlot();
+	///    slots.release();
+	///
+	template <ptrdiff_t LeastMaxValue = INT32_MAX>
+	class counting_semaphore
+	{
+		static_assert((LeastMaxValue >= 0) && (LeastMaxValue <= INT32_MAX), "counting_semaphore holds counts of up to INT32_MAX.");
+
+	public:
+		static EA_CONSTEXPR ptrdiff_t max() EA_NOEXCEPT
+			{ return LeastMaxValue; }
+
+		EA_CONSTEXPR explicit counting_semaphore(ptrdiff_t nDesired)
+			: mnCount((int32_t)nDesired), mnWaiterCount(0) { }
+
+		counting_semaphore(const counting_semaphore&) = delete;
+		counting_semaphore& operator=(const counting_semaphore&) = delete;
+
+		/// Adds n to the count, and wakes as many waiting threads as may now acquire.
+		void release(ptrdiff_t n = 1)
+		{
+			EASTL_ASSERT((n >= 0) && (n <= (max() - mnCount.load(memory_order_relaxed))));
+
+			// Both this and AcquireContended use seq_cst, so that either we see the waiter
+			// or the waiter sees the new count and doesn't sleep.
+			mnCount.fetch_add((int32_t)n, memory_order_seq_cst);
+
+			if(mnWaiterCount.load(memory_order_seq_cst) != 0)
+			{
+				if(n == 1)
+					mnCount.notify_one();
+				else
+					mnCount.notify_all();
+			}
+		}
+
+		/// Takes one from the count, waiting until it's positive.
+		void acquire()
+		{
+			if(!try_acquire())
+				AcquireContended();
+		}
+
+		/// Takes one from the count if it's positive, and returns whether it did.
+		bool try_acquire() EA_NOEXCEPT
+		{
+			int32_t nCount = mnCount.load(memory_order_relaxed);
+
+			while(nCount > 0)
+			{
+				if(mnCount.compare_exchange_weak(nCount, nCount - 1, memory_order_acquire, memory_order_relaxed))
+					return true;
+			}
+
+			return false;
+		}
+
+	protected:
+		void AcquireContended()
+		{
+			mnWaiterCount.fetch_add(1, memory_order_seq_cst);
+
+			for(;;)
+			{
+				int32_t nCount = mnCount.load(memory_order_seq_cst);
+
+				if(nCount > 0)
+				{
+					if(mnCount.compare_exchange_weak(nCount, nCount - 1, memory_order_acquire, memory_order_relaxed))
+						break;
+				}
+				else
+					mnCount.wait(nCount, memory_order_relaxed); // Spins for a while before it sleeps.
+			}
+
+			mnWaiterCount.fetch_sub(1, memory_order_relaxed);
+		}
+
+	protected:
+		atomic<int32_t> mnCount;
+		atomic<int32_t> mnWaiterCount; // The number of threads in AcquireContended.
+	};
+
+
+	/// binary_semaphore
+	///
+	/// A semaphore with a count of 0 or 1, which is mostly used for one thread
+	/// to signal another, as with a condition variable which doesn't need a mutex.
+	///
+	typedef counting_semaphore<1> binary_semaphore;
+
+} // namespace std
+
+
+#endif // Header include guard
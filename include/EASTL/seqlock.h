@@ -0,0 +1,175 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements the following
+//     seqlock
+//
+// seqlock is an extension to the standard library, for publishing small
+// values which one thread updates and many threads read, such as the latest
+// configuration or a timestamped sample, without readers writing to any
+// memory which the writer or other readers use.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_SEQLOCK_H
+#define EASTL_SEQLOCK_H
+
+
+#include <EABase/eabase.h>
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once
+#endif
+
+#include <EASTL/internal/config.h>
+#include <EASTL/internal/thread_support.h>
+#include <EASTL/atomic.h>
+#include <EASTL/type_traits.h>
+#include <string.h>
+
+
+
+namespace std
+{
+
+	/// seqlock
+	///
+	/// Holds a value of type T which one thread at a time may store while any
+	/// number of threads load it. A sequence number is odd while a store is in
+	/// progress and incremented once more when it's done; a load reads the
+	/// sequence number, then the value, then the sequence number again, and
+	/// retries if the two differ or the first was odd.
+	///
+	/// Loads make no stores at all, so readers don't take the cache lines from
+	/// the writer or from one another, and any number of them scale as well as
+	/// plain reads. In exchange a load retries while a store is in progress, so
+	/// T should be small enough to copy quickly, and stores should not be so
+	/// frequent that readers seldom get between them.
+	///
+	/// The value is kept as an array of relaxed atomic words, ordered by fences
+	/// against the sequence number (H. Boehm, "Can Seqlocks Get Along with
+	/// Programming Language Memory Models?"), so that a load which overlaps a
+	/// store, and retries, is still free of data races.
+	///
+	/// T must be trivially copyable. Threads which store must do so one at a
+	/// time, e.g. by being the same thread or by holding a mutex.
+	///
+	/// Example usage:
+	///    seqlock<Camera> gCamera;
+	///
+	///    gCamera.store(camera);            // The simulation thread
+	///    Camera camera = gCamera.load();   // Any thread
+	///
+	template <typename T>
+	class seqlock
+	{
+		static_assert(is_trivially_copyable<T>::value, "seqlock copies values bytewise, so T must be trivially copyable.");
+
+	public:
+		typedef T value_type;
+
+		seqlock()
+			: mnSequence(0)
+		{
+			for(size_t i = 0; i < kWordCount; i++)
+				mWords[i].store(0, memory_order_relaxed);
+		}
+
+		explicit seqlock(const value_type& value)
+			: mnSequence(0)
+		{
+			word_type words[kWordCount];
+			ToWords(value, words);
+
+			for(size_t i = 0; i < kWordCount; i++)
+				mWords[i].store(words[i], memory_order_relaxed);
+		}
+
+		seqlock(const seqlock&) = delete;
+		seqlock& operator=(const seqlock&) = delete;
+
+		/// Replaces the value. Only one thread at a time may call this.
+		void store(const value_type& value) EA_NOEXCEPT
+		{
+			word_type words[kWordCount];
+			ToWords(value, words);
+
+			const uint32_t nSequence = mnSequence.load(memory_order_relaxed);
+
+			mnSequence.store(nSequence + 1, memory_order_relaxed);
+			atomic_thread_fence(memory_order_release); // Orders the odd sequence number before the words.
+
+			for(size_t i = 0; i < kWordCount; i++)
+				mWords[i].store(words[i], memory_order_relaxed);
+
+			mnSequence.store(nSequence + 2, memory_order_release);
+		}
+
+		/// Copies the value to value, unless a store is in progress, and returns whether it did.
+		bool try_load(value_type& value) const EA_NOEXCEPT
+		{
+			word_type words[kWordCount];
+
+			if(!TryLoadWords(words))
+				return false;
+
+			memcpy(&value, words, sizeof(value_type));
+			return true;
+		}
+
+		/// Returns the value, retrying while stores are in progress. T need not be
+		/// default constructible, as the value is copied out bytewise.
+		value_type load() const EA_NOEXCEPT
+		{
+			word_type words[kWordCount];
+
+			for(int i = 1; !TryLoadWords(words); i++)
+			{
+				if(i % 64) // The writer normally finishes within a few pauses, unless it was suspended.
+					cpu_pause();
+				else
+					Internal::thread_yield();
+			}
+
+			typename aligned_storage<sizeof(value_type), EASTL_ALIGN_OF(value_type)>::type value;
+			memcpy(&value, words, sizeof(value_type));
+			return *reinterpret_cast<const value_type*>(&value);
+		}
+
+	protected:
+		typedef uintptr_t word_type;
+
+		static const size_t kWordCount = (sizeof(value_type) + sizeof(word_type) - 1) / sizeof(word_type);
+
+		static void ToWords(const value_type& value, word_type* pWords)
+		{
+			pWords[kWordCount - 1] = 0; // So that the padding bytes of the last word are always the same.
+			memcpy(pWords, &value, sizeof(value_type));
+		}
+
+		// Copies the words of the value to pWords, unless a store is in progress, and returns whether it did.
+		bool TryLoadWords(word_type* pWords) const EA_NOEXCEPT
+		{
+			const uint32_t nSequence = mnSequence.load(memory_order_acquire);
+
+			if(nSequence & 1)
+				return false;
+
+			for(size_t i = 0; i < kWordCount; i++)
+				pWords[i] = mWords[i].load(memory_order_relaxed);
+
+			atomic_thread_fence(memory_order_acquire); // Orders the words before the second sequence number.
+
+			return mnSequence.load(memory_order_relaxed) == nSequence;
+		}
+
+	protected:
+		atomic<uint32_t>  mnSequence;
+		atomic<word_type> mWords[kWordCount];
+	};
+
+} // namespace std
+
+
+#endif // Header include guard
@@ -0,0 +1,297 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements the following
+//     shared_mutex
+//     shared_lock
+//
+// These follow the C++ standard library's <shared_mutex>. shared_mutex is
+// meant for data which is read far more often than it's written: readers
+// take it with one compare-and-swap on a single word and never make a system
+// call unless a writer holds or waits for it.
+//
+// http://en.cppreference.com/w/cpp/header/shared_mutex
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_SHARED_MUTEX_H
+#define EASTL_SHARED_MUTEX_H
+
+
+#include <EABase/eabase.h>
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once
+#endif
+
+#include <EASTL/internal/config.h>
+#include <EASTL/mutex.h>
+
+
+
+namespace std
+{
+
+	///////////////////////////////////////////////////////////////////////////
+	// shared_mutex
+	///////////////////////////////////////////////////////////////////////////
+
+	/// shared_mutex
+	///
+	/// Implements a non-recursive reader-writer lock which any number of readers
+	/// may hold at once, or one writer. The state is a single 32-bit word:
+	///
+	///     kWriter         A writer holds the lock.
+	///     kWriterWaiting  A writer is waiting for the lock; new readers wait behind it.
+	///     kParked         A thread may be asleep in atomic<uint32_t>::wait on the state.
+	///     the rest        The number of readers which hold the lock.
+	///
+	/// Writers take precedence over new readers, so that a steady stream of
+	/// readers can't keep a writer waiting forever. Threads which wait spin
+	/// for EASTL_MUTEX_SPIN_COUNT checks before they sleep, and whoever clears
+	/// kParked wakes all sleepers, which set it again if they must go on waiting.
+	///
+	/// Example usage:
+	///    shared_mutex gTableMutex;
+	///
+	///    shared_lock<shared_mutex> readLock(gTableMutex);   // Readers
+	///    unique_lock<shared_mutex> writeLock(gTableMutex);  // Writers
+	///
+	class shared_mutex
+	{
+	public:
+		EA_CONSTEXPR shared_mutex() EA_NOEXCEPT
+			: mnState(0) { }
+
+		shared_mutex(const shared_mutex&) = delete;
+		shared_mutex& operator=(const shared_mutex&) = delete;
+
+		// Exclusive ownership
+		void lock()
+		{
+			uint32_t nExpected = 0;
+
+			if(!mnState.compare_exchange_strong(nExpected, kWriter, memory_order_acquire, memory_order_relaxed))
+				LockContended();
+		}
+
+		bool try_lock()
+		{
+			uint32_t nState = mnState.load(memory_order_relaxed);
+
+			return ((nState & (kWriter | kReaderMask)) == 0) &&
+				   mnState.compare_exchange_strong(nState, kWriter | (nState & kParked), memory_order_acquire, memory_order_relaxed);
+		}
+
+		void unlock()
+		{
+			// Subtracting kWriter, rather than masking it off, is a single instruction on x86.
+			if(mnState.fetch_sub(kWriter, memory_order_release) & kParked)
+			{
+				mnState.fetch_and(~kParked, memory_order_relaxed);
+				mnState.notify_all();
+			}
+		}
+
+		// Shared ownership
+		void lock_shared()
+		{
+			uint32_t nState = mnState.load(memory_order_relaxed);
+
+			if(((nState & (kWriter | kWriterWaiting)) != 0) ||
+			   !mnState.compare_exchange_weak(nState, nState + 1, memory_order_acquire, memory_order_relaxed))
+				LockSharedContended();
+		}
+
+		bool try_lock_shared()
+		{
+			uint32_t nState = mnState.load(memory_order_relaxed);
+
+			while((nState & (kWriter | kWriterWaiting)) == 0)
+			{
+				if(mnState.compare_exchange_weak(nState, nState + 1, memory_order_acquire, memory_order_relaxed))
+					return true;
+			}
+
+			return false;
+		}
+
+		void unlock_shared()
+		{
+			const uint32_t nPrevious = mnState.fetch_sub(1, memory_order_release);
+
+			// The last reader out wakes the writer waiting for it.
+			if(((nPrevious & kReaderMask) == 1) && (nPrevious & kParked))
+			{
+				mnState.fetch_and(~kParked, memory_order_relaxed);
+				mnState.notify_all();
+			}
+		}
+
+	protected:
+		static const uint32_t kWriter        = 0x80000000;
+		static const uint32_t kWriterWaiting = 0x40000000;
+		static const uint32_t kParked        = 0x20000000;
+		static const uint32_t kReaderMask    = kParked - 1;
+
+		void LockContended()
+		{
+			for(int i = 0; ; i++)
+			{
+				uint32_t nState = mnState.load(memory_order_relaxed);
+
+				if((nState & (kWriter | kReaderMask)) == 0)
+				{
+					// We clear kWriterWaiting, which other waiting writers set again.
+					if(mnState.compare_exchange_weak(nState, kWriter | (nState & kParked), memory_order_acquire, memory_order_relaxed))
+						return;
+				}
+				else if((nState & kWriterWaiting) == 0)
+					mnState.compare_exchange_weak(nState, nState | kWriterWaiting, memory_order_relaxed, memory_order_relaxed);
+				else if(i < EASTL_MUTEX_SPIN_COUNT)
+					cpu_pause();
+				else
+					Park(nState);
+			}
+		}
+
+		void LockSharedContended()
+		{
+			for(int i = 0; ; i++)
+			{
+				uint32_t nState = mnState.load(memory_order_relaxed);
+
+				if((nState & (kWriter | kWriterWaiting)) == 0)
+				{
+					if(mnState.compare_exchange_weak(nState, nState + 1, memory_order_acquire, memory_order_relaxed))
+						return;
+				}
+				else if(i < EASTL_MUTEX_SPIN_COUNT)
+					cpu_pause();
+				else
+					Park(nState);
+			}
+		}
+
+		// Sleeps until the state changes from nState, after marking it as having a sleeper.
+		void Park(uint32_t nState)
+		{
+			if(!(nState & kParked) && !mnState.compare_exchange_strong(nState, nState | kParked, memory_order_relaxed, memory_order_relaxed))
+				return; // The state changed, so the caller should look at it again.
+
+			mnState.wait(nState | kParked, memory_order_relaxed);
+		}
+
+	protected:
+		atomic<uint32_t> mnState;
+	};
+
+
+
+	///////////////////////////////////////////////////////////////////////////
+	// shared_lock
+	///////////////////////////////////////////////////////////////////////////
+
+	/// shared_lock
+	///
+	/// Holds a shared_mutex (or any type with lock_shared and unlock_shared)
+	/// shared, and unlocks it upon destruction if it still holds it. It's the
+	/// shared counterpart of unique_lock, with the same interface.
+	///
+	template <typename Mutex>
+	class shared_lock
+	{
+	public:
+		typedef Mutex mutex_type;
+
+		shared_lock() EA_NOEXCEPT
+			: mpMutex(NULL), mbOwns(false) { }
+
+		explicit shared_lock(mutex_type& m)
+			: mpMutex(&m), mbOwns(false) { lock(); }
+
+		shared_lock(mutex_type& m, defer_lock_t) EA_NOEXCEPT
+			: mpMutex(&m), mbOwns(false) { }
+
+		shared_lock(mutex_type& m, try_to_lock_t)
+			: mpMutex(&m), mbOwns(m.try_lock_shared()) { }
+
+		shared_lock(mutex_type& m, adopt_lock_t)
+			: mpMutex(&m), mbOwns(true) { }
+
+		shared_lock(shared_lock&& x) EA_NOEXCEPT
+			: mpMutex(x.mpMutex), mbOwns(x.mbOwns)
+		{
+			x.mpMutex = NULL;
+			x.mbOwns  = false;
+		}
+
+	   ~shared_lock()
+		{
+			if(mbOwns)
+				mpMutex->unlock_shared();
+		}
+
+		shared_lock& operator=(shared_lock&& x) EA_NOEXCEPT
+		{
+			shared_lock(std::move(x)).swap(*this);
+			return *this;
+		}
+
+		shared_lock(const shared_lock&) = delete;
+		shared_lock& operator=(const shared_lock&) = delete;
+
+		void lock()
+		{
+			EASTL_ASSERT(mpMutex && !mbOwns);
+			mpMutex->lock_shared();
+			mbOwns = true;
+		}
+
+		bool try_lock()
+		{
+			EASTL_ASSERT(mpMutex && !mbOwns);
+			return (mbOwns = mpMutex->try_lock_shared());
+		}
+
+		void unlock()
+		{
+			EASTL_ASSERT(mbOwns);
+			mpMutex->unlock_shared();
+			mbOwns = false;
+		}
+
+		void swap(shared_lock& x) EA_NOEXCEPT
+		{
+			std::swap(mpMutex, x.mpMutex);
+			std::swap(mbOwns, x.mbOwns);
+		}
+
+		mutex_type* release() EA_NOEXCEPT
+		{
+			mutex_type* const pMutex = mpMutex;
+			mpMutex = NULL;
+			mbOwns  = false;
+			return pMutex;
+		}
+
+		bool        owns_lock() const EA_NOEXCEPT         { return mbOwns; }
+		explicit    operator bool() const EA_NOEXCEPT     { return mbOwns; }
+		mutex_type* mutex() const EA_NOEXCEPT             { return mpMutex; }
+
+	protected:
+		mutex_type* mpMutex;
+		bool        mbOwns;
+	};
+
+	template <typename Mutex>
+	inline void swap(shared_lock<Mutex>& a, shared_lock<Mutex>& b) EA_NOEXCEPT
+	{
+		a.swap(b);
+	}
+
+} // namespace std
+
+
+#endif // Header include guard
@@ -46,6 +46,7 @@
 #include <EASTL/internal/smart_ptr.h>
 #include <EASTL/internal/thread_support.h>
 #include <EASTL/unique_ptr.h>
+#include <EASTL/atomic.h>
 #include <EASTL/functional.h>
 #include <EASTL/allocator.h>
 #if EASTL_RTTI_ENABLED
@@ -96,6 +97,11 @@ namespace std
 	template <typename T> class weak_ptr;
 	template <typename T> class enable_shared_from_this;
 
+	namespace Internal
+	{
+		template <typename SmartPtr> class atomic_smart_ptr;
+	}
+
 
 
 	#if EASTL_EXCEPTIONS_ENABLED
@@ -131,6 +137,14 @@ namespace std
 		void          weak_release();
 		ref_count_sp* lock() EA_NOEXCEPT;
 
+		// Non-atomic versions of the above, used by local_shared_ptr and local_weak_ptr,
+		// whose ownership groups are confined to a single thread.
+		void          local_addref() EA_NOEXCEPT;
+		void          local_release();
+		void          local_weak_addref() EA_NOEXCEPT;
+		void          local_weak_release();
+		ref_count_sp* local_lock() EA_NOEXCEPT;
+
 		virtual void free_value() EA_NOEXCEPT = 0;          // Release the contained object.
 		virtual void free_ref_count_sp() EA_NOEXCEPT = 0;   // Release this instance.
 
@@ -192,6 +206,44 @@ namespace std
 		return nullptr;
 	}
 
+	inline void ref_count_sp::local_addref() EA_NOEXCEPT
+	{
+		++mRefCount;
+		++mWeakRefCount;
+	}
+
+	inline void ref_count_sp::local_release()
+	{
+		EASTL_ASSERT((mRefCount > 0) && (mWeakRefCount > 0));
+		if(--mRefCount == 0)
+			free_value();
+
+		if(--mWeakRefCount == 0)
+			free_ref_count_sp();
+	}
+
+	inline void ref_count_sp::local_weak_addref() EA_NOEXCEPT
+	{
+		++mWeakRefCount;
+	}
+
+	inline void ref_count_sp::local_weak_release()
+	{
+		EASTL_ASSERT(mWeakRefCount > 0);
+		if(--mWeakRefCount == 0)
+			free_ref_count_sp();
+	}
+
+	inline ref_count_sp* ref_count_sp::local_lock() EA_NOEXCEPT
+	{
+		if(mRefCount == 0)
+			return nullptr;
+
+		++mRefCount;
+		++mWeakRefCount;
+		return this;
+	}
+
 
 
 	/// ref_count_sp_t
@@ -893,6 +945,7 @@ namespace std
 		// Friend declarations.
 		template <typename U> friend class shared_ptr;
 		template <typename U> friend class weak_ptr;
+		template <typename U> friend class Internal::atomic_smart_ptr;
 		template <typename U> friend void allocate_shared_helper(shared_ptr<U>&, ref_count_sp*, U*);
 
 		// Handles the allocating of mpRefCount, while assigning mpValue.
@@ -1228,6 +1281,10 @@ namespace std
 	//      shared_ptr<Foo> pFoo2 = pFoo;
 	//      // Thread 2:
 	//      pFoo = make_shared<Foo>();
+	//
+	// These functions lock a mutex chosen by the address of the shared_ptr, so 
+	// operations on different shared_ptr objects usually don't contend. Prefer
+	// atomic<shared_ptr<T>> (see below), which is lock-free.
 	///////////////////////////////////////////////////////////////////////////
 
 	template <typename T>
@@ -1235,8 +1292,8 @@ namespace std
 	{
 		// Return true if atomic access to the provided shared_ptr instance is lock-free, false otherwise.
 		// For this to be lock-free, we would have to be able to copy shared_ptr objects in an atomic way 
-		// as opposed to wrapping it with a mutex like we do below. Given the nature of shared_ptr, it's 
-		// probably not feasible to implement these operations without a mutex. atomic_is_lock_free exists
+		// as opposed to wrapping it with a mutex like we do below. A plain shared_ptr has no room for the 
+		// bookkeeping this requires, which is why atomic<shared_ptr<T>> exists. atomic_is_lock_free exists
 		// in the C++11 Standard because it also applies to other types such as built-in types which can
 		// be lock-free in their access.
 		return false;
@@ -1248,6 +1305,10 @@ namespace std
 		Internal::shared_ptr_auto_mutex autoMutex(pSharedPtr);
 		return *pSharedPtr;
 	}
+
+	// The functions below swap values out of *pSharedPtr rather than assign them, so that the 
+	// previous values are released after the mutex is unlocked. Releasing them may run arbitrary
+	// destructors, which themselves may use these functions on a shared_ptr with the same mutex.
   
 	template <typename T>
 	inline shared_ptr<T> atomic_load_explicit(const shared_ptr<T>* pSharedPtr, ... /*std::memory_order memoryOrder*/)
@@ -1289,15 +1350,21 @@ namespace std
 	template <typename T>
 	bool atomic_compare_exchange_strong(shared_ptr<T>* pSharedPtr, shared_ptr<T>* pSharedPtrCondition, shared_ptr<T> sharedPtrNew)
 	{
-		Internal::shared_ptr_auto_mutex autoMutex(pSharedPtr);
+		shared_ptr<T> current;
 
-		if(pSharedPtr->equivalent_ownership(*pSharedPtrCondition))
 		{
-			*pSharedPtr = sharedPtrNew;
-			return true;
+			Internal::shared_ptr_auto_mutex autoMutex(pSharedPtr);
+
+			if(pSharedPtr->equivalent_ownership(*pSharedPtrCondition))
+			{
+				pSharedPtr->swap(sharedPtrNew);
+				return true;
+			}
+
+			current = *pSharedPtr;
 		}
 
-		*pSharedPtrCondition = *pSharedPtr;
+		pSharedPtrCondition->swap(current);
 		return false;
 	}
 
@@ -1614,6 +1681,7 @@ namespace std
 		// Friend declarations
 		template <typename U> friend class shared_ptr;
 		template <typename U> friend class weak_ptr;
+		template <typename U> friend class Internal::atomic_smart_ptr;
 
 	}; // class weak_ptr
 
@@ -1682,6 +1750,297 @@ namespace std
 	};
 
 
+	///////////////////////////////////////////////////////////////////////////
+	// atomic<shared_ptr<T>>, atomic<weak_ptr<T>>
+	//
+	// Implements the C++20 atomic smart pointer specializations. Unlike the 
+	// shared_ptr atomic access functions above, these are lock-free.
+	//
+	// Example usage:
+	//     atomic<shared_ptr<const Config>> gConfig;
+	//
+	//     // Any number of reader threads:
+	//     shared_ptr<const Config> pConfig = gConfig.load();
+	//
+	//     // Writer thread:
+	//     gConfig.store(make_shared<const Config>(newSettings));
+	///////////////////////////////////////////////////////////////////////////
+
+	namespace Internal
+	{
+		/// atomic_smart_ptr
+		///
+		/// Implements atomic<shared_ptr<T>> and atomic<weak_ptr<T>> with split reference counts.
+		///
+		/// A smart pointer is two words, which is more than can be copied and have its reference 
+		/// count incremented in one atomic operation, and a reader that first reads the words and 
+		/// then increments the count may find the object freed by a writer in between. So each 
+		/// stored value is put in a heap node, and the atomic word is a (node, external count) pair, 
+		/// swapped by double-width CAS. A reader increments the external count, which guarantees 
+		/// that the node stays alive, copies the smart pointer out of the node and then decrements 
+		/// the node's internal count. A writer which swaps a node out adds the external count it 
+		/// saw to the internal count, and whoever brings the internal count to zero frees the node.
+		///
+		/// load costs two atomic read-modify-writes and no locks, and stores allocate one node.
+		/// Every load writes the head word, so concurrent readers contend on its cache line and 
+		/// read throughput doesn't scale with cores. Values read far more often than they change 
+		/// are better loaded once per batch of work, or published through rcu.
+		/// An empty smart pointer is stored without a node, so default construction doesn't allocate.
+		///
+		template <typename SmartPtr>
+		class atomic_smart_ptr
+		{
+		protected:
+			struct Node;
+
+			struct CountedNode
+			{
+				Node*     mpNode;
+				uintptr_t mnExternalCount;  // One for the reference held by mHead plus one for each reader which has acquired the node.
+			};
+
+		public:
+			typedef SmartPtr value_type;
+
+			// We are lock-free exactly when the double-width atomic head is.
+			static EA_CONSTEXPR_OR_CONST bool is_always_lock_free = atomic<CountedNode>::is_always_lock_free;
+
+		public:
+			atomic_smart_ptr() EA_NOEXCEPT
+				: mHead() {}
+
+			atomic_smart_ptr(value_type desired)
+				: mHead(MakeCountedNode(CreateNode(std::move(desired)))) {}
+
+			~atomic_smart_ptr()
+				{ RetireNode(mHead.load(memory_order_relaxed), 0); }
+
+			atomic_smart_ptr(const atomic_smart_ptr&) = delete;
+			atomic_smart_ptr& operator=(const atomic_smart_ptr&) = delete;
+
+			void operator=(value_type desired)
+				{ store(std::move(desired)); }
+
+			operator value_type() const
+				{ return load(); }
+
+			bool is_lock_free() const EA_NOEXCEPT
+				{ return mHead.is_lock_free(); }
+
+			// The memory order arguments are accepted for compatibility. All operations are sequentially consistent,
+			// as each reads or writes the stored value with a sequentially consistent read-modify-write of mHead.
+			template <typename Order>
+			value_type load(Order) const
+				{ return load(); }
+
+			value_type load() const
+			{
+				const CountedNode head = AcquireHead();
+
+				if(!head.mpNode)
+					return value_type();
+
+				value_type result(head.mpNode->mValue);
+				ReleaseNode(head.mpNode);
+				return result;
+			}
+
+			template <typename Order>
+			void store(value_type desired, Order)
+				{ store(std::move(desired)); }
+
+			void store(value_type desired)
+			{
+				const CountedNode oldHead = mHead.exchange(MakeCountedNode(CreateNode(std::move(desired))), memory_order_seq_cst);
+				RetireNode(oldHead, 0);
+			}
+
+			template <typename Order>
+			value_type exchange(value_type desired, Order)
+				{ return exchange(std::move(desired)); }
+
+			value_type exchange(value_type desired)
+			{
+				const CountedNode oldHead = mHead.exchange(MakeCountedNode(CreateNode(std::move(desired))), memory_order_seq_cst);
+
+				if(!oldHead.mpNode)
+					return value_type();
+
+				// Readers which incremented the external count before our exchange may still be copying 
+				// the value, so we copy it rather than move it out of the node.
+				value_type result(oldHead.mpNode->mValue);
+				RetireNode(oldHead, 0);
+				return result;
+			}
+
+			template <typename Order>
+			bool compare_exchange_weak(value_type& expected, value_type desired, Order)
+				{ return compare_exchange_strong(expected, std::move(desired)); }
+
+			template <typename OrderSuccess, typename OrderFailure>
+			bool compare_exchange_weak(value_type& expected, value_type desired, OrderSuccess, OrderFailure)
+				{ return compare_exchange_strong(expected, std::move(desired)); }
+
+			bool compare_exchange_weak(value_type& expected, value_type desired)
+				{ return compare_exchange_strong(expected, std::move(desired)); }
+
+			template <typename Order>
+			bool compare_exchange_strong(value_type& expected, value_type desired, Order)
+				{ return compare_exchange_strong(expected, std::move(desired)); }
+
+			template <typename OrderSuccess, typename OrderFailure>
+			bool compare_exchange_strong(value_type& expected, value_type desired, OrderSuccess, OrderFailure)
+				{ return compare_exchange_strong(expected, std::move(desired)); }
+
+			bool compare_exchange_strong(value_type& expected, value_type desired)
+			{
+				// As with the Standard, values are equivalent if they store the same pointer and share ownership.
+				Node* pNewNode     = NULL;
+				bool  bNodeCreated = false;
+
+				for(;;)
+				{
+					CountedNode head  = AcquireHead();
+					Node* const pNode = head.mpNode;
+
+					const bool bEquivalent = pNode ? ((pNode->mValue.mpValue == expected.mpValue) && (pNode->mValue.mpRefCount == expected.mpRefCount))
+					                               : (!expected.mpValue && !expected.mpRefCount);
+					if(!bEquivalent)
+					{
+						value_type current(pNode ? pNode->mValue : value_type());
+
+						if(pNode)
+							ReleaseNode(pNode);
+						if(pNewNode)
+							DestroyNode(pNewNode);
+
+						expected.swap(current);
+						return false;
+					}
+
+					if(!bNodeCreated)
+					{
+						pNewNode     = CreateNode(std::move(desired));
+						bNodeCreated = true;
+					}
+
+					// This fails if another thread stored a value or merely acquired the node in the 
+					// meantime. In the latter case we try again, as strong exchanges can't fail spuriously.
+					if(mHead.compare_exchange_strong(head, MakeCountedNode(pNewNode), memory_order_seq_cst, memory_order_relaxed))
+					{
+						const CountedNode oldHead = { pNode, head.mnExternalCount };
+						RetireNode(oldHead, 1);
+						return true;
+					}
+
+					if(pNode)
+						ReleaseNode(pNode);
+				}
+			}
+
+		protected:
+			struct Node
+			{
+				value_type         mValue;
+				atomic<intptr_t>   mnInternalCount;
+
+				Node(value_type&& value) : mValue(std::move(value)), mnInternalCount(0) {}
+			};
+
+			static Node* CreateNode(value_type&& value)
+			{
+				if(!value.mpValue && !value.mpRefCount)
+					return NULL;
+
+				EASTLAllocatorType allocator(EASTL_SHARED_PTR_DEFAULT_NAME);
+				void* const pMemory = EASTLAlloc(allocator, sizeof(Node));
+				EASTL_ASSERT(pMemory != NULL);
+				return ::new(pMemory) Node(std::move(value));
+			}
+
+			static void DestroyNode(Node* pNode)
+			{
+				EASTLAllocatorType allocator(EASTL_SHARED_PTR_DEFAULT_NAME);
+				pNode->~Node();
+				EASTLFree(allocator, pNode, sizeof(Node));
+			}
+
+			static CountedNode MakeCountedNode(Node* pNode)
+			{
+				const CountedNode countedNode = { pNode, 1 };
+				return countedNode;
+			}
+
+			// Increments the external count of the current node, which keeps it alive until ReleaseNode.
+			CountedNode AcquireHead() const
+			{
+				CountedNode head = mHead.load(memory_order_relaxed);
+				CountedNode newHead;
+
+				do {
+					if(!head.mpNode)
+						return head;
+
+					newHead = head;
+					newHead.mnExternalCount++;
+				} while(!mHead.compare_exchange_weak(head, newHead, memory_order_seq_cst, memory_order_relaxed));
+
+				return newHead;
+			}
+
+			static void ReleaseNode(Node* pNode)
+			{
+				if(pNode->mnInternalCount.fetch_sub(1, memory_order_acq_rel) == 1)
+					DestroyNode(pNode);
+			}
+
+			// Called by the thread which swapped the node out of mHead. nAcquired is the number of 
+			// acquisitions in oldHead.mnExternalCount made by the calling thread itself.
+			static void RetireNode(CountedNode oldHead, intptr_t nAcquired)
+			{
+				if(oldHead.mpNode)
+				{
+					const intptr_t nOutstanding = (intptr_t)oldHead.mnExternalCount - 1 - nAcquired;
+
+					if(oldHead.mpNode->mnInternalCount.fetch_add(nOutstanding, memory_order_acq_rel) == -nOutstanding)
+						DestroyNode(oldHead.mpNode);
+				}
+			}
+
+			mutable atomic<CountedNode> mHead;
+		};
+
+	} // namespace Internal
+
+
+	template <typename T>
+	struct atomic<shared_ptr<T>> : public Internal::atomic_smart_ptr<shared_ptr<T>>
+	{
+		typedef Internal::atomic_smart_ptr<shared_ptr<T>> base_type;
+
+		atomic() EA_NOEXCEPT {}
+		atomic(shared_ptr<T> desired) : base_type(std::move(desired)) {}
+		atomic(std::nullptr_t) EA_NOEXCEPT {}
+
+		using base_type::operator=;
+
+		void operator=(std::nullptr_t)
+			{ this->store(shared_ptr<T>()); }
+	};
+
+
+	template <typename T>
+	struct atomic<weak_ptr<T>> : public Internal::atomic_smart_ptr<weak_ptr<T>>
+	{
+		typedef Internal::atomic_smart_ptr<weak_ptr<T>> base_type;
+
+		atomic() EA_NOEXCEPT {}
+		atomic(weak_ptr<T> desired) : base_type(std::move(desired)) {}
+
+		using base_type::operator=;
+	};
+
+
 } // namespace std
 
 
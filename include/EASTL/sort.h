@@ -7,8 +7,9 @@
 // std C++ sorting algorithms, while others don't have equivalents in the 
 // C++ standard. We implement the following sorting algorithms:
 //    is_sorted             -- 
-//    sort                  -- Unstable.    The implementation of this is mapped to quick_sort by default.
+//    sort                  -- Unstable.    The implementation of this is mapped to pdq_sort by default.
 //    quick_sort            -- Unstable.    This is actually an intro-sort (quick sort with switch to insertion sort).
+//    pdq_sort              -- Unstable.    Pattern-defeating quicksort, an intro-sort which adapts to patterns in the data.
 //    tim_sort              -- Stable.
 //    tim_sort_buffer       -- Stable.
 //    partial_sort          -- Unstable.
@@ -21,13 +22,21 @@
 //    merge_sort_buffer     -- Stable. 
 //    nth_element           -- Unstable.
 //    radix_sort            -- Stable.      Important and useful sort for integral data, and faster than all others for this.
+//    radix_sort_by_key     -- Stable.      radix_sort of separate key and value arrays.
+//    radix_argsort         -- Stable.      The order radix_sort would put elements in, as indexes.
+//    static_sort           -- Unstable.    Sorting network for arrays of a size known at compile time.
 //    comb_sort             -- Unstable.    Possibly the best combination of small code size but fast sort.
 //    bubble_sort           -- Stable.      Useful in practice for sorting tiny sets of data (<= 10 elements).
 //    selection_sort*       -- Unstable.
 //    shaker_sort*          -- Stable.
 //    bucket_sort*          -- Stable. 
+//    string_sort*          -- Unstable.    Multikey quicksort for ranges of strings.
+//    parallel_sort**       -- Unstable.    Sample sort on a thread_pool.
+//    parallel_stable_sort**-- Stable.      Merge sort on a thread_pool.
+//    parallel_radix_sort** -- Stable.      radix_sort on a thread_pool, starting from the most significant digit.
 //
 // * Found in sort_extra.h.
+// ** Found in parallel_sort.h.
 //
 // Additional sorting and related algorithms we may want to implement:
 //    partial_sort_copy     This would be like the std STL version.
@@ -1078,6 +1087,760 @@ namespace std
 
 
 
+	namespace Internal
+	{
+		// pdq_sort is derived from pattern-defeating quicksort by Orson Peters.
+		// https://github.com/orlp/pdqsort
+		// Licensed under the zlib License: Copyright (c) 2021 Orson Peters
+
+		const intptr_t kPdqInsertionSortLimit        = 24;  // Partitions below this size are sorted with insertion sort.
+		const intptr_t kPdqNintherLimit              = 128; // Partitions above this size use Tukey's ninther as the pivot.
+		const size_t   kPdqPartialInsertionSortLimit = 8;   // Moves a partial_insertion_sort may make before giving up.
+		const size_t   kPdqBlockSize                 = 64;  // Elements classified per block by the branchless partition.
+		const size_t   kPdqCacheLineSize             = 64;
+
+
+		/// pdq_sort_use_branchless
+		///
+		/// Identifies comparisons which are cheap enough that pdq_sort should partition
+		/// with the branchless block partition, which does more work per element than
+		/// the plain partition in order to avoid mispredicted branches. This is the case
+		/// for the default orderings of arithmetic and pointer types. It can be
+		/// specialized by the user for other cheap comparisons.
+		///
+		template <typename T, typename Compare>
+		struct pdq_sort_use_branchless : public false_type {};
+
+		template <typename T> struct pdq_sort_use_branchless<T, std::less<T> >       : public integral_constant<bool, is_arithmetic<T>::value || is_pointer<T>::value> {};
+		template <typename T> struct pdq_sort_use_branchless<T, std::greater<T> >    : public integral_constant<bool, is_arithmetic<T>::value || is_pointer<T>::value> {};
+		template <typename T> struct pdq_sort_use_branchless<T, std::less<void> >    : public integral_constant<bool, is_arithmetic<T>::value || is_pointer<T>::value> {};
+		template <typename T> struct pdq_sort_use_branchless<T, std::greater<void> > : public integral_constant<bool, is_arithmetic<T>::value || is_pointer<T>::value> {};
+
+	} // namespace Internal
+
+
+
+	/// static_sort
+	///
+	/// Sorts the N elements starting at first with a sorting network: a sequence of
+	/// compare-exchange operations on fixed pairs of positions, known at compile time.
+	/// The network is Batcher's odd-even merge sort, for N that aren't powers of 2
+	/// with the comparisons against positions beyond N left out. The sort is not stable.
+	///
+	/// The default orderings of integral and pointer types use branchless compare-exchanges,
+	/// which compile to conditional moves or vector min/max instructions, so that sorting a
+	/// tiny array never mispredicts a branch. Other types are swapped when out of order, for
+	/// which insertion_sort is usually as fast.
+	///
+	/// Example usage:
+	///     float window[9];
+	///     static_sort<9>(window);
+	///     float median = window[4];
+	///
+	namespace Internal
+	{
+		template <typename RandomAccessIterator, typename Compare>
+		inline void static_sort_exchange(RandomAccessIterator a, RandomAccessIterator b, Compare& compare, true_type)
+		{
+			typedef typename std::iterator_traits<RandomAccessIterator>::value_type value_type;
+
+			// An independent min and max, which compilers turn into conditional moves or min and
+			// max instructions. Equivalent elements are identical for these types, so it doesn't
+			// matter that both are taken from x when neither is less.
+			const value_type x = *a;
+			const value_type y = *b;
+
+			*a = compare(y, x) ? y : x;
+			*b = compare(x, y) ? y : x;
+		}
+
+		template <typename RandomAccessIterator, typename Compare>
+		inline void static_sort_exchange(RandomAccessIterator a, RandomAccessIterator b, Compare& compare, false_type)
+		{
+			if(compare(*b, *a))
+				std::iter_swap(a, b);
+		}
+
+
+		// static_sort_use_branchless
+		//
+		// The orderings for which static_sort compare-exchanges with a min and a max. These are
+		// those of pdq_sort_use_branchless for integral and pointer types, whose equivalent values
+		// are identical. That isn't so of floating point types (-0.0 and 0.0), or of whatever
+		// types the user has specialized pdq_sort_use_branchless for.
+		//
+		template <typename T, typename Compare>
+		struct static_sort_use_branchless
+			: public integral_constant<bool, pdq_sort_use_branchless<T, Compare>::value && (is_integral<T>::value || is_pointer<T>::value)> {};
+
+
+		// Compare-exchanges positions I and J, unless J is beyond the N sorted elements.
+		template <int N, int I, int J, bool bInRange = (J < N)>
+		struct static_sort_pair
+		{
+			template <typename RandomAccessIterator, typename Compare, typename Branchless>
+			static void apply(RandomAccessIterator first, Compare& compare, Branchless branchless)
+				{ static_sort_exchange(first + I, first + J, compare, branchless); }
+		};
+
+		template <int N, int I, int J>
+		struct static_sort_pair<N, I, J, false>
+		{
+			template <typename RandomAccessIterator, typename Compare, typename Branchless>
+			static void apply(RandomAccessIterator, Compare&, Branchless) { }
+		};
+
+
+		// Compare-exchanges positions (I, I + R), (I + 2R, I + 3R), ... for positions before End.
+		template <int N, int I, int R, int End, bool bContinue = (I < End)>
+		struct static_sort_merge_pairs
+		{
+			template <typename RandomAccessIterator, typename Compare, typename Branchless>
+			static void apply(RandomAccessIterator first, Compare& compare, Branchless branchless)
+			{
+				static_sort_pair<N, I, I + R>::apply(first, compare, branchless);
+				static_sort_merge_pairs<N, I + (2 * R), R, End>::apply(first, compare, branchless);
+			}
+		};
+
+		template <int N, int I, int R, int End>
+		struct static_sort_merge_pairs<N, I, R, End, false>
+		{
+			template <typename RandomAccessIterator, typename Compare, typename Branchless>
+			static void apply(RandomAccessIterator, Compare&, Branchless) { }
+		};
+
+
+		// Merges the sorted halves of positions [Lo, Hi] (inclusive), comparing positions R apart.
+		template <int N, int Lo, int Hi, int R, bool bRecurse = ((2 * R) < (Hi - Lo))>
+		struct static_sort_merge
+		{
+			template <typename RandomAccessIterator, typename Compare, typename Branchless>
+			static void apply(RandomAccessIterator first, Compare& compare, Branchless branchless)
+			{
+				static_sort_merge<N, Lo,     Hi, 2 * R>::apply(first, compare, branchless);
+				static_sort_merge<N, Lo + R, Hi, 2 * R>::apply(first, compare, branchless);
+				static_sort_merge_pairs<N, Lo + R, R, Hi - R>::apply(first, compare, branchless);
+			}
+		};
+
+		template <int N, int Lo, int Hi, int R>
+		struct static_sort_merge<N, Lo, Hi, R, false>
+		{
+			template <typename RandomAccessIterator, typename Compare, typename Branchless>
+			static void apply(RandomAccessIterator first, Compare& compare, Branchless branchless)
+				{ static_sort_pair<N, Lo, Lo + R>::apply(first, compare, branchless); }
+		};
+
+
+		// Sorts positions [Lo, Hi] (inclusive), where Hi - Lo + 1 is a power of 2.
+		// Parts of the network which only involve positions beyond N are left out.
+		template <int N, int Lo, int Hi, bool bSort = ((Lo < Hi) && (Lo < N))>
+		struct static_sort_network
+		{
+			template <typename RandomAccessIterator, typename Compare, typename Branchless>
+			static void apply(RandomAccessIterator first, Compare& compare, Branchless branchless)
+			{
+				static_sort_network<N, Lo, Lo + ((Hi - Lo) / 2)>::apply(first, compare, branchless);
+				static_sort_network<N, Lo + ((Hi - Lo) / 2) + 1, Hi>::apply(first, compare, branchless);
+				static_sort_merge<N, Lo, Hi, 1>::apply(first, compare, branchless);
+			}
+		};
+
+		template <int N, int Lo, int Hi>
+		struct static_sort_network<N, Lo, Hi, false>
+		{
+			template <typename RandomAccessIterator, typename Compare, typename Branchless>
+			static void apply(RandomAccessIterator, Compare&, Branchless) { }
+		};
+
+
+		// The smallest power of 2 which is no less than N.
+		template <int N, int P = 1, bool bDone = (P >= N)>
+		struct static_sort_size { static const int value = static_sort_size<N, P * 2>::value; };
+
+		template <int N, int P>
+		struct static_sort_size<N, P, true> { static const int value = P; };
+
+	} // namespace Internal
+
+	template <size_t N, typename RandomAccessIterator, typename Compare>
+	inline void static_sort(RandomAccessIterator first, Compare compare)
+	{
+		typedef typename std::iterator_traits<RandomAccessIterator>::value_type value_type;
+		typedef Internal::static_sort_network<(int)N, 0, Internal::static_sort_size<(int)N>::value - 1> network_type;
+
+		network_type::apply(first, compare, typename Internal::static_sort_use_branchless<value_type, Compare>::type());
+	}
+
+	template <size_t N, typename RandomAccessIterator>
+	inline void static_sort(RandomAccessIterator first)
+	{
+		typedef std::less<typename std::iterator_traits<RandomAccessIterator>::value_type> Less;
+
+		std::static_sort<N, RandomAccessIterator, Less>(first, Less());
+	}
+
+
+
+	namespace Internal
+	{
+
+
+		// pdq_insertion_sort
+		//
+		// Sorts [first, last) with insertion sort. If bUnguarded is true, there must be an
+		// element before first which is no greater than any element in [first, last),
+		// which serves as the sentinel and saves a bounds check per move.
+		//
+		template <bool bUnguarded, typename RandomAccessIterator, typename Compare>
+		inline void pdq_insertion_sort(RandomAccessIterator first, RandomAccessIterator last, Compare& compare)
+		{
+			typedef typename std::iterator_traits<RandomAccessIterator>::value_type value_type;
+
+			if(first == last)
+				return;
+
+			for(RandomAccessIterator current = first + 1; current != last; ++current)
+			{
+				RandomAccessIterator sift  = current;
+				RandomAccessIterator sift1 = current - 1;
+
+				// Compare first, so that elements already in position aren't moved twice.
+				if(compare(*sift, *sift1))
+				{
+					value_type temp(std::move(*sift));
+
+					do { *sift-- = std::move(*sift1); }
+					while((bUnguarded || (sift != first)) && compare(temp, *--sift1));
+
+					*sift = std::move(temp);
+				}
+			}
+		}
+
+
+
+		// pdq_network_sort
+		//
+		// Sorts the nSize (less than kPdqInsertionSortLimit) elements starting at first
+		// with the static_sort network of that size. This is used instead of insertion
+		// sort where static_sort is branchless, as it avoids the mispredicted branch
+		// which ends each insertion.
+		//
+		template <typename RandomAccessIterator, typename Compare>
+		inline void pdq_network_sort(RandomAccessIterator first, intptr_t nSize, Compare& compare)
+		{
+			static_assert(kPdqInsertionSortLimit == 24, "pdq_network_sort needs a case for each partition size.");
+
+			switch(nSize)
+			{
+				case  2: std::static_sort< 2>(first, compare); break;
+				case  3: std::static_sort< 3>(first, compare); break;
+				case  4: std::static_sort< 4>(first, compare); break;
+				case  5: std::static_sort< 5>(first, compare); break;
+				case  6: std::static_sort< 6>(first, compare); break;
+				case  7: std::static_sort< 7>(first, compare); break;
+				case  8: std::static_sort< 8>(first, compare); break;
+				case  9: std::static_sort< 9>(first, compare); break;
+				case 10: std::static_sort<10>(first, compare); break;
+				case 11: std::static_sort<11>(first, compare); break;
+				case 12: std::static_sort<12>(first, compare); break;
+				case 13: std::static_sort<13>(first, compare); break;
+				case 14: std::static_sort<14>(first, compare); break;
+				case 15: std::static_sort<15>(first, compare); break;
+				case 16: std::static_sort<16>(first, compare); break;
+				case 17: std::static_sort<17>(first, compare); break;
+				case 18: std::static_sort<18>(first, compare); break;
+				case 19: std::static_sort<19>(first, compare); break;
+				case 20: std::static_sort<20>(first, compare); break;
+				case 21: std::static_sort<21>(first, compare); break;
+				case 22: std::static_sort<22>(first, compare); break;
+				case 23: std::static_sort<23>(first, compare); break;
+				default: break;
+			}
+		}
+
+		// pdq_partial_insertion_sort
+		//
+		// Attempts an insertion sort of [first, last), giving up once more than
+		// kPdqPartialInsertionSortLimit elements have been moved. Returns true if
+		// the range was sorted.
+		//
+		template <typename RandomAccessIterator, typename Compare>
+		inline bool pdq_partial_insertion_sort(RandomAccessIterator first, RandomAccessIterator last, Compare& compare)
+		{
+			typedef typename std::iterator_traits<RandomAccessIterator>::value_type value_type;
+
+			if(first == last)
+				return true;
+
+			size_t nMoveCount = 0;
+
+			for(RandomAccessIterator current = first + 1; current != last; ++current)
+			{
+				RandomAccessIterator sift  = current;
+				RandomAccessIterator sift1 = current - 1;
+
+				if(compare(*sift, *sift1))
+				{
+					value_type temp(std::move(*sift));
+
+					do { *sift-- = std::move(*sift1); }
+					while((sift != first) && compare(temp, *--sift1));
+
+					*sift = std::move(temp);
+					nMoveCount += (size_t)(current - sift);
+				}
+
+				if(nMoveCount > kPdqPartialInsertionSortLimit)
+					return false;
+			}
+
+			return true;
+		}
+
+
+		template <typename RandomAccessIterator, typename Compare>
+		inline void pdq_sort2(RandomAccessIterator a, RandomAccessIterator b, Compare& compare)
+		{
+			if(compare(*b, *a))
+				std::iter_swap(a, b);
+		}
+
+		template <typename RandomAccessIterator, typename Compare>
+		inline void pdq_sort3(RandomAccessIterator a, RandomAccessIterator b, RandomAccessIterator c, Compare& compare)
+		{
+			pdq_sort2(a, b, compare);
+			pdq_sort2(b, c, compare);
+			pdq_sort2(a, b, compare);
+		}
+
+
+		// pdq_swap_offsets
+		//
+		// Swaps the elements at first + pOffsetsL[i] with the elements at last - pOffsetsR[i].
+		// If the number of elements waiting on each side differs, a cyclic permutation is
+		// used instead of swaps, as it takes fewer moves.
+		//
+		template <typename RandomAccessIterator>
+		inline void pdq_swap_offsets(RandomAccessIterator first, RandomAccessIterator last, const unsigned char* pOffsetsL,
+		                             const unsigned char* pOffsetsR, size_t nCount, bool bUseSwaps)
+		{
+			typedef typename std::iterator_traits<RandomAccessIterator>::value_type value_type;
+
+			if(bUseSwaps)
+			{
+				// This case is needed for the descending distribution, where we need
+				// to have proper swapping for pdq_sort to remain O(n).
+				for(size_t i = 0; i < nCount; ++i)
+					std::iter_swap(first + pOffsetsL[i], last - pOffsetsR[i]);
+			}
+			else if(nCount > 0)
+			{
+				RandomAccessIterator l = first + pOffsetsL[0];
+				RandomAccessIterator r = last  - pOffsetsR[0];
+				value_type temp(std::move(*l));
+				*l = std::move(*r);
+
+				for(size_t i = 1; i < nCount; ++i)
+				{
+					l = first + pOffsetsL[i]; *r = std::move(*l);
+					r = last  - pOffsetsR[i]; *l = std::move(*r);
+				}
+
+				*r = std::move(temp);
+			}
+		}
+
+
+		// pdq_partition_right
+		//
+		// Partitions [first, last) around the pivot *first. Elements equal to the pivot
+		// go to the right partition. Returns the position of the pivot after partitioning
+		// and whether the range was already partitioned. Assumes the pivot is a median of
+		// at least 3 elements and that [first, last) is at least kPdqInsertionSortLimit long.
+		//
+		// With bBranchless, elements are classified a block at a time into arrays of
+		// offsets, with the result of each comparison used as an integer rather than a
+		// branch, and then the misplaced elements are swapped. This is the BlockQuicksort
+		// scheme by Edelkamp and Weiss.
+		//
+		template <bool bBranchless, typename RandomAccessIterator, typename Compare>
+		pair<RandomAccessIterator, bool> pdq_partition_right(RandomAccessIterator first, RandomAccessIterator last, Compare& compare)
+		{
+			typedef typename std::iterator_traits<RandomAccessIterator>::value_type value_type;
+
+			value_type pivot(std::move(*first));
+
+			RandomAccessIterator l = first;
+			RandomAccessIterator r = last;
+
+			// Find the first element greater than or equal to the pivot (the median of 3
+			// guarantees this exists).
+			while(compare(*++l, pivot))
+				{ }
+
+			// Find the first element strictly smaller than the pivot. We have to guard this
+			// search if there was no element before *l.
+			if((l - 1) == first)
+			{
+				while((l < r) && !compare(*--r, pivot))
+					{ }
+			}
+			else
+			{
+				while(!compare(*--r, pivot))
+					{ }
+			}
+
+			// If the first pair of elements that should be swapped to partition are the same
+			// element, the passed in sequence already was correctly partitioned.
+			const bool bAlreadyPartitioned = (l >= r);
+
+			if(!bAlreadyPartitioned)
+			{
+				if(bBranchless)
+				{
+					std::iter_swap(l, r);
+					++l;
+
+					unsigned char offsetsStorageL[kPdqBlockSize + kPdqCacheLineSize];
+					unsigned char offsetsStorageR[kPdqBlockSize + kPdqCacheLineSize];
+					unsigned char* pOffsetsL = (unsigned char*)(((uintptr_t)offsetsStorageL + (kPdqCacheLineSize - 1)) & ~(uintptr_t)(kPdqCacheLineSize - 1));
+					unsigned char* pOffsetsR = (unsigned char*)(((uintptr_t)offsetsStorageR + (kPdqCacheLineSize - 1)) & ~(uintptr_t)(kPdqCacheLineSize - 1));
+
+					RandomAccessIterator offsetsBaseL = l;
+					RandomAccessIterator offsetsBaseR = r;
+					size_t nCountL = 0, nCountR = 0, nStartL = 0, nStartR = 0;
+
+					while(l < r)
+					{
+						// Fill up the offset blocks with elements that are on the wrong side. First
+						// divide the unknown elements between the left and right blocks.
+						const size_t nUnknown    = (size_t)(r - l);
+						const size_t nSplitLeft  = (nCountL == 0) ? ((nCountR == 0) ? (nUnknown / 2) : nUnknown) : 0;
+						const size_t nSplitRight = (nCountR == 0) ? (nUnknown - nSplitLeft) : 0;
+
+						// Fill the offset blocks, unrolled when a full block remains.
+						if(nSplitLeft >= kPdqBlockSize)
+						{
+							for(size_t i = 0; i < kPdqBlockSize; )
+							{
+								pOffsetsL[nCountL] = (unsigned char)i++; nCountL += !compare(*l, pivot); ++l;
+								pOffsetsL[nCountL] = (unsigned char)i++; nCountL += !compare(*l, pivot); ++l;
+								pOffsetsL[nCountL] = (unsigned char)i++; nCountL += !compare(*l, pivot); ++l;
+								pOffsetsL[nCountL] = (unsigned char)i++; nCountL += !compare(*l, pivot); ++l;
+								pOffsetsL[nCountL] = (unsigned char)i++; nCountL += !compare(*l, pivot); ++l;
+								pOffsetsL[nCountL] = (unsigned char)i++; nCountL += !compare(*l, pivot); ++l;
+								pOffsetsL[nCountL] = (unsigned char)i++; nCountL += !compare(*l, pivot); ++l;
+								pOffsetsL[nCountL] = (unsigned char)i++; nCountL += !compare(*l, pivot); ++l;
+							}
+						}
+						else
+						{
+							for(size_t i = 0; i < nSplitLeft; )
+							{
+								pOffsetsL[nCountL] = (unsigned char)i++; nCountL += !compare(*l, pivot); ++l;
+							}
+						}
+
+						if(nSplitRight >= kPdqBlockSize)
+						{
+							for(size_t i = 0; i < kPdqBlockSize; )
+							{
+								pOffsetsR[nCountR] = (unsigned char)++i; nCountR += compare(*--r, pivot);
+								pOffsetsR[nCountR] = (unsigned char)++i; nCountR += compare(*--r, pivot);
+								pOffsetsR[nCountR] = (unsigned char)++i; nCountR += compare(*--r, pivot);
+								pOffsetsR[nCountR] = (unsigned char)++i; nCountR += compare(*--r, pivot);
+								pOffsetsR[nCountR] = (unsigned char)++i; nCountR += compare(*--r, pivot);
+								pOffsetsR[nCountR] = (unsigned char)++i; nCountR += compare(*--r, pivot);
+								pOffsetsR[nCountR] = (unsigned char)++i; nCountR += compare(*--r, pivot);
+								pOffsetsR[nCountR] = (unsigned char)++i; nCountR += compare(*--r, pivot);
+							}
+						}
+						else
+						{
+							for(size_t i = 0; i < nSplitRight; )
+							{
+								pOffsetsR[nCountR] = (unsigned char)++i; nCountR += compare(*--r, pivot);
+							}
+						}
+
+						// Swap elements and update block sizes and first/last boundaries.
+						const size_t nCount = (nCountL < nCountR) ? nCountL : nCountR;
+						pdq_swap_offsets(offsetsBaseL, offsetsBaseR, pOffsetsL + nStartL, pOffsetsR + nStartR, nCount, nCountL == nCountR);
+						nCountL -= nCount; nCountR -= nCount;
+						nStartL += nCount; nStartR += nCount;
+
+						if(nCountL == 0)
+						{
+							nStartL = 0;
+							offsetsBaseL = l;
+						}
+
+						if(nCountR == 0)
+						{
+							nStartR = 0;
+							offsetsBaseR = r;
+						}
+					}
+
+					// We have now fully identified [l, r)'s proper position. Swap the last elements.
+					if(nCountL)
+					{
+						pOffsetsL += nStartL;
+						while(nCountL--)
+							std::iter_swap(offsetsBaseL + pOffsetsL[nCountL], --r);
+						l = r;
+					}
+
+					if(nCountR)
+					{
+						pOffsetsR += nStartR;
+						while(nCountR--)
+						{
+							std::iter_swap(offsetsBaseR - pOffsetsR[nCountR], l);
+							++l;
+						}
+						r = l;
+					}
+				}
+				else
+				{
+					// Keep swapping pairs of elements that are on the wrong side of the pivot.
+					// Previously swapped pairs guard the searches, which is why the first
+					// iteration is special-cased above.
+					while(l < r)
+					{
+						std::iter_swap(l, r);
+						while(compare(*++l, pivot))
+							{ }
+						while(!compare(*--r, pivot))
+							{ }
+					}
+				}
+			}
+
+			// Put the pivot in the right place.
+			const RandomAccessIterator pivotPosition = l - 1;
+			*first = std::move(*pivotPosition);
+			*pivotPosition = std::move(pivot);
+
+			return pair<RandomAccessIterator, bool>(pivotPosition, bAlreadyPartitioned);
+		}
+
+
+		// pdq_partition_left
+		//
+		// Similar to pdq_partition_right, except that elements equal to the pivot are put
+		// to the left of the pivot, and it doesn't check or return whether the range was
+		// already partitioned. This is used when the pivot equals the element preceding
+		// the range, in which case the left partition is all equal elements.
+		//
+		template <typename RandomAccessIterator, typename Compare>
+		RandomAccessIterator pdq_partition_left(RandomAccessIterator first, RandomAccessIterator last, Compare& compare)
+		{
+			typedef typename std::iterator_traits<RandomAccessIterator>::value_type value_type;
+
+			value_type pivot(std::move(*first));
+
+			RandomAccessIterator l = first;
+			RandomAccessIterator r = last;
+
+			while(compare(pivot, *--r))
+				{ }
+
+			if((r + 1) == last)
+			{
+				while((l < r) && !compare(pivot, *++l))
+					{ }
+			}
+			else
+			{
+				while(!compare(pivot, *++l))
+					{ }
+			}
+
+			while(l < r)
+			{
+				std::iter_swap(l, r);
+				while(compare(pivot, *--r))
+					{ }
+				while(!compare(pivot, *++l))
+					{ }
+			}
+
+			*first = std::move(*r);
+			*r = std::move(pivot);
+
+			return r;
+		}
+
+
+		// pdq_sort_loop
+		//
+		// nBadAllowed is the number of highly unbalanced partitions allowed before falling
+		// back to heap_sort. bLeftmost is true if [first, last) is the leftmost partition,
+		// which is the only one without a smaller element before it.
+		//
+		template <bool bBranchless, typename RandomAccessIterator, typename Compare>
+		void pdq_sort_loop(RandomAccessIterator first, RandomAccessIterator last, Compare& compare, int nBadAllowed, bool bLeftmost)
+		{
+			typedef typename std::iterator_traits<RandomAccessIterator>::difference_type difference_type;
+			typedef typename std::iterator_traits<RandomAccessIterator>::value_type      value_type;
+
+			// Use a while loop for tail recursion elimination.
+			for(;;)
+			{
+				const difference_type nSize = last - first;
+
+				// Insertion sort (or a sorting network) is faster for small arrays.
+				if(nSize < kPdqInsertionSortLimit)
+				{
+					if(static_sort_use_branchless<value_type, Compare>::value)
+						pdq_network_sort(first, (intptr_t)nSize, compare);
+					else if(bLeftmost)
+						pdq_insertion_sort<false>(first, last, compare);
+					else
+						pdq_insertion_sort<true>(first, last, compare);
+					return;
+				}
+
+				// Choose the pivot as the median of 3 or the pseudomedian of 9 and move it to *first.
+				const difference_type nHalf = nSize / 2;
+
+				if(nSize > kPdqNintherLimit)
+				{
+					pdq_sort3(first,                 first + nHalf, last - 1,              compare);
+					pdq_sort3(first + 1,             first + (nHalf - 1), last - 2,        compare);
+					pdq_sort3(first + 2,             first + (nHalf + 1), last - 3,        compare);
+					pdq_sort3(first + (nHalf - 1),   first + nHalf, first + (nHalf + 1),   compare);
+					std::iter_swap(first, first + nHalf);
+				}
+				else
+					pdq_sort3(first + nHalf, first, last - 1, compare);
+
+				// If *(first - 1) is the end of the right partition of a previous partition
+				// operation, no element in [first, last) is smaller than *(first - 1). Then if
+				// the pivot compares equal to *(first - 1), we put equal elements in the left
+				// partition and greater elements in the right one. The left partition is then
+				// sorted (all equal), so we needn't recurse into it. This makes inputs with
+				// many duplicates take linear time.
+				if(!bLeftmost && !compare(*(first - 1), *first))
+				{
+					first = pdq_partition_left(first, last, compare) + 1;
+					continue;
+				}
+
+				// Partition and get results.
+				const pair<RandomAccessIterator, bool> result = pdq_partition_right<bBranchless>(first, last, compare);
+				const RandomAccessIterator pivotPosition = result.first;
+				const bool bAlreadyPartitioned = result.second;
+
+				// Check for a highly unbalanced partition.
+				const difference_type nSizeL = pivotPosition - first;
+				const difference_type nSizeR = last - (pivotPosition + 1);
+				const bool bHighlyUnbalanced = (nSizeL < (nSize / 8)) || (nSizeR < (nSize / 8));
+
+				if(bHighlyUnbalanced)
+				{
+					// If we had too many bad partitions, switch to heap_sort to guarantee O(n log n).
+					if(--nBadAllowed == 0)
+					{
+						std::make_heap<RandomAccessIterator, Compare&>(first, last, compare);
+						std::sort_heap<RandomAccessIterator, Compare&>(first, last, compare);
+						return;
+					}
+
+					// Otherwise break patterns which may be causing the bad partitions.
+					if(nSizeL >= kPdqInsertionSortLimit)
+					{
+						std::iter_swap(first,             first + nSizeL / 4);
+						std::iter_swap(pivotPosition - 1, pivotPosition - nSizeL / 4);
+
+						if(nSizeL > kPdqNintherLimit)
+						{
+							std::iter_swap(first + 1,         first + (nSizeL / 4 + 1));
+							std::iter_swap(first + 2,         first + (nSizeL / 4 + 2));
+							std::iter_swap(pivotPosition - 2, pivotPosition - (nSizeL / 4 + 1));
+							std::iter_swap(pivotPosition - 3, pivotPosition - (nSizeL / 4 + 2));
+						}
+					}
+
+					if(nSizeR >= kPdqInsertionSortLimit)
+					{
+						std::iter_swap(pivotPosition + 1, pivotPosition + (1 + nSizeR / 4));
+						std::iter_swap(last - 1,          last - nSizeR / 4);
+
+						if(nSizeR > kPdqNintherLimit)
+						{
+							std::iter_swap(pivotPosition + 2, pivotPosition + (2 + nSizeR / 4));
+							std::iter_swap(pivotPosition + 3, pivotPosition + (3 + nSizeR / 4));
+							std::iter_swap(last - 2,          last - (1 + nSizeR / 4));
+							std::iter_swap(last - 3,          last - (2 + nSizeR / 4));
+						}
+					}
+				}
+				else
+				{
+					// If we were decently balanced and we tried to sort an already partitioned
+					// sequence, try to use insertion sort. This makes sorted and nearly sorted
+					// inputs take linear time.
+					if(bAlreadyPartitioned && pdq_partial_insertion_sort(first, pivotPosition, compare)
+					                       && pdq_partial_insertion_sort(pivotPosition + 1, last, compare))
+						return;
+				}
+
+				// Sort the left partition first using recursion and do tail recursion elimination for
+				// the right-hand partition.
+				pdq_sort_loop<bBranchless>(first, pivotPosition, compare, nBadAllowed, bLeftmost);
+				first = pivotPosition + 1;
+				bLeftmost = false;
+			}
+		}
+	}
+
+
+	/// pdq_sort
+	///
+	/// This is an unstable sort, and is the default implementation of sort.
+	/// pdq_sort is pattern-defeating quicksort, an introsort variant which
+	/// runs in linear time on sorted, reverse sorted and mostly sorted input and
+	/// on input with few distinct values, while remaining O(n log n) in the
+	/// worst case. Patterns which cause unbalanced partitions are broken up by
+	/// swapping elements, and heap_sort takes over should that keep failing.
+	///
+	/// For the default comparisons of arithmetic and pointer types (see
+	/// Internal::pdq_sort_use_branchless), partitioning is done a block of
+	/// elements at a time without data-dependent branches, which avoids branch
+	/// mispredictions on random input.
+	///
+	/// Requires the value type to be move constructible and move assignable.
+	///
+	template <typename RandomAccessIterator, typename Compare>
+	void pdq_sort(RandomAccessIterator first, RandomAccessIterator last, Compare compare)
+	{
+		typedef typename std::iterator_traits<RandomAccessIterator>::value_type value_type;
+
+		if(first != last)
+		{
+			const bool bBranchless = Internal::pdq_sort_use_branchless<value_type, Compare>::value;
+
+			Internal::pdq_sort_loop<bBranchless, RandomAccessIterator, Compare>(first, last, compare, (int)Internal::Log2((intptr_t)(last - first)), true);
+		}
+	}
+
+	template <typename RandomAccessIterator>
+	inline void pdq_sort(RandomAccessIterator first, RandomAccessIterator last)
+	{
+		typedef std::less<typename std::iterator_traits<RandomAccessIterator>::value_type> Less;
+
+		std::pdq_sort<RandomAccessIterator, Less>(first, last, Less());
+	}
+
+
+
 
 	namespace Internal
 	{
@@ -1593,8 +2356,8 @@ namespace std
 	/// See http://en.wikipedia.org/wiki/Radix_sort.
 	/// This sort requires that the sorted data be of a type that has a member
 	/// radix_type typedef and an mKey member of that type. The type must be
-	/// an integral type. This limits what can be sorted, but radix_sort is 
-	/// very fast -- typically faster than any other sort.
+	/// an integral or floating point type. This limits what can be sorted, but 
+	/// radix_sort is very fast -- typically faster than any other sort.
 	/// For example:
 	///     struct Sortable {
 	///         typedef int radix_type;
@@ -1620,6 +2383,22 @@ namespace std
 	///
 	///     radix_sort<Element*, extract_radix_key<Element> >(elementArray, elementArray + 100, buffer);
 	///
+	/// Signed integer keys and float or double keys are sorted by their value, through
+	/// a mapping of the key bits to an unsigned integer of the same order. Floating point
+	/// keys order -0.0 before +0.0, and NaNs after +infinity (or before -infinity when
+	/// their sign bit is set).
+	///
+	/// The histograms of all digits are counted in a single pass over the keys before
+	/// any element is moved, and digits on which all keys agree are skipped. Keys which
+	/// use few of their bits, such as small integers or timestamps from a short period,
+	/// thus take few passes.
+	///
+	/// radix_sort(first, last, buffer, extractKey) takes any function object which 
+	/// returns the key of an element, and radix_sort(first, last, buffer) sorts ranges
+	/// of integral or floating point values. Both choose the digit size themselves:
+	/// 11 bits for large ranges of 32 and 64 bit keys, which takes 3 instead of 4 passes
+	/// over 32 bit keys and 6 instead of 8 over 64 bit keys, and 8 bits otherwise.
+	///
 	/// To consider: A static linked-list implementation may be faster than the version here.
 
 	namespace Internal
@@ -1638,107 +2417,293 @@ namespace std
 				{ return x.mKey; }
 		};
 
-		// The radix_sort implementation uses two optimizations that are not part of a typical radix sort implementation.
-		// 1. Computing a histogram (i.e. finding the number of elements per bucket) for the next pass is done in parallel with the loop that "scatters"
-		//    elements in the current pass.  The advantage is that it avoids the memory traffic / cache pressure of reading keys in a separate operation.
-		//    Note: It would also be possible to compute all histograms in a single pass.  However, that would increase the amount of stack space used and
-		//    also increase cache pressure slightly.  However, it could still be faster under some situations.
-		// 2. If all elements are mapped to a single bucket, then there is no need to perform a scatter operation.  Instead the elements are left in place
-		//    and only copied if they need to be copied to the final output buffer.
-		template <typename RandomAccessIterator, typename ExtractKey, int DigitBits, typename IntegerType>
-		void radix_sort_impl(RandomAccessIterator first,
-			RandomAccessIterator last,
-			RandomAccessIterator buffer,
-			ExtractKey extractKey,
-			IntegerType)
-		{
-			RandomAccessIterator srcFirst = first;
-			constexpr size_t numBuckets = 1 << DigitBits;
-			constexpr IntegerType bucketMask = numBuckets - 1;
+		/// radix_identity_key
+		///
+		/// Radix sort key reader for ranges of integral or floating point values.
+		///
+		template <typename T>
+		struct radix_identity_key
+		{
+			typedef T radix_type;
+
+			const T& operator()(const T& x) const
+				{ return x; }
+		};
+
+
+		/// radix_key_traits
+		///
+		/// Maps keys to unsigned integers which compare in the same order as the keys.
+		/// Unsigned integer keys are used as they are.
+		///
+		template <typename Key, bool bFloatingPoint = is_floating_point<Key>::value, bool bSigned = is_signed<Key>::value>
+		struct radix_key_traits
+		{
+			typedef Key unsigned_type;
+
+			static unsigned_type encode(Key key)
+				{ return key; }
+		};
+
+		// Flipping the sign bit of signed integers moves the negative values below the positive ones.
+		template <typename Key>
+		struct radix_key_traits<Key, false, true>
+		{
+			typedef typename make_unsigned<Key>::type unsigned_type;
+
+			static unsigned_type encode(Key key)
+				{ return (unsigned_type)((unsigned_type)key ^ ((unsigned_type)1 << ((sizeof(Key) * 8) - 1))); }
+		};
+
+		// IEEE floating point values order as their bits do, except that negative values order
+		// in reverse. Flipping all bits of negative values and the sign bit of the others fixes both.
+		template <typename Key>
+		struct radix_key_traits<Key, true, true>
+		{
+			static_assert((sizeof(Key) == 4) || (sizeof(Key) == 8), "radix_sort supports 32 and 64 bit floating point keys.");
+
+			typedef typename conditional<sizeof(Key) == 4, uint32_t, uint64_t>::type unsigned_type;
+
+			static unsigned_type encode(Key key)
+			{
+				const unsigned_type kSignBit = (unsigned_type)1 << ((sizeof(unsigned_type) * 8) - 1);
+
+				unsigned_type bits;
+				memcpy(&bits, &key, sizeof(bits));
+
+				return bits ^ (((unsigned_type)0 - (bits >> ((sizeof(unsigned_type) * 8) - 1))) | kSignBit);
+			}
+		};
+
+
+		/// radix_sort_elements
+		///
+		/// The elements radix_sort_passes sorts: a range of elements and a buffer of the 
+		/// same size, between which the elements are moved on each pass.
+		///
+		template <typename RandomAccessIterator, typename ExtractKey>
+		struct radix_sort_elements
+		{
+			typedef typename remove_cv<typename remove_reference<decltype(declval<ExtractKey&>()(*declval<RandomAccessIterator&>()))>::type>::type key_type;
+			typedef radix_key_traits<key_type>           traits_type;
+			typedef typename traits_type::unsigned_type  unsigned_type;
+
+			RandomAccessIterator mSource;
+			RandomAccessIterator mDest;
+			ExtractKey           mExtractKey;
+
+			radix_sort_elements(RandomAccessIterator source, RandomAccessIterator dest, const ExtractKey& extractKey)
+				: mSource(source), mDest(dest), mExtractKey(extractKey) { }
+
+			unsigned_type key(size_t i)
+				{ return traits_type::encode(mExtractKey(mSource[i])); }
+
+			void move(size_t iFrom, size_t iTo)
+				{ mDest[iTo] = std::move(mSource[iFrom]); }
+
+			void swap()
+				{ std::swap(mSource, mDest); }
+		};
+
+
+		/// radix_sort_pairs
+		///
+		/// The elements radix_sort_by_key sorts: a range of keys and a range of values,
+		/// each with its own buffer.
+		///
+		template <typename KeyIterator, typename ValueIterator>
+		struct radix_sort_pairs
+		{
+			typedef typename iterator_traits<KeyIterator>::value_type  key_type;
+			typedef radix_key_traits<key_type>                         traits_type;
+			typedef typename traits_type::unsigned_type                unsigned_type;
+
+			KeyIterator   mKeySource;
+			KeyIterator   mKeyDest;
+			ValueIterator mValueSource;
+			ValueIterator mValueDest;
+
+			radix_sort_pairs(KeyIterator keySource, KeyIterator keyDest, ValueIterator valueSource, ValueIterator valueDest)
+				: mKeySource(keySource), mKeyDest(keyDest), mValueSource(valueSource), mValueDest(valueDest) { }
+
+			unsigned_type key(size_t i)
+				{ return traits_type::encode(mKeySource[i]); }
+
+			void move(size_t iFrom, size_t iTo)
+			{
+				mKeyDest[iTo]   = std::move(mKeySource[iFrom]);
+				mValueDest[iTo] = std::move(mValueSource[iFrom]);
+			}
+
+			void swap()
+			{
+				std::swap(mKeySource, mKeyDest);
+				std::swap(mValueSource, mValueDest);
+			}
+		};
+
+
+		// Histograms of up to this many bytes are kept on the stack, larger ones are allocated.
+		const size_t kRadixSortMaxStackHistogramSize = 8192;
+
+		// The smallest range sorted 11 bits at a time, below which the larger histograms cost more than the saved pass.
+		const size_t kRadixSortWideDigitMinCount = 65536;
 
+
+		template <typename Count, size_t kCount, bool bOnStack = ((kCount * sizeof(Count)) <= kRadixSortMaxStackHistogramSize)>
+		struct radix_sort_histogram
+		{
 			// The alignment of this variable isn't required; it merely allows the code below to be faster on some platforms.
-			uint32_t EA_PREFIX_ALIGN(EASTL_PLATFORM_PREFERRED_ALIGNMENT) bucketSize[numBuckets];
-			uint32_t EA_PREFIX_ALIGN(EASTL_PLATFORM_PREFERRED_ALIGNMENT) bucketPosition[numBuckets];
+			Count EA_PREFIX_ALIGN(EASTL_PLATFORM_PREFERRED_ALIGNMENT) mCounts[kCount];
+
+			Count* data()
+				{ return mCounts; }
+		};
+
+		template <typename Count, size_t kCount>
+		struct radix_sort_histogram<Count, kCount, false>
+		{
+			Count* mpCounts;
+
+			radix_sort_histogram()
+				: mpCounts((Count*)allocate_memory(*get_default_allocator(0), kCount * sizeof(Count), EASTL_ALIGN_OF(Count), 0)) { }
+
+			~radix_sort_histogram()
+				{ EASTLFree(*get_default_allocator(0), mpCounts, kCount * sizeof(Count)); }
 
-			RandomAccessIterator temp;
-			uint32_t i;
+			Count* data()
+				{ return mpCounts; }
+
+		private:
+			radix_sort_histogram(const radix_sort_histogram&);
+			radix_sort_histogram& operator=(const radix_sort_histogram&);
+		};
+
+
+		/// radix_sort_passes
+		///
+		/// Stably sorts the n elements of storage by the low nKeyBits bits of their keys,
+		/// DigitBits bits at a time. Returns true if the sorted elements were left in the
+		/// buffer, which happens after an odd number of passes.
+		///
+		/// The histograms of all digits are counted in one pass over the keys, which
+		/// also reveals the digits on which all keys agree. These are skipped, as they
+		/// would only copy the elements from one buffer to the other.
+		///
+		template <int DigitBits, typename Count, typename Storage>
+		bool radix_sort_passes(Storage& storage, size_t n, int nKeyBits)
+		{
+			typedef typename Storage::unsigned_type unsigned_type;
 
-			bool doSeparateHistogramCalculation = true;
-			uint32_t j;
-			for (j = 0; j < (8 * sizeof(IntegerType)); j += DigitBits)
+			const size_t kBucketCount   = (size_t)1 << DigitBits;
+			const size_t kDigitMask     = kBucketCount - 1;
+			const size_t kMaxDigitCount = ((sizeof(unsigned_type) * 8) + DigitBits - 1) / DigitBits;
+			const int    nDigitCount    = (nKeyBits + DigitBits - 1) / DigitBits;
+
+			radix_sort_histogram<Count, kMaxDigitCount * kBucketCount> histogram;
+			Count* const pHistograms = histogram.data();
+
+			memset(pHistograms, 0, nDigitCount * kBucketCount * sizeof(Count));
+
+			for(size_t i = 0; i < n; i++)
+			{
+				const unsigned_type key = storage.key(i);
+
+				for(int d = 0; d < nDigitCount; d++)
+					++pHistograms[(d * kBucketCount) + (size_t)((key >> (d * DigitBits)) & kDigitMask)];
+			}
+
+			const unsigned_type firstKey = storage.key(0);
+			bool bInBuffer = false;
+
+			for(int d = 0; d < nDigitCount; d++)
 			{
-				if (doSeparateHistogramCalculation)
+				Count* const pPositions = pHistograms + (d * kBucketCount);
+				const int    nShift     = d * DigitBits;
+
+				if(pPositions[(size_t)((firstKey >> nShift) & kDigitMask)] == (Count)n)
+					continue; // All keys have the same digit.
+
+				// Turn the counts into the position the first element of each bucket goes to.
+				Count nPosition = 0;
+				for(size_t b = 0; b < kBucketCount; b++)
 				{
-					memset(bucketSize, 0, sizeof(bucketSize));
-					// Calculate histogram for the first scatter operation
-					for (temp = srcFirst; temp != last; ++temp)
-						++bucketSize[(extractKey(*temp) >> j) & bucketMask];
+					const Count nCount = pPositions[b];
+					pPositions[b] = nPosition;
+					nPosition += nCount;
 				}
 
-				// If a single bucket contains all of the elements, then don't bother redistributing all elements to the
-				// same bucket.
-				if (bucketSize[((extractKey(*srcFirst) >> j) & bucketMask)] == uint32_t(last - srcFirst))
+				for(size_t i = 0; i < n; i++)
 				{
-					// Set flag to ensure histogram is computed for next digit position.
-					doSeparateHistogramCalculation = true;
+					const size_t nDigit = (size_t)((storage.key(i) >> nShift) & kDigitMask);
+					storage.move(i, (size_t)pPositions[nDigit]++);
 				}
-				else
-				{
-					// The histogram is either not needed or it will be calculated in parallel with the scatter operation below for better cache efficiency.
-					doSeparateHistogramCalculation = false;
 
-					// If this is the last digit position, then don't calculate a histogram
-					if (j == (8 * sizeof(IntegerType) - DigitBits))
-					{
-						bucketPosition[0] = 0;
-						for (i = 0; i < numBuckets - 1; i++)
-						{
-							bucketPosition[i + 1] = bucketPosition[i] + bucketSize[i];
-						}
+				storage.swap();
+				bInBuffer = !bInBuffer;
+			}
 
-						for (temp = srcFirst; temp != last; ++temp)
-						{
-							IntegerType key = extractKey(*temp);
-							const size_t digit = (key >> j) & bucketMask;
-							buffer[bucketPosition[digit]++] = *temp;
-						}
-					}
-					// Compute the histogram while performing the scatter operation
-					else
-					{
-						bucketPosition[0] = 0;
-						for (i = 0; i < numBuckets - 1; i++)
-						{
-							bucketPosition[i + 1] = bucketPosition[i] + bucketSize[i];
-							bucketSize[i] = 0;	// Clear the bucket for the next pass
-						}
+			return bInBuffer;
+		}
 
-						uint32_t jNext = j + DigitBits;
-						for (temp = srcFirst; temp != last; ++temp)
-						{
-							IntegerType key = extractKey(*temp);
-							const size_t digit = (key >> j) & bucketMask;
-							buffer[bucketPosition[digit]++] = *temp;
 
-							// Update histogram for the next scatter operation
-							++bucketSize[(extractKey(*temp) >> jNext) & bucketMask];
-						}
-					}
+		/// radix_sort_digits
+		///
+		/// Calls radix_sort_passes with counts of the smallest type which can hold n.
+		///
+		template <int DigitBits, typename Storage>
+		bool radix_sort_digits(Storage& storage, size_t n, int nKeyBits)
+		{
+			if(n < 2)
+				return false;
 
-					last = buffer + (last - srcFirst);
-					temp = srcFirst;
-					srcFirst = buffer;
-					buffer = temp;
-				}
-			}
+			if((uint64_t)n <= UINT32_MAX)
+				return radix_sort_passes<DigitBits, uint32_t>(storage, n, nKeyBits);
+			else
+				return radix_sort_passes<DigitBits, uint64_t>(storage, n, nKeyBits);
+		}
 
-			if (srcFirst != first)
-			{
-				// Copy values back into the expected buffer
-				for (temp = srcFirst; temp != last; ++temp)
-					*buffer++ = *temp;
-			}
+
+		/// radix_sort_adaptive
+		///
+		/// Calls radix_sort_digits with 11 bit digits for large ranges of 32 and 64 bit keys,
+		/// and with 8 bit digits otherwise.
+		///
+		template <typename Storage>
+		bool radix_sort_adaptive_impl(Storage& storage, size_t n, int nKeyBits, true_type)
+		{
+			if(n >= kRadixSortWideDigitMinCount)
+				return radix_sort_digits<11>(storage, n, nKeyBits);
+			else
+				return radix_sort_digits<8>(storage, n, nKeyBits);
 		}
+
+		template <typename Storage>
+		bool radix_sort_adaptive_impl(Storage& storage, size_t n, int nKeyBits, false_type)
+		{
+			return radix_sort_digits<8>(storage, n, nKeyBits);
+		}
+
+		template <typename Storage>
+		bool radix_sort_adaptive(Storage& storage, size_t n, int nKeyBits)
+		{
+			typedef integral_constant<bool, (sizeof(typename Storage::unsigned_type) >= 4)> wide_digits;
+
+			return radix_sort_adaptive_impl(storage, n, nKeyBits, wide_digits());
+		}
+
+
+		/// radix_sort_move_back
+		///
+		/// Moves the elements of storage from the buffer they were left in back to the source range.
+		///
+		template <typename Storage>
+		void radix_sort_move_back(Storage& storage, size_t n)
+		{
+			for(size_t i = 0; i < n; i++)
+				storage.move(i, i);
+		}
+
 	} // namespace Internal
 
 	template <typename RandomAccessIterator, typename ExtractKey, int DigitBits = 8>
@@ -1746,7 +2711,119 @@ namespace std
 	{
 		static_assert(DigitBits > 0, "DigitBits must be > 0");
 		static_assert(DigitBits <= (sizeof(typename ExtractKey::radix_type) * 8), "DigitBits must be <= the size of the key (in bits)");
-		std::Internal::radix_sort_impl<RandomAccessIterator, ExtractKey, DigitBits>(first, last, buffer, ExtractKey(), typename ExtractKey::radix_type());
+
+		typedef Internal::radix_sort_elements<RandomAccessIterator, ExtractKey> storage_type;
+
+		const size_t n = (size_t)(last - first);
+		storage_type storage(first, buffer, ExtractKey());
+
+		if(Internal::radix_sort_digits<DigitBits>(storage, n, (int)(sizeof(typename storage_type::unsigned_type) * 8)))
+			Internal::radix_sort_move_back(storage, n);
+	}
+
+	template <typename RandomAccessIterator, typename ExtractKey>
+	void radix_sort(RandomAccessIterator first, RandomAccessIterator last, RandomAccessIterator buffer, ExtractKey extractKey)
+	{
+		typedef Internal::radix_sort_elements<RandomAccessIterator, ExtractKey> storage_type;
+
+		const size_t n = (size_t)(last - first);
+		storage_type storage(first, buffer, extractKey);
+
+		if(Internal::radix_sort_adaptive(storage, n, (int)(sizeof(typename storage_type::unsigned_type) * 8)))
+			Internal::radix_sort_move_back(storage, n);
+	}
+
+	template <typename RandomAccessIterator>
+	inline void radix_sort(RandomAccessIterator first, RandomAccessIterator last, RandomAccessIterator buffer)
+	{
+		typedef typename std::iterator_traits<RandomAccessIterator>::value_type value_type;
+
+		std::radix_sort<RandomAccessIterator, Internal::radix_identity_key<value_type> >(first, last, buffer, Internal::radix_identity_key<value_type>());
+	}
+
+
+
+	/// radix_sort_by_key
+	///
+	/// Stably sorts the integral or floating point keys [keyFirst, keyLast) with radix_sort,
+	/// and applies the same reordering to the values starting at valueFirst. keyBuffer and 
+	/// valueBuffer are scratch space of the same size. This sorts keys and values stored 
+	/// in separate arrays without building an array of pairs, and moves only the small keys
+	/// when computing the histograms.
+	///
+	/// Example usage:
+	///     vector<int64_t>  timestamps(n), timestampBuffer(n);
+	///     vector<uint32_t> ids(n), idBuffer(n);
+	///
+	///     radix_sort_by_key(timestamps.begin(), timestamps.end(), ids.begin(), timestampBuffer.begin(), idBuffer.begin());
+	///
+	template <typename KeyIterator, typename ValueIterator>
+	void radix_sort_by_key(KeyIterator keyFirst, KeyIterator keyLast, ValueIterator valueFirst, KeyIterator keyBuffer, ValueIterator valueBuffer)
+	{
+		typedef Internal::radix_sort_pairs<KeyIterator, ValueIterator> storage_type;
+
+		const size_t n = (size_t)(keyLast - keyFirst);
+		storage_type storage(keyFirst, keyBuffer, valueFirst, valueBuffer);
+
+		if(Internal::radix_sort_adaptive(storage, n, (int)(sizeof(typename storage_type::unsigned_type) * 8)))
+			Internal::radix_sort_move_back(storage, n);
+	}
+
+
+
+	/// radix_argsort
+	///
+	/// Writes to [result, result + (last - first)) the indexes of the elements of 
+	/// [first, last) in the order radix_sort would put them, without moving the elements.
+	/// Elements with equal keys keep their relative order. The index type is the value
+	/// type of IndexIterator, and must be able to hold (last - first).
+	///
+	/// This allocates memory for two copies of the keys and of the indexes via the default allocator.
+	///
+	/// Example usage:
+	///     vector<Record>   records;
+	///     vector<uint32_t> order(records.size());
+	///
+	///     radix_argsort(records.begin(), records.end(), order.begin(), [](const Record& r) { return r.mTimestamp; });
+	///
+	template <typename RandomAccessIterator, typename IndexIterator, typename ExtractKey>
+	void radix_argsort(RandomAccessIterator first, RandomAccessIterator last, IndexIterator result, ExtractKey extractKey)
+	{
+		typedef typename Internal::radix_sort_elements<RandomAccessIterator, ExtractKey>::traits_type  traits_type;
+		typedef typename traits_type::unsigned_type                                                   unsigned_type;
+		typedef typename std::iterator_traits<IndexIterator>::value_type                              index_type;
+		typedef Internal::radix_sort_pairs<unsigned_type*, index_type*>                               storage_type;
+
+		const size_t n = (size_t)(last - first);
+
+		if(n)
+		{
+			EASTLAllocatorType& allocator = *get_default_allocator(0);
+			unsigned_type* const pKeys    = (unsigned_type*)allocate_memory(allocator, 2 * n * sizeof(unsigned_type), EASTL_ALIGN_OF(unsigned_type), 0);
+			index_type* const    pIndexes = (index_type*)allocate_memory(allocator, 2 * n * sizeof(index_type), EASTL_ALIGN_OF(index_type), 0);
+
+			for(size_t i = 0; i < n; i++)
+			{
+				pKeys[i]    = traits_type::encode(extractKey(first[i]));
+				pIndexes[i] = (index_type)i;
+			}
+
+			storage_type storage(pKeys, pKeys + n, pIndexes, pIndexes + n);
+			const index_type* const pSorted = Internal::radix_sort_adaptive(storage, n, (int)(sizeof(unsigned_type) * 8)) ? (pIndexes + n) : pIndexes;
+
+			std::copy(pSorted, pSorted + n, result);
+
+			EASTLFree(allocator, pIndexes, 2 * n * sizeof(index_type));
+			EASTLFree(allocator, pKeys, 2 * n * sizeof(unsigned_type));
+		}
+	}
+
+	template <typename RandomAccessIterator, typename IndexIterator>
+	inline void radix_argsort(RandomAccessIterator first, RandomAccessIterator last, IndexIterator result)
+	{
+		typedef typename std::iterator_traits<RandomAccessIterator>::value_type value_type;
+
+		std::radix_argsort(first, last, result, Internal::radix_identity_key<value_type>());
 	}
 
 
@@ -1882,10 +2959,11 @@ namespace std
 
 	/// sort
 	/// 
-	/// We use quick_sort by default. See quick_sort for details.
+	/// We use pdq_sort by default. See pdq_sort for details.
 	///
 	/// EASTL_DEFAULT_SORT_FUNCTION
-	/// If a default sort function is specified then call it, otherwise use EASTL's default quick_sort.
+	/// If a default sort function is specified then call it, otherwise use EASTL's default pdq_sort.
+	/// Define it to std::quick_sort for the sort used by earlier versions.
 	/// EASTL_DEFAULT_SORT_FUNCTION must be namespace-qualified and include any necessary template
 	/// parameters (e.g. std::comb_sort instead of just comb_sort), and it must be visible to this code. 
 	/// The EASTL_DEFAULT_SORT_FUNCTION must be provided in two versions: 
@@ -1901,7 +2979,7 @@ namespace std
 		#if defined(EASTL_DEFAULT_SORT_FUNCTION)
 			EASTL_DEFAULT_SORT_FUNCTION(first, last);
 		#else
-			std::quick_sort<RandomAccessIterator>(first, last);
+			std::pdq_sort<RandomAccessIterator>(first, last);
 		#endif
 	}
 
@@ -1911,7 +2989,7 @@ namespace std
 		#if defined(EASTL_DEFAULT_SORT_FUNCTION)
 			EASTL_DEFAULT_SORT_FUNCTION(first, last, compare);
 		#else
-			std::quick_sort<RandomAccessIterator, Compare>(first, last, compare);
+			std::pdq_sort<RandomAccessIterator, Compare>(first, last, compare);
 		#endif
 	}
 
@@ -0,0 +1,458 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements the following
+//     spsc_queue
+//     fixed_spsc_queue
+//
+// spsc_queue is a bounded queue which one producer thread and one consumer
+// thread can use at once without a mutex. Every operation is wait-free: it
+// completes in a bounded number of steps regardless of what the other thread
+// is doing, and fails rather than waits when the queue is full or empty.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_SPSC_QUEUE_H
+#define EASTL_SPSC_QUEUE_H
+
+
+#include <EABase/eabase.h>
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once
+#endif
+
+#include <EASTL/internal/config.h>
+#include <EASTL/allocator.h>
+#include <EASTL/atomic.h>
+#include <EASTL/span.h>
+#include <EASTL/type_traits.h>
+#include <EASTL/utility.h>
+
+
+
+namespace std
+{
+
+	/// EASTL_SPSC_QUEUE_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_SPSC_QUEUE_DEFAULT_NAME
+		#define EASTL_SPSC_QUEUE_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " spsc_queue" // Unless the user overrides something, this is "EASTL spsc_queue".
+	#endif
+
+
+	/// EASTL_SPSC_QUEUE_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_SPSC_QUEUE_DEFAULT_ALLOCATOR
+		#define EASTL_SPSC_QUEUE_DEFAULT_ALLOCATOR allocator_type(EASTL_SPSC_QUEUE_DEFAULT_NAME)
+	#endif
+
+
+
+	namespace Internal
+	{
+		///////////////////////////////////////////////////////////////////////
+		// spsc_queue_base
+		///////////////////////////////////////////////////////////////////////
+
+		/// spsc_queue_base
+		///
+		/// Implements the queue over a ring of slots provided by the subclass. The
+		/// ring's size is a power of two, so that an index maps to its slot with
+		/// a mask. The head (the index of the next element to pop) is written only
+		/// by the consumer and the tail (the index of the next slot to push to) only
+		/// by the producer. Both increase without wrapping to the ring's size, so
+		/// that tail - head is the element count and a full ring is told apart
+		/// from an empty one without giving up a slot.
+		///
+		/// Each index lives on its own cache line, together with the side's copy
+		/// of the other side's index as last read. The producer only reads mnHead
+		/// when its copy says the ring is full, and the consumer only reads mnTail
+		/// when its copy says the ring is empty, so that in a steady stream each
+		/// side takes a cache miss on the other's line once per lap rather than
+		/// upon every operation.
+		///
+		template <typename T>
+		class spsc_queue_base
+		{
+		public:
+			typedef spsc_queue_base<T>  this_type;
+			typedef T                   value_type;
+			typedef T&                  reference;
+			typedef const T&            const_reference;
+			typedef T*                  pointer;
+			typedef eastl_size_t        size_type;
+
+		public:
+			// Producer functions. These must only be called by one thread at a time.
+
+			/// try_push
+			///
+			/// Adds a copy of value to the back of the queue. Returns false without
+			/// doing anything if the queue is full.
+			///
+			bool try_push(const value_type& value)
+				{ return try_emplace(value); }
+
+			bool try_push(value_type&& value)
+				{ return try_emplace(std::move(value)); }
+
+
+			/// try_emplace
+			///
+			/// Constructs an element from args at the back of the queue. Returns
+			/// false without doing anything if the queue is full.
+			///
+			template <typename... Args>
+			bool try_emplace(Args&&... args)
+			{
+				const size_type nTail = mnTail.load(memory_order_relaxed);
+
+				if(EASTL_UNLIKELY((nTail - mnCachedHead) == mnCapacity))
+				{
+					mnCachedHead = mnHead.load(memory_order_acquire);
+
+					if((nTail - mnCachedHead) == mnCapacity)
+						return false;
+				}
+
+				::new(static_cast<void*>(mpBuffer + (nTail & (mnCapacity - 1)))) value_type(std::forward<Args>(args)...);
+				mnTail.store(nTail + 1, memory_order_release);
+				return true;
+			}
+
+
+			/// push_n
+			///
+			/// Adds copies of as many of the given values as fit to the back of the
+			/// queue, in order, and returns how many were added. All of them become
+			/// visible to the consumer at once.
+			///
+			size_type push_n(span<const value_type> values)
+			{
+				const size_type nTail = mnTail.load(memory_order_relaxed);
+				size_type       nCount = (size_type)values.size();
+
+				if((mnCapacity - (nTail - mnCachedHead)) < nCount)
+				{
+					mnCachedHead = mnHead.load(memory_order_acquire);
+
+					if((mnCapacity - (nTail - mnCachedHead)) < nCount)
+						nCount = mnCapacity - (nTail - mnCachedHead);
+				}
+
+				size_type i = 0;
+
+				#if EASTL_EXCEPTIONS_ENABLED
+					try
+					{
+				#endif
+						for(; i < nCount; i++)
+							::new(static_cast<void*>(mpBuffer + ((nTail + i) & (mnCapacity - 1)))) value_type(values[i]);
+				#if EASTL_EXCEPTIONS_ENABLED
+					}
+					catch(...)
+					{
+						while(i > 0)
+							mpBuffer[(nTail + --i) & (mnCapacity - 1)].~value_type();
+						throw;
+					}
+				#endif
+
+				if(nCount)
+					mnTail.store(nTail + nCount, memory_order_release);
+				return nCount;
+			}
+
+
+		public:
+			// Consumer functions. These must only be called by one thread at a time.
+
+			/// try_pop
+			///
+			/// Moves the front element into value and removes it. Returns false
+			/// without doing anything if the queue is empty.
+			///
+			bool try_pop(value_type& value)
+			{
+				value_type* const pValue = front();
+
+				if(pValue)
+				{
+					value = std::move(*pValue);
+					pop();
+					return true;
+				}
+
+				return false;
+			}
+
+
+			/// front
+			///
+			/// Returns the front element, or NULL if the queue is empty. The element
+			/// stays in place until pop is called, so the consumer can work on it
+			/// without moving it out.
+			///
+			value_type* front()
+			{
+				const size_type nHead = mnHead.load(memory_order_relaxed);
+
+				if(EASTL_UNLIKELY(nHead == mnCachedTail))
+				{
+					mnCachedTail = mnTail.load(memory_order_acquire);
+
+					if(nHead == mnCachedTail)
+						return NULL;
+				}
+
+				return mpBuffer + (nHead & (mnCapacity - 1));
+			}
+
+
+			/// pop
+			///
+			/// Removes the front element. front must have returned it beforehand.
+			///
+			void pop()
+			{
+				const size_type nHead = mnHead.load(memory_order_relaxed);
+
+				EASTL_ASSERT(nHead != mnCachedTail);
+				mpBuffer[nHead & (mnCapacity - 1)].~value_type();
+				mnHead.store(nHead + 1, memory_order_release);
+			}
+
+
+			/// pop_n
+			///
+			/// Moves up to values.size() elements from the front of the queue into
+			/// values, in order, removes them and returns how many there were. All
+			/// of their slots become free to the producer at once.
+			///
+			size_type pop_n(span<value_type> values)
+			{
+				const size_type nHead = mnHead.load(memory_order_relaxed);
+				size_type       nCount = (size_type)values.size();
+
+				if((mnCachedTail - nHead) < nCount)
+				{
+					mnCachedTail = mnTail.load(memory_order_acquire);
+
+					if((mnCachedTail - nHead) < nCount)
+						nCount = mnCachedTail - nHead;
+				}
+
+				size_type i = 0;
+
+				#if EASTL_EXCEPTIONS_ENABLED
+					try
+					{
+				#endif
+						for(; i < nCount; i++)
+						{
+							value_type& value = mpBuffer[(nHead + i) & (mnCapacity - 1)];
+							values[i] = std::move(value);
+							value.~value_type();
+						}
+				#if EASTL_EXCEPTIONS_ENABLED
+					}
+					catch(...)
+					{
+						// The elements moved out so far are removed, and the one which threw stays at the front.
+						mnHead.store(nHead + i, memory_order_release);
+						throw;
+					}
+				#endif
+
+				if(nCount)
+					mnHead.store(nHead + nCount, memory_order_release);
+				return nCount;
+			}
+
+
+		public:
+			// Functions which either thread may call. Unless called by the only
+			// thread using the queue, their results may be out of date on return.
+
+			/// size
+			/// Returns the number of elements in the queue.
+			size_type size() const
+			{
+				const size_type nHead = mnHead.load(memory_order_acquire); // Read before mnTail so that the difference can't be negative.
+				const size_type nSize = mnTail.load(memory_order_acquire) - nHead;
+
+				return (nSize < mnCapacity) ? nSize : mnCapacity;
+			}
+
+			bool empty() const
+				{ return mnTail.load(memory_order_acquire) == mnHead.load(memory_order_acquire); }
+
+			bool full() const
+				{ return size() == mnCapacity; }
+
+			/// capacity
+			/// Returns the maximum number of elements, which is a power of two.
+			size_type capacity() const
+				{ return mnCapacity; }
+
+		protected:
+			spsc_queue_base(value_type* pBuffer, size_type nCapacity)
+				: mpBuffer(pBuffer), mnCapacity(nCapacity), mnTail(0), mnCachedHead(0), mnHead(0), mnCachedTail(0)
+			{
+				EASTL_ASSERT((nCapacity != 0) && ((nCapacity & (nCapacity - 1)) == 0));
+			}
+
+			// Destroys the elements which are still in the queue. Subclasses call this before freeing the ring.
+			void DestroyElements()
+			{
+				for(size_type i = mnHead.load(memory_order_relaxed), iEnd = mnTail.load(memory_order_relaxed); i != iEnd; i++)
+					mpBuffer[i & (mnCapacity - 1)].~value_type();
+			}
+
+			spsc_queue_base(const this_type&);            // Not implemented.
+			this_type& operator=(const this_type&);       // Not implemented.
+
+		protected:
+			value_type*       mpBuffer;     // Neither is written after construction, so both threads can share this cache line.
+			const size_type   mnCapacity;
+			char              mPadding0[EA_CACHE_LINE_SIZE]; // Keeps the producer's line off the above.
+
+			atomic<size_type> mnTail;       // Written by the producer.
+			size_type         mnCachedHead; // The producer's copy of mnHead.
+			char              mPadding1[EA_CACHE_LINE_SIZE]; // Keeps the consumer's line off the producer's.
+
+			atomic<size_type> mnHead;       // Written by the consumer.
+			size_type         mnCachedTail; // The consumer's copy of mnTail.
+			char              mPadding2[EA_CACHE_LINE_SIZE]; // Keeps whatever follows the queue off the consumer's line.
+		};
+
+	} // namespace Internal
+
+
+
+	///////////////////////////////////////////////////////////////////////////
+	// spsc_queue
+	///////////////////////////////////////////////////////////////////////////
+
+	/// spsc_queue
+	///
+	/// Implements a bounded FIFO queue for passing elements from one thread (the
+	/// producer) to another (the consumer) without locking. The producer may call
+	/// try_push, try_emplace and push_n; the consumer may call try_pop, front,
+	/// pop and pop_n. Each is wait-free and returns a failure or partial count
+	/// instead of blocking, so the caller decides whether to spin, yield or do
+	/// other work. Unlike ring_buffer, the queue never overwrites elements.
+	/// It keeps its own ring rather than wrapping ring_buffer because ring_buffer
+	/// overwrites the oldest element when full and keeps its begin and end in one
+	/// object, where the producer and consumer would each write the other's index.
+	///
+	/// The ring is allocated by the constructor and its size is nCapacity rounded
+	/// up to a power of two. See fixed_spsc_queue for a version which holds its
+	/// ring inline.
+	///
+	/// Example usage:
+	///    spsc_queue<Request> queue(1024);
+	///
+	///    // I/O thread:
+	///    while(!queue.try_push(request))
+	///        cpu_pause();
+	///
+	///    // Worker thread:
+	///    Request requests[32];
+	///    for(size_t n; (n = queue.pop_n(requests)) != 0; )
+	///        Process(requests, n);
+	///
+	template <typename T, typename Allocator = EASTLAllocatorType>
+	class spsc_queue : public Internal::spsc_queue_base<T>
+	{
+	public:
+		typedef Internal::spsc_queue_base<T>  base_type;
+		typedef spsc_queue<T, Allocator>      this_type;
+		typedef typename base_type::size_type size_type;
+		typedef Allocator                     allocator_type;
+
+	public:
+		explicit spsc_queue(size_type nCapacity, const allocator_type& allocator = EASTL_SPSC_QUEUE_DEFAULT_ALLOCATOR)
+			: base_type(NULL, RoundUpCapacity(nCapacity)), mAllocator(allocator)
+		{
+			// The ring starts on a cache line, so that no other data shares its first and last lines.
+			this->mpBuffer = (T*)EASTLAllocAligned(mAllocator, this->mnCapacity * sizeof(T),
+			                                       (EASTL_ALIGN_OF(T) > EA_CACHE_LINE_SIZE) ? EASTL_ALIGN_OF(T) : EA_CACHE_LINE_SIZE, 0);
+		}
+
+	   ~spsc_queue()
+		{
+			this->DestroyElements();
+			EASTLFree(mAllocator, this->mpBuffer, this->mnCapacity * sizeof(T));
+		}
+
+		const allocator_type& get_allocator() const EA_NOEXCEPT
+			{ return mAllocator; }
+
+	protected:
+		static size_type RoundUpCapacity(size_type n)
+		{
+			size_type nCapacity = 1;
+			while(nCapacity < n)
+				nCapacity *= 2;
+			return nCapacity;
+		}
+
+		spsc_queue(const this_type&);            // Not implemented.
+		this_type& operator=(const this_type&);  // Not implemented.
+
+	protected:
+		allocator_type mAllocator;
+	};
+
+
+
+	///////////////////////////////////////////////////////////////////////////
+	// fixed_spsc_queue
+	///////////////////////////////////////////////////////////////////////////
+
+	/// fixed_spsc_queue
+	///
+	/// Implements an spsc_queue whose ring of nCapacity slots is a member, so
+	/// that it does no allocation. nCapacity must be a power of two.
+	///
+	/// Example usage:
+	///    fixed_spsc_queue<Message, 256> queue;
+	///
+	template <typename T, size_t nCapacity>
+	class fixed_spsc_queue : public Internal::spsc_queue_base<T>
+	{
+		static_assert((nCapacity != 0) && ((nCapacity & (nCapacity - 1)) == 0), "fixed_spsc_queue capacity must be a power of two.");
+
+	public:
+		typedef Internal::spsc_queue_base<T>  base_type;
+		typedef fixed_spsc_queue<T, nCapacity> this_type;
+
+	public:
+		fixed_spsc_queue()
+			: base_type(reinterpret_cast<T*>(mBuffer), nCapacity)
+		{
+		}
+
+	   ~fixed_spsc_queue()
+		{
+			this->DestroyElements();
+		}
+
+	protected:
+		fixed_spsc_queue(const this_type&);            // Not implemented.
+		this_type& operator=(const this_type&);        // Not implemented.
+
+	protected:
+		typename aligned_storage<sizeof(T), EASTL_ALIGN_OF(T)>::type mBuffer[nCapacity];
+	};
+
+
+} // namespace std
+
+
+#endif // Header include guard
@@ -31,6 +31,9 @@
 //    - basic_string has a force_size() function, which unilaterally moves the string
 //      end position (mpEnd) to the given location. Useful for when the user writes
 //      into the string via some external means such as C strcpy or sprintf.
+//    - basic_string has resize_default_init() and append_uninitialized() functions,
+//      which grow the string without filling the new characters. Useful for when the
+//      user fills the string via some external means such as read() or decompression.
 //    - basic_string substr() deviates from the standard and returns a string with
 //		a copy of this->get_allocator()
 ///////////////////////////////////////////////////////////////////////////////
@@ -132,6 +135,7 @@ EA_DISABLE_VC_WARNING(4530 4480 4571 4267 4702);
 
 #include <EASTL/internal/char_traits.h>
 #include <EASTL/string_view.h>
+#include <EASTL/utf.h>
 
 ///////////////////////////////////////////////////////////////////////////////
 // EASTL_STRING_EXPLICIT
@@ -599,6 +603,8 @@ namespace std
 		void      reserve(size_type = 0);
 		void      set_capacity(size_type n = npos); // Revises the capacity to the user-specified value. Resizes the container to match the capacity if the requested capacity n is less than the current size. If n == npos then the capacity is reallocated (if necessary) such that capacity == size.
 		void      force_size(size_type n);          // Unilaterally moves the string end position (mpEnd) to the given location. Useful for when the user writes into the string via some extenal means such as C strcpy or sprintf. This allows for more efficient use than using resize to achieve this.
+		void      resize_default_init(size_type n); // Same as resize(n), except that new characters are left uninitialized instead of being set to 0. The string remains 0-terminated. Unlike force_size, this grows the capacity as needed.
+		void      resize_for_overwrite(size_type n);// Same as resize_default_init(n). Named after the C++20 make_unique_for_overwrite.
 		void shrink_to_fit();
 
 		// Raw access
@@ -627,6 +633,7 @@ namespace std
 		this_type& append(const value_type* p);
 		this_type& append(size_type n, value_type c);
 		this_type& append(const value_type* pBegin, const value_type* pEnd);
+		pointer    append_uninitialized(size_type n); // Grows the string by n uninitialized characters and returns a pointer to the first of them, for the user to write into. The string remains 0-terminated.
 
 		this_type& append_sprintf_va_list(const value_type* pFormat, va_list arguments);
 		this_type& append_sprintf(const value_type* pFormat, ...);
@@ -1356,6 +1363,25 @@ namespace std
 	}
 
 
+	template <typename T, typename Allocator>
+	void basic_string<T, Allocator>::resize_default_init(size_type n)
+	{
+		const size_type s = internalLayout().GetSize();
+
+		if(n < s)
+			erase(internalLayout().BeginPtr() + n, internalLayout().EndPtr());
+		else if(n > s)
+			append_uninitialized(n - s);
+	}
+
+
+	template <typename T, typename Allocator>
+	inline void basic_string<T, Allocator>::resize_for_overwrite(size_type n)
+	{
+		resize_default_init(n);
+	}
+
+
 	template <typename T, typename Allocator>
 	void basic_string<T, Allocator>::reserve(size_type n)
 	{
@@ -1667,6 +1693,22 @@ namespace std
 		// program and the higher level application code should be verifying UTF8 string validity,
 		// and thus we should do the friendly thing and ignore the invalid characters as opposed
 		// to making the user of this function handle exceptions that are easily forgotten.
+		//
+		// Valid text in another encoding is converted directly into the string, once the length
+		// it converts to is known. Otherwise it's converted a buffer at a time by DecodePart,
+		// which replaces invalid code points with 0xffff.
+
+		typedef typename Internal::utf_char_type<OtherCharType>::type other_utf_type;
+		typedef typename Internal::utf_char_type<value_type>::type    utf_type;
+
+		const other_utf_type* const pOtherUtf = reinterpret_cast<const other_utf_type*>(pOther);
+
+		if(!is_same<other_utf_type, utf_type>::value && Internal::utf_validate(pOtherUtf, (size_t)n))
+		{
+			const size_type nLength = (size_type)Internal::utf_length(pOtherUtf, (size_t)n, (const utf_type*)NULL);
+			Internal::utf_transcode(pOtherUtf, (size_t)n, reinterpret_cast<utf_type*>(append_uninitialized(nLength)));
+			return *this;
+		}
 
 		const size_t         kBufferSize = 512;
 		value_type           selfBuffer[kBufferSize];   // This assumes that value_type is one of char8_t, char16_t, char32_t, or wchar_t. Or more importantly, a type with a trivial constructor and destructor.
@@ -1741,6 +1783,23 @@ namespace std
 	}
 
 
+	template <typename T, typename Allocator>
+	typename basic_string<T, Allocator>::pointer
+	basic_string<T, Allocator>::append_uninitialized(size_type n)
+	{
+		const size_type nSize     = internalLayout().GetSize();
+		const size_type nCapacity = capacity();
+
+		if((nSize + n) > nCapacity)
+			reserve(GetNewCapacity(nCapacity, (nSize + n) - nCapacity));
+
+		pointer const pTail = internalLayout().EndPtr();
+		internalLayout().SetSize(nSize + n);
+		*internalLayout().EndPtr() = 0;
+		return pTail;
+	}
+
+
 	template <typename T, typename Allocator>
 	basic_string<T, Allocator>& basic_string<T, Allocator>::append_sprintf_va_list(const value_type* pFormat, va_list arguments)
 	{
@@ -2652,7 +2711,7 @@ namespace std
 
 		if(EASTL_LIKELY(((npos - n) >= position) && (position + n) <= internalLayout().GetSize())) // If the range is valid...
 		{
-			const value_type* const pTemp = std::search(internalLayout().BeginPtr() + position, internalLayout().EndPtr(), p, p + n);
+			const value_type* const pTemp = CharTypeStringSearch(internalLayout().BeginPtr() + position, internalLayout().EndPtr(), p, p + n);
 
 			if((pTemp != internalLayout().EndPtr()) || (n == 0))
 				return (size_type)(pTemp - internalLayout().BeginPtr());
@@ -3385,34 +3444,22 @@ namespace std
 	// CharTypeStringFindEnd
 	// Specialized char version of STL find() from back function.
 	// Not the same as RFind because search range is specified as forward iterators.
+	// The search functions below forward to those of char_traits.h, whose char versions use SIMD.
 	template <typename T, typename Allocator>
-	const typename basic_string<T, Allocator>::value_type*
+	inline const typename basic_string<T, Allocator>::value_type*
 	basic_string<T, Allocator>::CharTypeStringFindEnd(const value_type* pBegin, const value_type* pEnd, value_type c)
 	{
-		const value_type* pTemp = pEnd;
-		while(--pTemp >= pBegin)
-		{
-			if(*pTemp == c)
-				return pTemp;
-		}
-
-		return pEnd;
+		return std::CharTypeStringFindEnd(pBegin, pEnd, c);
 	}
 
 
 	// CharTypeStringRFind
 	// Specialized value_type version of STL find() function in reverse.
 	template <typename T, typename Allocator>
-	const typename basic_string<T, Allocator>::value_type*
+	inline const typename basic_string<T, Allocator>::value_type*
 	basic_string<T, Allocator>::CharTypeStringRFind(const value_type* pRBegin, const value_type* pREnd, const value_type c)
 	{
-		while(pRBegin > pREnd)
-		{
-			if(*(pRBegin - 1) == c)
-				return pRBegin;
-			--pRBegin;
-		}
-		return pREnd;
+		return std::CharTypeStringRFind(pRBegin, pREnd, c);
 	}
 
 
@@ -3420,47 +3467,11 @@ namespace std
 	// Specialized value_type version of STL search() function.
 	// Purpose: find p2 within p1. Return p1End if not found or if either string is zero length.
 	template <typename T, typename Allocator>
-	const typename basic_string<T, Allocator>::value_type*
+	inline const typename basic_string<T, Allocator>::value_type*
 	basic_string<T, Allocator>::CharTypeStringSearch(const value_type* p1Begin, const value_type* p1End,
 													 const value_type* p2Begin, const value_type* p2End)
 	{
-		// Test for zero length strings, in which case we have a match or a failure,
-		// but the return value is the same either way.
-		if((p1Begin == p1End) || (p2Begin == p2End))
-			return p1Begin;
-
-		// Test for a pattern of length 1.
-		if((p2Begin + 1) == p2End)
-			return std::find(p1Begin, p1End, *p2Begin);
-
-		// General case.
-		const value_type* pTemp;
-		const value_type* pTemp1 = (p2Begin + 1);
-		const value_type* pCurrent = p1Begin;
-
-		while(p1Begin != p1End)
-		{
-			p1Begin = std::find(p1Begin, p1End, *p2Begin);
-			if(p1Begin == p1End)
-				return p1End;
-
-			pTemp = pTemp1;
-			pCurrent = p1Begin;
-			if(++pCurrent == p1End)
-				return p1End;
-
-			while(*pCurrent == *pTemp)
-			{
-				if(++pTemp == p2End)
-					return p1Begin;
-				if(++pCurrent == p1End)
-					return p1End;
-			}
-
-			++p1Begin;
-		}
-
-		return p1Begin;
+		return std::CharTypeStringSearch(p1Begin, p1End, p2Begin, p2End);
 	}
 
 
@@ -3468,49 +3479,11 @@ namespace std
 	// Specialized value_type version of STL find_end() function (which really is a reverse search function).
 	// Purpose: find last instance of p2 within p1. Return p1End if not found or if either string is zero length.
 	template <typename T, typename Allocator>
-	const typename basic_string<T, Allocator>::value_type*
+	inline const typename basic_string<T, Allocator>::value_type*
 	basic_string<T, Allocator>::CharTypeStringRSearch(const value_type* p1Begin, const value_type* p1End,
 													  const value_type* p2Begin, const value_type* p2End)
 	{
-		// Test for zero length strings, in which case we have a match or a failure,
-		// but the return value is the same either way.
-		if((p1Begin == p1End) || (p2Begin == p2End))
-			return p1Begin;
-
-		// Test for a pattern of length 1.
-		if((p2Begin + 1) == p2End)
-			return CharTypeStringFindEnd(p1Begin, p1End, *p2Begin);
-
-		// Test for search string length being longer than string length.
-		if((p2End - p2Begin) > (p1End - p1Begin))
-			return p1End;
-
-		// General case.
-		const value_type* pSearchEnd = (p1End - (p2End - p2Begin) + 1);
-		const value_type* pCurrent1;
-		const value_type* pCurrent2;
-
-		while(pSearchEnd != p1Begin)
-		{
-			// Search for the last occurrence of *p2Begin.
-			pCurrent1 = CharTypeStringFindEnd(p1Begin, pSearchEnd, *p2Begin);
-			if(pCurrent1 == pSearchEnd) // If the first char of p2 wasn't found,
-				return p1End;           // then we immediately have failure.
-
-			// In this case, *pTemp == *p2Begin. So compare the rest.
-			pCurrent2 = p2Begin;
-			while(*pCurrent1++ == *pCurrent2++)
-			{
-				if(pCurrent2 == p2End)
-					return (pCurrent1 - (p2End - p2Begin));
-			}
-
-			// A smarter algorithm might know to subtract more than just one,
-			// but in most cases it won't make much difference anyway.
-			--pSearchEnd;
-		}
-
-		return p1End;
+		return std::CharTypeStringRSearch(p1Begin, p1End, p2Begin, p2End);
 	}
 
 
@@ -3518,19 +3491,11 @@ namespace std
 	// Specialized value_type version of STL find_first_of() function.
 	// This function is much like the C runtime strtok function, except the strings aren't null-terminated.
 	template <typename T, typename Allocator>
-	const typename basic_string<T, Allocator>::value_type*
+	inline const typename basic_string<T, Allocator>::value_type*
 	basic_string<T, Allocator>::CharTypeStringFindFirstOf(const value_type* p1Begin, const value_type* p1End,
 														  const value_type* p2Begin, const value_type* p2End)
 	{
-		for( ; p1Begin != p1End; ++p1Begin)
-		{
-			for(const value_type* pTemp = p2Begin; pTemp != p2End; ++pTemp)
-			{
-				if(*p1Begin == *pTemp)
-					return p1Begin;
-			}
-		}
-		return p1End;
+		return std::CharTypeStringFindFirstOf(p1Begin, p1End, p2Begin, p2End);
 	}
 
 
@@ -3538,19 +3503,11 @@ namespace std
 	// Specialized value_type version of STL find_first_of() function in reverse.
 	// This function is much like the C runtime strtok function, except the strings aren't null-terminated.
 	template <typename T, typename Allocator>
-	const typename basic_string<T, Allocator>::value_type*
+	inline const typename basic_string<T, Allocator>::value_type*
 	basic_string<T, Allocator>::CharTypeStringRFindFirstOf(const value_type* p1RBegin, const value_type* p1REnd,
 														   const value_type* p2Begin,  const value_type* p2End)
 	{
-		for( ; p1RBegin != p1REnd; --p1RBegin)
-		{
-			for(const value_type* pTemp = p2Begin; pTemp != p2End; ++pTemp)
-			{
-				if(*(p1RBegin - 1) == *pTemp)
-					return p1RBegin;
-			}
-		}
-		return p1REnd;
+		return std::CharTypeStringRFindFirstOf(p1RBegin, p1REnd, p2Begin, p2End);
 	}
 
 
@@ -3558,44 +3515,22 @@ namespace std
 	// CharTypeStringFindFirstNotOf
 	// Specialized value_type version of STL find_first_not_of() function.
 	template <typename T, typename Allocator>
-	const typename basic_string<T, Allocator>::value_type*
+	inline const typename basic_string<T, Allocator>::value_type*
 	basic_string<T, Allocator>::CharTypeStringFindFirstNotOf(const value_type* p1Begin, const value_type* p1End,
 															 const value_type* p2Begin, const value_type* p2End)
 	{
-		for( ; p1Begin != p1End; ++p1Begin)
-		{
-			const value_type* pTemp;
-			for(pTemp = p2Begin; pTemp != p2End; ++pTemp)
-			{
-				if(*p1Begin == *pTemp)
-					break;
-			}
-			if(pTemp == p2End)
-				return p1Begin;
-		}
-		return p1End;
+		return std::CharTypeStringFindFirstNotOf(p1Begin, p1End, p2Begin, p2End);
 	}
 
 
 	// CharTypeStringRFindFirstNotOf
 	// Specialized value_type version of STL find_first_not_of() function in reverse.
 	template <typename T, typename Allocator>
-	const typename basic_string<T, Allocator>::value_type*
+	inline const typename basic_string<T, Allocator>::value_type*
 	basic_string<T, Allocator>::CharTypeStringRFindFirstNotOf(const value_type* p1RBegin, const value_type* p1REnd,
 															  const value_type* p2Begin,  const value_type* p2End)
 	{
-		for( ; p1RBegin != p1REnd; --p1RBegin)
-		{
-			const value_type* pTemp;
-			for(pTemp = p2Begin; pTemp != p2End; ++pTemp)
-			{
-				if(*(p1RBegin-1) == *pTemp)
-					break;
-			}
-			if(pTemp == p2End)
-				return p1RBegin;
-		}
-		return p1REnd;
+		return std::CharTypeStringRFindFirstNotOf(p1RBegin, p1REnd, p2Begin, p2End);
 	}
 
 
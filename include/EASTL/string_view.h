@@ -214,7 +214,7 @@ namespace std
 			auto* pEnd = mpBegin + mnCount;
 			if (EASTL_LIKELY(((npos - sw.size()) >= pos) && (pos + sw.size()) <= mnCount))
 			{
-				const value_type* const pTemp = std::search(mpBegin + pos, pEnd, sw.data(), sw.data() + sw.size());
+				const value_type* const pTemp = CharTypeStringSearch(mpBegin + pos, pEnd, sw.data(), sw.data() + sw.size());
 
 				if ((pTemp != pEnd) || (sw.size() == 0))
 					return (size_type)(pTemp - mpBegin);
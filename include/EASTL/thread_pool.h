@@ -0,0 +1,429 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements thread_pool, a work-stealing pool of threads which
+// runs fork-join parallel loops. It is the executor behind the parallel
+// execution policy (see execution.h), and can be used directly via its
+// parallel_for and parallel_invoke functions.
+//
+// Each participating thread owns a Chase-Lev deque of tasks. A thread which
+// forks work pushes tasks onto the bottom of its own deque and pops them
+// back in LIFO order, while idle threads steal from the top of other threads'
+// deques. Pushing and popping one's own deque costs no atomic read-modify-write
+// in the common case, and stealing takes the oldest and thus largest pieces
+// of work, so tasks rarely migrate more than once.
+//
+// The thread which calls parallel_for participates in running its tasks, so a
+// pool with N workers runs loops on N + 1 threads.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_THREAD_POOL_H
+#define EASTL_THREAD_POOL_H
+
+
+#include <EABase/eabase.h>
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once
+#endif
+
+#include <EASTL/internal/config.h>
+#include <EASTL/internal/thread_support.h>
+#include <EASTL/atomic.h>
+#include <EASTL/utility.h>
+
+
+// 4275 - non dll-interface class used as base for DLL-interface classkey 'identifier'
+EA_DISABLE_VC_WARNING(4275);
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// EASTL_THREAD_POOL_AVAILABLE
+//
+// Defined as 0 or 1. Identifies if thread_pool can create threads on this
+// platform. If not, thread_pool has no workers and parallel_for runs the
+// whole loop on the calling thread.
+//
+#ifndef EASTL_THREAD_POOL_AVAILABLE
+	#if EASTL_THREAD_SUPPORT_AVAILABLE && (defined(EA_PLATFORM_MICROSOFT) || defined(EA_PLATFORM_POSIX)) && !defined(EA_COMPILER_NO_THREAD_LOCAL)
+		#define EASTL_THREAD_POOL_AVAILABLE 1
+	#else
+		#define EASTL_THREAD_POOL_AVAILABLE 0
+	#endif
+#endif
+
+
+///////////////////////////////////////////////////////////////////////////////
+// EASTL_THREAD_POOL_DEQUE_SIZE
+//
+// The capacity of each thread's task deque. Must be a power of two. Forking
+// pushes one task per halving of a range, so even deeply nested loops use
+// only a few dozen entries. Should a deque fill up, tasks are run in place
+// instead of being pushed.
+//
+#ifndef EASTL_THREAD_POOL_DEQUE_SIZE
+	#define EASTL_THREAD_POOL_DEQUE_SIZE 1024
+#endif
+
+
+///////////////////////////////////////////////////////////////////////////////
+// EASTL_THREAD_POOL_DEFAULT_WORKER_COUNT
+//
+// The number of worker threads of thread_pool::get_default(). If not defined
+// by the user, it is one less than the number of hardware threads, as the
+// calling thread makes up the difference.
+//
+// #define EASTL_THREAD_POOL_DEFAULT_WORKER_COUNT 7
+
+
+
+namespace std
+{
+	class thread_pool;
+
+	namespace Internal
+	{
+		struct thread_pool_context;
+
+
+		/// thread_pool_task
+		///
+		/// A unit of work pushed onto a thread_pool_deque. Tasks are owned by the frame
+		/// which forks them (usually on its stack), which waits for mnPending to drop
+		/// to zero before returning, so tasks need no allocation.
+		///
+		struct thread_pool_task
+		{
+			void (*mpRun)(thread_pool_task* pTask, thread_pool_context* pContext);
+			atomic<int32_t>* mpPending; // Decremented once the task has run.
+		};
+
+
+		/// thread_pool_deque
+		///
+		/// A fixed capacity Chase-Lev work-stealing deque, as described by Lê, Pop,
+		/// Cohen and Zappa Nardelli in "Correct and Efficient Work-Stealing for Weak
+		/// Memory Models" (PPoPP 2013). push and pop may only be called by the owning
+		/// thread; steal may be called by any thread.
+		///
+		class thread_pool_deque
+		{
+		public:
+			enum { kCapacity = EASTL_THREAD_POOL_DEQUE_SIZE };
+
+			thread_pool_deque()
+				: mnTop(0), mnBottom(0)
+			{
+				static_assert((kCapacity & (kCapacity - 1)) == 0, "EASTL_THREAD_POOL_DEQUE_SIZE must be a power of two.");
+			}
+
+			// Returns false if the deque is full.
+			bool push(thread_pool_task* pTask)
+			{
+				const intptr_t b = mnBottom.load(memory_order_relaxed);
+				const intptr_t t = mnTop.load(memory_order_acquire);
+
+				if((b - t) >= (intptr_t)kCapacity)
+					return false;
+
+				mTasks[b & (kCapacity - 1)].store(pTask, memory_order_relaxed);
+				atomic_thread_fence(memory_order_release);
+				mnBottom.store(b + 1, memory_order_relaxed);
+				return true;
+			}
+
+			thread_pool_task* pop()
+			{
+				const intptr_t b = mnBottom.load(memory_order_relaxed) - 1;
+				mnBottom.store(b, memory_order_relaxed);
+				atomic_thread_fence(memory_order_seq_cst);
+				intptr_t t = mnTop.load(memory_order_relaxed);
+
+				if(t <= b)
+				{
+					thread_pool_task* pTask = mTasks[b & (kCapacity - 1)].load(memory_order_relaxed);
+
+					if(t == b) // If this is the last task then we race thieves for it.
+					{
+						if(!mnTop.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed))
+							pTask = NULL;
+						mnBottom.store(b + 1, memory_order_relaxed);
+					}
+
+					return pTask;
+				}
+
+				mnBottom.store(b + 1, memory_order_relaxed);
+				return NULL;
+			}
+
+			thread_pool_task* steal()
+			{
+				intptr_t t = mnTop.load(memory_order_acquire);
+				atomic_thread_fence(memory_order_seq_cst);
+				const intptr_t b = mnBottom.load(memory_order_acquire);
+
+				if(t < b)
+				{
+					thread_pool_task* const pTask = mTasks[t & (kCapacity - 1)].load(memory_order_relaxed);
+
+					if(mnTop.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed))
+						return pTask;
+				}
+
+				return NULL; // Empty, or we lost a race with the owner or another thief.
+			}
+
+			bool empty() const
+			{
+				return mnBottom.load(memory_order_relaxed) <= mnTop.load(memory_order_relaxed);
+			}
+
+		protected:
+			atomic<intptr_t> mnTop;
+			char             mPadding[EA_CACHE_LINE_SIZE]; // Keeps thieves' writes to mnTop off the owner's cache line.
+			atomic<intptr_t> mnBottom;
+			atomic<thread_pool_task*> mTasks[kCapacity];
+		};
+
+	} // namespace Internal
+
+
+
+	/// thread_pool
+	///
+	/// A pool of worker threads which cooperatively run fork-join parallel loops.
+	///
+	/// Worker threads are started by the constructor and sleep while there is no
+	/// work. Any thread may call parallel_for or parallel_invoke, including from
+	/// within a task of the same pool (nested parallelism). Calls from threads
+	/// which aren't workers of the pool are serialized with respect to each other,
+	/// as such a caller borrows the pool's single caller slot while it runs.
+	///
+	/// Tasks must not throw exceptions, and must not block on one another other
+	/// than via nested parallel_for or parallel_invoke.
+	///
+	/// Example usage:
+	///    thread_pool pool(4);
+	///    pool.parallel_for(v.size(), 4096, [&](size_t begin, size_t end)
+	///    {
+	///        for(size_t i = begin; i < end; ++i)
+	///            v[i] = Score(v[i]);
+	///    });
+	///
+	class EASTL_API thread_pool
+	{
+	public:
+		/// thread_pool
+		///
+		/// Starts nWorkerCount worker threads. A value of -1 selects one less than
+		/// the number of hardware threads. A value of 0 creates a pool which runs
+		/// everything on the calling thread.
+		///
+		explicit thread_pool(int nWorkerCount = -1);
+	   ~thread_pool();
+
+		/// worker_count
+		/// Returns the number of worker threads.
+		size_t worker_count() const { return mnWorkerCount; }
+
+		/// concurrency
+		/// Returns the number of threads which run a loop, which includes the caller.
+		size_t concurrency() const { return mnWorkerCount + 1; }
+
+		/// parallel_for
+		///
+		/// Calls function(begin, end) for disjoint subranges which together cover
+		/// [0, n), in parallel. Ranges are split in halves until they are no larger
+		/// than nGrainSize (or 1 if nGrainSize is 0). A pool without workers makes
+		/// a single call for the whole range. Returns once all calls have returned.
+		///
+		template <typename Function>
+		void parallel_for(size_t n, size_t nGrainSize, Function function);
+
+		/// parallel_invoke
+		///
+		/// Calls function1() and function2() in parallel and returns once both have
+		/// returned.
+		///
+		template <typename Function1, typename Function2>
+		void parallel_invoke(Function1 function1, Function2 function2);
+
+		/// hardware_concurrency
+		/// Returns the number of hardware threads, or 1 if it isn't known.
+		static size_t hardware_concurrency();
+
+		/// get_default
+		///
+		/// Returns the pool used by the parallel execution policy unless another is
+		/// specified. It is created upon first use with EASTL_THREAD_POOL_DEFAULT_WORKER_COUNT
+		/// workers, and lives until program exit.
+		///
+		static thread_pool& get_default();
+
+	public:
+		// The following are used by the task templates below and are not intended for users.
+		Internal::thread_pool_context* Enter(Internal::thread_pool_context*& pPrevious);
+		void Leave(Internal::thread_pool_context* pContext, Internal::thread_pool_context* pPrevious);
+		void Spawn(Internal::thread_pool_context* pContext, Internal::thread_pool_task* pTask);
+		void Wait(Internal::thread_pool_context* pContext, atomic<int32_t>& nPending);
+
+		static void Execute(Internal::thread_pool_task* pTask, Internal::thread_pool_context* pContext)
+		{
+			atomic<int32_t>* const pPending = pTask->mpPending;
+			pTask->mpRun(pTask, pContext);
+			pPending->fetch_sub(1, memory_order_release); // pTask may be gone after this.
+		}
+
+	protected:
+		thread_pool(const thread_pool&);            // Not implemented.
+		thread_pool& operator=(const thread_pool&); // Not implemented.
+
+		friend struct Internal::thread_pool_context;
+
+		Internal::thread_pool_task* FindWork(Internal::thread_pool_context* pContext);
+		void WorkerLoop(Internal::thread_pool_context* pContext);
+
+	protected:
+		size_t                         mnWorkerCount;
+		size_t                         mnContextCount;  // The number of contexts allocated. Context 0 is the caller slot, the rest are workers.
+		Internal::thread_pool_context* mpContexts;
+		void*                          mpPlatformData;  // Threads and the primitives which idle workers sleep on.
+		atomic<uint32_t>               mnWorkEpoch;     // Incremented upon every Spawn. Sleeping workers wait for it to change.
+		atomic<int32_t>                mnSleepingCount;
+		atomic<bool>                   mbShutdown;
+	};
+
+
+
+	namespace Internal
+	{
+		/// thread_pool_for_task
+		///
+		/// Runs a parallel_for subrange, splitting it further as long as it's larger
+		/// than the grain size.
+		///
+		template <typename Function>
+		struct thread_pool_for_task : public thread_pool_task
+		{
+			thread_pool* mpPool;
+			Function*    mpFunction;
+			size_t       mnBegin;
+			size_t       mnEnd;
+			size_t       mnGrainSize;
+
+			static void Run(thread_pool_task* pTask, thread_pool_context* pContext)
+			{
+				thread_pool_for_task* const pThis = static_cast<thread_pool_for_task*>(pTask);
+				RunRange(pThis->mpPool, pContext, *pThis->mpFunction, pThis->mnBegin, pThis->mnEnd, pThis->mnGrainSize);
+			}
+
+			static void RunRange(thread_pool* pPool, thread_pool_context* pContext, Function& function, size_t nBegin, size_t nEnd, size_t nGrainSize)
+			{
+				// Halving a range of size_t indices needs at most one task per bit.
+				thread_pool_for_task tasks[sizeof(size_t) * 8];
+				atomic<int32_t>      nPending(0);
+				int                  nTaskCount = 0;
+
+				while((nEnd - nBegin) > nGrainSize)
+				{
+					const size_t nMiddle = nBegin + ((nEnd - nBegin) / 2);
+					thread_pool_for_task& task = tasks[nTaskCount++];
+
+					task.mpRun       = &thread_pool_for_task::Run;
+					task.mpPending   = &nPending;
+					task.mpPool      = pPool;
+					task.mpFunction  = &function;
+					task.mnBegin     = nMiddle;
+					task.mnEnd       = nEnd;
+					task.mnGrainSize = nGrainSize;
+
+					nPending.fetch_add(1, memory_order_relaxed);
+					pPool->Spawn(pContext, &task);
+					nEnd = nMiddle;
+				}
+
+				function(nBegin, nEnd);
+
+				if(nTaskCount)
+					pPool->Wait(pContext, nPending);
+			}
+		};
+
+
+		/// thread_pool_invoke_task
+		///
+		template <typename Function>
+		struct thread_pool_invoke_task : public thread_pool_task
+		{
+			Function* mpFunction;
+
+			static void Run(thread_pool_task* pTask, thread_pool_context*)
+			{
+				(*static_cast<thread_pool_invoke_task*>(pTask)->mpFunction)();
+			}
+		};
+
+	} // namespace Internal
+
+
+
+	template <typename Function>
+	inline void thread_pool::parallel_for(size_t n, size_t nGrainSize, Function function)
+	{
+		if(nGrainSize == 0)
+			nGrainSize = 1;
+
+		if((n <= nGrainSize) || (mnWorkerCount == 0))
+		{
+			if(n)
+				function((size_t)0, n);
+			return;
+		}
+
+		Internal::thread_pool_context* pPrevious;
+		Internal::thread_pool_context* const pContext = Enter(pPrevious);
+
+		Internal::thread_pool_for_task<Function>::RunRange(this, pContext, function, 0, n, nGrainSize);
+
+		Leave(pContext, pPrevious);
+	}
+
+
+	template <typename Function1, typename Function2>
+	inline void thread_pool::parallel_invoke(Function1 function1, Function2 function2)
+	{
+		if(mnWorkerCount == 0)
+		{
+			function1();
+			function2();
+			return;
+		}
+
+		Internal::thread_pool_context* pPrevious;
+		Internal::thread_pool_context* const pContext = Enter(pPrevious);
+
+		atomic<int32_t> nPending(1);
+		Internal::thread_pool_invoke_task<Function2> task;
+		task.mpRun      = &Internal::thread_pool_invoke_task<Function2>::Run;
+		task.mpPending  = &nPending;
+		task.mpFunction = &function2;
+
+		Spawn(pContext, &task);
+		function1();
+		Wait(pContext, nPending);
+
+		Leave(pContext, pPrevious);
+	}
+
+
+} // namespace std
+
+
+EA_RESTORE_VC_WARNING();
+
+
+#endif // Header include guard
@@ -0,0 +1,130 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file declares functions which validate text in UTF-8 (char), UTF-16
+// (char16_t) and UTF-32 (char32_t), give the length of its conversion to the
+// other encodings, and convert it. basic_string's append_convert and
+// assign_convert use them, as does DecodePart.
+//
+// Text is valid if it's a sequence of Unicode scalar values (code points up
+// to 0x10FFFF, other than the surrogates 0xD800-0xDFFF), encoded in the
+// shortest form, and in UTF-16 with each surrogate in a pair.
+//
+// With EASTL_SIMD_ENABLED, UTF-8 is validated 32 bytes per step with AVX2,
+// and runs of ASCII (and for UTF-16 to UTF-32 and back, of code points below
+// 0x10000) are converted 16 or 32 elements per step, with SSE2 or AVX2.
+//
+// Example usage:
+//     const size_t nLength = utf16_length_from_utf8(p, n); // p must be valid.
+//     vector<char16_t> v(nLength);
+//     utf8_to_utf16(p, n, v.data());
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_UTF_H
+#define EASTL_UTF_H
+
+
+#include <EASTL/internal/config.h>
+#include <stddef.h>
+#include <string.h>
+
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace std
+{
+	/// utf8_validate / utf16_validate / utf32_validate
+	///
+	/// Return true if the n elements at p are valid text.
+	///
+	EASTL_API bool utf8_validate (const char*     p, size_t n);
+	EASTL_API bool utf16_validate(const char16_t* p, size_t n);
+	EASTL_API bool utf32_validate(const char32_t* p, size_t n);
+
+
+	/// utf8_length_from_utf16, etc.
+	///
+	/// Return the number of elements which the n elements at p convert to, which
+	/// must be valid text.
+	///
+	EASTL_API size_t utf8_length_from_utf16 (const char16_t* p, size_t n);
+	EASTL_API size_t utf8_length_from_utf32 (const char32_t* p, size_t n);
+	EASTL_API size_t utf16_length_from_utf8 (const char*     p, size_t n);
+	EASTL_API size_t utf16_length_from_utf32(const char32_t* p, size_t n);
+	EASTL_API size_t utf32_length_from_utf8 (const char*     p, size_t n);
+	EASTL_API size_t utf32_length_from_utf16(const char16_t* p, size_t n);
+
+
+	/// utf8_to_utf16, etc.
+	///
+	/// Convert the n elements at pSrc, and return the number of elements written
+	/// to pDest, which must have room for them (see utf16_length_from_utf8, etc.).
+	/// Return 0, having written nothing, if the source isn't valid text.
+	///
+	EASTL_API size_t utf8_to_utf16 (const char*     pSrc, size_t n, char16_t* pDest);
+	EASTL_API size_t utf8_to_utf32 (const char*     pSrc, size_t n, char32_t* pDest);
+	EASTL_API size_t utf16_to_utf8 (const char16_t* pSrc, size_t n, char*     pDest);
+	EASTL_API size_t utf16_to_utf32(const char16_t* pSrc, size_t n, char32_t* pDest);
+	EASTL_API size_t utf32_to_utf8 (const char32_t* pSrc, size_t n, char*     pDest);
+	EASTL_API size_t utf32_to_utf16(const char32_t* pSrc, size_t n, char16_t* pDest);
+
+
+
+	namespace Internal
+	{
+		/// utf_char_type
+		///
+		/// Whichever of char, char16_t and char32_t has the size, and so the encoding, of
+		/// the char type T, as with DecodePart: char8_t is UTF-8, wchar_t is UTF-16 or
+		/// UTF-32, and int is UTF-32.
+		///
+		template <typename T, size_t nSize = sizeof(T)> struct utf_char_type { };
+		template <typename T> struct utf_char_type<T, 1> { typedef char     type; };
+		template <typename T> struct utf_char_type<T, 2> { typedef char16_t type; };
+		template <typename T> struct utf_char_type<T, 4> { typedef char32_t type; };
+
+
+		/// utf_transcode
+		///
+		/// Converts the n elements at pSrc, which must be valid text, and returns the number
+		/// of elements written to pDest.
+		///
+		EASTL_API size_t utf_transcode(const char*     pSrc, size_t n, char16_t* pDest);
+		EASTL_API size_t utf_transcode(const char*     pSrc, size_t n, char32_t* pDest);
+		EASTL_API size_t utf_transcode(const char16_t* pSrc, size_t n, char*     pDest);
+		EASTL_API size_t utf_transcode(const char16_t* pSrc, size_t n, char32_t* pDest);
+		EASTL_API size_t utf_transcode(const char32_t* pSrc, size_t n, char*     pDest);
+		EASTL_API size_t utf_transcode(const char32_t* pSrc, size_t n, char16_t* pDest);
+
+
+		// The above functions by encoding, for append_convert. It copies text of the same
+		// encoding, but they're defined for it too, so that it compiles.
+		inline bool utf_validate(const char*     p, size_t n) { return utf8_validate(p, n);  }
+		inline bool utf_validate(const char16_t* p, size_t n) { return utf16_validate(p, n); }
+		inline bool utf_validate(const char32_t* p, size_t n) { return utf32_validate(p, n); }
+
+		inline size_t utf_length(const char*     p, size_t n, const char16_t*) { return utf16_length_from_utf8(p, n);  }
+		inline size_t utf_length(const char*     p, size_t n, const char32_t*) { return utf32_length_from_utf8(p, n);  }
+		inline size_t utf_length(const char16_t* p, size_t n, const char*)     { return utf8_length_from_utf16(p, n);  }
+		inline size_t utf_length(const char16_t* p, size_t n, const char32_t*) { return utf32_length_from_utf16(p, n); }
+		inline size_t utf_length(const char32_t* p, size_t n, const char*)     { return utf8_length_from_utf32(p, n);  }
+		inline size_t utf_length(const char32_t* p, size_t n, const char16_t*) { return utf16_length_from_utf32(p, n); }
+
+		template <typename T>
+		inline size_t utf_length(const T*, size_t n, const T*) { return n; }
+
+		template <typename T>
+		inline size_t utf_transcode(const T* pSrc, size_t n, T* pDest) { memmove(pDest, pSrc, n * sizeof(T)); return n; }
+
+	} // namespace Internal
+
+} // namespace std
+
+
+#endif // Header include guard
@@ -26,6 +26,9 @@
 //    - vector has a set_capacity() function which frees excess capacity. 
 //      The only way to do this with std::vector is via the cryptic non-obvious 
 //      trick of using: vector<SomeClass>(x).swap(x);
+//    - vector has resize_default_init() and append_uninitialized() functions,
+//      which add elements without value-initializing them. Useful for when the
+//      user fills the elements via some external means such as read() or memcpy.
 ///////////////////////////////////////////////////////////////////////////////
 
 
@@ -169,6 +172,21 @@ namespace std
 
 
 
+	namespace Internal
+	{
+		/// vector_can_reallocate
+		///
+		/// Identifies if vector storage can be resized by the allocator's reallocate function instead of
+		/// an allocate-move-free cycle. This requires elements that can be relocated via a bitwise copy,
+		/// and that need no more than the system alignment, as that is all reallocate guarantees.
+		///
+		template <typename T, typename Allocator>
+		struct vector_can_reallocate
+			: public integral_constant<bool, has_trivial_relocate<T>::value && allocator_has_reallocate<Allocator>::value &&
+			                                 (EASTL_ALIGN_OF(T) <= EASTL_SYSTEM_ALLOCATOR_MIN_ALIGNMENT)> {};
+	}
+
+
 	/// vector
 	///
 	/// Implements a dynamic array.
@@ -254,6 +272,8 @@ namespace std
 
 		void resize(size_type n, const value_type& value);
 		void resize(size_type n);
+		void resize_default_init(size_type n);              // Same as resize(n), except that new elements are default-initialized instead of value-initialized. For scalar types this means they are left uninitialized, which avoids writing memory that the user is going to overwrite anyway.
+		void resize_for_overwrite(size_type n);             // Same as resize_default_init(n). Named after the C++20 make_unique_for_overwrite.
 		void reserve(size_type n);
 		void set_capacity(size_type n = base_type::npos);   // Revises the capacity to the user-specified value. Resizes the container to match the capacity if the requested capacity n is less than the current size. If n == npos then the capacity is reallocated (if necessary) such that capacity == size.
 		void shrink_to_fit();                               // C++11 function which is the same as set_capacity().
@@ -276,6 +296,7 @@ namespace std
 		void      push_back(const value_type& value);
 		reference push_back();
 		void*     push_back_uninitialized();
+		pointer   append_uninitialized(size_type n);     // Appends n default-initialized elements and returns a pointer to the first of them, for the user to write into. For scalar types the elements are left uninitialized.
 		void      push_back(value_type&& value);
 		void      pop_back();
 
@@ -381,6 +402,10 @@ namespace std
 
 		void DoGrow(size_type n);
 
+		typedef Internal::vector_can_reallocate<T, Allocator> reallocate_tag;
+
+		bool DoReallocate(size_type n);
+
 		void DoSwap(this_type& x);
 
 	}; // class vector
@@ -829,6 +854,43 @@ namespace std
 	}
 
 
+	template <typename T, typename Allocator>
+	inline void vector<T, Allocator>::resize_default_init(size_type n)
+	{
+		if(n > (size_type)(mpEnd - mpBegin))
+			append_uninitialized(n - ((size_type)(mpEnd - mpBegin)));
+		else
+		{
+			std::destruct(mpBegin + n, mpEnd);
+			mpEnd = mpBegin + n;
+		}
+	}
+
+
+	template <typename T, typename Allocator>
+	inline void vector<T, Allocator>::resize_for_overwrite(size_type n)
+	{
+		resize_default_init(n);
+	}
+
+
+	template <typename T, typename Allocator>
+	typename vector<T, Allocator>::pointer
+	vector<T, Allocator>::append_uninitialized(size_type n)
+	{
+		if(n > size_type(internalCapacityPtr() - mpEnd))
+		{
+			const size_type nPrevSize = size_type(mpEnd - mpBegin);
+			DoGrow(std::max(GetNewCapacity(nPrevSize), nPrevSize + n));
+		}
+
+		pointer const pTail = mpEnd;
+		std::uninitialized_default_construct_n(pTail, n);
+		mpEnd += n;
+		return pTail;
+	}
+
+
 	template <typename T, typename Allocator>
 	void vector<T, Allocator>::reserve(size_type n)
 	{
@@ -850,7 +912,7 @@ namespace std
 
 			shrink_to_fit();
 		}
-		else // Else new capacity > size.
+		else if(!DoReallocate(n)) // Else new capacity > size.
 		{
 			pointer const pNewData = DoRealloc(n, mpBegin, mpEnd, should_move_tag());
 			std::destruct(mpBegin, mpEnd);
@@ -1725,6 +1787,9 @@ namespace std
 	template <typename T, typename Allocator>
 	void vector<T, Allocator>::DoGrow(size_type n)
 	{
+		if(DoReallocate(n))
+			return;
+
 		pointer const pNewData = DoAllocate(n);
 
 		pointer pNewEnd = std::uninitialized_move_ptr_if_noexcept(mpBegin, mpEnd, pNewData);
@@ -1738,6 +1803,30 @@ namespace std
 	}
 
 
+	template <typename T, typename Allocator>
+	bool vector<T, Allocator>::DoReallocate(size_type n)
+	{
+		// Only trivially relocatable elements can be moved by reallocate's bitwise copy.
+		// If we have no storage yet, the regular allocation path is just as good.
+		if(reallocate_tag::value && mpBegin)
+		{
+			const size_type nPrevSize     = size_type(mpEnd - mpBegin);
+			const size_type nPrevCapacity = size_type(internalCapacityPtr() - mpBegin);
+			pointer const   pNewData      = (pointer)reallocate_memory(internalAllocator(), mpBegin, nPrevCapacity * sizeof(T), n * sizeof(T));
+
+			if(pNewData)
+			{
+				mpBegin    = pNewData;
+				mpEnd      = pNewData + nPrevSize;
+				internalCapacityPtr() = pNewData + n;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+
 	template <typename T, typename Allocator>
 	inline void vector<T, Allocator>::DoSwap(this_type& x)
 	{
@@ -1756,6 +1845,16 @@ namespace std
 			const size_type nPrevSize = size_type(mpEnd - mpBegin);
 			const size_type nGrowSize = GetNewCapacity(nPrevSize);
 			const size_type nNewSize = std::max(nGrowSize, nPrevSize + n);
+
+			if(reallocate_tag::value)
+			{
+				const value_type valueCopy(value); // value may refer to one of our elements, which DoGrow may relocate.
+				DoGrow(nNewSize);
+				std::uninitialized_fill_n_ptr(mpEnd, n, valueCopy);
+				mpEnd += n;
+				return;
+			}
+
 			pointer const pNewData = DoAllocate(nNewSize);
 
 			#if EASTL_EXCEPTIONS_ENABLED
@@ -1799,6 +1898,15 @@ namespace std
 			const size_type nPrevSize = size_type(mpEnd - mpBegin);
 			const size_type nGrowSize = GetNewCapacity(nPrevSize);
 			const size_type nNewSize = std::max(nGrowSize, nPrevSize + n);
+
+			if(reallocate_tag::value)
+			{
+				DoGrow(nNewSize);
+				std::uninitialized_default_fill_n(mpEnd, n);
+				mpEnd += n;
+				return;
+			}
+
 			pointer const pNewData = DoAllocate(nNewSize);
 
 			#if EASTL_EXCEPTIONS_ENABLED
@@ -1913,6 +2021,16 @@ namespace std
 	{
 		const size_type nPrevSize = size_type(mpEnd - mpBegin);
 		const size_type nNewSize  = GetNewCapacity(nPrevSize);
+
+		if(reallocate_tag::value)
+		{
+			value_type value(std::forward<Args>(args)...); // args may refer to one of our elements, which DoGrow may relocate.
+			DoGrow(nNewSize);
+			::new((void*)mpEnd) value_type(std::move(value));
+			++mpEnd;
+			return;
+		}
+
 		pointer const   pNewData  = DoAllocate(nNewSize);
 
 		#if EASTL_EXCEPTIONS_ENABLED
@@ -234,6 +234,7 @@ namespace std
 		void      push_back(const value_type& value) = delete;
 		reference push_back()                        = delete;
 		void*     push_back_uninitialized()          = delete;
+		pointer   append_uninitialized(size_type)    = delete;
 		template <class... Args>
 		reference emplace_back(Args&&...)            = delete;
 
@@ -0,0 +1,211 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#if !defined(_GNU_SOURCE)
+	#define _GNU_SOURCE // mremap and MREMAP_MAYMOVE are GNU extensions.
+#endif
+
+#include <EASTL/internal/config.h>
+#include <EASTL/allocator_mmap.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if EASTL_MMAP_ALLOCATOR_AVAILABLE
+	#include <sys/mman.h>
+	#include <unistd.h>
+#endif
+
+
+namespace std
+{
+
+	mmap_allocator::mmap_allocator(const char* EASTL_NAME(pName), bool bUseHugePages)
+		: mbUseHugePages(bUseHugePages)
+	{
+		#if EASTL_NAME_ENABLED
+			mpName = pName ? pName : "mmap_allocator";
+		#endif
+	}
+
+
+	mmap_allocator::mmap_allocator(const mmap_allocator& x)
+		: mbUseHugePages(x.mbUseHugePages)
+	{
+		#if EASTL_NAME_ENABLED
+			mpName = x.mpName;
+		#endif
+	}
+
+
+	mmap_allocator::mmap_allocator(const mmap_allocator& x, const char* EASTL_NAME(pName))
+		: mbUseHugePages(x.mbUseHugePages)
+	{
+		#if EASTL_NAME_ENABLED
+			mpName = pName ? pName : "mmap_allocator";
+		#endif
+	}
+
+
+	mmap_allocator& mmap_allocator::operator=(const mmap_allocator& x)
+	{
+		#if EASTL_NAME_ENABLED
+			mpName = x.mpName;
+		#endif
+		mbUseHugePages = x.mbUseHugePages;
+		return *this;
+	}
+
+
+	const char* mmap_allocator::get_name() const
+	{
+		#if EASTL_NAME_ENABLED
+			return mpName;
+		#else
+			return "mmap_allocator";
+		#endif
+	}
+
+
+	void mmap_allocator::set_name(const char* EASTL_NAME(pName))
+	{
+		#if EASTL_NAME_ENABLED
+			mpName = pName;
+		#endif
+	}
+
+
+	size_t mmap_allocator::get_page_size()
+	{
+		#if EASTL_MMAP_ALLOCATOR_AVAILABLE
+			static const size_t sPageSize = (size_t)sysconf(_SC_PAGESIZE);
+			return sPageSize;
+		#else
+			return 4096;
+		#endif
+	}
+
+
+	void* mmap_allocator::DoMap(size_t n)
+	{
+		#if EASTL_MMAP_ALLOCATOR_AVAILABLE
+			void* const p = mmap(NULL, n, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+			if(p == MAP_FAILED)
+				return NULL;
+
+			#if defined(MADV_HUGEPAGE)
+				if(mbUseHugePages && (n >= EASTL_MMAP_ALLOCATOR_HUGE_PAGE_SIZE))
+					madvise(p, n, MADV_HUGEPAGE); // This is only advice; failure (e.g. THP disabled) leaves us with regular pages.
+			#endif
+
+			return p;
+		#else
+			return malloc(n);
+		#endif
+	}
+
+
+	void mmap_allocator::DoUnmap(void* p, size_t n)
+	{
+		#if EASTL_MMAP_ALLOCATOR_AVAILABLE
+			munmap(p, n);
+		#else
+			EA_UNUSED(n);
+			free(p);
+		#endif
+	}
+
+
+	void* mmap_allocator::allocate(size_t n, int /*flags*/)
+	{
+		if(n < EASTL_MMAP_ALLOCATOR_THRESHOLD)
+			return malloc(n);
+		return DoMap(n);
+	}
+
+
+	void* mmap_allocator::allocate(size_t n, size_t alignment, size_t alignmentOffset, int flags)
+	{
+		if((alignmentOffset % alignment) != 0)
+			return NULL;
+
+		#if EASTL_MMAP_ALLOCATOR_AVAILABLE
+			// Mappings are page aligned.
+			if(n >= EASTL_MMAP_ALLOCATOR_THRESHOLD)
+				return (alignment <= get_page_size()) ? DoMap(n) : NULL;
+
+			// Small blocks must be freeable with free, as deallocate and reallocate can't tell
+			// them apart. posix_memalign provides such blocks with greater than system alignment.
+			if(alignment > EASTL_SYSTEM_ALLOCATOR_MIN_ALIGNMENT)
+			{
+				void* p = NULL;
+				return (posix_memalign(&p, alignment, n) == 0) ? p : NULL;
+			}
+		#endif
+
+		// Without mappings all blocks come from malloc, which provides the system alignment only.
+		return (alignment <= EASTL_SYSTEM_ALLOCATOR_MIN_ALIGNMENT) ? allocate(n, flags) : NULL;
+	}
+
+
+	void mmap_allocator::deallocate(void* p, size_t n)
+	{
+		if(p)
+		{
+			if(n < EASTL_MMAP_ALLOCATOR_THRESHOLD)
+				free(p);
+			else
+				DoUnmap(p, n);
+		}
+	}
+
+
+	void* mmap_allocator::reallocate(void* p, size_t oldSize, size_t newSize, int flags)
+	{
+		if(!p)
+			return allocate(newSize, flags);
+
+		#if EASTL_MMAP_ALLOCATOR_AVAILABLE
+			const bool bOldMapped = (oldSize >= EASTL_MMAP_ALLOCATOR_THRESHOLD);
+			const bool bNewMapped = (newSize >= EASTL_MMAP_ALLOCATOR_THRESHOLD);
+
+			if(!bOldMapped && !bNewMapped)
+				return realloc(p, newSize);
+
+			if(bOldMapped && bNewMapped)
+			{
+				// The kernel extends the mapping in place if the following address range is free,
+				// else it moves the page table entries to a new range. Either way no data is copied.
+				void* const pNew = mremap(p, oldSize, newSize, MREMAP_MAYMOVE);
+
+				if(pNew == MAP_FAILED)
+					return NULL;
+
+				#if defined(MADV_HUGEPAGE)
+					if(mbUseHugePages && (newSize >= EASTL_MMAP_ALLOCATOR_HUGE_PAGE_SIZE))
+						madvise(pNew, newSize, MADV_HUGEPAGE);
+				#endif
+
+				return pNew;
+			}
+
+			// The block moves between malloc and a mapping, and so we have no choice but to copy it.
+			void* const pNew = allocate(newSize, flags);
+
+			if(pNew)
+			{
+				memcpy(pNew, p, (oldSize < newSize) ? oldSize : newSize);
+				deallocate(p, oldSize);
+			}
+
+			return pNew;
+		#else
+			// Without mappings all blocks come from malloc.
+			EA_UNUSED(oldSize);
+			return realloc(p, newSize);
+		#endif
+	}
+
+} // namespace std
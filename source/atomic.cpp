@@ -4,6 +4,22 @@
 
 
 #include <EASTL/atomic.h>
+#include <EASTL/internal/thread_support.h>
+
+#if defined(EA_PLATFORM_LINUX)
+	#include <linux/futex.h>
+	#include <sys/syscall.h>
+	#include <unistd.h>
+	#include <limits.h>
+#elif defined(EA_PLATFORM_MICROSOFT)
+	EA_DISABLE_ALL_VC_WARNINGS();
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#include <Windows.h>
+	EA_RESTORE_ALL_VC_WARNINGS();
+	#pragma comment(lib, "Synchronization.lib") // WaitOnAddress
+#endif
 
 
 namespace std
@@ -20,6 +36,147 @@ static void EastlCompilerBarrierDataDependencyFunc(void*)
 volatile CompilerBarrierDataDependencyFuncPtr gCompilerBarrierDataDependencyFunc = &EastlCompilerBarrierDataDependencyFunc;
 
 
+/////////////////////////////////////////////////////////////////////////////////
+// atomic_wait_slow / atomic_notify_slow
+//
+// Every address waited upon hashes to a bucket which counts the threads that
+// may be waiting on it, so that a notify with nobody waiting costs one fence
+// and one load rather than a system call. Waiters increment the count before
+// they load the value for the last time, and notifiers load the count after
+// they store the value, each with a full fence in between, so that a notifier
+// which sees no waiter is certain that any later waiter sees the new value.
+//
+// On Linux, a 4-byte value is waited upon with a futex on the value itself. The
+// futex API can't wait on other sizes, for which waiters instead sleep on the
+// bucket's version, which notifiers increment. Several addresses may share a
+// bucket, so such notifies wake all the bucket's waiters, which recheck their
+// own values. Windows's WaitOnAddress waits on 1, 2, 4 and 8 byte values itself.
+//
+namespace
+{
+	struct AtomicWaitBucket
+	{
+		std::atomic<uint32_t> mnWaiterCount;
+		std::atomic<uint32_t> mnVersion;
+		char                  mPadding[EA_CACHE_LINE_SIZE - (2 * sizeof(uint32_t))]; // Keeps buckets off each other's lines.
+	};
+
+	const size_t kAtomicWaitBucketCount = 256; // Must be a power of two.
+
+	EA_ALIGN(EA_CACHE_LINE_SIZE) AtomicWaitBucket gAtomicWaitBuckets[kAtomicWaitBucketCount];
+
+	AtomicWaitBucket& GetAtomicWaitBucket(const void* pAddress)
+	{
+		uintptr_t n = reinterpret_cast<uintptr_t>(pAddress);
+		n ^= (n >> 16);
+		n *= static_cast<uintptr_t>(0x45d9f3b);
+		n ^= (n >> 16);
+		return gAtomicWaitBuckets[(n >> 2) & (kAtomicWaitBucketCount - 1)]; // The low bits are mostly alignment.
+	}
+
+	#if defined(EA_PLATFORM_LINUX)
+		void FutexWait(const void* pAddress, uint32_t nExpected)
+		{
+			// Returns when woken, or immediately if *pAddress != nExpected, or spuriously.
+			syscall(SYS_futex, pAddress, FUTEX_WAIT_PRIVATE, nExpected, NULL, NULL, 0);
+		}
+
+		void FutexWake(const void* pAddress, bool bAll)
+		{
+			syscall(SYS_futex, pAddress, FUTEX_WAKE_PRIVATE, bAll ? INT_MAX : 1, NULL, NULL, 0);
+		}
+	#endif
+
+	bool IsDirectlyWaitable(size_t size)
+	{
+		#if defined(EA_PLATFORM_LINUX)
+			return (size == 4);
+		#elif defined(EA_PLATFORM_MICROSOFT)
+			return (size == 1) || (size == 2) || (size == 4) || (size == 8);
+		#else
+			EA_UNUSED(size);
+			return false;
+		#endif
+	}
+}
+
+
+EASTL_API void atomic_wait_slow(const void* pAddress, size_t size, AtomicWaitChangedFunc pfnChanged,
+								const void* pAtomicObj, const void* pOld) EA_NOEXCEPT
+{
+	AtomicWaitBucket& bucket = GetAtomicWaitBucket(pAddress);
+
+	bucket.mnWaiterCount.fetch_add(1, std::memory_order_seq_cst);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	for (;;)
+	{
+		if (IsDirectlyWaitable(size))
+		{
+			if (pfnChanged(pAtomicObj, pOld))
+				break;
+
+			#if defined(EA_PLATFORM_LINUX)
+				FutexWait(pAddress, *static_cast<const uint32_t*>(pOld));
+			#elif defined(EA_PLATFORM_MICROSOFT)
+				WaitOnAddress(const_cast<void*>(pAddress), const_cast<void*>(pOld), size, INFINITE);
+			#endif
+		}
+		else
+		{
+			const uint32_t nVersion = bucket.mnVersion.load(std::memory_order_seq_cst);
+
+			if (pfnChanged(pAtomicObj, pOld))
+				break;
+
+			#if defined(EA_PLATFORM_LINUX)
+				FutexWait(&bucket.mnVersion, nVersion);
+			#elif defined(EA_PLATFORM_MICROSOFT)
+				WaitOnAddress(&bucket.mnVersion, const_cast<uint32_t*>(&nVersion), sizeof(nVersion), INFINITE);
+			#else
+				EA_UNUSED(nVersion);
+				std::Internal::thread_yield();
+			#endif
+		}
+	}
+
+	bucket.mnWaiterCount.fetch_sub(1, std::memory_order_relaxed);
+}
+
+
+EASTL_API void atomic_notify_slow(const void* pAddress, size_t size, bool bAll) EA_NOEXCEPT
+{
+	AtomicWaitBucket& bucket = GetAtomicWaitBucket(pAddress);
+
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	if (bucket.mnWaiterCount.load(std::memory_order_relaxed) == 0)
+		return;
+
+	if (IsDirectlyWaitable(size))
+	{
+		#if defined(EA_PLATFORM_LINUX)
+			FutexWake(pAddress, bAll);
+		#elif defined(EA_PLATFORM_MICROSOFT)
+			if (bAll)
+				WakeByAddressAll(const_cast<void*>(pAddress));
+			else
+				WakeByAddressSingle(const_cast<void*>(pAddress));
+		#endif
+	}
+	else
+	{
+		bucket.mnVersion.fetch_add(1, std::memory_order_seq_cst);
+
+		#if defined(EA_PLATFORM_LINUX)
+			FutexWake(&bucket.mnVersion, true);
+		#elif defined(EA_PLATFORM_MICROSOFT)
+			WakeByAddressAll(&bucket.mnVersion);
+		#endif
+	}
+}
+
+
 } // namespace internal
 
 } // namespace std
@@ -5,6 +5,7 @@
 
 #include <EASTL/internal/fixed_pool.h>
 #include <EASTL/fixed_allocator.h>
+#include <EASTL/concurrent_fixed_pool.h>
 
 
 
@@ -50,6 +51,254 @@ namespace std
 	}
 
 
+	///////////////////////////////////////////////////////////////////////////
+	// concurrent_fixed_pool
+	///////////////////////////////////////////////////////////////////////////
+
+	concurrent_fixed_pool::concurrent_fixed_pool(void* pMemory)
+		: mShared()
+		, mpNext((Link*)pMemory)
+		, mpBegin((Link*)pMemory)
+		, mpCapacity((Link*)pMemory)
+		, mnNodeSize(0) // This is normally set in the init function.
+	{
+		for(size_t i = 0; i < kCacheCount; i++)
+			mCache[i].mpHead = NULL;
+
+		#if EASTL_FIXED_SIZE_TRACKING_ENABLED
+			mnCurrentSize.store(0, memory_order_relaxed);
+			mnPeakSize.store(0, memory_order_relaxed);
+		#endif
+	}
+
+
+	concurrent_fixed_pool::concurrent_fixed_pool(void* pMemory, size_t memorySize, size_t nodeSize,
+												 size_t alignment, size_t alignmentOffset)
+		: mShared()
+		, mpNext(NULL)
+		, mpBegin(NULL)
+		, mpCapacity(NULL)
+		, mnNodeSize(0)
+	{
+		init(pMemory, memorySize, nodeSize, alignment, alignmentOffset);
+	}
+
+
+	void concurrent_fixed_pool::init(void* pMemory, size_t memorySize, size_t nodeSize,
+									 size_t alignment, size_t alignmentOffset)
+	{
+		// We use fixed_pool_base to do the node size and alignment calculations, 
+		// so that the two pools carve a given block into the same nodes.
+		fixed_pool_base layout;
+		layout.init(pMemory, memorySize, nodeSize, alignment, alignmentOffset);
+
+		const TaggedLink emptyList = { NULL, 0 };
+
+		mShared.store(emptyList, memory_order_relaxed);
+		mpNext.store(layout.mpNext, memory_order_relaxed);
+		mpBegin    = layout.mpNext;
+		mpCapacity = layout.mpCapacity;
+		mnNodeSize = layout.mnNodeSize;
+
+		for(size_t i = 0; i < kCacheCount; i++)
+		{
+			mCache[i].mnLocked.store(0, memory_order_relaxed);
+			mCache[i].mnCount.store(0, memory_order_relaxed);
+			mCache[i].mpHead = NULL;
+		}
+
+		#if EASTL_FIXED_SIZE_TRACKING_ENABLED
+			mnCurrentSize.store(0, memory_order_relaxed);
+			mnPeakSize.store(0, memory_order_relaxed);
+		#endif
+
+		atomic_thread_fence(memory_order_release);
+	}
+
+
+	size_t concurrent_fixed_pool::GetThreadCacheIndex()
+	{
+		#if !defined(EA_COMPILER_NO_THREAD_LOCAL)
+			// Threads are numbered in the order in which they first use any pool, which 
+			// spreads the first kCacheCount threads over distinct caches.
+			static atomic<uint32_t> sThreadCount(0);
+			static thread_local uint32_t sThreadIndex = sThreadCount.fetch_add(1, memory_order_relaxed);
+
+			return sThreadIndex;
+		#else
+			// Thread stacks are typically at least 64 KB apart, so the address of a 
+			// local variable identifies the thread well enough for spreading contention.
+			char c;
+			return (size_t)((uintptr_t)&c >> 16);
+		#endif
+	}
+
+
+	concurrent_fixed_pool::Link* concurrent_fixed_pool::Refill(Cache& cache)
+	{
+		// The cache is locked by us and empty.
+		TaggedLink chain = PopShared(kBatchSize);
+		size_t     nCount = (size_t)chain.mnTag;
+
+		if(!chain.mpHead)
+			chain.mpHead = Carve(kBatchSize, nCount);
+
+		if(chain.mpHead)
+		{
+			cache.mpHead = chain.mpHead->mpNext;
+			cache.mnCount.store((uint32_t)(nCount - 1), memory_order_relaxed);
+		}
+
+		return chain.mpHead;
+	}
+
+
+	void concurrent_fixed_pool::Drain(Cache& cache)
+	{
+		// The cache is locked by us and holds at least kBatchSize nodes.
+		Link* const pFirst = cache.mpHead;
+		Link*       pLast  = pFirst;
+
+		for(size_t i = 1; i < kBatchSize; i++)
+			pLast = pLast->mpNext;
+
+		cache.mpHead = pLast->mpNext;
+		cache.mnCount.store(cache.mnCount.load(memory_order_relaxed) - (uint32_t)kBatchSize, memory_order_relaxed);
+
+		PushShared(pFirst, pLast);
+	}
+
+
+	concurrent_fixed_pool::Link* concurrent_fixed_pool::AllocateSlow()
+	{
+		size_t nCount;
+		Link*  pLink = Carve(1, nCount);
+
+		if(!pLink)
+			pLink = PopShared(1).mpHead;
+
+		// Free nodes may remain in the caches of other threads. We take one from 
+		// the first cache we find that has any, rather than fail the allocation.
+		for(size_t i = 0; !pLink && (i < kCacheCount); i++)
+		{
+			Cache& cache = mCache[i];
+
+			if(cache.mnCount.load(memory_order_relaxed) && (cache.mnLocked.exchange(1, memory_order_acquire) == 0))
+			{
+				pLink = cache.mpHead;
+
+				if(pLink)
+				{
+					cache.mpHead = pLink->mpNext;
+					cache.mnCount.store(cache.mnCount.load(memory_order_relaxed) - 1, memory_order_relaxed);
+				}
+
+				cache.mnLocked.store(0, memory_order_release);
+			}
+		}
+
+		return pLink;
+	}
+
+
+	concurrent_fixed_pool::Link* concurrent_fixed_pool::Carve(size_t nMaxCount, size_t& nCount)
+	{
+		Link* pCurrent = mpNext.load(memory_order_relaxed);
+		Link* pEnd;
+
+		do {
+			if(pCurrent == mpCapacity)
+			{
+				nCount = 0;
+				return NULL;
+			}
+
+			const size_t nAvailable = (size_t)((char*)mpCapacity - (char*)pCurrent) / mnNodeSize;
+
+			nCount = (nAvailable < nMaxCount) ? nAvailable : nMaxCount;
+			pEnd   = (Link*)((char*)pCurrent + (nCount * mnNodeSize));
+		} while(!mpNext.compare_exchange_weak(pCurrent, pEnd, memory_order_relaxed, memory_order_relaxed));
+
+		// The nodes from pCurrent to pEnd are now ours alone.
+		for(Link* pLink = pCurrent; pLink != pEnd; )
+		{
+			Link* const pNext = (Link*)((char*)pLink + mnNodeSize);
+			pLink->mpNext = (pNext != pEnd) ? pNext : NULL;
+			pLink = pNext;
+		}
+
+		return pCurrent;
+	}
+
+
+	concurrent_fixed_pool::TaggedLink concurrent_fixed_pool::PopShared(size_t nMaxCount)
+	{
+		TaggedLink head = mShared.load(memory_order_acquire);
+		TaggedLink newHead;
+		Link*      pLast;
+		size_t     nCount;
+
+		do {
+			if(!head.mpHead)
+			{
+				const TaggedLink emptyChain = { NULL, 0 };
+				return emptyChain;
+			}
+
+			// Other threads may pop and reuse the nodes we walk here, in which case we may read 
+			// user data rather than links. Any such read is within the pool's memory block, as we 
+			// stop upon a link which isn't, and the swap below fails as the tag will have changed.
+			pLast  = head.mpHead;
+			nCount = 1;
+
+			Link* pNext = pLast->mpNext;
+
+			while((nCount < nMaxCount) && pNext && IsNode(pNext))
+			{
+				pLast = pNext;
+				pNext = pLast->mpNext;
+				nCount++;
+			}
+
+			newHead.mpHead = pNext;
+			newHead.mnTag  = head.mnTag + 1;
+		} while(!mShared.compare_exchange_weak(head, newHead, memory_order_acquire, memory_order_acquire));
+
+		pLast->mpNext = NULL;
+
+		const TaggedLink chain = { head.mpHead, (uintptr_t)nCount };
+		return chain;
+	}
+
+
+	void concurrent_fixed_pool::PushShared(Link* pFirst, Link* pLast)
+	{
+		TaggedLink head = mShared.load(memory_order_relaxed);
+		TaggedLink newHead;
+
+		do {
+			pLast->mpNext  = head.mpHead;
+			newHead.mpHead = pFirst;
+			newHead.mnTag  = head.mnTag + 1;
+		} while(!mShared.compare_exchange_weak(head, newHead, memory_order_release, memory_order_relaxed));
+	}
+
+
+	bool concurrent_fixed_pool::can_allocate() const
+	{
+		if(mShared.load(memory_order_relaxed).mpHead || (mpNext.load(memory_order_relaxed) != mpCapacity))
+			return true;
+
+		for(size_t i = 0; i < kCacheCount; i++)
+		{
+			if(mCache[i].mnCount.load(memory_order_relaxed))
+				return true;
+		}
+
+		return false;
+	}
+
+
 } // namespace std
 
 
@@ -0,0 +1,282 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/hazard_pointer.h>
+#include <EASTL/algorithm.h>
+#include <EASTL/allocator.h>
+#include <EASTL/fixed_vector.h>
+#include <EASTL/mutex.h>
+#include <EASTL/sort.h>
+#include <new>
+
+
+namespace std
+{
+	/// EASTL_HAZARD_POINTER_DEFAULT_NAME
+	///
+	/// Defines a default allocator name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_HAZARD_POINTER_DEFAULT_NAME
+		#define EASTL_HAZARD_POINTER_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " hazard_pointer" // Unless the user overrides something, this is "EASTL hazard_pointer".
+	#endif
+
+
+	namespace Internal
+	{
+		namespace
+		{
+			// Each record has a cache line to itself, as its owner stores to it upon
+			// every protect.
+			struct HazardPointerRecordBlock
+			{
+				hazard_pointer_record mRecord;
+				char                  mPadding[EA_CACHE_LINE_SIZE - sizeof(hazard_pointer_record)];
+			};
+
+			atomic<hazard_pointer_record*> gpRecordList(NULL);   // All records ever allocated. Only grows.
+			atomic<size_t>                 gnRecordCount(0);
+			atomic<retired_node*>          gpOrphanList(NULL);   // Retired by threads which have since exited. Only ever emptied whole.
+
+
+			struct HazardPointerThreadState
+			{
+				retired_node*          mpRetired;
+				size_t                 mnRetiredCount;
+				hazard_pointer_record* mpCache[EASTL_HAZARD_POINTER_CACHE_SIZE];
+				size_t                 mnCacheCount;
+				bool                   mbDestroyed;
+
+				void PushRetired(retired_node* pNode)
+				{
+					pNode->mpNext = mpRetired;
+					mpRetired     = pNode;
+					mnRetiredCount++;
+				}
+
+				~HazardPointerThreadState();
+			};
+
+
+			void PushOrphans(retired_node* pFirst, retired_node* pLast)
+			{
+				retired_node* pHead = gpOrphanList.load(memory_order_relaxed);
+
+				do {
+					pLast->mpNext = pHead;
+				} while(!gpOrphanList.compare_exchange_weak(pHead, pFirst, memory_order_release, memory_order_relaxed));
+			}
+
+
+			HazardPointerThreadState::~HazardPointerThreadState()
+			{
+				for(size_t i = 0; i < mnCacheCount; i++)
+					mpCache[i]->mnInUse.store(0, memory_order_release);
+
+				if(mpRetired)
+				{
+					retired_node* pLast = mpRetired;
+					while(pLast->mpNext)
+						pLast = pLast->mpNext;
+
+					PushOrphans(mpRetired, pLast);
+				}
+
+				mpRetired      = NULL;
+				mnRetiredCount = 0;
+				mnCacheCount   = 0;
+				mbDestroyed    = true; // Any hazard_pointer destroyed or object retired by a later thread_local destructor bypasses us.
+			}
+
+
+			// Returns the calling thread's state, which must be passed to UnlockThreadState,
+			// or NULL if the thread is exiting and its state has been destroyed. Without
+			// thread_local, all threads share one state under a spinlock.
+			#if !defined(EA_COMPILER_NO_THREAD_LOCAL)
+				thread_local HazardPointerThreadState sThreadState; // Zero-initialized.
+
+				HazardPointerThreadState* LockThreadState()
+					{ return sThreadState.mbDestroyed ? NULL : &sThreadState; }
+
+				void UnlockThreadState(HazardPointerThreadState*)
+					{ }
+			#else
+				HazardPointerThreadState gSharedState;
+				spinlock                 gSharedStateLock;
+
+				HazardPointerThreadState* LockThreadState()
+					{ gSharedStateLock.lock(); return &gSharedState; }
+
+				void UnlockThreadState(HazardPointerThreadState*)
+					{ gSharedStateLock.unlock(); }
+			#endif
+
+
+			// Removes the objects which no hazard pointer protects from the retire list,
+			// adopting the orphans first, and returns them linked together.
+			retired_node* TakeUnprotected(HazardPointerThreadState& state)
+			{
+				retired_node* pNode = gpOrphanList.exchange(NULL, memory_order_acquire);
+
+				while(pNode)
+				{
+					retired_node* const pNext = pNode->mpNext;
+					state.PushRetired(pNode);
+					pNode = pNext;
+				}
+
+				// Orders our callers' unlinking of the retired objects before our loads of the
+				// hazard pointers, so that a reader's protect either sees the unlink or is seen.
+				atomic_thread_fence(memory_order_seq_cst);
+
+				fixed_vector<const void*, 64, true> protectedObjects;
+
+				for(hazard_pointer_record* pRecord = gpRecordList.load(memory_order_acquire); pRecord; pRecord = pRecord->mpNext)
+				{
+					const void* const pProtected = pRecord->mpProtected.load(memory_order_acquire);
+
+					if(pProtected)
+						protectedObjects.push_back(pProtected);
+				}
+
+				std::sort(protectedObjects.begin(), protectedObjects.end());
+
+				retired_node* pUnprotected = NULL;
+
+				pNode = state.mpRetired;
+				state.mpRetired      = NULL;
+				state.mnRetiredCount = 0;
+
+				while(pNode)
+				{
+					retired_node* const pNext = pNode->mpNext;
+
+					if(std::binary_search(protectedObjects.begin(), protectedObjects.end(), pNode->mpObject))
+						state.PushRetired(pNode);
+					else
+					{
+						pNode->mpNext = pUnprotected;
+						pUnprotected  = pNode;
+					}
+
+					pNode = pNext;
+				}
+
+				return pUnprotected;
+			}
+
+
+			// Reclaims the objects outside the state lock, as their deleters may retire more.
+			void Reclaim(retired_node* pNode)
+			{
+				while(pNode)
+				{
+					retired_node* const pNext = pNode->mpNext;
+					pNode->mpReclaim(pNode);
+					pNode = pNext;
+				}
+			}
+
+		} // namespace
+
+
+
+		EASTL_API hazard_pointer_record* hazard_pointer_acquire_record()
+		{
+			if(HazardPointerThreadState* pState = LockThreadState())
+			{
+				hazard_pointer_record* const pRecord = pState->mnCacheCount ? pState->mpCache[--pState->mnCacheCount] : NULL;
+				UnlockThreadState(pState);
+
+				if(pRecord)
+					return pRecord;
+			}
+
+			for(hazard_pointer_record* pRecord = gpRecordList.load(memory_order_acquire); pRecord; pRecord = pRecord->mpNext)
+			{
+				uint32_t nInUse = 0;
+
+				if((pRecord->mnInUse.load(memory_order_relaxed) == 0) &&
+				   pRecord->mnInUse.compare_exchange_strong(nInUse, 1, memory_order_acquire, memory_order_relaxed))
+				{
+					return pRecord;
+				}
+			}
+
+			EASTLAllocatorType allocator(EASTL_HAZARD_POINTER_DEFAULT_NAME);
+			void* const pMemory = EASTLAllocAligned(allocator, sizeof(HazardPointerRecordBlock), EA_CACHE_LINE_SIZE, 0);
+			hazard_pointer_record* const pRecord = &(::new(pMemory) HazardPointerRecordBlock)->mRecord;
+
+			pRecord->mpProtected.store(NULL, memory_order_relaxed);
+			pRecord->mnInUse.store(1, memory_order_relaxed);
+
+			hazard_pointer_record* pHead = gpRecordList.load(memory_order_relaxed);
+
+			do {
+				pRecord->mpNext = pHead;
+			} while(!gpRecordList.compare_exchange_weak(pHead, pRecord, memory_order_release, memory_order_relaxed));
+
+			gnRecordCount.fetch_add(1, memory_order_relaxed);
+			return pRecord;
+		}
+
+
+		EASTL_API void hazard_pointer_release_record(hazard_pointer_record* pRecord) EA_NOEXCEPT
+		{
+			pRecord->mpProtected.store(NULL, memory_order_release);
+
+			if(HazardPointerThreadState* pState = LockThreadState())
+			{
+				const bool bCached = (pState->mnCacheCount < EASTL_HAZARD_POINTER_CACHE_SIZE);
+
+				if(bCached)
+					pState->mpCache[pState->mnCacheCount++] = pRecord;
+
+				UnlockThreadState(pState);
+
+				if(bCached)
+					return;
+			}
+
+			pRecord->mnInUse.store(0, memory_order_release);
+		}
+
+
+		EASTL_API void hazard_pointer_retire(retired_node* pNode) EA_NOEXCEPT
+		{
+			HazardPointerThreadState* const pState = LockThreadState();
+
+			if(!pState)
+			{
+				PushOrphans(pNode, pNode);
+				return;
+			}
+
+			pState->PushRetired(pNode);
+
+			const size_t nRecordCount = gnRecordCount.load(memory_order_relaxed);
+			const size_t nThreshold   = std::max((size_t)EASTL_HAZARD_POINTER_RETIRE_THRESHOLD, 2 * nRecordCount);
+			retired_node* const pUnprotected = (pState->mnRetiredCount >= nThreshold) ? TakeUnprotected(*pState) : NULL;
+
+			UnlockThreadState(pState);
+			Reclaim(pUnprotected);
+		}
+
+	} // namespace Internal
+
+
+
+	EASTL_API void hazard_pointer_reclaim() EA_NOEXCEPT
+	{
+		if(Internal::HazardPointerThreadState* const pState = Internal::LockThreadState())
+		{
+			Internal::retired_node* const pUnprotected = Internal::TakeUnprotected(*pState);
+
+			Internal::UnlockThreadState(pState);
+			Internal::Reclaim(pUnprotected);
+		}
+	}
+
+} // namespace std
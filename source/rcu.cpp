@@ -0,0 +1,382 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/internal/thread_support.h>
+#include <EASTL/rcu.h>
+#include <EASTL/allocator.h>
+#include <EASTL/atomic.h>
+#include <EASTL/mutex.h>
+#include <new>
+
+
+namespace std
+{
+	namespace Internal
+	{
+		namespace
+		{
+			// The global epoch is always even. A thread's record holds the epoch it entered
+			// its critical section in plus one, which is odd, or zero outside of one.
+			struct RcuThreadRecord
+			{
+				atomic<uint32_t> mnState;
+				atomic<uint32_t> mnInUse;
+				RcuThreadRecord* mpNext;
+			};
+
+			// Each record has a cache line to itself, as its owner stores to it upon
+			// every lock and unlock.
+			struct RcuThreadRecordBlock
+			{
+				RcuThreadRecord mRecord;
+				char            mPadding[EA_CACHE_LINE_SIZE - sizeof(RcuThreadRecord)];
+			};
+
+			atomic<uint32_t>         gnEpoch(0);
+			atomic<RcuThreadRecord*> gpRecordList(NULL);           // All records ever allocated. Only grows.
+			atomic<uint32_t>         gnUntrackedReaderCount(0);    // Critical sections of threads which have no record.
+
+
+			// Returns true if objects retired in nRetireEpoch can be reclaimed in nEpoch,
+			// which is two advances later, allowing for wraparound.
+			bool IsExpired(uint32_t nRetireEpoch, uint32_t nEpoch)
+			{
+				return (int32_t)(nEpoch - nRetireEpoch) >= 4;
+			}
+
+
+			// Retired objects, in one list for each of the last three epochs they were
+			// retired in. Any older list has expired and is reclaimed before its slot is
+			// reused for a new epoch.
+			struct RcuRetireList
+			{
+				struct Bucket
+				{
+					retired_node* mpHead;
+					retired_node* mpTail;
+					size_t        mnCount;
+					uint32_t      mnEpoch;
+				};
+
+				Bucket mBuckets[3];
+				size_t mnCountSinceAdvance;
+
+				void Push(retired_node* pFirst, retired_node* pLast, size_t nCount, uint32_t nEpoch)
+				{
+					Bucket& bucket = mBuckets[(nEpoch >> 1) % 3];
+
+					EASTL_ASSERT(!bucket.mpHead || (bucket.mnEpoch == nEpoch)); // TakeExpired(nEpoch) has emptied it otherwise.
+
+					if(!bucket.mpHead)
+						bucket.mpTail = pLast;
+
+					pLast->mpNext   = bucket.mpHead;
+					bucket.mpHead   = pFirst;
+					bucket.mnCount += nCount;
+					bucket.mnEpoch  = nEpoch;
+
+					mnCountSinceAdvance += nCount;
+				}
+
+				// Moves all our objects to list, as if retired in nEpoch.
+				void MoveTo(RcuRetireList& list, uint32_t nEpoch)
+				{
+					for(size_t i = 0; i < 3; i++)
+					{
+						Bucket& bucket = mBuckets[i];
+
+						if(bucket.mpHead)
+						{
+							list.Push(bucket.mpHead, bucket.mpTail, bucket.mnCount, nEpoch);
+							bucket.mpHead  = bucket.mpTail = NULL;
+							bucket.mnCount = 0;
+						}
+					}
+				}
+
+				// Removes the lists which have expired in nEpoch, and returns them linked in
+				// front of pChain.
+				retired_node* TakeExpired(uint32_t nEpoch, retired_node* pChain)
+				{
+					for(size_t i = 0; i < 3; i++)
+					{
+						Bucket& bucket = mBuckets[i];
+
+						if(bucket.mpHead && IsExpired(bucket.mnEpoch, nEpoch))
+						{
+							bucket.mpTail->mpNext = pChain;
+							pChain = bucket.mpHead;
+
+							bucket.mpHead  = bucket.mpTail = NULL;
+							bucket.mnCount = 0;
+						}
+					}
+
+					return pChain;
+				}
+			};
+
+			RcuRetireList gOrphans;       // Retired by threads which have since exited, or which have no thread state.
+			spinlock      gOrphanLock;
+
+
+			void Reclaim(retired_node* pNode)
+			{
+				while(pNode)
+				{
+					retired_node* const pNext = pNode->mpNext;
+					pNode->mpReclaim(pNode);
+					pNode = pNext;
+				}
+			}
+
+
+			RcuThreadRecord* AcquireRecord()
+			{
+				for(RcuThreadRecord* pRecord = gpRecordList.load(memory_order_acquire); pRecord; pRecord = pRecord->mpNext)
+				{
+					uint32_t nInUse = 0;
+
+					if((pRecord->mnInUse.load(memory_order_relaxed) == 0) &&
+					   pRecord->mnInUse.compare_exchange_strong(nInUse, 1, memory_order_acquire, memory_order_relaxed))
+					{
+						return pRecord;
+					}
+				}
+
+				EASTLAllocatorType allocator(EASTL_RCU_DEFAULT_NAME);
+				void* const pMemory = EASTLAllocAligned(allocator, sizeof(RcuThreadRecordBlock), EA_CACHE_LINE_SIZE, 0);
+				RcuThreadRecord* const pRecord = &(::new(pMemory) RcuThreadRecordBlock)->mRecord;
+
+				pRecord->mnState.store(0, memory_order_relaxed);
+				pRecord->mnInUse.store(1, memory_order_relaxed);
+
+				RcuThreadRecord* pHead = gpRecordList.load(memory_order_relaxed);
+
+				do {
+					pRecord->mpNext = pHead;
+				} while(!gpRecordList.compare_exchange_weak(pHead, pRecord, memory_order_release, memory_order_relaxed));
+
+				return pRecord;
+			}
+
+
+			// Advances the epoch from nEpoch if every thread in a critical section entered
+			// it in nEpoch. Returns true if the epoch is now later than nEpoch, whether we
+			// or another thread advanced it.
+			bool TryAdvance(uint32_t nEpoch)
+			{
+				// Pairs with the fence in lock: either we see a thread's record, or it sees
+				// every unlink which preceded our call.
+				atomic_thread_fence(memory_order_seq_cst);
+
+				if(gnUntrackedReaderCount.load(memory_order_acquire) != 0)
+					return false;
+
+				for(RcuThreadRecord* pRecord = gpRecordList.load(memory_order_acquire); pRecord; pRecord = pRecord->mpNext)
+				{
+					const uint32_t nState = pRecord->mnState.load(memory_order_acquire);
+
+					if(nState && (nState != (nEpoch | 1)))
+						return false;
+				}
+
+				gnEpoch.compare_exchange_strong(nEpoch, nEpoch + 2, memory_order_acq_rel, memory_order_acquire);
+				return true;
+			}
+
+
+			struct RcuThreadState
+			{
+				RcuThreadRecord* mpRecord;
+				uint32_t         mnDepth;
+				RcuRetireList    mRetired;
+				bool             mbDestroyed;
+
+				~RcuThreadState()
+				{
+					EASTL_ASSERT(mnDepth == 0); // A thread must not exit within a critical section.
+
+					mbDestroyed = true; // Objects retired while we reclaim below go to the orphans.
+
+					if(mpRecord)
+					{
+						mpRecord->mnState.store(0, memory_order_release);
+						mpRecord->mnInUse.store(0, memory_order_release);
+						mpRecord = NULL;
+					}
+
+					gOrphanLock.lock();
+					const uint32_t nEpoch = gnEpoch.load(memory_order_acquire);
+					retired_node* const pExpired = gOrphans.TakeExpired(nEpoch, mRetired.TakeExpired(nEpoch, NULL));
+					mRetired.MoveTo(gOrphans, nEpoch);
+					gOrphanLock.unlock();
+
+					Reclaim(pExpired);
+				}
+			};
+
+
+			// Returns the calling thread's state, or NULL if it has none, either because
+			// it is exiting and its state has been destroyed, or because thread_local isn't
+			// supported. Threads without state count their critical sections in
+			// gnUntrackedReaderCount and retire objects to the orphans.
+			#if !defined(EA_COMPILER_NO_THREAD_LOCAL)
+				thread_local RcuThreadState sThreadState; // Zero-initialized.
+
+				RcuThreadState* GetThreadState()
+					{ return sThreadState.mbDestroyed ? NULL : &sThreadState; }
+			#else
+				RcuThreadState* GetThreadState()
+					{ return NULL; }
+			#endif
+
+		} // namespace
+
+
+
+		EASTL_API void rcu_retire(retired_node* pNode) EA_NOEXCEPT
+		{
+			RcuThreadState* const pState = GetThreadState();
+			RcuRetireList&        list   = pState ? pState->mRetired : gOrphans;
+
+			if(!pState)
+				gOrphanLock.lock();
+
+			// Orders our caller's unlinking of the object before our load of the epoch, which
+			// would otherwise be free to stamp it with an epoch from before a reader could find
+			// it, as a release store followed by a load isn't ordered even on x86.
+			atomic_thread_fence(memory_order_seq_cst);
+
+			uint32_t      nEpoch   = gnEpoch.load(memory_order_acquire);
+			retired_node* pExpired = list.TakeExpired(nEpoch, NULL);
+			bool          bAdvanced = false;
+
+			list.Push(pNode, pNode, 1, nEpoch);
+
+			if(list.mnCountSinceAdvance >= EASTL_RCU_RETIRE_BATCH_SIZE)
+			{
+				list.mnCountSinceAdvance = 0;
+
+				if(TryAdvance(nEpoch))
+				{
+					bAdvanced = true;
+					nEpoch    = gnEpoch.load(memory_order_acquire);
+					pExpired  = list.TakeExpired(nEpoch, pExpired);
+				}
+			}
+
+			if(!pState)
+				gOrphanLock.unlock();
+			else if(bAdvanced && gOrphanLock.try_lock()) // Adopts the orphans which have expired, if nobody else is.
+			{
+				pExpired = gOrphans.TakeExpired(nEpoch, pExpired);
+				gOrphanLock.unlock();
+			}
+
+			Reclaim(pExpired);
+		}
+
+	} // namespace Internal
+
+
+
+	EASTL_API rcu_domain& rcu_default_domain() EA_NOEXCEPT
+	{
+		static rcu_domain sDefaultDomain; // Constant-initialized.
+		return sDefaultDomain;
+	}
+
+
+	EASTL_API void rcu_domain::lock() EA_NOEXCEPT
+	{
+		using namespace Internal;
+
+		if(RcuThreadState* const pState = GetThreadState())
+		{
+			if(pState->mnDepth++ == 0)
+			{
+				if(!pState->mpRecord)
+					pState->mpRecord = AcquireRecord();
+
+				const uint32_t nState = gnEpoch.load(memory_order_relaxed) | 1;
+
+				// Our record must be visible before the loads of our critical section, which
+				// takes a full fence that pairs with the one in TryAdvance. On x86 a locked
+				// instruction is one, and is cheaper than a store followed by mfence.
+				#if defined(EA_PROCESSOR_X86) || defined(EA_PROCESSOR_X86_64)
+					pState->mpRecord->mnState.exchange(nState, memory_order_seq_cst);
+				#else
+					pState->mpRecord->mnState.store(nState, memory_order_release);
+					atomic_thread_fence(memory_order_seq_cst);
+				#endif
+			}
+		}
+		else
+		{
+			gnUntrackedReaderCount.fetch_add(1, memory_order_seq_cst);
+
+			#if !defined(EA_PROCESSOR_X86) && !defined(EA_PROCESSOR_X86_64)
+				atomic_thread_fence(memory_order_seq_cst);
+			#endif
+		}
+	}
+
+
+	EASTL_API void rcu_domain::unlock() EA_NOEXCEPT
+	{
+		using namespace Internal;
+
+		if(RcuThreadState* const pState = GetThreadState())
+		{
+			EASTL_ASSERT(pState->mnDepth > 0);
+
+			if(--pState->mnDepth == 0)
+				pState->mpRecord->mnState.store(0, memory_order_release);
+		}
+		else
+			gnUntrackedReaderCount.fetch_sub(1, memory_order_release);
+	}
+
+
+	EASTL_API void rcu_synchronize(rcu_domain&) EA_NOEXCEPT
+	{
+		using namespace Internal;
+
+		EASTL_ASSERT(!GetThreadState() || (GetThreadState()->mnDepth == 0));
+
+		// Critical sections entered before now were entered in this epoch or earlier.
+		// The epoch can only advance past the next one after they have all ended.
+		const uint32_t nTarget = gnEpoch.load(memory_order_acquire) + 4;
+
+		for(uint32_t nEpoch = gnEpoch.load(memory_order_acquire); (int32_t)(nEpoch - nTarget) < 0; nEpoch = gnEpoch.load(memory_order_acquire))
+		{
+			if(!TryAdvance(nEpoch))
+				Internal::thread_yield(); // A reader is in a critical section, which it needs processor time to leave.
+		}
+	}
+
+
+	EASTL_API void rcu_barrier(rcu_domain& domain) EA_NOEXCEPT
+	{
+		using namespace Internal;
+
+		rcu_synchronize(domain);
+
+		const uint32_t nEpoch   = gnEpoch.load(memory_order_acquire);
+		retired_node*  pExpired = NULL;
+
+		if(RcuThreadState* const pState = GetThreadState())
+			pExpired = pState->mRetired.TakeExpired(nEpoch, NULL);
+
+		gOrphanLock.lock();
+		pExpired = gOrphans.TakeExpired(nEpoch, pExpired);
+		gOrphanLock.unlock();
+
+		Reclaim(pExpired);
+	}
+
+} // namespace std
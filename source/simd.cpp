@@ -0,0 +1,923 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/internal/simd.h>
+
+#if EASTL_SIMD_ENABLED
+
+#include <string.h>
+#if defined(EA_COMPILER_MSVC)
+	#include <intrin.h>
+#else
+	#include <cpuid.h>
+#endif
+#include <immintrin.h>
+
+
+///////////////////////////////////////////////////////////////////////////////
+// EASTL_SIMD_AVX2_BEGIN / EASTL_SIMD_AVX2_END
+//
+// Compile the functions between them for AVX2, whatever the compiler options.
+// VC++ allows the intrinsics of any instruction set in any function.
+//
+#if defined(EA_COMPILER_CLANG)
+	#define EASTL_SIMD_AVX2_BEGIN _Pragma("clang attribute push (__attribute__((target(\"avx2\"))), apply_to = function)")
+	#define EASTL_SIMD_AVX2_END   _Pragma("clang attribute pop")
+#elif defined(EA_COMPILER_GNUC)
+	#define EASTL_SIMD_AVX2_BEGIN _Pragma("GCC push_options") _Pragma("GCC target(\"avx2\")")
+	#define EASTL_SIMD_AVX2_END   _Pragma("GCC pop_options")
+#else
+	#define EASTL_SIMD_AVX2_BEGIN
+	#define EASTL_SIMD_AVX2_END
+#endif
+
+
+namespace std
+{
+	namespace Internal
+	{
+		namespace
+		{
+			int DetectSimdFeatures()
+			{
+				int nFeatures = kSimdFeatureSSE2; // EASTL_SIMD_ENABLED requires it.
+
+				#if defined(EA_COMPILER_MSVC)
+					int info[4];
+					__cpuid(info, 0);
+					const int nMaxLeaf = info[0];
+
+					__cpuid(info, 1);
+					const bool bOSXSave = (info[2] & (1 << 27)) != 0;
+					const bool bAVX     = (info[2] & (1 << 28)) != 0;
+
+					int nLeaf7EBX = 0;
+					if(nMaxLeaf >= 7)
+					{
+						__cpuidex(info, 7, 0);
+						nLeaf7EBX = info[1];
+					}
+
+					const bool bOSSavesAVX = bOSXSave && ((_xgetbv(0) & 0x6) == 0x6);
+				#else
+					unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+					const unsigned nMaxLeaf = __get_cpuid_max(0, NULL);
+
+					__cpuid(1, eax, ebx, ecx, edx);
+					const bool bOSXSave = (ecx & (1u << 27)) != 0;
+					const bool bAVX     = (ecx & (1u << 28)) != 0;
+
+					unsigned nLeaf7EBX = 0;
+					if(nMaxLeaf >= 7)
+					{
+						__cpuid_count(7, 0, eax, ebx, ecx, edx);
+						nLeaf7EBX = ebx;
+					}
+
+					bool bOSSavesAVX = false;
+					if(bOSXSave)
+					{
+						unsigned xcr0, xcr0High;
+						__asm__ __volatile__("xgetbv" : "=a"(xcr0), "=d"(xcr0High) : "c"(0));
+						bOSSavesAVX = ((xcr0 & 0x6) == 0x6); // The XMM and YMM registers are saved on context switches.
+					}
+				#endif
+
+				if(bAVX && bOSSavesAVX && (nLeaf7EBX & (1 << 5)))
+					nFeatures |= kSimdFeatureAVX2;
+
+				return nFeatures;
+			}
+
+			// Set before main. A call by a static initializer which runs earlier sees zero and uses SSE2.
+			int gnSimdFeatures = DetectSimdFeatures();
+
+
+			inline uint32_t SimdFirstBit(uint32_t x) // x must be non-zero.
+			{
+				#if defined(EA_COMPILER_MSVC)
+					unsigned long nIndex;
+					_BitScanForward(&nIndex, x);
+					return (uint32_t)nIndex;
+				#else
+					return (uint32_t)__builtin_ctz(x);
+				#endif
+			}
+
+			inline uint32_t SimdLastBit(uint32_t x) // x must be non-zero.
+			{
+				#if defined(EA_COMPILER_MSVC)
+					unsigned long nIndex;
+					_BitScanReverse(&nIndex, x);
+					return (uint32_t)nIndex;
+				#else
+					return (uint32_t)(31 - __builtin_clz(x));
+				#endif
+			}
+
+
+			namespace sse2
+			{
+				struct simd
+				{
+					typedef __m128i type;
+
+					static const size_t   kSize    = 16;
+					static const uint32_t kAllMask = 0xffff;
+
+					static type     Load(const void* p)           { return _mm_loadu_si128((const __m128i*)p); }
+					static void     Store(void* p, type a)        { _mm_storeu_si128((__m128i*)p, a); }
+					static type     Zero()                        { return _mm_setzero_si128(); }
+					static type     Set(char c)                   { return _mm_set1_epi8(c); }
+					static type     Equal(type a, type b)         { return _mm_cmpeq_epi8(a, b); }
+					static type     And(type a, type b)           { return _mm_and_si128(a, b); }
+					static type     Or(type a, type b)            { return _mm_or_si128(a, b); }
+					static type     Xor(type a, type b)           { return _mm_xor_si128(a, b); }
+					static type     Sub(type a, type b)           { return _mm_sub_epi8(a, b); }
+					static type     Select(type m, type a, type b) { return _mm_or_si128(_mm_and_si128(m, b), _mm_andnot_si128(m, a)); } // b where m is set, else a.
+					static uint32_t Mask(type a)                  { return (uint32_t)_mm_movemask_epi8(a); }
+
+					static uint32_t SumBytes(type a)
+					{
+						const __m128i sums = _mm_sad_epu8(a, _mm_setzero_si128());
+						return (uint32_t)_mm_cvtsi128_si32(sums) + (uint32_t)_mm_cvtsi128_si32(_mm_unpackhi_epi64(sums, sums));
+					}
+
+					static void StoreWidened(uint16_t* p, type a) // Stores the bytes of a as 16-bit elements.
+					{
+						Store(p,     _mm_unpacklo_epi8(a, _mm_setzero_si128()));
+						Store(p + 8, _mm_unpackhi_epi8(a, _mm_setzero_si128()));
+					}
+
+					static void StoreWidened(uint32_t* p, type a) // Stores the bytes of a as 32-bit elements.
+					{
+						const __m128i low  = _mm_unpacklo_epi8(a, _mm_setzero_si128());
+						const __m128i high = _mm_unpackhi_epi8(a, _mm_setzero_si128());
+
+						StoreWidened16(p,     low);
+						StoreWidened16(p + 8, high);
+					}
+
+					static void StoreWidened16(uint32_t* p, type a) // Stores the 16-bit elements of a as 32-bit elements.
+					{
+						Store(p,     _mm_unpacklo_epi16(a, _mm_setzero_si128()));
+						Store(p + 4, _mm_unpackhi_epi16(a, _mm_setzero_si128()));
+					}
+
+					static type Narrow16(type a, type b) // The 16-bit elements of a then b, which must be below 0x80, as bytes.
+						{ return _mm_packus_epi16(a, b); }
+
+					static type Narrow32(type a, type b) // The 32-bit elements of a then b, which must be below 0x10000, as 16-bit elements.
+					{
+						// SSE2 packs with signed saturation only, so the elements are sign extended from 16 bits first.
+						return _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(a, 16), 16), _mm_srai_epi32(_mm_slli_epi32(b, 16), 16));
+					}
+				};
+
+				// The operations on vectors of T, for the kernels of the algorithms.
+				template <typename T> struct lanes;
+
+				template <typename T>
+				struct lanes8
+				{
+					static __m128i Set(T x)                    { return _mm_set1_epi8((char)x); }
+					static __m128i Equal(__m128i a, __m128i b) { return _mm_cmpeq_epi8(a, b); }
+					static __m128i NaN(__m128i)                { return _mm_setzero_si128(); }
+				};
+
+				template <typename T>
+				struct lanes16
+				{
+					static __m128i Set(T x)                    { return _mm_set1_epi16((short)x); }
+					static __m128i Equal(__m128i a, __m128i b) { return _mm_cmpeq_epi16(a, b); }
+					static __m128i NaN(__m128i)                { return _mm_setzero_si128(); }
+				};
+
+				template <typename T>
+				struct lanes32
+				{
+					static __m128i Set(T x)                    { return _mm_set1_epi32((int)x); }
+					static __m128i Equal(__m128i a, __m128i b) { return _mm_cmpeq_epi32(a, b); }
+					static __m128i NaN(__m128i)                { return _mm_setzero_si128(); }
+				};
+
+				template <typename T>
+				struct lanes64
+				{
+					static __m128i Set(T x) { return _mm_set1_epi64x((long long)x); }
+					static __m128i NaN(__m128i) { return _mm_setzero_si128(); }
+
+					static __m128i Equal(__m128i a, __m128i b) // SSE2 compares 32 bits at most.
+					{
+						const __m128i equal = _mm_cmpeq_epi32(a, b);
+						return _mm_and_si128(equal, _mm_shuffle_epi32(equal, _MM_SHUFFLE(2, 3, 0, 1)));
+					}
+
+					static __m128i Greater(__m128i a, __m128i b) // Signed; the high halves compare signed and the low halves unsigned.
+					{
+						const __m128i lowBias = _mm_set_epi32(0, (int)0x80000000, 0, (int)0x80000000);
+						const __m128i greater = _mm_cmpgt_epi32(_mm_xor_si128(a, lowBias), _mm_xor_si128(b, lowBias));
+						const __m128i equal   = _mm_cmpeq_epi32(a, b);
+						const __m128i result  = _mm_or_si128(greater, _mm_and_si128(equal, _mm_shuffle_epi32(greater, _MM_SHUFFLE(2, 2, 0, 0))));
+						return _mm_shuffle_epi32(result, _MM_SHUFFLE(3, 3, 1, 1));
+					}
+				};
+
+				template <> struct lanes<int8_t> : lanes8<int8_t>
+				{
+					static __m128i Min(__m128i a, __m128i b) { return simd::Select(_mm_cmpgt_epi8(a, b), a, b); }
+					static __m128i Max(__m128i a, __m128i b) { return simd::Select(_mm_cmpgt_epi8(a, b), b, a); }
+				};
+
+				template <> struct lanes<uint8_t> : lanes8<uint8_t>
+				{
+					static __m128i Min(__m128i a, __m128i b) { return _mm_min_epu8(a, b); }
+					static __m128i Max(__m128i a, __m128i b) { return _mm_max_epu8(a, b); }
+				};
+
+				template <> struct lanes<int16_t> : lanes16<int16_t>
+				{
+					static __m128i Min(__m128i a, __m128i b) { return _mm_min_epi16(a, b); }
+					static __m128i Max(__m128i a, __m128i b) { return _mm_max_epi16(a, b); }
+				};
+
+				template <> struct lanes<uint16_t> : lanes16<uint16_t> // Compared as signed, with their top bits flipped.
+				{
+					static __m128i Min(__m128i a, __m128i b) { const __m128i bias = _mm_set1_epi16((short)0x8000); return _mm_xor_si128(_mm_min_epi16(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias)), bias); }
+					static __m128i Max(__m128i a, __m128i b) { const __m128i bias = _mm_set1_epi16((short)0x8000); return _mm_xor_si128(_mm_max_epi16(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias)), bias); }
+				};
+
+				template <> struct lanes<int32_t> : lanes32<int32_t>
+				{
+					static __m128i Min(__m128i a, __m128i b) { return simd::Select(_mm_cmpgt_epi32(a, b), a, b); }
+					static __m128i Max(__m128i a, __m128i b) { return simd::Select(_mm_cmpgt_epi32(a, b), b, a); }
+				};
+
+				template <> struct lanes<uint32_t> : lanes32<uint32_t>
+				{
+					static __m128i Greater(__m128i a, __m128i b) { const __m128i bias = _mm_set1_epi32((int)0x80000000); return _mm_cmpgt_epi32(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias)); }
+					static __m128i Min(__m128i a, __m128i b)     { return simd::Select(Greater(a, b), a, b); }
+					static __m128i Max(__m128i a, __m128i b)     { return simd::Select(Greater(a, b), b, a); }
+				};
+
+				template <> struct lanes<int64_t> : lanes64<int64_t>
+				{
+					static __m128i Min(__m128i a, __m128i b) { return simd::Select(Greater(a, b), a, b); }
+					static __m128i Max(__m128i a, __m128i b) { return simd::Select(Greater(a, b), b, a); }
+				};
+
+				template <> struct lanes<uint64_t> : lanes64<uint64_t>
+				{
+					static __m128i GreaterUnsigned(__m128i a, __m128i b) { const __m128i bias = _mm_set1_epi64x((long long)0x8000000000000000ull); return Greater(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias)); }
+					static __m128i Min(__m128i a, __m128i b) { return simd::Select(GreaterUnsigned(a, b), a, b); }
+					static __m128i Max(__m128i a, __m128i b) { return simd::Select(GreaterUnsigned(a, b), b, a); }
+				};
+
+				template <> struct lanes<float>
+				{
+					static __m128i Set(float x)                { return _mm_castps_si128(_mm_set1_ps(x)); }
+					static __m128i Equal(__m128i a, __m128i b) { return _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b))); }
+					static __m128i NaN(__m128i a)              { return _mm_castps_si128(_mm_cmpunord_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(a))); }
+					static __m128i Min(__m128i a, __m128i b)   { return _mm_castps_si128(_mm_min_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b))); }
+					static __m128i Max(__m128i a, __m128i b)   { return _mm_castps_si128(_mm_max_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b))); }
+				};
+
+				template <> struct lanes<double>
+				{
+					static __m128i Set(double x)               { return _mm_castpd_si128(_mm_set1_pd(x)); }
+					static __m128i Equal(__m128i a, __m128i b) { return _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b))); }
+					static __m128i NaN(__m128i a)              { return _mm_castpd_si128(_mm_cmpunord_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(a))); }
+					static __m128i Min(__m128i a, __m128i b)   { return _mm_castpd_si128(_mm_min_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b))); }
+					static __m128i Max(__m128i a, __m128i b)   { return _mm_castpd_si128(_mm_max_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b))); }
+				};
+
+				#include "simd_kernels.inl"
+
+				const char* FindFirstOf(const char* pBegin, const char* pEnd, const char* pSetBegin, const char* pSetEnd, bool bInSet)
+				{
+					if((size_t)(pSetEnd - pSetBegin) <= kSetMatcherMaxSize)
+						return FindFirst(pBegin, pEnd, SetMatcher(pSetBegin, pSetEnd, bInSet));
+
+					bool table[256] = {};
+					for(const char* p = pSetBegin; p != pSetEnd; ++p)
+						table[(uint8_t)*p] = true;
+
+					for(; pBegin != pEnd; ++pBegin)
+					{
+						if(table[(uint8_t)*pBegin] == bInSet)
+							return pBegin;
+					}
+					return NULL;
+				}
+
+				const char* FindLastOf(const char* pBegin, const char* pEnd, const char* pSetBegin, const char* pSetEnd, bool bInSet)
+				{
+					if((size_t)(pSetEnd - pSetBegin) <= kSetMatcherMaxSize)
+						return FindLast(pBegin, pEnd, SetMatcher(pSetBegin, pSetEnd, bInSet));
+
+					bool table[256] = {};
+					for(const char* p = pSetBegin; p != pSetEnd; ++p)
+						table[(uint8_t)*p] = true;
+
+					while(pEnd != pBegin)
+					{
+						if(table[(uint8_t)*--pEnd] == bInSet)
+							return pEnd;
+					}
+					return NULL;
+				}
+			}
+
+
+			EASTL_SIMD_AVX2_BEGIN
+
+			namespace avx2
+			{
+				struct simd
+				{
+					typedef __m256i type;
+
+					static const size_t   kSize    = 32;
+					static const uint32_t kAllMask = 0xffffffff;
+
+					static type     Load(const void* p)           { return _mm256_loadu_si256((const __m256i*)p); }
+					static void     Store(void* p, type a)        { _mm256_storeu_si256((__m256i*)p, a); }
+					static type     Zero()                        { return _mm256_setzero_si256(); }
+					static type     Set(char c)                   { return _mm256_set1_epi8(c); }
+					static type     Equal(type a, type b)         { return _mm256_cmpeq_epi8(a, b); }
+					static type     And(type a, type b)           { return _mm256_and_si256(a, b); }
+					static type     Or(type a, type b)            { return _mm256_or_si256(a, b); }
+					static type     Xor(type a, type b)           { return _mm256_xor_si256(a, b); }
+					static type     Sub(type a, type b)           { return _mm256_sub_epi8(a, b); }
+					static type     Select(type m, type a, type b) { return _mm256_blendv_epi8(a, b, m); } // b where m is set, else a.
+					static uint32_t Mask(type a)                  { return (uint32_t)_mm256_movemask_epi8(a); }
+
+					static uint32_t SumBytes(type a)
+					{
+						const __m256i sums4 = _mm256_sad_epu8(a, _mm256_setzero_si256());
+						const __m128i sums  = _mm_add_epi64(_mm256_castsi256_si128(sums4), _mm256_extracti128_si256(sums4, 1));
+						return (uint32_t)_mm_cvtsi128_si32(sums) + (uint32_t)_mm_cvtsi128_si32(_mm_unpackhi_epi64(sums, sums));
+					}
+
+					static void StoreWidened(uint16_t* p, type a) // Stores the bytes of a as 16-bit elements.
+					{
+						Store(p,      _mm256_cvtepu8_epi16(_mm256_castsi256_si128(a)));
+						Store(p + 16, _mm256_cvtepu8_epi16(_mm256_extracti128_si256(a, 1)));
+					}
+
+					static void StoreWidened(uint32_t* p, type a) // Stores the bytes of a as 32-bit elements.
+					{
+						const __m128i low  = _mm256_castsi256_si128(a);
+						const __m128i high = _mm256_extracti128_si256(a, 1);
+
+						Store(p,      _mm256_cvtepu8_epi32(low));
+						Store(p + 8,  _mm256_cvtepu8_epi32(_mm_srli_si128(low, 8)));
+						Store(p + 16, _mm256_cvtepu8_epi32(high));
+						Store(p + 24, _mm256_cvtepu8_epi32(_mm_srli_si128(high, 8)));
+					}
+
+					static void StoreWidened16(uint32_t* p, type a) // Stores the 16-bit elements of a as 32-bit elements.
+					{
+						Store(p,     _mm256_cvtepu16_epi32(_mm256_castsi256_si128(a)));
+						Store(p + 8, _mm256_cvtepu16_epi32(_mm256_extracti128_si256(a, 1)));
+					}
+
+					// The packs interleave the 128-bit lanes of a and b, which the permutes put back in order.
+					static type Narrow16(type a, type b) // The 16-bit elements of a then b, which must be below 0x80, as bytes.
+						{ return _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), _MM_SHUFFLE(3, 1, 2, 0)); }
+
+					static type Narrow32(type a, type b) // The 32-bit elements of a then b, which must be below 0x10000, as 16-bit elements.
+						{ return _mm256_permute4x64_epi64(_mm256_packus_epi32(a, b), _MM_SHUFFLE(3, 1, 2, 0)); }
+				};
+
+				// The operations on vectors of T, for the kernels of the algorithms.
+				template <typename T> struct lanes;
+
+				template <typename T>
+				struct lanes8
+				{
+					static __m256i Set(T x)                    { return _mm256_set1_epi8((char)x); }
+					static __m256i Equal(__m256i a, __m256i b) { return _mm256_cmpeq_epi8(a, b); }
+					static __m256i NaN(__m256i)                { return _mm256_setzero_si256(); }
+				};
+
+				template <typename T>
+				struct lanes16
+				{
+					static __m256i Set(T x)                    { return _mm256_set1_epi16((short)x); }
+					static __m256i Equal(__m256i a, __m256i b) { return _mm256_cmpeq_epi16(a, b); }
+					static __m256i NaN(__m256i)                { return _mm256_setzero_si256(); }
+				};
+
+				template <typename T>
+				struct lanes32
+				{
+					static __m256i Set(T x)                    { return _mm256_set1_epi32((int)x); }
+					static __m256i Equal(__m256i a, __m256i b) { return _mm256_cmpeq_epi32(a, b); }
+					static __m256i NaN(__m256i)                { return _mm256_setzero_si256(); }
+				};
+
+				template <typename T>
+				struct lanes64
+				{
+					static __m256i Set(T x)                    { return _mm256_set1_epi64x((long long)x); }
+					static __m256i Equal(__m256i a, __m256i b) { return _mm256_cmpeq_epi64(a, b); }
+					static __m256i NaN(__m256i)                { return _mm256_setzero_si256(); }
+				};
+
+				template <> struct lanes<int8_t> : lanes8<int8_t>
+				{
+					static __m256i Min(__m256i a, __m256i b) { return _mm256_min_epi8(a, b); }
+					static __m256i Max(__m256i a, __m256i b) { return _mm256_max_epi8(a, b); }
+				};
+
+				template <> struct lanes<uint8_t> : lanes8<uint8_t>
+				{
+					static __m256i Min(__m256i a, __m256i b) { return _mm256_min_epu8(a, b); }
+					static __m256i Max(__m256i a, __m256i b) { return _mm256_max_epu8(a, b); }
+				};
+
+				template <> struct lanes<int16_t> : lanes16<int16_t>
+				{
+					static __m256i Min(__m256i a, __m256i b) { return _mm256_min_epi16(a, b); }
+					static __m256i Max(__m256i a, __m256i b) { return _mm256_max_epi16(a, b); }
+				};
+
+				template <> struct lanes<uint16_t> : lanes16<uint16_t>
+				{
+					static __m256i Min(__m256i a, __m256i b) { return _mm256_min_epu16(a, b); }
+					static __m256i Max(__m256i a, __m256i b) { return _mm256_max_epu16(a, b); }
+				};
+
+				template <> struct lanes<int32_t> : lanes32<int32_t>
+				{
+					static __m256i Min(__m256i a, __m256i b) { return _mm256_min_epi32(a, b); }
+					static __m256i Max(__m256i a, __m256i b) { return _mm256_max_epi32(a, b); }
+				};
+
+				template <> struct lanes<uint32_t> : lanes32<uint32_t>
+				{
+					static __m256i Min(__m256i a, __m256i b) { return _mm256_min_epu32(a, b); }
+					static __m256i Max(__m256i a, __m256i b) { return _mm256_max_epu32(a, b); }
+				};
+
+				template <> struct lanes<int64_t> : lanes64<int64_t>
+				{
+					static __m256i Min(__m256i a, __m256i b) { return simd::Select(_mm256_cmpgt_epi64(a, b), a, b); }
+					static __m256i Max(__m256i a, __m256i b) { return simd::Select(_mm256_cmpgt_epi64(a, b), b, a); }
+				};
+
+				template <> struct lanes<uint64_t> : lanes64<uint64_t> // Compared as signed, with their top bits flipped.
+				{
+					static __m256i Greater(__m256i a, __m256i b) { const __m256i bias = _mm256_set1_epi64x((long long)0x8000000000000000ull); return _mm256_cmpgt_epi64(_mm256_xor_si256(a, bias), _mm256_xor_si256(b, bias)); }
+					static __m256i Min(__m256i a, __m256i b)     { return simd::Select(Greater(a, b), a, b); }
+					static __m256i Max(__m256i a, __m256i b)     { return simd::Select(Greater(a, b), b, a); }
+				};
+
+				template <> struct lanes<float>
+				{
+					static __m256i Set(float x)                { return _mm256_castps_si256(_mm256_set1_ps(x)); }
+					static __m256i Equal(__m256i a, __m256i b) { return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_EQ_OQ)); }
+					static __m256i NaN(__m256i a)              { return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(a), _CMP_UNORD_Q)); }
+					static __m256i Min(__m256i a, __m256i b)   { return _mm256_castps_si256(_mm256_min_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b))); }
+					static __m256i Max(__m256i a, __m256i b)   { return _mm256_castps_si256(_mm256_max_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b))); }
+				};
+
+				template <> struct lanes<double>
+				{
+					static __m256i Set(double x)               { return _mm256_castpd_si256(_mm256_set1_pd(x)); }
+					static __m256i Equal(__m256i a, __m256i b) { return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_EQ_OQ)); }
+					static __m256i NaN(__m256i a)              { return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(a), _CMP_UNORD_Q)); }
+					static __m256i Min(__m256i a, __m256i b)   { return _mm256_castpd_si256(_mm256_min_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b))); }
+					static __m256i Max(__m256i a, __m256i b)   { return _mm256_castpd_si256(_mm256_max_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b))); }
+				};
+
+				#include "simd_kernels.inl"
+
+				// Matches the chars in (or not in) a set of any size, with two table lookups per
+				// byte. A char's low nibble selects a row of the table and its high nibble the bit
+				// in that row. The rows are 16 bits, split into a table for the high nibbles 0-7
+				// and one for 8-15, as the shuffle instruction which does the lookups returns bytes.
+				struct NibbleSetMatcher
+				{
+					vector_type mLowTable;      // Bit h of byte l is set if the char (h << 4) | l is in the set, for h < 8.
+					vector_type mHighTable;     // Likewise for h >= 8, in bit h - 8.
+					vector_type mLowBits;       // Byte h is 1 << h for h < 8, else 0.
+					vector_type mHighBits;      // Byte h is 1 << (h - 8) for h >= 8, else 0.
+					vector_type mNibbleMask;
+					bool        mTable[256];
+					bool        mbInSet;
+
+					NibbleSetMatcher(const char* pSetBegin, const char* pSetEnd, bool bInSet)
+						: mbInSet(bInSet)
+					{
+						uint8_t lowTable[16]  = {};
+						uint8_t highTable[16] = {};
+						uint8_t lowBits[16], highBits[16];
+
+						memset(mTable, 0, sizeof(mTable));
+
+						for(const char* p = pSetBegin; p != pSetEnd; ++p)
+						{
+							const uint8_t c = (uint8_t)*p;
+							mTable[c] = true;
+
+							if(c < 0x80)
+								lowTable[c & 15] |= (uint8_t)(1 << (c >> 4));
+							else
+								highTable[c & 15] |= (uint8_t)(1 << ((c >> 4) - 8));
+						}
+
+						for(int h = 0; h < 16; h++)
+						{
+							lowBits[h]  = (uint8_t)((h < 8) ? (1 << h) : 0);
+							highBits[h] = (uint8_t)((h < 8) ? 0 : (1 << (h - 8)));
+						}
+
+						mLowTable   = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)lowTable));
+						mHighTable  = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)highTable));
+						mLowBits    = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)lowBits));
+						mHighBits   = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)highBits));
+						mNibbleMask = _mm256_set1_epi8(0x0f);
+					}
+
+					uint32_t Mask(const char* p) const
+					{
+						const __m256i v     = simd::Load(p);
+						const __m256i low   = _mm256_and_si256(v, mNibbleMask);
+						const __m256i high  = _mm256_and_si256(_mm256_srli_epi16(v, 4), mNibbleMask);
+						const __m256i found = _mm256_or_si256(_mm256_and_si256(_mm256_shuffle_epi8(mLowTable,  low), _mm256_shuffle_epi8(mLowBits,  high)),
+															  _mm256_and_si256(_mm256_shuffle_epi8(mHighTable, low), _mm256_shuffle_epi8(mHighBits, high)));
+						const uint32_t nNotFound = simd::Mask(_mm256_cmpeq_epi8(found, _mm256_setzero_si256()));
+
+						return mbInSet ? ~nNotFound : nNotFound;
+					}
+
+					bool Match(char c) const { return mTable[(uint8_t)c] == mbInSet; }
+				};
+
+				const char* FindFirstOf(const char* pBegin, const char* pEnd, const char* pSetBegin, const char* pSetEnd, bool bInSet)
+				{
+					if((pSetEnd - pSetBegin) <= 2)
+						return FindFirst(pBegin, pEnd, SetMatcher(pSetBegin, pSetEnd, bInSet));
+					return FindFirst(pBegin, pEnd, NibbleSetMatcher(pSetBegin, pSetEnd, bInSet));
+				}
+
+				const char* FindLastOf(const char* pBegin, const char* pEnd, const char* pSetBegin, const char* pSetEnd, bool bInSet)
+				{
+					if((pSetEnd - pSetBegin) <= 2)
+						return FindLast(pBegin, pEnd, SetMatcher(pSetBegin, pSetEnd, bInSet));
+					return FindLast(pBegin, pEnd, NibbleSetMatcher(pSetBegin, pSetEnd, bInSet));
+				}
+
+				// Validates UTF-8 with the lookup algorithm of Keiser and Lemire ("Validating UTF-8 In
+				// Less Than One Instruction Per Byte", 2021). Each byte and the byte before it are
+				// classified by three table lookups, on the high and low nibbles of the first and the
+				// high nibble of the second, and the AND of the three has a bit set for each error of
+				// the pair. Bytes which must be the third or fourth of a sequence are found from the
+				// bytes two and three before them. Vectors of ASCII only check that the previous vector
+				// didn't end within a sequence.
+				class Utf8Validator
+				{
+				public:
+					Utf8Validator()
+					{
+						enum
+						{
+							kTooShort     = 1 << 0, // A lead byte followed by a lead byte or ASCII.
+							kTooLong      = 1 << 1, // ASCII followed by a continuation byte.
+							kOverlong3    = 1 << 2, // 11100000 100_____
+							kTooLarge     = 1 << 3, // 11110100 1001____, 11110100 101_____, 11110101 1001____, ...
+							kSurrogate    = 1 << 4, // 11101101 101_____
+							kOverlong2    = 1 << 5, // 1100000_ 10______
+							kTooLarge1000 = 1 << 6, // 11110101 1000____, 1111011_ 1000____, 11111___ 1000____
+							kOverlong4    = 1 << 6, // 11110000 1000____
+							kTwoConts     = 1 << 7, // A continuation byte followed by one, which is an error unless the second must be the third or fourth of a sequence.
+							kCarry        = kTooShort | kTooLong | kTwoConts
+						};
+
+						mFirstHighTable = Table(kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong,
+												kTwoConts, kTwoConts, kTwoConts, kTwoConts,
+												kTooShort | kOverlong2,
+												kTooShort,
+												kTooShort | kOverlong3 | kSurrogate,
+												kTooShort | kTooLarge | kTooLarge1000 | kOverlong4);
+
+						mFirstLowTable  = Table(kCarry | kOverlong3 | kOverlong2 | kOverlong4,
+												kCarry | kOverlong2,
+												kCarry,
+												kCarry,
+												kCarry | kTooLarge,
+												kCarry | kTooLarge | kTooLarge1000,
+												kCarry | kTooLarge | kTooLarge1000,
+												kCarry | kTooLarge | kTooLarge1000,
+												kCarry | kTooLarge | kTooLarge1000,
+												kCarry | kTooLarge | kTooLarge1000,
+												kCarry | kTooLarge | kTooLarge1000,
+												kCarry | kTooLarge | kTooLarge1000,
+												kCarry | kTooLarge | kTooLarge1000,
+												kCarry | kTooLarge | kTooLarge1000 | kSurrogate,
+												kCarry | kTooLarge | kTooLarge1000,
+												kCarry | kTooLarge | kTooLarge1000);
+
+						mSecondHighTable = Table(kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort,
+												 kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge1000 | kOverlong4,
+												 kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge,
+												 kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,
+												 kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,
+												 kTooShort, kTooShort, kTooShort, kTooShort);
+
+						// A vector ends within a sequence if any of its last three bytes begins one longer than the bytes left.
+						mIncompleteMax = _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+														  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+														  (char)(0xf0 - 1), (char)(0xe0 - 1), (char)(0xc0 - 1));
+
+						mPrevious   = _mm256_setzero_si256();
+						mIncomplete = _mm256_setzero_si256();
+						mError      = _mm256_setzero_si256();
+					}
+
+					// Checks the next 32 bytes, and returns false if there has been an error.
+					bool Check(__m256i input)
+					{
+						if(_mm256_movemask_epi8(input) == 0)
+							mError = _mm256_or_si256(mError, mIncomplete);
+						else
+						{
+							const __m256i nibbleMask  = _mm256_set1_epi8(0x0f);
+							const __m256i previous    = _mm256_permute2x128_si256(mPrevious, input, 0x21); // The high lane of mPrevious, then the low lane of input.
+							const __m256i previous1   = _mm256_alignr_epi8(input, previous, 15);
+							const __m256i previous2   = _mm256_alignr_epi8(input, previous, 14);
+							const __m256i previous3   = _mm256_alignr_epi8(input, previous, 13);
+
+							const __m256i firstHigh   = _mm256_shuffle_epi8(mFirstHighTable,  _mm256_and_si256(_mm256_srli_epi16(previous1, 4), nibbleMask));
+							const __m256i firstLow    = _mm256_shuffle_epi8(mFirstLowTable,   _mm256_and_si256(previous1, nibbleMask));
+							const __m256i secondHigh  = _mm256_shuffle_epi8(mSecondHighTable, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibbleMask));
+							const __m256i pairErrors  = _mm256_and_si256(_mm256_and_si256(firstHigh, firstLow), secondHigh);
+
+							const __m256i isThird     = _mm256_subs_epu8(previous2, _mm256_set1_epi8((char)(0xe0 - 0x80))); // Only 111_____ are >= 0x80.
+							const __m256i isFourth    = _mm256_subs_epu8(previous3, _mm256_set1_epi8((char)(0xf0 - 0x80))); // Only 1111____ are >= 0x80.
+							const __m256i mustBe3rd4th = _mm256_and_si256(_mm256_or_si256(isThird, isFourth), _mm256_set1_epi8((char)0x80));
+
+							mError      = _mm256_or_si256(mError, _mm256_xor_si256(mustBe3rd4th, pairErrors));
+							mIncomplete = _mm256_subs_epu8(input, mIncompleteMax);
+						}
+
+						mPrevious = input;
+						return _mm256_testz_si256(mError, mError) != 0;
+					}
+
+				protected:
+					static __m256i Table(int a0, int a1, int a2,  int a3,  int a4,  int a5,  int a6,  int a7,
+										 int a8, int a9, int a10, int a11, int a12, int a13, int a14, int a15)
+					{
+						return _mm256_broadcastsi128_si256(_mm_setr_epi8((char)a0, (char)a1, (char)a2,  (char)a3,  (char)a4,  (char)a5,  (char)a6,  (char)a7,
+																		 (char)a8, (char)a9, (char)a10, (char)a11, (char)a12, (char)a13, (char)a14, (char)a15));
+					}
+
+					__m256i mFirstHighTable;
+					__m256i mFirstLowTable;
+					__m256i mSecondHighTable;
+					__m256i mIncompleteMax;
+					__m256i mPrevious;
+					__m256i mIncomplete;
+					__m256i mError;
+				};
+
+				size_t Utf8ValidLength(const char* p, size_t n)
+				{
+					// The validator begins as if after ASCII, so it can begin after the leading ASCII.
+					Utf8Validator validator;
+					size_t i = AsciiLength(p, n);
+
+					if(i == n)
+						return n;
+
+					for(; (i + simd::kSize) <= n; i += simd::kSize)
+					{
+						if(!validator.Check(simd::Load(p + i)))
+							break;
+					}
+
+					if(i + simd::kSize > n) // If all the whole vectors were valid, check the rest, padded with zeros, which ends any sequence.
+					{
+						char buffer[simd::kSize] = {};
+						memcpy(buffer, p + i, n - i);
+
+						if(validator.Check(simd::Load(buffer)))
+							return n;
+					}
+
+					// The error involves the vector at i or the three bytes before it, so the characters
+					// which end before those are valid.
+					if(i < 3)
+						return 0;
+					for(i -= 3; (i > 0) && (((uint8_t)p[i] & 0xc0) == 0x80); --i)
+						{ }
+					return i;
+				}
+			}
+
+			EASTL_SIMD_AVX2_END
+
+		} // namespace
+
+
+		EASTL_API int simd_features()
+		{
+			return gnSimdFeatures;
+		}
+
+
+		EASTL_API int simd_set_features(int nFeatures)
+		{
+			const int nPrevious = gnSimdFeatures;
+			gnSimdFeatures = (nFeatures & DetectSimdFeatures()) | kSimdFeatureSSE2;
+			return nPrevious;
+		}
+
+
+		EASTL_API const char* simd_string_search(const char* pBegin, const char* pEnd, const char* pPatternBegin, const char* pPatternEnd)
+		{
+			if(gnSimdFeatures & kSimdFeatureAVX2)
+				return avx2::Search(pBegin, pEnd, pPatternBegin, pPatternEnd);
+			return sse2::Search(pBegin, pEnd, pPatternBegin, pPatternEnd);
+		}
+
+
+		EASTL_API const char* simd_string_rsearch(const char* pBegin, const char* pEnd, const char* pPatternBegin, const char* pPatternEnd)
+		{
+			if(gnSimdFeatures & kSimdFeatureAVX2)
+				return avx2::RSearch(pBegin, pEnd, pPatternBegin, pPatternEnd);
+			return sse2::RSearch(pBegin, pEnd, pPatternBegin, pPatternEnd);
+		}
+
+
+		EASTL_API const char* simd_string_find_last(const char* pBegin, const char* pEnd, char c)
+		{
+			if(gnSimdFeatures & kSimdFeatureAVX2)
+				return avx2::FindLast(pBegin, pEnd, avx2::CharMatcher(c));
+			return sse2::FindLast(pBegin, pEnd, sse2::CharMatcher(c));
+		}
+
+
+		EASTL_API const char* simd_string_find_first_of(const char* pBegin, const char* pEnd, const char* pSetBegin, const char* pSetEnd, bool bInSet)
+		{
+			if(pSetBegin == pSetEnd)
+				return (bInSet || (pBegin == pEnd)) ? NULL : pBegin;
+
+			if(gnSimdFeatures & kSimdFeatureAVX2)
+				return avx2::FindFirstOf(pBegin, pEnd, pSetBegin, pSetEnd, bInSet);
+			return sse2::FindFirstOf(pBegin, pEnd, pSetBegin, pSetEnd, bInSet);
+		}
+
+
+		EASTL_API const char* simd_string_find_last_of(const char* pBegin, const char* pEnd, const char* pSetBegin, const char* pSetEnd, bool bInSet)
+		{
+			if(pSetBegin == pSetEnd)
+				return (bInSet || (pBegin == pEnd)) ? NULL : (pEnd - 1);
+
+			if(gnSimdFeatures & kSimdFeatureAVX2)
+				return avx2::FindLastOf(pBegin, pEnd, pSetBegin, pSetEnd, bInSet);
+			return sse2::FindLastOf(pBegin, pEnd, pSetBegin, pSetEnd, bInSet);
+		}
+
+
+		EASTL_API size_t simd_mismatch(const void* p1, const void* p2, size_t nSize)
+		{
+			if(gnSimdFeatures & kSimdFeatureAVX2)
+				return avx2::Mismatch((const char*)p1, (const char*)p2, nSize);
+			return sse2::Mismatch((const char*)p1, (const char*)p2, nSize);
+		}
+
+
+		EASTL_API size_t simd_utf8_valid_length(const char* p, size_t n)
+		{
+			if(gnSimdFeatures & kSimdFeatureAVX2)
+				return avx2::Utf8ValidLength(p, n);
+			return sse2::AsciiLength(p, n); // SSE2 has no byte shuffle, which the lookups need.
+		}
+
+
+		EASTL_API size_t simd_utf_transcode_direct(const char* pSrc, size_t n, char16_t* pDest)
+		{
+			if(gnSimdFeatures & kSimdFeatureAVX2)
+				return avx2::WidenAscii(pSrc, n, (uint16_t*)pDest);
+			return sse2::WidenAscii(pSrc, n, (uint16_t*)pDest);
+		}
+
+
+		EASTL_API size_t simd_utf_transcode_direct(const char* pSrc, size_t n, char32_t* pDest)
+		{
+			if(gnSimdFeatures & kSimdFeatureAVX2)
+				return avx2::WidenAscii(pSrc, n, (uint32_t*)pDest);
+			return sse2::WidenAscii(pSrc, n, (uint32_t*)pDest);
+		}
+
+
+		EASTL_API size_t simd_utf_transcode_direct(const char16_t* pSrc, size_t n, char* pDest)
+		{
+			if(gnSimdFeatures & kSimdFeatureAVX2)
+				return avx2::NarrowAscii((const uint16_t*)pSrc, n, pDest);
+			return sse2::NarrowAscii((const uint16_t*)pSrc, n, pDest);
+		}
+
+
+		EASTL_API size_t simd_utf_transcode_direct(const char16_t* pSrc, size_t n, char32_t* pDest)
+		{
+			if(gnSimdFeatures & kSimdFeatureAVX2)
+				return avx2::WidenUtf16((const uint16_t*)pSrc, n, (uint32_t*)pDest);
+			return sse2::WidenUtf16((const uint16_t*)pSrc, n, (uint32_t*)pDest);
+		}
+
+
+		EASTL_API size_t simd_utf_transcode_direct(const char32_t* pSrc, size_t n, char* pDest)
+		{
+			if(gnSimdFeatures & kSimdFeatureAVX2)
+				return avx2::NarrowAscii((const uint32_t*)pSrc, n, pDest);
+			return sse2::NarrowAscii((const uint32_t*)pSrc, n, pDest);
+		}
+
+
+		EASTL_API size_t simd_utf_transcode_direct(const char32_t* pSrc, size_t n, char16_t* pDest)
+		{
+			if(gnSimdFeatures & kSimdFeatureAVX2)
+				return avx2::NarrowUtf32((const uint32_t*)pSrc, n, (uint16_t*)pDest);
+			return sse2::NarrowUtf32((const uint32_t*)pSrc, n, (uint16_t*)pDest);
+		}
+
+
+		// The kernels which only compare for equality are compiled for the unsigned integer type
+		// U of each size, as the integers of a size are equal if their bits are.
+		#define EASTL_SIMD_DEFINE_ALGORITHMS(T, U)                                                                      \
+			EASTL_API const T* simd_find(const T* pBegin, const T* pEnd, T value)                                       \
+			{                                                                                                           \
+				if(gnSimdFeatures & kSimdFeatureAVX2)                                                                   \
+					return (const T*)avx2::FindValue((const U*)pBegin, (const U*)pEnd, (U)value);                       \
+				return (const T*)sse2::FindValue((const U*)pBegin, (const U*)pEnd, (U)value);                           \
+			}                                                                                                           \
+																														\
+			EASTL_API size_t simd_count(const T* pBegin, const T* pEnd, T value)                                        \
+			{                                                                                                           \
+				if(gnSimdFeatures & kSimdFeatureAVX2)                                                                   \
+					return avx2::CountValue((const U*)pBegin, (const U*)pEnd, (U)value);                                \
+				return sse2::CountValue((const U*)pBegin, (const U*)pEnd, (U)value);                                    \
+			}                                                                                                           \
+																														\
+			EASTL_API void simd_replace(T* pBegin, T* pEnd, T oldValue, T newValue)                                     \
+			{                                                                                                           \
+				if(gnSimdFeatures & kSimdFeatureAVX2)                                                                   \
+					avx2::ReplaceValue((U*)pBegin, (U*)pEnd, (U)oldValue, (U)newValue);                                 \
+				else                                                                                                    \
+					sse2::ReplaceValue((U*)pBegin, (U*)pEnd, (U)oldValue, (U)newValue);                                 \
+			}                                                                                                           \
+																														\
+			EASTL_API size_t simd_mismatch_elements(const T* p1, const T* p2, size_t n)                                 \
+			{                                                                                                           \
+				if(gnSimdFeatures & kSimdFeatureAVX2)                                                                   \
+					return avx2::MismatchValues((const U*)p1, (const U*)p2, n);                                         \
+				return sse2::MismatchValues((const U*)p1, (const U*)p2, n);                                             \
+			}                                                                                                           \
+																														\
+			EASTL_API const T* simd_min_element(const T* pBegin, const T* pEnd)                                         \
+			{                                                                                                           \
+				if(gnSimdFeatures & kSimdFeatureAVX2)                                                                   \
+					return avx2::MinElement(pBegin, pEnd);                                                              \
+				return sse2::MinElement(pBegin, pEnd);                                                                  \
+			}                                                                                                           \
+																														\
+			EASTL_API const T* simd_max_element(const T* pBegin, const T* pEnd)                                         \
+			{                                                                                                           \
+				if(gnSimdFeatures & kSimdFeatureAVX2)                                                                   \
+					return avx2::MaxElement(pBegin, pEnd);                                                              \
+				return sse2::MaxElement(pBegin, pEnd);                                                                  \
+			}                                                                                                           \
+																														\
+			EASTL_API bool simd_minmax_element(const T* pBegin, const T* pEnd, const T*& pMin, const T*& pMax)          \
+			{                                                                                                           \
+				if(gnSimdFeatures & kSimdFeatureAVX2)                                                                   \
+					return avx2::MinMaxElement(pBegin, pEnd, pMin, pMax);                                               \
+				return sse2::MinMaxElement(pBegin, pEnd, pMin, pMax);                                                   \
+			}
+
+		EASTL_SIMD_DEFINE_ALGORITHMS(int8_t,   uint8_t)
+		EASTL_SIMD_DEFINE_ALGORITHMS(uint8_t,  uint8_t)
+		EASTL_SIMD_DEFINE_ALGORITHMS(int16_t,  uint16_t)
+		EASTL_SIMD_DEFINE_ALGORITHMS(uint16_t, uint16_t)
+		EASTL_SIMD_DEFINE_ALGORITHMS(int32_t,  uint32_t)
+		EASTL_SIMD_DEFINE_ALGORITHMS(uint32_t, uint32_t)
+		EASTL_SIMD_DEFINE_ALGORITHMS(int64_t,  uint64_t)
+		EASTL_SIMD_DEFINE_ALGORITHMS(uint64_t, uint64_t)
+		EASTL_SIMD_DEFINE_ALGORITHMS(float,    float)
+		EASTL_SIMD_DEFINE_ALGORITHMS(double,   double)
+
+		#undef EASTL_SIMD_DEFINE_ALGORITHMS
+
+	} // namespace Internal
+
+} // namespace std
+
+#endif // EASTL_SIMD_ENABLED
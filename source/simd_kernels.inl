@@ -0,0 +1,752 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// The SIMD kernels, written once in terms of the vector operations of 'simd'.
+// simd.cpp includes this file once per instruction set, each time within a
+// namespace which defines 'simd' as the operations of that instruction set.
+// It therefore has no include guard.
+//
+// A vector holds simd::kSize bytes, and simd::Mask returns one bit per byte.
+// Loops process whole vectors and finish a range with a vector which overlaps
+// the bytes already processed, rather than a byte at a time. Only ranges
+// shorter than a vector are processed with scalar code.
+//
+// The kernels of the algorithms process vectors of elements of type T, with
+// the operations of lanes<T>. Their masks have sizeof(T) bits per element.
+///////////////////////////////////////////////////////////////////////////////
+
+
+typedef simd::type vector_type;
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Matchers
+//
+// A matcher finds the bytes which it matches in a vector (Mask) or in a
+// single char (Match).
+///////////////////////////////////////////////////////////////////////////////
+
+// Matches a single char.
+struct CharMatcher
+{
+	vector_type mVector;
+	char        mChar;
+
+	explicit CharMatcher(char c)
+		: mVector(simd::Set(c)), mChar(c) { }
+
+	uint32_t Mask(const char* p) const { return simd::Mask(simd::Equal(simd::Load(p), mVector)); }
+	bool     Match(char c) const       { return c == mChar; }
+};
+
+
+// Matches the chars in (or not in) a set of up to kSetMatcherMaxSize chars, comparing
+// with each in turn.
+const size_t kSetMatcherMaxSize = 16;
+
+struct SetMatcher
+{
+	vector_type mVectors[kSetMatcherMaxSize];
+	const char* mpSetBegin;
+	const char* mpSetEnd;
+	uint32_t    mnFlipMask;  // Zero to find the chars in the set, all ones to find those not in it.
+
+	SetMatcher(const char* pSetBegin, const char* pSetEnd, bool bInSet)
+		: mpSetBegin(pSetBegin), mpSetEnd(pSetEnd), mnFlipMask(bInSet ? 0 : simd::kAllMask)
+	{
+		for(size_t i = 0, iEnd = (size_t)(pSetEnd - pSetBegin); i < iEnd; i++)
+			mVectors[i] = simd::Set(pSetBegin[i]);
+	}
+
+	uint32_t Mask(const char* p) const
+	{
+		const vector_type v = simd::Load(p);
+		vector_type found = simd::Equal(v, mVectors[0]);
+
+		for(size_t i = 1, iEnd = (size_t)(mpSetEnd - mpSetBegin); i < iEnd; i++)
+			found = simd::Or(found, simd::Equal(v, mVectors[i]));
+
+		return simd::Mask(found) ^ mnFlipMask;
+	}
+
+	bool Match(char c) const
+	{
+		return (memchr(mpSetBegin, c, (size_t)(mpSetEnd - mpSetBegin)) != NULL) != (mnFlipMask != 0);
+	}
+};
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Find
+///////////////////////////////////////////////////////////////////////////////
+
+template <typename Matcher>
+const char* FindFirst(const char* pBegin, const char* pEnd, const Matcher& matcher)
+{
+	const size_t n = (size_t)(pEnd - pBegin);
+	size_t i = 0;
+
+	if(n < simd::kSize)
+	{
+		for(; i < n; i++)
+		{
+			if(matcher.Match(pBegin[i]))
+				return pBegin + i;
+		}
+		return NULL;
+	}
+
+	for(; (i + simd::kSize) <= n; i += simd::kSize)
+	{
+		const uint32_t nMask = matcher.Mask(pBegin + i);
+		if(nMask)
+			return pBegin + i + SimdFirstBit(nMask);
+	}
+
+	if(i < n) // Test the remaining bytes with the last vector of the range, whose first bytes were already tested.
+	{
+		const uint32_t nMask = matcher.Mask(pEnd - simd::kSize) >> (simd::kSize - (n - i));
+		if(nMask)
+			return pBegin + i + SimdFirstBit(nMask);
+	}
+
+	return NULL;
+}
+
+
+template <typename Matcher>
+const char* FindLast(const char* pBegin, const char* pEnd, const Matcher& matcher)
+{
+	const size_t n = (size_t)(pEnd - pBegin);
+	size_t i = n; // The bytes in [pBegin, pBegin + i) are yet to be tested.
+
+	if(n < simd::kSize)
+	{
+		while(i--)
+		{
+			if(matcher.Match(pBegin[i]))
+				return pBegin + i;
+		}
+		return NULL;
+	}
+
+	for(; i >= simd::kSize; i -= simd::kSize)
+	{
+		const uint32_t nMask = matcher.Mask(pBegin + i - simd::kSize);
+		if(nMask)
+			return pBegin + i - simd::kSize + SimdLastBit(nMask);
+	}
+
+	if(i) // Test the remaining bytes with the first vector of the range.
+	{
+		const uint32_t nMask = matcher.Mask(pBegin) & ((1u << i) - 1);
+		if(nMask)
+			return pBegin + SimdLastBit(nMask);
+	}
+
+	return NULL;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Search
+//
+// Finds a pattern of at least 2 chars by its first and last char: a vector of
+// possible positions is compared with the first char of the pattern and the
+// vector m - 1 bytes further on with the last char, and the rest of the pattern
+// is compared only at the positions where both match. This rejects almost all
+// positions in natural text at two compares per vector.
+///////////////////////////////////////////////////////////////////////////////
+
+struct SearchMatcher
+{
+	vector_type mFirst;
+	vector_type mLast;
+	const char* mpPattern;
+	size_t      mnLength;
+
+	SearchMatcher(const char* pPatternBegin, const char* pPatternEnd)
+		: mFirst(simd::Set(pPatternBegin[0]))
+		, mLast(simd::Set(pPatternEnd[-1]))
+		, mpPattern(pPatternBegin)
+		, mnLength((size_t)(pPatternEnd - pPatternBegin)) { }
+
+	// The positions of p + [0, kSize) where the first and last chars match.
+	uint32_t Mask(const char* p) const
+	{
+		return simd::Mask(simd::And(simd::Equal(simd::Load(p), mFirst), simd::Equal(simd::Load(p + mnLength - 1), mLast)));
+	}
+
+	bool Match(const char* p) const
+	{
+		return (p[0] == mpPattern[0]) && (memcmp(p + 1, mpPattern + 1, mnLength - 1) == 0);
+	}
+
+	bool MatchMiddle(const char* p) const
+	{
+		return memcmp(p + 1, mpPattern + 1, mnLength - 2) == 0;
+	}
+};
+
+
+inline const char* Search(const char* pBegin, const char* pEnd, const char* pPatternBegin, const char* pPatternEnd)
+{
+	const size_t m = (size_t)(pPatternEnd - pPatternBegin);
+
+	if((size_t)(pEnd - pBegin) < m)
+		return NULL;
+
+	const SearchMatcher matcher(pPatternBegin, pPatternEnd);
+	const size_t nPositions = (size_t)(pEnd - pBegin) - m + 1;
+	size_t i = 0;
+
+	if(nPositions < simd::kSize)
+	{
+		for(; i < nPositions; i++)
+		{
+			if(matcher.Match(pBegin + i))
+				return pBegin + i;
+		}
+		return NULL;
+	}
+
+	for(; (i + simd::kSize) <= nPositions; i += simd::kSize)
+	{
+		for(uint32_t nMask = matcher.Mask(pBegin + i); nMask; nMask &= (nMask - 1))
+		{
+			const char* const p = pBegin + i + SimdFirstBit(nMask);
+			if(matcher.MatchMiddle(p))
+				return p;
+		}
+	}
+
+	if(i < nPositions)
+	{
+		const size_t nRemaining = nPositions - i;
+
+		for(uint32_t nMask = matcher.Mask(pBegin + nPositions - simd::kSize) >> (simd::kSize - nRemaining); nMask; nMask &= (nMask - 1))
+		{
+			const char* const p = pBegin + i + SimdFirstBit(nMask);
+			if(matcher.MatchMiddle(p))
+				return p;
+		}
+	}
+
+	return NULL;
+}
+
+
+inline const char* RSearch(const char* pBegin, const char* pEnd, const char* pPatternBegin, const char* pPatternEnd)
+{
+	const size_t m = (size_t)(pPatternEnd - pPatternBegin);
+
+	if((size_t)(pEnd - pBegin) < m)
+		return NULL;
+
+	const SearchMatcher matcher(pPatternBegin, pPatternEnd);
+	size_t i = (size_t)(pEnd - pBegin) - m + 1; // The positions in [0, i) are yet to be tested.
+
+	if(i < simd::kSize)
+	{
+		while(i--)
+		{
+			if(matcher.Match(pBegin + i))
+				return pBegin + i;
+		}
+		return NULL;
+	}
+
+	for(; i >= simd::kSize; i -= simd::kSize)
+	{
+		for(uint32_t nMask = matcher.Mask(pBegin + i - simd::kSize); nMask; )
+		{
+			const uint32_t nBit = SimdLastBit(nMask);
+			const char* const p = pBegin + i - simd::kSize + nBit;
+			if(matcher.MatchMiddle(p))
+				return p;
+			nMask &= ~(1u << nBit);
+		}
+	}
+
+	if(i)
+	{
+		for(uint32_t nMask = matcher.Mask(pBegin) & ((1u << i) - 1); nMask; )
+		{
+			const uint32_t nBit = SimdLastBit(nMask);
+			if(matcher.MatchMiddle(pBegin + nBit))
+				return pBegin + nBit;
+			nMask &= ~(1u << nBit);
+		}
+	}
+
+	return NULL;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Mismatch
+///////////////////////////////////////////////////////////////////////////////
+
+inline size_t Mismatch(const char* p1, const char* p2, size_t n)
+{
+	size_t i = 0;
+
+	if(n < simd::kSize)
+	{
+		while((i < n) && (p1[i] == p2[i]))
+			i++;
+		return i;
+	}
+
+	for(; (i + simd::kSize) <= n; i += simd::kSize)
+	{
+		const uint32_t nMask = simd::Mask(simd::Equal(simd::Load(p1 + i), simd::Load(p2 + i))) ^ simd::kAllMask;
+		if(nMask)
+			return i + SimdFirstBit(nMask);
+	}
+
+	if(i < n)
+	{
+		const size_t nLast = n - simd::kSize;
+		const uint32_t nMask = (simd::Mask(simd::Equal(simd::Load(p1 + nLast), simd::Load(p2 + nLast))) ^ simd::kAllMask) >> (simd::kSize - (n - i));
+		if(nMask)
+			return i + SimdFirstBit(nMask);
+	}
+
+	return n;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Algorithms
+//
+// The kernels of find, count, replace, mismatch and min/max_element for ranges
+// of arithmetic types. Elements are compared with the == and < of T, so they
+// give the same results as the scalar algorithms, except that the min/max
+// kernels don't process ranges with a NaN, for which < isn't an ordering.
+///////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+const T* FindValue(const T* pBegin, const T* pEnd, T value)
+{
+	const size_t kCount = simd::kSize / sizeof(T);
+	const size_t n = (size_t)(pEnd - pBegin);
+	size_t i = 0;
+
+	if(n < kCount)
+	{
+		while((i < n) && !(pBegin[i] == value))
+			i++;
+		return pBegin + i;
+	}
+
+	const vector_type v = lanes<T>::Set(value);
+
+	for(; (i + kCount) <= n; i += kCount)
+	{
+		const uint32_t nMask = simd::Mask(lanes<T>::Equal(simd::Load(pBegin + i), v));
+		if(nMask)
+			return pBegin + i + (SimdFirstBit(nMask) / sizeof(T));
+	}
+
+	if(i < n)
+	{
+		const uint32_t nMask = simd::Mask(lanes<T>::Equal(simd::Load(pEnd - kCount), v)) >> ((kCount - (n - i)) * sizeof(T));
+		if(nMask)
+			return pBegin + i + (SimdFirstBit(nMask) / sizeof(T));
+	}
+
+	return pEnd;
+}
+
+
+template <typename T>
+const T* FindLastValue(const T* pBegin, const T* pEnd, T value)
+{
+	const size_t kCount = simd::kSize / sizeof(T);
+	const size_t n = (size_t)(pEnd - pBegin);
+	size_t i = n; // The elements in [pBegin, pBegin + i) are yet to be tested.
+
+	if(n < kCount)
+	{
+		while(i--)
+		{
+			if(pBegin[i] == value)
+				return pBegin + i;
+		}
+		return pEnd;
+	}
+
+	const vector_type v = lanes<T>::Set(value);
+
+	for(; i >= kCount; i -= kCount)
+	{
+		const uint32_t nMask = simd::Mask(lanes<T>::Equal(simd::Load(pBegin + i - kCount), v));
+		if(nMask)
+			return pBegin + i - kCount + (SimdLastBit(nMask) / sizeof(T));
+	}
+
+	if(i)
+	{
+		const uint32_t nMask = simd::Mask(lanes<T>::Equal(simd::Load(pBegin), v)) & ((1u << (i * sizeof(T))) - 1);
+		if(nMask)
+			return pBegin + (SimdLastBit(nMask) / sizeof(T));
+	}
+
+	return pEnd;
+}
+
+
+// Counts in bytes: each vector of matches is subtracted from a vector of byte counts,
+// which is summed before any of its bytes could overflow.
+template <typename T>
+size_t CountValue(const T* pBegin, const T* pEnd, T value)
+{
+	const size_t kCount = simd::kSize / sizeof(T);
+	const size_t n = (size_t)(pEnd - pBegin);
+	size_t i = 0, nResult = 0;
+
+	if(n >= kCount)
+	{
+		const vector_type v = lanes<T>::Set(value);
+		size_t nBytes = 0;
+
+		while((i + kCount) <= n)
+		{
+			const size_t nVectors = (n - i) / kCount;
+			vector_type counts = simd::Zero();
+
+			for(size_t j = 0, jEnd = (nVectors < 255) ? nVectors : 255; j < jEnd; j++, i += kCount)
+				counts = simd::Sub(counts, lanes<T>::Equal(simd::Load(pBegin + i), v));
+
+			nBytes += simd::SumBytes(counts);
+		}
+
+		nResult = nBytes / sizeof(T);
+	}
+
+	for(; i < n; i++)
+	{
+		if(pBegin[i] == value)
+			nResult++;
+	}
+
+	return nResult;
+}
+
+
+// Vectors are only stored if they have a match. The last vector may replace elements which
+// were already replaced, which has no effect, as they equal newValue.
+template <typename T>
+void ReplaceValue(T* pBegin, T* pEnd, T oldValue, T newValue)
+{
+	const size_t kCount = simd::kSize / sizeof(T);
+	const size_t n = (size_t)(pEnd - pBegin);
+
+	if(n < kCount)
+	{
+		for(size_t i = 0; i < n; i++)
+		{
+			if(pBegin[i] == oldValue)
+				pBegin[i] = newValue;
+		}
+		return;
+	}
+
+	const vector_type vOld = lanes<T>::Set(oldValue);
+	const vector_type vNew = lanes<T>::Set(newValue);
+
+	for(size_t i = 0; i < n; i += kCount)
+	{
+		T* const p = ((i + kCount) <= n) ? (pBegin + i) : (pEnd - kCount);
+		const vector_type v     = simd::Load(p);
+		const vector_type found = lanes<T>::Equal(v, vOld);
+
+		if(simd::Mask(found))
+			simd::Store(p, simd::Select(found, v, vNew));
+	}
+}
+
+
+template <typename T>
+size_t MismatchValues(const T* p1, const T* p2, size_t n)
+{
+	const size_t kCount = simd::kSize / sizeof(T);
+	size_t i = 0;
+
+	if(n < kCount)
+	{
+		while((i < n) && (p1[i] == p2[i]))
+			i++;
+		return i;
+	}
+
+	for(; (i + kCount) <= n; i += kCount)
+	{
+		const uint32_t nMask = simd::Mask(lanes<T>::Equal(simd::Load(p1 + i), simd::Load(p2 + i))) ^ simd::kAllMask;
+		if(nMask)
+			return i + (SimdFirstBit(nMask) / sizeof(T));
+	}
+
+	if(i < n)
+	{
+		const size_t nLast = n - kCount;
+		const uint32_t nMask = (simd::Mask(lanes<T>::Equal(simd::Load(p1 + nLast), simd::Load(p2 + nLast))) ^ simd::kAllMask) >> ((kCount - (n - i)) * sizeof(T));
+		if(nMask)
+			return i + (SimdFirstBit(nMask) / sizeof(T));
+	}
+
+	return n;
+}
+
+
+// Finds the least (if bMin) and the greatest (if bMax) of the values in the non-empty
+// range [pBegin, pEnd). Returns false if the range has a NaN.
+template <typename T, bool bMin, bool bMax>
+bool MinMaxValues(const T* pBegin, const T* pEnd, T& minValue, T& maxValue)
+{
+	const size_t kCount = simd::kSize / sizeof(T);
+	const size_t n = (size_t)(pEnd - pBegin);
+
+	if(n < kCount)
+	{
+		minValue = maxValue = pBegin[0];
+
+		for(size_t i = 0; i < n; i++)
+		{
+			if(!(pBegin[i] == pBegin[i])) // NaN
+				return false;
+			if(pBegin[i] < minValue)
+				minValue = pBegin[i];
+			if(maxValue < pBegin[i])
+				maxValue = pBegin[i];
+		}
+		return true;
+	}
+
+	vector_type vMin = simd::Load(pBegin);
+	vector_type vMax = vMin;
+	vector_type vNaN = lanes<T>::NaN(vMin);
+
+	for(size_t i = kCount; i < n; i += kCount)
+	{
+		const vector_type v = simd::Load(((i + kCount) <= n) ? (pBegin + i) : (pEnd - kCount));
+
+		if(bMin)
+			vMin = lanes<T>::Min(vMin, v);
+		if(bMax)
+			vMax = lanes<T>::Max(vMax, v);
+		vNaN = simd::Or(vNaN, lanes<T>::NaN(v));
+	}
+
+	if(simd::Mask(vNaN))
+		return false;
+
+	T values[kCount];
+
+	if(bMin)
+	{
+		simd::Store(values, vMin);
+		minValue = values[0];
+		for(size_t j = 1; j < kCount; j++)
+		{
+			if(values[j] < minValue)
+				minValue = values[j];
+		}
+	}
+
+	if(bMax)
+	{
+		simd::Store(values, vMax);
+		maxValue = values[0];
+		for(size_t j = 1; j < kCount; j++)
+		{
+			if(maxValue < values[j])
+				maxValue = values[j];
+		}
+	}
+
+	return true;
+}
+
+
+// The min/max kernels find the least or greatest value, then the first (or for the
+// greatest value of minmax_element, the last) element which equals it.
+template <typename T>
+const T* MinElement(const T* pBegin, const T* pEnd)
+{
+	T minValue, maxValue;
+
+	if(!MinMaxValues<T, true, false>(pBegin, pEnd, minValue, maxValue))
+		return NULL;
+	return FindValue(pBegin, pEnd, minValue);
+}
+
+
+template <typename T>
+const T* MaxElement(const T* pBegin, const T* pEnd)
+{
+	T minValue, maxValue;
+
+	if(!MinMaxValues<T, false, true>(pBegin, pEnd, minValue, maxValue))
+		return NULL;
+	return FindValue(pBegin, pEnd, maxValue);
+}
+
+
+template <typename T>
+bool MinMaxElement(const T* pBegin, const T* pEnd, const T*& pMin, const T*& pMax)
+{
+	T minValue, maxValue;
+
+	if(!MinMaxValues<T, true, true>(pBegin, pEnd, minValue, maxValue))
+		return false;
+
+	pMin = FindValue(pBegin, pEnd, minValue);
+	pMax = FindLastValue(pBegin, pEnd, maxValue);
+	return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// UTF
+//
+// The kernels of the UTF transcoders convert the leading elements of the
+// source which each convert to one element of the same value, in whole
+// vectors, and return their number. The transcoders convert the rest, from
+// the first vector with an element which doesn't, with scalar code. Vectors
+// of the wider elements are narrowed with simd::Narrow16 and simd::Narrow32,
+// and the narrower are widened with simd::StoreWidened (bytes) and
+// simd::StoreWidened16 (16-bit elements).
+///////////////////////////////////////////////////////////////////////////////
+
+// The number of leading bytes of [p, p + n) below 0x80.
+size_t AsciiLength(const char* p, size_t n)
+{
+	size_t i = 0;
+
+	for(; (i + simd::kSize) <= n; i += simd::kSize)
+	{
+		const uint32_t nMask = simd::Mask(simd::Load(p + i));
+
+		if(nMask)
+			return i + SimdFirstBit(nMask);
+	}
+
+	while((i < n) && ((uint8_t)p[i] < 0x80))
+		++i;
+
+	return i;
+}
+
+
+// ASCII to UTF-16 or UTF-32, where Dest is uint16_t or uint32_t.
+template <typename Dest>
+size_t WidenAscii(const char* pSrc, size_t n, Dest* pDest)
+{
+	size_t i = 0;
+
+	for(; (i + simd::kSize) <= n; i += simd::kSize)
+	{
+		const vector_type v = simd::Load(pSrc + i);
+
+		if(simd::Mask(v))
+			break;
+		simd::StoreWidened(pDest + i, v);
+	}
+
+	return i;
+}
+
+
+// ASCII in UTF-16 to UTF-8.
+size_t NarrowAscii(const uint16_t* pSrc, size_t n, char* pDest)
+{
+	const vector_type nonAscii = lanes<uint16_t>::Set(0xff80);
+	size_t i = 0;
+
+	for(; (i + simd::kSize) <= n; i += simd::kSize)
+	{
+		const vector_type a = simd::Load(pSrc + i);
+		const vector_type b = simd::Load(pSrc + i + (simd::kSize / 2));
+
+		if(simd::Mask(simd::Equal(simd::And(simd::Or(a, b), nonAscii), simd::Zero())) != simd::kAllMask)
+			break;
+		simd::Store(pDest + i, simd::Narrow16(a, b));
+	}
+
+	return i;
+}
+
+
+// ASCII in UTF-32 to UTF-8.
+size_t NarrowAscii(const uint32_t* pSrc, size_t n, char* pDest)
+{
+	const vector_type nonAscii = lanes<uint32_t>::Set(0xffffff80);
+	const size_t      kQuarter = simd::kSize / 4;
+	size_t i = 0;
+
+	for(; (i + simd::kSize) <= n; i += simd::kSize)
+	{
+		const vector_type a = simd::Load(pSrc + i);
+		const vector_type b = simd::Load(pSrc + i + kQuarter);
+		const vector_type c = simd::Load(pSrc + i + (kQuarter * 2));
+		const vector_type d = simd::Load(pSrc + i + (kQuarter * 3));
+
+		if(simd::Mask(simd::Equal(simd::And(simd::Or(simd::Or(a, b), simd::Or(c, d)), nonAscii), simd::Zero())) != simd::kAllMask)
+			break;
+		simd::Store(pDest + i, simd::Narrow16(simd::Narrow32(a, b), simd::Narrow32(c, d)));
+	}
+
+	return i;
+}
+
+
+// UTF-16 to UTF-32, up to the first surrogate.
+size_t WidenUtf16(const uint16_t* pSrc, size_t n, uint32_t* pDest)
+{
+	const vector_type surrogateMask = lanes<uint16_t>::Set(0xf800);
+	const vector_type surrogate     = lanes<uint16_t>::Set(0xd800);
+	const size_t      kCount        = simd::kSize / 2;
+	size_t i = 0;
+
+	for(; (i + kCount) <= n; i += kCount)
+	{
+		const vector_type v = simd::Load(pSrc + i);
+
+		if(simd::Mask(lanes<uint16_t>::Equal(simd::And(v, surrogateMask), surrogate)))
+			break;
+		simd::StoreWidened16(pDest + i, v);
+	}
+
+	return i;
+}
+
+
+// UTF-32 to UTF-16, up to the first code point which is a surrogate or above 0xffff.
+size_t NarrowUtf32(const uint32_t* pSrc, size_t n, uint16_t* pDest)
+{
+	const vector_type highBits      = lanes<uint32_t>::Set(0xffff0000);
+	const vector_type surrogateMask = lanes<uint32_t>::Set(0xf800);
+	const vector_type surrogate     = lanes<uint32_t>::Set(0xd800);
+	const size_t      kCount        = simd::kSize / 2;
+	size_t i = 0;
+
+	for(; (i + kCount) <= n; i += kCount)
+	{
+		const vector_type a = simd::Load(pSrc + i);
+		const vector_type b = simd::Load(pSrc + i + (kCount / 2));
+
+		if(simd::Mask(simd::Equal(simd::And(simd::Or(a, b), highBits), simd::Zero())) != simd::kAllMask)
+			break;
+		if(simd::Mask(simd::Or(lanes<uint32_t>::Equal(simd::And(a, surrogateMask), surrogate),
+							   lanes<uint32_t>::Equal(simd::And(b, surrogateMask), surrogate))))
+			break;
+		simd::Store(pDest + i, simd::Narrow32(a, b));
+	}
+
+	return i;
+}
@@ -4,7 +4,9 @@
 
 
 #include <EASTL/internal/config.h>
+#include <EASTL/internal/simd.h>
 #include <EASTL/string.h>
+#include <EASTL/utf.h>
 #include <EABase/eabase.h>
 #include <string.h>
 
@@ -12,383 +14,554 @@
 namespace std
 {
 	///////////////////////////////////////////////////////////////////////////////
-	// Converters for DecodePart
+	// UTF transcoding
+	//
+	// All conversions go through Transcode, which decodes a code point from the
+	// source and encodes it to the destination, except for runs of elements which
+	// each convert to one element of the same value (ASCII, or for UTF-16 to
+	// UTF-32 and back, code points below 0x10000 which aren't surrogates), which
+	// it copies, with the SIMD kernels when it can.
+	//
+	// Transcode replaces each invalid UTF-8 byte, unpaired surrogate and invalid
+	// code point with kUtfReplacement. EASTL doesn't have a concept of setting or
+	// maintaining error state for string conversions, though it does have a
+	// policy of converting impossible values to something without generating
+	// invalid strings or throwing exceptions.
 	//
 	// For some decent documentation about conversions, see:
 	//     http://tidy.sourceforge.net/cgi-bin/lxr/source/src/utf8.c
-	//     
+	//
 	///////////////////////////////////////////////////////////////////////////////
 
-	// Requires that pDest have a capacity of at least 6 chars.
-	// Sets pResult to '\1' in the case that c is an invalid UCS4 char.
-	inline bool UCS4ToUTF8(uint32_t c, char*& pResult)
+	namespace
 	{
-		if(c < 0x00000080)
-			*pResult++ = (char)(uint8_t)c;
-		else if(c < 0x0800)
-		{
-			*pResult++ = (char)(uint8_t)(0xC0 | (c >> 6));
-			*pResult++ = (char)(uint8_t)(0x80 | (c & 0x3F));
-		}
-		else if(c <= 0x0000FFFF)
-		{
-			*pResult++ = (char)(uint8_t)(0xE0 | (c >> 12));
-			*pResult++ = (char)(uint8_t)(0x80 | ((c >> 6) & 0x3F));
-			*pResult++ = (char)(uint8_t)(0x80 | (c & 0x3F));
-		}
-		else if(c <= 0x001FFFFF)
-		{
-			*pResult++ = (char)(uint8_t)(0xF0 | (c >> 18));
-			*pResult++ = (char)(uint8_t)(0x80 | ((c >> 12) & 0x3F));
-			*pResult++ = (char)(uint8_t)(0x80 | ((c >> 6) & 0x3F));
-			*pResult++ = (char)(uint8_t)(0x80 | (c & 0x3F));
-		}
-		else if(c <= 0x003FFFFFF)
+		const uint32_t kUtfReplacement = 0xffff;
+
+
+		// Decodes the code point at p, which is before pEnd and isn't a direct element (see
+		// IsDirect). On success, sets c and advances p past the code point. Otherwise returns
+		// false and advances p by one element.
+		inline bool DecodeUtf(const char*& p, const char* pEnd, uint32_t& c)
 		{
-			*pResult++ = (char)(uint8_t)(0xF8 | (c >> 24));
-			*pResult++ = (char)(uint8_t)(0x80 | (c >> 18));
-			*pResult++ = (char)(uint8_t)(0x80 | ((c >> 12) & 0x3F));
-			*pResult++ = (char)(uint8_t)(0x80 | ((c >> 6) & 0x3F));
-			*pResult++ = (char)(uint8_t)(0x80 | (c & 0x3F));
+			const uint8_t c0 = (uint8_t)*p;
+			size_t        nLength;
+			uint32_t      cMin;
+
+			if(c0 < 0xc2) // A continuation byte, or the lead byte of an overlong two byte sequence.
+			{
+				++p;
+				return false;
+			}
+			else if(c0 < 0xe0)
+			{
+				nLength = 2;
+				cMin    = 0x80;
+				c       = c0 & 0x1f;
+			}
+			else if(c0 < 0xf0)
+			{
+				nLength = 3;
+				cMin    = 0x800;
+				c       = c0 & 0x0f;
+			}
+			else if(c0 < 0xf5)
+			{
+				nLength = 4;
+				cMin    = 0x10000;
+				c       = c0 & 0x07;
+			}
+			else
+			{
+				++p;
+				return false;
+			}
+
+			if((size_t)(pEnd - p) < nLength)
+			{
+				++p;
+				return false;
+			}
+
+			for(size_t i = 1; i < nLength; i++)
+			{
+				const uint8_t cNext = (uint8_t)p[i];
+
+				if((cNext & 0xc0) != 0x80)
+				{
+					++p;
+					return false;
+				}
+				c = (c << 6) | (cNext & 0x3f);
+			}
+
+			if((c < cMin) || (c > 0x10ffff) || ((c - 0xd800) < 0x800)) // Overlong, too large, or a surrogate.
+			{
+				++p;
+				return false;
+			}
+
+			p += nLength;
+			return true;
 		}
-		else if(c <= 0x7FFFFFFF)
+
+		inline bool DecodeUtf(const char16_t*& p, const char16_t* pEnd, uint32_t& c)
 		{
-			*pResult++ = (char)(uint8_t)(0xFC | (c >> 30));
-			*pResult++ = (char)(uint8_t)(0x80 | ((c >> 24) & 0x3F));
-			*pResult++ = (char)(uint8_t)(0x80 | ((c >> 18) & 0x3F));
-			*pResult++ = (char)(uint8_t)(0x80 | ((c >> 12) & 0x3F));
-			*pResult++ = (char)(uint8_t)(0x80 | ((c >> 6) & 0x3F));
-			*pResult++ = (char)(uint8_t)(0x80 | (c & 0x3F));
+			c = (uint32_t)*p++;
+
+			if((c - 0xd800) >= 0x800)
+				return true;
+
+			if((c < 0xdc00) && (p != pEnd) && (((uint32_t)*p - 0xdc00) < 0x400)) // A high surrogate followed by a low one.
+			{
+				c = 0x10000 + ((c - 0xd800) << 10) + ((uint32_t)*p++ - 0xdc00);
+				return true;
+			}
+
+			return false;
 		}
-		else
+
+		inline bool DecodeUtf(const char32_t*& p, const char32_t*, uint32_t& c)
 		{
-			// values >= 0x80000000 can't be converted to UTF8.
-			*pResult++ = '\1';
-			return false;
+			c = (uint32_t)*p++;
+			return (c <= 0x10ffff) && ((c - 0xd800) >= 0x800);
 		}
 
-		return true;
-	}
 
+		// Decodes the code point at p, as above, in text which is known to be valid.
+		inline uint32_t DecodeValidUtf(const char*& p)
+		{
+			const uint32_t c0 = (uint8_t)*p;
+			uint32_t       c;
 
-	// Requires that pResult have a capacity of at least 3 chars.
-	// Sets pResult to '\1' in the case that c is an invalid UCS4 char.
-	inline bool UCS2ToUTF8(uint16_t c, char*& pResult)
-	{
-		return UCS4ToUTF8(c, pResult);
-	}
+			if(c0 < 0xe0)
+			{
+				c  = ((c0 & 0x1f) << 6) | ((uint8_t)p[1] & 0x3fu);
+				p += 2;
+			}
+			else if(c0 < 0xf0)
+			{
+				c  = ((c0 & 0x0f) << 12) | (((uint8_t)p[1] & 0x3fu) << 6) | ((uint8_t)p[2] & 0x3fu);
+				p += 3;
+			}
+			else
+			{
+				c  = ((c0 & 0x07) << 18) | (((uint8_t)p[1] & 0x3fu) << 12) | (((uint8_t)p[2] & 0x3fu) << 6) | ((uint8_t)p[3] & 0x3fu);
+				p += 4;
+			}
 
+			return c;
+		}
 
-	// Sets result to 0xffff in the case that the input UTF8 sequence is bad.
-	// 32 bit 0xffffffff is an invalid UCS4 code point, so we can't use that as an error return value.
-	inline bool UTF8ToUCS4(const char*& p, const char* pEnd, uint32_t& result)
-	{
-		// This could likely be implemented in a faster-executing way that uses tables.
+		inline uint32_t DecodeValidUtf(const char16_t*& p)
+		{
+			const uint32_t c = (uint32_t)*p++;
 
-		bool           success = true;
-		uint32_t       c = 0xffff;
-		const char* pNext = NULL;
+			if((c - 0xd800) >= 0x800)
+				return c;
+			return 0x10000 + ((c - 0xd800) << 10) + ((uint32_t)*p++ - 0xdc00);
+		}
 
-		if(p < pEnd)
+		inline uint32_t DecodeValidUtf(const char32_t*& p)
 		{
-			uint8_t cChar0((uint8_t)*p), cChar1, cChar2, cChar3;
+			return (uint32_t)*p++;
+		}
 
-			// Asserts are disabled because we don't necessarily want to interrupt runtime execution due to this.
-			// EASTL_ASSERT((cChar0 != 0xFE) && (cChar0 != 0xFF));     //  No byte can be 0xFE or 0xFF
-			// Code below will effectively catch this error as it goes.
 
-			if(cChar0 < 0x80)
+		// Encodes the code point c, which is valid or kUtfReplacement.
+		inline void EncodeUtf(uint32_t c, char*& p)
+		{
+			if(c < 0x80)
+				*p++ = (char)(uint8_t)c;
+			else if(c < 0x800)
 			{
-				pNext = p + 1;
-				c     = cChar0;
+				*p++ = (char)(uint8_t)(0xc0 | (c >> 6));
+				*p++ = (char)(uint8_t)(0x80 | (c & 0x3f));
+			}
+			else if(c < 0x10000)
+			{
+				*p++ = (char)(uint8_t)(0xe0 | (c >> 12));
+				*p++ = (char)(uint8_t)(0x80 | ((c >> 6) & 0x3f));
+				*p++ = (char)(uint8_t)(0x80 | (c & 0x3f));
 			}
 			else
 			{
-				//EASTL_ASSERT((cChar0 & 0xC0) == 0xC0);              //  The top two bits need to be equal to 1
-				if((cChar0 & 0xC0) != 0xC0)
+				*p++ = (char)(uint8_t)(0xf0 | (c >> 18));
+				*p++ = (char)(uint8_t)(0x80 | ((c >> 12) & 0x3f));
+				*p++ = (char)(uint8_t)(0x80 | ((c >> 6) & 0x3f));
+				*p++ = (char)(uint8_t)(0x80 | (c & 0x3f));
+			}
+		}
+
+		inline void EncodeUtf(uint32_t c, char16_t*& p)
+		{
+			if(c < 0x10000)
+				*p++ = (char16_t)c;
+			else
+			{
+				*p++ = (char16_t)(0xd800 + ((c - 0x10000) >> 10));
+				*p++ = (char16_t)(0xdc00 + ((c - 0x10000) & 0x3ff));
+			}
+		}
+
+		inline void EncodeUtf(uint32_t c, char32_t*& p)
+		{
+			*p++ = (char32_t)c;
+		}
+
+
+		// Returns true if c converts to one element of the same value.
+		inline bool IsDirect(char c,     const char16_t*) { return (uint8_t)c < 0x80; }
+		inline bool IsDirect(char c,     const char32_t*) { return (uint8_t)c < 0x80; }
+		inline bool IsDirect(char16_t c, const char*)     { return c < 0x80; }
+		inline bool IsDirect(char16_t c, const char32_t*) { return ((uint32_t)c - 0xd800) >= 0x800; }
+		inline bool IsDirect(char32_t c, const char*)     { return c < 0x80; }
+		inline bool IsDirect(char32_t c, const char16_t*) { return (c < 0x10000) && (((uint32_t)c - 0xd800) >= 0x800); }
+
+
+		// Copies the run of direct elements at p.
+		template <typename Src, typename Dest>
+		inline void TranscodeDirect(const Src*& p, const Src* pEnd, Dest*& pDest)
+		{
+			#if EASTL_SIMD_ENABLED
+				// The kernels are called for runs which look long enough to fill a vector, so as not
+				// to call them for each word of mixed text.
+				if(((pEnd - p) >= 32) && IsDirect(p[1], pDest) && IsDirect(p[7], pDest) && IsDirect(p[15], pDest))
 				{
-					success = false;
-					goto Failure;
+					const size_t n = Internal::simd_utf_transcode_direct(p, (size_t)(pEnd - p), pDest);
+					p     += n;
+					pDest += n;
 				}
+			#endif
 
-				if((cChar0 & 0xE0) == 0xC0)
-				{
-					pNext = p + 2;
+			while((p != pEnd) && IsDirect(*p, pDest))
+				*pDest++ = (Dest)*p++;
+		}
 
-					if(pNext <= pEnd)
-					{
-						c      = (uint32_t)((cChar0 & 0x1F) << 6);
-						cChar1 = static_cast<uint8_t>(p[1]);
-						c     |= cChar1 & 0x3F;
-
-						//EASTL_ASSERT((cChar1 & 0xC0) == 0x80);          //  All subsequent code should be b10xxxxxx
-						//EASTL_ASSERT(c >= 0x0080 && c < 0x0800);        //  Check that we have the smallest coding
-						if(!((cChar1 & 0xC0) == 0x80) ||
-						   !(c >= 0x0080 && c < 0x0800))
-						{
-							success = false;
-							goto Failure;
-						}
-					}
-					else
-					{
-						success = false;
-						goto Failure;
-					}
-				}
-				else if((cChar0 & 0xF0) == 0xE0)
-				{
-					pNext = p + 3;
 
-					if(pNext <= pEnd)
-					{
-						c      = (uint32_t)((cChar0 & 0xF) << 12);
-						cChar1 = static_cast<uint8_t>(p[1]);
-						c     |= (cChar1 & 0x3F) << 6;
-						cChar2 = static_cast<uint8_t>(p[2]);
-						c     |= cChar2 & 0x3F;
-
-						//EASTL_ASSERT((cChar1 & 0xC0) == 0x80);            //  All subsequent code should be b10xxxxxx
-						//EASTL_ASSERT((cChar2 & 0xC0) == 0x80);            //  All subsequent code should be b10xxxxxx
-						//EASTL_ASSERT(c >= 0x00000800 && c <  0x00010000); //  Check that we have the smallest coding
-						if(!((cChar1 & 0xC0) == 0x80) ||
-						   !((cChar2 & 0xC0) == 0x80) ||
-						   !(c >= 0x00000800 && c <  0x00010000))
-						{
-							success = false;
-							goto Failure;
-						}
-					}
-					else
-					{
-						success = false;
-						goto Failure;
-					}
-				}
-				else if((cChar0 & 0xF8) == 0xF0)
-				{
-					pNext = p + 4;
+		// Converts [p, pEnd) to pDest, which must have room for the result; MaxTranscodedLength
+		// gives the most elements which each source element converts to. Returns false if it
+		// replaced invalid text.
+		template <typename Src, typename Dest>
+		bool Transcode(const Src*& p, const Src* pEnd, Dest*& pDest)
+		{
+			bool bValid = true;
 
-					if(pNext <= pEnd)
-					{
-						c      = (uint32_t)((cChar0 & 0x7) << 18);
-						cChar1 = static_cast<uint8_t>(p[1]);
-						c     |= (uint32_t)((cChar1 & 0x3F) << 12);
-						cChar2 = static_cast<uint8_t>(p[2]);
-						c     |= (cChar2 & 0x3F) << 6;
-						cChar3 = static_cast<uint8_t>(p[3]);
-						c     |= cChar3 & 0x3F;
-
-						//EASTL_ASSERT((cChar0 & 0xf8) == 0xf0);            //  We handle the unicode but not UCS-4
-						//EASTL_ASSERT((cChar1 & 0xC0) == 0x80);            //  All subsequent code should be b10xxxxxx
-						//EASTL_ASSERT((cChar2 & 0xC0) == 0x80);            //  All subsequent code should be b10xxxxxx
-						//EASTL_ASSERT((cChar3 & 0xC0) == 0x80);            //  All subsequent code should be b10xxxxxx
-						//EASTL_ASSERT(c >= 0x00010000 && c <= 0x0010FFFF); //  Check that we have the smallest coding, Unicode and not ucs-4
-						if(!((cChar0 & 0xf8) == 0xf0) ||
-						   !((cChar1 & 0xC0) == 0x80) ||
-						   !((cChar2 & 0xC0) == 0x80) ||
-						   !(c >= 0x00010000 && c <= 0x0010FFFF))
-						{
-							success = false;
-							goto Failure;
-						}
-					}
-					else
-					{
-						success = false;
-						goto Failure;
-					}
-				}
-				else if((cChar0 & 0xFC) == 0xF8)
+			while(p != pEnd)
+			{
+				if(IsDirect(*p, pDest))
+					TranscodeDirect(p, pEnd, pDest);
+				else
 				{
-					pNext = p + 4;
+					uint32_t c;
 
-					if(pNext <= pEnd)
-					{
-						// To do. We don't currently support extended UCS4 characters.
-					}
-					else
+					if(!DecodeUtf(p, pEnd, c))
 					{
-						success = false;
-						goto Failure;
+						c      = kUtfReplacement;
+						bValid = false;
 					}
+					EncodeUtf(c, pDest);
 				}
-				else if((cChar0 & 0xFE) == 0xFC)
-				{
-					pNext = p + 5;
+			}
 
-					if(pNext <= pEnd)
-					{
-						// To do. We don't currently support extended UCS4 characters.
-					}
-					else
-					{
-						success = false;
-						goto Failure;
-					}
-				}
-				else
-				{
-					success = false;
-					goto Failure;
-				}
+			return bValid;
+		}
+
+		inline size_t MaxTranscodedLength(const char*,     const char16_t*) { return 1; }
+		inline size_t MaxTranscodedLength(const char*,     const char32_t*) { return 1; }
+		inline size_t MaxTranscodedLength(const char16_t*, const char*)     { return 3; }
+		inline size_t MaxTranscodedLength(const char16_t*, const char32_t*) { return 1; }
+		inline size_t MaxTranscodedLength(const char32_t*, const char*)     { return 4; }
+		inline size_t MaxTranscodedLength(const char32_t*, const char16_t*) { return 2; }
+
+
+		// Returns the beginning of the code point which pEnd splits, if it splits one, or else
+		// pEnd, so that text can be converted in parts. pEnd must be before the end of the text.
+		inline const char* CodePointBoundary(const char* pBegin, const char* pEnd)
+		{
+			const char* p = pEnd;
+
+			for(int i = 0; (i < 3) && (p != pBegin) && (((uint8_t)p[-1] & 0xc0) == 0x80); i++)
+				--p;
+
+			if(p != pBegin)
+			{
+				const uint8_t c = (uint8_t)p[-1];
+				const ptrdiff_t nLength = (c >= 0xf0) ? 4 : (c >= 0xe0) ? 3 : (c >= 0xc0) ? 2 : 1;
+
+				if((pEnd - p) + 1 < nLength)
+					return p - 1;
 			}
+
+			return pEnd;
 		}
-		else
-			success = false;
 
-		Failure:
-		if(success)
+		inline const char16_t* CodePointBoundary(const char16_t* pBegin, const char16_t* pEnd)
 		{
-			p = pNext;
-			result = c;
+			return ((pEnd != pBegin) && (((uint32_t)pEnd[-1] - 0xd800) < 0x400)) ? (pEnd - 1) : pEnd;
 		}
-		else
+
+		inline const char32_t* CodePointBoundary(const char32_t*, const char32_t* pEnd)
 		{
-			p = p + 1;
-			result = 0xffff;
+			return pEnd;
 		}
 
-		return success;
-	}
 
-	// Sets result to 0xffff in the case that the input UTF8 sequence is bad.
-	// The effect of converting UTF8 codepoints > 0xffff to UCS2 (char16_t) is to set all
-	// such codepoints to 0xffff. EASTL doesn't have a concept of setting or maintaining 
-	// error state for string conversions, though it does have a policy of converting 
-	// impossible values to something without generating invalid strings or throwing exceptions.
-	inline bool UTF8ToUCS2(const char*& p, const char* pEnd, uint16_t& result)
-	{
-		uint32_t u32;
+		// Converts as much of [pSrc, pSrcEnd) as is sure to fit in [pDest, pDestEnd), up to the
+		// end of a code point, for DecodePart.
+		template <typename Src, typename Dest>
+		bool TranscodePart(const Src*& pSrc, const Src* pSrcEnd, Dest*& pDest, Dest* pDestEnd)
+		{
+			const size_t nMaxLength = MaxTranscodedLength(pSrc, pDest);
+			const size_t nCount     = (size_t)(pDestEnd - pDest) / nMaxLength;
+			const Src*   pEnd       = pSrcEnd;
+
+			if(nCount < (size_t)(pSrcEnd - pSrc))
+			{
+				EASTL_ASSERT(nCount >= 4); // The user must provide ample buffer space, preferably 256 chars or more.
+				pEnd = CodePointBoundary(pSrc, pSrc + nCount);
+			}
+
+			return Transcode(pSrc, pEnd, pDest);
+		}
+
+
+		inline uint64_t Load8(const char* p)
+		{
+			uint64_t x;
+			memcpy(&x, p, sizeof(x));
+			return x;
+		}
 
-		if(UTF8ToUCS4(p, pEnd, u32))
+		inline bool IsAscii8(const char* p) // Returns true if the 8 bytes at p are ASCII.
 		{
-			if(u32 <= 0xffff)
+			return (Load8(p) & UINT64_C(0x8080808080808080)) == 0;
+		}
+
+		inline size_t CountBytes(uint64_t x) // Returns the number of the 8 bytes of x with the high bit set.
+		{
+			return (size_t)((((x >> 7) & UINT64_C(0x0101010101010101)) * UINT64_C(0x0101010101010101)) >> 56);
+		}
+
+
+		// Converts the n elements at p, which are known to be valid text, as Transcode does.
+		template <typename Src, typename Dest>
+		size_t TranscodeValid(const Src* p, size_t n, Dest* pDest)
+		{
+			const Src* const pEnd   = p + n;
+			Dest* const      pBegin = pDest;
+
+			while(p != pEnd)
 			{
-				result = (uint16_t)u32;
-				return true;
+				if(IsDirect(*p, pDest))
+					TranscodeDirect(p, pEnd, pDest);
+				else
+					EncodeUtf(DecodeValidUtf(p), pDest);
 			}
+
+			return (size_t)(pDest - pBegin);
 		}
 
-		result = 0xffff;
-		return false;
-	}
+	} // namespace
 
 
 
 	///////////////////////////////////////////////////////////////////////////
-	// DecodePart
+	// Validation
 	///////////////////////////////////////////////////////////////////////////
 
-	EASTL_API bool DecodePart(const char*& pSrc, const char* pSrcEnd, char*& pDest, char* pDestEnd)
+	EASTL_API bool utf8_validate(const char* p, size_t n)
 	{
-		size_t sourceSize = (size_t)(pSrcEnd - pSrc);
-		size_t destSize   = (size_t)(pDestEnd - pDest);
+		const char* const pEnd = p + n;
 
-		if(sourceSize > destSize)
-		   sourceSize = destSize;
+		#if EASTL_SIMD_ENABLED
+			p += Internal::simd_utf8_valid_length(p, n);
+		#endif
 
-		memmove(pDest, (void*)pSrc, sourceSize * sizeof(*pSrcEnd));
-
-		pSrc  += sourceSize;
-		pDest += sourceSize; // Intentionally add sourceSize here.
+		while(p != pEnd)
+		{
+			if((uint8_t)*p < 0x80)
+			{
+				while(((pEnd - p) >= 8) && IsAscii8(p))
+					p += 8;
+				while((p != pEnd) && ((uint8_t)*p < 0x80))
+					++p;
+			}
+			else
+			{
+				uint32_t c;
+				if(!DecodeUtf(p, pEnd, c))
+					return false;
+			}
+		}
 
 		return true;
 	}
 
-	EASTL_API bool DecodePart(const char*& pSrc, const char* pSrcEnd, char16_t*& pDest, char16_t* pDestEnd)
+
+	EASTL_API bool utf16_validate(const char16_t* p, size_t n)
 	{
-		bool success = true;
+		const char16_t* const pEnd = p + n;
 
-		while(success && (pSrc < pSrcEnd) && (pDest < pDestEnd))
-			success = UTF8ToUCS2(pSrc, pSrcEnd, (uint16_t&)*pDest++);
+		while(p != pEnd)
+		{
+			uint32_t c;
+			if(!DecodeUtf(p, pEnd, c))
+				return false;
+		}
 
-		return success;
+		return true;
 	}
 
-	EASTL_API bool DecodePart(const char*& pSrc, const char* pSrcEnd, char32_t*& pDest, char32_t* pDestEnd)
+
+	EASTL_API bool utf32_validate(const char32_t* p, size_t n)
 	{
-		bool success = true;
+		uint32_t nInvalid = 0;
 
-		while(success && (pSrc < pSrcEnd) && (pDest < pDestEnd))
-			success = UTF8ToUCS4(pSrc, pSrcEnd, (uint32_t&)*pDest++);
+		for(size_t i = 0; i < n; i++) // Without branches, so that it vectorizes.
+			nInvalid |= (uint32_t)(p[i] > 0x10ffff) | (uint32_t)(((uint32_t)p[i] - 0xd800) < 0x800);
 
-		return success;
+		return nInvalid == 0;
 	}
 
 
-	EASTL_API bool DecodePart(const char16_t*& pSrc, const char16_t* pSrcEnd, char*& pDest, char* pDestEnd)
+
+	///////////////////////////////////////////////////////////////////////////
+	// Lengths
+	//
+	// These count without branches, so that they vectorize.
+	///////////////////////////////////////////////////////////////////////////
+
+	EASTL_API size_t utf8_length_from_utf16(const char16_t* p, size_t n)
 	{
-		bool success = true;
+		size_t nLength = n;
+
+		for(size_t i = 0; i < n; i++) // A surrogate pair is 4 bytes, so each surrogate counts as 2.
+			nLength += (size_t)(p[i] >= 0x80) + (size_t)(p[i] >= 0x800) - (size_t)(((uint32_t)p[i] - 0xd800) < 0x800);
+
+		return nLength;
+	}
 
-		EASTL_ASSERT((pDest + 6) < pDestEnd); // The user must provide ample buffer space, preferably 256 chars or more.
-		pDestEnd -= 6; // Do this so that we can avoid dest buffer size checking in the loop below and the function it calls.
 
-		while(success && (pSrc < pSrcEnd) && (pDest < pDestEnd))
-			success = UCS2ToUTF8(*pSrc++, pDest);
+	EASTL_API size_t utf8_length_from_utf32(const char32_t* p, size_t n)
+	{
+		size_t nLength = n;
+
+		for(size_t i = 0; i < n; i++)
+			nLength += (size_t)(p[i] >= 0x80) + (size_t)(p[i] >= 0x800) + (size_t)(p[i] >= 0x10000);
 
-		return success;
+		return nLength;
 	}
 
-	EASTL_API bool DecodePart(const char16_t*& pSrc, const char16_t* pSrcEnd, char16_t*& pDest, char16_t* pDestEnd)
+
+	EASTL_API size_t utf16_length_from_utf8(const char* p, size_t n)
 	{
-		size_t sourceSize = (size_t)(pSrcEnd - pSrc);
-		size_t destSize   = (size_t)(pDestEnd - pDest);
+		// Each byte other than a continuation byte begins a code point, of two elements if it's of four bytes.
+		size_t nLength = n, i = 0;
 
-		if(sourceSize > destSize)
-		   sourceSize = destSize;
+		for(; i + 8 <= n; i += 8)
+		{
+			const uint64_t x = Load8(p + i);
+			nLength += CountBytes(x & (x << 1) & (x << 2) & (x << 3)) - CountBytes(x & ~(x << 1));
+		}
 
-		memmove(pDest, (void*)pSrc, sourceSize * sizeof(*pSrcEnd));
+		for(; i < n; i++)
+			nLength += (size_t)((uint8_t)p[i] >= 0xf0) - (size_t)(((uint8_t)p[i] & 0xc0) == 0x80);
 
-		pSrc  += sourceSize;
-		pDest += sourceSize; // Intentionally add sourceSize here.
+		return nLength;
+	}
 
-		return true;
+
+	EASTL_API size_t utf16_length_from_utf32(const char32_t* p, size_t n)
+	{
+		size_t nLength = n;
+
+		for(size_t i = 0; i < n; i++)
+			nLength += (size_t)(p[i] >= 0x10000);
+
+		return nLength;
 	}
 
-	EASTL_API bool DecodePart(const char16_t*& pSrc, const char16_t* pSrcEnd, char32_t*& pDest, char32_t* pDestEnd)
+
+	EASTL_API size_t utf32_length_from_utf8(const char* p, size_t n)
 	{
-		size_t sourceSize = (size_t)(pSrcEnd - pSrc);
-		size_t destSize   = (size_t)(pDestEnd - pDest);
+		size_t nLength = n, i = 0;
 
-		if(sourceSize > destSize)
-		   pSrcEnd = pSrc + destSize;
+		for(; i + 8 <= n; i += 8)
+		{
+			const uint64_t x = Load8(p + i);
+			nLength -= CountBytes(x & ~(x << 1));
+		}
 
-		while(pSrc != pSrcEnd) // To consider: Improve this by unrolling this loop. Other tricks can improve its speed as well.
-			*pDest++ = (char32_t)*pSrc++;
+		for(; i < n; i++)
+			nLength -= (size_t)(((uint8_t)p[i] & 0xc0) == 0x80);
 
-		return true;
+		return nLength;
 	}
 
 
-	EASTL_API bool DecodePart(const char32_t*& pSrc, const char32_t* pSrcEnd, char*& pDest, char* pDestEnd)
+	EASTL_API size_t utf32_length_from_utf16(const char16_t* p, size_t n)
 	{
-		bool success = true;
+		size_t nLength = n;
+
+		for(size_t i = 0; i < n; i++) // Each low surrogate ends a pair.
+			nLength -= (size_t)(((uint32_t)p[i] - 0xdc00) < 0x400);
+
+		return nLength;
+	}
 
-		EASTL_ASSERT((pDest + 6) < pDestEnd); // The user must provide ample buffer space, preferably 256 chars or more.
-		pDestEnd -= 6; // Do this so that we can avoid dest buffer size checking in the loop below and the function it calls.
 
-		while(success && (pSrc < pSrcEnd) && (pDest < pDestEnd))
-			success = UCS4ToUTF8(*pSrc++, pDest);
 
-		return success;
+	///////////////////////////////////////////////////////////////////////////
+	// Conversions
+	///////////////////////////////////////////////////////////////////////////
+
+	namespace Internal
+	{
+		EASTL_API size_t utf_transcode(const char*     pSrc, size_t n, char16_t* pDest) { return TranscodeValid(pSrc, n, pDest); }
+		EASTL_API size_t utf_transcode(const char*     pSrc, size_t n, char32_t* pDest) { return TranscodeValid(pSrc, n, pDest); }
+		EASTL_API size_t utf_transcode(const char16_t* pSrc, size_t n, char*     pDest) { return TranscodeValid(pSrc, n, pDest); }
+		EASTL_API size_t utf_transcode(const char16_t* pSrc, size_t n, char32_t* pDest) { return TranscodeValid(pSrc, n, pDest); }
+		EASTL_API size_t utf_transcode(const char32_t* pSrc, size_t n, char*     pDest) { return TranscodeValid(pSrc, n, pDest); }
+		EASTL_API size_t utf_transcode(const char32_t* pSrc, size_t n, char16_t* pDest) { return TranscodeValid(pSrc, n, pDest); }
 	}
 
-	EASTL_API bool DecodePart(const char32_t*& pSrc, const char32_t* pSrcEnd, char16_t*& pDest, char16_t* pDestEnd)
+	EASTL_API size_t utf8_to_utf16(const char* pSrc, size_t n, char16_t* pDest)
 	{
-		size_t sourceSize = (size_t)(pSrcEnd - pSrc);
-		size_t destSize   = (size_t)(pDestEnd - pDest);
+		return utf8_validate(pSrc, n) ? TranscodeValid(pSrc, n, pDest) : 0;
+	}
 
-		if(sourceSize > destSize)
-		   pSrcEnd = pSrc + destSize;
+	EASTL_API size_t utf8_to_utf32(const char* pSrc, size_t n, char32_t* pDest)
+	{
+		return utf8_validate(pSrc, n) ? TranscodeValid(pSrc, n, pDest) : 0;
+	}
 
-		while(pSrc != pSrcEnd) // To consider: Improve this by unrolling this loop. Other tricks can improve its speed as well.
-			*pDest++ = (char16_t)*pSrc++;   // This is potentially losing data. We are not converting to UTF16; we are converting to UCS2.
+	EASTL_API size_t utf16_to_utf8(const char16_t* pSrc, size_t n, char* pDest)
+	{
+		return utf16_validate(pSrc, n) ? TranscodeValid(pSrc, n, pDest) : 0;
+	}
 
-		return true;
+	EASTL_API size_t utf16_to_utf32(const char16_t* pSrc, size_t n, char32_t* pDest)
+	{
+		return utf16_validate(pSrc, n) ? TranscodeValid(pSrc, n, pDest) : 0;
 	}
 
-	EASTL_API bool DecodePart(const char32_t*& pSrc, const char32_t* pSrcEnd, char32_t*& pDest, char32_t* pDestEnd)
+	EASTL_API size_t utf32_to_utf8(const char32_t* pSrc, size_t n, char* pDest)
+	{
+		return utf32_validate(pSrc, n) ? TranscodeValid(pSrc, n, pDest) : 0;
+	}
+
+	EASTL_API size_t utf32_to_utf16(const char32_t* pSrc, size_t n, char16_t* pDest)
+	{
+		return utf32_validate(pSrc, n) ? TranscodeValid(pSrc, n, pDest) : 0;
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////////
+	// DecodePart
+	///////////////////////////////////////////////////////////////////////////
+
+	EASTL_API bool DecodePart(const char*& pSrc, const char* pSrcEnd, char*& pDest, char* pDestEnd)
 	{
 		size_t sourceSize = (size_t)(pSrcEnd - pSrc);
 		size_t destSize   = (size_t)(pDestEnd - pDest);
@@ -404,48 +577,88 @@ namespace std
 		return true;
 	}
 
-	EASTL_API bool DecodePart(const int*& pSrc, const int* pSrcEnd, char*&  pDest, char* pDestEnd)
+	EASTL_API bool DecodePart(const char*& pSrc, const char* pSrcEnd, char16_t*& pDest, char16_t* pDestEnd)
 	{
-		bool success = true;
+		return TranscodePart(pSrc, pSrcEnd, pDest, pDestEnd);
+	}
 
-		EASTL_ASSERT((pDest + 6) < pDestEnd); // The user must provide ample buffer space, preferably 256 chars or more.
-		pDestEnd -= 6; // Do this so that we can avoid dest buffer size checking in the loop below and the function it calls.
+	EASTL_API bool DecodePart(const char*& pSrc, const char* pSrcEnd, char32_t*& pDest, char32_t* pDestEnd)
+	{
+		return TranscodePart(pSrc, pSrcEnd, pDest, pDestEnd);
+	}
 
-		while(success && (pSrc < pSrcEnd) && (pDest < pDestEnd))
-			success = UCS4ToUTF8((uint32_t)(unsigned)*pSrc++, pDest);
 
-		return success;
+	EASTL_API bool DecodePart(const char16_t*& pSrc, const char16_t* pSrcEnd, char*& pDest, char* pDestEnd)
+	{
+		return TranscodePart(pSrc, pSrcEnd, pDest, pDestEnd);
 	}
 
-	EASTL_API bool DecodePart(const int*& pSrc, const int* pSrcEnd, char16_t*& pDest, char16_t* pDestEnd)
+	EASTL_API bool DecodePart(const char16_t*& pSrc, const char16_t* pSrcEnd, char16_t*& pDest, char16_t* pDestEnd)
 	{
 		size_t sourceSize = (size_t)(pSrcEnd - pSrc);
 		size_t destSize   = (size_t)(pDestEnd - pDest);
 
 		if(sourceSize > destSize)
-		   pSrcEnd = pSrc + destSize;
+		   sourceSize = destSize;
 
-		while(pSrc != pSrcEnd) // To consider: Improve this by unrolling this loop. Other tricks can improve its speed as well.
-			*pDest++ = (char16_t)*pSrc++;   // This is potentially losing data. We are not converting to UTF16; we are converting to UCS2.
+		memmove(pDest, (void*)pSrc, sourceSize * sizeof(*pSrcEnd));
+
+		pSrc  += sourceSize;
+		pDest += sourceSize; // Intentionally add sourceSize here.
 
 		return true;
 	}
 
-	EASTL_API bool DecodePart(const int*& pSrc, const int* pSrcEnd, char32_t*& pDest, char32_t* pDestEnd)
+	EASTL_API bool DecodePart(const char16_t*& pSrc, const char16_t* pSrcEnd, char32_t*& pDest, char32_t* pDestEnd)
+	{
+		return TranscodePart(pSrc, pSrcEnd, pDest, pDestEnd);
+	}
+
+
+	EASTL_API bool DecodePart(const char32_t*& pSrc, const char32_t* pSrcEnd, char*& pDest, char* pDestEnd)
+	{
+		return TranscodePart(pSrc, pSrcEnd, pDest, pDestEnd);
+	}
+
+	EASTL_API bool DecodePart(const char32_t*& pSrc, const char32_t* pSrcEnd, char16_t*& pDest, char16_t* pDestEnd)
+	{
+		return TranscodePart(pSrc, pSrcEnd, pDest, pDestEnd);
+	}
+
+	EASTL_API bool DecodePart(const char32_t*& pSrc, const char32_t* pSrcEnd, char32_t*& pDest, char32_t* pDestEnd)
 	{
 		size_t sourceSize = (size_t)(pSrcEnd - pSrc);
 		size_t destSize   = (size_t)(pDestEnd - pDest);
 
 		if(sourceSize > destSize)
-		   pSrcEnd = pSrc + destSize;
+		   sourceSize = destSize;
+
+		memmove(pDest, (void*)pSrc, sourceSize * sizeof(*pSrcEnd));
 
-		while(pSrc != pSrcEnd) // To consider: Improve this by unrolling this loop. Other tricks can improve its speed as well.
-			*pDest++ = (char32_t)*pSrc++;   // This is potentially losing data. We are not converting to UTF16; we are converting to UCS2.
+		pSrc  += sourceSize;
+		pDest += sourceSize; // Intentionally add sourceSize here.
 
 		return true;
 	}
 
 
+	// int is UTF-32, as with char32_t.
+	EASTL_API bool DecodePart(const int*& pSrc, const int* pSrcEnd, char*&  pDest, char* pDestEnd)
+	{
+		return DecodePart(reinterpret_cast<const char32_t*&>(pSrc), reinterpret_cast<const char32_t*>(pSrcEnd), pDest, pDestEnd);
+	}
+
+	EASTL_API bool DecodePart(const int*& pSrc, const int* pSrcEnd, char16_t*& pDest, char16_t* pDestEnd)
+	{
+		return DecodePart(reinterpret_cast<const char32_t*&>(pSrc), reinterpret_cast<const char32_t*>(pSrcEnd), pDest, pDestEnd);
+	}
+
+	EASTL_API bool DecodePart(const int*& pSrc, const int* pSrcEnd, char32_t*& pDest, char32_t* pDestEnd)
+	{
+		return DecodePart(reinterpret_cast<const char32_t*&>(pSrc), reinterpret_cast<const char32_t*>(pSrcEnd), pDest, pDestEnd);
+	}
+
+
 
 } // namespace std
 
@@ -462,3 +675,5 @@ namespace std
 
 
 
+
+
@@ -0,0 +1,442 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/thread_pool.h>
+#include <EASTL/allocator.h>
+#include <new>
+
+#if EASTL_THREAD_POOL_AVAILABLE
+	#if defined(EA_PLATFORM_MICROSOFT)
+		EA_DISABLE_ALL_VC_WARNINGS();
+		#ifndef WIN32_LEAN_AND_MEAN
+			#define WIN32_LEAN_AND_MEAN
+		#endif
+		#include <Windows.h>
+		EA_RESTORE_ALL_VC_WARNINGS();
+	#else
+		#include <pthread.h>
+		#include <sched.h>
+		#include <unistd.h>
+	#endif
+#endif
+
+
+namespace std
+{
+	/// EASTL_THREAD_POOL_DEFAULT_NAME
+	///
+	/// Defines a default allocator name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_THREAD_POOL_DEFAULT_NAME
+		#define EASTL_THREAD_POOL_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " thread_pool" // Unless the user overrides something, this is "EASTL thread_pool".
+	#endif
+
+
+	namespace Internal
+	{
+		/// thread_pool_context
+		///
+		/// The state of one thread participating in a pool: a worker, or whichever
+		/// outside thread currently holds the caller slot.
+		///
+		struct thread_pool_context
+		{
+			thread_pool_deque mDeque;
+			thread_pool*      mpPool;
+			size_t            mnIndex;
+			uint32_t          mnRandom; // State of the generator which picks steal victims.
+
+			static void RunWorker(thread_pool_context* pContext)
+				{ pContext->mpPool->WorkerLoop(pContext); }
+		};
+
+
+		#if EASTL_THREAD_POOL_AVAILABLE
+			// The context of the pool the current thread is working for, if any.
+			static thread_local thread_pool_context* sCurrentContext = NULL;
+		#endif
+
+
+		#if EASTL_THREAD_POOL_AVAILABLE && defined(EA_PLATFORM_MICROSOFT)
+			struct thread_pool_platform_data
+			{
+				CRITICAL_SECTION   mSleepLock;
+				CONDITION_VARIABLE mSleepCondition;
+				CRITICAL_SECTION   mCallerLock;    // Held by the outside thread using the caller slot.
+				HANDLE*            mpThreads;
+
+				void Lock()            { EnterCriticalSection(&mSleepLock); }
+				void Unlock()          { LeaveCriticalSection(&mSleepLock); }
+				void Sleep()           { SleepConditionVariableCS(&mSleepCondition, &mSleepLock, INFINITE); }
+				void WakeOne()         { WakeConditionVariable(&mSleepCondition); }
+				void WakeAll()         { WakeAllConditionVariable(&mSleepCondition); }
+				void LockCaller()      { EnterCriticalSection(&mCallerLock); }
+				void UnlockCaller()    { LeaveCriticalSection(&mCallerLock); }
+				static void Yield()    { SwitchToThread(); }
+			};
+
+			static DWORD WINAPI ThreadPoolThreadFunction(LPVOID pContext)
+			{
+				thread_pool_context::RunWorker(static_cast<thread_pool_context*>(pContext));
+				return 0;
+			}
+		#elif EASTL_THREAD_POOL_AVAILABLE
+			struct thread_pool_platform_data
+			{
+				pthread_mutex_t mSleepMutex;
+				pthread_cond_t  mSleepCondition;
+				pthread_mutex_t mCallerMutex;      // Held by the outside thread using the caller slot.
+				pthread_t*      mpThreads;
+
+				void Lock()            { pthread_mutex_lock(&mSleepMutex); }
+				void Unlock()          { pthread_mutex_unlock(&mSleepMutex); }
+				void Sleep()           { pthread_cond_wait(&mSleepCondition, &mSleepMutex); }
+				void WakeOne()         { pthread_cond_signal(&mSleepCondition); }
+				void WakeAll()         { pthread_cond_broadcast(&mSleepCondition); }
+				void LockCaller()      { pthread_mutex_lock(&mCallerMutex); }
+				void UnlockCaller()    { pthread_mutex_unlock(&mCallerMutex); }
+				static void Yield()    { sched_yield(); }
+			};
+
+			static void* ThreadPoolThreadFunction(void* pContext)
+			{
+				thread_pool_context::RunWorker(static_cast<thread_pool_context*>(pContext));
+				return NULL;
+			}
+		#endif
+
+	} // namespace Internal
+
+
+
+	#if EASTL_THREAD_POOL_AVAILABLE
+		// The number of times an idle worker looks for work before it goes to sleep,
+		// and the number of times a waiting thread pauses before yielding its time slice.
+		static const int kThreadPoolSpinCount = 256;
+
+		static inline Internal::thread_pool_platform_data* GetPlatformData(void* p)
+		{
+			return static_cast<Internal::thread_pool_platform_data*>(p);
+		}
+	#endif
+
+
+	thread_pool::thread_pool(int nWorkerCount)
+		: mnWorkerCount(0)
+		, mnContextCount(0)
+		, mpContexts(NULL)
+		, mpPlatformData(NULL)
+		, mnWorkEpoch(0)
+		, mnSleepingCount(0)
+		, mbShutdown(false)
+	{
+		if(nWorkerCount < 0)
+			nWorkerCount = (int)hardware_concurrency() - 1;
+
+		#if EASTL_THREAD_POOL_AVAILABLE
+			EASTLAllocatorType allocator(EASTL_THREAD_POOL_DEFAULT_NAME);
+
+			const size_t nContextCount = (size_t)nWorkerCount + 1;
+			void* const pContextMemory = EASTLAllocAligned(allocator, nContextCount * sizeof(Internal::thread_pool_context), EA_CACHE_LINE_SIZE, 0);
+			mpContexts = static_cast<Internal::thread_pool_context*>(pContextMemory);
+
+			for(size_t i = 0; i < nContextCount; i++)
+			{
+				Internal::thread_pool_context* const pContext = ::new(&mpContexts[i]) Internal::thread_pool_context;
+				pContext->mpPool   = this;
+				pContext->mnIndex  = i;
+				pContext->mnRandom = (uint32_t)(i * 2654435761u) | 1;
+			}
+
+			mnContextCount = nContextCount;
+
+			void* const pDataMemory = EASTLAlloc(allocator, sizeof(Internal::thread_pool_platform_data));
+			Internal::thread_pool_platform_data* const pData = ::new(pDataMemory) Internal::thread_pool_platform_data;
+			mpPlatformData = pData;
+
+			#if defined(EA_PLATFORM_MICROSOFT)
+				InitializeCriticalSection(&pData->mSleepLock);
+				InitializeCriticalSection(&pData->mCallerLock);
+				InitializeConditionVariable(&pData->mSleepCondition);
+				void* const pThreadMemory = EASTLAlloc(allocator, (nContextCount * sizeof(HANDLE)));
+				pData->mpThreads = static_cast<HANDLE*>(pThreadMemory);
+			#else
+				pthread_mutex_init(&pData->mSleepMutex, NULL);
+				pthread_mutex_init(&pData->mCallerMutex, NULL);
+				pthread_cond_init(&pData->mSleepCondition, NULL);
+				void* const pThreadMemory = EASTLAlloc(allocator, (nContextCount * sizeof(pthread_t)));
+				pData->mpThreads = static_cast<pthread_t*>(pThreadMemory);
+			#endif
+
+			// Workers are counted as they start, so that if thread creation fails we end up with a smaller pool.
+			for(int i = 0; i < nWorkerCount; i++)
+			{
+				Internal::thread_pool_context* const pContext = &mpContexts[mnWorkerCount + 1];
+
+				#if defined(EA_PLATFORM_MICROSOFT)
+					HANDLE hThread = CreateThread(NULL, 0, Internal::ThreadPoolThreadFunction, pContext, 0, NULL);
+					if(!hThread)
+						break;
+					pData->mpThreads[mnWorkerCount] = hThread;
+				#else
+					if(pthread_create(&pData->mpThreads[mnWorkerCount], NULL, Internal::ThreadPoolThreadFunction, pContext) != 0)
+						break;
+				#endif
+
+				mnWorkerCount++;
+			}
+		#endif
+	}
+
+
+	thread_pool::~thread_pool()
+	{
+		#if EASTL_THREAD_POOL_AVAILABLE
+			Internal::thread_pool_platform_data* const pData = GetPlatformData(mpPlatformData);
+
+			pData->Lock();
+			mbShutdown.store(true, memory_order_seq_cst);
+			pData->WakeAll();
+			pData->Unlock();
+
+			for(size_t i = 0; i < mnWorkerCount; i++)
+			{
+				#if defined(EA_PLATFORM_MICROSOFT)
+					WaitForSingleObject(pData->mpThreads[i], INFINITE);
+					CloseHandle(pData->mpThreads[i]);
+				#else
+					pthread_join(pData->mpThreads[i], NULL);
+				#endif
+			}
+
+			EASTLAllocatorType allocator(EASTL_THREAD_POOL_DEFAULT_NAME);
+			const size_t nContextCount = mnContextCount;
+
+			#if defined(EA_PLATFORM_MICROSOFT)
+				DeleteCriticalSection(&pData->mSleepLock);
+				DeleteCriticalSection(&pData->mCallerLock);
+				EASTLFree(allocator, pData->mpThreads, (nContextCount * sizeof(HANDLE)));
+			#else
+				pthread_cond_destroy(&pData->mSleepCondition);
+				pthread_mutex_destroy(&pData->mCallerMutex);
+				pthread_mutex_destroy(&pData->mSleepMutex);
+				EASTLFree(allocator, pData->mpThreads, (nContextCount * sizeof(pthread_t)));
+			#endif
+
+			pData->~thread_pool_platform_data();
+			EASTLFree(allocator, pData, sizeof(Internal::thread_pool_platform_data));
+
+			for(size_t i = 0; i < nContextCount; i++)
+				mpContexts[i].~thread_pool_context();
+			EASTLFree(allocator, mpContexts, nContextCount * sizeof(Internal::thread_pool_context));
+		#endif
+	}
+
+
+	size_t thread_pool::hardware_concurrency()
+	{
+		#if EASTL_THREAD_POOL_AVAILABLE && defined(EA_PLATFORM_MICROSOFT)
+			SYSTEM_INFO systemInfo;
+			GetSystemInfo(&systemInfo);
+			return (systemInfo.dwNumberOfProcessors > 0) ? (size_t)systemInfo.dwNumberOfProcessors : 1;
+		#elif EASTL_THREAD_POOL_AVAILABLE
+			const long nCount = sysconf(_SC_NPROCESSORS_ONLN);
+			return (nCount > 0) ? (size_t)nCount : 1;
+		#else
+			return 1;
+		#endif
+	}
+
+
+	thread_pool& thread_pool::get_default()
+	{
+		#if defined(EASTL_THREAD_POOL_DEFAULT_WORKER_COUNT)
+			static thread_pool sDefaultPool(EASTL_THREAD_POOL_DEFAULT_WORKER_COUNT);
+		#else
+			static thread_pool sDefaultPool(-1);
+		#endif
+
+		return sDefaultPool;
+	}
+
+
+	Internal::thread_pool_context* thread_pool::Enter(Internal::thread_pool_context*& pPrevious)
+	{
+		#if EASTL_THREAD_POOL_AVAILABLE
+			pPrevious = Internal::sCurrentContext;
+
+			// A nested call from a thread which already works for this pool uses its own context.
+			if(pPrevious && (pPrevious->mpPool == this))
+				return pPrevious;
+
+			GetPlatformData(mpPlatformData)->LockCaller();
+			Internal::sCurrentContext = &mpContexts[0];
+			return &mpContexts[0];
+		#else
+			pPrevious = NULL;
+			return NULL;
+		#endif
+	}
+
+
+	void thread_pool::Leave(Internal::thread_pool_context* pContext, Internal::thread_pool_context* pPrevious)
+	{
+		#if EASTL_THREAD_POOL_AVAILABLE
+			if(pContext != pPrevious)
+			{
+				Internal::sCurrentContext = pPrevious;
+				GetPlatformData(mpPlatformData)->UnlockCaller();
+			}
+		#else
+			EA_UNUSED(pContext); EA_UNUSED(pPrevious);
+		#endif
+	}
+
+
+	void thread_pool::Spawn(Internal::thread_pool_context* pContext, Internal::thread_pool_task* pTask)
+	{
+		#if EASTL_THREAD_POOL_AVAILABLE
+			if(!pContext->mDeque.push(pTask))
+			{
+				Execute(pTask, pContext); // The deque is full, so we do the work ourselves.
+				return;
+			}
+
+			// See WorkerLoop for why this can't miss a worker which is about to go to sleep.
+			mnWorkEpoch.fetch_add(1, memory_order_seq_cst);
+
+			if(mnSleepingCount.load(memory_order_seq_cst) > 0)
+			{
+				Internal::thread_pool_platform_data* const pData = GetPlatformData(mpPlatformData);
+				pData->Lock();
+				pData->WakeOne();
+				pData->Unlock();
+			}
+		#else
+			Execute(pTask, pContext);
+		#endif
+	}
+
+
+	void thread_pool::Wait(Internal::thread_pool_context* pContext, atomic<int32_t>& nPending)
+	{
+		#if EASTL_THREAD_POOL_AVAILABLE
+			// Rather than block, we run queued tasks until our own have finished. These are
+			// usually our own tasks (popped from our deque) or pieces of the ones that were
+			// stolen from us, which keeps this thread busy and the join cheap.
+			int nSpinCount = 0;
+
+			while(nPending.load(memory_order_acquire) != 0)
+			{
+				Internal::thread_pool_task* const pTask = FindWork(pContext);
+
+				if(pTask)
+				{
+					Execute(pTask, pContext);
+					nSpinCount = 0;
+				}
+				else if(++nSpinCount < kThreadPoolSpinCount)
+					EASTL_ATOMIC_CPU_PAUSE();
+				else
+					Internal::thread_pool_platform_data::Yield();
+			}
+		#else
+			EA_UNUSED(pContext);
+			EA_UNUSED(nPending);
+		#endif
+	}
+
+
+	Internal::thread_pool_task* thread_pool::FindWork(Internal::thread_pool_context* pContext)
+	{
+		#if EASTL_THREAD_POOL_AVAILABLE
+			Internal::thread_pool_task* pTask = pContext->mDeque.pop();
+
+			if(!pTask)
+			{
+				// We start at a random victim so that thieves spread out over the pool. Workers start
+				// while the constructor is still counting them, so we go by mnContextCount, which is
+				// set before the first starts. The contexts of threads which failed to start stay empty.
+				const size_t nContextCount = mnContextCount;
+
+				pContext->mnRandom ^= pContext->mnRandom << 13;
+				pContext->mnRandom ^= pContext->mnRandom >> 17;
+				pContext->mnRandom ^= pContext->mnRandom << 5;
+
+				for(size_t i = 0, j = pContext->mnRandom % nContextCount; i < nContextCount; i++, j = ((j + 1) % nContextCount))
+				{
+					if((j != pContext->mnIndex) && !mpContexts[j].mDeque.empty())
+					{
+						pTask = mpContexts[j].mDeque.steal();
+						if(pTask)
+							break;
+					}
+				}
+			}
+
+			return pTask;
+		#else
+			EA_UNUSED(pContext);
+			return NULL;
+		#endif
+	}
+
+
+	void thread_pool::WorkerLoop(Internal::thread_pool_context* pContext)
+	{
+		#if EASTL_THREAD_POOL_AVAILABLE
+			Internal::thread_pool_platform_data* const pData = GetPlatformData(mpPlatformData);
+			int nSpinCount = 0;
+
+			Internal::sCurrentContext = pContext;
+
+			while(!mbShutdown.load(memory_order_relaxed))
+			{
+				Internal::thread_pool_task* pTask = FindWork(pContext);
+
+				if(pTask)
+				{
+					Execute(pTask, pContext);
+					nSpinCount = 0;
+				}
+				else if(++nSpinCount < kThreadPoolSpinCount)
+					EASTL_ATOMIC_CPU_PAUSE();
+				else
+				{
+					// We read the epoch before looking for work a last time. Spawn pushes its task
+					// before incrementing the epoch and then checks for sleepers, while we register
+					// as a sleeper before checking the epoch. So either we see the new epoch (or
+					// the task), or Spawn sees us sleeping and wakes us.
+					const uint32_t nEpoch = mnWorkEpoch.load(memory_order_seq_cst);
+
+					pTask = FindWork(pContext);
+
+					if(pTask)
+						Execute(pTask, pContext);
+					else
+					{
+						pData->Lock();
+						mnSleepingCount.fetch_add(1, memory_order_seq_cst);
+
+						while((mnWorkEpoch.load(memory_order_seq_cst) == nEpoch) && !mbShutdown.load(memory_order_seq_cst))
+							pData->Sleep();
+
+						mnSleepingCount.fetch_sub(1, memory_order_seq_cst);
+						pData->Unlock();
+					}
+
+					nSpinCount = 0;
+				}
+			}
+
+			Internal::sCurrentContext = NULL;
+		#else
+			EA_UNUSED(pContext);
+		#endif
+	}
+
+
+} // namespace std
@@ -7,6 +7,7 @@
 #include <EASTL/internal/thread_support.h>
 #include <EASTL/type_traits.h>
 #include <EASTL/memory.h>
+#include <EASTL/mutex.h>
 
 #if defined(EA_PLATFORM_MICROSOFT)
 	EA_DISABLE_ALL_VC_WARNINGS();
@@ -15,6 +16,8 @@
 	#endif
 	#include <Windows.h>
 	EA_RESTORE_ALL_VC_WARNINGS();
+#elif defined(EA_PLATFORM_POSIX)
+	#include <sched.h>
 #endif
 
 
@@ -87,17 +90,43 @@ namespace std
 		#endif
 
 
+		/////////////////////////////////////////////////////////////////
+		// thread_yield
+		/////////////////////////////////////////////////////////////////
+
+		void thread_yield()
+		{
+			#if defined(EA_PLATFORM_MICROSOFT)
+				SwitchToThread();
+			#elif defined(EA_PLATFORM_POSIX)
+				sched_yield();
+			#endif
+		}
+
+
 		/////////////////////////////////////////////////////////////////
 		// shared_ptr_auto_mutex
 		/////////////////////////////////////////////////////////////////
 
 		// We could solve this by having single global mutex for all shared_ptrs, a set of mutexes for shared_ptrs, 
 		// a single mutex for every shared_ptr, or have a template parameter that enables mutexes for just some shared_ptrs.
-		std::late_constructed<mutex, true> gSharedPtrMutex;
+		// We use a set of mutexes selected by the shared_ptr address, so that unrelated shared_ptrs rarely contend.
+		// The lock-free alternative is atomic<shared_ptr<T>>, which doesn't use these.
+		// The critical sections only swap or copy a shared_ptr and never nest, so they use std::mutex, which
+		// needs no construction and costs one compare-and-swap when uncontended, rather than the recursive mutex.
+		const size_t kSharedPtrMutexCount = 31; // A prime, so that the stride of shared_ptrs in arrays and structs doesn't map them to few mutexes.
+
+		std::mutex gSharedPtrMutex[kSharedPtrMutexCount];
+
+		shared_ptr_auto_mutex::shared_ptr_auto_mutex(const void* pSharedPtr)
+			: mpMutex(&gSharedPtrMutex[((uintptr_t)pSharedPtr / sizeof(void*)) % kSharedPtrMutexCount])
+		{
+			mpMutex->lock();
+		}
 
-		shared_ptr_auto_mutex::shared_ptr_auto_mutex(const void* /*pSharedPtr*/)
-			: auto_mutex(*gSharedPtrMutex.get())
+		shared_ptr_auto_mutex::~shared_ptr_auto_mutex()
 		{
+			mpMutex->unlock();
 		}
 
 
@@ -36,6 +36,7 @@
 #endif
 
 
+#include <EASTL/thread_pool.h>
 #include "EASTLTestAllocator.h"
 #include "EASTLTest.h"  // Include this last, as it enables compiler warnings.
 
@@ -217,6 +218,17 @@ const char* GetStdSTLName()
 
 
 
+
+///////////////////////////////////////////////////////////////////////////////
+// CanRunBlockingTasks
+//
+bool CanRunBlockingTasks(const std::thread_pool& pool, size_t nTaskCount)
+{
+	return pool.concurrency() >= nTaskCount;
+}
+
+
+
 ///////////////////////////////////////////////////////////////////////////////
 // MallocAllocator
 ///////////////////////////////////////////////////////////////////////////////
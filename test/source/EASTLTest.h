@@ -30,6 +30,8 @@ int TestBitVector();
 int TestBitset();
 int TestCharTraits();
 int TestChrono();
+int TestConcurrentIntrusive();
+int TestConcurrentLruCache();
 int TestCppCXTypeTraits();
 int TestDeque();
 int TestExtra();
@@ -57,10 +59,13 @@ int TestLruCache();
 int TestMap();
 int TestMemory();
 int TestMeta();
+int TestMpmcQueue();
+int TestMutex();
 int TestNumericLimits();
 int TestOptional();
 int TestRandom();
 int TestRatio();
+int TestReclamation();
 int TestRingBuffer();
 int TestSList();
 int TestSegmentedVector();
@@ -68,10 +73,13 @@ int TestSet();
 int TestSmartPtr();
 int TestSort();
 int TestSpan();
+int TestSpscQueue();
 int TestString();
 int TestStringHashMap();
 int TestStringMap();
 int TestStringView();
+int TestSynchronization();
+int TestThreadPool();
 int TestTuple();
 int TestTupleVector();
 int TestTypeTraits();
@@ -227,6 +235,19 @@ StdSTLType GetStdSTLType();
 const char* GetStdSTLName();
 
 
+
+/// CanRunBlockingTasks
+///
+/// Returns whether pool can run nTaskCount tasks at once, counting the calling
+/// thread. Tests whose tasks block on one another check this first, as with too
+/// few threads the pool runs some tasks after others which wait on them. This is
+/// the case when the build has no thread support and the pool has no workers.
+///
+namespace std { class thread_pool; }
+
+bool CanRunBlockingTasks(const std::thread_pool& pool, size_t nTaskCount = 2);
+
+
 /// gEASTLTest_AllocationCount
 ///
 extern int gEASTLTest_AllocationCount; 
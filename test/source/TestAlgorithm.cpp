@@ -20,6 +20,7 @@
 #include <EASTL/string.h>
 #include <EASTL/set.h>
 #include <EASTL/sort>
+#include <EASTL/searcher.h>
 #include "ConceptImpls.h"
 #include <EAStdC/EAMemory.h>
 #include "EASTLTest.h"  // Put this after the above so that it doesn't block any warnings from the includes above.
@@ -688,6 +689,207 @@ static int TestClamp()
 }
 
 
+///////////////////////////////////////////////////////////////////////////////
+// TestSimdAlgorithms
+//
+// Compares the algorithms for pointers to arithmetic types, which use the SIMD
+// kernels if enabled, with those for deque iterators, which don't.
+//
+template <typename T>
+static int TestSimdAlgorithmsFor(EA::UnitTest::Rand& rng, uint32_t nRange, bool bFloat)
+{
+	using namespace std;
+
+	int nErrorCount = 0;
+
+	for(int nTrial = 0; nTrial < 400; nTrial++)
+	{
+		const eastl_size_t n = rng.RandLimit(160);
+
+		vector<T> v(n);
+		for(eastl_size_t i = 0; i < n; i++)
+			v[i] = (T)((int64_t)rng.RandLimit(nRange) - (int64_t)(nRange / 2)); // Negative values of unsigned types test their top bits.
+		if(bFloat && n && rng.RandLimit(2))
+			v[rng.RandLimit((uint32_t)n)] = (T)-0.0;
+		if(bFloat && n && rng.RandLimit(2))
+			v[rng.RandLimit((uint32_t)n)] = numeric_limits<T>::quiet_NaN();
+
+		deque<T> d(v.begin(), v.end());
+		T* const pBegin = v.data();
+		T* const pEnd   = v.data() + n;
+		const T  value  = (T)((int64_t)rng.RandLimit(nRange) - (int64_t)(nRange / 2));
+
+		EATEST_VERIFY((find(pBegin, pEnd, value) - pBegin) == distance(d.begin(), find(d.begin(), d.end(), value)));
+		EATEST_VERIFY(count(pBegin, pEnd, value) == count(d.begin(), d.end(), value));
+		EATEST_VERIFY((min_element(pBegin, pEnd) - pBegin) == distance(d.begin(), min_element(d.begin(), d.end())));
+		EATEST_VERIFY((max_element(pBegin, pEnd) - pBegin) == distance(d.begin(), max_element(d.begin(), d.end())));
+
+		const pair<T*, T*> minMax = minmax_element(pBegin, pEnd);
+		const pair<typename deque<T>::iterator, typename deque<T>::iterator> minMaxD = minmax_element(d.begin(), d.end());
+		EATEST_VERIFY((minMax.first  - pBegin) == distance(d.begin(), minMaxD.first));
+		EATEST_VERIFY((minMax.second - pBegin) == distance(d.begin(), minMaxD.second));
+
+		vector<T> w(v);
+		if(n && rng.RandLimit(4))
+			w[rng.RandLimit((uint32_t)n)] = value;
+		deque<T> dw(w.begin(), w.end());
+		EATEST_VERIFY((mismatch(pBegin, pEnd, w.data()).first - pBegin) == distance(d.begin(), mismatch(d.begin(), d.end(), dw.begin()).first));
+		EATEST_VERIFY(equal(pBegin, pEnd, w.data()) == equal(d.begin(), d.end(), dw.begin()));
+
+		const T newValue = (T)rng.RandLimit(nRange);
+		replace(pBegin, pEnd, value, newValue);
+		replace(d.begin(), d.end(), value, newValue);
+		for(eastl_size_t i = 0; i < n; i++)
+			EATEST_VERIFY(memcmp(&v[i], &d[i], sizeof(T)) == 0);
+	}
+
+	return nErrorCount;
+}
+
+
+static int TestSimdAlgorithms()
+{
+	int nErrorCount = 0;
+
+	EA::UnitTest::Rand rng(EA::UnitTest::GetRandSeed());
+
+	for(int nPass = 0; nPass < 2; nPass++)
+	{
+		#if EASTL_SIMD_ENABLED
+			const int nSavedFeatures = std::Internal::simd_set_features(nPass ? 0 : ~0); // The widest vectors, then SSE2.
+		#endif
+
+		nErrorCount += TestSimdAlgorithmsFor<char>    (rng, 20, false);
+		nErrorCount += TestSimdAlgorithmsFor<int8_t>  (rng, 20, false);
+		nErrorCount += TestSimdAlgorithmsFor<uint8_t> (rng, 256, false);
+		nErrorCount += TestSimdAlgorithmsFor<int16_t> (rng, 50, false);
+		nErrorCount += TestSimdAlgorithmsFor<uint16_t>(rng, 50, false);
+		nErrorCount += TestSimdAlgorithmsFor<int32_t> (rng, 100, false);
+		nErrorCount += TestSimdAlgorithmsFor<uint32_t>(rng, 100, false);
+		nErrorCount += TestSimdAlgorithmsFor<int64_t> (rng, 100, false);
+		nErrorCount += TestSimdAlgorithmsFor<uint64_t>(rng, 100, false);
+		nErrorCount += TestSimdAlgorithmsFor<float>   (rng, 20, true);
+		nErrorCount += TestSimdAlgorithmsFor<double>  (rng, 20, true);
+
+		#if EASTL_SIMD_ENABLED
+			std::Internal::simd_set_features(nSavedFeatures);
+		#endif
+	}
+
+	return nErrorCount;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// TestSearchers
+//
+// Compares each searcher with search, for ranges and patterns of a few distinct
+// values, which match often and at overlapping positions.
+//
+template <typename Container>
+static int TestSearchersFor(EA::UnitTest::Rand& rng, uint32_t nAlphabetSize)
+{
+	using namespace std;
+
+	typedef typename Container::value_type     value_type;
+	typedef typename Container::const_iterator const_iterator;
+	typedef pair<const_iterator, const_iterator> range_type;
+
+	int nErrorCount = 0;
+
+	for(int nTrial = 0; nTrial < 1000; nTrial++)
+	{
+		const eastl_size_t n = rng.RandLimit(200);
+		const eastl_size_t m = rng.RandLimit(12);
+
+		Container text, pattern;
+		for(eastl_size_t i = 0; i < n; i++)
+			text.push_back((value_type)('a' + rng.RandLimit(nAlphabetSize)));
+
+		if((m <= n) && rng.RandLimit(2)) // Half the patterns are taken from the text, so that they are found.
+		{
+			const_iterator it = text.begin() + (typename Container::difference_type)rng.RandLimit((uint32_t)(n - m + 1));
+			pattern.insert(pattern.end(), it, it + (typename Container::difference_type)m);
+		}
+		else
+		{
+			for(eastl_size_t i = 0; i < m; i++)
+				pattern.push_back((value_type)('a' + rng.RandLimit(nAlphabetSize)));
+		}
+
+		const Container& textC    = text;
+		const Container& patternC = pattern;
+
+		const const_iterator itExpected = search(textC.begin(), textC.end(), patternC.begin(), patternC.end());
+		const range_type     expected(itExpected, (itExpected == textC.end()) ? textC.end() : itExpected + (typename Container::difference_type)m);
+
+		const default_searcher<const_iterator>              defaultSearcher(patternC.begin(), patternC.end());
+		const boyer_moore_searcher<const_iterator>          boyerMooreSearcher(patternC.begin(), patternC.end());
+		const boyer_moore_horspool_searcher<const_iterator> horspoolSearcher(patternC.begin(), patternC.end());
+		const two_way_searcher<const_iterator>              twoWaySearcher(patternC.begin(), patternC.end());
+
+		EATEST_VERIFY(defaultSearcher   (textC.begin(), textC.end()) == expected);
+		EATEST_VERIFY(boyerMooreSearcher(textC.begin(), textC.end()) == expected);
+		EATEST_VERIFY(horspoolSearcher  (textC.begin(), textC.end()) == expected);
+		EATEST_VERIFY(twoWaySearcher    (textC.begin(), textC.end()) == expected);
+		EATEST_VERIFY(search(textC.begin(), textC.end(), boyerMooreSearcher) == itExpected);
+	}
+
+	return nErrorCount;
+}
+
+
+struct SearcherNoCaseHash
+{
+	size_t operator()(char c) const { return (size_t)(uint8_t)std::CharToLower(c); }
+};
+
+struct SearcherNoCaseEqual
+{
+	bool operator()(char a, char b) const { return std::CharToLower(a) == std::CharToLower(b); }
+};
+
+struct SearcherNoCaseLess
+{
+	bool operator()(char a, char b) const { return std::CharToLower(a) < std::CharToLower(b); }
+};
+
+
+static int TestSearchers()
+{
+	using namespace std;
+
+	int nErrorCount = 0;
+
+	EA::UnitTest::Rand rng(EA::UnitTest::GetRandSeed());
+
+	nErrorCount += TestSearchersFor<string>     (rng, 2);
+	nErrorCount += TestSearchersFor<string>     (rng, 4);
+	nErrorCount += TestSearchersFor<vector<int>>(rng, 3);  // The Boyer-Moore searchers use a hash_map for int.
+	nErrorCount += TestSearchersFor<deque<char>>(rng, 2);
+
+	{
+		// Searchers with a predicate which ignores case.
+		const char* const pText    = "The quick brown fox jumps over the lazy dog, then the LAZY DOG jumps.";
+		const char* const pTextEnd = pText + strlen(pText);
+		const char* const pPattern = "lAzY dOg J";
+
+		const boyer_moore_searcher<const char*, SearcherNoCaseHash, SearcherNoCaseEqual>          boyerMooreSearcher(pPattern, pPattern + 10);
+		const boyer_moore_horspool_searcher<const char*, SearcherNoCaseHash, SearcherNoCaseEqual> horspoolSearcher(pPattern, pPattern + 10);
+		const two_way_searcher<const char*, SearcherNoCaseLess>                                   twoWaySearcher(pPattern, pPattern + 10);
+
+		EATEST_VERIFY(search(pText, pTextEnd, boyerMooreSearcher) == (pText + 54));
+		EATEST_VERIFY(search(pText, pTextEnd, horspoolSearcher)   == (pText + 54));
+		EATEST_VERIFY(search(pText, pTextEnd, twoWaySearcher)     == (pText + 54));
+
+		EATEST_VERIFY(search(pText, pText + 60, boyerMooreSearcher) == (pText + 60));
+		EATEST_VERIFY(twoWaySearcher(pText, pText + 60) == make_pair(pText + 60, pText + 60));
+	}
+
+	return nErrorCount;
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////
 // TestAlgorithm
 //
@@ -703,6 +905,8 @@ int TestAlgorithm()
 
 	nErrorCount += TestMinMax();
 	nErrorCount += TestClamp();
+	nErrorCount += TestSimdAlgorithms();
+	nErrorCount += TestSearchers();
 
 
 	// bool all_of (InputIterator first, InputIterator last, Predicate p);
@@ -6,11 +6,16 @@
 #include "EASTLTest.h"
 #include <EASTL/allocator.h>
 #include <EASTL/allocator_malloc.h>
+#include <EASTL/allocator_mmap.h>
+#include <EASTL/concurrent_fixed_pool.h>
 #include <EASTL/fixed_allocator.h>
 #include <EASTL/core_allocator_adapter.h>
 #include <EASTL/list.h>
+#include <EASTL/sort.h>
+#include <EASTL/vector.h>
 #include <EAStdC/EAString.h>
 #include <EAStdC/EAAlignment.h>
+#include <eathread/eathread_thread.h>
 
 
 
@@ -291,6 +296,302 @@ struct TestClass
 		{ return mX * x; }
 };
 
+///////////////////////////////////////////////////////////////////////////////
+// TestAllocatorMmap
+//
+struct CountingMmapAllocator : public std::mmap_allocator
+{
+	static int snReallocateCount;
+
+	CountingMmapAllocator(const char* pName = EASTL_NAME_VAL("CountingMmapAllocator"))
+		: std::mmap_allocator(pName) {}
+
+	void* reallocate(void* p, size_t oldSize, size_t newSize, int flags = 0)
+	{
+		snReallocateCount++;
+		return std::mmap_allocator::reallocate(p, oldSize, newSize, flags);
+	}
+};
+
+int CountingMmapAllocator::snReallocateCount = 0;
+
+struct EA_ALIGN(64) MmapAligned64
+{
+	uint64_t mnValue;
+};
+
+static int TestAllocatorMmap()
+{
+	int nErrorCount = 0;
+
+	static_assert(std::allocator_has_reallocate<std::mmap_allocator>::value, "mmap_allocator should provide reallocate");
+	static_assert(!std::allocator_has_reallocate<std::allocator_malloc>::value, "allocator_malloc doesn't provide reallocate");
+
+	{
+		// Blocks below and above the mapping threshold, and reallocation across it in both directions.
+		std::mmap_allocator a;
+		const size_t kSmall = 64;
+		const size_t kLarge = EASTL_MMAP_ALLOCATOR_THRESHOLD * 2;
+
+		uint8_t* p = (uint8_t*)a.allocate(kSmall);
+		EATEST_VERIFY(p != NULL);
+		for(size_t i = 0; i < kSmall; i++)
+			p[i] = (uint8_t)i;
+
+		p = (uint8_t*)a.reallocate(p, kSmall, kLarge);
+		EATEST_VERIFY(p != NULL);
+		for(size_t i = 0; i < kSmall; i++)
+			EATEST_VERIFY(p[i] == (uint8_t)i);
+		p[kLarge - 1] = 0xff;
+
+		p = (uint8_t*)a.reallocate(p, kLarge, kLarge * 4);
+		EATEST_VERIFY(p != NULL);
+		EATEST_VERIFY(p[kLarge - 1] == 0xff);
+		for(size_t i = 0; i < kSmall; i++)
+			EATEST_VERIFY(p[i] == (uint8_t)i);
+
+		p = (uint8_t*)a.reallocate(p, kLarge * 4, kSmall);
+		EATEST_VERIFY(p != NULL);
+		for(size_t i = 0; i < kSmall; i++)
+			EATEST_VERIFY(p[i] == (uint8_t)i);
+
+		a.deallocate(p, kSmall);
+	}
+
+	{
+		// vector growth through reallocate, including push_back of one of its own elements.
+		typedef std::vector<uint64_t, std::mmap_allocator> MmapVector;
+
+		MmapVector v(std::mmap_allocator("TestAllocatorMmap", true));
+		const uint64_t kCount = (EASTL_MMAP_ALLOCATOR_THRESHOLD / sizeof(uint64_t)) * 8;
+
+		for(uint64_t i = 0; i < kCount; i++)
+			v.push_back(i);
+		v.push_back(v[0]);
+
+		EATEST_VERIFY(v.size() == kCount + 1);
+		EATEST_VERIFY(v.back() == 0);
+
+		bool bValid = true;
+		for(uint64_t i = 0; i < kCount; i++)
+			bValid = bValid && (v[(size_t)i] == i);
+		EATEST_VERIFY(bValid);
+
+		v.resize(v.size() * 3, v[1]);
+		EATEST_VERIFY(v.back() == 1);
+		EATEST_VERIFY(v[(size_t)kCount - 1] == kCount - 1);
+
+		v.reserve(v.capacity() * 2);
+		EATEST_VERIFY(v[(size_t)kCount - 1] == kCount - 1);
+		EATEST_VERIFY(v.validate());
+
+		v.set_capacity(kCount);
+		EATEST_VERIFY(v.size() == kCount);
+		EATEST_VERIFY(v[(size_t)kCount - 1] == kCount - 1);
+	}
+
+	{
+		// vector growth goes through reallocate, and only for types which need no more than system alignment.
+		static_assert(std::Internal::vector_can_reallocate<uint64_t, CountingMmapAllocator>::value, "uint64_t should use reallocate");
+		static_assert(!std::Internal::vector_can_reallocate<MmapAligned64, CountingMmapAllocator>::value, "over-aligned types must not use reallocate");
+
+		const size_t kCount = (EASTL_MMAP_ALLOCATOR_THRESHOLD / sizeof(MmapAligned64)) * 4;
+
+		CountingMmapAllocator::snReallocateCount = 0;
+		std::vector<uint64_t, CountingMmapAllocator> v;
+		for(size_t i = 0; i < kCount; i++)
+			v.push_back(i);
+		EATEST_VERIFY(CountingMmapAllocator::snReallocateCount > 0);
+
+		// Grows from malloc to mappings and shrinks back, each time keeping its alignment.
+		CountingMmapAllocator::snReallocateCount = 0;
+		std::vector<MmapAligned64, CountingMmapAllocator> a;
+		bool bAligned = true;
+
+		for(size_t i = 0; i < kCount; i++)
+		{
+			MmapAligned64 value = { i };
+			a.push_back(value);
+			bAligned = bAligned && (((uintptr_t)a.data() % 64) == 0);
+		}
+
+		a.resize(4);
+		a.shrink_to_fit();
+		bAligned = bAligned && (((uintptr_t)a.data() % 64) == 0);
+
+		EATEST_VERIFY(bAligned);
+		EATEST_VERIFY((a.size() == 4) && (a[3].mnValue == 3));
+		EATEST_VERIFY(CountingMmapAllocator::snReallocateCount == 0);
+
+		// The aligned allocate overload itself, both below and above the threshold.
+		std::mmap_allocator m;
+		void* const pSmall = m.allocate(256, 256, 0);
+		void* const pLarge = m.allocate(EASTL_MMAP_ALLOCATOR_THRESHOLD, 256, 0);
+		EATEST_VERIFY(pSmall && (((uintptr_t)pSmall % 256) == 0));
+		EATEST_VERIFY(pLarge && (((uintptr_t)pLarge % 256) == 0));
+		m.deallocate(pSmall, 256);
+		m.deallocate(pLarge, EASTL_MMAP_ALLOCATOR_THRESHOLD);
+	}
+
+	return nErrorCount;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// TestConcurrentFixedPool
+//
+#if EASTL_THREAD_SUPPORT_AVAILABLE
+	struct ConcurrentFixedPoolTestThread : public EA::Thread::IRunnable
+	{
+		EA::Thread::Thread          mThread;
+		std::concurrent_fixed_pool* mpPool;
+		uintptr_t                   mnId;
+		int                         mnErrorCount;
+
+		ConcurrentFixedPoolTestThread() : mThread(), mpPool(NULL), mnId(0), mnErrorCount(0) {}
+		ConcurrentFixedPoolTestThread(const ConcurrentFixedPoolTestThread&){}
+		void operator=(const ConcurrentFixedPoolTestThread&){}
+
+		intptr_t Run(void*)
+		{
+			int& nErrorCount = mnErrorCount; // declare nErrorCount so that EATEST_VERIFY can work, as it depends on it being declared.
+
+			uintptr_t* nodes[37];
+
+			for(int i = 0; i < 2000; i++)
+			{
+				size_t nCount = 0;
+
+				for(; nCount < EAArrayCount(nodes); nCount++)
+				{
+					if((nodes[nCount] = (uintptr_t*)mpPool->allocate()) == NULL)
+						break;
+					nodes[nCount][0] = mnId;
+					nodes[nCount][1] = nCount;
+				}
+
+				// If any node had been given to two threads at once, its contents would have been overwritten.
+				for(size_t j = 0; j < nCount; j++)
+				{
+					EATEST_VERIFY((nodes[j][0] == mnId) && (nodes[j][1] == j));
+					mpPool->deallocate(nodes[j]);
+				}
+			}
+
+			return nErrorCount;
+		}
+	};
+#endif
+
+
+static int TestConcurrentFixedPool()
+{
+	using namespace std;
+
+	int nErrorCount = 0;
+
+	{
+		// Single-threaded behaviour must match fixed_pool, in particular all nodes must be
+		// allocatable, regardless of which caches the freed nodes ended up in.
+		const size_t kNodeSize  = 32;
+		const size_t kNodeCount = concurrent_fixed_pool::kBatchSize * 5 + 3;
+		EA_ALIGN(16) char buffer[kNodeSize * kNodeCount];
+
+		concurrent_fixed_pool pool(buffer, sizeof(buffer), kNodeSize, 16);
+		vector<void*> nodes;
+
+		for(int pass = 0; pass < 3; pass++)
+		{
+			EATEST_VERIFY(pool.can_allocate());
+
+			while(void* p = pool.allocate())
+			{
+				EATEST_VERIFY(((uintptr_t)p % 16) == 0);
+				EATEST_VERIFY((p >= buffer) && ((char*)p + kNodeSize <= buffer + sizeof(buffer)));
+				nodes.push_back(p);
+			}
+
+			EATEST_VERIFY(nodes.size() == kNodeCount);
+			EATEST_VERIFY(!pool.can_allocate());
+
+			sort(nodes.begin(), nodes.end());
+			EATEST_VERIFY(unique(nodes.begin(), nodes.end()) == nodes.end());
+
+			#if EASTL_FIXED_SIZE_TRACKING_ENABLED
+				EATEST_VERIFY(pool.current_size() == kNodeCount);
+				EATEST_VERIFY(pool.peak_size() == kNodeCount);
+			#endif
+
+			for(size_t i = 0; i < nodes.size(); i++)
+				pool.deallocate(nodes[i]);
+			nodes.clear();
+
+			#if EASTL_FIXED_SIZE_TRACKING_ENABLED
+				EATEST_VERIFY(pool.current_size() == 0);
+				EATEST_VERIFY(pool.peak_size() == kNodeCount);
+			#endif
+		}
+	}
+
+	{
+		// concurrent_fixed_pool as the pool of fixed_node_allocator.
+		typedef list<int>::node_type IntListNode;
+		typedef fixed_node_allocator<sizeof(IntListNode), 64, EASTL_ALIGN_OF(IntListNode), 0, false, EASTLAllocatorType, concurrent_fixed_pool> ConcurrentNodeAllocator;
+		typedef list<int, ConcurrentNodeAllocator> IntList;
+
+		char buffer[ConcurrentNodeAllocator::kBufferSize];
+		IntList intList((ConcurrentNodeAllocator(buffer)));
+
+		for(int i = 0; i < 64; i++)
+			intList.push_back(i);
+
+		EATEST_VERIFY(intList.size() == 64);
+		EATEST_VERIFY(!intList.get_allocator().can_allocate());
+
+		intList.remove_if([](int i) { return (i % 2) == 0; });
+		for(int i = 0; i < 32; i++)
+			intList.push_front(-i);
+
+		EATEST_VERIFY(intList.size() == 64);
+		EATEST_VERIFY(intList.validate());
+	}
+
+	#if EASTL_THREAD_SUPPORT_AVAILABLE
+		{
+			// More threads than nodes per thread would need, so that threads find the shared 
+			// list empty and have to take nodes out of each other's caches.
+			const size_t kNodeSize  = sizeof(uintptr_t) * 2;
+			const size_t kNodeCount = 100;
+			EA_ALIGN(16) char buffer[kNodeSize * kNodeCount];
+
+			concurrent_fixed_pool pool(buffer, sizeof(buffer), kNodeSize, 16);
+			ConcurrentFixedPoolTestThread thread[6];
+
+			for(size_t i = 0; i < EAArrayCount(thread); i++)
+			{
+				thread[i].mpPool = &pool;
+				thread[i].mnId   = i + 1;
+				thread[i].mThread.Begin(&thread[i]);
+			}
+
+			for(size_t i = 0; i < EAArrayCount(thread); i++)
+			{
+				thread[i].mThread.WaitForEnd();
+				nErrorCount += thread[i].mnErrorCount;
+			}
+
+			// No nodes may have been lost.
+			size_t nCount = 0;
+			while(pool.allocate())
+				nCount++;
+			EATEST_VERIFY(nCount == kNodeCount);
+		}
+	#endif
+
+	return nErrorCount;
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////
 // TestCoreAllocatorAdapter
 //
@@ -383,6 +684,8 @@ int TestAllocator()
 	nErrorCount += TestAllocationOffsetAndAlignment();
 	nErrorCount += TestFixedAllocator();
 	nErrorCount += TestAllocatorMalloc();
+	nErrorCount += TestAllocatorMmap();
+	nErrorCount += TestConcurrentFixedPool();
 	nErrorCount += TestCoreAllocatorAdapter();
 	nErrorCount += TestSwapAllocator();
 
@@ -6,6 +6,7 @@
 #include "EASTLTest.h"
 
 #include <EASTL/atomic.h>
+#include <EASTL/thread_pool.h>
 
 
 /**
@@ -3955,6 +3956,147 @@ int TestAtomic128Loads()
 
 #endif
 
+struct AtomicWaitType128
+{
+	uint64_t a, b;
+};
+
+#if EASTL_THREAD_POOL_AVAILABLE
+/**
+ * Passes a token back and forth between two threads kRoundCount times, each waiting
+ * for the other's value before storing its own and notifying, with values of the
+ * given type made from the round number by makeValue.
+ */
+template <typename T, typename MakeValue>
+static int TestAtomicWaitPingPong(MakeValue makeValue)
+{
+	int nErrorCount = 0;
+
+	const int kRoundCount = 2000;
+
+	std::thread_pool pool(1);
+	std::atomic<T>   atomic{makeValue(0)};
+	int              nWrong = 0;
+
+	if (CanRunBlockingTasks(pool))
+	{
+		pool.parallel_invoke([&]
+		{
+			for (int i = 0; i < kRoundCount; i += 2)
+			{
+				atomic.wait(makeValue(i), std::memory_order_acquire);
+				atomic.store(makeValue(i + 2), std::memory_order_release);
+				atomic.notify_one();
+			}
+		},
+		[&]
+		{
+			for (int i = 0; i < kRoundCount; i += 2)
+			{
+				atomic.store(makeValue(i + 1), std::memory_order_release);
+				atomic.notify_one();
+				atomic.wait(makeValue(i + 1), std::memory_order_acquire);
+
+				const T value    = atomic.load();
+				const T expected = makeValue(i + 2);
+				if (memcmp(&value, &expected, sizeof(T)) != 0)
+					nWrong++;
+			}
+		});
+
+		VERIFY(nWrong == 0);
+	}
+
+	return nErrorCount;
+}
+#endif
+
+static int TestAtomicWait()
+{
+	int nErrorCount = 0;
+
+	// wait returns at once if the value already differs, and notify without waiters does nothing.
+	{
+		std::atomic<uint32_t> atomic{1};
+
+		atomic.wait(0);
+		atomic.wait(0, std::memory_order_relaxed);
+		atomic.notify_one();
+		atomic.notify_all();
+
+		std::atomic_wait(&atomic, 0u);
+		std::atomic_wait_explicit(&atomic, 0u, std::memory_order_acquire);
+		std::atomic_notify_one(&atomic);
+		std::atomic_notify_all(&atomic);
+
+		VERIFY(atomic.load() == 1);
+	}
+
+	{
+		std::atomic_flag flag;
+
+		flag.test_and_set();
+		flag.wait(false);
+		flag.wait(false, std::memory_order_acquire);
+		flag.notify_all();
+
+		std::atomic_flag_wait(&flag, false);
+		std::atomic_flag_wait_explicit(&flag, false, std::memory_order_acquire);
+		std::atomic_flag_notify_one(&flag);
+		std::atomic_flag_notify_all(&flag);
+
+		VERIFY(flag.test());
+	}
+
+	#if EASTL_THREAD_POOL_AVAILABLE
+		// The sizes which are waited upon directly, and those which go through the buckets.
+		nErrorCount += TestAtomicWaitPingPong<uint32_t>([](int i) { return (uint32_t)i; });
+		nErrorCount += TestAtomicWaitPingPong<uint8_t>([](int i) { return (uint8_t)i; });
+		nErrorCount += TestAtomicWaitPingPong<uint64_t>([](int i) { return (uint64_t)i << 40; });
+		nErrorCount += TestAtomicWaitPingPong<void*>([](int i) { return (void*)(uintptr_t)(i * 16); });
+
+		#if defined(EASTL_ATOMIC_HAS_128BIT)
+			nErrorCount += TestAtomicWaitPingPong<AtomicWaitType128>([](int i) { return AtomicWaitType128{0, (uint64_t)i}; });
+		#endif
+
+		// Several threads wait upon a flag which is set once, with notify_all.
+		{
+			std::thread_pool      pool(4);
+			std::atomic_flag      flag;
+			std::atomic<int>      nStarted{0};
+			std::atomic<int>      nWoken{0};
+
+			if (CanRunBlockingTasks(pool)) // The setter waits for a waiter to start, which runs after it without workers.
+			{
+				pool.parallel_invoke([&]
+				{
+					while (nStarted.load() == 0)
+						std::Internal::thread_yield();
+
+					flag.test_and_set(std::memory_order_release);
+					flag.notify_all();
+				},
+				[&]
+				{
+					pool.parallel_for(4, 1, [&](size_t nBegin, size_t nEnd)
+					{
+						for (size_t i = nBegin; i < nEnd; i++)
+						{
+							nStarted++;
+							flag.wait(false, std::memory_order_acquire);
+							nWoken++;
+						}
+					});
+				});
+
+				VERIFY(nWoken.load() == 4);
+			}
+		}
+	#endif
+
+	return nErrorCount;
+}
+
 int TestAtomicBasic()
 {
 	int nErrorCount = 0;
@@ -4079,5 +4221,7 @@ int TestAtomicBasic()
 
 	nErrorCount += TestAtomicConstantInitialization();
 
+	nErrorCount += TestAtomicWait();
+
 	return nErrorCount;
 }
@@ -0,0 +1,182 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "EASTLTest.h"
+#include <EASTL/concurrent_intrusive.h>
+#include <EASTL/thread_pool.h>
+#include <EASTL/atomic.h>
+#include <EASTL/vector.h>
+
+
+namespace
+{
+	struct IntNode : public std::intrusive_slist_node
+	{
+		int mnProducer;
+		int mnValue;
+
+		IntNode(int nProducer = 0, int nValue = 0) : mnProducer(nProducer), mnValue(nValue) {}
+	};
+}
+
+
+int TestConcurrentIntrusive()
+{
+	using namespace std;
+
+	int nErrorCount = 0;
+
+	// Test intrusive_mpsc_queue on a single thread
+	{
+		intrusive_mpsc_queue<IntNode> queue;
+		IntNode                       nodes[4] = { IntNode(0, 0), IntNode(0, 1), IntNode(0, 2), IntNode(0, 3) };
+
+		EATEST_VERIFY(queue.empty());
+		EATEST_VERIFY(queue.try_pop() == NULL);
+
+		queue.push(nodes[0]);
+		EATEST_VERIFY(!queue.empty());
+		EATEST_VERIFY(queue.try_pop() == &nodes[0]);
+		EATEST_VERIFY(queue.empty());
+		EATEST_VERIFY(queue.try_pop() == NULL);
+
+		// A popped node can be pushed again, including the last one popped.
+		queue.push(nodes[1]);
+		queue.push(&nodes[2]);
+		queue.push(nodes[0]);
+		EATEST_VERIFY(queue.try_pop() == &nodes[1]);
+		queue.push(nodes[1]);
+		queue.push(nodes[3]);
+
+		EATEST_VERIFY(queue.try_pop() == &nodes[2]);
+		EATEST_VERIFY(queue.try_pop() == &nodes[0]);
+		EATEST_VERIFY(queue.try_pop() == &nodes[1]);
+		EATEST_VERIFY(queue.try_pop() == &nodes[3]);
+		EATEST_VERIFY(queue.try_pop() == NULL);
+		EATEST_VERIFY(queue.empty());
+	}
+
+	// Test intrusive_treiber_stack on a single thread
+	{
+		intrusive_treiber_stack<IntNode> stack;
+		IntNode                          nodes[4] = { IntNode(0, 0), IntNode(0, 1), IntNode(0, 2), IntNode(0, 3) };
+
+		EATEST_VERIFY(stack.empty());
+		EATEST_VERIFY(stack.try_pop() == NULL);
+		EATEST_VERIFY(stack.pop_all() == NULL);
+
+		stack.push(nodes[0]);
+		stack.push(&nodes[1]);
+		EATEST_VERIFY(!stack.empty());
+		EATEST_VERIFY(stack.try_pop() == &nodes[1]);
+
+		nodes[2].mpNext = &nodes[3];
+		stack.push_chain(&nodes[2], &nodes[3]);
+
+		IntNode* pNode = stack.pop_all();
+		EATEST_VERIFY(stack.empty());
+		EATEST_VERIFY(pNode == &nodes[2]);
+		EATEST_VERIFY(pNode->mpNext == &nodes[3]);
+		EATEST_VERIFY(pNode->mpNext->mpNext == &nodes[0]);
+		EATEST_VERIFY(pNode->mpNext->mpNext->mpNext == NULL);
+	}
+
+	// Test producers pushing to an intrusive_mpsc_queue while the consumer pops. Each
+	// producer's nodes must arrive in the order it pushed them.
+	#if EASTL_THREAD_POOL_AVAILABLE
+		{
+			const int kProducerCount = 4;
+			const int kNodeCount     = 20000;
+
+			vector<IntNode> nodes(kProducerCount * kNodeCount);
+			for (int i = 0; i < kProducerCount * kNodeCount; i++)
+				nodes[i] = IntNode(i / kNodeCount, i % kNodeCount);
+
+			intrusive_mpsc_queue<IntNode> queue;
+			thread_pool                   pool(kProducerCount);
+			int                           nWrong = 0;
+
+			if (CanRunBlockingTasks(pool)) // The consumer waits for nodes which only the producers push.
+			{
+				pool.parallel_invoke([&]
+				{
+					int nNext[kProducerCount] = {};
+
+					for (int nPopped = 0; nPopped < kProducerCount * kNodeCount; )
+					{
+						if (IntNode* pNode = queue.try_pop())
+						{
+							if (pNode->mnValue != nNext[pNode->mnProducer]++)
+								nWrong++;
+							nPopped++;
+						}
+					}
+				},
+				[&]
+				{
+					pool.parallel_for(kProducerCount, 1, [&](size_t nBegin, size_t nEnd)
+					{
+						for (size_t p = nBegin; p < nEnd; p++)
+						{
+							for (int i = 0; i < kNodeCount; i++)
+								queue.push(nodes[p * kNodeCount + i]);
+						}
+					});
+				});
+
+				EATEST_VERIFY(nWrong == 0);
+				EATEST_VERIFY(queue.empty());
+			}
+		}
+	#endif
+
+	// Test threads popping nodes from an intrusive_treiber_stack and pushing them back,
+	// which is the pattern the tag protects from the ABA problem. Every node must be on
+	// the stack exactly once at the end.
+	{
+		const int kNodeCount = 64;
+
+		IntNode                          nodes[kNodeCount];
+		intrusive_treiber_stack<IntNode> stack;
+		thread_pool                      pool(4);
+
+		for (int i = 0; i < kNodeCount; i++)
+		{
+			nodes[i].mnValue = i;
+			stack.push(nodes[i]);
+		}
+
+		pool.parallel_for(200000, 1000, [&](size_t nBegin, size_t nEnd)
+		{
+			IntNode* popped[3];
+
+			for (size_t i = nBegin; i < nEnd; i++)
+			{
+				const int nPopCount = 1 + (int)(i % 3);
+				int       n = 0;
+
+				while (n < nPopCount && (popped[n] = stack.try_pop()) != NULL)
+					n++;
+				while (n > 0)
+					stack.push(popped[--n]);
+			}
+		});
+
+		int seen[kNodeCount] = {};
+		int nCount = 0;
+
+		for (IntNode* pNode = stack.pop_all(); pNode; pNode = static_cast<IntNode*>(pNode->mpNext))
+		{
+			seen[pNode->mnValue]++;
+			if (++nCount > kNodeCount)
+				break;
+		}
+
+		EATEST_VERIFY(nCount == kNodeCount);
+		for (int i = 0; i < kNodeCount; i++)
+			EATEST_VERIFY(seen[i] == 1);
+	}
+
+	return nErrorCount;
+}
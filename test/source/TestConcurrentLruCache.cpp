@@ -0,0 +1,138 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "EASTLTest.h"
+#include <EASTL/bonus/concurrent_lru_cache.h>
+#include <EASTL/thread_pool.h>
+#include <EASTL/atomic.h>
+
+
+int TestConcurrentLruCache()
+{
+	using namespace std;
+
+	int nErrorCount = 0;
+
+	// Test the semantics of lru_cache, with one shard
+	{
+		int nCreated = 0, nDeleted = 0;
+
+		concurrent_lru_cache<int, int> cache(3, 1, EASTLAllocatorType("ConcurrentLruCache"),
+		                                     [&](int k) { nCreated++; return k * 10; },
+		                                     [&](const int&) { nDeleted++; });
+
+		EATEST_VERIFY(cache.shard_count() == 1);
+		EATEST_VERIFY(cache.capacity() == 3);
+		EATEST_VERIFY(cache.empty());
+		EATEST_VERIFY(!cache.at(1).has_value());
+
+		EATEST_VERIFY(cache.get(1) == 10);
+		EATEST_VERIFY(cache.get(2) == 20);
+		EATEST_VERIFY(cache.get(1) == 10); // A hit doesn't create.
+		EATEST_VERIFY(nCreated == 2);
+		EATEST_VERIFY(cache.size() == 2);
+
+		EATEST_VERIFY(cache.insert(3, 30));
+		EATEST_VERIFY(!cache.insert(3, 31));
+		EATEST_VERIFY(cache.at(3).value() == 30);
+
+		// The reads of 1 are applied before 4 is added, so 2 is the oldest.
+		EATEST_VERIFY(cache.touch(1));
+		EATEST_VERIFY(!cache.touch(5));
+		EATEST_VERIFY(cache.get(4) == 40);
+		EATEST_VERIFY(!cache.contains(2));
+		EATEST_VERIFY(cache.contains(1) && cache.contains(3) && cache.contains(4));
+		EATEST_VERIFY(nDeleted == 1);
+
+		EATEST_VERIFY(cache.assign(3, 33));
+		EATEST_VERIFY(!cache.assign(2, 22));
+		EATEST_VERIFY(cache.at(3).value() == 33);
+		cache.insert_or_assign(4, 44);
+		EATEST_VERIFY(cache.at(4).value() == 44);
+		EATEST_VERIFY(nDeleted == 3);
+
+		EATEST_VERIFY(cache.erase(1));
+		EATEST_VERIFY(!cache.erase(1));
+		EATEST_VERIFY(nDeleted == 4);
+
+		cache.clear();
+		EATEST_VERIFY(cache.empty());
+		EATEST_VERIFY(nDeleted == 6);
+	}
+
+	// Test that the capacity is divided among the shards
+	{
+		concurrent_lru_cache<int, int> cache(100, 5);
+
+		EATEST_VERIFY(cache.shard_count() == 8);
+		EATEST_VERIFY(cache.capacity() == 104);
+
+		for (int i = 0; i < 1000; i++)
+			cache.insert(i, i);
+
+		EATEST_VERIFY(cache.size() <= 104);
+		EATEST_VERIFY(cache.size() >= 64);
+
+		for (int i = 0; i < 1000; i++)
+		{
+			auto v = cache.at(i);
+			EATEST_VERIFY(!v.has_value() || (v.value() == i));
+		}
+	}
+
+	// Test many threads getting, adding and erasing keys at once. Every datum created must be deleted once.
+	{
+		atomic<int> nLive(0);
+		atomic<int> nWrong(0);
+
+		{
+			concurrent_lru_cache<int, int> cache(256, 4, EASTLAllocatorType("ConcurrentLruCache"),
+			                                     [&](int k) { nLive.fetch_add(1); return k + 1; },
+			                                     [&](const int&) { nLive.fetch_sub(1); });
+
+			thread_pool pool(4);
+
+			pool.parallel_for(20000, 16, [&](size_t nBegin, size_t nEnd)
+			{
+				for (size_t i = nBegin; i < nEnd; i++)
+				{
+					const int k = (int)((i * 7919) % 1024);
+
+					switch (i % 8)
+					{
+						case 0:
+							if (cache.insert(k, k + 1))
+								nLive.fetch_add(1);
+							break;
+
+						case 1:
+							cache.erase(k);
+							break;
+
+						case 2:
+						{
+							auto v = cache.at(k);
+							if (v.has_value() && (v.value() != k + 1))
+								nWrong.fetch_add(1);
+							break;
+						}
+
+						default:
+							if (cache.get(k) != k + 1)
+								nWrong.fetch_add(1);
+							break;
+					}
+				}
+			});
+
+			EATEST_VERIFY(cache.size() <= cache.capacity());
+			EATEST_VERIFY(nLive.load() == (int)cache.size());
+		}
+
+		EATEST_VERIFY(nWrong.load() == 0);
+		EATEST_VERIFY(nLive.load() == 0);
+	}
+
+	return nErrorCount;
+}
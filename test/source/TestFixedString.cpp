@@ -291,6 +291,22 @@ int TestFixedString()
 		fs88.set_capacity(capacity * 2);
 		EATEST_VERIFY(fs88.capacity() >= (capacity * 2));
 
+		// void resize_default_init(size_type n);
+		// pointer append_uninitialized(size_type n);
+		fixed_string<char, 16, true> fs12("abc");
+		char* pTail = fs12.append_uninitialized(3);
+		EATEST_VERIFY(pTail == fs12.data() + 3);
+		memcpy(pTail, "def", 3);
+		EATEST_VERIFY(fs12 == "abcdef");
+		EATEST_VERIFY(fs12.validate());
+		fs12.resize_default_init(40); // Overflows the fixed buffer.
+		EATEST_VERIFY(fs12.size() == 40);
+		EATEST_VERIFY(fs12.has_overflowed());
+		EATEST_VERIFY(fs12.compare(0, 6, "abcdef") == 0);
+		EATEST_VERIFY(fs12.c_str()[40] == 0);
+		fs12.resize_for_overwrite(2);
+		EATEST_VERIFY(fs12 == "ab");
+
 		// void reset_lose_memory();
 		fs6.reset_lose_memory();
 		EATEST_VERIFY(fs6.size() == 0);
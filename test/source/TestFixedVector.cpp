@@ -142,6 +142,19 @@ int TestFixedVector()
 		fv88.set_capacity(capacity * 2);
 		EATEST_VERIFY(fv88.capacity() >= (capacity * 2));
 
+		// void resize_default_init(size_type n);
+		// pointer append_uninitialized(size_type n);
+		FixedVectorInt8 fv9;
+		fv9.resize_default_init(4);
+		EATEST_VERIFY(fv9.size() == 4);
+		EATEST_VERIFY(fv9.capacity() == 8);
+		int* pTail = fv9.append_uninitialized(4);
+		EATEST_VERIFY(pTail == fv9.data() + 4);
+		EATEST_VERIFY(fv9.size() == 8);
+		EATEST_VERIFY(fv9.full());
+		fv9.resize_for_overwrite(2);
+		EATEST_VERIFY(fv9.size() == 2);
+
 		// void swap(this_type& x);
 		// FixedVectorInt8 fv7(5, 3);  // MSVC-ARM64 generated an internal compiler error on this line.
 		FixedVectorInt8 fv7 = {3, 3, 3, 3, 3};
@@ -4,6 +4,7 @@
 
 #include "EASTLTest.h"
 #include <EASTL/bonus/lru_cache.h>
+#include <EASTL/string.h>
 #include <EASTL/unique_ptr.h>
 
 namespace TestLruCacheInternal
@@ -49,6 +50,68 @@ namespace TestLruCacheInternal
 
 		int mFooCreatedCount;
 	};
+
+	// Tests the lru_cache functions with the given policy, and returns the ratio of hits for a set of
+	// frequently used keys, interleaved with scans of keys which are used once.
+	template <typename Policy>
+	int TestPolicy(double& fHotHitRatio)
+	{
+		int nErrorCount = 0;
+		int nLiveCount = 0;
+
+		{
+			std::lru_cache<int, int, EASTLAllocatorType, std::hash<int>, std::equal_to<int>, Policy>
+				lc(100, EASTLAllocatorType("LruCache"), [&](int k) { nLiveCount++; return k * 2; }, [&](const int&) { nLiveCount--; });
+
+			for(int i = 0; i < 1000; i++)
+			{
+				VERIFY(lc.get(i % 300) == (i % 300) * 2);
+				VERIFY(lc.size() <= 100);
+			}
+			VERIFY(lc.size() == 100);
+			VERIFY(nLiveCount == 100);
+
+			int nCount = 0;
+			for(auto& p : lc)
+			{
+				VERIFY(p.second.first == p.first * 2);
+				nCount++;
+			}
+			VERIFY(nCount == 100);
+
+			lc.erase_oldest();
+			VERIFY(lc.size() == 99);
+			lc.resize(50);
+			VERIFY(lc.size() == 50);
+			VERIFY(nLiveCount == 50);
+			lc.resize(100);
+
+			int nHitCount = 0;
+			int nScanKey = 1000;
+			for(int round = 0; round < 100; round++)
+			{
+				for(int i = 0; i < 200; i++)
+				{
+					if(lc.touch(i % 50))
+						nHitCount++;
+					else
+						lc.get(i % 50);
+				}
+
+				for(int i = 0; i < 150; i++)
+					lc.get(nScanKey++);
+			}
+			fHotHitRatio = nHitCount / 20000.0;
+
+			lc.clear();
+			VERIFY(lc.empty());
+			VERIFY(nLiveCount == 0);
+			lc.get(1);
+		}
+
+		VERIFY(nLiveCount == 0);
+		return nErrorCount;
+	}
 }
 
 
@@ -336,5 +399,89 @@ int TestLruCache()
 		}
 	}
 
+	// Test recency order, and resize, which moves the entries to storage for the new capacity
+	{
+		std::lru_cache<std::string, std::unique_ptr<int>> lc(4);
+		lc.emplace("a", new int(1));
+		lc.emplace("b", new int(2));
+		lc.emplace("c", new int(3));
+		lc.touch("a");
+		lc.emplace("b", new int(20)); // Replaces the value of b, and makes it the newest
+
+		{
+			const char* expected[] = { "c", "a", "b" };
+			int i = 0;
+			for(auto& p : lc)
+				VERIFY(p.first == expected[i++]);
+			VERIFY(i == 3);
+
+			for(auto iter = lc.rbegin(); iter != lc.rend(); ++iter)
+				VERIFY(iter->first == expected[--i]);
+			VERIFY(i == 0);
+		}
+
+		lc.resize(100);
+		VERIFY(lc.size() == 3);
+		VERIFY(lc.capacity() == 100);
+		VERIFY(*lc.get("b") == 20);
+		VERIFY(lc.begin()->first == "c");
+
+		lc.resize(2); // Evicts c, the oldest
+		VERIFY(lc.size() == 2);
+		VERIFY(!lc.contains("c"));
+		VERIFY(*lc.get("a") == 1);
+		VERIFY(*lc.get("b") == 20);
+
+		for(int i = 0; i < 1000; i++) // Entries are reused, without allocating.
+			lc.emplace(std::to_string(i), new int(i));
+		VERIFY(lc.size() == 2);
+		VERIFY(lc.contains("999") && lc.contains("998") && !lc.contains("997"));
+		VERIFY(lc.erase("999"));
+		VERIFY(lc.size() == 1);
+		VERIFY(lc.begin()->first == "998");
+	}
+
+	// Test the policies
+	{
+		using namespace TestLruCacheInternal;
+
+		double fLru, fClock, fS3Fifo, fWTinyLfu;
+		nErrorCount += TestPolicy<std::cache_lru_policy>(fLru);
+		nErrorCount += TestPolicy<std::cache_clock_policy>(fClock);
+		nErrorCount += TestPolicy<std::cache_s3fifo_policy>(fS3Fifo);
+		nErrorCount += TestPolicy<std::cache_wtinylfu_policy>(fWTinyLfu);
+
+		// The scans flush the frequently used keys from LRU and CLOCK, but not from S3-FIFO and W-TinyLFU.
+		VERIFY(fLru < 0.8);
+		VERIFY(fClock < 0.8);
+		VERIFY(fS3Fifo > 0.95);
+		VERIFY(fWTinyLfu > 0.95);
+
+		// CLOCK evicts the first entry which hasn't been accessed, and passes over the others.
+		std::lru_cache<int, int, EASTLAllocatorType, std::hash<int>, std::equal_to<int>, std::cache_clock_policy> lc(3);
+		lc.insert(1, 1);
+		lc.insert(2, 2);
+		lc.insert(3, 3);
+		lc.touch(1);
+		lc.insert(4, 4);
+		VERIFY(lc.contains(1) && !lc.contains(2));
+		VERIFY(lc.begin()->first == 3);
+		VERIFY(lc.rbegin()->first == 4);
+
+		// W-TinyLFU doesn't admit a key used less often than the one it would replace.
+		std::lru_cache<int, int, EASTLAllocatorType, std::hash<int>, std::equal_to<int>, std::cache_wtinylfu_policy> lfu(10);
+		for(int i = 0; i < 10; i++)
+		{
+			for(int j = 0; j < 5; j++)
+				lfu.get(i);
+		}
+		for(int i = 10; i < 20; i++)
+			lfu.get(i);
+		int nCount = 0;
+		for(int i = 0; i < 10; i++)
+			nCount += lfu.contains(i) ? 1 : 0;
+		VERIFY(nCount == 9); // All but the one in the window.
+	}
+
 	return nErrorCount;
 }
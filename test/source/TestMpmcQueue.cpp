@@ -0,0 +1,172 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "EASTLTest.h"
+#include <EASTL/mpmc_queue.h>
+#include <EASTL/thread_pool.h>
+#include <EASTL/atomic.h>
+#include <EASTL/vector.h>
+
+
+int TestMpmcQueue()
+{
+	using namespace std;
+
+	int nErrorCount = 0;
+
+	// Test the sequence difference which tells a full or empty cell from one claimed by
+	// another thread. If it were taken in a type wider than eastl_size_t, as happens with
+	// EASTL_SIZE_T_32BIT on a 64 bit platform, a cell behind its index would seem ahead of
+	// it, and try_pop on an empty queue or try_push on a full one would never return. So
+	// this runs first, and the queue is only used if the difference is right.
+	{
+		const eastl_size_t kMax = (eastl_size_t)-1;
+
+		EATEST_VERIFY(Internal::mpmc_queue_sequence_diff(0, 0) == 0);
+		EATEST_VERIFY(Internal::mpmc_queue_sequence_diff(0, 1) < 0);
+		EATEST_VERIFY(Internal::mpmc_queue_sequence_diff(1, 0) > 0);
+		EATEST_VERIFY(Internal::mpmc_queue_sequence_diff(kMax, 0) < 0);
+		EATEST_VERIFY(Internal::mpmc_queue_sequence_diff(0, kMax) > 0);
+
+		if (nErrorCount)
+			return nErrorCount;
+
+		mpmc_queue<int> queue(2);
+		int             n = 0;
+		const int       values[2] = { 1, 2 };
+
+		EATEST_VERIFY(!queue.try_pop(n));
+		EATEST_VERIFY(queue.pop_n(span<int>(&n, 1)) == 0);
+		EATEST_VERIFY(queue.push_n(values) == 2);
+		EATEST_VERIFY(!queue.try_push(3));
+		EATEST_VERIFY(queue.push_n(values) == 0);
+	}
+
+	// Test the operations on a single thread
+	{
+		TestObject::Reset();
+
+		{
+			mpmc_queue<TestObject> queue(5);
+			TestObject             object;
+
+			EATEST_VERIFY(queue.capacity() == 8);
+			EATEST_VERIFY(queue.empty());
+			EATEST_VERIFY(!queue.try_pop(object));
+
+			for (int i = 0; i < 8; i++)
+				EATEST_VERIFY(queue.try_emplace(i));
+
+			EATEST_VERIFY(queue.size() == 8);
+			EATEST_VERIFY(!queue.try_push(TestObject(8)));
+			EATEST_VERIFY(TestObject::sTOCount == 9);
+
+			EATEST_VERIFY(queue.try_pop(object) && (object.mX == 0));
+			queue.pop(object);
+			EATEST_VERIFY(object.mX == 1);
+			queue.push(TestObject(8));
+
+			// Push a batch which wraps around the end of the ring, and only partly fits.
+			const TestObject batch[4] = { TestObject(9), TestObject(10), TestObject(11), TestObject(12) };
+			EATEST_VERIFY(queue.push_n(batch) == 1);
+			EATEST_VERIFY(queue.push_n(batch) == 0);
+			EATEST_VERIFY(queue.push_n(span<const TestObject>()) == 0);
+
+			TestObject results[5];
+			EATEST_VERIFY(queue.pop_n(results) == 5);
+			for (int i = 0; i < 5; i++)
+				EATEST_VERIFY(results[i].mX == i + 2);
+
+			EATEST_VERIFY(queue.pop_n(results) == 3);
+			EATEST_VERIFY((results[0].mX == 7) && (results[1].mX == 8) && (results[2].mX == 9));
+			EATEST_VERIFY(queue.empty());
+			EATEST_VERIFY(queue.pop_n(results) == 0);
+
+			// The queue destroys the elements it still holds.
+			EATEST_VERIFY(queue.push_n(batch) == 4);
+		}
+
+		EATEST_VERIFY(TestObject::IsClear());
+		TestObject::Reset();
+	}
+
+	// Test fixed_mpmc_queue at its smallest capacity
+	{
+		fixed_mpmc_queue<int, 2> queue;
+		int                      n = 0;
+
+		EATEST_VERIFY(queue.capacity() == 2);
+
+		for (int i = 0; i < 10; i += 2)
+		{
+			EATEST_VERIFY(queue.try_push(i) && queue.try_push(i + 1));
+			EATEST_VERIFY(!queue.try_push(-1));
+			EATEST_VERIFY(queue.try_pop(n) && (n == i));
+			EATEST_VERIFY(queue.try_pop(n) && (n == i + 1));
+			EATEST_VERIFY(!queue.try_pop(n));
+		}
+	}
+
+	// Test producers and consumers passing distinct values through a small queue. The
+	// threads push and pop in turn, so that they can't all wait for one another. Every
+	// value must be popped exactly once.
+	{
+		const uint32_t kCount = 100000;
+
+		mpmc_queue<uint32_t> queue(64);
+		vector<uint8_t>      seen(kCount, 0);
+		atomic<uint32_t>     nWrong(0);
+		thread_pool          pool(4);
+
+		pool.parallel_for(kCount / 100, 1, [&](size_t nBegin, size_t nEnd)
+		{
+			for (size_t r = nBegin; r < nEnd; r++)
+			{
+				uint32_t values[10];
+				uint32_t nPushed = 0, nPopped = 0;
+
+				// Pushes 100 values, 10 at a time, alternately singly and in a batch, and
+				// pops as many, which may be any threads' values.
+				for (uint32_t i = 0; i < 10; i++)
+				{
+					const uint32_t nFirst = (uint32_t)r * 100 + i * 10;
+
+					if (i % 2)
+					{
+						for (uint32_t j = 0; j < 10; j++)
+							queue.push(nFirst + j);
+					}
+					else
+					{
+						for (uint32_t j = 0; j < 10; j++)
+							values[j] = nFirst + j;
+						for (uint32_t j = 0; j < 10; )
+							j += (uint32_t)queue.push_n(span<const uint32_t>(values + j, 10 - j));
+					}
+					nPushed += 10;
+
+					while (nPopped < nPushed)
+					{
+						const eastl_size_t n = (i % 2) ? queue.pop_n(span<uint32_t>(values, nPushed - nPopped)) : (queue.pop(values[0]), 1);
+
+						for (eastl_size_t j = 0; j < n; j++)
+						{
+							if ((values[j] >= kCount) || (seen[values[j]]++ != 0)) // Each value is written by one thread.
+								nWrong++;
+						}
+						nPopped += (uint32_t)n;
+					}
+				}
+			}
+		});
+
+		EATEST_VERIFY(nWrong.load() == 0);
+		EATEST_VERIFY(queue.empty());
+
+		for (uint32_t i = 0; i < kCount; i++)
+			EATEST_VERIFY(seen[i] == 1);
+	}
+
+	return nErrorCount;
+}
@@ -0,0 +1,194 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "EASTLTest.h"
+#include <EASTL/mutex.h>
+#include <EASTL/shared_mutex.h>
+#include <EASTL/thread_pool.h>
+#include <EASTL/atomic.h>
+
+
+namespace
+{
+	// These are usable without construction, e.g. from other globals' constructors.
+	std::mutex        gMutex;
+	std::spinlock     gSpinlock;
+	std::shared_mutex gSharedMutex;
+
+
+	// Has threads increment a counter under the lock, with each thread's increments
+	// interleaved with others'. Any lost increment shows the lock didn't exclude.
+	template <typename Mutex>
+	int TestMutualExclusion(Mutex& m)
+	{
+		int nErrorCount = 0;
+
+		const size_t kCount = 200000;
+
+		std::thread_pool pool(4);
+		size_t           nCounter = 0;
+
+		pool.parallel_for(kCount, 1000, [&](size_t nBegin, size_t nEnd)
+		{
+			for (size_t i = nBegin; i < nEnd; i++)
+			{
+				std::lock_guard<Mutex> lock(m);
+				nCounter++;
+			}
+		});
+
+		EATEST_VERIFY(nCounter == kCount);
+
+		return nErrorCount;
+	}
+}
+
+
+int TestMutex()
+{
+	using namespace std;
+
+	int nErrorCount = 0;
+
+	// Test mutex and spinlock on a single thread
+	{
+		EATEST_VERIFY(gMutex.try_lock());
+		EATEST_VERIFY(!gMutex.try_lock());
+		gMutex.unlock();
+		gMutex.lock();
+		EATEST_VERIFY(!gMutex.try_lock());
+		gMutex.unlock();
+
+		EATEST_VERIFY(gSpinlock.try_lock());
+		EATEST_VERIFY(!gSpinlock.try_lock());
+		gSpinlock.unlock();
+		gSpinlock.lock();
+		EATEST_VERIFY(!gSpinlock.try_lock());
+		gSpinlock.unlock();
+	}
+
+	// Test lock_guard and unique_lock
+	{
+		mutex m;
+
+		{
+			lock_guard<mutex> lock(m);
+			EATEST_VERIFY(!m.try_lock());
+		}
+		EATEST_VERIFY(m.try_lock());
+		{
+			lock_guard<mutex> lock(m, adopt_lock);
+		}
+		EATEST_VERIFY(m.try_lock());
+		m.unlock();
+
+		unique_lock<mutex> lock1(m, defer_lock);
+		EATEST_VERIFY(!lock1.owns_lock() && (lock1.mutex() == &m));
+		lock1.lock();
+		EATEST_VERIFY(lock1.owns_lock() && lock1);
+
+		unique_lock<mutex> lock2(m, try_to_lock);
+		EATEST_VERIFY(!lock2 && (lock2.mutex() == &m));
+
+		lock1.unlock();
+		EATEST_VERIFY(lock2.try_lock());
+
+		unique_lock<mutex> lock3(std::move(lock2));
+		EATEST_VERIFY(!lock2 && (lock2.mutex() == NULL));
+		EATEST_VERIFY(lock3.owns_lock());
+
+		swap(lock1, lock3);
+		EATEST_VERIFY(lock1.owns_lock() && !lock3.owns_lock());
+
+		lock3 = std::move(lock1);
+		EATEST_VERIFY(lock3.owns_lock() && !lock1.owns_lock());
+
+		mutex* const pMutex = lock3.release();
+		EATEST_VERIFY((pMutex == &m) && !lock3 && !m.try_lock());
+
+		unique_lock<mutex> lock4(m, adopt_lock);
+		EATEST_VERIFY(lock4.owns_lock());
+	}
+
+	// Test shared_mutex and shared_lock on a single thread
+	{
+		EATEST_VERIFY(gSharedMutex.try_lock_shared());
+		EATEST_VERIFY(gSharedMutex.try_lock_shared());
+		EATEST_VERIFY(!gSharedMutex.try_lock());
+		gSharedMutex.unlock_shared();
+		EATEST_VERIFY(!gSharedMutex.try_lock());
+		gSharedMutex.unlock_shared();
+
+		EATEST_VERIFY(gSharedMutex.try_lock());
+		EATEST_VERIFY(!gSharedMutex.try_lock_shared());
+		EATEST_VERIFY(!gSharedMutex.try_lock());
+		gSharedMutex.unlock();
+
+		{
+			shared_lock<shared_mutex> lock1(gSharedMutex);
+			shared_lock<shared_mutex> lock2(gSharedMutex, try_to_lock);
+			EATEST_VERIFY(lock1 && lock2);
+
+			unique_lock<shared_mutex> writeLock(gSharedMutex, try_to_lock);
+			EATEST_VERIFY(!writeLock);
+
+			shared_lock<shared_mutex> lock3(std::move(lock2));
+			EATEST_VERIFY(!lock2 && lock3.owns_lock());
+			lock3.unlock();
+			lock1.unlock();
+
+			EATEST_VERIFY(writeLock.try_lock());
+			EATEST_VERIFY(!lock3.try_lock());
+		}
+
+		EATEST_VERIFY(gSharedMutex.try_lock());
+		gSharedMutex.unlock();
+	}
+
+	// Test that the locks exclude one another across threads
+	{
+		mutex        m;
+		spinlock     s;
+		shared_mutex sm;
+
+		nErrorCount += TestMutualExclusion(m);
+		nErrorCount += TestMutualExclusion(s);
+		nErrorCount += TestMutualExclusion(sm);
+	}
+
+	// Test readers and writers of a shared_mutex at once. Writers keep the two values
+	// equal, so a reader which sees them differ overlapped a writer.
+	{
+		shared_mutex     sm;
+		uint32_t         nValue1 = 0, nValue2 = 0;
+		atomic<uint32_t> nTorn(0);
+		thread_pool      pool(4);
+
+		pool.parallel_for(100000, 100, [&](size_t nBegin, size_t nEnd)
+		{
+			for (size_t i = nBegin; i < nEnd; i++)
+			{
+				if ((i % 16) == 0)
+				{
+					unique_lock<shared_mutex> lock(sm);
+					nValue1++;
+					nValue2++;
+				}
+				else
+				{
+					shared_lock<shared_mutex> lock(sm);
+					if (nValue1 != nValue2)
+						nTorn++;
+				}
+			}
+		});
+
+		EATEST_VERIFY(nTorn.load() == 0);
+		EATEST_VERIFY((nValue1 == 100000 / 16) && (nValue2 == nValue1));
+		EATEST_VERIFY(sm.try_lock());
+		sm.unlock();
+	}
+
+	return nErrorCount;
+}
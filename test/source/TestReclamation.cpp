@@ -0,0 +1,347 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "EASTLTest.h"
+#include <EASTL/hazard_pointer.h>
+#include <EASTL/rcu.h>
+#include <EASTL/concurrent_fixed_pool.h>
+#include <EASTL/fixed_allocator.h>
+#include <EASTL/mutex.h>
+#include <EASTL/thread_pool.h>
+#include <EASTL/atomic.h>
+
+
+namespace
+{
+	// Nodes come from a pool, so that a reader which accessed a node after it was
+	// deleted would find it marked dead rather than read freed memory.
+	const size_t kNodeSize  = 64;
+	const size_t kNodeCount = 4096;
+
+	typedef std::fixed_node_allocator<kNodeSize, kNodeCount, 16, 0, false, EASTLAllocatorType, std::concurrent_fixed_pool> NodeAllocator;
+
+	const uint32_t kAlive = 0xa11fe;
+	const uint32_t kDead  = 0xdead;
+
+	template <template <typename, typename> class ObjBase>
+	struct ReclaimNode : public ObjBase<ReclaimNode<ObjBase>, std::allocator_delete<ReclaimNode<ObjBase>, NodeAllocator> >
+	{
+		explicit ReclaimNode(uint64_t nValue, std::atomic<int>* pDestroyedCount)
+			: mnValue(nValue), mnMagic(kAlive), mpDestroyedCount(pDestroyedCount) { }
+
+		~ReclaimNode()
+		{
+			mnMagic = kDead;
+			(*mpDestroyedCount)++;
+		}
+
+		uint64_t          mnValue;
+		volatile uint32_t mnMagic;
+		std::atomic<int>* mpDestroyedCount;
+	};
+
+	typedef ReclaimNode<std::hazard_pointer_obj_base> HazardNode;
+	typedef ReclaimNode<std::rcu_obj_base>            RcuNode;
+
+	static_assert(sizeof(HazardNode) <= kNodeSize, "kNodeSize is too small.");
+	static_assert(sizeof(RcuNode) <= kNodeSize, "kNodeSize is too small.");
+
+
+	// Protects the node in a shared pointer for the duration of a reader's access.
+	struct HazardPointerReader
+	{
+		std::hazard_pointer mHazardPointer;
+
+		HazardPointerReader() : mHazardPointer(std::make_hazard_pointer()) { }
+
+		HazardNode* Enter(const std::atomic<HazardNode*>& src) { return mHazardPointer.protect(src); }
+		void        Leave()                                    { mHazardPointer.reset_protection(); }
+
+		static void Barrier() { std::hazard_pointer_reclaim(); }
+	};
+
+	struct RcuReader
+	{
+		RcuNode* Enter(const std::atomic<RcuNode*>& src) { std::rcu_default_domain().lock(); return src.load(std::memory_order_acquire); }
+		void     Leave()                                 { std::rcu_default_domain().unlock(); }
+
+		static void Barrier() { std::rcu_barrier(); }
+	};
+
+
+	// Has one thread replace the node in a shared pointer and retire the old one, while
+	// other threads read it. Readers must only ever see live nodes, and every node
+	// must be deleted, and returned to the pool, once the threads have exited. With
+	// bReleaseStore the writer unlinks the node with a release store under a mutex, as
+	// is usual for writers, rather than with an exchange, whose locked instruction would
+	// order the unlink before retire's loads by itself on x86.
+	template <typename Node, typename Reader>
+	int TestConcurrentRetire(bool bReleaseStore)
+	{
+		int nErrorCount = 0;
+
+		const uint64_t kReplaceCount = 20000;
+		const int      kReaderCount  = 3;
+		const int      kReadCount    = 20000;
+
+		char* const       pBuffer = new char[NodeAllocator::kBufferSize];
+		NodeAllocator     nodeAllocator(pBuffer);
+		std::atomic<int>  nDestroyedCount(0);
+		std::atomic<int>  nWrong(0);
+		std::atomic<Node*> pShared(::new(nodeAllocator.allocate(sizeof(Node))) Node(0, &nDestroyedCount));
+		std::mutex         writerMutex;
+
+		{
+			std::thread_pool pool(kReaderCount);
+
+			pool.parallel_invoke([&]
+			{
+				for(uint64_t i = 1; i <= kReplaceCount; i++)
+				{
+					Node* const pNode = ::new(nodeAllocator.allocate(sizeof(Node))) Node(i, &nDestroyedCount);
+					Node*       pOld;
+
+					if(bReleaseStore)
+					{
+						std::lock_guard<std::mutex> lock(writerMutex);
+						pOld = pShared.load(std::memory_order_relaxed);
+						pShared.store(pNode, std::memory_order_release);
+					}
+					else
+						pOld = pShared.exchange(pNode, std::memory_order_acq_rel);
+
+					pOld->retire(std::allocator_delete<Node, NodeAllocator>(&nodeAllocator));
+
+					if((i % 64) == 0)
+						std::Internal::thread_yield(); // Lets the readers run when the threads share a core.
+				}
+			},
+			[&]
+			{
+				pool.parallel_for(kReaderCount, 1, [&](size_t nBegin, size_t nEnd)
+				{
+					for(size_t r = nBegin; r < nEnd; r++)
+					{
+						Reader   reader;
+						uint64_t nLast = 0;
+
+						for(int i = 0; i < kReadCount; i++)
+						{
+							const Node* const pNode = reader.Enter(pShared);
+
+							if((pNode->mnMagic != kAlive) || (pNode->mnValue < nLast))
+								nWrong++;
+							nLast = pNode->mnValue;
+
+							reader.Leave();
+
+							if((i % 64) == 0)
+								std::Internal::thread_yield();
+						}
+					}
+				});
+			});
+		} // The pool's threads exit here, handing their retired nodes over.
+
+		pShared.load()->retire(std::allocator_delete<Node, NodeAllocator>(&nodeAllocator));
+		Reader::Barrier();
+
+		EATEST_VERIFY(nWrong.load() == 0);
+		EATEST_VERIFY(nDestroyedCount.load() == (int)kReplaceCount + 1);
+		EATEST_VERIFY(nodeAllocator.mPool.current_size() == 0);
+
+		delete[] pBuffer;
+		return nErrorCount;
+	}
+
+
+	struct CountingDelete
+	{
+		int* mpCount;
+
+		template <typename T>
+		void operator()(T* p) const { (*mpCount)++; delete p; }
+	};
+}
+
+
+int TestReclamation()
+{
+	using namespace std;
+
+	int nErrorCount = 0;
+
+	// Test hazard_pointer on a single thread
+	{
+		char* const   pBuffer = new char[NodeAllocator::kBufferSize];
+		NodeAllocator nodeAllocator(pBuffer);
+		atomic<int>   nDestroyedCount(0);
+
+		typedef allocator_delete<HazardNode, NodeAllocator> NodeDelete;
+
+		hazard_pointer empty;
+		EATEST_VERIFY(empty.empty());
+
+		hazard_pointer hp = make_hazard_pointer();
+		EATEST_VERIFY(!hp.empty());
+
+		hazard_pointer moved(std::move(hp));
+		EATEST_VERIFY(hp.empty() && !moved.empty());
+		swap(hp, moved);
+		EATEST_VERIFY(!hp.empty() && moved.empty());
+
+		HazardNode* const pA = ::new(nodeAllocator.allocate(sizeof(HazardNode))) HazardNode(1, &nDestroyedCount);
+		HazardNode* const pB = ::new(nodeAllocator.allocate(sizeof(HazardNode))) HazardNode(2, &nDestroyedCount);
+		atomic<HazardNode*> pShared(pA);
+
+		// A protected node survives retirement until its protection is reset.
+		EATEST_VERIFY(hp.protect(pShared) == pA);
+		pShared.store(pB);
+		pA->retire(NodeDelete(&nodeAllocator));
+		hazard_pointer_reclaim();
+		EATEST_VERIFY((nDestroyedCount.load() == 0) && (pA->mnMagic == kAlive));
+
+		hp.reset_protection();
+		hazard_pointer_reclaim();
+		EATEST_VERIFY(nDestroyedCount.load() == 1);
+
+		// try_protect fails, and reports the new value, if the pointer changed.
+		HazardNode* p = pA;
+		EATEST_VERIFY(!hp.try_protect(p, pShared) && (p == pB));
+		EATEST_VERIFY(hp.try_protect(p, pShared) && (p == pB));
+
+		// Retired nodes are reclaimed in batches as they're retired, so only a bounded
+		// number await reclamation however many are retired.
+		const int kRetireCount = 1000;
+		int       nMaxAwaiting = 0;
+
+		for(int i = 0; i < kRetireCount; i++)
+		{
+			(::new(nodeAllocator.allocate(sizeof(HazardNode))) HazardNode(3, &nDestroyedCount))->retire(NodeDelete(&nodeAllocator));
+			nMaxAwaiting = max(nMaxAwaiting, (i + 2) - nDestroyedCount.load());
+		}
+
+		EATEST_VERIFY(nMaxAwaiting <= 4 * EASTL_HAZARD_POINTER_RETIRE_THRESHOLD);
+
+		pShared.store(NULL);
+		pB->retire(NodeDelete(&nodeAllocator));
+		hazard_pointer_reclaim();
+		EATEST_VERIFY(pB->mnMagic == kAlive); // hp still protects it.
+
+		hp = hazard_pointer();
+		hazard_pointer_reclaim();
+		EATEST_VERIFY(nDestroyedCount.load() == kRetireCount + 2);
+		EATEST_VERIFY(nodeAllocator.mPool.current_size() == 0);
+
+		delete[] pBuffer;
+	}
+
+	// Test rcu on a single thread
+	{
+		char* const   pBuffer = new char[NodeAllocator::kBufferSize];
+		NodeAllocator nodeAllocator(pBuffer);
+		atomic<int>   nDestroyedCount(0);
+
+		typedef allocator_delete<RcuNode, NodeAllocator> NodeDelete;
+
+		rcu_domain& domain = rcu_default_domain();
+		EATEST_VERIFY(&domain == &rcu_default_domain());
+
+		// A node retired within a critical section outlives it, however many batches
+		// are retired after it.
+		const int kBatchedCount = 4 * EASTL_RCU_RETIRE_BATCH_SIZE;
+
+		{
+			lock_guard<rcu_domain> lock(domain);
+
+			RcuNode* const pNode = ::new(nodeAllocator.allocate(sizeof(RcuNode))) RcuNode(1, &nDestroyedCount);
+			pNode->retire(NodeDelete(&nodeAllocator));
+
+			{
+				lock_guard<rcu_domain> nested(domain);
+
+				for(int i = 0; i < kBatchedCount; i++)
+					(::new(nodeAllocator.allocate(sizeof(RcuNode))) RcuNode(1, &nDestroyedCount))->retire(NodeDelete(&nodeAllocator));
+			}
+
+			EATEST_VERIFY((nDestroyedCount.load() == 0) && (pNode->mnMagic == kAlive));
+		}
+
+		rcu_synchronize();
+		rcu_barrier();
+		EATEST_VERIFY(nDestroyedCount.load() == kBatchedCount + 1);
+
+		// Objects which don't derive from rcu_obj_base.
+		int nDeleteCount = 0;
+		CountingDelete countingDelete = { &nDeleteCount };
+
+		rcu_retire(new int(1), countingDelete);
+		rcu_retire(new int(2));
+		rcu_barrier();
+		EATEST_VERIFY(nDeleteCount == 1);
+
+		// Retired nodes are reclaimed in batches as they're retired.
+		const int kRetireCount = 1000;
+		int       nMaxAwaiting = 0;
+
+		for(int i = 0; i < kRetireCount; i++)
+		{
+			(::new(nodeAllocator.allocate(sizeof(RcuNode))) RcuNode(2, &nDestroyedCount))->retire(NodeDelete(&nodeAllocator));
+			nMaxAwaiting = max(nMaxAwaiting, (kBatchedCount + i + 2) - nDestroyedCount.load());
+		}
+
+		EATEST_VERIFY(nMaxAwaiting <= 4 * EASTL_RCU_RETIRE_BATCH_SIZE);
+
+		rcu_barrier();
+		EATEST_VERIFY(nDestroyedCount.load() == kBatchedCount + kRetireCount + 1);
+		EATEST_VERIFY(nodeAllocator.mPool.current_size() == 0);
+
+		delete[] pBuffer;
+	}
+
+	// Test that rcu_synchronize waits for a critical section entered before it.
+	#if EASTL_THREAD_POOL_AVAILABLE
+		{
+			thread_pool pool(1);
+			atomic<int> nStage(0);
+			bool        bLeft = false;
+			bool        bWaited = false;
+
+			if(CanRunBlockingTasks(pool))
+			{
+				pool.parallel_invoke([&]
+				{
+					lock_guard<rcu_domain> lock(rcu_default_domain());
+
+					nStage.store(1);
+					while(nStage.load() != 2)
+						Internal::thread_yield();
+
+					for(int i = 0; i < 100; i++) // Gives rcu_synchronize time to return early, if it would.
+						Internal::thread_yield();
+
+					bLeft = true;
+				},
+				[&]
+				{
+					while(nStage.load() != 1)
+						Internal::thread_yield();
+
+					nStage.store(2);
+					rcu_synchronize();
+					bWaited = bLeft;
+				});
+
+				EATEST_VERIFY(bWaited);
+			}
+		}
+	#endif
+
+	nErrorCount += TestConcurrentRetire<HazardNode, HazardPointerReader>(false);
+	nErrorCount += TestConcurrentRetire<HazardNode, HazardPointerReader>(true);
+	nErrorCount += TestConcurrentRetire<RcuNode, RcuReader>(false);
+	nErrorCount += TestConcurrentRetire<RcuNode, RcuReader>(true);
+
+	return nErrorCount;
+}
@@ -13,12 +13,14 @@
 #include <EASTL/intrusive_ptr.h>
 #include <EASTL/linked_array>
 #include <EASTL/linked_ptr.h>
+#include <EASTL/local_shared_ptr.h>
 #include <EASTL/safe_ptr.h>
 #include <EASTL/scoped_array>
 #include <EASTL/scoped_ptr.h>
 #include <EASTL/shared_array>
 #include <EASTL/shared_ptr.h>
 #include <EASTL/unique_ptr.h>
+#include <EASTL/vector.h>
 #include <EASTL/weak_ptr.h>
 #include <eathread/eathread_thread.h>
 
@@ -219,6 +221,21 @@ namespace SmartPtrTest
 	}
 
 
+	/// RefCounted
+	///
+	/// This is used for tests involving intrusive_ptr with intrusive_ref_counter.
+	///
+	struct RefCounted : public std::intrusive_ref_counter<RefCounted>
+	{
+		static int mCount;
+
+		RefCounted()  { ++mCount; }
+		~RefCounted() { --mCount; }
+	};
+
+	int RefCounted::mCount = 0;
+
+
 	/// ParentClass / ChildClass / GrandChildClass
 	///
 	/// This is used for tests involving shared_ptr.
@@ -1490,6 +1507,169 @@ static int Test_shared_ptr_thread()
 }
 
 
+#if EASTL_THREAD_SUPPORT_AVAILABLE
+	struct AtomicSharedPtrSnapshot
+	{
+		static std::atomic<int> sCount;
+		int mnVersion;
+		int mnCheck;
+
+		AtomicSharedPtrSnapshot(int nVersion) : mnVersion(nVersion), mnCheck(~nVersion) { ++sCount; }
+		~AtomicSharedPtrSnapshot() { mnCheck = 0; --sCount; }
+	};
+
+	struct AtomicSharedPtrTestThread : public EA::Thread::IRunnable
+	{
+		EA::Thread::Thread                                     mThread;
+		std::atomic<std::shared_ptr<AtomicSharedPtrSnapshot>>* mpSnapshot;
+		std::atomic<bool>*                                     mpShouldContinue;
+		int                                                    mnErrorCount;
+
+		AtomicSharedPtrTestThread() : mThread(), mpSnapshot(NULL), mpShouldContinue(NULL), mnErrorCount(0) {}
+		AtomicSharedPtrTestThread(const AtomicSharedPtrTestThread&){}
+		void operator=(const AtomicSharedPtrTestThread&){}
+
+		intptr_t Run(void*)
+		{
+			int& nErrorCount = mnErrorCount; // declare nErrorCount so that EATEST_VERIFY can work, as it depends on it being declared.
+			int  nLastVersion = 0;
+
+			while(mpShouldContinue->load(std::memory_order_relaxed))
+			{
+				std::shared_ptr<AtomicSharedPtrSnapshot> spSnapshot = mpSnapshot->load();
+
+				EATEST_VERIFY(spSnapshot->mnCheck == ~spSnapshot->mnVersion);
+				EATEST_VERIFY(spSnapshot->mnVersion >= nLastVersion); // The writer only moves forward.
+				nLastVersion = spSnapshot->mnVersion;
+			}
+
+			return nErrorCount;
+		}
+	};
+
+	std::atomic<int> AtomicSharedPtrSnapshot::sCount(0);
+#endif
+
+
+static int Test_atomic_shared_ptr()
+{
+	using namespace SmartPtrTest;
+	using namespace std;
+
+	int nErrorCount(0);
+
+	{
+		atomic<shared_ptr<TestObject>> aspTO;
+		EATEST_VERIFY(aspTO.is_lock_free() || !atomic<shared_ptr<TestObject>>::is_always_lock_free);
+		#if ((EA_PLATFORM_PTR_SIZE == 8) && defined(EASTL_ATOMIC_HAS_128BIT)) || ((EA_PLATFORM_PTR_SIZE == 4) && defined(EASTL_ATOMIC_HAS_64BIT))
+			// The head is a (node, count) pair, which is lock free wherever double-width CAS is.
+			EATEST_VERIFY(atomic<shared_ptr<TestObject>>::is_always_lock_free && aspTO.is_lock_free());
+		#endif
+		EATEST_VERIFY(!aspTO.load());
+
+		shared_ptr<TestObject> spTO(new TestObject(55));
+		aspTO.store(spTO);
+		EATEST_VERIFY(spTO.use_count() == 2);
+
+		shared_ptr<TestObject> spTO2 = aspTO.load(memory_order_acquire);
+		EATEST_VERIFY(spTO2 == spTO);
+		EATEST_VERIFY(spTO.use_count() == 3);
+
+		spTO2 = aspTO.exchange(make_shared<TestObject>(66));
+		EATEST_VERIFY(spTO2 == spTO);
+		EATEST_VERIFY(spTO.use_count() == 2);
+		EATEST_VERIFY(aspTO.load()->mX == 66);
+
+		// spTO isn't the stored value, so this should do no exchange and return the stored value.
+		shared_ptr<TestObject> spExpected = spTO;
+		bool result = aspTO.compare_exchange_strong(spExpected, make_shared<TestObject>(77));
+		EATEST_VERIFY(!result);
+		EATEST_VERIFY(spExpected->mX == 66);
+		EATEST_VERIFY(aspTO.load()->mX == 66);
+
+		result = aspTO.compare_exchange_weak(spExpected, spTO, memory_order_acq_rel, memory_order_acquire);
+		EATEST_VERIFY(result);
+		EATEST_VERIFY(aspTO.load() == spTO);
+		EATEST_VERIFY(spExpected.use_count() == 1);
+
+		// An empty value is stored without allocating and compares equal to a default-constructed value.
+		aspTO = nullptr;
+		EATEST_VERIFY(spTO.use_count() == 2);
+		shared_ptr<TestObject> spEmpty;
+		result = aspTO.compare_exchange_strong(spEmpty, spTO);
+		EATEST_VERIFY(result);
+		EATEST_VERIFY(spTO.use_count() == 3);
+
+		// Aliased values must compare by both the stored pointer and ownership.
+		shared_ptr<int> spInt(new int(3));
+		atomic<shared_ptr<int>> aspInt(spInt);
+		shared_ptr<int> spAlias(spInt, (int*)NULL);
+		result = aspInt.compare_exchange_strong(spAlias, shared_ptr<int>());
+		EATEST_VERIFY(!result);
+		EATEST_VERIFY(spAlias == spInt);
+	}
+
+	{
+		shared_ptr<TestObject> spTO(new TestObject(88));
+		atomic<weak_ptr<TestObject>> awpTO(spTO);
+		EATEST_VERIFY(awpTO.load().lock() == spTO);
+		EATEST_VERIFY(spTO.use_count() == 1);
+
+		weak_ptr<TestObject> wpExpected = awpTO.load();
+		bool result = awpTO.compare_exchange_strong(wpExpected, weak_ptr<TestObject>());
+		EATEST_VERIFY(result);
+		EATEST_VERIFY(awpTO.load().expired());
+	}
+
+	EATEST_VERIFY(TestObject::IsClear());
+	TestObject::Reset();
+
+	#if EASTL_THREAD_SUPPORT_AVAILABLE
+		{
+			// Readers continuously load a value which is replaced by a writer. Every value a reader 
+			// sees must be intact, and all values must be freed once the last reference is gone.
+			{
+				atomic<shared_ptr<AtomicSharedPtrSnapshot>> aspSnapshot(make_shared<AtomicSharedPtrSnapshot>(0));
+				atomic<bool>                 bShouldContinue(true);
+				AtomicSharedPtrTestThread    thread[4];
+
+				for(size_t i = 0; i < EAArrayCount(thread); i++)
+				{
+					thread[i].mpSnapshot       = &aspSnapshot;
+					thread[i].mpShouldContinue = &bShouldContinue;
+					thread[i].mThread.Begin(&thread[i]);
+				}
+
+				for(int i = 1; i <= 20000; i++)
+				{
+					if(i % 2)
+						aspSnapshot.store(make_shared<AtomicSharedPtrSnapshot>(i));
+					else
+					{
+						shared_ptr<AtomicSharedPtrSnapshot> spExpected = aspSnapshot.load();
+						EATEST_VERIFY(aspSnapshot.compare_exchange_strong(spExpected, make_shared<AtomicSharedPtrSnapshot>(i)));
+					}
+				}
+
+				bShouldContinue.store(false);
+
+				for(size_t i = 0; i < EAArrayCount(thread); i++)
+				{
+					thread[i].mThread.WaitForEnd();
+					nErrorCount += thread[i].mnErrorCount;
+				}
+
+				EATEST_VERIFY(AtomicSharedPtrSnapshot::sCount.load() == 1);
+			}
+
+			EATEST_VERIFY(AtomicSharedPtrSnapshot::sCount.load() == 0);
+		}
+	#endif
+
+	return nErrorCount;
+}
+
+
 static int Test_weak_ptr()
 {
 	using namespace SmartPtrTest;
@@ -2090,6 +2270,180 @@ static int Test_intrusive_ptr()
 		intrusive_ptr<IntrusiveParent> ap = bp;
 	}
 
+	{ // Test intrusive_ref_counter with the default (atomic) policy.
+		{
+			intrusive_ptr<RefCounted> ip1(new RefCounted);
+			EATEST_VERIFY(RefCounted::mCount == 1);
+			EATEST_VERIFY(ip1->use_count() == 1);
+
+			intrusive_ptr<RefCounted> ip2(ip1);
+			EATEST_VERIFY(ip1->use_count() == 2);
+
+			ip1.reset();
+			EATEST_VERIFY(ip2->use_count() == 1);
+			EATEST_VERIFY(RefCounted::mCount == 1);
+		}
+		EATEST_VERIFY(RefCounted::mCount == 0);
+	}
+
+	{ // Test intrusive_ptr_local_policy.
+		{
+			typedef intrusive_ptr<RefCounted, intrusive_ptr_local_policy> LocalPtr;
+
+			LocalPtr ip1(new RefCounted);
+			LocalPtr ip2(ip1);
+			LocalPtr ip3;
+			EATEST_VERIFY(RefCounted::mCount == 1);
+			EATEST_VERIFY(ip1->use_count() == 2);
+
+			ip3 = ip2;
+			EATEST_VERIFY(ip1->use_count() == 3);
+			EATEST_VERIFY(ip3 == ip1);
+
+			ip3 = new RefCounted;
+			EATEST_VERIFY(RefCounted::mCount == 2);
+			EATEST_VERIFY(ip1->use_count() == 2);
+			EATEST_VERIFY(ip3->use_count() == 1);
+
+			LocalPtr ip4(std::move(ip3));
+			EATEST_VERIFY(!ip3);
+			EATEST_VERIFY(ip4->use_count() == 1);
+
+			swap(ip1, ip4);
+			EATEST_VERIFY(ip4->use_count() == 2);
+			ip1.reset();
+			EATEST_VERIFY(RefCounted::mCount == 1);
+
+			#if !defined(EA_COMPILER_NO_TEMPLATE_ALIASES)
+				local_intrusive_ptr<RefCounted> ip5(ip4);
+				EATEST_VERIFY(ip5->use_count() == 3);
+				EATEST_VERIFY((is_same<local_intrusive_ptr<RefCounted>::policy_type, intrusive_ptr_local_policy>::value));
+			#endif
+		}
+		EATEST_VERIFY(RefCounted::mCount == 0);
+	}
+
+	return nErrorCount;
+}
+
+
+static int Test_local_shared_ptr()
+{
+	using namespace SmartPtrTest;
+	using namespace std;
+
+	int nErrorCount = 0;
+
+	{
+		local_shared_ptr<int> pT1;
+		EATEST_VERIFY(!pT1);
+		EATEST_VERIFY(pT1.use_count() == 0);
+
+		local_shared_ptr<int> pT2(new int(5));
+		EATEST_VERIFY(pT2 && (*pT2 == 5));
+		EATEST_VERIFY(pT2.unique());
+
+		pT1 = pT2;
+		EATEST_VERIFY(pT1.use_count() == 2);
+		EATEST_VERIFY(pT1 == pT2);
+
+		local_shared_ptr<int> pT3(std::move(pT1));
+		EATEST_VERIFY(!pT1);
+		EATEST_VERIFY(pT3.use_count() == 2);
+
+		pT3.reset();
+		EATEST_VERIFY(pT2.unique());
+		EATEST_VERIFY(pT3 == nullptr);
+	}
+
+	{   // Test derived to base conversions, casts and deleters.
+		EATEST_VERIFY(A::mCount == 0);
+		{
+			local_shared_ptr<B> pB(new B);
+			local_shared_ptr<A> pA(pB);
+			EATEST_VERIFY(A::mCount == 1);
+			EATEST_VERIFY(pA.use_count() == 2);
+
+			local_shared_ptr<B> pB2 = static_pointer_cast<B>(pA);
+			EATEST_VERIFY(pB2.get() == pB.get());
+			EATEST_VERIFY(pA.use_count() == 3);
+
+			#if EASTL_RTTI_ENABLED
+				local_shared_ptr<B> pB3 = dynamic_pointer_cast<B>(pA);
+				EATEST_VERIFY(pB3.get() == pB.get());
+			#endif
+
+			local_shared_ptr<A> pA2(new A, CustomDeleter());
+			EATEST_VERIFY(A::mCount == 2);
+		}
+		EATEST_VERIFY(A::mCount == 0);
+	}
+
+	{   // Test local_weak_ptr.
+		local_weak_ptr<A> pW;
+		EATEST_VERIFY(pW.expired());
+		EATEST_VERIFY(!pW.lock());
+
+		{
+			local_shared_ptr<A> pA = make_local_shared<A>('a');
+			EATEST_VERIFY(A::mCount == 1);
+
+			pW = pA;
+			EATEST_VERIFY(!pW.expired());
+			EATEST_VERIFY(pW.use_count() == 1);
+
+			local_shared_ptr<A> pA2 = pW.lock();
+			EATEST_VERIFY(pA2 && (pA2->mc == 'a'));
+			EATEST_VERIFY(pA.use_count() == 2);
+
+			local_shared_ptr<A> pA3(pW);
+			EATEST_VERIFY(pA.use_count() == 3);
+
+			local_weak_ptr<A> pW2(pW);
+			EATEST_VERIFY(!pW2.owner_before(pW) && !pW.owner_before(pW2));
+		}
+
+		EATEST_VERIFY(A::mCount == 0);
+		EATEST_VERIFY(pW.expired());
+		EATEST_VERIFY(!pW.lock());
+	}
+
+	{   // Test an object graph with parent back-pointers.
+		struct Node
+		{
+			vector<local_shared_ptr<Node> > mChildren;
+			local_weak_ptr<Node>            mParent;
+		};
+
+		local_shared_ptr<Node> pRoot = make_local_shared<Node>();
+		local_weak_ptr<Node> pWeakRoot(pRoot);
+
+		for(int i = 0; i < 4; i++)
+		{
+			local_shared_ptr<Node> pChild = make_local_shared<Node>();
+			pChild->mParent = pRoot;
+			pRoot->mChildren.push_back(pChild);
+		}
+
+		local_weak_ptr<Node> pWeakChild(pRoot->mChildren[0]);
+		EATEST_VERIFY(pRoot.unique());
+		EATEST_VERIFY(pWeakChild.lock()->mParent.lock() == pRoot);
+
+		pRoot.reset();
+		EATEST_VERIFY(pWeakRoot.expired());
+		EATEST_VERIFY(pWeakChild.expired());
+	}
+
+	{   // Test unique_ptr conversion and allocate_local_shared.
+		unique_ptr<int> pU(new int(3));
+		local_shared_ptr<int> pL(std::move(pU));
+		EATEST_VERIFY(!pU && (*pL == 3));
+
+		local_shared_ptr<int> pL2 = allocate_local_shared<int>(EASTLAllocatorType(), 4);
+		EATEST_VERIFY(pL2.unique() && (*pL2 == 4));
+		EATEST_VERIFY(hash<local_shared_ptr<int> >()(pL2) == hash<int*>()(pL2.get()));
+	}
+
 	return nErrorCount;
 }
 
@@ -2168,7 +2522,9 @@ int TestSmartPtr()
 	nErrorCount += Test_scoped_array();
 	nErrorCount += Test_shared_ptr();
 	nErrorCount += Test_shared_ptr_thread();
+	nErrorCount += Test_atomic_shared_ptr();
 	nErrorCount += Test_weak_ptr();
+	nErrorCount += Test_local_shared_ptr();
 	nErrorCount += Test_shared_array();
 	nErrorCount += Test_linked_ptr();
 	nErrorCount += Test_linked_array();
@@ -23,6 +23,10 @@
 #include <EASTL/allocator.h>
 #include <EASTL/numeric.h>
 #include <EASTL/random.h>
+#include <EASTL/parallel_sort.h>
+#include <EASTL/string.h>
+#include <EASTL/string_view.h>
+#include <EASTL/execution.h>
 #include <EABase/eahave.h>
 #include <cmath>
 
@@ -181,6 +185,64 @@ namespace std
 
 } // namespace std
 
+
+// Tests static_sort<N> with every sequence of N zeros and ones (by the 0-1 principle, a network
+// which sorts these sorts anything) and with random arrays of types on both its code paths.
+template <size_t N>
+static int TestStaticSort(EASTLTest_Rand& rng)
+{
+	using namespace std;
+
+	int nErrorCount = 0;
+	const size_t   kSize     = N ? N : 1;
+	const uint32_t kBitCount = (N <= 16) ? (uint32_t)N : 0; // Clamped, as the shift below is compiled for every N.
+
+	if(N <= 16)
+	{
+		for(uint32_t nBits = 0; nBits < (1u << kBitCount); nBits++)
+		{
+			uint8_t bytes[kSize];
+			for(size_t i = 0; i < N; i++)
+				bytes[i] = (uint8_t)((nBits >> i) & 1);
+
+			static_sort<N>(bytes);
+			EATEST_VERIFY(is_sorted(bytes, bytes + N));
+		}
+	}
+
+	for(int t = 0; t < 20; t++)
+	{
+		int        ints[kSize];
+		int        intsSorted[kSize];
+		float      floats[kSize];
+		TestObject objects[kSize];
+
+		for(size_t i = 0; i < N; i++)
+		{
+			ints[i] = intsSorted[i] = (int)rng.RandRange(-20, 20);
+			floats[i]  = (float)ints[i] / 4.f;
+			objects[i] = TestObject(ints[i]);
+		}
+
+		static_sort<N>(ints);
+		sort(intsSorted, intsSorted + N);
+		EATEST_VERIFY(equal(ints, ints + N, intsSorted));
+
+		static_sort<N>(ints, greater<int>());
+		EATEST_VERIFY(is_sorted(ints, ints + N, greater<int>()));
+
+		static_sort<N>(floats);
+		EATEST_VERIFY(is_sorted(floats, floats + N));
+
+		static_sort<N>(objects);
+		EATEST_VERIFY(is_sorted(objects, objects + N));
+		for(size_t i = 0; i < N; i++)
+			EATEST_VERIFY(objects[i].mX == intsSorted[i]);
+	}
+
+	return nErrorCount;
+}
+
 int TestSort()
 {
 	using namespace std;
@@ -296,6 +358,11 @@ int TestSort()
 				EATEST_VERIFY(is_sorted(intArray.begin(), intArray.end()));
 				EATEST_VERIFY(std::accumulate(begin(intArraySaved), end(intArraySaved), int64_t(0)) == expectedSum);
 
+				intArray = intArraySaved;
+				pdq_sort(intArray.begin(), intArray.end());
+				EATEST_VERIFY(is_sorted(intArray.begin(), intArray.end()));
+				EATEST_VERIFY(std::accumulate(begin(intArray), end(intArray), int64_t(0)) == expectedSum);
+
 				intArray = intArraySaved;
 				buffer.resize(intArray.size()/2);
 				tim_sort_buffer(intArray.begin(), intArray.end(), buffer.data());
@@ -305,6 +372,88 @@ int TestSort()
 		}
 	}
 
+	// Test pdq_sort with the input patterns it adapts to, for both its branchless and plain partitions.
+	{
+		struct CountingLess
+		{
+			int64_t* mpCount;
+			bool operator()(int a, int b) const { ++*mpCount; return a < b; }
+		};
+
+		const int kSize = 100000;
+		vector<int> patterns[6];
+
+		for(int i = 0; i < kSize; i++)
+		{
+			patterns[0].push_back(i);                                     // sorted
+			patterns[1].push_back(kSize - i);                             // reverse sorted
+			patterns[2].push_back(7);                                     // all equal
+			patterns[3].push_back((int)rng.RandLimit(4));                 // few distinct values
+			patterns[4].push_back((i < kSize / 2) ? i : (kSize - i));     // organ pipe
+			patterns[5].push_back(((i % 100) == 0) ? (int)rng.RandLimit(kSize) : i); // mostly sorted
+		}
+
+		for(eastl_size_t p = 0; p < EAArrayCount(patterns); p++)
+		{
+			vector<int> v(patterns[p]);
+			pdq_sort(v.begin(), v.end());
+			EATEST_VERIFY(is_sorted(v.begin(), v.end()));
+
+			v = patterns[p];
+			pdq_sort(v.begin(), v.end(), std::greater<int>());
+			EATEST_VERIFY(is_sorted(v.begin(), v.end(), std::greater<int>()));
+
+			int64_t nCompareCount = 0;
+			CountingLess countingLess = { &nCompareCount };
+			v = patterns[p];
+			pdq_sort(v.begin(), v.end(), countingLess);
+			EATEST_VERIFY(is_sorted(v.begin(), v.end()));
+
+			if(p <= 3) // These patterns are sorted in linear time.
+				EATEST_VERIFY(nCompareCount < (4 * kSize));
+		}
+
+		// Killer input for median of 3: rising values at the sample positions.
+		vector<int> v(kSize);
+		for(int i = 0; i < kSize; i++)
+			v[i] = (i % 2) ? (kSize / 2 + i) : i;
+		pdq_sort(v.begin(), v.end());
+		EATEST_VERIFY(is_sorted(v.begin(), v.end()));
+
+		vector<double> doubles(kSize);
+		for(int i = 0; i < kSize; i++)
+			doubles[i] = (double)rng.RandLimit(1000) / 7.0;
+		sort(doubles.begin(), doubles.end());
+		EATEST_VERIFY(is_sorted(doubles.begin(), doubles.end()));
+	}
+
+	{
+		// void static_sort<N>(RandomAccessIterator first)
+		// void static_sort<N>(RandomAccessIterator first, Compare compare)
+
+		nErrorCount += TestStaticSort< 0>(rng) + TestStaticSort< 1>(rng) + TestStaticSort< 2>(rng) + TestStaticSort< 3>(rng);
+		nErrorCount += TestStaticSort< 4>(rng) + TestStaticSort< 5>(rng) + TestStaticSort< 6>(rng) + TestStaticSort< 7>(rng);
+		nErrorCount += TestStaticSort< 8>(rng) + TestStaticSort< 9>(rng) + TestStaticSort<10>(rng) + TestStaticSort<11>(rng);
+		nErrorCount += TestStaticSort<12>(rng) + TestStaticSort<13>(rng) + TestStaticSort<16>(rng) + TestStaticSort<17>(rng);
+		nErrorCount += TestStaticSort<23>(rng) + TestStaticSort<24>(rng) + TestStaticSort<31>(rng) + TestStaticSort<32>(rng);
+
+		// Equivalent but distinguishable values are kept, not duplicated.
+		float zeros[2] = { 0.f, -0.f };
+		static_sort<2>(zeros);
+		EATEST_VERIFY(signbit(zeros[0]) != signbit(zeros[1]));
+
+		// pdq_sort finishes small partitions with these networks.
+		vector<uint16_t> v;
+		for(int i = 0; i < 10000; i++)
+			v.push_back((uint16_t)rng.RandLimit((i % 2) ? 100 : 65535));
+		for(eastl_size_t i = 0; i < v.size(); i += 23)
+		{
+			vector<uint16_t> w(v.begin(), v.begin() + i);
+			pdq_sort(w.begin(), w.end());
+			EATEST_VERIFY(is_sorted(w.begin(), w.end()));
+		}
+	}
+
 	// Test tim sort with a specific array size and seed that caused a crash 
 	{
 		vector<int64_t> intArray;
@@ -395,6 +544,10 @@ int TestSort()
 				quick_sort(toArray.begin(), toArray.end());
 				EATEST_VERIFY(is_sorted(toArray.begin(), toArray.end()));
 
+				toArray = toArraySaved;
+				pdq_sort(toArray.begin(), toArray.end());
+				EATEST_VERIFY(is_sorted(toArray.begin(), toArray.end()));
+
 				toArray = toArraySaved;
 				vector<TestObject> buffer(toArray.size()/2);
 				tim_sort_buffer(toArray.begin(), toArray.end(), buffer.data());
@@ -670,6 +823,100 @@ int TestSort()
 
 	}
 
+	{
+		// void radix_sort(RandomAccessIterator first, RandomAccessIterator last, RandomAccessIterator buffer, ExtractKey extractKey)
+		// void radix_sort(RandomAccessIterator first, RandomAccessIterator last, RandomAccessIterator buffer)
+		// void radix_sort_by_key(KeyIterator keyFirst, KeyIterator keyLast, ValueIterator valueFirst, KeyIterator keyBuffer, ValueIterator valueBuffer)
+		// void radix_argsort(RandomAccessIterator first, RandomAccessIterator last, IndexIterator result, ExtractKey extractKey)
+
+		{   // Signed and floating point keys.
+			int32_t input[] = { 5, -3, 0, 2147483647, -2147483647 - 1, -1, 1, -200000, 200000 };
+			int32_t buffer[EAArrayCount(input)];
+			radix_sort(begin(input), end(input), buffer);
+			EATEST_VERIFY(is_sorted(begin(input), end(input)));
+
+			int8_t input8[] = { 5, -3, 0, 127, -128, -1, 1, -100, 100 };
+			int8_t buffer8[EAArrayCount(input8)];
+			radix_sort(begin(input8), end(input8), buffer8);
+			EATEST_VERIFY(is_sorted(begin(input8), end(input8)));
+
+			float inputF[] = { 1.5f, -0.0f, -1.5f, 0.0f, 1e30f, -1e30f, -INFINITY, INFINITY, 1e-40f, -1e-40f, 3.0f, -3.0f };
+			float bufferF[EAArrayCount(inputF)];
+			radix_sort(begin(inputF), end(inputF), bufferF);
+			EATEST_VERIFY(is_sorted(begin(inputF), end(inputF)));
+			EATEST_VERIFY(signbit(inputF[5]) && !signbit(inputF[6])); // -0.0 orders before +0.0.
+
+			double inputD[] = { 1.5, -0.5, -1.5, 0.0, 1e300, -1e300, -INFINITY, INFINITY, 2.0, -2.0 };
+			double bufferD[EAArrayCount(inputD)];
+			radix_sort(begin(inputD), end(inputD), bufferD);
+			EATEST_VERIFY(is_sorted(begin(inputD), end(inputD)));
+		}
+
+		struct RadixSortPair
+		{
+			int64_t  mKey;
+			uint32_t mPosition;
+		};
+
+		const eastl_size_t kSizes[] = { 0, 1, 2, 100, 4099, 65536 + 17 }; // The last uses 11 bit digits.
+
+		for(eastl_size_t s = 0; s < EAArrayCount(kSizes); s++)
+		{
+			for(int64_t nKeyRange = 3; nKeyRange != 0; nKeyRange = (nKeyRange < 0x100000) ? (nKeyRange * 4096) : 0)
+			{
+				const int64_t nBase = (int64_t)0x0123456700000000 - (nKeyRange / 2); // Keys of both signs which share their high bits.
+
+				vector<RadixSortPair> saved(kSizes[s]);
+				for(eastl_size_t i = 0; i < saved.size(); i++)
+				{
+					saved[i].mKey      = nBase + (int64_t)rng.RandLimit((uint32_t)nKeyRange);
+					saved[i].mPosition = (uint32_t)i;
+					if(i & 1)
+						saved[i].mKey = -saved[i].mKey;
+				}
+
+				auto extractKey = [](const RadixSortPair& x) { return x.mKey; };
+				auto stableLess = [](const RadixSortPair& a, const RadixSortPair& b) { return (a.mKey != b.mKey) ? (a.mKey < b.mKey) : (a.mPosition < b.mPosition); };
+
+				vector<RadixSortPair> v(saved), buffer(saved.size());
+				radix_sort(v.begin(), v.end(), buffer.begin(), extractKey);
+				EATEST_VERIFY(is_sorted(v.begin(), v.end(), stableLess));
+
+				vector<int64_t>  keys(saved.size()), keyBuffer(saved.size());
+				vector<uint32_t> values(saved.size()), valueBuffer(saved.size());
+				for(eastl_size_t i = 0; i < saved.size(); i++)
+				{
+					keys[i]   = saved[i].mKey;
+					values[i] = saved[i].mPosition;
+				}
+
+				radix_sort_by_key(keys.begin(), keys.end(), values.begin(), keyBuffer.begin(), valueBuffer.begin());
+				bool bMatch = true;
+				for(eastl_size_t i = 0; i < v.size(); i++)
+					bMatch = bMatch && (keys[i] == v[i].mKey) && (values[i] == v[i].mPosition);
+				EATEST_VERIFY(bMatch);
+
+				vector<uint32_t> order(saved.size());
+				radix_argsort(saved.begin(), saved.end(), order.begin(), extractKey);
+				EATEST_VERIFY(order == values);
+			}
+		}
+
+		{   // Non-trivial elements.
+			TestObject::Reset();
+			{
+				vector<TestObject> toArray, toBuffer(2000);
+				for(int i = 0; i < 2000; i++)
+					toArray.push_back(TestObject((int)rng.RandLimit(1000) - 500));
+
+				radix_sort(toArray.begin(), toArray.end(), toBuffer.begin(), [](const TestObject& x) { return x.mX; });
+				EATEST_VERIFY(is_sorted(toArray.begin(), toArray.end()));
+			}
+			EATEST_VERIFY(TestObject::IsClear());
+			TestObject::Reset();
+		}
+	}
+
 	{
 		// void bucket_sort(ForwardIterator first, ForwardIterator last, ContainerArray& bucketArray, HashFunction hash)
 
@@ -685,6 +932,55 @@ int TestSort()
 	}
 
 
+	{
+		// void string_sort(RandomAccessIterator first, RandomAccessIterator last)
+
+		const eastl_size_t kSizes[] = { 0, 1, 2, 16, 17, 129, 5000 };
+		const char* const  kPrefixes[] = { "", "a", "ab", "abcdefgh", "abcdefghijklmnop", "abcdefghijklmnopq", "\xff\x80", "z" };
+
+		for(eastl_size_t s = 0; s < EAArrayCount(kSizes); s++)
+		{
+			// Strings which share prefixes of various lengths, including across the 8 byte keys, and many duplicates.
+			vector<string> strings(kSizes[s]);
+			for(eastl_size_t i = 0; i < strings.size(); i++)
+			{
+				strings[i] = kPrefixes[rng.RandLimit(EAArrayCount(kPrefixes))];
+				for(uint32_t j = 0, jEnd = rng.RandLimit(4); j < jEnd; j++)
+					strings[i].push_back((char)("ab\0\xfe"[rng.RandLimit(4)]));
+			}
+
+			vector<string> stringsSorted(strings);
+			sort(stringsSorted.begin(), stringsSorted.end());
+
+			vector<string> v(strings);
+			string_sort(v.begin(), v.end());
+			EATEST_VERIFY(v == stringsSorted);
+
+			vector<string_view> views(strings.begin(), strings.end());
+			string_sort(views.begin(), views.end());
+			EATEST_VERIFY(equal(views.begin(), views.end(), stringsSorted.begin()));
+
+			vector<const char*> pointers;
+			for(eastl_size_t i = 0; i < strings.size(); i++)
+			{
+				if(strings[i].find('\0') == string::npos)
+					pointers.push_back(strings[i].c_str());
+			}
+			string_sort(pointers.begin(), pointers.end());
+			EATEST_VERIFY(is_sorted(pointers.begin(), pointers.end(), [](const char* a, const char* b) { return strcmp(a, b) < 0; }));
+
+			vector<u32string> wideStrings(strings.size());
+			for(eastl_size_t i = 0; i < strings.size(); i++)
+			{
+				for(eastl_size_t j = 0; j < strings[i].size(); j++)
+					wideStrings[i].push_back((char32_t)(uint8_t)strings[i][j] * 0x01010101u);
+			}
+			string_sort(wideStrings.begin(), wideStrings.end());
+			EATEST_VERIFY(is_sorted(wideStrings.begin(), wideStrings.end()));
+		}
+	}
+
+
 	{ 
 		// stable_sort general test
 		typedef std::less<int> IntCompare;
@@ -886,6 +1182,154 @@ int TestSort()
 		test_stable_sort(list<uint16_t>(),   0);	// Test stable_partition on bidirectional iterator (not random access)
 	}
 
+	{
+		// void parallel_sort(thread_pool& pool, RandomAccessIterator first, RandomAccessIterator last, Compare compare)
+		// void parallel_stable_sort(thread_pool& pool, RandomAccessIterator first, RandomAccessIterator last, Compare compare)
+		// void sort(ExecutionPolicy&& policy, RandomAccessIterator first, RandomAccessIterator last)
+		// void stable_sort(ExecutionPolicy&& policy, RandomAccessIterator first, RandomAccessIterator last, Compare compare)
+		struct ParallelSortObj
+		{
+			uint32_t mKey;
+			uint32_t mPosition;
+		};
+
+		struct ParallelSortKeyLess
+		{
+			bool operator()(const ParallelSortObj& a, const ParallelSortObj& b) const
+				{ return a.mKey < b.mKey; }
+		};
+
+		struct ParallelSortStableLess
+		{
+			bool operator()(const ParallelSortObj& a, const ParallelSortObj& b) const
+				{ return (a.mKey != b.mKey) ? (a.mKey < b.mKey) : (a.mPosition < b.mPosition); }
+		};
+
+		thread_pool pool(3);
+		const execution::parallel_policy par = execution::par.on(pool).with_grain_size(64);
+		const eastl_size_t kSizes[] = { 0, 1, 100, 1000, 4099, 65536 + 17, 200000 };
+
+		for(eastl_size_t s = 0; s < EAArrayCount(kSizes); s++)
+		{
+			for(uint32_t nKeyRange = 2; nKeyRange != 0; nKeyRange = (nKeyRange < 0x10000) ? (nKeyRange * 256) : 0) // Many duplicates through few.
+			{
+				vector<ParallelSortObj> saved(kSizes[s]);
+				for(eastl_size_t i = 0; i < saved.size(); i++)
+				{
+					saved[i].mKey      = (uint32_t)rng.RandLimit(nKeyRange);
+					saved[i].mPosition = (uint32_t)i;
+				}
+
+				vector<ParallelSortObj> v(saved);
+				std::sort(par, v.begin(), v.end(), ParallelSortKeyLess());
+				EATEST_VERIFY(is_sorted(v.begin(), v.end(), ParallelSortKeyLess()));
+
+				vector<uint32_t> positions(v.size());
+				for(eastl_size_t i = 0; i < v.size(); i++)
+					positions[i] = v[i].mPosition;
+				sort(positions.begin(), positions.end());
+				EATEST_VERIFY(adjacent_find(positions.begin(), positions.end()) == positions.end()); // Every element is still present once.
+
+				v = saved;
+				std::stable_sort(par, v.begin(), v.end(), ParallelSortKeyLess());
+				EATEST_VERIFY(is_sorted(v.begin(), v.end(), ParallelSortStableLess()));
+
+				v = saved;
+				parallel_stable_sort(pool, v.begin(), v.end(), ParallelSortKeyLess());
+				EATEST_VERIFY(is_sorted(v.begin(), v.end(), ParallelSortStableLess()));
+			}
+
+			vector<int> intArray(kSizes[s]);
+			generate(intArray.begin(), intArray.end(), rng);
+
+			vector<int> intArraySorted(intArray);
+			sort(intArraySorted.begin(), intArraySorted.end());
+
+			vector<int> v(intArray);
+			parallel_sort(pool, v.begin(), v.end(), std::less<int>());
+			EATEST_VERIFY(v == intArraySorted);
+
+			v = intArray;
+			std::sort(par, v.begin(), v.end());
+			EATEST_VERIFY(v == intArraySorted);
+
+			v = intArray;
+			std::sort(execution::seq, v.begin(), v.end());
+			EATEST_VERIFY(v == intArraySorted);
+
+			std::reverse(v.begin(), v.end());
+			parallel_sort(v.begin(), v.end());
+			EATEST_VERIFY(v == intArraySorted);
+
+			parallel_stable_sort(v.begin(), v.end(), std::greater<int>());
+			EATEST_VERIFY(is_sorted(v.begin(), v.end(), std::greater<int>()));
+		}
+
+		{   // Non-trivial elements.
+			TestObject::Reset();
+			{
+				vector<TestObject> toArray;
+				for(int i = 0; i < 50000; i++)
+					toArray.push_back(TestObject((int)rng.RandLimit(1000)));
+
+				vector<TestObject> toArray2(toArray);
+
+				std::sort(par, toArray.begin(), toArray.end());
+				EATEST_VERIFY(is_sorted(toArray.begin(), toArray.end()));
+
+				std::stable_sort(par, toArray2.begin(), toArray2.end());
+				EATEST_VERIFY(toArray == toArray2);
+			}
+			EATEST_VERIFY(TestObject::IsClear());
+			TestObject::Reset();
+		}
+	}
+
+	{
+		// void parallel_radix_sort(thread_pool& pool, RandomAccessIterator first, RandomAccessIterator last, RandomAccessIterator buffer, ExtractKey extractKey)
+		struct RadixSortPair
+		{
+			uint64_t mKey;
+			uint32_t mPosition;
+		};
+
+		auto extractKey = [](const RadixSortPair& x) { return x.mKey; };
+		auto stableLess = [](const RadixSortPair& a, const RadixSortPair& b) { return (a.mKey != b.mKey) ? (a.mKey < b.mKey) : (a.mPosition < b.mPosition); };
+
+		thread_pool pool(3);
+		thread_pool inlinePool(0);
+		const eastl_size_t kCount = EASTL_PARALLEL_RADIX_SORT_THRESHOLD + 1000;
+
+		// Timestamp-like keys which share their high bits, keys which differ only in their
+		// lowest bits, and keys which are all equal.
+		const uint64_t kKeyRanges[] = { 0x100000000, 1000, 4, 1 };
+
+		for(eastl_size_t r = 0; r < EAArrayCount(kKeyRanges); r++)
+		{
+			vector<RadixSortPair> saved(kCount);
+			for(eastl_size_t i = 0; i < saved.size(); i++)
+			{
+				saved[i].mKey      = UINT64_C(0x16d0000000000000) + (((uint64_t)rng.Rand() << 16) % kKeyRanges[r]);
+				saved[i].mPosition = (uint32_t)i;
+			}
+
+			vector<RadixSortPair> v(saved), buffer(saved.size());
+			parallel_radix_sort(pool, v.begin(), v.end(), buffer.begin(), extractKey);
+			EATEST_VERIFY(is_sorted(v.begin(), v.end(), stableLess));
+
+			v = saved;
+			parallel_radix_sort(inlinePool, v.begin(), v.end(), buffer.begin(), extractKey);
+			EATEST_VERIFY(is_sorted(v.begin(), v.end(), stableLess));
+		}
+
+		vector<float> floatArray(kCount), floatBuffer(kCount);
+		for(eastl_size_t i = 0; i < floatArray.size(); i++)
+			floatArray[i] = (float)(int32_t)rng.Rand() / 1000.f;
+
+		parallel_radix_sort(floatArray.begin(), floatArray.end(), floatBuffer.begin());
+		EATEST_VERIFY(is_sorted(floatArray.begin(), floatArray.end()));
+	}
+
 	#if 0 // Disabled because it takes a long time and thus far seems to show no bug in quick_sort.
 	{
 		// Regression of Coverity report for Madden 2014 that quick_sort is reading beyond an array bounds within insertion_sort_simple.
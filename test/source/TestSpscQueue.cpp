@@ -0,0 +1,146 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "EASTLTest.h"
+#include <EASTL/spsc_queue.h>
+#include <EASTL/thread_pool.h>
+#include <EASTL/atomic.h>
+
+
+int TestSpscQueue()
+{
+	using namespace std;
+
+	int nErrorCount = 0;
+
+	// Test the operations on a single thread
+	{
+		TestObject::Reset();
+
+		{
+			spsc_queue<TestObject> queue(5);
+			TestObject             object;
+
+			EATEST_VERIFY(queue.capacity() == 8);
+			EATEST_VERIFY(queue.empty() && !queue.full());
+			EATEST_VERIFY(queue.front() == NULL);
+			EATEST_VERIFY(!queue.try_pop(object));
+
+			for (int i = 0; i < 8; i++)
+				EATEST_VERIFY(queue.try_emplace(i));
+
+			EATEST_VERIFY(queue.full() && (queue.size() == 8));
+			EATEST_VERIFY(!queue.try_push(TestObject(8)));
+			EATEST_VERIFY(TestObject::sTOCount == 9);
+
+			EATEST_VERIFY(queue.front()->mX == 0);
+			queue.pop();
+			EATEST_VERIFY(queue.try_pop(object) && (object.mX == 1));
+			EATEST_VERIFY(queue.size() == 6);
+
+			// Push a batch which wraps around the end of the ring, and only partly fits.
+			const TestObject batch[4] = { TestObject(8), TestObject(9), TestObject(10), TestObject(11) };
+			EATEST_VERIFY(queue.push_n(batch) == 2);
+			EATEST_VERIFY(queue.push_n(span<const TestObject>()) == 0);
+			EATEST_VERIFY(queue.full());
+
+			TestObject results[5];
+			EATEST_VERIFY(queue.pop_n(results) == 5);
+			for (int i = 0; i < 5; i++)
+				EATEST_VERIFY(results[i].mX == i + 2);
+
+			EATEST_VERIFY(queue.pop_n(results) == 3);
+			EATEST_VERIFY((results[0].mX == 7) && (results[1].mX == 8) && (results[2].mX == 9));
+			EATEST_VERIFY(queue.empty());
+
+			// The queue destroys the elements it still holds.
+			EATEST_VERIFY(queue.push_n(batch) == 4);
+		}
+
+		EATEST_VERIFY(TestObject::IsClear());
+		TestObject::Reset();
+	}
+
+	// Test fixed_spsc_queue, which has a capacity of one
+	{
+		fixed_spsc_queue<int, 1> queue;
+		int                      n = 0;
+
+		EATEST_VERIFY(queue.capacity() == 1);
+		EATEST_VERIFY(queue.try_push(1));
+		EATEST_VERIFY(!queue.try_push(2));
+		EATEST_VERIFY(queue.try_pop(n) && (n == 1));
+		EATEST_VERIFY(queue.try_push(3));
+		EATEST_VERIFY(queue.try_pop(n) && (n == 3));
+		EATEST_VERIFY(!queue.try_pop(n));
+	}
+
+	// Test a producer and a consumer thread passing a sequence through the queue,
+	// singly on one side and in batches on the other.
+	#if EASTL_THREAD_POOL_AVAILABLE
+		{
+			const uint32_t kCount = 100000;
+
+			for (int nTest = 0; nTest < 2; nTest++)
+			{
+				fixed_spsc_queue<uint32_t, 1024> queue;
+				atomic<uint32_t>                 nWrong(0);
+				thread_pool                      pool(1);
+
+				if (CanRunBlockingTasks(pool)) // The producer waits for the consumer once the queue is full.
+				{
+					pool.parallel_invoke([&]
+					{
+						uint32_t values[16];
+
+						for (uint32_t i = 0; i < kCount; )
+						{
+							if (nTest == 0)
+							{
+								if (queue.try_push(i))
+									i++;
+							}
+							else
+							{
+								const uint32_t nBatch = ((kCount - i) < 16) ? (kCount - i) : 16;
+
+								for (uint32_t j = 0; j < nBatch; j++)
+									values[j] = i + j;
+								i += (uint32_t)queue.push_n(span<const uint32_t>(values, nBatch));
+							}
+						}
+					},
+					[&]
+					{
+						uint32_t values[16];
+						uint32_t nExpected = 0;
+
+						while (nExpected < kCount)
+						{
+							if (nTest == 1)
+							{
+								uint32_t n;
+								if (queue.try_pop(n) && (n != nExpected++))
+									nWrong++;
+							}
+							else
+							{
+								for (eastl_size_t j = 0, jEnd = queue.pop_n(values); j < jEnd; j++)
+								{
+									if (values[j] != nExpected++)
+										nWrong++;
+								}
+							}
+						}
+					});
+
+					EATEST_VERIFY(nWrong.load() == 0);
+					EATEST_VERIFY(queue.empty());
+				}
+			}
+		}
+	#endif
+
+	return nErrorCount;
+}
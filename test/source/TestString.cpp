@@ -7,6 +7,7 @@
 #include <EAStdC/EAMemory.h>
 #include <EAStdC/EAString.h>
 #include <EASTL/string.h>
+#include <EASTL/utf.h>
 #include <EASTL/algorithm>
 #include <EASTL/allocator_malloc.h>
 
@@ -39,6 +40,230 @@ static_assert(false, "Building with char8_t tests enabled, but EA_CHAR8_UNIQUE e
 #define LITERAL(x) EA_CHAR32(x)
 #include "TestString.inl"
 
+// Tests the searches of long char strings, which use the SIMD kernels (see internal/simd.h) on 
+// some platforms, against the generic algorithms, at every position of their last vector.
+static int TestStringSearch()
+{
+	using namespace std;
+
+	int nErrorCount = 0;
+	EASTLTest_Rand rng(EA::UnitTest::GetRandSeed());
+
+	for(int nPass = 0; nPass < 2; nPass++)
+	{
+		#if EASTL_SIMD_ENABLED
+			const int nSavedFeatures = Internal::simd_set_features(nPass ? 0 : ~0); // The widest vectors, then SSE2.
+		#endif
+
+		for(int nTrial = 0; nTrial < 2000; nTrial++)
+		{
+			const eastl_size_t nLength  = rng.RandRange(32, 200);
+			const char         cLast    = (char)('a' + rng.RandLimit((nTrial % 4) + 1)); // Small alphabets make near misses common.
+			const bool         bAllBits = (nTrial % 5) == 0;
+
+			string text, pattern, set;
+			for(eastl_size_t i = 0; i < nLength; i++)
+				text.push_back(bAllBits ? (char)rng.RandLimit(256) : (char)rng.RandRange('a', cLast + 1));
+			for(eastl_size_t i = 0, iEnd = rng.RandRange(2, 8); i < iEnd; i++)
+				pattern.push_back(bAllBits ? (char)rng.RandLimit(256) : (char)rng.RandRange('a', cLast + 1));
+			for(eastl_size_t i = 0, iEnd = rng.RandLimit(40); i < iEnd; i++)
+				set.push_back(bAllBits ? (char)rng.RandLimit(256) : (char)rng.RandRange('a', cLast + 2));
+			if(rng.RandLimit(2))
+				text.replace(rng.RandLimit(nLength - pattern.size()), pattern.size(), pattern);
+
+			const char* const pBegin = text.data();
+			const char* const pEnd   = text.data() + text.size();
+			const string_view view(text);
+
+			eastl_size_t nExpected = (eastl_size_t)(search(pBegin, pEnd, pattern.begin(), pattern.end()) - pBegin);
+			if(nExpected == nLength)
+				nExpected = string::npos;
+			EATEST_VERIFY(text.find(pattern) == nExpected);
+			EATEST_VERIFY(view.find(pattern.data(), 0, pattern.size()) == nExpected);
+
+			nExpected = (eastl_size_t)(find_end(pBegin, pEnd, pattern.begin(), pattern.end()) - pBegin);
+			if(nExpected == nLength)
+				nExpected = string::npos;
+			EATEST_VERIFY(text.rfind(pattern) == nExpected);
+			EATEST_VERIFY(view.rfind(pattern.data(), string_view::npos, pattern.size()) == nExpected);
+
+			nExpected = (eastl_size_t)(find_first_of(pBegin, pEnd, set.begin(), set.end()) - pBegin);
+			if(nExpected == nLength)
+				nExpected = string::npos;
+			EATEST_VERIFY(text.find_first_of(set.data(), 0, set.size()) == nExpected);
+			EATEST_VERIFY(view.find_first_of(set.data(), 0, set.size()) == nExpected);
+
+			nExpected = (eastl_size_t)(find_if(pBegin, pEnd, [&](char c) { return set.find(c) == string::npos; }) - pBegin);
+			if(nExpected == nLength)
+				nExpected = string::npos;
+			EATEST_VERIFY(text.find_first_not_of(set.data(), 0, set.size()) == nExpected);
+
+			nExpected = string::npos;
+			for(eastl_size_t i = nLength; i-- > 0; )
+			{
+				if(set.find(text[i]) != string::npos)
+					{ nExpected = i; break; }
+			}
+			EATEST_VERIFY(text.find_last_of(set.data(), string::npos, set.size()) == nExpected);
+
+			nExpected = string::npos;
+			for(eastl_size_t i = nLength; i-- > 0; )
+			{
+				if(set.find(text[i]) == string::npos)
+					{ nExpected = i; break; }
+			}
+			EATEST_VERIFY(text.find_last_not_of(set.data(), string::npos, set.size()) == nExpected);
+
+			nExpected = string::npos;
+			for(eastl_size_t i = nLength; i-- > 0; )
+			{
+				if(text[i] == pattern[0])
+					{ nExpected = i; break; }
+			}
+			EATEST_VERIFY(text.rfind(pattern[0]) == nExpected);
+
+			u16string wide;
+			for(eastl_size_t i = 0; i < nLength; i++)
+				wide.push_back((char16_t)(uint8_t)text[i]);
+			u16string wideOther(wide);
+			const eastl_size_t nChanged = rng.RandLimit(nLength);
+			wideOther[nChanged] = (char16_t)(wideOther[nChanged] ^ 0x8001);
+			EATEST_VERIFY(wide.compare(u16string(wide)) == 0);
+			EATEST_VERIFY((wide.compare(wideOther) < 0) == (wide[nChanged] < wideOther[nChanged]));
+		}
+
+		#if EASTL_SIMD_ENABLED
+			Internal::simd_set_features(nSavedFeatures);
+		#endif
+	}
+
+	return nErrorCount;
+}
+
+
+// Tests the UTF validation and conversion functions (see utf.h), and append_convert, which uses
+// them, with text long enough for the SIMD kernels, and with each kind of invalid text.
+static int TestStringUtf()
+{
+	using namespace std;
+
+	int nErrorCount = 0;
+	EASTLTest_Rand rng(EA::UnitTest::GetRandSeed());
+
+	{   // Each rule of validity, with the replacement append_convert makes for invalid text.
+		EATEST_VERIFY( utf8_validate("\xc2\x80\xdf\xbf\xe0\xa0\x80\xed\x9f\xbf\xee\x80\x80\xf0\x90\x80\x80\xf4\x8f\xbf\xbf", 21));
+		EATEST_VERIFY(!utf8_validate("\xc0\xaf", 2));         // Overlong
+		EATEST_VERIFY(!utf8_validate("\xe0\x9f\xbf", 3));     // Overlong
+		EATEST_VERIFY(!utf8_validate("\xf0\x8f\xbf\xbf", 4)); // Overlong
+		EATEST_VERIFY(!utf8_validate("\xed\xa0\x80", 3));     // Surrogate
+		EATEST_VERIFY(!utf8_validate("\xf4\x90\x80\x80", 4)); // Above 0x10FFFF
+		EATEST_VERIFY(!utf8_validate("\xe2\x82", 2));         // Truncated
+		EATEST_VERIFY(!utf8_validate("\x80", 1));             // Unexpected continuation
+		EATEST_VERIFY(!utf8_validate("\xff", 1));
+
+		const char16_t pPair[] = { 0xd83d, 0xde00 };
+		const char16_t pLone[] = { 'a', 0xd83d, 'b', 0xde00 };
+		EATEST_VERIFY( utf16_validate(pPair, 2));
+		EATEST_VERIFY(!utf16_validate(pPair, 1));
+		EATEST_VERIFY(!utf16_validate(pPair + 1, 1));
+		EATEST_VERIFY(!utf16_validate(pLone, 4));
+
+		const char32_t pValid[] = { 0x10ffff, 0xe000, 0xd7ff };
+		const char32_t pSurrogate[] = { 0xdfff };
+		const char32_t pLarge[] = { 0x110000 };
+		EATEST_VERIFY( utf32_validate(pValid, 3));
+		EATEST_VERIFY(!utf32_validate(pSurrogate, 1));
+		EATEST_VERIFY(!utf32_validate(pLarge, 1));
+
+		u32string s32;
+		s32.append_convert(pLone, 4);
+		EATEST_VERIFY(s32 == U"a\xffff" "b\xffff");
+		s32.assign_convert("a\xe2\x82z\xf0\x9f\x98\x80", 8);
+		EATEST_VERIFY(s32 == U"a\xffff\xffffz\x1f600");
+
+		string s8;
+		s8.append_convert(pPair, 2);
+		EATEST_VERIFY(s8 == "\xf0\x9f\x98\x80");
+		s8.assign_convert(pLarge, 1);
+		EATEST_VERIFY(s8 == "\xef\xbf\xbf");
+
+		char16_t pDest[4] = { 1, 1, 1, 1 };
+		EATEST_VERIFY(utf8_to_utf16("a\xc0\xaf", 3, pDest) == 0);
+		EATEST_VERIFY(pDest[0] == 1);
+	}
+
+	// Random text, of mostly ASCII or of mostly other code points, converted through each encoding.
+	for(int nPass = 0; nPass < 2; nPass++)
+	{
+		#if EASTL_SIMD_ENABLED
+			const int nSavedFeatures = Internal::simd_set_features(nPass ? 0 : ~0); // The widest vectors, then SSE2.
+		#endif
+
+		for(int nTrial = 0; nTrial < 500; nTrial++)
+		{
+			const eastl_size_t nLength = rng.RandRange(0, 300);
+			const uint32_t     nAscii  = (nTrial % 3) ? 95 : 30; // Percentage of code points which are ASCII.
+
+			u32string s32;
+			for(eastl_size_t i = 0; i < nLength; i++)
+			{
+				const uint32_t nKind = rng.RandLimit(100);
+
+				if(nKind < nAscii)
+					s32.push_back((char32_t)rng.RandLimit(0x80));
+				else if(nKind < nAscii + (100 - nAscii) / 3)
+					s32.push_back((char32_t)rng.RandRange(0x80, 0x800));
+				else if(nKind < nAscii + 2 * (100 - nAscii) / 3)
+					s32.push_back((char32_t)rng.RandRange(0xe000, 0x10000));
+				else
+					s32.push_back((char32_t)rng.RandRange(0x10000, 0x110000));
+			}
+
+			EATEST_VERIFY(utf32_validate(s32.data(), s32.size()));
+
+			string s8;
+			s8.resize(utf8_length_from_utf32(s32.data(), s32.size()));
+			EATEST_VERIFY(utf32_to_utf8(s32.data(), s32.size(), s8.data()) == s8.size());
+			EATEST_VERIFY(utf8_validate(s8.data(), s8.size()));
+
+			u16string s16;
+			s16.append_convert(s8);
+			EATEST_VERIFY(s16.size() == utf16_length_from_utf8(s8.data(), s8.size()));
+			EATEST_VERIFY(s16.size() == utf16_length_from_utf32(s32.data(), s32.size()));
+			EATEST_VERIFY(utf16_validate(s16.data(), s16.size()));
+
+			EATEST_VERIFY(string().append_convert(s16) == s8);
+			EATEST_VERIFY(u32string().append_convert(s16) == s32);
+			EATEST_VERIFY(u32string().append_convert(s8) == s32);
+			EATEST_VERIFY(u16string().append_convert(s32) == s16);
+
+			if(!s8.empty()) // Invalid text is converted up to where it's invalid, and replaced from there.
+			{
+				eastl_size_t nBad = rng.RandLimit((uint32_t)s8.size());
+				while(((uint8_t)s8[nBad] & 0xc0) == 0x80) // Back up to the beginning of its code point.
+					nBad--;
+				const eastl_size_t nBefore = utf32_length_from_utf8(s8.data(), nBad);
+
+				string bad(s8);
+				bad[nBad] = '\xff';
+				EATEST_VERIFY(!utf8_validate(bad.data(), bad.size()));
+				EATEST_VERIFY(utf8_to_utf32(bad.data(), bad.size(), NULL) == 0);
+
+				const u32string converted = u32string().append_convert(bad);
+				EATEST_VERIFY(converted.compare(0, nBefore, s32, 0, nBefore) == 0);
+				EATEST_VERIFY(converted[nBefore] == 0xffff);
+			}
+		}
+
+		#if EASTL_SIMD_ENABLED
+			Internal::simd_set_features(nSavedFeatures);
+		#endif
+	}
+
+	return nErrorCount;
+}
+
+
 int TestString()
 {
 	int nErrorCount = 0;
@@ -115,6 +340,9 @@ int TestString()
 	#endif
 	}
 
+	nErrorCount += TestStringSearch();
+	nErrorCount += TestStringUtf();
+
 	#if EASTL_USER_LITERALS_ENABLED 
 	{
 		VERIFY("cplusplus"s == "cplusplus");
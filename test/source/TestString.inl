@@ -1158,6 +1158,32 @@ int TEST_STRING_NAME()
 		VERIFY(str.size() == 3);
 	}
 
+	// void resize_default_init(size_type n);
+	// void resize_for_overwrite(size_type n);
+	// pointer append_uninitialized(size_type n);
+	{
+		StringType str(LITERAL("abc"));
+		typename StringType::pointer pTail = str.append_uninitialized(3);
+		VERIFY(pTail == str.data() + 3);
+		VERIFY(str.size() == 6);
+		VERIFY(str.c_str()[6] == 0);
+		pTail[0] = LITERAL('d');
+		pTail[1] = LITERAL('e');
+		pTail[2] = LITERAL('f');
+		VERIFY(str == LITERAL("abcdef"));
+
+		str.resize_default_init(100);
+		VERIFY(str.size() == 100);
+		VERIFY(str.capacity() >= 100);
+		VERIFY(str.c_str()[100] == 0);
+		VERIFY(str.compare(0, 6, LITERAL("abcdef")) == 0);
+		VERIFY(str.validate());
+
+		str.resize_for_overwrite(3);
+		VERIFY(str == LITERAL("abc"));
+		VERIFY(str.validate());
+	}
+
 	// const value_type* data() const EA_NOEXCEPT;
 	// const value_type* c_str() const EA_NOEXCEPT;
 	{
@@ -0,0 +1,337 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "EASTLTest.h"
+#include <EASTL/semaphore.h>
+#include <EASTL/latch.h>
+#include <EASTL/barrier.h>
+#include <EASTL/seqlock.h>
+#include <EASTL/mutex.h>
+#include <EASTL/thread_pool.h>
+#include <EASTL/atomic.h>
+
+
+namespace
+{
+	// A value which is consistent only if all of it was written by the same store.
+	struct SeqlockSample
+	{
+		uint64_t mnValue;
+		uint64_t mnInverse;
+		uint32_t mnTriple;
+	};
+
+	// A trivially copyable value which has no default constructor.
+	struct SeqlockPoint
+	{
+		SeqlockPoint(int16_t nX, int16_t nY) : mnX(nX), mnY(nY) {}
+
+		int16_t mnX;
+		int16_t mnY;
+	};
+
+	SeqlockSample MakeSample(uint64_t n)
+	{
+		const SeqlockSample sample = { n, ~n, (uint32_t)(n * 3) };
+		return sample;
+	}
+
+	bool IsConsistent(const SeqlockSample& sample)
+	{
+		return (sample.mnInverse == ~sample.mnValue) && (sample.mnTriple == (uint32_t)(sample.mnValue * 3));
+	}
+}
+
+
+int TestSynchronization()
+{
+	using namespace std;
+
+	int nErrorCount = 0;
+
+	// Test counting_semaphore and binary_semaphore on a single thread
+	{
+		counting_semaphore<5> semaphore(2);
+
+		EATEST_VERIFY(counting_semaphore<5>::max() == 5);
+		EATEST_VERIFY(semaphore.try_acquire());
+		semaphore.acquire();
+		EATEST_VERIFY(!semaphore.try_acquire());
+
+		semaphore.release(3);
+		for (int i = 0; i < 3; i++)
+			semaphore.acquire();
+		EATEST_VERIFY(!semaphore.try_acquire());
+
+		binary_semaphore signal(0);
+
+		EATEST_VERIFY(binary_semaphore::max() == 1);
+		EATEST_VERIFY(!signal.try_acquire());
+		signal.release();
+		EATEST_VERIFY(signal.try_acquire());
+		EATEST_VERIFY(!signal.try_acquire());
+	}
+
+	// Test two threads taking turns through a pair of binary_semaphores.
+	#if EASTL_THREAD_POOL_AVAILABLE
+		{
+			const int kRoundCount = 2000;
+
+			binary_semaphore ping(0), pong(0);
+			thread_pool      pool(1);
+			int              nTurn = 0;
+			int              nWrong = 0;
+
+			if (CanRunBlockingTasks(pool))
+			{
+				pool.parallel_invoke([&]
+				{
+					for (int i = 0; i < kRoundCount; i++)
+					{
+						ping.release();
+						pong.acquire();
+						if (nTurn++ != (2 * i) + 1)
+							nWrong++;
+					}
+				},
+				[&]
+				{
+					for (int i = 0; i < kRoundCount; i++)
+					{
+						ping.acquire();
+						if (nTurn++ != (2 * i))
+							nWrong++;
+						pong.release();
+					}
+				});
+
+				EATEST_VERIFY(nWrong == 0);
+				EATEST_VERIFY(nTurn == 2 * kRoundCount);
+			}
+		}
+	#endif
+
+	// Test consumers acquiring what a producer releases, singly and in batches.
+	{
+		const int kConsumerCount = 4;
+		const int kCountPerConsumer = 5000;
+
+		counting_semaphore<> semaphore(0);
+		thread_pool          pool(kConsumerCount);
+		atomic<int>          nAcquired(0);
+
+		pool.parallel_invoke([&]
+		{
+			for (int i = 0; i < kConsumerCount * kCountPerConsumer; )
+			{
+				const int n = min((i % 3) + 1, (kConsumerCount * kCountPerConsumer) - i);
+				semaphore.release(n);
+				i += n;
+			}
+		},
+		[&]
+		{
+			pool.parallel_for(kConsumerCount, 1, [&](size_t nBegin, size_t nEnd)
+			{
+				for (size_t c = nBegin; c < nEnd; c++)
+				{
+					for (int i = 0; i < kCountPerConsumer; i++)
+					{
+						semaphore.acquire();
+						nAcquired++;
+					}
+				}
+			});
+		});
+
+		EATEST_VERIFY(nAcquired.load() == kConsumerCount * kCountPerConsumer);
+		EATEST_VERIFY(!semaphore.try_acquire());
+	}
+
+	// Test latch
+	{
+		latch single(2);
+
+		EATEST_VERIFY(!single.try_wait());
+		single.count_down();
+		EATEST_VERIFY(!single.try_wait());
+		single.arrive_and_wait();
+		EATEST_VERIFY(single.try_wait());
+		single.wait();
+
+		latch zero(0);
+		EATEST_VERIFY(zero.try_wait());
+	}
+
+	// Test a thread waiting for jobs on other threads, which must all be done when it returns.
+	// The waiting task needs a worker thread, as the jobs run after it when there is none.
+	#if EASTL_THREAD_POOL_AVAILABLE
+		{
+			const int kJobCount = 8;
+
+			latch       done(kJobCount);
+			thread_pool pool(4);
+			int         jobs[kJobCount] = {};
+			int         nUnfinished = 0;
+
+			if (CanRunBlockingTasks(pool))
+			{
+				pool.parallel_invoke([&]
+				{
+					done.wait();
+					for (int i = 0; i < kJobCount; i++)
+						nUnfinished += (jobs[i] != 1);
+				},
+				[&]
+				{
+					pool.parallel_for(kJobCount, 1, [&](size_t nBegin, size_t nEnd)
+					{
+						for (size_t i = nBegin; i < nEnd; i++)
+						{
+							jobs[i]++;
+							done.count_down();
+						}
+					});
+				});
+
+				EATEST_VERIFY(nUnfinished == 0);
+			}
+		}
+	#endif
+
+	// Test barrier with a completion function. Each thread adds to a sum in every phase,
+	// which the completion function checks and clears. One thread drops out half way.
+	#if EASTL_THREAD_POOL_AVAILABLE
+		{
+			const int kThreadCount = 4;
+			const int kPhaseCount  = 200;
+
+			struct Completion
+			{
+				int*  mpSum;
+				int*  mpExpected;
+				int*  mpPhase;
+				int*  mpWrong;
+
+				void operator()() EA_NOEXCEPT
+				{
+					if (*mpSum != *mpExpected)
+						(*mpWrong)++;
+					*mpSum = 0;
+					(*mpPhase)++;
+				}
+			};
+
+			int         nSum = 0, nExpected = kThreadCount, nPhase = 0, nWrong = 0;
+			atomic<int> nPhaseWrong(0);
+			Completion  completion = { &nSum, &nExpected, &nPhase, &nWrong };
+
+			barrier<Completion> sync(kThreadCount, completion);
+			thread_pool         pool(kThreadCount);
+			spinlock            sumLock;
+
+			if (CanRunBlockingTasks(pool, kThreadCount)) // Each task waits at the barrier for the others.
+			{
+				pool.parallel_for(kThreadCount, 1, [&](size_t nBegin, size_t nEnd)
+				{
+					for (size_t t = nBegin; t < nEnd; t++)
+					{
+						for (int p = 0; p < kPhaseCount; p++)
+						{
+							if ((t == 0) && (p == kPhaseCount / 2))
+							{
+								// Only the thread which drops out writes nExpected, before it arrives. Its
+								// arrival counts in this phase, but it adds nothing to the sum.
+								nExpected = kThreadCount - 1;
+								sync.arrive_and_drop();
+								break;
+							}
+
+							{
+								lock_guard<spinlock> lock(sumLock);
+								nSum++;
+							}
+
+							if (p % 2)
+								sync.arrive_and_wait();
+							else
+							{
+								auto token = sync.arrive();
+								sync.wait(std::move(token));
+							}
+
+							if (nPhase != p + 1)
+								nPhaseWrong++;
+						}
+					}
+				});
+
+				EATEST_VERIFY(nWrong == 0);
+				EATEST_VERIFY(nPhaseWrong.load() == 0);
+				EATEST_VERIFY(nPhase == kPhaseCount);
+			}
+		}
+	#endif
+
+	// Test seqlock on a single thread
+	{
+		seqlock<SeqlockSample> sample;
+		SeqlockSample          value = MakeSample(1);
+
+		EATEST_VERIFY(sample.try_load(value) && (value.mnValue == 0) && (value.mnInverse == 0));
+
+		sample.store(MakeSample(42));
+		value = sample.load();
+		EATEST_VERIFY((value.mnValue == 42) && IsConsistent(value));
+
+		seqlock<int> n(7);
+		EATEST_VERIFY(n.load() == 7);
+
+		// Values need not be default constructible.
+		seqlock<SeqlockPoint> point(SeqlockPoint(3, -4));
+		EATEST_VERIFY((point.load().mnX == 3) && (point.load().mnY == -4));
+	}
+
+	// Test threads loading from a seqlock while another stores to it. Every value loaded
+	// must be one that was stored, whole, and no older than the one loaded before it.
+	{
+		const uint64_t kStoreCount = 200000;
+
+		seqlock<SeqlockSample> sample(MakeSample(0));
+		thread_pool            pool(3);
+		atomic<int>            nWrong(0);
+
+		pool.parallel_invoke([&]
+		{
+			for (uint64_t i = 1; i <= kStoreCount; i++)
+				sample.store(MakeSample(i));
+		},
+		[&]
+		{
+			pool.parallel_for(3, 1, [&](size_t nBegin, size_t nEnd)
+			{
+				for (size_t r = nBegin; r < nEnd; r++)
+				{
+					uint64_t nLast = 0;
+
+					while (nLast != kStoreCount)
+					{
+						const SeqlockSample value = sample.load();
+
+						if (!IsConsistent(value) || (value.mnValue < nLast))
+							nWrong++;
+						nLast = value.mnValue;
+
+						if (nLast != kStoreCount)
+							Internal::thread_yield(); // Lets the writer run when the threads share a core.
+					}
+				}
+			});
+		});
+
+		EATEST_VERIFY(nWrong.load() == 0);
+	}
+
+	return nErrorCount;
+}
@@ -0,0 +1,249 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#include "EASTLTest.h"
+#include <EASTL/thread_pool.h>
+#include <EASTL/execution.h>
+#include <EASTL/vector.h>
+#include <EASTL/list.h>
+#include <EASTL/atomic.h>
+
+
+static int TestThreadPoolDeque()
+{
+	using namespace std;
+
+	int nErrorCount = 0;
+
+	Internal::thread_pool_deque deque;
+	Internal::thread_pool_task  tasks[4];
+
+	EATEST_VERIFY(deque.empty());
+	EATEST_VERIFY(deque.pop() == NULL);
+	EATEST_VERIFY(deque.steal() == NULL);
+
+	for(int i = 0; i < 4; i++)
+		EATEST_VERIFY(deque.push(&tasks[i]));
+
+	EATEST_VERIFY(!deque.empty());
+	EATEST_VERIFY(deque.pop()   == &tasks[3]); // The owner pops in LIFO order...
+	EATEST_VERIFY(deque.steal() == &tasks[0]); // ...while thieves steal in FIFO order.
+	EATEST_VERIFY(deque.steal() == &tasks[1]);
+	EATEST_VERIFY(deque.pop()   == &tasks[2]);
+	EATEST_VERIFY(deque.pop()   == NULL);
+	EATEST_VERIFY(deque.empty());
+
+	// Fill the deque to capacity, wrapping around the ring.
+	for(int i = 0; i < (int)Internal::thread_pool_deque::kCapacity; i++)
+		EATEST_VERIFY(deque.push(&tasks[i % 4]));
+	EATEST_VERIFY(!deque.push(&tasks[0]));
+
+	for(int i = 0; i < (int)Internal::thread_pool_deque::kCapacity; i++)
+		EATEST_VERIFY(deque.steal() != NULL);
+	EATEST_VERIFY(deque.empty());
+
+	return nErrorCount;
+}
+
+
+static int TestThreadPoolParallelFor(std::thread_pool& pool)
+{
+	using namespace std;
+
+	int nErrorCount = 0;
+
+	{   // Every index is visited exactly once.
+		const size_t kCount = 100000;
+		vector<int> visits(kCount, 0);
+
+		pool.parallel_for(kCount, 1000, [&visits](size_t nBegin, size_t nEnd)
+		{
+			for(size_t i = nBegin; i < nEnd; i++)
+				visits[i]++;
+		});
+
+		EATEST_VERIFY(count(visits.begin(), visits.end(), 1) == (ptrdiff_t)kCount);
+	}
+
+	{   // Ranges are no larger than the grain size, and empty loops make no calls.
+		atomic<size_t> nMaxRange(0);
+		atomic<int>    nCallCount(0);
+
+		pool.parallel_for(10000, 100, [&](size_t nBegin, size_t nEnd)
+		{
+			size_t nMax = nMaxRange.load();
+			while(((nEnd - nBegin) > nMax) && !nMaxRange.compare_exchange_weak(nMax, nEnd - nBegin))
+				{ }
+			nCallCount++;
+		});
+
+		if(pool.worker_count())
+		{
+			EATEST_VERIFY(nMaxRange.load() <= 100);
+			EATEST_VERIFY(nCallCount.load() >= 100);
+		}
+		else
+			EATEST_VERIFY(nCallCount.load() == 1); // A pool without workers makes a single call.
+
+		nCallCount = 0;
+		pool.parallel_for(0, 100, [&](size_t, size_t) { nCallCount++; });
+		EATEST_VERIFY(nCallCount.load() == 0);
+	}
+
+	{   // Nested loops.
+		const size_t kOuter = 64, kInner = 1000;
+		atomic<size_t> nSum(0);
+
+		pool.parallel_for(kOuter, 1, [&](size_t nOuterBegin, size_t nOuterEnd)
+		{
+			for(size_t i = nOuterBegin; i < nOuterEnd; i++)
+			{
+				pool.parallel_for(kInner, 10, [&](size_t nBegin, size_t nEnd)
+				{
+					size_t nLocal = 0;
+					for(size_t j = nBegin; j < nEnd; j++)
+						nLocal += j;
+					nSum += nLocal;
+				});
+			}
+		});
+
+		EATEST_VERIFY(nSum.load() == (kOuter * (kInner * (kInner - 1) / 2)));
+	}
+
+	{   // parallel_invoke, recursively.
+		struct Fibonacci
+		{
+			static int Compute(std::thread_pool& pool, int n)
+			{
+				if(n < 12)
+					return (n < 2) ? n : (Compute(pool, n - 1) + Compute(pool, n - 2));
+
+				int a = 0, b = 0;
+				pool.parallel_invoke([&] { a = Compute(pool, n - 1); }, [&] { b = Compute(pool, n - 2); });
+				return a + b;
+			}
+		};
+
+		EATEST_VERIFY(Fibonacci::Compute(pool, 24) == 46368);
+	}
+
+	return nErrorCount;
+}
+
+
+static int TestExecutionPolicies(const std::execution::parallel_policy& par)
+{
+	using namespace std;
+
+	int nErrorCount = 0;
+
+	static_assert(is_execution_policy<execution::sequenced_policy>::value, "is_execution_policy failure");
+	static_assert(is_execution_policy<execution::parallel_policy>::value, "is_execution_policy failure");
+	static_assert(!is_execution_policy<int>::value, "is_execution_policy failure");
+
+	const int kCount = 100003; // Not a multiple of any chunk size.
+
+	vector<int> v(kCount);
+	for(int i = 0; i < kCount; i++)
+		v[i] = i;
+
+	{   // for_each
+		vector<int> w(v);
+		for_each(par, w.begin(), w.end(), [](int& x) { x *= 2; });
+		EATEST_VERIFY(w[0] == 0 && w[kCount - 1] == 2 * (kCount - 1));
+		EATEST_VERIFY(accumulate(w.begin(), w.end(), (int64_t)0) == (int64_t)kCount * (kCount - 1));
+
+		for_each(execution::seq, w.begin(), w.end(), [](int& x) { x /= 2; });
+		EATEST_VERIFY(w == v);
+	}
+
+	{   // transform
+		vector<int> w(kCount);
+		vector<int>::iterator it = transform(par, v.begin(), v.end(), w.begin(), [](int x) { return x + 1; });
+		EATEST_VERIFY(it == w.end());
+		EATEST_VERIFY(w[0] == 1 && w[kCount - 1] == kCount);
+
+		vector<int> z(kCount);
+		transform(par, v.begin(), v.end(), w.begin(), z.begin(), [](int x, int y) { return y - x; });
+		EATEST_VERIFY(count(z.begin(), z.end(), 1) == kCount);
+	}
+
+	{   // copy / fill
+		vector<int> w(kCount, -1);
+		EATEST_VERIFY(copy(par, v.begin(), v.end(), w.begin()) == w.end());
+		EATEST_VERIFY(w == v);
+
+		fill(par, w.begin(), w.end(), 7);
+		EATEST_VERIFY(count(w.begin(), w.end(), 7) == kCount);
+	}
+
+	{   // count_if / find_if
+		EATEST_VERIFY(count_if(par, v.begin(), v.end(), [](int x) { return (x % 3) == 0; }) == (kCount + 2) / 3);
+
+		EATEST_VERIFY(find_if(par, v.begin(), v.end(), [](int x) { return x >= 77777; }) == v.begin() + 77777);
+		EATEST_VERIFY(find_if(par, v.begin(), v.end(), [](int x) { return (x % 1000) == 999; }) == v.begin() + 999);
+		EATEST_VERIFY(find_if(par, v.begin(), v.end(), [](int x) { return x < 0; }) == v.end());
+	}
+
+	{   // reduce / accumulate / transform_reduce
+		const int64_t nExpected = (int64_t)kCount * (kCount - 1) / 2;
+
+		EATEST_VERIFY(reduce(par, v.begin(), v.end(), (int64_t)0) == nExpected);
+		EATEST_VERIFY(reduce(par, v.begin(), v.begin() + 100) == 4950);
+		EATEST_VERIFY(reduce(par, v.begin(), v.end(), 0, [](int a, int b) { return (a > b) ? a : b; }) == kCount - 1);
+		EATEST_VERIFY(accumulate(par, v.begin(), v.end(), (int64_t)0) == nExpected);
+		EATEST_VERIFY(accumulate(par, v.begin(), v.end(), (int64_t)10, plus<int64_t>()) == nExpected + 10);
+
+		EATEST_VERIFY(transform_reduce(par, v.begin(), v.end(), (int64_t)0, plus<int64_t>(), [](int x) { return (int64_t)x * 2; }) == 2 * nExpected);
+
+		vector<int64_t> ones(kCount, 1);
+		EATEST_VERIFY(transform_reduce(par, v.begin(), v.end(), ones.begin(), (int64_t)0) == nExpected);
+		EATEST_VERIFY(transform_reduce(execution::seq, v.begin(), v.end(), ones.begin(), (int64_t)0) == nExpected);
+	}
+
+	{   // Iterators which aren't random access fall back to the serial algorithms.
+		list<int> l(v.begin(), v.begin() + 1000);
+		for_each(par, l.begin(), l.end(), [](int& x) { x++; });
+		EATEST_VERIFY(reduce(par, l.begin(), l.end(), 0) == (1000 * 1001) / 2);
+		EATEST_VERIFY(count_if(par, l.begin(), l.end(), [](int x) { return x > 500; }) == 500);
+	}
+
+	return nErrorCount;
+}
+
+
+int TestThreadPool()
+{
+	using namespace std;
+
+	int nErrorCount = 0;
+
+	nErrorCount += TestThreadPoolDeque();
+
+	{
+		thread_pool pool(3);
+		EATEST_VERIFY(pool.concurrency() == (pool.worker_count() + 1));
+		#if EASTL_THREAD_POOL_AVAILABLE
+			EATEST_VERIFY(pool.worker_count() == 3);
+		#endif
+
+		nErrorCount += TestThreadPoolParallelFor(pool);
+		nErrorCount += TestExecutionPolicies(execution::par.on(pool).with_grain_size(1000));
+		nErrorCount += TestExecutionPolicies(execution::par.on(pool));
+	}
+
+	{   // A pool without workers runs everything on the calling thread.
+		thread_pool pool(0);
+		EATEST_VERIFY(pool.worker_count() == 0);
+		nErrorCount += TestThreadPoolParallelFor(pool);
+		nErrorCount += TestExecutionPolicies(execution::par.on(pool));
+	}
+
+	EATEST_VERIFY(thread_pool::hardware_concurrency() >= 1);
+	nErrorCount += TestExecutionPolicies(execution::par);
+
+	return nErrorCount;
+}
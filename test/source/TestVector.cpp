@@ -511,6 +511,43 @@ int TestVector()
 		}
 	}
 
+	{
+		using namespace std;
+
+		// void resize_default_init(size_type n);
+		// void resize_for_overwrite(size_type n);
+		// pointer append_uninitialized(size_type n);
+
+		vector<int> intArray;
+		intArray.resize_default_init(10);
+		EATEST_VERIFY(intArray.size() == 10);
+		EATEST_VERIFY(intArray.validate());
+		for(i = 0; i < 10; i++)
+			intArray[i] = (int)i;
+
+		int* pTail = intArray.append_uninitialized(90);
+		EATEST_VERIFY(pTail == intArray.data() + 10);
+		EATEST_VERIFY(intArray.size() == 100);
+		EATEST_VERIFY(intArray[9] == 9);
+		for(i = 10; i < 100; i++)
+			pTail[i - 10] = (int)i;
+		EATEST_VERIFY(intArray[99] == 99);
+
+		intArray.resize_for_overwrite(5);
+		EATEST_VERIFY(intArray.size() == 5);
+		EATEST_VERIFY(intArray[4] == 4);
+
+		// Class types are default-constructed.
+		int64_t toCount0 = TestObject::sTOCount;
+		vector<TestObject> toArray;
+		toArray.resize_default_init(5);
+		EATEST_VERIFY(TestObject::sTOCount == toCount0 + 5);
+		TestObject* pTO = toArray.append_uninitialized(3);
+		EATEST_VERIFY(pTO == toArray.data() + 5);
+		EATEST_VERIFY(TestObject::sTOCount == toCount0 + 8);
+		EATEST_VERIFY(toArray.validate());
+	}
+
 	{
 		using namespace std;
 
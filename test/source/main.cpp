@@ -93,6 +93,8 @@ int EAMain(int argc, char* argv[])
 	testSuite.AddTest("Bitset",					TestBitset);
 	testSuite.AddTest("CharTraits",			    TestCharTraits);
 	testSuite.AddTest("Chrono",					TestChrono);
+	testSuite.AddTest("ConcurrentIntrusive",	TestConcurrentIntrusive);
+	testSuite.AddTest("ConcurrentLRUCache",	TestConcurrentLruCache);
 	testSuite.AddTest("Deque",					TestDeque);
 	testSuite.AddTest("Extra",					TestExtra);
 	testSuite.AddTest("Finally",				TestFinally);
@@ -119,10 +121,13 @@ int EAMain(int argc, char* argv[])
 	testSuite.AddTest("Map",					TestMap);
 	testSuite.AddTest("Memory",					TestMemory);
 	testSuite.AddTest("Meta",				    TestMeta);
+	testSuite.AddTest("MpmcQueue",				TestMpmcQueue);
+	testSuite.AddTest("Mutex",					TestMutex);
 	testSuite.AddTest("NumericLimits",			TestNumericLimits);
 	testSuite.AddTest("Optional",				TestOptional);
 	testSuite.AddTest("Random",					TestRandom);
 	testSuite.AddTest("Ratio",					TestRatio);
+	testSuite.AddTest("Reclamation",			TestReclamation);
 	testSuite.AddTest("RingBuffer",				TestRingBuffer);
 	testSuite.AddTest("SList",					TestSList);
 	testSuite.AddTest("SegmentedVector",		TestSegmentedVector);
@@ -130,11 +135,14 @@ int EAMain(int argc, char* argv[])
 	testSuite.AddTest("SmartPtr",				TestSmartPtr);
 	testSuite.AddTest("Sort",					TestSort);
 	testSuite.AddTest("Span",				    TestSpan);
+	testSuite.AddTest("SpscQueue",				TestSpscQueue);
 	testSuite.AddTest("String",					TestString);
 	testSuite.AddTest("StringHashMap",			TestStringHashMap);
 	testSuite.AddTest("StringMap",				TestStringMap);
 	testSuite.AddTest("StringView",			    TestStringView);
+	testSuite.AddTest("Synchronization",		TestSynchronization);
 	testSuite.AddTest("TestCppCXTypeTraits",	TestCppCXTypeTraits);
+	testSuite.AddTest("ThreadPool",			TestThreadPool);
 	testSuite.AddTest("Tuple",					TestTuple);
 	testSuite.AddTest("TupleVector",			TestTupleVector);
 	testSuite.AddTest("TypeTraits",				TestTypeTraits);